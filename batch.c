@@ -0,0 +1,375 @@
+/*
+ * @Name : batch.c
+ * @Description : Image Processing in C - 여러 BMP 파일 일괄 처리 (읽기, 처리, 쓰기를 동시에 진행)
+ * @Date : 2026. 10. 19
+ * @Revision : 1.2
+ * 1.0 : BatchProcess - 읽기 스레드, 처리(호출한 스레드), 쓰기 스레드를 슬롯 큐로 연결
+ * 1.1 : 저장 형식 선택 (nFileFormat, RLE8 / 1비트 BMP, PNG)
+ * 1.2 : 쓰기 스레드도 저장하는 동안 슬롯의 풀 사용 (PNG, RLE8, 1비트 저장 버퍼가 스레드 기본 풀에 남아서 새던 문제)
+ *
+ * 파일 N+1을 읽고 파일 N-1을 쓰는 동안 파일 N을 처리한다.
+ * 슬롯(입력, 결과 버퍼 한 쌍) 개수만큼만 파일이 동시에 메모리에 올라가므로 메모리 사용량이 정해져 있다.
+ *
+ *   빈 슬롯 큐 -> [읽기 스레드] -> 읽은 슬롯 큐 -> [처리 : PipelineRun] -> 처리한 슬롯 큐 -> [쓰기 스레드] -> 빈 슬롯 큐
+ *
+ * 스레드는 Windows는 C11 threads.h, 그 외는 pthread 사용 (아래 BATCH_xxx 매크로)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef _WIN32
+#include <threads.h> // Windows.h는 DWORD 정의가 imgprocessing.h와 달라서 사용하지 않음
+#else
+#include <pthread.h>
+#endif
+#include "imgprocessing.h"
+#include "profile.h"
+
+// 스레드, 뮤텍스, 조건 변수
+#ifdef _WIN32
+typedef thrd_t BATCH_THREAD;
+typedef mtx_t BATCH_MUTEX;
+typedef cnd_t BATCH_COND;
+#define BATCH_THREAD_RETURN int
+#define BATCH_THREAD_START(pThread, Func, pArg) (thrd_create(pThread, Func, pArg) == thrd_success ? 0 : (-1))
+#define BATCH_THREAD_JOIN(Thread) thrd_join(Thread, NULL)
+#define BATCH_MUTEX_INIT(pMutex) mtx_init(pMutex, mtx_plain)
+#define BATCH_MUTEX_DESTROY(pMutex) mtx_destroy(pMutex)
+#define BATCH_LOCK(pMutex) mtx_lock(pMutex)
+#define BATCH_UNLOCK(pMutex) mtx_unlock(pMutex)
+#define BATCH_COND_INIT(pCond) cnd_init(pCond)
+#define BATCH_COND_DESTROY(pCond) cnd_destroy(pCond)
+#define BATCH_WAIT(pCond, pMutex) cnd_wait(pCond, pMutex)
+#define BATCH_SIGNAL(pCond) cnd_signal(pCond)
+#else
+typedef pthread_t BATCH_THREAD;
+typedef pthread_mutex_t BATCH_MUTEX;
+typedef pthread_cond_t BATCH_COND;
+#define BATCH_THREAD_RETURN void *
+#define BATCH_THREAD_START(pThread, Func, pArg) (pthread_create(pThread, NULL, Func, pArg) == 0 ? 0 : (-1))
+#define BATCH_THREAD_JOIN(Thread) pthread_join(Thread, NULL)
+#define BATCH_MUTEX_INIT(pMutex) pthread_mutex_init(pMutex, NULL)
+#define BATCH_MUTEX_DESTROY(pMutex) pthread_mutex_destroy(pMutex)
+#define BATCH_LOCK(pMutex) pthread_mutex_lock(pMutex)
+#define BATCH_UNLOCK(pMutex) pthread_mutex_unlock(pMutex)
+#define BATCH_COND_INIT(pCond) pthread_cond_init(pCond, NULL)
+#define BATCH_COND_DESTROY(pCond) pthread_cond_destroy(pCond)
+#define BATCH_WAIT(pCond, pMutex) pthread_cond_wait(pCond, pMutex)
+#define BATCH_SIGNAL(pCond) pthread_cond_signal(pCond)
+#endif
+
+#define BATCH_END (-1) // 큐의 끝 표시 (더 이상 슬롯이 오지 않음)
+
+// 파일 하나를 담는 슬롯 (큐를 통해 넘겨받은 스레드 하나만 사용)
+typedef struct
+{
+    BUFFER_POOL Pool; // 입력, 결과 버퍼 (다음 파일에서 같은 크기면 그대로 재사용)
+    int nFile;        // 파일 번호 (szInputs, szOutputs 순서)
+    int nStatus;      // 0 (성공) / -1 (읽기, 처리, 쓰기 오류)
+    BITMAPFILEHEADER hf;
+    BITMAPINFOHEADER hInfo;
+    RGBQUAD hRGB[256];
+    int nFormat, nOutFormat;
+    BYTE *pInput, *pOutput;
+} BATCH_SLOT;
+
+// 슬롯 번호 큐 (슬롯 개수보다 많이 들어가지 않으므로 가득 차는 경우가 없음)
+typedef struct
+{
+    int nItem[BATCH_MAX_SLOTS + 1]; // 슬롯 번호 + BATCH_END
+    int nHead, nCount;
+    BATCH_MUTEX Mutex;
+    BATCH_COND NotEmpty;
+} BATCH_QUEUE;
+
+// 세 단계가 같이 사용하는 상태
+typedef struct
+{
+    const char *const *szInputs;
+    const char *const *szOutputs;
+    int nFiles, nFileFormat;
+    BATCH_SLOT *pSlots;
+    BATCH_QUEUE Free, Read, Done;
+    double dReadSec, dWriteSec; // 읽기, 쓰기 스레드가 일한 시간
+    int nFailed;                // 쓰기 스레드가 센 실패 파일 수
+} BATCH_STATE;
+
+/*
+ * @Function Name : BatchNow
+ * @Description : 현재 시각을 초 단위로 반환합니다. (C11 timespec_get)
+ * @Output : 초
+ */
+static double BatchNow(void)
+{
+    struct timespec ts;
+
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void QueueInit(BATCH_QUEUE *pQueue)
+{
+    pQueue->nHead = pQueue->nCount = 0;
+    BATCH_MUTEX_INIT(&pQueue->Mutex);
+    BATCH_COND_INIT(&pQueue->NotEmpty);
+}
+
+static void QueueDestroy(BATCH_QUEUE *pQueue)
+{
+    BATCH_MUTEX_DESTROY(&pQueue->Mutex);
+    BATCH_COND_DESTROY(&pQueue->NotEmpty);
+}
+
+static void QueuePush(BATCH_QUEUE *pQueue, int nItem)
+{
+    BATCH_LOCK(&pQueue->Mutex);
+    pQueue->nItem[(pQueue->nHead + pQueue->nCount) % (BATCH_MAX_SLOTS + 1)] = nItem;
+    pQueue->nCount++;
+    BATCH_SIGNAL(&pQueue->NotEmpty);
+    BATCH_UNLOCK(&pQueue->Mutex);
+}
+
+// 비어 있으면 들어올 때까지 기다림
+static int QueuePop(BATCH_QUEUE *pQueue)
+{
+    int nItem;
+
+    BATCH_LOCK(&pQueue->Mutex);
+    while (pQueue->nCount == 0)
+        BATCH_WAIT(&pQueue->NotEmpty, &pQueue->Mutex);
+    nItem = pQueue->nItem[pQueue->nHead];
+    pQueue->nHead = (pQueue->nHead + 1) % (BATCH_MAX_SLOTS + 1);
+    pQueue->nCount--;
+    BATCH_UNLOCK(&pQueue->Mutex);
+
+    return nItem;
+}
+
+/*
+ * @Function Name : ReaderThread
+ * @Description : 빈 슬롯을 받아서 다음 파일을 읽고 읽은 슬롯 큐로 넘깁니다.
+ * @Input : pArg - BATCH_STATE
+ */
+// 김광제의 설명 - ReadBitmap은 GetThreadPool에서 버퍼를 가져오므로 읽는 동안만 슬롯의 풀로 바꿔준다.
+// 읽기에 실패한 파일도 슬롯을 넘겨서 쓰기 스레드가 실패 수를 세고 슬롯을 돌려줌
+static BATCH_THREAD_RETURN ReaderThread(void *pArg)
+{
+    BATCH_STATE *pState = (BATCH_STATE *)pArg;
+
+    for (int f = 0; f < pState->nFiles; f++)
+    {
+        int nSlot = QueuePop(&pState->Free);
+        BATCH_SLOT *pSlot = &pState->pSlots[nSlot];
+        double dStart = BatchNow();
+        BUFFER_POOL *pPrevPool;
+        FILE *fp = NULL;
+
+        pSlot->nFile = f;
+        pSlot->pInput = pSlot->pOutput = NULL;
+        ImgOpenFile(&fp, pState->szInputs[f], "rb");
+        if (fp != NULL)
+        {
+            pPrevPool = SetThreadPool(&pSlot->Pool);
+            pSlot->pInput = ReadBitmap(fp, &pSlot->hf, &pSlot->hInfo, pSlot->hRGB, &pSlot->nFormat);
+            SetThreadPool(pPrevPool);
+            fclose(fp);
+        }
+        pSlot->nStatus = (NULL == pSlot->pInput) ? (-1) : 0;
+
+        pState->dReadSec += BatchNow() - dStart;
+        QueuePush(&pState->Read, nSlot);
+    }
+
+    QueuePush(&pState->Read, BATCH_END);
+    return (BATCH_THREAD_RETURN)0;
+}
+
+/*
+ * @Function Name : WriterThread
+ * @Description : 처리한 슬롯의 결과를 BMP로 저장하고 슬롯을 빈 슬롯 큐로 돌려줍니다.
+ * @Input : pArg - BATCH_STATE
+ */
+// 김광제의 설명 - PNG, RLE8, 1비트 저장은 GetThreadPool에서 임시 버퍼를 가져오므로 읽기 스레드처럼 저장하는 동안만 슬롯의 풀로 바꿔준다.
+// 스레드 기본 풀을 쓰면 아무도 PoolRelease를 부르지 않아서 스레드가 끝날 때 보관중인 블록이 샘
+static BATCH_THREAD_RETURN WriterThread(void *pArg)
+{
+    BATCH_STATE *pState = (BATCH_STATE *)pArg;
+    int nSlot;
+
+    while ((nSlot = QueuePop(&pState->Done)) != BATCH_END)
+    {
+        BATCH_SLOT *pSlot = &pState->pSlots[nSlot];
+        double dStart = BatchNow();
+        BUFFER_POOL *pPrevPool;
+        FILE *fp = NULL;
+
+        if (pSlot->nStatus == 0)
+        {
+            ImgOpenFile(&fp, pState->szOutputs[pSlot->nFile], "wb");
+            if (NULL == fp)
+                pSlot->nStatus = (-1);
+            else
+            {
+                pPrevPool = SetThreadPool(&pSlot->Pool);
+                if (WriteImageFile(fp, &pSlot->hf, &pSlot->hInfo, pSlot->hRGB, pSlot->pOutput, pSlot->nOutFormat, pState->nFileFormat) != 0)
+                    pSlot->nStatus = (-1);
+                SetThreadPool(pPrevPool);
+                if (fclose(fp) != 0)
+                    pSlot->nStatus = (-1);
+            }
+        }
+        if (pSlot->nStatus != 0)
+            pState->nFailed++;
+
+        PoolFree(&pSlot->Pool, pSlot->pInput);
+        PoolFree(&pSlot->Pool, pSlot->pOutput);
+        pSlot->pInput = pSlot->pOutput = NULL;
+
+        pState->dWriteSec += BatchNow() - dStart;
+        QueuePush(&pState->Free, nSlot);
+    }
+
+    return (BATCH_THREAD_RETURN)0;
+}
+
+/*
+ * @Function Name : ProcessSlot
+ * @Description : 슬롯의 입력 영상에 파이프라인을 실행합니다.
+ * @Input : *pCtx, *pPipe, *pSlot
+ * @Output : pSlot->pOutput, nOutFormat, nStatus
+ */
+// 김광제의 설명 - 결과 형식은 OP_TO_GRAY가 있으면 8비트 그레이, 없으면 입력과 같은 형식이다.
+// 컬러에서 그레이로 바뀌면 원본에 팔레트가 없으므로 그레이 팔레트를 만들어서 저장
+static void ProcessSlot(IMGPROC_CONTEXT *pCtx, PIPELINE *pPipe, BATCH_SLOT *pSlot)
+{
+    IMAGE In, Out;
+    int nWidth = pSlot->hInfo.biWidth, nHeight = pSlot->hInfo.biHeight;
+
+    pSlot->nOutFormat = pSlot->nFormat;
+    for (int i = 0; i < pPipe->nOps; i++)
+        if (pPipe->Op[i].nOp == OP_TO_GRAY)
+            pSlot->nOutFormat = PIXEL_GRAY8;
+
+    pSlot->pOutput = (BYTE *)PoolAlloc(&pSlot->Pool, (size_t)nWidth * nHeight * GetBytesPerPixel(pSlot->nOutFormat), 0);
+    if (NULL == pSlot->pOutput)
+    {
+        pSlot->nStatus = (-1);
+        return;
+    }
+
+    WrapImage(&In, pSlot->pInput, nWidth, nHeight, pSlot->nFormat, 0);
+    WrapImage(&Out, pSlot->pOutput, nWidth, nHeight, pSlot->nOutFormat, 0);
+    if (PipelineRun(pCtx, pPipe, &In, &Out) != 0)
+        pSlot->nStatus = (-1);
+
+    if (pSlot->nFormat != PIXEL_GRAY8 && pSlot->nOutFormat == PIXEL_GRAY8)
+        for (int i = 0; i < 256; i++)
+        {
+            pSlot->hRGB[i].rgbBlue = pSlot->hRGB[i].rgbGreen = pSlot->hRGB[i].rgbRed = (BYTE)i;
+            pSlot->hRGB[i].rgbReserved = 0;
+        }
+}
+
+/*
+ * @Function Name : BatchProcess
+ * @Description : 여러 BMP 파일에 같은 파이프라인을 실행하고 저장합니다. (읽기, 처리, 쓰기를 겹쳐서 진행)
+ * @Input : *pCtx - 처리 컨텍스트 (호출한 스레드에서만 사용),
+ *          *pPipe - 실행할 파이프라인,
+ *          szInputs, szOutputs - 입력, 결과 파일 경로 (nFiles개),
+ *          nSlots - 동시에 메모리에 올릴 파일 수 (3 ~ BATCH_MAX_SLOTS, 0이면 BATCH_DEFAULT_SLOTS),
+ *          nFileFormat - 저장 형식 (FILE_xxx, 결과 형식에 맞지 않으면 그 파일은 실패)
+ * @Output : *pStats - 처리 결과 (NULL 가능),
+ *           반환값 0 (모두 성공) / -1 (실패한 파일이 있음, 스레드 생성 오류)
+ */
+// 김광제의 설명 - 처리는 호출한 스레드에서 하므로 컨텍스트의 OpenMP 스레드 수, 버퍼 풀을 그대로 사용한다.
+// 슬롯 3개면 읽기, 처리, 쓰기가 한 파일씩 동시에 진행되고, 더 많으면 읽기나 쓰기가 잠깐 느려져도 처리가 기다리지 않음
+// 결과는 파일 순서대로 하나씩 PipelineRun을 실행한 것과 같다.
+int BatchProcess(IMGPROC_CONTEXT *pCtx, PIPELINE *pPipe, const char *const *szInputs, const char *const *szOutputs, int nFiles,
+                 int nSlots, int nFileFormat, BATCH_STATS *pStats)
+{
+    BATCH_STATE State;
+    BATCH_THREAD Reader, Writer;
+    double dStart = BatchNow(), dWorkSec = 0.0;
+    int nSlot;
+    PROFILE_BEGIN(dProfile);
+
+    if (nSlots == 0)
+        nSlots = BATCH_DEFAULT_SLOTS;
+    if (nSlots < 3 || nSlots > BATCH_MAX_SLOTS || nFiles < 0)
+        return (-1);
+
+    memset(&State, 0, sizeof(BATCH_STATE));
+    State.szInputs = szInputs;
+    State.szOutputs = szOutputs;
+    State.nFiles = nFiles;
+    State.nFileFormat = nFileFormat;
+    State.pSlots = (BATCH_SLOT *)calloc(nSlots, sizeof(BATCH_SLOT));
+    if (NULL == State.pSlots)
+        return (-1);
+
+    QueueInit(&State.Free);
+    QueueInit(&State.Read);
+    QueueInit(&State.Done);
+    for (int s = 0; s < nSlots; s++)
+    {
+        PoolInit(&State.pSlots[s].Pool, 0);
+        QueuePush(&State.Free, s);
+    }
+
+    if (BATCH_THREAD_START(&Reader, ReaderThread, &State) != 0)
+    {
+        State.nFailed = nFiles;
+    }
+    else
+    {
+        if (BATCH_THREAD_START(&Writer, WriterThread, &State) != 0)
+        {
+            // 쓰기 스레드 없이 같은 순서로 처리 (읽기 스레드가 멈추지 않도록 슬롯을 바로 돌려줌)
+            while ((nSlot = QueuePop(&State.Read)) != BATCH_END)
+            {
+                PoolFree(&State.pSlots[nSlot].Pool, State.pSlots[nSlot].pInput);
+                State.nFailed++;
+                QueuePush(&State.Free, nSlot);
+            }
+        }
+        else
+        {
+            while ((nSlot = QueuePop(&State.Read)) != BATCH_END)
+            {
+                double dWork = BatchNow();
+
+                if (State.pSlots[nSlot].nStatus == 0)
+                    ProcessSlot(pCtx, pPipe, &State.pSlots[nSlot]);
+                dWorkSec += BatchNow() - dWork;
+                QueuePush(&State.Done, nSlot);
+            }
+            QueuePush(&State.Done, BATCH_END);
+            BATCH_THREAD_JOIN(Writer);
+        }
+        BATCH_THREAD_JOIN(Reader);
+    }
+
+    for (int s = 0; s < nSlots; s++)
+        PoolRelease(&State.pSlots[s].Pool);
+    QueueDestroy(&State.Free);
+    QueueDestroy(&State.Read);
+    QueueDestroy(&State.Done);
+    free(State.pSlots);
+
+    if (pStats != NULL)
+    {
+        pStats->nFiles = nFiles;
+        pStats->nFailed = State.nFailed;
+        pStats->dTotalSec = BatchNow() - dStart;
+        pStats->dReadSec = State.dReadSec;
+        pStats->dProcessSec = dWorkSec;
+        pStats->dWriteSec = State.dWriteSec;
+    }
+
+    PROFILE_COUNT("batch_files", nFiles);
+    PROFILE_COUNT("batch_failed", State.nFailed);
+    PROFILE_END(dProfile, "batch", 0, 0);
+    return (State.nFailed == 0) ? 0 : (-1);
+}
@@ -0,0 +1,931 @@
+/*
+ * @Name : benchmark.c
+ * @Description : Image Processing 성능 측정 (메뉴의 모든 기능 + 여러 단계 파이프라인)
+ * @Date : 2026. 10. 19
+ * @Revision : 2.1
+ * 1.0 : coins.bmp, noise.bmp, scratch.bmp, 합성 영상(256 ~ 16384)에 대한 MP/s, ns/pixel, 스레드 수별 측정, JSON 출력
+ * 1.1 : 같은 기능을 하나씩 실행(pipeline_chain)한 것과 지연 실행 파이프라인으로 합쳐서 실행(pipeline_chain_fused)한 것 비교
+ * 1.2 : 반지름 20 침식 - Erosion 20번 반복(erosion_x20)과 거리 변환 한번(erosion_radius_20, 유클리드 / 시가지) 비교
+ * 1.3 : 원 허프 변환 (hough_circles, 이진 영상에서 반지름 20 ~ 60)
+ * 1.4 : 직선 허프 변환 - 모든 에지 점 투표(hough_lines)와 점진 방식으로 64개까지(hough_lines_progressive) 비교
+ * 1.5 : 워터셰드로 맞닿은 객체 나누기 (watershed_split, 이진 영상에서 깊이 2픽셀)
+ * 1.6 : 윤곽선 추적 (find_contours)과 Douglas-Peucker 1픽셀까지 (find_contours_simplify), DetectObjectEdge를 그대로 측정
+ * 1.7 : 구멍 채우기 (fill_holes), 이진 영상 배경 영역 채우기 (flood_fill, 왼쪽 위에서 8연결)
+ * 1.8 : RLE 변환 (rle_encode), 런 단위 8연결 레이블링 (rle_label), 3x3 침식 (rle_erosion) - component_labeling, erosion과 비교
+ * 1.9 : 큰 커널 컨볼루션 - 15x15 직접 / FFT, 51x51 자동 선택 / 커널 스펙트럼 재사용 (FFT 필터), 버터워스 저역 통과
+ * 2.0 : 위상 상관 정합 - 한 쌍씩 (phase_correlation), 기준 스펙트럼 재사용 (phase_correlation_cached, 매 프레임 정렬)
+ * 2.1 : 가우시안 흐림 σ = 4 - GaussianConvolution 32번 반복(gaussian_3x3_x32)과 재귀 필터 비교, σ = 30 재귀 / 상자 흐림 (배경 추정)
+ *
+ * 사용법 : benchmark [옵션]
+ *   --images DIR     : coins.bmp, noise.bmp, scratch.bmp가 있는 폴더 (기본값 .)
+ *   --max-size N     : 합성 영상의 최대 한 변 크기 (기본값 4096, 최대 16384)
+ *   --min-size N     : 합성 영상의 최소 한 변 크기 (기본값 256)
+ *   --threads LIST   : 측정할 스레드 수 목록 (예: 1,2,4,8, 기본값 1부터 최대 스레드 수까지 2배씩)
+ *   --repeat N       : 측정 반복 횟수 (기본값 5, 중간값 사용)
+ *   --max-time SEC   : 한 항목의 최대 측정 시간 (기본값 2초, 넘으면 반복을 줄임)
+ *   --ops LIST       : 측정할 기능 이름 목록 (예: inverse,clahe, 기본값 전체)
+ *   --json FILE      : 결과를 JSON 파일로 저장 (회귀 추적용)
+ *
+ * 16384 X 16384 영상은 버퍼 하나가 256MB (컬러 768MB, 레이블링 작업 버퍼 1.5GB)라서 메모리가 충분할 때만 사용
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "imgprocessing.h"
+
+#define BENCH_MAX_THREADS 16 // 스레드 목록 최대 개수
+#define BENCH_MAX_OPS 64     // --ops 목록 최대 개수
+
+// 측정할 영상 (같은 크기의 버퍼들)
+typedef struct
+{
+    char szName[64];
+    int nWidth, nHeight;
+    BYTE *Input;  // 8비트 그레이 원본
+    BYTE *Binary; // 이진 영상 (레이블링, 형태학 연산 입력, 전경 255)
+    BYTE *Color;  // 24비트 컬러 (컬러 -> 그레이 입력)
+    BYTE *Output; // 결과
+    BYTE *Temp;   // 임시 (Prewitt, Sobel 합치기, 제자리 처리 함수의 입력 복사본)
+    BYTE *Work;   // 파이프라인 중간 결과
+} BENCH_IMAGE;
+
+// 측정할 기능
+typedef struct
+{
+    const char *szName;
+    int nMode;                       // 메뉴 번호 (파이프라인은 0)
+    void (*Prepare)(BENCH_IMAGE *p); // 시간 측정 전 준비 (제자리 처리 함수의 입력 복사), 없으면 NULL
+    void (*Run)(BENCH_IMAGE *p);     // 측정할 함수
+} BENCH_OP;
+
+// 결과를 쓰지 않는 함수(히스토그램)가 최적화로 사라지지 않도록 결과를 여기에 더함
+static volatile int nBenchSink;
+
+// pipeline_chain_fused 측정용 처리 컨텍스트, 파이프라인 (main에서 한번 만듦)
+static IMGPROC_CONTEXT BenchContext;
+static PIPELINE BenchChain;
+
+/*
+ * @Function Name : NowSeconds
+ * @Description : 현재 시각을 초 단위로 반환합니다. (C11 timespec_get)
+ * @Output : 초
+ */
+static double NowSeconds(void)
+{
+    struct timespec ts;
+
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// 메뉴 기능별 측정 함수 (main의 case와 같은 함수를 같은 인자로 호출)
+static void RunInverse(BENCH_IMAGE *p) { InverseImageEx(p->Input, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8); }
+static void RunBrightness(BENCH_IMAGE *p) { AdjustBrightnessEx(p->Input, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8, 30); }
+static void RunContrast(BENCH_IMAGE *p) { AdjustContrastEx(p->Input, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8, 1.5); }
+
+static void RunHistogram(BENCH_IMAGE *p)
+{
+    int nHisto[256] = {
+        0,
+    };
+
+    GenerateHistogram(p->Input, nHisto, p->nWidth, p->nHeight);
+    nBenchSink += nHisto[0] + nHisto[255];
+}
+
+static void RunGonzalez(BENCH_IMAGE *p) { GenerateAutoBinarization(p->Input, p->Output, p->nWidth, p->nHeight, THRESHOLD_GONZALEZ); }
+static void RunBinarization(BENCH_IMAGE *p) { GenerateBinarizationEx(p->Input, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8, 128); }
+static void RunStretching(BENCH_IMAGE *p) { HistogramStretchingEx(p->Input, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8); }
+static void RunEqualization(BENCH_IMAGE *p) { HistogramEqualizationEx(p->Input, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8); }
+static void RunAverage(BENCH_IMAGE *p) { ConvolutionEx(p->Input, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8, KERNEL_AVERAGE); }
+static void RunGaussian(BENCH_IMAGE *p) { ConvolutionEx(p->Input, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8, KERNEL_GAUSSIAN); }
+static void RunLaplacian(BENCH_IMAGE *p) { ConvolutionEx(p->Input, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8, KERNEL_LAPLACIAN); }
+static void RunPrewittX(BENCH_IMAGE *p) { ConvolutionEx(p->Input, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8, KERNEL_PREWITT_X); }
+static void RunPrewittY(BENCH_IMAGE *p) { ConvolutionEx(p->Input, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8, KERNEL_PREWITT_Y); }
+
+static void RunPrewitt(BENCH_IMAGE *p)
+{
+    ConvolutionEx(p->Input, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8, KERNEL_PREWITT_X);
+    ConvolutionEx(p->Input, p->Temp, p->nWidth, p->nHeight, PIXEL_GRAY8, KERNEL_PREWITT_Y);
+    CombineMaxEx(p->Temp, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8);
+}
+
+static void RunSobelX(BENCH_IMAGE *p) { ConvolutionEx(p->Input, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8, KERNEL_SOBEL_X); }
+static void RunSobelY(BENCH_IMAGE *p) { ConvolutionEx(p->Input, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8, KERNEL_SOBEL_Y); }
+
+static void RunSobel(BENCH_IMAGE *p)
+{
+    ConvolutionEx(p->Input, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8, KERNEL_SOBEL_X);
+    ConvolutionEx(p->Input, p->Temp, p->nWidth, p->nHeight, PIXEL_GRAY8, KERNEL_SOBEL_Y);
+    CombineMaxEx(p->Temp, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8);
+}
+
+static void RunHPF(BENCH_IMAGE *p) { ConvolutionEx(p->Input, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8, KERNEL_HPF_LAPLACIAN); }
+static void RunMedian3(BENCH_IMAGE *p) { MedianFilter(p->Input, p->Output, p->nWidth, p->nHeight); }
+static void RunMedian5(BENCH_IMAGE *p) { MedianFilteringEx(p->Input, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8, 5); }
+
+// 제자리 처리 함수는 측정 전에 입력을 Temp로 복사해두고 Temp에서 처리
+static void CopyBinaryToTemp(BENCH_IMAGE *p) { memcpy(p->Temp, p->Binary, (size_t)p->nWidth * p->nHeight); }
+static void CopyInputToTemp(BENCH_IMAGE *p) { memcpy(p->Temp, p->Input, (size_t)p->nWidth * p->nHeight); }
+
+// 레이블 수가 1000개를 넘어도 안전한 Gray Gap Labeling(3)으로 측정
+static void RunLabeling(BENCH_IMAGE *p) { ComponentLabeling(p->Temp, p->nHeight, p->nWidth, 3); }
+
+static void RunEdge(BENCH_IMAGE *p) { DetectObjectEdge(p->Binary, p->Output, p->nWidth, p->nHeight); }
+
+static void RunVerticalFlip(BENCH_IMAGE *p) { VerticalFlipEx(p->Temp, p->nWidth, p->nHeight, PIXEL_GRAY8); }
+static void RunHorizontalFlip(BENCH_IMAGE *p) { HorizontalFlipEx(p->Temp, p->nWidth, p->nHeight, PIXEL_GRAY8); }
+static void RunTranslation(BENCH_IMAGE *p) { TranslationEx(p->Input, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8, 10, 20); }
+static void RunScaling(BENCH_IMAGE *p) { ScalingEx(p->Input, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8, 1.5, 0.7); }
+static void RunRotation(BENCH_IMAGE *p) { RotationEx(p->Input, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8, 30); }
+static void RunErosion(BENCH_IMAGE *p) { Erosion(p->Binary, p->Output, p->nWidth, p->nHeight); }
+static void RunDilation(BENCH_IMAGE *p) { Dilation(p->Binary, p->Output, p->nWidth, p->nHeight); }
+static void RunOtsu(BENCH_IMAGE *p) { GenerateAutoBinarization(p->Input, p->Output, p->nWidth, p->nHeight, THRESHOLD_OTSU); }
+
+static void RunMultiOtsu(BENCH_IMAGE *p)
+{
+    int nHisto[256] = {
+        0,
+    };
+    BYTE bThresholds[MAX_OTSU_THRESHOLDS];
+
+    GenerateHistogram(p->Input, nHisto, p->nWidth, p->nHeight);
+    MultiOtsuMethod(nHisto, bThresholds, 2);
+    GenerateMultiLevelBinarization(p->Input, p->Output, p->nWidth, p->nHeight, bThresholds, 2);
+}
+
+static void RunCLAHE(BENCH_IMAGE *p) { CLAHE(p->Input, p->Output, p->nWidth, p->nHeight, 8, 8, 2.0); }
+
+static void RunColorToGray(BENCH_IMAGE *p)
+{
+    IMAGE Color, Gray;
+
+    WrapImage(&Color, p->Color, p->nWidth, p->nHeight, PIXEL_BGR24, 0);
+    WrapImage(&Gray, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8, 0);
+    ConvertToGray(&Color, &Gray);
+}
+
+// 반지름 20 침식 : Erosion을 20번 반복 (Output, Temp를 번갈아 사용)과 거리 변환 한번
+static void RunErosionX20(BENCH_IMAGE *p)
+{
+    Erosion(p->Binary, p->Output, p->nWidth, p->nHeight);
+    for (int k = 1; k < 20; k++)
+        Erosion((k & 1) ? p->Output : p->Temp, (k & 1) ? p->Temp : p->Output, p->nWidth, p->nHeight);
+}
+
+static void RunErosionRadius(BENCH_IMAGE *p, int nMetric)
+{
+    IMAGE In, Out;
+
+    WrapImage(&In, p->Binary, p->nWidth, p->nHeight, PIXEL_GRAY8, 0);
+    WrapImage(&Out, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8, 0);
+    nBenchSink += ImgErosionRadius(&In, &Out, 20.0, nMetric);
+}
+
+static void RunErosionRadiusEuclid(BENCH_IMAGE *p) { RunErosionRadius(p, DIST_EUCLIDEAN); }
+static void RunErosionRadiusCity(BENCH_IMAGE *p) { RunErosionRadius(p, DIST_CITYBLOCK); }
+
+// 원 허프 변환 : 이진 영상에서 반지름 20 ~ 60, 둘레 50% 이상
+static void RunHoughCircles(BENCH_IMAGE *p)
+{
+    static HOUGH_CIRCLE Circles[1024];
+    IMAGE In;
+
+    WrapImage(&In, p->Binary, p->nWidth, p->nHeight, PIXEL_GRAY8, 0);
+    nBenchSink += ImgHoughCircles(&In, 20, 60, 100, 0.5, Circles, 1024);
+}
+
+// 직선 허프 변환 : 이진 영상의 소벨 에지, 점 200개, 길이 50 이상 (점진 방식은 64개 찾으면 끝)
+static void RunHoughLines(BENCH_IMAGE *p, int nMode)
+{
+    static HOUGH_LINE Lines[1024];
+    IMAGE In;
+
+    WrapImage(&In, p->Binary, p->nWidth, p->nHeight, PIXEL_GRAY8, 0);
+    nBenchSink += ImgHoughLines(&In, 100, 200, 50, 3, nMode, Lines, (nMode == HOUGH_LINES_STANDARD) ? 1024 : 64);
+}
+
+static void RunHoughLinesStandard(BENCH_IMAGE *p) { RunHoughLines(p, HOUGH_LINES_STANDARD); }
+static void RunHoughLinesProgressive(BENCH_IMAGE *p) { RunHoughLines(p, HOUGH_LINES_PROGRESSIVE); }
+
+// 워터셰드 : 이진 영상의 객체를 깊이 2픽셀 이상인 곳에서 나눔 (레이블 버퍼는 스레드 메모리 풀에서 다시 사용)
+static void RunWatershedSplit(BENCH_IMAGE *p)
+{
+    int *pLabels = (int *)PoolAlloc(GetThreadPool(), sizeof(int) * (size_t)p->nWidth * p->nHeight, 0);
+    IMAGE In;
+
+    WrapImage(&In, p->Binary, p->nWidth, p->nHeight, PIXEL_GRAY8, 0);
+    nBenchSink += ImgSplitObjects(&In, pLabels, 2.0);
+    PoolFree(GetThreadPool(), pLabels);
+}
+
+// 윤곽선 : 이진 영상의 모든 경계 (윤곽선 목록은 실제 사용처럼 반복마다 재사용)
+static void RunContours(BENCH_IMAGE *p, double dEpsilon)
+{
+    static CONTOUR_SET Set; // 0으로 초기화 = ContourInit
+    IMAGE In;
+
+    WrapImage(&In, p->Binary, p->nWidth, p->nHeight, PIXEL_GRAY8, 0);
+    nBenchSink += ImgFindContours(&In, &Set);
+    if (dEpsilon > 0.0)
+        nBenchSink += SimplifyContours(&Set, dEpsilon) + Set.nPoints;
+}
+
+static void RunFindContours(BENCH_IMAGE *p) { RunContours(p, 0.0); }
+static void RunFindContoursSimplify(BENCH_IMAGE *p) { RunContours(p, 1.0); }
+
+// 영역 채우기 : 이진 영상의 구멍 채우기, 왼쪽 위 픽셀과 이어진 영역을 128로 채우기 (입력은 Temp에 복사해 둠)
+static void RunFillHoles(BENCH_IMAGE *p)
+{
+    IMAGE In, Out;
+
+    WrapImage(&In, p->Binary, p->nWidth, p->nHeight, PIXEL_GRAY8, 0);
+    WrapImage(&Out, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8, 0);
+    nBenchSink += ImgFillHoles(&In, &Out);
+}
+
+static void RunFloodFill(BENCH_IMAGE *p)
+{
+    IMAGE Img;
+
+    WrapImage(&Img, p->Temp, p->nWidth, p->nHeight, PIXEL_GRAY8, 0);
+    nBenchSink += ImgFloodFill(&Img, 0, 0, 128, 0, 8);
+}
+
+// RLE : 이진 영상을 런으로 바꾸기, 런 단위 레이블링과 침식 (변환은 준비 단계에서 해 둠, 버퍼는 반복마다 재사용)
+static RLE_IMAGE BenchRle, BenchRleOut; // 0으로 초기화 = RleInit
+
+static void EncodeBinaryToRle(BENCH_IMAGE *p)
+{
+    IMAGE In;
+
+    WrapImage(&In, p->Binary, p->nWidth, p->nHeight, PIXEL_GRAY8, 0);
+    RleEncode(&In, &BenchRle);
+}
+
+static void RunRleEncode(BENCH_IMAGE *p) { EncodeBinaryToRle(p); nBenchSink += BenchRle.nRuns; }
+
+static void RunRleLabel(BENCH_IMAGE *p)
+{
+    static int *pRunLabels, nMaxLabels;
+
+    (void)p;
+    if (nMaxLabels < BenchRle.nRuns + 1)
+    {
+        free(pRunLabels);
+        nMaxLabels = BenchRle.nRuns + 1;
+        pRunLabels = (int *)malloc(sizeof(int) * nMaxLabels);
+    }
+    nBenchSink += RleLabel(&BenchRle, 8, pRunLabels, NULL);
+}
+
+static void RunRleErosion(BENCH_IMAGE *p)
+{
+    (void)p;
+    nBenchSink += RleErosion(&BenchRle, &BenchRleOut, 1, 1);
+}
+
+// 큰 커널 컨볼루션 : 가운데가 큰 원형 PSF (nSize X nSize, 합 1)
+static const double *GetPsfKernel(int nSize)
+{
+    static double Kernel[51 * 51];
+    static int nCurrent;
+
+    if (nCurrent != nSize)
+    {
+        double dSum = 0.0, dRadius = nSize / 2 + 0.5;
+
+        for (int j = 0; j < nSize; j++)
+            for (int i = 0; i < nSize; i++)
+            {
+                double dx = i - nSize / 2, dy = j - nSize / 2, d = sqrt(dx * dx + dy * dy);
+
+                Kernel[j * nSize + i] = (d < dRadius) ? exp(-d * d / (dRadius * dRadius / 4.0)) : 0.0;
+                dSum += Kernel[j * nSize + i];
+            }
+        for (int i = 0; i < nSize * nSize; i++)
+            Kernel[i] /= dSum;
+        nCurrent = nSize;
+    }
+    return Kernel;
+}
+
+static void RunConvolutionLarge(BENCH_IMAGE *p, int nSize, int nMethod)
+{
+    IMAGE In, Out;
+
+    WrapImage(&In, p->Input, p->nWidth, p->nHeight, PIXEL_GRAY8, 0);
+    WrapImage(&Out, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8, 0);
+    nBenchSink += ImgConvolutionLarge(&In, &Out, GetPsfKernel(nSize), nSize, nSize, CONV_POST_NONE, nMethod);
+}
+
+static void RunConvolution15Direct(BENCH_IMAGE *p) { RunConvolutionLarge(p, 15, CONV_METHOD_DIRECT); }
+static void RunConvolution15Fft(BENCH_IMAGE *p) { RunConvolutionLarge(p, 15, CONV_METHOD_FFT); }
+static void RunConvolution51(BENCH_IMAGE *p) { RunConvolutionLarge(p, 51, CONV_METHOD_AUTO); }
+
+// 같은 커널을 매 프레임 적용 (FFT 필터는 영상 크기가 바뀔 때만 다시 만듦)
+static void RunConvolution51Cached(BENCH_IMAGE *p)
+{
+    static FFT_FILTER Filter; // 0으로 초기화 = 필터 없음
+    IMAGE In, Out;
+
+    if (Filter.nWidth != p->nWidth || Filter.nHeight != p->nHeight)
+    {
+        FftFilterRelease(&Filter);
+        FftFilterKernel(&Filter, p->nWidth, p->nHeight, GetPsfKernel(51), 51, 51, CONV_POST_NONE);
+    }
+    WrapImage(&In, p->Input, p->nWidth, p->nHeight, PIXEL_GRAY8, 0);
+    WrapImage(&Out, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8, 0);
+    nBenchSink += FftFilterApply(&Filter, &In, &Out);
+}
+
+static void RunButterworth(BENCH_IMAGE *p)
+{
+    IMAGE In, Out;
+
+    WrapImage(&In, p->Input, p->nWidth, p->nHeight, PIXEL_GRAY8, 0);
+    WrapImage(&Out, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8, 0);
+    nBenchSink += ImgFrequencyFilter(&In, &Out, FREQ_BUTTERWORTH_LOWPASS, 0.05, 2);
+}
+
+// 가우시안 흐림 : 3x3 가우시안 커널의 분산은 0.5라서 32번 반복하면 σ = 4
+static void RunGaussian3x3x32(BENCH_IMAGE *p)
+{
+    GaussianConvolution(p->Input, p->Temp, p->nWidth, p->nHeight);
+    for (int i = 1; i < 32; i += 2)
+    {
+        GaussianConvolution(p->Temp, p->Work, p->nWidth, p->nHeight);
+        GaussianConvolution(p->Work, p->Temp, p->nWidth, p->nHeight);
+    }
+    GaussianConvolution(p->Temp, p->Output, p->nWidth, p->nHeight);
+}
+
+static void RunGaussianBlur(BENCH_IMAGE *p, double dSigma, int nMethod)
+{
+    IMAGE In, Out;
+
+    WrapImage(&In, p->Input, p->nWidth, p->nHeight, PIXEL_GRAY8, 0);
+    WrapImage(&Out, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8, 0);
+    nBenchSink += ImgGaussianBlur(&In, &Out, dSigma, nMethod);
+}
+
+static void RunGaussianBlur4(BENCH_IMAGE *p) { RunGaussianBlur(p, 4.0, BLUR_RECURSIVE); }
+static void RunGaussianBlur30(BENCH_IMAGE *p) { RunGaussianBlur(p, 30.0, BLUR_RECURSIVE); }
+static void RunGaussianBlur30Box(BENCH_IMAGE *p) { RunGaussianBlur(p, 30.0, BLUR_BOX); }
+
+// 위상 상관 정합 : 입력을 (7, 5) 옮긴 영상을 프레임으로 사용
+static void ShiftInputToWork(BENCH_IMAGE *p) { TranslationEx(p->Input, p->Work, p->nWidth, p->nHeight, PIXEL_GRAY8, 7, 5); }
+
+static void RunPhaseCorrelation(BENCH_IMAGE *p)
+{
+    IMAGE Ref, Frame;
+    double dx, dy;
+
+    WrapImage(&Ref, p->Input, p->nWidth, p->nHeight, PIXEL_GRAY8, 0);
+    WrapImage(&Frame, p->Work, p->nWidth, p->nHeight, PIXEL_GRAY8, 0);
+    nBenchSink += ImgPhaseCorrelate(&Ref, &Frame, &dx, &dy);
+}
+
+// 기준 영상은 그대로 두고 매 프레임 정렬 (기준 영상이 바뀔 때만 다시 준비)
+static void RunPhaseCorrelationCached(BENCH_IMAGE *p)
+{
+    static PHASE_CORR Corr; // 0으로 초기화 = 준비 안 됨
+    static const BYTE *pCurrent;
+    IMAGE Ref, Frame;
+    PHASE_CORR_RESULT Result;
+
+    WrapImage(&Ref, p->Input, p->nWidth, p->nHeight, PIXEL_GRAY8, 0);
+    WrapImage(&Frame, p->Work, p->nWidth, p->nHeight, PIXEL_GRAY8, 0);
+    if (pCurrent != p->Input || Corr.nWidth != p->nWidth || Corr.nHeight != p->nHeight)
+    {
+        PhaseCorrRelease(&Corr);
+        PhaseCorrInit(&Corr, &Ref, 0);
+        pCurrent = p->Input;
+    }
+    nBenchSink += PhaseCorrMatch(&Corr, &Frame, &Result);
+}
+
+// 여러 단계 파이프라인
+// 1. 에지 검출 : Gaussian -> Sobel X, Y -> 합치기 -> Otsu 이진화
+static void RunEdgePipeline(BENCH_IMAGE *p)
+{
+    ConvolutionEx(p->Input, p->Work, p->nWidth, p->nHeight, PIXEL_GRAY8, KERNEL_GAUSSIAN);
+    ConvolutionEx(p->Work, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8, KERNEL_SOBEL_X);
+    ConvolutionEx(p->Work, p->Temp, p->nWidth, p->nHeight, PIXEL_GRAY8, KERNEL_SOBEL_Y);
+    CombineMaxEx(p->Temp, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8);
+    GenerateAutoBinarization(p->Output, p->Temp, p->nWidth, p->nHeight, THRESHOLD_OTSU);
+}
+
+// 2. 잡음 제거 + 대비 향상 : Median 3x3 -> CLAHE -> Otsu 이진화
+static void RunDenoisePipeline(BENCH_IMAGE *p)
+{
+    MedianFilter(p->Input, p->Temp, p->nWidth, p->nHeight);
+    CLAHE(p->Temp, p->Output, p->nWidth, p->nHeight, 8, 8, 2.0);
+    GenerateAutoBinarization(p->Output, p->Temp, p->nWidth, p->nHeight, THRESHOLD_OTSU);
+}
+
+// 3. 객체 추출 : Otsu 이진화 -> 침식 -> 팽창 -> 레이블링
+static void RunMorphologyPipeline(BENCH_IMAGE *p)
+{
+    GenerateAutoBinarization(p->Input, p->Output, p->nWidth, p->nHeight, THRESHOLD_OTSU);
+    Erosion(p->Output, p->Temp, p->nWidth, p->nHeight);
+    Dilation(p->Temp, p->Output, p->nWidth, p->nHeight);
+    ComponentLabeling(p->Output, p->nHeight, p->nWidth, 3);
+}
+
+// 4. 필터 체인 : Gaussian -> Sobel X -> 이진화 -> 팽창 (기능마다 영상 전체를 읽고 씀)
+static void RunChain(BENCH_IMAGE *p)
+{
+    ConvolutionEx(p->Input, p->Work, p->nWidth, p->nHeight, PIXEL_GRAY8, KERNEL_GAUSSIAN);
+    ConvolutionEx(p->Work, p->Temp, p->nWidth, p->nHeight, PIXEL_GRAY8, KERNEL_SOBEL_X);
+    GenerateBinarizationEx(p->Temp, p->Work, p->nWidth, p->nHeight, PIXEL_GRAY8, 60);
+    Dilation(p->Work, p->Output, p->nWidth, p->nHeight);
+}
+
+// 5. 같은 필터 체인을 파이프라인으로 합쳐서 실행 (타일 단위, 입력과 출력만 영상 전체 접근)
+static void RunChainFused(BENCH_IMAGE *p)
+{
+    IMAGE In, Out;
+
+    WrapImage(&In, p->Input, p->nWidth, p->nHeight, PIXEL_GRAY8, 0);
+    WrapImage(&Out, p->Output, p->nWidth, p->nHeight, PIXEL_GRAY8, 0);
+    nBenchSink += PipelineRun(&BenchContext, &BenchChain, &In, &Out);
+}
+
+static const BENCH_OP BenchOps[] = {
+    {"inverse", 1, NULL, RunInverse},
+    {"brightness", 2, NULL, RunBrightness},
+    {"contrast", 3, NULL, RunContrast},
+    {"histogram", 4, NULL, RunHistogram},
+    {"gonzalez_binarization", 5, NULL, RunGonzalez},
+    {"binarization", 6, NULL, RunBinarization},
+    {"histogram_stretching", 7, NULL, RunStretching},
+    {"histogram_equalization", 8, NULL, RunEqualization},
+    {"average_convolution", 9, NULL, RunAverage},
+    {"gaussian_convolution", 10, NULL, RunGaussian},
+    {"laplacian_convolution", 11, NULL, RunLaplacian},
+    {"prewitt_x", 12, NULL, RunPrewittX},
+    {"prewitt_y", 13, NULL, RunPrewittY},
+    {"prewitt", 14, NULL, RunPrewitt},
+    {"sobel_x", 15, NULL, RunSobelX},
+    {"sobel_y", 16, NULL, RunSobelY},
+    {"sobel", 17, NULL, RunSobel},
+    {"hpf_laplacian", 18, NULL, RunHPF},
+    {"median_3x3", 19, NULL, RunMedian3},
+    {"median_5x5", 20, NULL, RunMedian5},
+    {"component_labeling", 21, CopyBinaryToTemp, RunLabeling},
+    {"detect_object_edge", 22, NULL, RunEdge},
+    {"vertical_flip", 23, CopyInputToTemp, RunVerticalFlip},
+    {"horizontal_flip", 24, CopyInputToTemp, RunHorizontalFlip},
+    {"translation", 25, NULL, RunTranslation},
+    {"scaling", 26, NULL, RunScaling},
+    {"rotation", 27, NULL, RunRotation},
+    {"erosion", 28, NULL, RunErosion},
+    {"dilation", 29, NULL, RunDilation},
+    {"otsu_binarization", 30, NULL, RunOtsu},
+    {"multi_otsu", 31, NULL, RunMultiOtsu},
+    {"clahe", 32, NULL, RunCLAHE},
+    {"color_to_gray", 33, NULL, RunColorToGray},
+    {"erosion_x20", 0, NULL, RunErosionX20},
+    {"erosion_radius_20", 0, NULL, RunErosionRadiusEuclid},
+    {"erosion_radius_20_cityblock", 0, NULL, RunErosionRadiusCity},
+    {"hough_circles", 0, NULL, RunHoughCircles},
+    {"hough_lines", 0, NULL, RunHoughLinesStandard},
+    {"hough_lines_progressive", 0, NULL, RunHoughLinesProgressive},
+    {"watershed_split", 0, NULL, RunWatershedSplit},
+    {"find_contours", 0, NULL, RunFindContours},
+    {"find_contours_simplify", 0, NULL, RunFindContoursSimplify},
+    {"fill_holes", 0, NULL, RunFillHoles},
+    {"flood_fill", 0, CopyBinaryToTemp, RunFloodFill},
+    {"rle_encode", 0, NULL, RunRleEncode},
+    {"rle_label", 0, EncodeBinaryToRle, RunRleLabel},
+    {"rle_erosion", 0, EncodeBinaryToRle, RunRleErosion},
+    {"convolution_15x15_direct", 0, NULL, RunConvolution15Direct},
+    {"convolution_15x15_fft", 0, NULL, RunConvolution15Fft},
+    {"convolution_51x51", 0, NULL, RunConvolution51},
+    {"convolution_51x51_cached", 0, NULL, RunConvolution51Cached},
+    {"butterworth_lowpass", 0, NULL, RunButterworth},
+    {"phase_correlation", 0, ShiftInputToWork, RunPhaseCorrelation},
+    {"phase_correlation_cached", 0, ShiftInputToWork, RunPhaseCorrelationCached},
+    {"gaussian_3x3_x32", 0, NULL, RunGaussian3x3x32},
+    {"gaussian_blur_4", 0, NULL, RunGaussianBlur4},
+    {"gaussian_blur_30", 0, NULL, RunGaussianBlur30},
+    {"gaussian_blur_30_box", 0, NULL, RunGaussianBlur30Box},
+    {"pipeline_edge", 0, NULL, RunEdgePipeline},
+    {"pipeline_denoise", 0, NULL, RunDenoisePipeline},
+    {"pipeline_morphology", 0, NULL, RunMorphologyPipeline},
+    {"pipeline_chain", 0, NULL, RunChain},
+    {"pipeline_chain_fused", 0, NULL, RunChainFused},
+};
+
+#define BENCH_OP_COUNT ((int)(sizeof(BenchOps) / sizeof(BenchOps[0])))
+
+/*
+ * @Function Name : AllocBenchImage
+ * @Description : 측정용 버퍼를 할당하고 이진 영상, 컬러 영상을 Input에서 만듭니다.
+ * @Input : *p (szName, nWidth, nHeight, Input 설정됨)
+ * @Output : *p, 반환값 0 (성공) / -1 (메모리 할당 오류)
+ */
+// 김광제의 설명 - 이진 영상은 Otsu 임계값으로, 컬러 영상은 밝기값을 채널마다 조금씩 다르게 바꿔서 만든다.
+static int AllocBenchImage(BENCH_IMAGE *p)
+{
+    size_t nSize = (size_t)p->nWidth * p->nHeight;
+    int nHisto[256] = {
+        0,
+    };
+    BYTE bThreshold;
+
+    p->Binary = (BYTE *)malloc(nSize);
+    p->Color = (BYTE *)malloc(nSize * 3);
+    p->Output = (BYTE *)calloc(nSize, 1);
+    p->Temp = (BYTE *)calloc(nSize, 1);
+    p->Work = (BYTE *)calloc(nSize, 1);
+    if (NULL == p->Binary || NULL == p->Color || NULL == p->Output || NULL == p->Temp || NULL == p->Work)
+        return (-1);
+
+    GenerateHistogram(p->Input, nHisto, p->nWidth, p->nHeight);
+    bThreshold = OtsuMethod(nHisto);
+    for (size_t i = 0; i < nSize; i++)
+    {
+        p->Binary[i] = (p->Input[i] >= bThreshold) ? 255 : 0;
+        p->Color[i * 3] = p->Input[i];
+        p->Color[i * 3 + 1] = (BYTE)(255 - p->Input[i]);
+        p->Color[i * 3 + 2] = (BYTE)(p->Input[i] ^ 0x5A);
+    }
+
+    return 0;
+}
+
+/*
+ * @Function Name : FreeBenchImage
+ * @Description : 측정용 버퍼를 해제합니다.
+ * @Input : *p
+ */
+static void FreeBenchImage(BENCH_IMAGE *p)
+{
+    free(p->Input);
+    free(p->Binary);
+    free(p->Color);
+    free(p->Output);
+    free(p->Temp);
+    free(p->Work);
+    memset(p, 0, sizeof(BENCH_IMAGE));
+}
+
+/*
+ * @Function Name : LoadBenchImage
+ * @Description : 8비트 BMP 파일을 측정용 영상으로 읽습니다.
+ * @Input : *szDir, *szFile
+ * @Output : *p, 반환값 0 (성공) / -1 (파일 없음, 8비트가 아님)
+ */
+static int LoadBenchImage(BENCH_IMAGE *p, const char *szDir, const char *szFile)
+{
+    char szPath[512];
+    FILE *fp;
+    BITMAPFILEHEADER hf;
+    BITMAPINFOHEADER hInfo;
+    RGBQUAD hRGB[256];
+    int nFormat;
+    BYTE *pPixels;
+
+    memset(p, 0, sizeof(BENCH_IMAGE));
+    snprintf(szPath, sizeof(szPath), "%s/%s", szDir, szFile);
+    fp = fopen(szPath, "rb");
+    if (NULL == fp)
+        return (-1);
+
+    pPixels = ReadBitmap(fp, &hf, &hInfo, hRGB, &nFormat);
+    fclose(fp);
+    if (NULL == pPixels || nFormat != PIXEL_GRAY8)
+    {
+        PoolFree(GetThreadPool(), pPixels);
+        return (-1);
+    }
+
+    // 측정용 버퍼는 모두 malloc으로 관리 (버퍼 풀 재사용이 측정 결과에 섞이지 않도록)
+    p->nWidth = hInfo.biWidth;
+    p->nHeight = hInfo.biHeight;
+    p->Input = (BYTE *)malloc((size_t)p->nWidth * p->nHeight);
+    if (NULL == p->Input)
+    {
+        PoolFree(GetThreadPool(), pPixels);
+        return (-1);
+    }
+    memcpy(p->Input, pPixels, (size_t)p->nWidth * p->nHeight);
+    PoolFree(GetThreadPool(), pPixels);
+    snprintf(p->szName, sizeof(p->szName), "%s", szFile);
+
+    return AllocBenchImage(p);
+}
+
+/*
+ * @Function Name : MakeSyntheticImage
+ * @Description : nSize X nSize 크기의 합성 영상(완만한 무늬 + 잡음)을 만듭니다.
+ * @Input : nSize
+ * @Output : *p, 반환값 0 (성공) / -1 (메모리 할당 오류)
+ */
+// 김광제의 설명 - 이진화했을 때 적당한 크기의 객체(레이블)가 여러 개 생기도록 사인 무늬에 잡음을 더한다.
+// 난수는 고정된 시드의 선형 합동 생성기라서 항상 같은 영상이 만들어짐
+static int MakeSyntheticImage(BENCH_IMAGE *p, int nSize)
+{
+    unsigned int nSeed = 12345u;
+
+    memset(p, 0, sizeof(BENCH_IMAGE));
+    p->nWidth = p->nHeight = nSize;
+    snprintf(p->szName, sizeof(p->szName), "synthetic_%d", nSize);
+    p->Input = (BYTE *)malloc((size_t)nSize * nSize);
+    if (NULL == p->Input)
+        return (-1);
+
+    for (int i = 0; i < nSize; i++)
+    {
+        double dRow = sin(i * 0.031);
+        for (int j = 0; j < nSize; j++)
+        {
+            int nValue;
+
+            nSeed = nSeed * 1103515245u + 12345u;
+            nValue = (int)(128.0 + 90.0 * dRow * cos(j * 0.027)) + (int)((nSeed >> 16) % 41) - 20;
+            p->Input[(size_t)i * nSize + j] = (BYTE)((nValue < 0) ? 0 : ((nValue > 255) ? 255 : nValue));
+        }
+    }
+
+    return AllocBenchImage(p);
+}
+
+/*
+ * @Function Name : CompareDouble
+ * @Description : qsort 비교 함수 (오름차순)
+ */
+static int CompareDouble(const void *a, const void *b)
+{
+    double da = *(const double *)a, db = *(const double *)b;
+    return (da > db) - (da < db);
+}
+
+/*
+ * @Function Name : MeasureOp
+ * @Description : pOp를 nRepeat번(최대 dMaxTime초) 실행하여 한 번 실행 시간의 중간값을 구합니다.
+ * @Input : *pOp, *p, nRepeat, dMaxTime
+ * @Output : 중간값 (초), *pRuns - 실제 실행 횟수
+ */
+// 김광제의 설명 - 첫 실행은 캐시, 페이지 폴트 영향이 커서 한번 먼저 실행하고 버린다. (warm-up)
+// 평균 대신 중간값을 사용하여 다른 프로세스 때문에 튀는 값의 영향을 줄임
+static double MeasureOp(const BENCH_OP *pOp, BENCH_IMAGE *p, int nRepeat, double dMaxTime, int *pRuns)
+{
+    double dTimes[64], dStart, dTotal = 0.0, dMedian;
+    int nRuns = 0;
+
+    if (nRepeat > 64)
+        nRepeat = 64;
+
+    if (pOp->Prepare)
+        pOp->Prepare(p);
+    pOp->Run(p);
+
+    while (nRuns < nRepeat && (nRuns == 0 || dTotal < dMaxTime))
+    {
+        if (pOp->Prepare)
+            pOp->Prepare(p);
+
+        dStart = NowSeconds();
+        pOp->Run(p);
+        dTimes[nRuns] = NowSeconds() - dStart;
+        dTotal += dTimes[nRuns];
+        nRuns++;
+    }
+
+    qsort(dTimes, nRuns, sizeof(double), CompareDouble);
+    *pRuns = nRuns;
+    dMedian = (nRuns % 2) ? dTimes[nRuns / 2] : (dTimes[nRuns / 2 - 1] + dTimes[nRuns / 2]) / 2.0;
+
+    // 타이머 해상도보다 짧으면 0이 되어 MP/s가 inf가 되므로 최소 1ns로 제한
+    return (dMedian < 1e-9) ? 1e-9 : dMedian;
+}
+
+/*
+ * @Function Name : IsOpSelected
+ * @Description : --ops 목록에 포함된 기능인지 검사합니다. (목록이 없으면 전체)
+ */
+static int IsOpSelected(const char *szName, char szOps[][64], int nOps)
+{
+    if (nOps == 0)
+        return 1;
+
+    for (int i = 0; i < nOps; i++)
+        if (strcmp(szOps[i], szName) == 0)
+            return 1;
+
+    return 0;
+}
+
+/*
+ * @Function Name : ParseList
+ * @Description : 쉼표로 구분된 문자열을 나눕니다.
+ * @Input : *szList, nMax
+ * @Output : szItems, 반환값 항목 개수
+ */
+static int ParseList(const char *szList, char szItems[][64], int nMax)
+{
+    int nCount = 0;
+    const char *pStart = szList;
+
+    while (*pStart && nCount < nMax)
+    {
+        const char *pEnd = strchr(pStart, ',');
+        size_t nLen = pEnd ? (size_t)(pEnd - pStart) : strlen(pStart);
+
+        if (nLen > 63)
+            nLen = 63;
+        memcpy(szItems[nCount], pStart, nLen);
+        szItems[nCount][nLen] = '\0';
+        if (nLen > 0)
+            nCount++;
+
+        if (NULL == pEnd)
+            break;
+        pStart = pEnd + 1;
+    }
+
+    return nCount;
+}
+
+/*
+ * @Function Name : RunBenchImage
+ * @Description : 영상 하나에 대해 선택된 기능을 스레드 수별로 측정하고 결과를 출력합니다.
+ * @Input : *p, 스레드 목록, 반복 설정, 기능 목록, JSON 파일
+ * @Output : *pbFirst - JSON 배열의 첫 항목인지 (쉼표 처리)
+ */
+static void RunBenchImage(BENCH_IMAGE *p, const int *pThreads, int nThreads, int nRepeat, double dMaxTime,
+                          char szOps[][64], int nOps, FILE *fpJson, int *pbFirst)
+{
+    double dPixels = (double)p->nWidth * p->nHeight;
+
+    for (int o = 0; o < BENCH_OP_COUNT; o++)
+    {
+        const BENCH_OP *pOp = &BenchOps[o];
+
+        if (!IsOpSelected(pOp->szName, szOps, nOps))
+            continue;
+
+        for (int t = 0; t < nThreads; t++)
+        {
+            int nRuns;
+            double dSeconds;
+
+#ifdef _OPENMP
+            omp_set_num_threads(pThreads[t]);
+#endif
+            dSeconds = MeasureOp(pOp, p, nRepeat, dMaxTime, &nRuns);
+
+            printf("%-24s %-18s %5dx%-5d %3d thr %10.3f ms %9.2f MP/s %8.2f ns/px\n", pOp->szName, p->szName,
+                   p->nWidth, p->nHeight, pThreads[t], dSeconds * 1e3, dPixels / dSeconds / 1e6, dSeconds * 1e9 / dPixels);
+            fflush(stdout);
+
+            if (fpJson)
+            {
+                fprintf(fpJson, "%s\n    {\"op\": \"%s\", \"mode\": %d, \"image\": \"%s\", \"width\": %d, \"height\": %d, "
+                                "\"threads\": %d, \"runs\": %d, \"median_ms\": %.6f, \"mpix_per_s\": %.4f, \"ns_per_pixel\": %.4f}",
+                        *pbFirst ? "" : ",", pOp->szName, pOp->nMode, p->szName, p->nWidth, p->nHeight,
+                        pThreads[t], nRuns, dSeconds * 1e3, dPixels / dSeconds / 1e6, dSeconds * 1e9 / dPixels);
+                *pbFirst = 0;
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const char *szDir = ".", *szJson = NULL;
+    const char *szFiles[] = {"coins.bmp", "noise.bmp", "scratch.bmp"};
+    int nMinSize = 256, nMaxSize = 4096, nRepeat = 5;
+    double dMaxTime = 2.0;
+    int nThreads[BENCH_MAX_THREADS], nThreadCount = 0;
+    char szOps[BENCH_MAX_OPS][64], szItems[BENCH_MAX_THREADS][64];
+    int nOps = 0, bFirst = 1;
+    FILE *fpJson = NULL;
+    BENCH_IMAGE Image;
+    OP_PARAM Param;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--images") == 0 && i + 1 < argc)
+            szDir = argv[++i];
+        else if (strcmp(argv[i], "--max-size") == 0 && i + 1 < argc)
+            nMaxSize = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--min-size") == 0 && i + 1 < argc)
+            nMinSize = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc)
+            nRepeat = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--max-time") == 0 && i + 1 < argc)
+            dMaxTime = atof(argv[++i]);
+        else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+            szJson = argv[++i];
+        else if (strcmp(argv[i], "--ops") == 0 && i + 1 < argc)
+            nOps = ParseList(argv[++i], szOps, BENCH_MAX_OPS);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            int nCount = ParseList(argv[++i], szItems, BENCH_MAX_THREADS);
+            for (int t = 0; t < nCount; t++)
+                if (atoi(szItems[t]) > 0)
+                    nThreads[nThreadCount++] = atoi(szItems[t]);
+        }
+        else
+        {
+            printf("usage : %s [--images DIR] [--min-size N] [--max-size N] [--threads 1,2,4] [--repeat N] [--max-time SEC] [--ops a,b] [--json FILE]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (nMaxSize > 16384)
+        nMaxSize = 16384;
+    if (nRepeat < 1)
+        nRepeat = 1;
+
+    // 스레드 목록 기본값 : 1, 2, 4, ... 최대 스레드 수
+    if (nThreadCount == 0)
+    {
+#ifdef _OPENMP
+        int nMax = omp_get_max_threads();
+        for (int t = 1; t < nMax && nThreadCount < BENCH_MAX_THREADS - 1; t *= 2)
+            nThreads[nThreadCount++] = t;
+        nThreads[nThreadCount++] = nMax;
+#else
+        nThreads[nThreadCount++] = 1;
+#endif
+    }
+
+    // 스레드 수는 측정할 때마다 omp_set_num_threads로 정하므로 컨텍스트는 OpenMP 기본값 사용
+    if (ContextInit(&BenchContext, 0, 0) != 0)
+    {
+        printf("Error : this CPU does not support the instruction set used in the build\n");
+        return 1;
+    }
+    memset(&Param, 0, sizeof(OP_PARAM));
+    PipelineInit(&BenchChain);
+    Param.nKernel = KERNEL_GAUSSIAN;
+    PipelineAdd(&BenchChain, OP_CONVOLUTION, &Param);
+    Param.nKernel = KERNEL_SOBEL_X;
+    PipelineAdd(&BenchChain, OP_CONVOLUTION, &Param);
+    Param.nThreshold = 60;
+    PipelineAdd(&BenchChain, OP_BINARIZATION, &Param);
+    PipelineAdd(&BenchChain, OP_DILATION, &Param);
+
+    if (szJson)
+    {
+        fpJson = fopen(szJson, "w");
+        if (NULL == fpJson)
+        {
+            printf("Error : cannot open %s\n", szJson);
+            return 1;
+        }
+#ifdef _OPENMP
+        fprintf(fpJson, "{\n  \"openmp\": true,\n  \"max_threads\": %d,\n", omp_get_max_threads());
+#else
+        fprintf(fpJson, "{\n  \"openmp\": false,\n  \"max_threads\": 1,\n");
+#endif
+        fprintf(fpJson, "  \"repeat\": %d,\n  \"results\": [", nRepeat);
+    }
+
+    // 1. 기준 영상 (파일이 없으면 건너뜀)
+    for (int f = 0; f < 3; f++)
+    {
+        if (LoadBenchImage(&Image, szDir, szFiles[f]) != 0)
+        {
+            printf("skip %s/%s (not found or not 8 bit)\n", szDir, szFiles[f]);
+            FreeBenchImage(&Image);
+            continue;
+        }
+        RunBenchImage(&Image, nThreads, nThreadCount, nRepeat, dMaxTime, szOps, nOps, fpJson, &bFirst);
+        FreeBenchImage(&Image);
+    }
+
+    // 2. 합성 영상 (한 변을 2배씩)
+    for (int nSize = nMinSize; nSize <= nMaxSize; nSize *= 2)
+    {
+        if (MakeSyntheticImage(&Image, nSize) != 0)
+        {
+            printf("skip synthetic_%d (memory allocation error)\n", nSize);
+            FreeBenchImage(&Image);
+            continue;
+        }
+        RunBenchImage(&Image, nThreads, nThreadCount, nRepeat, dMaxTime, szOps, nOps, fpJson, &bFirst);
+        FreeBenchImage(&Image);
+    }
+
+    if (fpJson)
+    {
+        fprintf(fpJson, "\n  ]\n}\n");
+        fclose(fpJson);
+    }
+
+    ContextRelease(&BenchContext);
+    PoolRelease(GetThreadPool());
+    return 0;
+}
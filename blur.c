@@ -0,0 +1,364 @@
+/*
+ * @Name : blur.c
+ * @Description : Image Processing in C - 표준 편차에 상관없이 화소당 계산량이 일정한 가우시안 흐림 (재귀 필터, 상자 흐림 3번)
+ * @Date : 2026. 10. 19
+ * @Revision : 1.0
+ * 1.0 : ImgGaussianBlur (BLUR_RECURSIVE : 3차 재귀 가우시안, BLUR_BOX : 누적 합 상자 흐림 3번), OP_GAUSSIAN_BLUR
+ *
+ * GaussianConvolution은 3x3 커널이라서 표준 편차 σ를 얻으려면 2σ²번 반복해야 하고, 커널을 σ에 맞게 키우면 화소당 (6σ + 1)²번 곱한다.
+ * 재귀 필터는 앞 방향, 뒤 방향 3차 점화식 두번으로 가우시안을 근사하므로 σ가 1이든 100이든 한 축에 화소당 곱셈 8번이다.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "imgprocessing.h"
+#include "profile.h"
+
+#define BLUR_COLUMN_BLOCK 16 // 세로 방향은 이웃한 열 16개를 같이 처리 (double 16개 = 캐시 라인 2개, 점화식 의존성을 열끼리 겹쳐서 숨김)
+#define BLUR_TRANSPOSE_TILE 64 // 결과 저장 전치 단위 (열 64개 X 16행 double = 8KB, L1 캐시 안)
+#define BLUR_BOX_PASSES 3    // 상자 흐림 반복 횟수 (3번이면 가우시안과 거의 같음)
+#define BLUR_POLE_RE 1.4165     // 가우시안 3차 근사 극점 (σ = 2, van Vliet, Young, Verbeek), 복소수 쌍 1.4165 ± 1.00829i와 실수 1.86543
+#define BLUR_POLE_IM 1.00829
+#define BLUR_POLE_REAL 1.86543
+#define BLUR_TAIL_PER_SIGMA 20 // 오른쪽 경계 초기값을 구할 때 영상 밖으로 계산할 길이 (σ당, 재귀 필터 응답이 0이 될 때까지)
+
+// 재귀 가우시안 계수 (w[n] = B x[n] + a1 w[n - 1] + a2 w[n - 2] + a3 w[n - 3], 뒤 방향도 같은 계수)
+typedef struct
+{
+    double B, a[3];
+    double M[9]; // 오른쪽 경계 : 뒤 방향 초기값 y[N], y[N + 1], y[N + 2] = u + M (w[N - 1] - u, w[N - 2] - u, w[N - 3] - u), u = 마지막 화소
+} BLUR_IIR;
+
+/*
+ * @Function Name : IirVariance
+ * @Description : 극점을 1 / q 제곱한 재귀 필터(앞, 뒤 방향)의 분산을 구합니다.
+ * @Input : q
+ * @Output : 반환값 분산, *pReal - 실수 극점, *pRadius, *pAngle - 복소수 극점 쌍의 크기, 각도
+ */
+// 김광제의 설명 - 극점 d인 1차 필터 (1 - 1 / d) / (1 - z^-1 / d)의 분산은 d / (d - 1)²이고, 앞 방향과 뒤 방향을 합치면 두배가 된다.
+static double IirVariance(double q, double *pReal, double *pRadius, double *pAngle)
+{
+    double re, im, sr, si, dDen;
+
+    *pReal = pow(BLUR_POLE_REAL, 1.0 / q);
+    *pRadius = pow(sqrt(BLUR_POLE_RE * BLUR_POLE_RE + BLUR_POLE_IM * BLUR_POLE_IM), 1.0 / q);
+    *pAngle = atan2(BLUR_POLE_IM, BLUR_POLE_RE) / q;
+
+    // 복소수 극점 D : D / (D - 1)² = D conj((D - 1)²) / |D - 1|⁴ (켤레 극점과 합치면 실수부의 두배)
+    re = *pRadius * cos(*pAngle);
+    im = *pRadius * sin(*pAngle);
+    sr = (re - 1.0) * (re - 1.0) - im * im;
+    si = 2.0 * (re - 1.0) * im;
+    dDen = sr * sr + si * si;
+    return 2.0 * *pReal / ((*pReal - 1.0) * (*pReal - 1.0)) + 4.0 * (re * sr + im * si) / dDen;
+}
+
+/*
+ * @Function Name : IirInit
+ * @Description : 표준 편차로 재귀 가우시안 계수와 오른쪽 경계 행렬을 구합니다.
+ * @Input : *pIir, dSigma (0.5 이상)
+ * @Output : *pIir, 반환값 0 (성공) / -1 (메모리 할당 오류)
+ */
+// 김광제의 설명 - 가우시안에 가장 가깝게 맞춘 3차 극점(van Vliet, Young, Verbeek)을 1 / q 제곱하면 모양은 같고 폭만 바뀐다.
+// 분산이 q에 대해 늘어나기만 하므로 이분법으로 분산이 σ²가 되는 q를 찾는다.
+// 왼쪽 경계는 첫 화소가 계속 이어진다고 보면 앞 방향 초기값이 첫 화소 그대로이다. (B + a1 + a2 + a3 = 1)
+// 오른쪽은 앞 방향이 영상 밖에서도 마지막 화소로 계속 진행한 결과가 뒤 방향 초기값이 되어야 한다. (Triggs, Sdika)
+// 마지막 화소와의 차이는 입력 없이 줄어들기만 하므로 차이 (1, 0, 0), (0, 1, 0), (0, 0, 1)을 영상 밖으로 진행, 되돌려서 행렬 M을 만든다.
+static int IirInit(BLUR_IIR *pIir, double dSigma)
+{
+    double qLow = 0.01, qHigh = dSigma + 1.0, dReal, dRadius, dAngle, p1, pRe, pAbs2, *pTail;
+    int nTail = (int)(BLUR_TAIL_PER_SIGMA * dSigma) + 64;
+
+    for (int i = 0; i < 100; i++)
+    {
+        double q = 0.5 * (qLow + qHigh);
+
+        if (IirVariance(q, &dReal, &dRadius, &dAngle) < dSigma * dSigma)
+            qLow = q;
+        else
+            qHigh = q;
+    }
+    IirVariance(0.5 * (qLow + qHigh), &dReal, &dRadius, &dAngle);
+
+    // 분모 (1 - p1 z^-1)(1 - p2 z^-1)(1 - conj(p2) z^-1), p = 1 / 극점
+    p1 = 1.0 / dReal;
+    pRe = cos(dAngle) / dRadius;
+    pAbs2 = 1.0 / (dRadius * dRadius);
+    pIir->a[0] = p1 + 2.0 * pRe;
+    pIir->a[1] = -(pAbs2 + 2.0 * p1 * pRe);
+    pIir->a[2] = p1 * pAbs2;
+    pIir->B = 1.0 - (pIir->a[0] + pIir->a[1] + pIir->a[2]);
+
+    pTail = (double *)malloc(sizeof(double) * (nTail + 3));
+    if (NULL == pTail)
+        return (-1);
+    for (int k = 0; k < 3; k++)
+    {
+        double y1 = 0.0, y2 = 0.0, y3 = 0.0;
+
+        // pTail[0 ~ 2] = w[N - 3], w[N - 2], w[N - 1]의 차이, pTail[3 + j] = w[N + j]의 차이
+        pTail[0] = (k == 2) ? 1.0 : 0.0;
+        pTail[1] = (k == 1) ? 1.0 : 0.0;
+        pTail[2] = (k == 0) ? 1.0 : 0.0;
+        for (int j = 3; j < nTail + 3; j++)
+            pTail[j] = pIir->a[0] * pTail[j - 1] + pIir->a[1] * pTail[j - 2] + pIir->a[2] * pTail[j - 3];
+        for (int j = nTail + 2; j >= 3; j--)
+        {
+            double y = pIir->B * pTail[j] + pIir->a[0] * y1 + pIir->a[1] * y2 + pIir->a[2] * y3;
+
+            y3 = y2;
+            y2 = y1;
+            y1 = y;
+            if (j <= 5)
+                pIir->M[(j - 3) * 3 + k] = y;
+        }
+    }
+    free(pTail);
+    return 0;
+}
+
+/*
+ * @Function Name : RecursiveBlock
+ * @Description : 묶음 버퍼의 줄 BLUR_COLUMN_BLOCK개에 재귀 가우시안을 같이 적용합니다. (제자리, 가장자리 화소가 계속 이어진다고 봄)
+ * @Input : *pIir, *pData - nLength X BLUR_COLUMN_BLOCK (한 칸에 줄마다 값 하나씩), nLength
+ * @Output : *pData
+ */
+// 김광제의 설명 - 점화식은 바로 앞 결과를 기다려야 해서 한 줄만 진행하면 곱셈기가 대부분 논다.
+// 서로 독립인 줄 16개를 나란히 두면 안쪽 루프가 횟수가 정해진 연속 접근이라 SIMD로 나누어지고 의존성 대기도 겹쳐진다.
+static void RecursiveBlock(const BLUR_IIR *pIir, double *pData, int nLength)
+{
+    double B = pIir->B, a1 = pIir->a[0], a2 = pIir->a[1], a3 = pIir->a[2];
+    double u[BLUR_COLUMN_BLOCK], w1[BLUR_COLUMN_BLOCK], w2[BLUR_COLUMN_BLOCK], w3[BLUR_COLUMN_BLOCK];
+
+    for (int c = 0; c < BLUR_COLUMN_BLOCK; c++)
+    {
+        u[c] = pData[(size_t)(nLength - 1) * BLUR_COLUMN_BLOCK + c];
+        w1[c] = w2[c] = w3[c] = pData[c];
+    }
+    for (int i = 0; i < nLength; i++)
+    {
+        double *p = pData + (size_t)i * BLUR_COLUMN_BLOCK;
+
+        for (int c = 0; c < BLUR_COLUMN_BLOCK; c++)
+        {
+            double w = B * p[c] + a1 * w1[c] + a2 * w2[c] + a3 * w3[c];
+
+            w3[c] = w2[c];
+            w2[c] = w1[c];
+            w1[c] = w;
+            p[c] = w;
+        }
+    }
+
+    // 뒤 방향 초기값 (w1, w2, w3 = w[N - 1], w[N - 2], w[N - 3] 자리를 y[N], y[N + 1], y[N + 2]로 다시 사용)
+    for (int c = 0; c < BLUR_COLUMN_BLOCK; c++)
+    {
+        double d1 = w1[c] - u[c], d2 = w2[c] - u[c], d3 = w3[c] - u[c];
+
+        w1[c] = u[c] + pIir->M[0] * d1 + pIir->M[1] * d2 + pIir->M[2] * d3;
+        w2[c] = u[c] + pIir->M[3] * d1 + pIir->M[4] * d2 + pIir->M[5] * d3;
+        w3[c] = u[c] + pIir->M[6] * d1 + pIir->M[7] * d2 + pIir->M[8] * d3;
+    }
+    for (int i = nLength - 1; i >= 0; i--)
+    {
+        double *p = pData + (size_t)i * BLUR_COLUMN_BLOCK;
+
+        for (int c = 0; c < BLUR_COLUMN_BLOCK; c++)
+        {
+            double y = B * p[c] + a1 * w1[c] + a2 * w2[c] + a3 * w3[c];
+
+            w3[c] = w2[c];
+            w2[c] = w1[c];
+            w1[c] = y;
+            p[c] = y;
+        }
+    }
+}
+
+/*
+ * @Function Name : GetBoxRadii
+ * @Description : 상자 흐림 3번의 분산 합이 σ²에 가장 가깝도록 상자 반지름을 정합니다. (Kovesi, 홀수 너비 wl, wl + 2를 섞음)
+ * @Input : dSigma
+ * @Output : Radius[BLUR_BOX_PASSES]
+ */
+// 김광제의 설명 - 너비 w 상자의 분산은 (w² - 1) / 12이고, 여러번 적용하면 분산이 더해지면서 모양이 가우시안에 가까워진다. (중심 극한 정리)
+static void GetBoxRadii(double dSigma, int Radius[BLUR_BOX_PASSES])
+{
+    int n = BLUR_BOX_PASSES, wl = (int)floor(sqrt(12.0 * dSigma * dSigma / n + 1.0)), m;
+
+    if (wl % 2 == 0)
+        wl--;
+    m = (int)floor((12.0 * dSigma * dSigma - n * wl * wl - 4.0 * n * wl - 3.0 * n) / (-4.0 * wl - 4.0) + 0.5);
+    for (int i = 0; i < n; i++)
+        Radius[i] = ((i < m) ? wl : wl + 2) / 2;
+}
+
+/*
+ * @Function Name : BoxPass
+ * @Description : 묶음 버퍼의 줄 BLUR_COLUMN_BLOCK개에 누적 합으로 반지름 nRadius 상자 평균을 구합니다. (가장자리 화소가 계속 이어진다고 봄)
+ * @Input : *pSrc - nLength X BLUR_COLUMN_BLOCK, nLength, nRadius
+ * @Output : *pDst
+ */
+static void BoxPass(const double *pSrc, double *pDst, int nLength, int nRadius)
+{
+    double dSum[BLUR_COLUMN_BLOCK] = {0.0}, dScale = 1.0 / (2 * nRadius + 1);
+
+    for (int k = -nRadius; k <= nRadius; k++)
+    {
+        const double *p = pSrc + (size_t)((k < 0) ? 0 : ((k >= nLength) ? nLength - 1 : k)) * BLUR_COLUMN_BLOCK;
+
+        for (int c = 0; c < BLUR_COLUMN_BLOCK; c++)
+            dSum[c] += p[c];
+    }
+    for (int i = 0; i < nLength; i++)
+    {
+        int nAdd = (i + nRadius + 1 < nLength) ? i + nRadius + 1 : nLength - 1, nSub = (i - nRadius > 0) ? i - nRadius : 0;
+        const double *pAdd = pSrc + (size_t)nAdd * BLUR_COLUMN_BLOCK, *pSub = pSrc + (size_t)nSub * BLUR_COLUMN_BLOCK;
+        double *p = pDst + (size_t)i * BLUR_COLUMN_BLOCK;
+
+        for (int c = 0; c < BLUR_COLUMN_BLOCK; c++)
+        {
+            p[c] = dSum[c] * dScale;
+            dSum[c] += pAdd[c] - pSub[c];
+        }
+    }
+}
+
+/*
+ * @Function Name : FilterBlock
+ * @Description : 묶음 버퍼 하나에 선택한 방법으로 1차원 가우시안 흐림을 적용합니다.
+ * @Input : *pIir, *pRadius, nMethod, *pA - 입력, *pB - 작업 버퍼, nLength
+ * @Output : 반환값 결과가 있는 버퍼 (pA 또는 pB)
+ */
+static double *FilterBlock(const BLUR_IIR *pIir, const int *pRadius, int nMethod, double *pA, double *pB, int nLength)
+{
+    if (nMethod == BLUR_RECURSIVE)
+    {
+        RecursiveBlock(pIir, pA, nLength);
+        return pA;
+    }
+    BoxPass(pA, pB, nLength, pRadius[0]);
+    BoxPass(pB, pA, nLength, pRadius[1]);
+    BoxPass(pA, pB, nLength, pRadius[2]);
+    return pB;
+}
+
+/*
+ * @Function Name : ImgGaussianBlur
+ * @Description : 표준 편차 dSigma 가우시안 흐림을 적용합니다. (화소당 계산량이 σ와 상관없음)
+ * @Input : *pIn - 8, 16비트 그레이 (ROI 가능), dSigma (0.5 이상), nMethod (BLUR_RECURSIVE, BLUR_BOX)
+ * @Output : *pOut - pIn과 같은 형식, 크기 (pIn과 같아도 됨), 반환값 0 (성공) / -1 (입력 오류, 메모리 할당 오류)
+ */
+// 김광제의 설명 - 중간 버퍼는 16행 묶음마다 같은 x의 16행이 연속인 배치라서 가로 처리는 묶음을 그대로 제자리에서 처리한다.
+// 세로는 열 16개를 묶음 버퍼에 옮겨서(행마다 연속 16개) 처리하고, 16 X 16 조각 단위로 전치해서 중간 버퍼에 쓴다.
+// 행 순서 버퍼에 열 묶음을 쓰면 행마다 다른 페이지를 건드리지만, 이 배치에서는 16행이 2KB 한 곳에 모임
+// 가장자리 밖은 가장자리 화소가 계속 이어진다고 보므로 큰 σ로 배경을 구해도 가장자리가 어두워지지 않음
+// BLUR_BOX는 한 축에 화소당 덧셈, 뺄셈 6번이라 재귀 필터보다 빠르지만 응답이 조각별 2차 곡선이라 가우시안과 조금 다르다.
+int ImgGaussianBlur(const IMAGE *pIn, IMAGE *pOut, double dSigma, int nMethod)
+{
+    int nWidth = pIn->nWidth, nHeight = pIn->nHeight, nLength = (nWidth > nHeight) ? nWidth : nHeight, nFailed = 0;
+    int nRowBlocks = (nHeight + BLUR_COLUMN_BLOCK - 1) / BLUR_COLUMN_BLOCK, nColBlocks = (nWidth + BLUR_COLUMN_BLOCK - 1) / BLUR_COLUMN_BLOCK;
+    size_t nBlockSize = (size_t)nWidth * BLUR_COLUMN_BLOCK; // 중간 버퍼 16행 묶음 하나의 크기
+    int Radius[BLUR_BOX_PASSES];
+    double dMax = (pIn->nFormat == PIXEL_GRAY16) ? 65535.0 : 255.0;
+    BLUR_IIR Iir;
+    double *pBuf;
+    PROFILE_BEGIN(dStart);
+
+    if ((pIn->nFormat != PIXEL_GRAY8 && pIn->nFormat != PIXEL_GRAY16) || pOut->nFormat != pIn->nFormat || pOut->nWidth != nWidth ||
+        pOut->nHeight != nHeight || !(dSigma >= 0.5) || (nMethod != BLUR_RECURSIVE && nMethod != BLUR_BOX))
+        return (-1);
+    if (nMethod == BLUR_RECURSIVE && IirInit(&Iir, dSigma) < 0)
+        return (-1);
+    GetBoxRadii(dSigma, Radius);
+
+    pBuf = (double *)PoolAlloc(GetThreadPool(), sizeof(double) * nBlockSize * nRowBlocks, 0);
+    if (NULL == pBuf)
+        return (-1);
+    if (nHeight % BLUR_COLUMN_BLOCK) // 마지막 묶음의 영상 밖 행은 0 (가로 처리에서 SIMD 폭을 채우는 용도)
+        memset(pBuf + nBlockSize * (nRowBlocks - 1), 0, sizeof(double) * nBlockSize);
+
+#pragma omp parallel reduction(+ : nFailed)
+    {
+        double *pA = (double *)malloc(sizeof(double) * nLength * BLUR_COLUMN_BLOCK * 2), *pB = pA + (size_t)nLength * BLUR_COLUMN_BLOCK;
+
+        if (NULL == pA)
+            nFailed++;
+
+        // 1. 세로 (열 묶음마다, 묶음 버퍼 한 칸 = 같은 y의 열 16개)
+#pragma omp for schedule(static)
+        for (int b = 0; b < nColBlocks; b++)
+        {
+            int nX = b * BLUR_COLUMN_BLOCK, nCount = (nWidth - nX < BLUR_COLUMN_BLOCK) ? nWidth - nX : BLUR_COLUMN_BLOCK;
+            double *pResult;
+
+            if (NULL == pA)
+                continue;
+            if (nCount < BLUR_COLUMN_BLOCK)
+                memset(pA, 0, sizeof(double) * nHeight * BLUR_COLUMN_BLOCK);
+            for (int y = 0; y < nHeight; y++)
+            {
+                const BYTE *pSrc = pIn->pPlane[0] + (size_t)y * pIn->nStride;
+                double *pDst = pA + (size_t)y * BLUR_COLUMN_BLOCK;
+
+                if (pIn->nFormat == PIXEL_GRAY16)
+                    for (int c = 0; c < nCount; c++)
+                        pDst[c] = ((const WORD *)pSrc)[nX + c];
+                else
+                    for (int c = 0; c < nCount; c++)
+                        pDst[c] = pSrc[nX + c];
+            }
+            pResult = FilterBlock(&Iir, Radius, nMethod, pA, pB, nHeight);
+            for (int y = 0; y < nHeight; y++)
+            {
+                double *pDst = pBuf + nBlockSize * (y / BLUR_COLUMN_BLOCK) + (size_t)nX * BLUR_COLUMN_BLOCK + y % BLUR_COLUMN_BLOCK;
+                const double *pSrc = pResult + (size_t)y * BLUR_COLUMN_BLOCK;
+
+                for (int c = 0; c < nCount; c++)
+                    pDst[c * BLUR_COLUMN_BLOCK] = pSrc[c];
+            }
+        }
+
+        // 2. 가로 (행 묶음마다 제자리, 결과 저장)
+        // pIn과 pOut이 같아도 세로 처리가 모두 끝난 뒤(omp for 끝의 대기)에 저장함
+#pragma omp for schedule(static)
+        for (int b = 0; b < nRowBlocks; b++)
+        {
+            int nY = b * BLUR_COLUMN_BLOCK, nCount = (nHeight - nY < BLUR_COLUMN_BLOCK) ? nHeight - nY : BLUR_COLUMN_BLOCK;
+            const double *pResult;
+
+            if (NULL == pA)
+                continue;
+            pResult = FilterBlock(&Iir, Radius, nMethod, pBuf + nBlockSize * b, pA, nWidth);
+            for (int x0 = 0; x0 < nWidth; x0 += BLUR_TRANSPOSE_TILE)
+            {
+                int x1 = (x0 + BLUR_TRANSPOSE_TILE < nWidth) ? x0 + BLUR_TRANSPOSE_TILE : nWidth;
+
+                for (int r = 0; r < nCount; r++)
+                {
+                    BYTE *pDst = pOut->pPlane[0] + (size_t)(nY + r) * pOut->nStride;
+
+                    // 음수, 최대값은 먼저 잘라내므로 + 0.5 후 정수 변환이 반올림
+                    for (int x = x0; x < x1; x++)
+                    {
+                        double d = pResult[(size_t)x * BLUR_COLUMN_BLOCK + r];
+
+                        d = (d < 0.0) ? 0.0 : ((d > dMax) ? dMax : d);
+                        if (pOut->nFormat == PIXEL_GRAY16)
+                            ((WORD *)pDst)[x] = (WORD)(d + 0.5);
+                        else
+                            pDst[x] = (BYTE)(d + 0.5);
+                    }
+                }
+            }
+        }
+        free(pA);
+    }
+
+    PoolFree(GetThreadPool(), pBuf);
+    PROFILE_COUNT((nMethod == BLUR_RECURSIVE) ? "gaussian_blur_recursive" : "gaussian_blur_box", 1);
+    PROFILE_END(dStart, "gaussian_blur", (long long)nWidth * nHeight, (long long)nWidth * nHeight * (2 + 2 * sizeof(double)));
+    return (nFailed == 0) ? 0 : (-1);
+}
@@ -0,0 +1,501 @@
+/*
+ * @Name : bmpio.c
+ * @Description : Image Processing in C - BMP 파일 입출력 (Windows, Linux 공통)
+ * @Date : 2026. 10. 19
+ * @Revision : 1.2
+ * 1.0 : imgprocessing.c에서 ReadBitmap, WriteBitmap 분리, fopen_s 대신 ImgOpenFile 사용
+ * 1.1 : RLE8 압축 BMP, 1비트 BMP 읽기/쓰기 (이진 영상, 레이블 영상처럼 같은 값이 많은 결과를 작게 저장),
+ *       WriteImageFile (저장 형식 FILE_xxx 선택, PNG는 pngio.c)
+ * 1.2 : ReadBitmap 헤더 크기 확인 (0 이하, INT_MIN 높이, 행 크기 / 버퍼 크기 넘침, 파일보다 큰 픽셀 데이터)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include "imgprocessing.h"
+#include "profile.h"
+
+/*
+ * @Function Name : ImgOpenFile
+ * @Description : 파일을 엽니다. (MSVC는 fopen_s, 그 외는 fopen)
+ * @Input : *szPath, *szMode - fopen과 같은 모드 문자열 ("rb", "wb")
+ * @Output : *pFp - 연 파일 포인터 (실패하면 NULL),
+ *           반환값 - 0 (성공) / 오류 번호 (errno)
+ */
+// 김광제의 설명 - fopen_s는 MSVC에만 있어서 Linux에서 빌드가 안 된다. 메뉴 프로그램은 이 함수만 사용하고
+// 반환값은 fopen_s와 같이 오류 번호라서 기존의 "file open error = %d" 출력을 그대로 쓸 수 있다.
+int ImgOpenFile(FILE **pFp, const char *szPath, const char *szMode)
+{
+#ifdef _MSC_VER
+    return (int)fopen_s(pFp, szPath, szMode);
+#else
+    *pFp = fopen(szPath, szMode);
+    return (NULL == *pFp) ? errno : 0;
+#endif
+}
+
+/*
+ * @Function Name : DecodeRLE8
+ * @Description : RLE8 압축 픽셀 데이터를 풉니다.
+ * @Input : *fp - 픽셀 데이터 위치, nWidth, nHeight
+ * @Output : *pImage (0으로 초기화된 버퍼, 건너뛴 픽셀은 0), 반환값 0 (성공) / -1 (파일 끝, 잘못된 데이터)
+ */
+// 김광제의 설명 - (개수, 값) 쌍이 기본이고 개수가 0이면 다음 바이트가 명령이다.
+//   0 : 행 끝, 1 : 영상 끝, 2 : (dx, dy) 만큼 이동, 3 이상 : 그 개수만큼 압축하지 않은 픽셀 (2바이트 단위로 패딩)
+// 영상 밖으로 나가는 데이터는 잘못된 파일로 처리
+static int DecodeRLE8(FILE *fp, BYTE *pImage, int nWidth, int nHeight)
+{
+    int x = 0, y = 0, nCount, nValue;
+
+    while (y <= nHeight)
+    {
+        if ((nCount = fgetc(fp)) == EOF || (nValue = fgetc(fp)) == EOF)
+            return (-1);
+
+        if (nCount > 0)
+        {
+            if (y >= nHeight || x + nCount > nWidth)
+                return (-1);
+            memset(pImage + (size_t)y * nWidth + x, nValue, nCount);
+            x += nCount;
+        }
+        else if (nValue == 0)
+        {
+            x = 0;
+            y++;
+        }
+        else if (nValue == 1)
+            return 0;
+        else if (nValue == 2)
+        {
+            int dx = fgetc(fp), dy = fgetc(fp);
+
+            if (dx == EOF || dy == EOF)
+                return (-1);
+            x += dx;
+            y += dy;
+        }
+        else
+        {
+            if (y >= nHeight || x + nValue > nWidth || fread(pImage + (size_t)y * nWidth + x, 1, nValue, fp) != (size_t)nValue)
+                return (-1);
+            x += nValue;
+            if (nValue & 1)
+                fgetc(fp);
+        }
+    }
+
+    return (-1);
+}
+
+/*
+ * @Function Name : ReadRows1
+ * @Description : 1비트 픽셀 데이터를 읽어서 팔레트의 밝기값으로 바꿉니다.
+ * @Input : *fp - 픽셀 데이터 위치, nWidth, nHeight, bTopDown, *pRGB - 2색 팔레트
+ * @Output : *pImage, *pRGB - 0 ~ 255 그레이 팔레트로 바뀜, 반환값 0 (성공) / -1 (파일 끝)
+ */
+// 김광제의 설명 - 한 바이트에 왼쪽 픽셀부터 상위 비트에 8개씩 들어있고, 한 행은 4바이트 배수로 패딩
+static int ReadRows1(FILE *fp, BYTE *pImage, int nWidth, int nHeight, int bTopDown, RGBQUAD *pRGB)
+{
+    int nFileRow = ((nWidth + 31) / 32) * 4;
+    BYTE *pRow = (BYTE *)PoolAlloc(GetThreadPool(), nFileRow, 0);
+    BYTE Gray[2] = {pRGB[0].rgbGreen, pRGB[1].rgbGreen};
+    int nRet = 0;
+
+    if (NULL == pRow)
+        return (-1);
+
+    for (int i = 0; i < nHeight && nRet == 0; i++)
+    {
+        BYTE *pDst = pImage + (size_t)(bTopDown ? (nHeight - 1 - i) : i) * nWidth;
+
+        if (fread(pRow, 1, nFileRow, fp) != (size_t)nFileRow)
+            nRet = (-1);
+        for (int j = 0; j < nWidth && nRet == 0; j++)
+            pDst[j] = Gray[(pRow[j >> 3] >> (7 - (j & 7))) & 1];
+    }
+
+    for (int i = 0; i < 256; i++)
+    {
+        pRGB[i].rgbBlue = pRGB[i].rgbGreen = pRGB[i].rgbRed = (BYTE)i;
+        pRGB[i].rgbReserved = 0;
+    }
+
+    PoolFree(GetThreadPool(), pRow);
+    return nRet;
+}
+
+/*
+ * @Function Name : ReadBitmap
+ * @Description : BMP 파일(1비트, 8비트 팔레트(RLE8 포함), 16비트 그레이, 24/32비트 컬러)을 읽습니다.
+ * @Input : *fp - 읽기 모드로 연 파일 포인터
+ * @Output : *pHf, *pInfo - BMP 헤더 (높이는 항상 양수로 저장),
+ *           *pRGB - 팔레트 (8비트일 때만, 256개),
+ *           *pFormat - 픽셀 형식 (PIXEL_xxx),
+ *           반환값 - 픽셀 데이터 (행 패딩이 없는 연속된 버퍼, 스레드 버퍼 풀에서 가져오므로 PoolFree(GetThreadPool(), ...)로 반납, 실패하면 NULL)
+ */
+// 김광제의 설명 - BMP는 한 행이 4바이트 배수가 되도록 패딩이 들어가 있어서 너비가 4의 배수가 아니면 그냥 읽으면 영상이 밀린다.
+// 행 단위로 읽으면서 패딩은 버리고, 픽셀 데이터는 bfOffBits 위치부터 시작하도록 처리
+// 16비트는 BI_BITFIELDS 마스크가 R, G, B 모두 같은 경우만 그레이로 취급함 (고비트 카메라 데이터)
+// 높이가 음수인 (위에서 아래로 저장된) 파일은 기존 함수들과 같은 순서가 되도록 아래에서 위 순서로 바꿔서 저장
+// 1비트는 8비트 그레이(팔레트의 밝기값)로 바꿔서 반환
+// 일괄 처리는 아무 파일이나 읽으므로 헤더의 크기는 할당 전에 모두 확인 (버퍼 크기는 int 범위, 처리 함수들이 int로 계산)
+BYTE *ReadBitmap(FILE *fp, BITMAPFILEHEADER *pHf, BITMAPINFOHEADER *pInfo, RGBQUAD *pRGB, int *pFormat)
+{
+    DWORD dwMasks[3] = {
+        0,
+    };
+    int nWidth, nHeight, nBpp, nRowBytes, nPadBytes, bTopDown, nRet;
+    BYTE *pImage;
+    BYTE Pad[4];
+    PROFILE_BEGIN(dStart);
+
+    if (fread(pHf, sizeof(BITMAPFILEHEADER), 1, fp) != 1 || fread(pInfo, sizeof(BITMAPINFOHEADER), 1, fp) != 1)
+        return NULL;
+
+    if (pHf->bfType != 0x4D42) // "BM"
+        return NULL;
+
+    // 너비, 높이가 0 이하 (높이의 부호는 저장 방향), abs(INT_MIN)은 정의되지 않음
+    if (pInfo->biWidth <= 0 || pInfo->biHeight == 0 || pInfo->biHeight == INT_MIN)
+        return NULL;
+
+    nWidth = pInfo->biWidth;
+    nHeight = abs(pInfo->biHeight);
+    bTopDown = (pInfo->biHeight < 0);
+
+    // BI_BITFIELDS 마스크는 정보 헤더 바로 뒤에 있음 (V4, V5 헤더는 헤더 안의 같은 위치)
+    if (pInfo->biCompression == BMP_BITFIELDS)
+    {
+        fseek(fp, sizeof(BITMAPFILEHEADER) + 40, SEEK_SET);
+        if (fread(dwMasks, sizeof(DWORD), 3, fp) != 3)
+            return NULL;
+    }
+
+    switch (pInfo->biBitCount)
+    {
+    case 1:
+        // 2색 팔레트 (읽을 때 팔레트의 밝기값으로 바꿔서 8비트 그레이로 저장)
+        fseek(fp, sizeof(BITMAPFILEHEADER) + pInfo->biSize, SEEK_SET);
+        memset(pRGB, 0, sizeof(RGBQUAD) * 256);
+        if (fread(pRGB, sizeof(RGBQUAD), 2, fp) != 2)
+            return NULL;
+        *pFormat = PIXEL_GRAY8;
+        break;
+    case 8:
+        // 팔레트는 정보 헤더 뒤에 biClrUsed개 (0이면 256개)
+        fseek(fp, sizeof(BITMAPFILEHEADER) + pInfo->biSize, SEEK_SET);
+        memset(pRGB, 0, sizeof(RGBQUAD) * 256);
+        if (fread(pRGB, sizeof(RGBQUAD), (pInfo->biClrUsed && pInfo->biClrUsed < 256) ? pInfo->biClrUsed : 256, fp) == 0)
+            return NULL;
+        *pFormat = PIXEL_GRAY8;
+        break;
+    case 16:
+        if (pInfo->biCompression != BMP_BITFIELDS || dwMasks[0] != dwMasks[1] || dwMasks[1] != dwMasks[2])
+            return NULL; // RGB555, RGB565는 지원하지 않음
+        *pFormat = PIXEL_GRAY16;
+        break;
+    case 24:
+        *pFormat = PIXEL_BGR24;
+        break;
+    case 32:
+        *pFormat = PIXEL_BGRA32;
+        break;
+    default:
+        return NULL;
+    }
+
+    if (pInfo->biCompression != BMP_RGB && pInfo->biCompression != BMP_BITFIELDS && !(pInfo->biCompression == BMP_RLE8 && pInfo->biBitCount == 8))
+        return NULL; // RLE4 압축 파일은 지원하지 않음
+    if (pInfo->biCompression == BMP_RLE8 && bTopDown)
+        return NULL; // RLE 압축 파일은 항상 아래에서 위 순서
+
+    // 파일의 행 크기 (nWidth * biBitCount + 31)와 버퍼 크기 (nRowBytes * nHeight)가 int를 넘지 않아야 함
+    nBpp = GetBytesPerPixel(*pFormat);
+    if (nWidth > (INT_MAX - 31) / 32 || nHeight > INT_MAX / (nWidth * nBpp))
+        return NULL;
+    nRowBytes = nWidth * nBpp;
+    nPadBytes = ((nWidth * pInfo->biBitCount + 31) / 32) * 4 - nRowBytes;
+
+    // 압축하지 않은 파일은 픽셀 데이터가 파일 안에 있어야 함 (작은 깨진 파일로 큰 버퍼를 할당하지 않도록)
+    if (pInfo->biCompression != BMP_RLE8)
+    {
+        long nFileSize;
+
+        if (fseek(fp, 0, SEEK_END) != 0 || (nFileSize = ftell(fp)) < 0 || (long long)nFileSize < pHf->bfOffBits ||
+            ((long long)nFileSize - pHf->bfOffBits) / ((nWidth * pInfo->biBitCount + 31) / 32 * 4) < nHeight)
+            return NULL;
+    }
+
+    // 전부 파일에서 읽으므로 초기화하지 않음 (RLE8은 건너뛴 픽셀이 0이 되도록 초기화)
+    pImage = (BYTE *)PoolAlloc(GetThreadPool(), (size_t)nRowBytes * nHeight, pInfo->biCompression == BMP_RLE8);
+    if (NULL == pImage)
+        return NULL;
+
+    fseek(fp, pHf->bfOffBits, SEEK_SET);
+    if (pInfo->biCompression == BMP_RLE8)
+        nRet = DecodeRLE8(fp, pImage, nWidth, nHeight);
+    else if (pInfo->biBitCount == 1)
+        nRet = ReadRows1(fp, pImage, nWidth, nHeight, bTopDown, pRGB);
+    else
+    {
+        nRet = 0;
+        for (int i = 0; i < nHeight && nRet == 0; i++)
+        {
+            int nRow = bTopDown ? (nHeight - 1 - i) : i;
+            if (fread(pImage + (size_t)nRow * nRowBytes, 1, nRowBytes, fp) != (size_t)nRowBytes ||
+                (nPadBytes > 0 && fread(Pad, 1, nPadBytes, fp) != (size_t)nPadBytes))
+                nRet = (-1);
+        }
+    }
+
+    if (nRet != 0)
+    {
+        PoolFree(GetThreadPool(), pImage);
+        return NULL;
+    }
+
+    pInfo->biHeight = nHeight;
+    PROFILE_COUNT("bmp_bytes_read", (long long)(nRowBytes + nPadBytes) * nHeight);
+    PROFILE_END(dStart, "read_bitmap", (long long)nWidth * nHeight, (long long)nRowBytes * nHeight);
+    return pImage;
+}
+
+/*
+ * @Function Name : WriteBitmap
+ * @Description : 픽셀 형식에 맞는 헤더, 팔레트(8비트), 마스크(16비트)와 행 패딩을 포함하여 BMP 파일을 저장합니다.
+ * @Input : *fp - 쓰기 모드로 연 파일 포인터,
+ *          *pHf, *pInfo - 원본 BMP 헤더,
+ *          *pRGB - 팔레트 (8비트일 때만 사용),
+ *          *Image - 패딩이 없는 픽셀 데이터,
+ *          nFormat - 픽셀 형식
+ * @Output : 반환값 0 (성공) / -1 (파일 쓰기 오류)
+ */
+// 김광제의 설명 - 원본 헤더를 그대로 쓰면 팔레트 개수나 패딩이 맞지 않을 수 있어서 크기와 오프셋을 다시 계산해서 저장
+int WriteBitmap(FILE *fp, BITMAPFILEHEADER *pHf, BITMAPINFOHEADER *pInfo, RGBQUAD *pRGB, BYTE *Image, int nFormat)
+{
+    BITMAPFILEHEADER hf = *pHf;
+    BITMAPINFOHEADER hInfo = *pInfo;
+    DWORD dwMasks[3] = {0xFFFF, 0xFFFF, 0xFFFF}; // 16비트 그레이 마스크
+    BYTE Pad[4] = {
+        0,
+    };
+    int nBpp = GetBytesPerPixel(nFormat);
+    int nRowBytes = hInfo.biWidth * nBpp;
+    int nStride = ((nRowBytes + 3) / 4) * 4; // 4바이트 배수로 맞춘 한 행의 크기
+    int nHeader = sizeof(BITMAPFILEHEADER) + sizeof(BITMAPINFOHEADER);
+    PROFILE_BEGIN(dStart);
+
+    if (nFormat == PIXEL_GRAY8)
+        nHeader += sizeof(RGBQUAD) * 256;
+    else if (nFormat == PIXEL_GRAY16)
+        nHeader += sizeof(dwMasks);
+
+    hInfo.biSize = sizeof(BITMAPINFOHEADER);
+    hInfo.biBitCount = (unsigned short)(nBpp * 8);
+    hInfo.biCompression = (nFormat == PIXEL_GRAY16) ? BMP_BITFIELDS : BMP_RGB;
+    hInfo.biSizeImage = nStride * hInfo.biHeight;
+    hInfo.biClrUsed = 0;
+    hInfo.biClrImportant = 0;
+    hf.bfOffBits = nHeader;
+    hf.bfSize = nHeader + hInfo.biSizeImage;
+
+    fwrite(&hf, sizeof(BYTE), sizeof(BITMAPFILEHEADER), fp);
+    fwrite(&hInfo, sizeof(BYTE), sizeof(BITMAPINFOHEADER), fp);
+    if (nFormat == PIXEL_GRAY8)
+        fwrite(pRGB, sizeof(RGBQUAD), 256, fp);
+    else if (nFormat == PIXEL_GRAY16)
+        fwrite(dwMasks, sizeof(DWORD), 3, fp);
+
+    for (int i = 0; i < hInfo.biHeight; i++)
+    {
+        if (fwrite(Image + (size_t)i * nRowBytes, 1, nRowBytes, fp) != (size_t)nRowBytes)
+            return (-1);
+        if (nStride > nRowBytes)
+            fwrite(Pad, 1, nStride - nRowBytes, fp);
+    }
+
+    PROFILE_COUNT("bmp_bytes_written", hf.bfSize);
+    PROFILE_END(dStart, "write_bitmap", (long long)hInfo.biWidth * hInfo.biHeight, (long long)nRowBytes * hInfo.biHeight);
+    return 0;
+}
+
+/*
+ * @Function Name : WriteHeaders
+ * @Description : 파일 헤더, 정보 헤더, 팔레트를 저장합니다. (WriteBitmapRLE8, WriteBitmap1 공통)
+ * @Input : *fp, *pHf, *pInfo - 원본 헤더, nBitCount, nCompression, nColors - 팔레트 개수, *pRGB, nImageBytes - 픽셀 데이터 크기
+ * @Output : 반환값 0 (성공) / -1 (파일 쓰기 오류)
+ */
+static int WriteHeaders(FILE *fp, const BITMAPFILEHEADER *pHf, const BITMAPINFOHEADER *pInfo, int nBitCount, int nCompression,
+                        int nColors, const RGBQUAD *pRGB, size_t nImageBytes)
+{
+    BITMAPFILEHEADER hf = *pHf;
+    BITMAPINFOHEADER hInfo = *pInfo;
+    int nHeader = sizeof(BITMAPFILEHEADER) + sizeof(BITMAPINFOHEADER) + sizeof(RGBQUAD) * nColors;
+
+    hInfo.biSize = sizeof(BITMAPINFOHEADER);
+    hInfo.biBitCount = (unsigned short)nBitCount;
+    hInfo.biCompression = nCompression;
+    hInfo.biSizeImage = (unsigned int)nImageBytes;
+    hInfo.biClrUsed = nColors;
+    hInfo.biClrImportant = 0;
+    hf.bfType = 0x4D42;
+    hf.bfOffBits = nHeader;
+    hf.bfSize = (unsigned int)(nHeader + nImageBytes);
+
+    if (fwrite(&hf, sizeof(BITMAPFILEHEADER), 1, fp) != 1 || fwrite(&hInfo, sizeof(BITMAPINFOHEADER), 1, fp) != 1 ||
+        fwrite(pRGB, sizeof(RGBQUAD), nColors, fp) != (size_t)nColors)
+        return (-1);
+    return 0;
+}
+
+/*
+ * @Function Name : WriteBitmapRLE8
+ * @Description : 8비트 그레이 영상을 RLE8 압축 BMP로 저장합니다.
+ * @Input : *fp, *pHf, *pInfo - 원본 BMP 헤더, *pRGB - 팔레트 (256개), *Image - 패딩이 없는 픽셀 데이터
+ * @Output : 반환값 0 (성공) / -1 (메모리 할당 오류, 파일 쓰기 오류)
+ */
+// 김광제의 설명 - 같은 값이 2개 이상 이어지면 (개수, 값), 아니면 다음 반복이 나올 때까지 압축하지 않은 구간 (3개 이상일 때만)으로 저장한다.
+// 이진 영상, 레이블 영상은 한 행이 몇 개의 (개수, 값)으로 끝나서 수십 분의 1 크기가 됨
+// 압축한 크기를 헤더에 먼저 써야 하므로 버퍼에 압축한 다음 저장 (최악의 경우 한 행당 원본의 2배 + 행 끝 2바이트)
+int WriteBitmapRLE8(FILE *fp, BITMAPFILEHEADER *pHf, BITMAPINFOHEADER *pInfo, RGBQUAD *pRGB, BYTE *Image)
+{
+    int nWidth = pInfo->biWidth, nHeight = pInfo->biHeight;
+    size_t nMax = (size_t)nHeight * (2 * (size_t)nWidth + 2) + 2, n = 0;
+    BYTE *pData = (BYTE *)PoolAlloc(GetThreadPool(), nMax, 0);
+    int nRet;
+    PROFILE_BEGIN(dStart);
+
+    if (NULL == pData)
+        return (-1);
+
+    for (int i = 0; i < nHeight; i++)
+    {
+        const BYTE *pRow = Image + (size_t)i * nWidth;
+        int j = 0;
+
+        while (j < nWidth)
+        {
+            int nRun = 1, nLiteral;
+
+            while (j + nRun < nWidth && nRun < 255 && pRow[j + nRun] == pRow[j])
+                nRun++;
+            if (nRun >= 2)
+            {
+                pData[n++] = (BYTE)nRun;
+                pData[n++] = pRow[j];
+                j += nRun;
+                continue;
+            }
+
+            // 다음 반복(같은 값 2개)이 시작되기 전까지 압축하지 않은 구간
+            nLiteral = 1;
+            while (j + nLiteral < nWidth && nLiteral < 255 && !(j + nLiteral + 1 < nWidth && pRow[j + nLiteral] == pRow[j + nLiteral + 1]))
+                nLiteral++;
+            if (nLiteral < 3)
+            {
+                for (int k = 0; k < nLiteral; k++)
+                {
+                    pData[n++] = 1;
+                    pData[n++] = pRow[j + k];
+                }
+            }
+            else
+            {
+                pData[n++] = 0;
+                pData[n++] = (BYTE)nLiteral;
+                memcpy(pData + n, pRow + j, nLiteral);
+                n += nLiteral;
+                if (nLiteral & 1)
+                    pData[n++] = 0;
+            }
+            j += nLiteral;
+        }
+
+        // 행 끝 (마지막 행은 영상 끝)
+        pData[n++] = 0;
+        pData[n++] = (i == nHeight - 1) ? 1 : 0;
+    }
+    if (nHeight == 0)
+    {
+        pData[n++] = 0;
+        pData[n++] = 1;
+    }
+
+    nRet = WriteHeaders(fp, pHf, pInfo, 8, BMP_RLE8, 256, pRGB, n);
+    if (nRet == 0 && fwrite(pData, 1, n, fp) != n)
+        nRet = (-1);
+
+    PoolFree(GetThreadPool(), pData);
+    PROFILE_COUNT("bmp_bytes_written", n);
+    PROFILE_END(dStart, "write_bitmap_rle8", (long long)nWidth * nHeight, (long long)nWidth * nHeight + n);
+    return nRet;
+}
+
+/*
+ * @Function Name : WriteBitmap1
+ * @Description : 이진 영상(0, 255)을 1비트 BMP로 저장합니다.
+ * @Input : *fp, *pHf, *pInfo - 원본 BMP 헤더, *Image - 패딩이 없는 8비트 픽셀 데이터
+ * @Output : 반환값 0 (성공) / -1 (0, 255 이외의 값이 있음, 메모리 할당 오류, 파일 쓰기 오류)
+ */
+// 김광제의 설명 - 팔레트는 0 : 검정, 1 : 흰색 두 개라서 0, 255만 있는 영상만 그대로 복원된다. 다른 값이 있으면 저장하지 않음
+int WriteBitmap1(FILE *fp, BITMAPFILEHEADER *pHf, BITMAPINFOHEADER *pInfo, BYTE *Image)
+{
+    int nWidth = pInfo->biWidth, nHeight = pInfo->biHeight;
+    int nFileRow = ((nWidth + 31) / 32) * 4;
+    RGBQUAD Palette[2] = {{0, 0, 0, 0}, {255, 255, 255, 0}};
+    BYTE *pRow;
+    int nRet;
+    PROFILE_BEGIN(dStart);
+
+    for (size_t i = 0; i < (size_t)nWidth * nHeight; i++)
+        if (Image[i] != 0 && Image[i] != 255)
+            return (-1);
+
+    pRow = (BYTE *)PoolAlloc(GetThreadPool(), nFileRow, 0);
+    if (NULL == pRow)
+        return (-1);
+
+    nRet = WriteHeaders(fp, pHf, pInfo, 1, BMP_RGB, 2, Palette, (size_t)nFileRow * nHeight);
+    for (int i = 0; i < nHeight && nRet == 0; i++)
+    {
+        const BYTE *pSrc = Image + (size_t)i * nWidth;
+
+        memset(pRow, 0, nFileRow);
+        for (int j = 0; j < nWidth; j++)
+            pRow[j >> 3] |= (BYTE)((pSrc[j] & 1) << (7 - (j & 7)));
+        if (fwrite(pRow, 1, nFileRow, fp) != (size_t)nFileRow)
+            nRet = (-1);
+    }
+
+    PoolFree(GetThreadPool(), pRow);
+    PROFILE_COUNT("bmp_bytes_written", (long long)nFileRow * nHeight);
+    PROFILE_END(dStart, "write_bitmap_1bit", (long long)nWidth * nHeight, (long long)nWidth * nHeight + (long long)nFileRow * nHeight);
+    return nRet;
+}
+
+/*
+ * @Function Name : WriteImageFile
+ * @Description : nFileFormat(FILE_xxx) 형식으로 영상을 저장합니다.
+ * @Input : *fp, *pHf, *pInfo, *pRGB, *Image, nFormat - 픽셀 형식, nFileFormat - 저장 형식
+ * @Output : 반환값 0 (성공) / -1 (지원하지 않는 형식 조합, 쓰기 오류)
+ */
+// 김광제의 설명 - RLE8, 1비트는 8비트 그레이에서만 사용할 수 있다. (1비트는 0, 255만 있는 이진 영상)
+int WriteImageFile(FILE *fp, BITMAPFILEHEADER *pHf, BITMAPINFOHEADER *pInfo, RGBQUAD *pRGB, BYTE *Image, int nFormat, int nFileFormat)
+{
+    switch (nFileFormat)
+    {
+    case FILE_BMP:
+        return WriteBitmap(fp, pHf, pInfo, pRGB, Image, nFormat);
+    case FILE_BMP_RLE8:
+        return (nFormat == PIXEL_GRAY8) ? WriteBitmapRLE8(fp, pHf, pInfo, pRGB, Image) : (-1);
+    case FILE_BMP_1BIT:
+        return (nFormat == PIXEL_GRAY8) ? WriteBitmap1(fp, pHf, pInfo, Image) : (-1);
+    case FILE_PNG:
+        return WritePng(fp, Image, pInfo->biWidth, pInfo->biHeight, nFormat);
+    default:
+        return (-1);
+    }
+}
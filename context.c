@@ -0,0 +1,357 @@
+/*
+ * @Name : context.c
+ * @Description : Image Processing in C - 처리 컨텍스트 (버퍼 풀, 스레드 수, CPU 기능)와 기능 번호로 호출하는 RunOperation
+ * @Date : 2026. 10. 19
+ * @Revision : 1.4
+ * 1.0 : ContextInit, ContextRelease, RunOperation, GetCpuFeatures, GetOperationName
+ * 1.1 : OP_EROSION_RADIUS, OP_DILATION_RADIUS (distance.c)
+ * 1.2 : OP_FILL_HOLES (fill.c)
+ * 1.3 : OP_FREQUENCY_FILTER (fft.c)
+ * 1.4 : OP_GAUSSIAN_BLUR (blur.c)
+ *
+ * 서비스처럼 오래 실행되면서 메모리의 영상을 계속 처리하는 프로그램은 컨텍스트를 한번 만들어 두고 RunOperation만 호출한다.
+ * 중간 버퍼는 컨텍스트의 풀에서 재사용되므로 두번째 호출부터는 할당이 없다.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h> // _xgetbv
+#endif
+#include "imgprocessing.h"
+#include "profile.h"
+
+// 기능 번호별 정보
+typedef struct
+{
+    const char *szName; // 기능 이름 (프로파일, 로그용)
+    int bOverwrite;     // 출력 영상의 모든 픽셀을 새로 쓰는지 (0이면 처리 전에 출력을 0으로 초기화)
+} OP_INFO;
+
+// OP_xxx 순서
+static const OP_INFO OpTable[OP_COUNT] = {
+    {"copy", 1},
+    {"inverse", 1},
+    {"brightness", 1},
+    {"contrast", 1},
+    {"binarization", 1},
+    {"auto_binarization", 1},
+    {"histogram_stretching", 1},
+    {"histogram_equalization", 1},
+    {"convolution", 0},
+    {"median_filtering", 0},
+    {"vertical_flip", 1},
+    {"horizontal_flip", 1},
+    {"translation", 0},
+    {"scaling", 0},
+    {"rotation", 0},
+    {"erosion", 0},
+    {"dilation", 0},
+    {"detect_object_edge", 1},
+    {"component_labeling", 1},
+    {"clahe", 1},
+    {"combine_max", 1},
+    {"convert_to_gray", 1},
+    {"erosion_radius", 1},
+    {"dilation_radius", 1},
+    {"fill_holes", 1},
+    {"frequency_filter", 1},
+    {"gaussian_blur", 1},
+};
+
+/*
+ * @Function Name : GetCpuFeatures
+ * @Description : 실행 중인 CPU가 지원하는 SIMD 기능을 반환합니다.
+ * @Output : CPU_xxx 조합 (x86이 아니면 0)
+ */
+// 김광제의 설명 - AVX2는 CPU뿐 아니라 운영체제가 YMM 레지스터를 저장해 주는지(XGETBV)도 확인해야 한다.
+// GCC, Clang은 __builtin_cpu_supports가 둘 다 확인해 줌
+int GetCpuFeatures(void)
+{
+    int nFeatures = 0;
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2"))
+        nFeatures |= CPU_SSE2;
+    if (__builtin_cpu_supports("ssse3"))
+        nFeatures |= CPU_SSSE3;
+    if (__builtin_cpu_supports("avx2"))
+        nFeatures |= CPU_AVX2;
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int Info[4];
+
+    __cpuid(Info, 0);
+    if (Info[0] >= 1)
+    {
+        int nMaxLeaf = Info[0];
+
+        __cpuid(Info, 1);
+        if (Info[3] & (1 << 26))
+            nFeatures |= CPU_SSE2;
+        if (Info[2] & (1 << 9))
+            nFeatures |= CPU_SSSE3;
+
+        // OSXSAVE, AVX 비트와 XCR0의 XMM, YMM 상태 저장 비트 확인 후 leaf 7의 AVX2 비트
+        if ((Info[2] & (1 << 27)) && (Info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6 && nMaxLeaf >= 7)
+        {
+            __cpuidex(Info, 7, 0);
+            if (Info[1] & (1 << 5))
+                nFeatures |= CPU_AVX2;
+        }
+    }
+#endif
+
+    return nFeatures;
+}
+
+/*
+ * @Function Name : GetBuildFeatures
+ * @Description : 빌드할 때 사용하도록 지정한 SIMD 기능을 반환합니다. (-march=native, /arch:AVX2 등)
+ * @Output : CPU_xxx 조합
+ */
+// 김광제의 설명 - imgprocessing.c의 IMGPROC_SSE2, IMGPROC_SSSE3와 같은 조건을 사용 (컴파일 옵션은 라이브러리 전체에 같이 적용됨)
+static int GetBuildFeatures(void)
+{
+    int nFeatures = 0;
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    nFeatures |= CPU_SSE2;
+#endif
+#if defined(__SSSE3__) || defined(__AVX__)
+    nFeatures |= CPU_SSSE3;
+#endif
+#if defined(__AVX2__)
+    nFeatures |= CPU_AVX2;
+#endif
+
+    return nFeatures;
+}
+
+/*
+ * @Function Name : ContextInit
+ * @Description : 처리 컨텍스트를 초기화합니다.
+ * @Input : nThreads - OpenMP 스레드 수 (0이면 OpenMP 기본값),
+ *          nMaxCached - 풀이 보관할 최대 바이트 수 (0이면 POOL_DEFAULT_MAX_CACHED)
+ * @Output : *pCtx, 반환값 0 (성공) / -1 (빌드할 때 사용한 SIMD 기능을 이 CPU가 지원하지 않음)
+ */
+// 김광제의 설명 - -march=native로 빌드한 파일을 다른 CPU에서 실행하면 처리 도중에 잘못된 명령어로 죽기 때문에
+// 처음 한번 CPU 기능을 확인해서 미리 실패하도록 한다. (호출할 때마다 확인하지 않음)
+int ContextInit(IMGPROC_CONTEXT *pCtx, int nThreads, size_t nMaxCached)
+{
+    memset(pCtx, 0, sizeof(IMGPROC_CONTEXT));
+    PoolInit(&pCtx->Pool, nMaxCached);
+    pCtx->nThreads = (nThreads > 0) ? nThreads : 0;
+    pCtx->nCpuFeatures = GetCpuFeatures();
+    pCtx->nBuildFeatures = GetBuildFeatures();
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    if ((pCtx->nBuildFeatures & pCtx->nCpuFeatures) != pCtx->nBuildFeatures)
+        return (-1);
+#endif
+
+    return 0;
+}
+
+/*
+ * @Function Name : ContextRelease
+ * @Description : 컨텍스트의 풀에 보관중인 버퍼를 모두 해제합니다.
+ * @Input : *pCtx
+ */
+void ContextRelease(IMGPROC_CONTEXT *pCtx)
+{
+    PoolRelease(&pCtx->Pool);
+}
+
+/*
+ * @Function Name : GetOperationName
+ * @Description : 기능 번호의 이름을 반환합니다.
+ * @Input : nOp - OP_xxx
+ * @Output : 이름 (잘못된 번호면 NULL)
+ */
+const char *GetOperationName(int nOp)
+{
+    if (nOp < 0 || nOp >= OP_COUNT)
+        return NULL;
+    return OpTable[nOp].szName;
+}
+
+/*
+ * @Function Name : ClearImage
+ * @Description : 영상(ROI 가능)의 모든 픽셀을 0으로 채웁니다.
+ * @Input : *pImg
+ */
+static void ClearImage(IMAGE *pImg)
+{
+    int nUnits = (pImg->nLayout == LAYOUT_PLANAR) ? pImg->nChannels : 1;
+    size_t nRowBytes = (size_t)pImg->nWidth * ((pImg->nLayout == LAYOUT_PLANAR) ? 1 : GetBytesPerPixel(pImg->nFormat));
+
+    for (int u = 0; u < nUnits; u++)
+        for (int i = 0; i < pImg->nHeight; i++)
+            memset(pImg->pPlane[u] + (size_t)i * pImg->nStride, 0, nRowBytes);
+}
+
+/*
+ * @Function Name : AutoBinarization
+ * @Description : 8비트 그레이 영상(ROI 가능)의 히스토그램으로 임계값을 정해서 이진화합니다.
+ * @Input : *pIn, nMethod - THRESHOLD_xxx
+ * @Output : *pOut, *pThreshold - 구한 임계값, 반환값 0 (성공) / -1 (입력 오류)
+ */
+static int AutoBinarization(const IMAGE *pIn, IMAGE *pOut, int nMethod, int *pThreshold)
+{
+    int Histogram[256] = {
+        0,
+    };
+
+    if (pIn->nFormat != PIXEL_GRAY8 || ImgHistogram(pIn, Histogram) != 0)
+        return (-1);
+
+    *pThreshold = SelectThreshold(Histogram, nMethod);
+    return ImgBinarization(pIn, pOut, (unsigned int)*pThreshold);
+}
+
+/*
+ * @Function Name : RunOperation
+ * @Description : 기능 번호(OP_xxx)의 처리를 컨텍스트의 풀과 스레드 수로 실행합니다.
+ * @Input : *pCtx, nOp - OP_xxx, *pIn, *pParam - 기능별 인자 (NULL이면 모두 0)
+ * @Output : *pOut - 결과 (pIn과 크기, 형식, 저장 방식이 같아야 함, OP_TO_GRAY는 8비트 그레이),
+ *           반환값 0 (성공) / -1 (잘못된 기능 번호, 입력 오류, 메모리 할당 오류)
+ */
+// 김광제의 설명 - 메뉴 프로그램의 switch를 라이브러리에서 쓸 수 있게 만든 것. 입력은 보존된다. (뒤집기, 레이블링은 출력에 복사 후 처리)
+// 가장자리나 빈 영역을 쓰지 않는 기능(컨볼루션, 기하 변환 등)은 이전 결과가 남지 않도록 출력을 먼저 0으로 채운다.
+// OpenMP 스레드 수는 호출한 스레드의 설정만 바꿨다가 되돌리므로 같은 프로세스의 다른 코드에 영향이 없음
+int RunOperation(IMGPROC_CONTEXT *pCtx, int nOp, const IMAGE *pIn, IMAGE *pOut, OP_PARAM *pParam)
+{
+    OP_PARAM Param;
+    BUFFER_POOL *pPrevPool;
+    int nRet = (-1);
+#ifdef _OPENMP
+    int nPrevThreads = omp_get_max_threads();
+#endif
+    PROFILE_BEGIN(dStart);
+
+    if (nOp < 0 || nOp >= OP_COUNT)
+        return (-1);
+
+    if (NULL == pParam)
+    {
+        memset(&Param, 0, sizeof(OP_PARAM));
+        pParam = &Param;
+    }
+
+    pPrevPool = SetThreadPool(&pCtx->Pool);
+#ifdef _OPENMP
+    if (pCtx->nThreads > 0)
+        omp_set_num_threads(pCtx->nThreads);
+#endif
+
+    if (!OpTable[nOp].bOverwrite && pIn != pOut && pIn->pPlane[0] != pOut->pPlane[0])
+        ClearImage(pOut);
+
+    switch (nOp)
+    {
+    case OP_COPY:
+        nRet = CopyImage(pIn, pOut);
+        break;
+    case OP_INVERSE:
+        nRet = ImgInverse(pIn, pOut);
+        break;
+    case OP_BRIGHTNESS:
+        nRet = ImgAdjustBrightness(pIn, pOut, pParam->nBrightness);
+        break;
+    case OP_CONTRAST:
+        nRet = ImgAdjustContrast(pIn, pOut, pParam->dContrast);
+        break;
+    case OP_BINARIZATION:
+        nRet = ImgBinarization(pIn, pOut, (unsigned int)pParam->nThreshold);
+        break;
+    case OP_AUTO_BINARIZATION:
+        nRet = AutoBinarization(pIn, pOut, pParam->nMethod, &pParam->nThreshold);
+        break;
+    case OP_STRETCHING:
+        nRet = ImgHistogramStretching(pIn, pOut);
+        break;
+    case OP_EQUALIZATION:
+        nRet = ImgHistogramEqualization(pIn, pOut);
+        break;
+    case OP_CONVOLUTION:
+        nRet = ImgConvolution(pIn, pOut, pParam->nKernel);
+        break;
+    case OP_MEDIAN:
+        nRet = ImgMedianFiltering(pIn, pOut, pParam->nSize);
+        break;
+    case OP_VERTICAL_FLIP:
+        nRet = CopyImage(pIn, pOut);
+        if (nRet == 0)
+            ImgVerticalFlip(pOut);
+        break;
+    case OP_HORIZONTAL_FLIP:
+        nRet = CopyImage(pIn, pOut);
+        if (nRet == 0)
+            ImgHorizontalFlip(pOut);
+        break;
+    case OP_TRANSLATION:
+        nRet = ImgTranslation(pIn, pOut, pParam->Tx, pParam->Ty);
+        break;
+    case OP_SCALING:
+        nRet = ImgScaling(pIn, pOut, pParam->Sx, pParam->Sy);
+        break;
+    case OP_ROTATION:
+        nRet = ImgRotation(pIn, pOut, pParam->Angle);
+        break;
+    case OP_EROSION:
+        nRet = ImgErosion(pIn, pOut);
+        break;
+    case OP_DILATION:
+        nRet = ImgDilation(pIn, pOut);
+        break;
+    case OP_EDGE:
+        nRet = ImgDetectObjectEdge(pIn, pOut);
+        break;
+    case OP_LABELING:
+        nRet = CopyImage(pIn, pOut);
+        if (nRet == 0)
+            nRet = ImgComponentLabeling(pOut, pParam->nLabel);
+        break;
+    case OP_CLAHE:
+        nRet = ImgCLAHE(pIn, pOut, (pParam->nTilesX > 0) ? pParam->nTilesX : 8, (pParam->nTilesY > 0) ? pParam->nTilesY : 8,
+                        (pParam->dClipLimit > 0.0) ? pParam->dClipLimit : 2.0);
+        break;
+    case OP_COMBINE_MAX:
+        nRet = ImgCombineMax(pIn, pOut);
+        break;
+    case OP_TO_GRAY:
+        nRet = ConvertToGray(pIn, pOut);
+        break;
+    case OP_EROSION_RADIUS:
+        nRet = ImgErosionRadius(pIn, pOut, pParam->dRadius, pParam->nMetric);
+        break;
+    case OP_DILATION_RADIUS:
+        nRet = ImgDilationRadius(pIn, pOut, pParam->dRadius, pParam->nMetric);
+        break;
+    case OP_FILL_HOLES:
+        nRet = ImgFillHoles(pIn, pOut);
+        break;
+    case OP_FREQUENCY_FILTER:
+        nRet = ImgFrequencyFilter(pIn, pOut, pParam->nMethod, pParam->dRadius, (pParam->nSize > 0) ? pParam->nSize : 2);
+        break;
+    case OP_GAUSSIAN_BLUR:
+        nRet = ImgGaussianBlur(pIn, pOut, pParam->dRadius, pParam->nMethod);
+        break;
+    }
+
+#ifdef _OPENMP
+    if (pCtx->nThreads > 0)
+        omp_set_num_threads(nPrevThreads);
+#endif
+    SetThreadPool(pPrevPool);
+    pCtx->nCalls++;
+
+    PROFILE_END(dStart, "run_operation", (long long)pIn->nWidth * pIn->nHeight, 0);
+    return nRet;
+}
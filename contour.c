@@ -0,0 +1,410 @@
+/*
+ * @Name : contour.c
+ * @Description : Image Processing in C - 이진 영상 윤곽선 추적 (점 목록, 바깥 경계 / 구멍 계층)
+ * @Date : 2026. 10. 19
+ * @Revision : 1.0
+ * 1.0 : ImgFindContours (Suzuki-Abe 경계 추적, 래스터 스캔 한번), SimplifyContours (Douglas-Peucker), CONTOUR_SET
+ *
+ * DetectObjectEdge는 경계 픽셀을 영상으로만 남기므로 둘레, 넓이, 모양을 재려면 에지 영상을 다시 전부 훑어야 한다.
+ * 경계를 따라가면서 점 목록으로 저장하면 객체마다 경계 점 수만큼만 보면 되고, 구멍이 어느 객체 안에 있는지도 같이 나온다.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "imgprocessing.h"
+#include "profile.h"
+
+#define CONTOUR_INIT_CONTOURS 64 // 처음 할당하는 윤곽선 수 (모자라면 2배씩)
+#define CONTOUR_INIT_POINTS 4096 // 처음 할당하는 점 수 (모자라면 2배씩)
+
+/*
+ * @Function Name : ContourInit
+ * @Description : 윤곽선 목록을 빈 상태로 초기화합니다.
+ * @Input : *pSet
+ */
+void ContourInit(CONTOUR_SET *pSet)
+{
+    memset(pSet, 0, sizeof(CONTOUR_SET));
+}
+
+/*
+ * @Function Name : ContourRelease
+ * @Description : 윤곽선 목록의 메모리를 해제합니다. (다시 쓰려면 ContourInit 필요 없음)
+ * @Input : *pSet
+ */
+void ContourRelease(CONTOUR_SET *pSet)
+{
+    free(pSet->pContours);
+    free(pSet->pPoints);
+    memset(pSet, 0, sizeof(CONTOUR_SET));
+}
+
+/*
+ * @Function Name : AddContour
+ * @Description : 윤곽선 목록 끝에 점이 없는 윤곽선을 하나 추가합니다.
+ * @Input : *pSet, bHole, nParent
+ * @Output : 반환값 0 (성공) / -1 (메모리 할당 오류)
+ */
+static int AddContour(CONTOUR_SET *pSet, int bHole, int nParent)
+{
+    CONTOUR *pContour;
+
+    if (pSet->nContours == pSet->nMaxContours)
+    {
+        int nMax = (pSet->nMaxContours > 0) ? pSet->nMaxContours * 2 : CONTOUR_INIT_CONTOURS;
+        CONTOUR *pNew = (CONTOUR *)realloc(pSet->pContours, sizeof(CONTOUR) * nMax);
+
+        if (NULL == pNew)
+            return (-1);
+        pSet->pContours = pNew;
+        pSet->nMaxContours = nMax;
+    }
+
+    pContour = &pSet->pContours[pSet->nContours++];
+    pContour->nFirst = pSet->nPoints;
+    pContour->nCount = 0;
+    pContour->bHole = bHole;
+    pContour->nParent = nParent;
+    return 0;
+}
+
+/*
+ * @Function Name : AddPoint
+ * @Description : 마지막 윤곽선에 점 하나를 추가합니다.
+ * @Input : *pSet, x, y
+ * @Output : 반환값 0 (성공) / -1 (메모리 할당 오류)
+ */
+static int AddPoint(CONTOUR_SET *pSet, int x, int y)
+{
+    if (pSet->nPoints == pSet->nMaxPoints)
+    {
+        int nMax = (pSet->nMaxPoints > 0) ? pSet->nMaxPoints * 2 : CONTOUR_INIT_POINTS;
+        CONTOUR_POINT *pNew = (CONTOUR_POINT *)realloc(pSet->pPoints, sizeof(CONTOUR_POINT) * nMax);
+
+        if (NULL == pNew)
+            return (-1);
+        pSet->pPoints = pNew;
+        pSet->nMaxPoints = nMax;
+    }
+
+    pSet->pPoints[pSet->nPoints].x = x;
+    pSet->pPoints[pSet->nPoints].y = y;
+    pSet->nPoints++;
+    pSet->pContours[pSet->nContours - 1].nCount++;
+    return 0;
+}
+
+/*
+ * @Function Name : FollowBorder
+ * @Description : p0에서 시작하는 경계를 따라 한 바퀴 돌면서 점을 저장하고 경계 픽셀에 nBorder를 표시합니다. (Suzuki-Abe 3단계)
+ * @Input : *pMap - 한 픽셀 0으로 둘러싼 표시 버퍼 (0 : 배경, 1 : 아직 경계가 아닌 전경), nMapWidth, p0 - 시작 픽셀,
+ *          nStart - 시작 픽셀에서 본 배경 이웃 방향 (바깥 경계는 왼쪽, 구멍은 오른쪽), nBorder - 경계 번호
+ * @Output : *pSet - 마지막 윤곽선에 점 추가, 반환값 0 (성공) / -1 (메모리 할당 오류)
+ */
+// 김광제의 설명 - 방향 번호는 오른쪽(0)부터 시계 방향으로 0 ~ 7 (y가 아래로 커지는 영상 좌표)
+// 1. 시작 픽셀 주변을 시계 방향으로 돌며 첫 전경 p1을 찾는다. (없으면 점 하나짜리 객체)
+// 2. 현재 픽셀 주변을 직전 픽셀 다음 방향부터 반시계 방향으로 돌며 다음 전경 픽셀을 찾는다.
+//    오른쪽 이웃이 배경인 것을 확인했으면 -nBorder (그 행을 스캔할 때 오른쪽이 배경이라 새 구멍이 아님을 표시), 아직 1이면 nBorder
+// 3. 다시 시작 픽셀로 돌아와서 다음 픽셀이 p1이면 한 바퀴가 끝난 것이다.
+static int FollowBorder(int *pMap, int nMapWidth, long long p0, int nStart, int nBorder, CONTOUR_SET *pSet)
+{
+    const long long nOffset[8] = {1, nMapWidth + 1, nMapWidth, nMapWidth - 1, -1, -(long long)nMapWidth - 1, -(long long)nMapWidth,
+                                  -(long long)nMapWidth + 1};
+    long long p1 = -1, p3 = p0;
+    int nPrev = 0;
+
+    // 1. 첫 전경 이웃 (시계 방향)
+    for (int k = 0; k < 8; k++)
+    {
+        int d = (nStart + k) & 7;
+
+        if (pMap[p0 + nOffset[d]] != 0)
+        {
+            p1 = p0 + nOffset[d];
+            nPrev = d;
+            break;
+        }
+    }
+    if (p1 < 0)
+    {
+        pMap[p0] = -nBorder;
+        return AddPoint(pSet, (int)(p0 % nMapWidth) - 1, (int)(p0 / nMapWidth) - 1);
+    }
+
+    for (;;)
+    {
+        long long p4;
+        int d = nPrev, bRightEmpty = 0;
+
+        if (AddPoint(pSet, (int)(p3 % nMapWidth) - 1, (int)(p3 / nMapWidth) - 1) < 0)
+            return (-1);
+
+        // 2. 다음 전경 이웃 (반시계 방향, 직전 픽셀은 전경이므로 반드시 찾음)
+        for (int k = 1; k <= 8; k++)
+        {
+            d = (nPrev - k) & 7;
+            if (pMap[p3 + nOffset[d]] != 0)
+                break;
+            if (d == 0)
+                bRightEmpty = 1;
+        }
+
+        if (bRightEmpty)
+            pMap[p3] = -nBorder;
+        else if (pMap[p3] == 1)
+            pMap[p3] = nBorder;
+
+        // 3. 한 바퀴
+        p4 = p3 + nOffset[d];
+        if (p4 == p0 && p3 == p1)
+            break;
+        nPrev = (d + 4) & 7; // 다음 픽셀에서 본 현재 픽셀 방향
+        p3 = p4;
+    }
+    return 0;
+}
+
+/*
+ * @Function Name : ImgFindContours
+ * @Description : 8비트 이진 영상에서 모든 객체(전경 255, 8연결)의 바깥 경계와 구멍(배경 4연결) 경계를 점 목록으로 찾습니다.
+ * @Input : *pIn - 8비트 이진 영상 (ROI 가능, 255가 아닌 값은 배경), *pSet - ContourInit으로 초기화한 윤곽선 목록 (이전 결과는 지움)
+ * @Output : *pSet - 윤곽선 (래스터 스캔에서 처음 만난 순서), 반환값 윤곽선 수 / -1 (입력 오류, 메모리 할당 오류)
+ */
+// 김광제의 설명 - Suzuki-Abe 경계 추적. 영상을 한번 래스터 스캔하면서
+// 1. 왼쪽이 배경인 1 픽셀은 새 바깥 경계, 오른쪽이 배경인 전경 픽셀은 (이미 따라간 경계의 오른쪽 끝이 아니면) 새 구멍 경계의 시작이다.
+// 2. 새 경계를 찾으면 FollowBorder로 한 바퀴 돌고, 지나온 픽셀에 경계 번호를 표시해서 같은 경계를 다시 시작하지 않는다.
+// 3. 스캔하면서 마지막으로 지나간 경계 번호(LNBD)가 새 경계를 바로 둘러싼 경계거나 그 경계의 형제라서 계층이 같이 정해진다.
+//    (새 경계와 LNBD의 종류가 같으면 LNBD의 부모가, 다르면 LNBD가 부모)
+// 영상 밖은 배경으로 보고, 표시 버퍼는 한 픽셀 둘러싼 int 버퍼라서 가장자리 검사가 없다.
+int ImgFindContours(const IMAGE *pIn, CONTOUR_SET *pSet)
+{
+    int nWidth = pIn->nWidth, nHeight = pIn->nHeight, nMapWidth = nWidth + 2, nRet = 0;
+    size_t nMapSize = (size_t)nMapWidth * (nHeight + 2);
+    int *pMap, *pParent = NULL, *pHole = NULL, nBorder = 1, nMaxBorder = 0;
+    PROFILE_BEGIN(dStart);
+
+    if (pIn->nFormat != PIXEL_GRAY8 || NULL == pSet)
+        return (-1);
+    pSet->nContours = 0;
+    pSet->nPoints = 0;
+
+    pMap = (int *)PoolAlloc(GetThreadPool(), nMapSize * sizeof(int), 0);
+    if (NULL == pMap)
+        return (-1);
+
+    // 표시 버퍼 (전경 1, 배경과 둘레 0)
+    memset(pMap, 0, sizeof(int) * nMapWidth);
+    memset(pMap + (size_t)(nHeight + 1) * nMapWidth, 0, sizeof(int) * nMapWidth);
+#pragma omp parallel for schedule(static)
+    for (int y = 0; y < nHeight; y++)
+    {
+        const BYTE *pRow = pIn->pPlane[0] + (size_t)y * pIn->nStride;
+        int *pDst = pMap + (size_t)(y + 1) * nMapWidth;
+
+        pDst[0] = pDst[nWidth + 1] = 0;
+        for (int x = 0; x < nWidth; x++)
+            pDst[x + 1] = (pRow[x] == 255);
+    }
+
+    for (int y = 1; y <= nHeight && nRet == 0; y++)
+    {
+        int nLast = 1; // LNBD (행 시작은 영상 둘레 = 1)
+        int *pRow = pMap + (size_t)y * nMapWidth;
+
+        for (int x = 1; x <= nWidth; x++)
+        {
+            int f = pRow[x], bHole, nStart, nParent;
+
+            if (f == 0)
+                continue;
+
+            if (f == 1 && pRow[x - 1] == 0)
+            {
+                bHole = 0; // 바깥 경계 (왼쪽이 배경)
+                nStart = 4;
+            }
+            else if (f >= 1 && pRow[x + 1] == 0)
+            {
+                bHole = 1; // 구멍 경계 (오른쪽이 배경)
+                nStart = 0;
+                if (f > 1)
+                    nLast = f;
+            }
+            else
+            {
+                if (f != 1)
+                    nLast = (f > 0) ? f : -f;
+                continue;
+            }
+
+            // 경계 번호 2부터 (1은 영상 둘레), 번호 n의 윤곽선은 pContours[n - 2]
+            if (nBorder + 1 >= nMaxBorder)
+            {
+                int nMax = (nMaxBorder > 0) ? nMaxBorder * 2 : CONTOUR_INIT_CONTOURS;
+                int *pNewParent = (int *)realloc(pParent, sizeof(int) * nMax), *pNewHole;
+
+                if (NULL != pNewParent)
+                    pParent = pNewParent;
+                pNewHole = (NULL != pNewParent) ? (int *)realloc(pHole, sizeof(int) * nMax) : NULL;
+                if (NULL == pNewHole)
+                {
+                    nRet = -1;
+                    break;
+                }
+                pHole = pNewHole;
+                if (nMaxBorder == 0)
+                {
+                    pParent[1] = 0; // 영상 둘레 (구멍처럼 취급, 부모 없음)
+                    pHole[1] = 1;
+                }
+                nMaxBorder = nMax;
+            }
+            nBorder++;
+            nParent = (pHole[nLast] == bHole) ? pParent[nLast] : nLast;
+            pParent[nBorder] = nParent;
+            pHole[nBorder] = bHole;
+
+            if (AddContour(pSet, bHole, (nParent >= 2) ? nParent - 2 : -1) < 0 ||
+                FollowBorder(pMap, nMapWidth, (long long)y * nMapWidth + x, nStart, nBorder, pSet) < 0)
+            {
+                nRet = -1;
+                break;
+            }
+
+            f = pRow[x];
+            if (f != 1)
+                nLast = (f > 0) ? f : -f;
+        }
+    }
+
+    free(pParent);
+    free(pHole);
+    PoolFree(GetThreadPool(), pMap);
+    PROFILE_COUNT("contours", pSet->nContours);
+    PROFILE_COUNT("contour_points", pSet->nPoints);
+    PROFILE_END(dStart, "find_contours", (long long)nWidth * nHeight, (long long)nWidth * nHeight * (1 + 2 * sizeof(int)));
+    return (nRet == 0) ? pSet->nContours : (-1);
+}
+
+/*
+ * @Function Name : LineDistance
+ * @Description : 점 c에서 a, b를 지나는 직선까지의 거리 (a, b가 같으면 a까지의 거리)
+ */
+static double LineDistance(const CONTOUR_POINT *a, const CONTOUR_POINT *b, const CONTOUR_POINT *c)
+{
+    double dx = b->x - a->x, dy = b->y - a->y, dLength = sqrt(dx * dx + dy * dy);
+
+    if (dLength == 0.0)
+        return sqrt((double)(c->x - a->x) * (c->x - a->x) + (double)(c->y - a->y) * (c->y - a->y));
+    return fabs(dx * (c->y - a->y) - dy * (c->x - a->x)) / dLength;
+}
+
+/*
+ * @Function Name : SimplifyChain
+ * @Description : 닫힌 윤곽선의 nFirst ~ nLast 구간(nLast는 nCount이면 첫 점)에서 남길 점을 Douglas-Peucker로 표시합니다.
+ * @Input : *pPoints - 윤곽선의 점, nCount, nFirst, nLast, dEpsilon, *pStack - 2 X nCount 작업 버퍼
+ * @Output : *pKeep - 남길 점 1
+ */
+// 김광제의 설명 - 구간 양 끝을 잇는 직선에서 가장 먼 점이 dEpsilon보다 멀면 그 점을 남기고 두 구간으로 나눠서 반복한다.
+// 긴 윤곽선에서 재귀가 깊어지지 않도록 구간을 스택에 넣어서 처리
+static void SimplifyChain(const CONTOUR_POINT *pPoints, int nCount, int nFirst, int nLast, double dEpsilon, BYTE *pKeep, int *pStack)
+{
+    int nTop = 0;
+
+    pStack[nTop++] = nFirst;
+    pStack[nTop++] = nLast;
+    while (nTop > 0)
+    {
+        int nEnd = pStack[--nTop], nBegin = pStack[--nTop], nFar = -1;
+        double dFar = dEpsilon;
+
+        for (int i = nBegin + 1; i < nEnd; i++)
+        {
+            double d = LineDistance(&pPoints[nBegin], &pPoints[nEnd % nCount], &pPoints[i]);
+
+            if (d > dFar)
+            {
+                dFar = d;
+                nFar = i;
+            }
+        }
+        if (nFar < 0)
+            continue;
+        pKeep[nFar] = 1;
+        pStack[nTop++] = nBegin;
+        pStack[nTop++] = nFar;
+        pStack[nTop++] = nFar;
+        pStack[nTop++] = nEnd;
+    }
+}
+
+/*
+ * @Function Name : SimplifyContours
+ * @Description : 모든 윤곽선을 Douglas-Peucker로 줄입니다. (원래 윤곽선과 dEpsilon 픽셀 안에 있는 다각형의 꼭짓점만 남김)
+ * @Input : *pSet - ImgFindContours 결과, dEpsilon - 허용 거리 (픽셀, 0보다 커야 함)
+ * @Output : *pSet - 남은 점 (원래 점 중 일부, 순서 유지), 반환값 0 (성공) / -1 (입력 오류, 메모리 할당 오류)
+ */
+// 김광제의 설명 - 닫힌 윤곽선은 양 끝이 같아서 그대로 나눌 수 없으므로 첫 점과 그 점에서 가장 먼 점을 남기고 두 구간으로 나눈다.
+// 점이 줄기만 하므로 앞에서부터 같은 배열에 다시 채워 넣는다.
+int SimplifyContours(CONTOUR_SET *pSet, double dEpsilon)
+{
+    int nMaxCount = 0, nOut = 0;
+    BYTE *pKeep;
+    int *pStack;
+
+    if (NULL == pSet || !(dEpsilon > 0.0))
+        return (-1);
+
+    for (int c = 0; c < pSet->nContours; c++)
+        if (pSet->pContours[c].nCount > nMaxCount)
+            nMaxCount = pSet->pContours[c].nCount;
+
+    pKeep = (BYTE *)PoolAlloc(GetThreadPool(), (size_t)nMaxCount + 1, 0);
+    pStack = (int *)PoolAlloc(GetThreadPool(), sizeof(int) * 2 * ((size_t)nMaxCount + 1), 0);
+    if (NULL == pKeep || NULL == pStack)
+    {
+        PoolFree(GetThreadPool(), pKeep);
+        PoolFree(GetThreadPool(), pStack);
+        return (-1);
+    }
+
+    for (int c = 0; c < pSet->nContours; c++)
+    {
+        CONTOUR *pContour = &pSet->pContours[c];
+        const CONTOUR_POINT *pPoints = pSet->pPoints + pContour->nFirst;
+        int nCount = pContour->nCount, nFar = 0;
+        long long nFarSq = -1;
+
+        memset(pKeep, 0, nCount);
+        for (int i = 0; i < nCount; i++)
+        {
+            long long dx = pPoints[i].x - pPoints[0].x, dy = pPoints[i].y - pPoints[0].y;
+
+            if (dx * dx + dy * dy > nFarSq)
+            {
+                nFarSq = dx * dx + dy * dy;
+                nFar = i;
+            }
+        }
+        pKeep[0] = pKeep[nFar] = 1;
+        if (nFar > 0)
+        {
+            SimplifyChain(pPoints, nCount, 0, nFar, dEpsilon, pKeep, pStack);
+            SimplifyChain(pPoints, nCount, nFar, nCount, dEpsilon, pKeep, pStack);
+        }
+
+        // 남은 점을 앞으로 모음 (nOut <= nFirst + i 이므로 아직 읽지 않은 점을 덮어쓰지 않음)
+        pContour->nFirst = nOut;
+        for (int i = 0; i < nCount; i++)
+            if (pKeep[i])
+                pSet->pPoints[nOut++] = pPoints[i];
+        pContour->nCount = nOut - pContour->nFirst;
+    }
+    pSet->nPoints = nOut;
+
+    PoolFree(GetThreadPool(), pKeep);
+    PoolFree(GetThreadPool(), pStack);
+    return 0;
+}
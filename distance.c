@@ -0,0 +1,397 @@
+/*
+ * @Name : distance.c
+ * @Description : Image Processing in C - 이진 영상 거리 변환과 반지름 단위 침식, 팽창
+ * @Date : 2026. 10. 19
+ * @Revision : 1.0
+ * 1.0 : ImgDistanceTransform (유클리드 - Meijster 분리형, 챔퍼 - 2번 스캔), ImgErosionRadius, ImgDilationRadius
+ *
+ * Erosion, Dilation은 4주변 화소만 보므로 N픽셀을 줄이거나 늘리려면 영상 전체를 N번 처리해야 한다.
+ * 거리 변환을 한번 구하면 "가장 가까운 배경까지의 거리 > 반지름"인 픽셀만 남기는 것으로 어떤 반지름이든 한번에 처리된다.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <float.h>
+#include <math.h>
+#include "imgprocessing.h"
+#include "profile.h"
+
+#define DIST_COLUMN_BLOCK 512 // 유클리드 1단계에서 스레드 하나가 맡는 열 수 (행 방향으로 길게 연속해서 읽도록)
+
+/*
+ * @Function Name : IsFeature
+ * @Description : 거리를 잴 기준 픽셀인지 검사합니다.
+ * @Input : v - 픽셀 값, bToForeground - 1이면 전경(255)까지, 0이면 배경(255가 아닌 값)까지의 거리
+ * @Output : 1 (기준 픽셀) / 0
+ */
+static int IsFeature(BYTE v, int bToForeground)
+{
+    return (v == 255) == (bToForeground != 0);
+}
+
+/*
+ * @Function Name : LowerEnvelope
+ * @Description : 한 행의 nLo ~ nHi 위치 포물선 (x - i)^2 + g(i)^2 의 아래쪽 경계로 x0 <= x < x1의 거리를 구합니다.
+ * @Input : *pF - F(i) = g(i)^2 + i^2, nLo, nHi, x0, x1, nInfSq - 기준 픽셀이 없는 열의 g^2, *pS, *pT - 작업 버퍼
+ * @Output : pRow[x0 ~ x1 - 1] - 거리의 제곱 (기준 픽셀이 없으면 INT_MAX)
+ */
+// 김광제의 설명 - (x - i)^2 + g(i)^2 = x^2 - 2xi + F(i) 이라서 두 포물선의 비교, 교점 계산에 곱셈이 거의 없다. (Meijster 2단계)
+// s[q]는 경계를 이루는 포물선의 중심, t[q]는 그 포물선이 최소가 되기 시작하는 x
+static void LowerEnvelope(const long long *pF, int nLo, int nHi, int x0, int x1, long long nInfSq, int *pS, int *pT, int *pRow)
+{
+    int q = 0;
+
+    pS[0] = nLo;
+    pT[0] = nLo;
+    for (int u = nLo + 1; u <= nHi; u++)
+    {
+        // u의 포물선이 t[q]에서 더 낮으면 s[q]의 포물선은 경계에서 빠짐
+        while (q >= 0 && pF[pS[q]] - 2LL * pT[q] * pS[q] > pF[u] - 2LL * pT[q] * u)
+            q--;
+
+        if (q < 0)
+        {
+            q = 0;
+            pS[0] = u;
+            pT[0] = nLo;
+        }
+        else
+        {
+            // 두 포물선이 만나는 위치 (s[q]보다 u가 낮아지기 시작하는 x)
+            // 분자, 분모 모두 2^53보다 작은 정수라서 double 나눗셈의 내림이 정수 나눗셈과 같음 (64비트 정수 나눗셈보다 빠름)
+            double dSep = (double)(pF[u] - pF[pS[q]]) / (2.0 * (u - pS[q]));
+            long long w = (long long)dSep;
+
+            if ((double)w > dSep) // 음수는 0 쪽으로 버려지므로 내림이 되도록 보정
+                w--;
+            w++;
+
+            if (w <= nHi)
+            {
+                q++;
+                pS[q] = u;
+                pT[q] = (int)w;
+            }
+        }
+    }
+
+    for (int u = nHi; u >= nLo; u--)
+    {
+        int i = pS[q];
+        long long g2 = pF[i] - (long long)i * i, d = g2 + (long long)(u - i) * (u - i);
+
+        if (u >= x0 && u < x1)
+            pRow[u] = (g2 >= nInfSq || d > INT_MAX) ? INT_MAX : (int)d;
+        if (u == pT[q])
+            q--;
+    }
+}
+
+/*
+ * @Function Name : EuclideanDistance
+ * @Description : 모든 픽셀에서 가장 가까운 기준 픽셀까지의 유클리드 거리의 제곱을 구합니다. (Meijster 알고리즘)
+ * @Input : *pIn - 8비트 이진 영상 (ROI 가능), bToForeground
+ * @Output : *pMap - 거리의 제곱 (nWidth X nHeight, 기준 픽셀이 없으면 INT_MAX), 반환값 0 (성공) / -1 (메모리 할당 오류)
+ */
+// 김광제의 설명 - 2차원 거리 변환을 1차원 두번으로 나눈다.
+// 1. 열마다 위, 아래로 한번씩 훑어서 같은 열의 가장 가까운 기준 픽셀까지의 세로 거리 g를 구한다. (열끼리 독립 -> 병렬)
+// 2. 행마다 d(x) = min_i ((x - i)^2 + g(i)^2)를 구한다. 포물선 (x - i)^2 + g(i)^2 들의 아래쪽 경계만 남기면
+//    한 행을 두번 훑는 것으로 끝나서 전체가 픽셀 수에 비례하는 시간이 된다. (행끼리 독립 -> 병렬)
+// 모든 계산이 정수라서 결과는 모든 기준 픽셀과 직접 비교한 값과 정확히 같다.
+static int EuclideanDistance(const IMAGE *pIn, int bToForeground, int *pMap)
+{
+    int nWidth = pIn->nWidth, nHeight = pIn->nHeight;
+    int nInf = nWidth + nHeight; // 기준 픽셀이 없는 열의 세로 거리 (어떤 실제 거리보다 큼)
+    int nFailed = 0;
+
+    // 1. 열 방향 거리 (DIST_COLUMN_BLOCK 열씩 행 순서로 읽음)
+#pragma omp parallel for schedule(static)
+    for (int x0 = 0; x0 < nWidth; x0 += DIST_COLUMN_BLOCK)
+    {
+        int x1 = (x0 + DIST_COLUMN_BLOCK < nWidth) ? x0 + DIST_COLUMN_BLOCK : nWidth;
+
+        for (int y = 0; y < nHeight; y++)
+        {
+            const BYTE *pRow = pIn->pPlane[0] + (size_t)y * pIn->nStride;
+            int *pG = pMap + (size_t)y * nWidth;
+
+            for (int x = x0; x < x1; x++)
+                pG[x] = IsFeature(pRow[x], bToForeground) ? 0 : ((y > 0 && pG[x - nWidth] < nInf) ? pG[x - nWidth] + 1 : nInf);
+        }
+        for (int y = nHeight - 2; y >= 0; y--)
+        {
+            int *pG = pMap + (size_t)y * nWidth;
+
+            for (int x = x0; x < x1; x++)
+                if (pG[x + nWidth] + 1 < pG[x])
+                    pG[x] = pG[x + nWidth] + 1;
+        }
+    }
+
+    // 2. 행 방향 (포물선의 아래쪽 경계, 스레드마다 작업 버퍼)
+#pragma omp parallel reduction(+ : nFailed)
+    {
+        long long *pF = (long long *)malloc(sizeof(long long) * nWidth);
+        int *pS = (int *)malloc(sizeof(int) * nWidth * 2);
+        int *pT = (NULL == pS) ? NULL : pS + nWidth;
+
+        if (NULL == pF || NULL == pS)
+            nFailed++;
+
+#pragma omp for schedule(static)
+        for (int y = 0; y < nHeight; y++)
+        {
+            int *pRow = pMap + (size_t)y * nWidth;
+
+            if (NULL == pF || NULL == pS)
+                continue;
+
+            for (int u = 0; u < nWidth; u++)
+                pF[u] = (long long)pRow[u] * pRow[u] + (long long)u * u;
+
+            // 기준 픽셀(g = 0)의 포물선은 그 위치에서 0이라 양쪽을 가로막으므로 기준 픽셀 사이 구간마다 따로 처리한다.
+            // 기준 픽셀은 결과가 0 그대로이고, 이진 영상은 기준 픽셀이 길게 이어지므로 포물선 계산이 그만큼 줄어듦
+            for (int x0 = 0, x1; x0 < nWidth; x0 = x1)
+            {
+                if (pRow[x0] == 0)
+                {
+                    x1 = x0 + 1;
+                    continue;
+                }
+                for (x1 = x0 + 1; x1 < nWidth && pRow[x1] != 0; x1++)
+                    ;
+                LowerEnvelope(pF, (x0 > 0) ? x0 - 1 : 0, (x1 < nWidth) ? x1 : nWidth - 1, x0, x1, (long long)nInf * nInf, pS, pT, pRow);
+            }
+        }
+
+        free(pF);
+        free(pS);
+    }
+
+    return (nFailed == 0) ? 0 : (-1);
+}
+
+/*
+ * @Function Name : ChamferDistance
+ * @Description : 챔퍼 거리 (가로, 세로 한 칸 nOrtho, 대각선 한 칸 nDiag)를 2번 스캔으로 구합니다.
+ * @Input : *pIn - 8비트 이진 영상 (ROI 가능), bToForeground, nOrtho, nDiag
+ * @Output : *pMap - 거리 (nWidth X nHeight, 기준 픽셀이 없으면 INT_MAX)
+ */
+// 김광제의 설명 - 위에서 아래로 (왼쪽 위, 위, 오른쪽 위, 왼쪽), 아래에서 위로 (오른쪽, 왼쪽 아래, 아래, 오른쪽 아래) 이웃의 거리 + 가중치의 최소를 취한다.
+//   (1, 2) : 시가지 거리 |dx| + |dy| (4주변 Erosion을 N번 한 것과 같은 마름모)
+//   (1, 1) : 체스판 거리 max(|dx|, |dy|) (8주변 정사각형)
+//   (3, 4) : 유클리드 거리의 근사 (값 / 3, 오차 8% 이내)
+// 앞 행의 결과를 바로 사용하므로 병렬 처리는 하지 않음 (픽셀당 비교 8번)
+static void ChamferDistance(const IMAGE *pIn, int bToForeground, int nOrtho, int nDiag, int *pMap)
+{
+    int nWidth = pIn->nWidth, nHeight = pIn->nHeight;
+    int nInf = INT_MAX - 2 * nDiag; // 더해도 넘치지 않는 무한대
+
+    for (int y = 0; y < nHeight; y++)
+    {
+        const BYTE *pRow = pIn->pPlane[0] + (size_t)y * pIn->nStride;
+        int *pD = pMap + (size_t)y * nWidth, *pUp = pD - nWidth;
+
+        for (int x = 0; x < nWidth; x++)
+        {
+            int d = nInf;
+
+            if (IsFeature(pRow[x], bToForeground))
+                d = 0;
+            else
+            {
+                if (x > 0 && pD[x - 1] + nOrtho < d)
+                    d = pD[x - 1] + nOrtho;
+                if (y > 0)
+                {
+                    if (pUp[x] + nOrtho < d)
+                        d = pUp[x] + nOrtho;
+                    if (x > 0 && pUp[x - 1] + nDiag < d)
+                        d = pUp[x - 1] + nDiag;
+                    if (x < nWidth - 1 && pUp[x + 1] + nDiag < d)
+                        d = pUp[x + 1] + nDiag;
+                }
+            }
+            pD[x] = (d > nInf) ? nInf : d;
+        }
+    }
+
+    for (int y = nHeight - 1; y >= 0; y--)
+    {
+        int *pD = pMap + (size_t)y * nWidth, *pDown = pD + nWidth;
+
+        for (int x = nWidth - 1; x >= 0; x--)
+        {
+            int d = pD[x];
+
+            if (x < nWidth - 1 && pD[x + 1] + nOrtho < d)
+                d = pD[x + 1] + nOrtho;
+            if (y < nHeight - 1)
+            {
+                if (pDown[x] + nOrtho < d)
+                    d = pDown[x] + nOrtho;
+                if (x > 0 && pDown[x - 1] + nDiag < d)
+                    d = pDown[x - 1] + nDiag;
+                if (x < nWidth - 1 && pDown[x + 1] + nDiag < d)
+                    d = pDown[x + 1] + nDiag;
+            }
+            pD[x] = d;
+        }
+    }
+
+    for (size_t i = 0; i < (size_t)nWidth * nHeight; i++)
+        if (pMap[i] >= nInf)
+            pMap[i] = INT_MAX;
+}
+
+/*
+ * @Function Name : ComputeDistance
+ * @Description : nMetric(DIST_xxx) 거리 변환을 정수 거리 지도로 구합니다.
+ * @Input : *pIn, bToForeground, nMetric
+ * @Output : *pMap - 유클리드는 거리의 제곱, 챔퍼는 가중치 단위 거리 (기준 픽셀이 없으면 INT_MAX),
+ *           반환값 0 (성공) / -1 (입력 오류, 메모리 할당 오류)
+ */
+static int ComputeDistance(const IMAGE *pIn, int bToForeground, int nMetric, int *pMap)
+{
+    switch (nMetric)
+    {
+    case DIST_EUCLIDEAN:
+        return EuclideanDistance(pIn, bToForeground, pMap);
+    case DIST_CITYBLOCK:
+        ChamferDistance(pIn, bToForeground, 1, 2, pMap);
+        return 0;
+    case DIST_CHESSBOARD:
+        ChamferDistance(pIn, bToForeground, 1, 1, pMap);
+        return 0;
+    case DIST_CHAMFER_3_4:
+        ChamferDistance(pIn, bToForeground, 3, 4, pMap);
+        return 0;
+    default:
+        return (-1);
+    }
+}
+
+/*
+ * @Function Name : ImgDistanceTransform
+ * @Description : 8비트 이진 영상의 모든 픽셀에서 가장 가까운 배경(255가 아닌 값) 픽셀까지의 거리를 구합니다.
+ * @Input : *pIn - 8비트 이진 영상 (ROI 가능), nMetric - DIST_xxx
+ * @Output : *pDist - 거리 (픽셀 단위, nWidth X nHeight 연속 버퍼, 배경 픽셀은 0, 배경이 없으면 FLT_MAX),
+ *           반환값 0 (성공) / -1 (입력 오류, 메모리 할당 오류)
+ */
+// 김광제의 설명 - 전경은 Erosion, Dilation과 같이 255이다. 영상 밖은 배경으로 보지 않음 (가장자리에 닿은 객체는 가장자리 쪽으로 줄어들지 않음)
+int ImgDistanceTransform(const IMAGE *pIn, float *pDist, int nMetric)
+{
+    size_t nSize = (size_t)pIn->nWidth * pIn->nHeight;
+    int *pMap;
+    int nRet;
+    PROFILE_BEGIN(dStart);
+
+    if (pIn->nFormat != PIXEL_GRAY8 || NULL == pDist)
+        return (-1);
+
+    pMap = (int *)PoolAlloc(GetThreadPool(), nSize * sizeof(int), 0);
+    if (NULL == pMap)
+        return (-1);
+
+    nRet = ComputeDistance(pIn, 0, nMetric, pMap);
+    if (nRet == 0)
+    {
+        for (size_t i = 0; i < nSize; i++)
+        {
+            if (pMap[i] == INT_MAX)
+                pDist[i] = FLT_MAX;
+            else if (nMetric == DIST_EUCLIDEAN)
+                pDist[i] = (float)sqrt((double)pMap[i]);
+            else if (nMetric == DIST_CHAMFER_3_4)
+                pDist[i] = pMap[i] / 3.0f;
+            else
+                pDist[i] = (float)pMap[i];
+        }
+    }
+
+    PoolFree(GetThreadPool(), pMap);
+    PROFILE_END(dStart, "distance_transform", (long long)nSize, (long long)nSize * (1 + 2 * sizeof(int) + sizeof(float)));
+    return nRet;
+}
+
+/*
+ * @Function Name : MorphologyRadius
+ * @Description : 거리 변환 결과를 반지름으로 잘라서 침식, 팽창 결과를 만듭니다.
+ * @Input : *pIn, dRadius, nMetric, bDilation - 0 : 침식, 1 : 팽창
+ * @Output : *pOut, 반환값 0 (성공) / -1 (입력 오류, 메모리 할당 오류)
+ */
+// 김광제의 설명 - 침식 : 가장 가까운 배경까지의 거리 > 반지름인 전경만 남김, 팽창 : 가장 가까운 전경까지의 거리 <= 반지름이면 전경
+// 정수 거리 지도와 비교하도록 반지름을 같은 단위로 바꾼다. (유클리드는 제곱, 3-4 챔퍼는 X 3)
+static int MorphologyRadius(const IMAGE *pIn, IMAGE *pOut, double dRadius, int nMetric, int bDilation)
+{
+    int nWidth = pIn->nWidth, nHeight = pIn->nHeight;
+    double dLimit;
+    int nLimit, nRet;
+    int *pMap;
+
+    if (pIn->nFormat != PIXEL_GRAY8 || pOut->nFormat != PIXEL_GRAY8 || pOut->nWidth != nWidth || pOut->nHeight != nHeight || dRadius < 0.0)
+        return (-1);
+
+    dLimit = (nMetric == DIST_EUCLIDEAN) ? dRadius * dRadius : ((nMetric == DIST_CHAMFER_3_4) ? dRadius * 3.0 : dRadius);
+    nLimit = (dLimit >= INT_MAX - 1) ? INT_MAX - 1 : (int)floor(dLimit + 1e-9);
+
+    pMap = (int *)PoolAlloc(GetThreadPool(), (size_t)nWidth * nHeight * sizeof(int), 0);
+    if (NULL == pMap)
+        return (-1);
+
+    nRet = ComputeDistance(pIn, bDilation, nMetric, pMap);
+    if (nRet == 0)
+    {
+#pragma omp parallel for schedule(static)
+        for (int y = 0; y < nHeight; y++)
+        {
+            const int *pRow = pMap + (size_t)y * nWidth;
+            BYTE *pDst = pOut->pPlane[0] + (size_t)y * pOut->nStride;
+
+            for (int x = 0; x < nWidth; x++)
+                pDst[x] = ((pRow[x] <= nLimit) == (bDilation != 0)) ? 255 : 0;
+        }
+    }
+
+    PoolFree(GetThreadPool(), pMap);
+    return nRet;
+}
+
+/*
+ * @Function Name : ImgErosionRadius
+ * @Description : 8비트 이진 영상을 반지름 dRadius의 원(nMetric 거리)으로 침식합니다.
+ * @Input : *pIn - 8비트 이진 영상 (ROI 가능), dRadius (0 이상), nMetric - DIST_xxx
+ * @Output : *pOut (영상 전체를 씀), 반환값 0 (성공) / -1 (입력 오류, 메모리 할당 오류)
+ */
+// 김광제의 설명 - DIST_CITYBLOCK, 반지름 N은 Erosion을 N번 반복한 것과 같다. (영상 가장자리 제외)
+// 반지름과 관계없이 거리 변환 한번 + 비교 한번이므로 반지름 20 침식도 한번의 처리로 끝남
+int ImgErosionRadius(const IMAGE *pIn, IMAGE *pOut, double dRadius, int nMetric)
+{
+    int nRet;
+    PROFILE_BEGIN(dStart);
+
+    nRet = MorphologyRadius(pIn, pOut, dRadius, nMetric, 0);
+
+    PROFILE_END(dStart, "erosion_radius", (long long)pIn->nWidth * pIn->nHeight, (long long)pIn->nWidth * pIn->nHeight * (2 + 2 * sizeof(int)));
+    return nRet;
+}
+
+/*
+ * @Function Name : ImgDilationRadius
+ * @Description : 8비트 이진 영상을 반지름 dRadius의 원(nMetric 거리)으로 팽창합니다.
+ * @Input : *pIn - 8비트 이진 영상 (ROI 가능), dRadius (0 이상), nMetric - DIST_xxx
+ * @Output : *pOut (영상 전체를 씀), 반환값 0 (성공) / -1 (입력 오류, 메모리 할당 오류)
+ */
+// 김광제의 설명 - DIST_CITYBLOCK, 반지름 N은 Dilation을 N번 반복한 것과 같다. (영상 가장자리 제외)
+int ImgDilationRadius(const IMAGE *pIn, IMAGE *pOut, double dRadius, int nMetric)
+{
+    int nRet;
+    PROFILE_BEGIN(dStart);
+
+    nRet = MorphologyRadius(pIn, pOut, dRadius, nMetric, 1);
+
+    PROFILE_END(dStart, "dilation_radius", (long long)pIn->nWidth * pIn->nHeight, (long long)pIn->nWidth * pIn->nHeight * (2 + 2 * sizeof(int)));
+    return nRet;
+}
@@ -0,0 +1,803 @@
+/*
+ * @Name : fft.c
+ * @Description : Image Processing in C - 2차원 실수 FFT, 큰 커널 컨볼루션 (직접 / FFT 자동 선택), 주파수 영역 필터
+ * @Date : 2026. 10. 19
+ * @Revision : 1.0
+ * 1.0 : 혼합 기수(2, 3, 4, 5) Stockham FFT, 실수 -> 복소수 2차원 변환 (행 병렬, 열은 블록으로 모아서 병렬),
+ *       FFT_FILTER (커널 / 전달 함수 스펙트럼을 한번 만들어서 여러 프레임에 재사용), ImgConvolutionLarge, ImgFrequencyFilter
+ *
+ * convolution.h의 3x3 커널은 픽셀마다 9번 곱하지만 51x51 PSF 커널은 픽셀마다 2601번 곱해야 한다.
+ * FFT로 바꾸면 커널 크기와 상관없이 픽셀마다 log(영상 크기)에 비례하는 비용으로 컨볼루션할 수 있다.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "imgprocessing.h"
+#include "profile.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define FFT_COLUMN_BLOCK 8     // 열 변환에서 한번에 모으는 열 수 (복소수 8개 = 128바이트, 캐시 라인 2개)
+#define FFT_COST_PER_POINT 5.0 // 변환 크기 N에서 FFT 한번의 비용 = N log2(N) X 이 값 (직접 컨볼루션 곱셈 한번 기준, benchmark로 정함)
+#define FFT_FREQ_MARGIN 16     // 주파수 영역 필터의 최소 여백 (영상 크기의 1/8과 큰 값, 순환 컨볼루션이 반대쪽 가장자리를 섞지 않도록)
+
+/*
+ * @Function Name : IsSmoothSize
+ * @Description : n이 2^a 3^b 5^c 꼴인지 검사합니다.
+ * @Output : 1 (맞음) / 0 (아님)
+ */
+static int IsSmoothSize(int n)
+{
+    if (n < 1)
+        return 0;
+    while (n % 2 == 0)
+        n /= 2;
+    while (n % 3 == 0)
+        n /= 3;
+    while (n % 5 == 0)
+        n /= 5;
+    return (n == 1);
+}
+
+/*
+ * @Function Name : FftGoodSize
+ * @Description : n 이상이면서 2^a 3^b 5^c (a >= 1) 꼴인 가장 작은 짝수를 구합니다. (FftInit이 받는 크기)
+ * @Input : n (1 이상)
+ * @Output : 반환값 FFT 크기 / -1 (입력 오류)
+ */
+int FftGoodSize(int n)
+{
+    if (n < 1 || n > (1 << 29))
+        return (-1);
+
+    for (int m = (n + 1) & ~1;; m += 2)
+        if (IsSmoothSize(m))
+            return m;
+}
+
+/*
+ * @Function Name : Fft1DInit
+ * @Description : 길이 n 복소수 FFT의 기수 순서와 회전 인자를 만듭니다.
+ * @Input : *p, n - 2^a 3^b 5^c
+ * @Output : *p, 반환값 0 (성공) / -1 (지원하지 않는 길이, 메모리 할당 오류)
+ */
+// 김광제의 설명 - 4를 먼저 쓰고 남은 2, 3, 5를 쓴다. 회전 인자는 단계마다 (이전 단계까지의 크기 Ns) X (기수 - 1)개
+static int Fft1DInit(FFT_1D *p, int n)
+{
+    int m = n, nTwiddles = 0, nNs = 1, nOffset = 0;
+
+    memset(p, 0, sizeof(FFT_1D));
+    p->n = n;
+    while (m > 1)
+    {
+        int R = (m % 4 == 0) ? 4 : ((m % 2 == 0) ? 2 : ((m % 3 == 0) ? 3 : ((m % 5 == 0) ? 5 : 0)));
+
+        if (R == 0 || p->nStages == FFT_MAX_STAGES)
+            return (-1);
+        p->Radix[p->nStages++] = R;
+        nTwiddles += nNs * (R - 1);
+        nNs *= R;
+        m /= R;
+    }
+
+    p->pTwiddle = (FFT_COMPLEX *)malloc(sizeof(FFT_COMPLEX) * (nTwiddles + 1));
+    if (NULL == p->pTwiddle)
+        return (-1);
+
+    nNs = 1;
+    for (int s = 0; s < p->nStages; s++)
+    {
+        int R = p->Radix[s];
+
+        for (int k = 0; k < nNs; k++)
+            for (int r = 1; r < R; r++)
+            {
+                double dAngle = -2.0 * M_PI * k * r / ((double)nNs * R);
+
+                p->pTwiddle[nOffset + k * (R - 1) + r - 1].re = cos(dAngle);
+                p->pTwiddle[nOffset + k * (R - 1) + r - 1].im = sin(dAngle);
+            }
+        nOffset += nNs * (R - 1);
+        nNs *= R;
+    }
+    return 0;
+}
+
+/*
+ * @Function Name : Fft1D
+ * @Description : 길이 n 복소수 순방향 FFT (정규화하지 않음)
+ * @Input : *p, *pData - n개, *pWork - n개 작업 버퍼
+ * @Output : *pData
+ */
+// 김광제의 설명 - Stockham 방식 (단계마다 두 버퍼를 번갈아 쓰면서 자리를 옮겨서 비트 반전 정렬이 필요 없음)
+// j번째 나비 연산 : 입력 j + r n / R (r = 0 ~ R - 1)에 회전 인자를 곱하고 길이 R DFT,
+// 출력 위치 = (j / Ns) Ns R + (j % Ns) + r Ns
+static void Fft1D(const FFT_1D *p, FFT_COMPLEX *pData, FFT_COMPLEX *pWork)
+{
+    const double C3 = -0.5, S3 = 0.86602540378443864676;                                         // cos, sin(2π / 3)
+    const double C51 = 0.30901699437494742410, C52 = -0.80901699437494742410;                     // cos(2π / 5), cos(4π / 5)
+    const double S51 = 0.95105651629515357212, S52 = 0.58778525229247312917;                      // sin(2π / 5), sin(4π / 5)
+    FFT_COMPLEX *pSrc = pData, *pDst = pWork;
+    const FFT_COMPLEX *pTw = p->pTwiddle;
+    int n = p->n, nNs = 1;
+
+    for (int s = 0; s < p->nStages; s++)
+    {
+        int R = p->Radix[s], nStep = n / R;
+
+        for (int j = 0; j < nStep; j++)
+        {
+            int k = j % nNs;
+            const FFT_COMPLEX *pW = pTw + k * (R - 1);
+            FFT_COMPLEX v[5], *pOut = pDst + (j - k) * R + k;
+
+            v[0] = pSrc[j];
+            for (int r = 1; r < R; r++)
+            {
+                FFT_COMPLEX a = pSrc[j + r * nStep];
+
+                v[r].re = a.re * pW[r - 1].re - a.im * pW[r - 1].im;
+                v[r].im = a.re * pW[r - 1].im + a.im * pW[r - 1].re;
+            }
+
+            if (R == 4)
+            {
+                double t0r = v[0].re + v[2].re, t0i = v[0].im + v[2].im, t1r = v[0].re - v[2].re, t1i = v[0].im - v[2].im;
+                double t2r = v[1].re + v[3].re, t2i = v[1].im + v[3].im, t3r = v[1].im - v[3].im, t3i = v[3].re - v[1].re; // t3 = (v1 - v3) X (-i)
+
+                pOut[0].re = t0r + t2r, pOut[0].im = t0i + t2i;
+                pOut[nNs].re = t1r + t3r, pOut[nNs].im = t1i + t3i;
+                pOut[2 * nNs].re = t0r - t2r, pOut[2 * nNs].im = t0i - t2i;
+                pOut[3 * nNs].re = t1r - t3r, pOut[3 * nNs].im = t1i - t3i;
+            }
+            else if (R == 2)
+            {
+                pOut[0].re = v[0].re + v[1].re, pOut[0].im = v[0].im + v[1].im;
+                pOut[nNs].re = v[0].re - v[1].re, pOut[nNs].im = v[0].im - v[1].im;
+            }
+            else if (R == 3)
+            {
+                double t1r = v[1].re + v[2].re, t1i = v[1].im + v[2].im, t2r = v[1].re - v[2].re, t2i = v[1].im - v[2].im;
+                double mr = v[0].re + C3 * t1r, mi = v[0].im + C3 * t1i, nr = S3 * t2i, ni = -S3 * t2r; // n = -i sin X t2
+
+                pOut[0].re = v[0].re + t1r, pOut[0].im = v[0].im + t1i;
+                pOut[nNs].re = mr + nr, pOut[nNs].im = mi + ni;
+                pOut[2 * nNs].re = mr - nr, pOut[2 * nNs].im = mi - ni;
+            }
+            else // R == 5
+            {
+                double t1r = v[1].re + v[4].re, t1i = v[1].im + v[4].im, t2r = v[2].re + v[3].re, t2i = v[2].im + v[3].im;
+                double t3r = v[1].re - v[4].re, t3i = v[1].im - v[4].im, t4r = v[2].re - v[3].re, t4i = v[2].im - v[3].im;
+                double a1r = v[0].re + C51 * t1r + C52 * t2r, a1i = v[0].im + C51 * t1i + C52 * t2i;
+                double a2r = v[0].re + C52 * t1r + C51 * t2r, a2i = v[0].im + C52 * t1i + C51 * t2i;
+                double b1r = S51 * t3i + S52 * t4i, b1i = -(S51 * t3r + S52 * t4r); // b1 = -i (s1 t3 + s2 t4)
+                double b2r = S52 * t3i - S51 * t4i, b2i = -(S52 * t3r - S51 * t4r); // b2 = -i (s2 t3 - s1 t4)
+
+                pOut[0].re = v[0].re + t1r + t2r, pOut[0].im = v[0].im + t1i + t2i;
+                pOut[nNs].re = a1r + b1r, pOut[nNs].im = a1i + b1i;
+                pOut[2 * nNs].re = a2r + b2r, pOut[2 * nNs].im = a2i + b2i;
+                pOut[3 * nNs].re = a2r - b2r, pOut[3 * nNs].im = a2i - b2i;
+                pOut[4 * nNs].re = a1r - b1r, pOut[4 * nNs].im = a1i - b1i;
+            }
+        }
+
+        pTw += nNs * (R - 1);
+        nNs *= R;
+        pSrc = pDst;
+        pDst = (pDst == pWork) ? pData : pWork;
+    }
+
+    if (pSrc != pData)
+        memcpy(pData, pSrc, sizeof(FFT_COMPLEX) * n);
+}
+
+/*
+ * @Function Name : Fft1DInverse
+ * @Description : 길이 n 복소수 역방향 FFT (정규화하지 않음, 켤레 -> 순방향 -> 켤레)
+ * @Input : *p, *pData, *pWork
+ * @Output : *pData
+ */
+static void Fft1DInverse(const FFT_1D *p, FFT_COMPLEX *pData, FFT_COMPLEX *pWork)
+{
+    for (int i = 0; i < p->n; i++)
+        pData[i].im = -pData[i].im;
+    Fft1D(p, pData, pWork);
+    for (int i = 0; i < p->n; i++)
+        pData[i].im = -pData[i].im;
+}
+
+/*
+ * @Function Name : FftInit
+ * @Description : nWidth X nHeight 실수 2차원 FFT 계획(회전 인자)을 만듭니다.
+ * @Input : *pPlan, nWidth - 2^a 3^b 5^c 꼴 짝수 (FftGoodSize), nHeight - 2^a 3^b 5^c
+ * @Output : *pPlan, 반환값 0 (성공) / -1 (지원하지 않는 크기, 메모리 할당 오류)
+ */
+// 김광제의 설명 - 실수 행 N개는 짝수, 홀수 번째를 실수부, 허수부로 묶은 N / 2 길이 복소수 FFT 한번으로 변환한다.
+// 스펙트럼은 켤레 대칭이라서 행마다 N / 2 + 1개만 저장 (nSpecWidth)
+int FftInit(FFT_PLAN *pPlan, int nWidth, int nHeight)
+{
+    memset(pPlan, 0, sizeof(FFT_PLAN));
+    if (nWidth < 2 || nHeight < 2 || (nWidth & 1) || !IsSmoothSize(nWidth) || !IsSmoothSize(nHeight))
+        return (-1);
+
+    pPlan->nWidth = nWidth;
+    pPlan->nHeight = nHeight;
+    pPlan->nSpecWidth = nWidth / 2 + 1;
+    pPlan->pHalf = (FFT_COMPLEX *)malloc(sizeof(FFT_COMPLEX) * pPlan->nSpecWidth);
+    if (NULL == pPlan->pHalf || Fft1DInit(&pPlan->Row, nWidth / 2) < 0 || Fft1DInit(&pPlan->Col, nHeight) < 0)
+    {
+        FftRelease(pPlan);
+        return (-1);
+    }
+
+    for (int k = 0; k < pPlan->nSpecWidth; k++)
+    {
+        pPlan->pHalf[k].re = cos(-2.0 * M_PI * k / nWidth);
+        pPlan->pHalf[k].im = sin(-2.0 * M_PI * k / nWidth);
+    }
+    return 0;
+}
+
+/*
+ * @Function Name : FftRelease
+ * @Description : FFT 계획의 메모리를 해제합니다.
+ * @Input : *pPlan
+ */
+void FftRelease(FFT_PLAN *pPlan)
+{
+    free(pPlan->pHalf);
+    free(pPlan->Row.pTwiddle);
+    free(pPlan->Col.pTwiddle);
+    memset(pPlan, 0, sizeof(FFT_PLAN));
+}
+
+/*
+ * @Function Name : RealRowForward
+ * @Description : 실수 행 nWidth개를 스펙트럼 nWidth / 2 + 1개로 변환합니다.
+ * @Input : *pPlan, *pRow, *pWork - nWidth / 2개
+ * @Output : *pSpec
+ */
+// 김광제의 설명 - z = 짝수 + i 홀수의 FFT Z에서 E[k] = (Z[k] + conj(Z[h - k])) / 2, O[k] = (Z[k] - conj(Z[h - k])) / 2i,
+// X[k] = E[k] + W^k O[k], X[h - k] = conj(E[k] - W^k O[k]) (h = nWidth / 2, W = exp(-2πi / nWidth))
+static void RealRowForward(const FFT_PLAN *pPlan, const double *pRow, FFT_COMPLEX *pSpec, FFT_COMPLEX *pWork)
+{
+    int h = pPlan->nWidth / 2;
+    double z0r, z0i;
+
+    for (int k = 0; k < h; k++)
+    {
+        pSpec[k].re = pRow[2 * k];
+        pSpec[k].im = pRow[2 * k + 1];
+    }
+    Fft1D(&pPlan->Row, pSpec, pWork);
+
+    z0r = pSpec[0].re;
+    z0i = pSpec[0].im;
+    pSpec[0].re = z0r + z0i, pSpec[0].im = 0.0;
+    pSpec[h].re = z0r - z0i, pSpec[h].im = 0.0;
+
+    for (int k = 1; k <= h / 2; k++)
+    {
+        FFT_COMPLEX A = pSpec[k], B = pSpec[h - k], W = pPlan->pHalf[k];
+        double er = 0.5 * (A.re + B.re), ei = 0.5 * (A.im - B.im); // E = (A + conj(B)) / 2
+        double or_ = 0.5 * (A.im + B.im), oi = -0.5 * (A.re - B.re); // O = (A - conj(B)) / 2i
+        double tr = W.re * or_ - W.im * oi, ti = W.re * oi + W.im * or_;
+
+        pSpec[k].re = er + tr, pSpec[k].im = ei + ti;
+        pSpec[h - k].re = er - tr, pSpec[h - k].im = -(ei - ti);
+    }
+}
+
+/*
+ * @Function Name : RealRowInverse
+ * @Description : 스펙트럼 nWidth / 2 + 1개를 실수 행 nWidth개로 되돌립니다. (결과는 nWidth배, dScale을 곱해서 저장)
+ * @Input : *pPlan, *pSpec (바뀜), dScale, *pWork - nWidth / 2개
+ * @Output : *pRow
+ */
+// 김광제의 설명 - RealRowForward의 반대 : Z[k] = E[k] + i O[k], E = X[k] + conj(X[h - k]), O = (X[k] - conj(X[h - k])) conj(W^k)
+// (2로 나누지 않아서 길이 h 역변환 결과가 2h = nWidth배)
+static void RealRowInverse(const FFT_PLAN *pPlan, FFT_COMPLEX *pSpec, double *pRow, double dScale, FFT_COMPLEX *pWork)
+{
+    int h = pPlan->nWidth / 2;
+
+    for (int k = 0; k <= h / 2; k++)
+    {
+        FFT_COMPLEX A = pSpec[k], B = pSpec[h - k], W = pPlan->pHalf[k];
+        double er = A.re + B.re, ei = A.im - B.im;             // E = A + conj(B)
+        double dr = A.re - B.re, di = A.im + B.im;             // A - conj(B)
+        double or_ = dr * W.re + di * W.im, oi = di * W.re - dr * W.im; // O = (A - conj(B)) conj(W)
+
+        // Z[k] = E + i O, Z[h - k] = conj(E) + i conj(O)
+        pSpec[k].re = er - oi, pSpec[k].im = ei + or_;
+        if (k > 0)
+        {
+            pSpec[h - k].re = er + oi;
+            pSpec[h - k].im = -ei + or_;
+        }
+    }
+    Fft1DInverse(&pPlan->Row, pSpec, pWork);
+
+    for (int k = 0; k < h; k++)
+    {
+        pRow[2 * k] = pSpec[k].re * dScale;
+        pRow[2 * k + 1] = pSpec[k].im * dScale;
+    }
+}
+
+/*
+ * @Function Name : ColumnPass
+ * @Description : 스펙트럼의 모든 열을 복소수 FFT합니다.
+ * @Input : *pPlan, *pSpec - nHeight X nSpecWidth, bInverse
+ * @Output : *pSpec, 반환값 0 (성공) / -1 (메모리 할당 오류)
+ */
+// 김광제의 설명 - 열을 하나씩 읽으면 행 간격만큼 떨어진 값을 읽어서 캐시 라인마다 16바이트만 쓴다.
+// 이웃한 열 FFT_COLUMN_BLOCK개를 행마다 한번에 모아 연속 버퍼로 옮긴 다음 변환하고 다시 돌려놓음 (블록끼리 병렬)
+static int ColumnPass(const FFT_PLAN *pPlan, FFT_COMPLEX *pSpec, int bInverse)
+{
+    int nHeight = pPlan->nHeight, nSpecWidth = pPlan->nSpecWidth;
+    int nBlocks = (nSpecWidth + FFT_COLUMN_BLOCK - 1) / FFT_COLUMN_BLOCK, nFailed = 0;
+
+#pragma omp parallel reduction(+ : nFailed)
+    {
+        FFT_COMPLEX *pBlock = (FFT_COMPLEX *)malloc(sizeof(FFT_COMPLEX) * nHeight * (FFT_COLUMN_BLOCK + 1));
+
+        if (NULL == pBlock)
+            nFailed++;
+
+#pragma omp for schedule(static)
+        for (int b = 0; b < nBlocks; b++)
+        {
+            int x0 = b * FFT_COLUMN_BLOCK, nCols = (x0 + FFT_COLUMN_BLOCK < nSpecWidth) ? FFT_COLUMN_BLOCK : nSpecWidth - x0;
+            FFT_COMPLEX *pWork = pBlock + (size_t)nHeight * FFT_COLUMN_BLOCK;
+
+            if (NULL == pBlock)
+                continue;
+
+            for (int y = 0; y < nHeight; y++)
+                for (int c = 0; c < nCols; c++)
+                    pBlock[c * nHeight + y] = pSpec[(size_t)y * nSpecWidth + x0 + c];
+            for (int c = 0; c < nCols; c++)
+            {
+                if (bInverse)
+                    Fft1DInverse(&pPlan->Col, pBlock + c * nHeight, pWork);
+                else
+                    Fft1D(&pPlan->Col, pBlock + c * nHeight, pWork);
+            }
+            for (int y = 0; y < nHeight; y++)
+                for (int c = 0; c < nCols; c++)
+                    pSpec[(size_t)y * nSpecWidth + x0 + c] = pBlock[c * nHeight + y];
+        }
+        free(pBlock);
+    }
+    return (nFailed == 0) ? 0 : (-1);
+}
+
+/*
+ * @Function Name : FftForward2D
+ * @Description : 실수 영상을 2차원 FFT합니다. (정규화하지 않음)
+ * @Input : *pPlan, *pIn - nWidth X nHeight double 연속 버퍼
+ * @Output : *pSpec - nHeight X nSpecWidth 복소수 (u = 0 ~ nWidth / 2, v = 0 ~ nHeight - 1), 반환값 0 (성공) / -1 (메모리 할당 오류)
+ */
+int FftForward2D(const FFT_PLAN *pPlan, const double *pIn, FFT_COMPLEX *pSpec)
+{
+    int nWidth = pPlan->nWidth, nHeight = pPlan->nHeight, nFailed = 0;
+    PROFILE_BEGIN(dStart);
+
+    if (NULL == pPlan->pHalf)
+        return (-1);
+
+#pragma omp parallel reduction(+ : nFailed)
+    {
+        FFT_COMPLEX *pWork = (FFT_COMPLEX *)malloc(sizeof(FFT_COMPLEX) * (nWidth / 2));
+
+        if (NULL == pWork)
+            nFailed++;
+
+#pragma omp for schedule(static)
+        for (int y = 0; y < nHeight; y++)
+            if (NULL != pWork)
+                RealRowForward(pPlan, pIn + (size_t)y * nWidth, pSpec + (size_t)y * pPlan->nSpecWidth, pWork);
+        free(pWork);
+    }
+    if (nFailed > 0 || ColumnPass(pPlan, pSpec, 0) < 0)
+        return (-1);
+
+    PROFILE_END(dStart, "fft_forward", (long long)nWidth * nHeight, (long long)nWidth * nHeight * (sizeof(double) + 2 * sizeof(FFT_COMPLEX)));
+    return 0;
+}
+
+/*
+ * @Function Name : FftInverse2D
+ * @Description : 스펙트럼을 실수 영상으로 되돌립니다. (1 / (nWidth nHeight)로 정규화, FftForward2D의 역변환)
+ * @Input : *pPlan, *pSpec - nHeight X nSpecWidth (바뀜)
+ * @Output : *pOut - nWidth X nHeight double 연속 버퍼, 반환값 0 (성공) / -1 (메모리 할당 오류)
+ */
+int FftInverse2D(const FFT_PLAN *pPlan, FFT_COMPLEX *pSpec, double *pOut)
+{
+    int nWidth = pPlan->nWidth, nHeight = pPlan->nHeight, nFailed = 0;
+    double dScale = 1.0 / ((double)nWidth * nHeight);
+    PROFILE_BEGIN(dStart);
+
+    if (NULL == pPlan->pHalf || ColumnPass(pPlan, pSpec, 1) < 0)
+        return (-1);
+
+#pragma omp parallel reduction(+ : nFailed)
+    {
+        FFT_COMPLEX *pWork = (FFT_COMPLEX *)malloc(sizeof(FFT_COMPLEX) * (nWidth / 2));
+
+        if (NULL == pWork)
+            nFailed++;
+
+#pragma omp for schedule(static)
+        for (int y = 0; y < nHeight; y++)
+            if (NULL != pWork)
+                RealRowInverse(pPlan, pSpec + (size_t)y * pPlan->nSpecWidth, pOut + (size_t)y * nWidth, dScale, pWork);
+        free(pWork);
+    }
+
+    PROFILE_END(dStart, "fft_inverse", (long long)nWidth * nHeight, (long long)nWidth * nHeight * (sizeof(double) + 2 * sizeof(FFT_COMPLEX)));
+    return (nFailed == 0) ? 0 : (-1);
+}
+
+/*
+ * @Function Name : LoadPadded
+ * @Description : 그레이 영상(8, 16비트)을 (nOffsetX, nOffsetY) 위치에 놓고 나머지는 가장 가까운 가장자리 픽셀로 채운 double 버퍼를 만듭니다.
+ * @Input : *pIn, nPadWidth, nPadHeight, nOffsetX, nOffsetY
+ * @Output : *pPad - nPadWidth X nPadHeight
+ */
+static void LoadPadded(const IMAGE *pIn, double *pPad, int nPadWidth, int nPadHeight, int nOffsetX, int nOffsetY)
+{
+    int nWidth = pIn->nWidth, nHeight = pIn->nHeight;
+
+#pragma omp parallel for schedule(static)
+    for (int v = 0; v < nPadHeight; v++)
+    {
+        int y = (v < nOffsetY) ? 0 : ((v - nOffsetY >= nHeight) ? nHeight - 1 : v - nOffsetY);
+        const BYTE *pSrc = pIn->pPlane[0] + (size_t)y * pIn->nStride;
+        double *pDst = pPad + (size_t)v * nPadWidth;
+        int x1 = (nOffsetX + nWidth < nPadWidth) ? nOffsetX + nWidth : nPadWidth;
+
+        if (pIn->nFormat == PIXEL_GRAY16)
+            for (int u = nOffsetX; u < x1; u++)
+                pDst[u] = ((const WORD *)pSrc)[u - nOffsetX];
+        else
+            for (int u = nOffsetX; u < x1; u++)
+                pDst[u] = pSrc[u - nOffsetX];
+        for (int u = 0; u < nOffsetX; u++)
+            pDst[u] = pDst[nOffsetX];
+        for (int u = x1; u < nPadWidth; u++)
+            pDst[u] = pDst[x1 - 1];
+    }
+}
+
+/*
+ * @Function Name : StoreRow
+ * @Description : double 결과 한 행을 그레이 영상(8, 16비트) 행에 저장합니다. (반올림, 0 ~ 최대값으로 클리핑)
+ * @Input : *pRow, nWidth, nFormat, nPost - CONV_POST_ABS면 절대값
+ * @Output : *pDst
+ */
+static void StoreRow(const double *pRow, BYTE *pDst, int nWidth, int nFormat, int nPost)
+{
+    double dMax = (nFormat == PIXEL_GRAY16) ? 65535.0 : 255.0;
+
+    for (int x = 0; x < nWidth; x++)
+    {
+        double d = (nPost == CONV_POST_ABS) ? fabs(pRow[x]) : pRow[x];
+
+        d = (d < 0.0) ? 0.0 : ((d > dMax) ? dMax : floor(d + 0.5));
+        if (nFormat == PIXEL_GRAY16)
+            ((WORD *)pDst)[x] = (WORD)d;
+        else
+            pDst[x] = (BYTE)d;
+    }
+}
+
+/*
+ * @Function Name : FilterInit
+ * @Description : FFT 필터의 크기, 여백, 계획, 전달 함수 버퍼를 준비합니다.
+ * @Output : 반환값 0 (성공) / -1 (메모리 할당 오류)
+ */
+static int FilterInit(FFT_FILTER *pFilter, int nWidth, int nHeight, int nMarginX, int nMarginY, int nPost)
+{
+    memset(pFilter, 0, sizeof(FFT_FILTER));
+    pFilter->nWidth = nWidth;
+    pFilter->nHeight = nHeight;
+    pFilter->nOffsetX = nMarginX;
+    pFilter->nOffsetY = nMarginY;
+    pFilter->nPost = nPost;
+    if (FftInit(&pFilter->Plan, FftGoodSize(nWidth + 2 * nMarginX), FftGoodSize(nHeight + 2 * nMarginY)) < 0)
+        return (-1);
+    pFilter->pTransfer = (FFT_COMPLEX *)malloc(sizeof(FFT_COMPLEX) * pFilter->Plan.nHeight * pFilter->Plan.nSpecWidth);
+    if (NULL == pFilter->pTransfer)
+    {
+        FftRelease(&pFilter->Plan);
+        return (-1);
+    }
+    return 0;
+}
+
+/*
+ * @Function Name : FftFilterKernel
+ * @Description : nWidth X nHeight 영상에 nKernelWidth X nKernelHeight 커널을 적용하는 FFT 필터를 만듭니다. (커널 스펙트럼을 한번만 계산)
+ * @Input : *pFilter, nWidth, nHeight - 처리할 영상 크기,
+ *          *pKernel - nKernelWidth X nKernelHeight (홀수) 연속 버퍼 (ImgConvolutionKernel과 같이 가운데를 기준으로 영상에 겹쳐서 곱함),
+ *          nPost - CONV_POST_ABS면 절대값, 나머지는 0 ~ 최대값으로 클리핑
+ * @Output : *pFilter, 반환값 0 (성공) / -1 (입력 오류, 메모리 할당 오류)
+ */
+// 김광제의 설명 - 영상을 커널 반지름만큼 가장자리 픽셀로 늘려서 놓으면 순환 컨볼루션이 반대쪽 가장자리를 섞지 않는다.
+// 커널은 K[j][i]를 (rx - i, ry - j) (음수는 반대쪽으로 돌아감) 위치에 놓아서 결과 (x, y)가 영상 (x + i - rx, y + j - ry)와 곱해지도록 함
+int FftFilterKernel(FFT_FILTER *pFilter, int nWidth, int nHeight, const double *pKernel, int nKernelWidth, int nKernelHeight, int nPost)
+{
+    int rx = nKernelWidth / 2, ry = nKernelHeight / 2, nPadWidth, nPadHeight;
+    double *pPad;
+
+    if (nWidth < 1 || nHeight < 1 || NULL == pKernel || nKernelWidth < 1 || nKernelHeight < 1 || !(nKernelWidth & 1) || !(nKernelHeight & 1) ||
+        FilterInit(pFilter, nWidth, nHeight, rx, ry, nPost) < 0)
+        return (-1);
+
+    nPadWidth = pFilter->Plan.nWidth;
+    nPadHeight = pFilter->Plan.nHeight;
+    pPad = (double *)PoolAlloc(GetThreadPool(), sizeof(double) * nPadWidth * nPadHeight, 1);
+    if (NULL == pPad)
+    {
+        FftFilterRelease(pFilter);
+        return (-1);
+    }
+
+    for (int j = 0; j < nKernelHeight; j++)
+        for (int i = 0; i < nKernelWidth; i++)
+            pPad[(size_t)((ry - j + nPadHeight) % nPadHeight) * nPadWidth + (rx - i + nPadWidth) % nPadWidth] = pKernel[j * nKernelWidth + i];
+
+    if (FftForward2D(&pFilter->Plan, pPad, pFilter->pTransfer) < 0)
+    {
+        PoolFree(GetThreadPool(), pPad);
+        FftFilterRelease(pFilter);
+        return (-1);
+    }
+    PoolFree(GetThreadPool(), pPad);
+    return 0;
+}
+
+/*
+ * @Function Name : FftFilterFrequency
+ * @Description : nWidth X nHeight 영상에 이상적 / 버터워스 저역, 고역 통과 필터를 적용하는 FFT 필터를 만듭니다.
+ * @Input : *pFilter, nWidth, nHeight,
+ *          nType - FREQ_xxx,
+ *          dCutoff - 차단 주파수 (픽셀당 주기, 0 초과 0.5 이하),
+ *          nOrder - 버터워스 차수 (1 이상)
+ * @Output : *pFilter, 반환값 0 (성공) / -1 (입력 오류, 메모리 할당 오류)
+ */
+// 김광제의 설명 - 주파수 D = sqrt((u / W)^2 + (v / H)^2) (FFT 크기 W, H에 대한 픽셀당 주기)라서 영상 크기가 달라도 같은 차단 주파수를 쓸 수 있다.
+// 버터워스 저역 = 1 / (1 + (D / D0)^2n), 고역 = 1 - 저역, 전달 함수가 실수라서 위상은 바뀌지 않음 (영상이 밀리지 않음)
+// 이상적 필터는 링잉이 넓게 퍼져서 여백을 영상 크기의 1/8 (최소 FFT_FREQ_MARGIN)로 둔다.
+int FftFilterFrequency(FFT_FILTER *pFilter, int nWidth, int nHeight, int nType, double dCutoff, int nOrder)
+{
+    int nMarginX = (nWidth / 8 > FFT_FREQ_MARGIN) ? nWidth / 8 : FFT_FREQ_MARGIN;
+    int nMarginY = (nHeight / 8 > FFT_FREQ_MARGIN) ? nHeight / 8 : FFT_FREQ_MARGIN;
+    int nPadWidth, nPadHeight, nSpecWidth;
+
+    if (nWidth < 1 || nHeight < 1 || nType < FREQ_IDEAL_LOWPASS || nType > FREQ_BUTTERWORTH_HIGHPASS || !(dCutoff > 0.0) || dCutoff > 0.5 ||
+        nOrder < 1 || FilterInit(pFilter, nWidth, nHeight, nMarginX, nMarginY, CONV_POST_CLIP) < 0)
+        return (-1);
+
+    nPadWidth = pFilter->Plan.nWidth;
+    nPadHeight = pFilter->Plan.nHeight;
+    nSpecWidth = pFilter->Plan.nSpecWidth;
+
+#pragma omp parallel for schedule(static)
+    for (int v = 0; v < nPadHeight; v++)
+    {
+        double fv = ((v <= nPadHeight / 2) ? v : v - nPadHeight) / (double)nPadHeight;
+
+        for (int u = 0; u < nSpecWidth; u++)
+        {
+            double fu = u / (double)nPadWidth, D = sqrt(fu * fu + fv * fv), H;
+
+            if (nType == FREQ_IDEAL_LOWPASS || nType == FREQ_IDEAL_HIGHPASS)
+                H = (D <= dCutoff) ? 1.0 : 0.0;
+            else
+                H = 1.0 / (1.0 + pow(D / dCutoff, 2.0 * nOrder));
+            if (nType == FREQ_IDEAL_HIGHPASS || nType == FREQ_BUTTERWORTH_HIGHPASS)
+                H = 1.0 - H;
+            pFilter->pTransfer[(size_t)v * nSpecWidth + u].re = H;
+            pFilter->pTransfer[(size_t)v * nSpecWidth + u].im = 0.0;
+        }
+    }
+    return 0;
+}
+
+/*
+ * @Function Name : FftFilterRelease
+ * @Description : FFT 필터의 메모리를 해제합니다.
+ * @Input : *pFilter
+ */
+void FftFilterRelease(FFT_FILTER *pFilter)
+{
+    FftRelease(&pFilter->Plan);
+    free(pFilter->pTransfer);
+    memset(pFilter, 0, sizeof(FFT_FILTER));
+}
+
+/*
+ * @Function Name : FftFilterApply
+ * @Description : FFT 필터를 영상에 적용합니다. (영상 크기는 필터를 만들 때와 같아야 함, 여러 프레임에 반복 사용)
+ * @Input : *pFilter, *pIn - 8, 16비트 그레이 영상 (ROI 가능)
+ * @Output : *pOut - pIn과 같은 형식, 크기 (pIn과 같아도 됨), 반환값 0 (성공) / -1 (입력 오류, 메모리 할당 오류)
+ */
+// 김광제의 설명 - 영상 FFT -> 전달 함수 곱 -> 역 FFT 한번씩 (커널 스펙트럼은 FftFilterKernel에서 미리 계산)
+int FftFilterApply(const FFT_FILTER *pFilter, const IMAGE *pIn, IMAGE *pOut)
+{
+    int nPadWidth = pFilter->Plan.nWidth, nPadHeight = pFilter->Plan.nHeight, nSpecWidth = pFilter->Plan.nSpecWidth;
+    size_t nPadSize = (size_t)nPadWidth * nPadHeight, nSpecSize = (size_t)nPadHeight * nSpecWidth;
+    double *pPad;
+    FFT_COMPLEX *pSpec;
+    int nRet = 0;
+    PROFILE_BEGIN(dStart);
+
+    if ((pIn->nFormat != PIXEL_GRAY8 && pIn->nFormat != PIXEL_GRAY16) || pOut->nFormat != pIn->nFormat || pIn->nWidth != pFilter->nWidth ||
+        pIn->nHeight != pFilter->nHeight || pOut->nWidth != pIn->nWidth || pOut->nHeight != pIn->nHeight || NULL == pFilter->pTransfer)
+        return (-1);
+
+    pPad = (double *)PoolAlloc(GetThreadPool(), sizeof(double) * nPadSize, 0);
+    pSpec = (FFT_COMPLEX *)PoolAlloc(GetThreadPool(), sizeof(FFT_COMPLEX) * nSpecSize, 0);
+    if (NULL == pPad || NULL == pSpec)
+        nRet = -1;
+
+    if (nRet == 0)
+    {
+        LoadPadded(pIn, pPad, nPadWidth, nPadHeight, pFilter->nOffsetX, pFilter->nOffsetY);
+        nRet = FftForward2D(&pFilter->Plan, pPad, pSpec);
+    }
+    if (nRet == 0)
+    {
+#pragma omp parallel for schedule(static)
+        for (int v = 0; v < nPadHeight; v++)
+            for (int u = 0; u < nSpecWidth; u++)
+            {
+                FFT_COMPLEX *pS = &pSpec[(size_t)v * nSpecWidth + u];
+                const FFT_COMPLEX *pH = &pFilter->pTransfer[(size_t)v * nSpecWidth + u];
+                double re = pS->re * pH->re - pS->im * pH->im;
+
+                pS->im = pS->re * pH->im + pS->im * pH->re;
+                pS->re = re;
+            }
+        nRet = FftInverse2D(&pFilter->Plan, pSpec, pPad);
+    }
+    if (nRet == 0)
+    {
+#pragma omp parallel for schedule(static)
+        for (int y = 0; y < pOut->nHeight; y++)
+            StoreRow(pPad + (size_t)(y + pFilter->nOffsetY) * nPadWidth + pFilter->nOffsetX, pOut->pPlane[0] + (size_t)y * pOut->nStride, pOut->nWidth,
+                     pOut->nFormat, pFilter->nPost);
+    }
+
+    PoolFree(GetThreadPool(), pPad);
+    PoolFree(GetThreadPool(), pSpec);
+    PROFILE_END(dStart, "fft_filter", (long long)pIn->nWidth * pIn->nHeight, (long long)nPadSize * (3 * sizeof(double) + 4 * sizeof(FFT_COMPLEX)));
+    return nRet;
+}
+
+/*
+ * @Function Name : ConvolutionDirect
+ * @Description : 큰 커널을 직접 곱해서 컨볼루션합니다. (영상 밖은 가장 가까운 가장자리 픽셀)
+ * @Input : *pIn, *pKernel, nKernelWidth, nKernelHeight, nPost
+ * @Output : *pOut, 반환값 0 (성공) / -1 (메모리 할당 오류)
+ */
+// 김광제의 설명 - 가장자리를 늘린 double 영상을 한번 만들고, 결과 행마다 커널 행 하나씩 (계수 X 늘린 행)을 누적한다.
+// 안쪽 반복이 연속 메모리의 곱셈 누적이라 컴파일러가 벡터화함
+static int ConvolutionDirect(const IMAGE *pIn, IMAGE *pOut, const double *pKernel, int nKernelWidth, int nKernelHeight, int nPost)
+{
+    int nWidth = pIn->nWidth, nHeight = pIn->nHeight, rx = nKernelWidth / 2, ry = nKernelHeight / 2;
+    int nPadWidth = nWidth + 2 * rx, nPadHeight = nHeight + 2 * ry, nFailed = 0;
+    double *pPad = (double *)PoolAlloc(GetThreadPool(), sizeof(double) * nPadWidth * nPadHeight, 0);
+
+    if (NULL == pPad)
+        return (-1);
+    LoadPadded(pIn, pPad, nPadWidth, nPadHeight, rx, ry);
+
+#pragma omp parallel reduction(+ : nFailed)
+    {
+        double *pAcc = (double *)malloc(sizeof(double) * nWidth);
+
+        if (NULL == pAcc)
+            nFailed++;
+
+#pragma omp for schedule(static)
+        for (int y = 0; y < nHeight; y++)
+        {
+            if (NULL == pAcc)
+                continue;
+            memset(pAcc, 0, sizeof(double) * nWidth);
+            for (int j = 0; j < nKernelHeight; j++)
+            {
+                const double *pRow = pPad + (size_t)(y + j) * nPadWidth;
+
+                for (int i = 0; i < nKernelWidth; i++)
+                {
+                    double k = pKernel[j * nKernelWidth + i];
+
+                    if (k == 0.0)
+                        continue;
+                    for (int x = 0; x < nWidth; x++)
+                        pAcc[x] += k * pRow[x + i];
+                }
+            }
+            StoreRow(pAcc, pOut->pPlane[0] + (size_t)y * pOut->nStride, nWidth, pOut->nFormat, nPost);
+        }
+        free(pAcc);
+    }
+
+    PoolFree(GetThreadPool(), pPad);
+    return (nFailed == 0) ? 0 : (-1);
+}
+
+/*
+ * @Function Name : ImgConvolutionLarge
+ * @Description : 임의 크기 커널로 컨볼루션합니다. (영상 밖은 가장 가까운 가장자리 픽셀, 모든 픽셀을 처리)
+ * @Input : *pIn - 8, 16비트 그레이 영상 (ROI 가능),
+ *          *pKernel - nKernelWidth X nKernelHeight (홀수) 연속 버퍼,
+ *          nPost - CONV_POST_ABS면 절대값, 나머지는 0 ~ 최대값으로 클리핑 (결과는 반올림),
+ *          nMethod - CONV_METHOD_AUTO (예상 비용이 작은 쪽), CONV_METHOD_DIRECT, CONV_METHOD_FFT
+ * @Output : *pOut - pIn과 같은 형식, 크기 (pIn과 같아도 됨), 반환값 0 (성공) / -1 (입력 오류, 메모리 할당 오류)
+ */
+// 김광제의 설명 - 직접 계산은 픽셀마다 커널 크기만큼, FFT는 (늘린 크기) log2(늘린 크기) X 3번 (커널, 영상, 역변환)에 비례한다.
+// 같은 커널을 여러 프레임에 쓰면 FftFilterKernel로 필터를 한번 만들고 FftFilterApply를 반복하는 것이 빠름 (커널 변환 생략)
+int ImgConvolutionLarge(const IMAGE *pIn, IMAGE *pOut, const double *pKernel, int nKernelWidth, int nKernelHeight, int nPost, int nMethod)
+{
+    FFT_FILTER Filter;
+    int nRet;
+    PROFILE_BEGIN(dStart);
+
+    if ((pIn->nFormat != PIXEL_GRAY8 && pIn->nFormat != PIXEL_GRAY16) || pOut->nFormat != pIn->nFormat || pOut->nWidth != pIn->nWidth ||
+        pOut->nHeight != pIn->nHeight || NULL == pKernel || nKernelWidth < 1 || nKernelHeight < 1 ||
+        !(nKernelWidth & 1) || !(nKernelHeight & 1) || nMethod < CONV_METHOD_AUTO || nMethod > CONV_METHOD_FFT)
+        return (-1);
+
+    if (nMethod == CONV_METHOD_AUTO)
+    {
+        double dPadWidth = FftGoodSize(pIn->nWidth + nKernelWidth - 1), dPadHeight = FftGoodSize(pIn->nHeight + nKernelHeight - 1);
+        double dDirect = (double)nKernelWidth * nKernelHeight * pIn->nWidth * pIn->nHeight;
+        double dFft = 3.0 * FFT_COST_PER_POINT * dPadWidth * dPadHeight * log2(dPadWidth * dPadHeight);
+
+        nMethod = (dFft < dDirect) ? CONV_METHOD_FFT : CONV_METHOD_DIRECT;
+    }
+
+    if (nMethod == CONV_METHOD_DIRECT)
+        nRet = ConvolutionDirect(pIn, pOut, pKernel, nKernelWidth, nKernelHeight, nPost);
+    else
+    {
+        nRet = FftFilterKernel(&Filter, pIn->nWidth, pIn->nHeight, pKernel, nKernelWidth, nKernelHeight, nPost);
+        if (nRet == 0)
+        {
+            nRet = FftFilterApply(&Filter, pIn, pOut);
+            FftFilterRelease(&Filter);
+        }
+    }
+
+    PROFILE_COUNT((nMethod == CONV_METHOD_FFT) ? "convolution_large_fft" : "convolution_large_direct", 1);
+    PROFILE_END(dStart, "convolution_large", (long long)pIn->nWidth * pIn->nHeight, (long long)pIn->nWidth * pIn->nHeight * 2);
+    return nRet;
+}
+
+/*
+ * @Function Name : ImgFrequencyFilter
+ * @Description : 이상적 / 버터워스 저역, 고역 통과 필터를 적용합니다. (한 영상만 처리, 여러 프레임은 FftFilterFrequency + FftFilterApply)
+ * @Input : *pIn - 8, 16비트 그레이 영상 (ROI 가능), nType - FREQ_xxx, dCutoff - 차단 주파수 (픽셀당 주기, 0 초과 0.5 이하), nOrder - 버터워스 차수
+ * @Output : *pOut (pIn과 같아도 됨), 반환값 0 (성공) / -1 (입력 오류, 메모리 할당 오류)
+ */
+// 김광제의 설명 - 고역 통과 결과의 음수는 0으로 클리핑 (HPF 커널의 CONV_POST_CLIP과 같음)
+int ImgFrequencyFilter(const IMAGE *pIn, IMAGE *pOut, int nType, double dCutoff, int nOrder)
+{
+    FFT_FILTER Filter;
+    int nRet;
+
+    if (FftFilterFrequency(&Filter, pIn->nWidth, pIn->nHeight, nType, dCutoff, nOrder) < 0)
+        return (-1);
+    nRet = FftFilterApply(&Filter, pIn, pOut);
+    FftFilterRelease(&Filter);
+    return nRet;
+}
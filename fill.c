@@ -0,0 +1,252 @@
+/*
+ * @Name : fill.c
+ * @Description : Image Processing in C - 구간(스캔라인) 단위 영역 채우기와 구멍 채우기
+ * @Date : 2026. 10. 19
+ * @Revision : 1.0
+ * 1.0 : ImgFloodFill (시작점, 4/8연결, 밝기 허용 범위), ImgFillHoles (영상 둘레에서 배경을 채워서 닿지 않은 배경 = 구멍)
+ *
+ * ComponentLabeling처럼 픽셀마다 스택에 넣으면 영상 크기만큼 스택이 필요하고 픽셀마다 넣고 빼는 비용이 든다.
+ * 한 행에서 이어진 구간을 한번에 채우고 위, 아래 행에는 구간 하나만 넣으면 스택은 구간 수만큼만 쓰고 픽셀은 한번씩만 본다.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "imgprocessing.h"
+#include "profile.h"
+
+#define FILL_INIT_SPANS 1024 // 처음 할당하는 구간 스택 크기 (모자라면 2배씩)
+
+// 채울 픽셀을 찾을 구간 (y 행의 xl ~ xr, dy는 이 구간을 넣은 행에서 온 방향)
+typedef struct
+{
+    int y, xl, xr, dy;
+} FILL_SPAN;
+
+// 채우기 대상 (밝기가 nLo ~ nHi이고 아직 표시하지 않은 픽셀)
+typedef struct
+{
+    const BYTE *pSrc; // 밝기를 검사할 영상
+    BYTE *pDst;       // 채운 픽셀에 nValue를 쓸 영상 (NULL이면 쓰지 않음, pSrc와 같으면 제자리)
+    int nStride, nWidth, nHeight;
+    BYTE nLo, nHi, nValue;
+    BYTE *pMark;      // nWidth X nHeight 채운 픽셀 표시 (NULL이면 pDst에 쓴 값이 nLo ~ nHi 밖이라서 필요 없음)
+    FILL_SPAN *pStack;
+    int nTop, nMaxStack;
+} FILL_STATE;
+
+/*
+ * @Function Name : IsFillable
+ * @Description : (x, y)가 아직 채우지 않은 채울 픽셀인지 검사합니다.
+ */
+static int IsFillable(const FILL_STATE *pState, int x, int y)
+{
+    BYTE v = pState->pSrc[(size_t)y * pState->nStride + x];
+
+    return v >= pState->nLo && v <= pState->nHi && (NULL == pState->pMark || !pState->pMark[(size_t)y * pState->nWidth + x]);
+}
+
+/*
+ * @Function Name : PushSpan
+ * @Description : 구간을 스택에 넣습니다. (영상 밖 행은 넣지 않고, 열은 영상 안으로 자름)
+ * @Output : 반환값 0 (성공) / -1 (메모리 할당 오류)
+ */
+static int PushSpan(FILL_STATE *pState, int y, int xl, int xr, int dy)
+{
+    FILL_SPAN *pSpan;
+
+    if (y < 0 || y >= pState->nHeight)
+        return 0;
+    if (xl < 0)
+        xl = 0;
+    if (xr > pState->nWidth - 1)
+        xr = pState->nWidth - 1;
+    if (xl > xr)
+        return 0;
+
+    if (pState->nTop == pState->nMaxStack)
+    {
+        int nMax = (pState->nMaxStack > 0) ? pState->nMaxStack * 2 : FILL_INIT_SPANS;
+        FILL_SPAN *pNew = (FILL_SPAN *)realloc(pState->pStack, sizeof(FILL_SPAN) * nMax);
+
+        if (NULL == pNew)
+            return (-1);
+        pState->pStack = pNew;
+        pState->nMaxStack = nMax;
+    }
+
+    pSpan = &pState->pStack[pState->nTop++];
+    pSpan->y = y;
+    pSpan->xl = xl;
+    pSpan->xr = xr;
+    pSpan->dy = dy;
+    return 0;
+}
+
+/*
+ * @Function Name : FillFrom
+ * @Description : (x0, y0)에서 시작해서 이어진 채울 픽셀을 모두 채웁니다.
+ * @Input : *pState, x0, y0 (채울 픽셀이어야 함), nConnectivity - 4 또는 8
+ * @Output : 반환값 채운 픽셀 수 / -1 (메모리 할당 오류)
+ */
+// 김광제의 설명 - 1. 구간을 꺼내서 그 안의 채울 픽셀마다 왼쪽, 오른쪽 끝까지 이어진 구간을 한번에 채운다.
+// 2. 채운 구간은 온 방향(dy)의 다음 행에 통째로 넣고, 온 행에서 채운 구간보다 옆으로 넓어진 부분만 반대 방향(온 행)에 다시 넣는다.
+//    (온 행에서 채운 구간은 다시 보지 않음)
+// 3. 8연결은 대각선 이웃까지 닿도록 위, 아래 행에 넣는 구간을 양쪽으로 1픽셀씩 넓힌다. (꺼낸 구간 = 온 행에서 채운 구간 ± 1)
+static long long FillFrom(FILL_STATE *pState, int x0, int y0, int nConnectivity)
+{
+    int c = (nConnectivity == 8) ? 1 : 0;
+    long long nFilled = 0;
+
+    // 시작점을 구간 하나로 넣고, 시작점 위 행은 따로 넣음 (시작 구간은 온 행이 없음)
+    if (PushSpan(pState, y0, x0, x0, 1) < 0 || PushSpan(pState, y0 - 1, x0 - c, x0 + c, -1) < 0)
+        return (-1);
+
+    while (pState->nTop > 0)
+    {
+        FILL_SPAN Span = pState->pStack[--pState->nTop];
+        int y = Span.y, x = Span.xl;
+
+        while (x <= Span.xr)
+        {
+            int s = x, e = x;
+
+            if (!IsFillable(pState, x, y))
+            {
+                x++;
+                continue;
+            }
+
+            // 1. 이어진 구간 (꺼낸 구간 밖으로 넘어갈 수 있음)
+            while (s > 0 && IsFillable(pState, s - 1, y))
+                s--;
+            while (e < pState->nWidth - 1 && IsFillable(pState, e + 1, y))
+                e++;
+            if (NULL != pState->pDst)
+                memset(pState->pDst + (size_t)y * pState->nStride + s, pState->nValue, (size_t)(e - s + 1));
+            if (NULL != pState->pMark)
+                memset(pState->pMark + (size_t)y * pState->nWidth + s, 1, (size_t)(e - s + 1));
+            nFilled += e - s + 1;
+
+            // 2. 다음 행, 넓어진 부분의 온 행
+            if (PushSpan(pState, y + Span.dy, s - c, e + c, Span.dy) < 0 ||
+                (s < Span.xl + c && PushSpan(pState, y - Span.dy, s - c, Span.xl + c - 1, -Span.dy) < 0) ||
+                (e > Span.xr - c && PushSpan(pState, y - Span.dy, Span.xr - c + 1, e + c, -Span.dy) < 0))
+                return (-1);
+
+            x = e + 2; // e + 1은 채울 픽셀이 아님
+        }
+    }
+    return nFilled;
+}
+
+/*
+ * @Function Name : ImgFloodFill
+ * @Description : 8비트 그레이 영상에서 (x, y)와 이어진 비슷한 밝기의 영역을 nValue로 채웁니다. (제자리 처리)
+ * @Input : *pImg - 8비트 그레이 영상 (ROI 가능), x, y - 시작점, nValue - 채울 값,
+ *          nTolerance - 시작점 밝기 ± nTolerance 안의 픽셀을 채움 (0 ~ 255, 이진 영상은 0), nConnectivity - 4 또는 8
+ * @Output : *pImg, 반환값 채운 픽셀 수 / -1 (입력 오류, 메모리 할당 오류)
+ */
+// 김광제의 설명 - 밝기 범위는 바로 옆 픽셀이 아니라 시작점 기준이라서 천천히 밝아지는 영역으로 번지지 않는다.
+// 채울 값이 범위 밖이면 채운 픽셀이 저절로 대상에서 빠지므로 표시 버퍼 없이 영상만 쓴다.
+int ImgFloodFill(IMAGE *pImg, int x, int y, BYTE nValue, int nTolerance, int nConnectivity)
+{
+    FILL_STATE State;
+    int nSeed;
+    long long nFilled;
+    PROFILE_BEGIN(dStart);
+
+    if (pImg->nFormat != PIXEL_GRAY8 || x < 0 || y < 0 || x >= pImg->nWidth || y >= pImg->nHeight || nTolerance < 0 || nTolerance > 255 ||
+        (nConnectivity != 4 && nConnectivity != 8))
+        return (-1);
+
+    memset(&State, 0, sizeof(State));
+    nSeed = pImg->pPlane[0][(size_t)y * pImg->nStride + x];
+    State.pSrc = State.pDst = pImg->pPlane[0];
+    State.nStride = pImg->nStride;
+    State.nWidth = pImg->nWidth;
+    State.nHeight = pImg->nHeight;
+    State.nLo = (BYTE)((nSeed > nTolerance) ? nSeed - nTolerance : 0);
+    State.nHi = (BYTE)((nSeed + nTolerance < 255) ? nSeed + nTolerance : 255);
+    State.nValue = nValue;
+    if (nValue >= State.nLo && nValue <= State.nHi)
+    {
+        State.pMark = (BYTE *)PoolAlloc(GetThreadPool(), (size_t)State.nWidth * State.nHeight, 1);
+        if (NULL == State.pMark)
+            return (-1);
+    }
+
+    nFilled = FillFrom(&State, x, y, nConnectivity);
+
+    free(State.pStack);
+    PoolFree(GetThreadPool(), State.pMark);
+    PROFILE_COUNT("flood_fill_pixels", nFilled);
+    PROFILE_END(dStart, "flood_fill", (nFilled > 0) ? nFilled : 0, (nFilled > 0) ? nFilled * 2 : 0);
+    return (nFilled < 0) ? (-1) : (int)nFilled;
+}
+
+/*
+ * @Function Name : ImgFillHoles
+ * @Description : 8비트 이진 영상의 객체(전경 255) 안의 구멍(영상 둘레와 4연결로 이어지지 않은 배경)을 255로 채웁니다.
+ * @Input : *pIn - 8비트 이진 영상 (ROI 가능, 255가 아닌 값은 배경)
+ * @Output : *pOut (영상 전체를 씀, pIn과 같아도 됨), 반환값 0 (성공) / -1 (입력 오류, 메모리 할당 오류)
+ */
+// 김광제의 설명 - 영상 둘레의 배경 픽셀마다 배경을 4연결로 채워서 표시하면 표시되지 않은 배경이 구멍이다.
+// 배경 픽셀은 한번씩만 채워지므로 표시까지 영상 크기에 비례하고, 마지막에 한번 훑으면서 결과를 씀
+// (전경은 8연결이라 대각선으로만 닿은 배경은 바깥과 이어지지 않은 것으로 봄, ImgFindContours의 구멍과 같음)
+int ImgFillHoles(const IMAGE *pIn, IMAGE *pOut)
+{
+    int nWidth = pIn->nWidth, nHeight = pIn->nHeight, nRet = 0;
+    FILL_STATE State;
+    PROFILE_BEGIN(dStart);
+
+    if (pIn->nFormat != PIXEL_GRAY8 || pOut->nFormat != PIXEL_GRAY8 || pOut->nWidth != nWidth || pOut->nHeight != nHeight)
+        return (-1);
+
+    memset(&State, 0, sizeof(State));
+    State.pSrc = pIn->pPlane[0];
+    State.nStride = pIn->nStride;
+    State.nWidth = nWidth;
+    State.nHeight = nHeight;
+    State.nLo = 0;
+    State.nHi = 254;
+    State.pMark = (BYTE *)PoolAlloc(GetThreadPool(), (size_t)nWidth * nHeight, 1);
+    if (NULL == State.pMark)
+        return (-1);
+
+    // 1. 둘레에서 바깥 배경 표시 (위, 아래 행, 왼쪽, 오른쪽 열)
+    for (int x = 0; x < nWidth && nRet == 0; x++)
+    {
+        if (IsFillable(&State, x, 0) && FillFrom(&State, x, 0, 4) < 0)
+            nRet = -1;
+        if (nRet == 0 && IsFillable(&State, x, nHeight - 1) && FillFrom(&State, x, nHeight - 1, 4) < 0)
+            nRet = -1;
+    }
+    for (int y = 1; y < nHeight - 1 && nRet == 0; y++)
+    {
+        if (IsFillable(&State, 0, y) && FillFrom(&State, 0, y, 4) < 0)
+            nRet = -1;
+        if (nRet == 0 && IsFillable(&State, nWidth - 1, y) && FillFrom(&State, nWidth - 1, y, 4) < 0)
+            nRet = -1;
+    }
+
+    // 2. 표시되지 않은 배경 = 구멍
+    if (nRet == 0)
+    {
+#pragma omp parallel for schedule(static)
+        for (int y = 0; y < nHeight; y++)
+        {
+            const BYTE *pSrc = pIn->pPlane[0] + (size_t)y * pIn->nStride;
+            const BYTE *pMark = State.pMark + (size_t)y * nWidth;
+            BYTE *pDst = pOut->pPlane[0] + (size_t)y * pOut->nStride;
+
+            for (int x = 0; x < nWidth; x++)
+                pDst[x] = pMark[x] ? pSrc[x] : 255;
+        }
+    }
+
+    free(State.pStack);
+    PoolFree(GetThreadPool(), State.pMark);
+    PROFILE_END(dStart, "fill_holes", (long long)nWidth * nHeight, (long long)nWidth * nHeight * 3);
+    return nRet;
+}
@@ -0,0 +1,3029 @@
+/*
+ * @Name : golden_test.c
+ * @Description : 기존 8비트 함수(기준 구현)와 최적화 경로(IMAGE 입력 함수, 템플릿 커널, ROI, Planar, OpenMP)의 결과 비교
+ * @Date : 2026. 10. 19
+ * @Revision : 2.8
+ * 1.0 : coins.bmp, noise.bmp, scratch.bmp와 홀수 크기 난수 영상에 대해 모든 기능을 비트 단위로 비교
+ * 1.1 : 처리 컨텍스트(RunOperation) 결과 비교
+ * 1.2 : 지연 실행 파이프라인(PipelineRun) 결과를 RunOperation을 차례로 실행한 결과와 비교
+ * 1.3 : 16비트 고정 커널 정수 컨볼루션을 double 커널 결과와 비교
+ * 1.4 : 일괄 처리(BatchProcess)로 저장한 파일을 PipelineRun 결과와 비교 (결과 파일은 현재 폴더에 만들고 지움)
+ * 1.5 : RLE8, 1비트 BMP를 저장하고 다시 읽은 결과를 원본과 비교, PNG 청크 구조 확인
+ * 1.6 : 거리 변환을 모든 배경 픽셀과 직접 비교한 결과와 비교, 반지름 단위 침식/팽창을 Erosion, Dilation 반복과 비교
+ * 1.7 : 원 허프 변환을 그려 넣은 원(맞닿은 원, 반전 영상, ROI, 스레드 수)과 coins.bmp 동전 개수로 확인
+ * 1.8 : 직선 허프 변환을 그려 넣은 선분(표준, 점진 방식, 스레드 수)과 소벨 에지 사각형으로 확인
+ * 1.9 : 워터셰드로 맞닿은 원(ROI, 스레드 수)을 나누는지, 마커가 능선에서 만나는지, coins.bmp 동전 개수로 확인
+ * 2.0 : 윤곽선 점을 모두 모은 것이 ImgDetectObjectEdge 경계와 같은지, 구멍 계층, Douglas-Peucker 결과 확인
+ *       DetectObjectEdge가 영상 밖을 배경으로 보도록 고쳐서 배경으로 둘러싼 영상 없이 바로 비교
+ * 2.1 : 영역 채우기, 구멍 채우기를 픽셀 단위 너비 우선 탐색 결과와 비교
+ * 2.2 : RLE 영상 왕복 변환, 런 단위 레이블링(너비 우선 탐색), 침식/팽창(ImgErosionRadius 체스판, 직접 계산) 비교
+ * 2.3 : FFT를 직접 계산한 DFT와 비교, 큰 커널 컨볼루션(직접 / FFT / ROI 제자리)을 픽셀 단위 계산과 비교, 주파수 영역 필터 확인
+ * 2.4 : 위상 상관 정합을 알고 있는 이동량(정수, 부화소), 회전, 배율로 만든 합성 영상으로 확인
+ * 2.5 : 재귀 가우시안 흐림을 직접 계산한 가우시안 컨볼루션과, 상자 흐림을 직접 계산한 상자 평균 3번과 비교
+ * 2.6 : 일괄 처리를 모든 저장 형식(RLE8, 1비트 BMP, PNG)으로 확인, PNG는 직접 구현한 inflate(DecodePng)로 풀어서 비교
+ * 2.7 : PNG 저장(8, 16비트 그레이, 24, 32비트 컬러)을 DecodePng로 풀어서 원본과 비교, RLE8, 1비트 BMP는 헤더의 저장 방식도 확인
+ * 2.8 : 크기가 깨진 BMP 헤더(0 이하, INT_MIN, 넘침, 파일보다 큰 크기)를 ReadBitmap이 거부하는지 확인
+ *
+ * 사용법 : golden_test [이미지 폴더 (기본값 .)] [난수 시드 (기본값 1)]
+ * 반환값 : 0 (모두 같음) / 1 (다른 결과가 있음)
+ *
+ * 비교 기준 (허용 오차)
+ *   - 모든 비교는 비트 단위로 같아야 함 (허용 오차 0)
+ *   - CLAHE, ComponentLabeling은 기존 함수가 IMAGE 함수를 그대로 호출하므로 ROI, 스레드 수가 달라도 같은지만 비교
+ *   - 컬러 영상은 채널마다 기존 8비트 함수를 실행한 결과와 비교 (알파는 점 연산에서 복사, 기하 변환에서 같이 이동)
+ *   - Interleaved 32비트의 알파는 컨볼루션, 미디언이 처리한 픽셀에서만 복사되므로 가장자리 알파는 비교하지 않음 (Planar는 평면 전체 복사)
+ *   - 원 허프 변환은 그려 넣은 원의 중심, 반지름과 1.5픽셀 안이면 같은 것으로 봄 (ROI, 스레드 수가 달라도 결과는 비트 단위로 같아야 함)
+ *   - 직선 허프 변환은 각도 1도, 거리 1.5픽셀, 끝점 2픽셀 안이면 같은 것으로 봄 (스레드 수가 달라도 결과는 비트 단위로 같아야 함)
+ *   - 워터셰드는 객체 수와 원 중심의 번호만 확인 (맞닿은 곳의 경계 위치는 비교하지 않음, ROI, 스레드 수가 달라도 레이블은 같아야 함)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <limits.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "imgprocessing.h"
+
+// 비교할 기능 (기존 함수와 IMAGE 함수 한 쌍)
+#define GOLDEN_INVERSE 0
+#define GOLDEN_BRIGHTNESS_UP 1
+#define GOLDEN_BRIGHTNESS_DOWN 2
+#define GOLDEN_CONTRAST_UP 3
+#define GOLDEN_CONTRAST_DOWN 4
+#define GOLDEN_BINARIZATION 5
+#define GOLDEN_STRETCHING 6
+#define GOLDEN_EQUALIZATION 7
+#define GOLDEN_CONVOLUTION 8 // 8 ~ 15 : KERNEL_AVERAGE ~ KERNEL_HPF_LAPLACIAN
+#define GOLDEN_MEDIAN_3 16
+#define GOLDEN_MEDIAN_5 17
+#define GOLDEN_VERTICAL_FLIP 18
+#define GOLDEN_HORIZONTAL_FLIP 19
+#define GOLDEN_TRANSLATION 20
+#define GOLDEN_SCALING 21
+#define GOLDEN_ROTATION 22
+#define GOLDEN_EROSION 23
+#define GOLDEN_DILATION 24
+#define GOLDEN_EDGE 25
+#define GOLDEN_OP_COUNT 26
+
+// 채널마다 따로 처리되는 기능만 컬러 영상에서 비교 (히스토그램 기능, 형태학 연산은 8비트 전용)
+#define GOLDEN_IS_COLOR_OP(nOp) ((nOp) <= GOLDEN_BINARIZATION || ((nOp) >= GOLDEN_CONVOLUTION && (nOp) <= GOLDEN_ROTATION))
+// 알파 채널도 같이 옮기는 기하 변환
+#define GOLDEN_IS_GEOMETRIC(nOp) ((nOp) >= GOLDEN_VERTICAL_FLIP && (nOp) <= GOLDEN_ROTATION)
+
+static const char *GoldenOpNames[GOLDEN_OP_COUNT] = {
+    "inverse", "brightness+40", "brightness-70", "contrast1.7", "contrast0.3", "binarization",
+    "stretching", "equalization", "average", "gaussian", "laplacian", "prewitt_x",
+    "prewitt_y", "sobel_x", "sobel_y", "hpf_laplacian", "median3", "median5",
+    "vertical_flip", "horizontal_flip", "translation", "scaling", "rotation", "erosion",
+    "dilation", "detect_object_edge"};
+
+static int nChecks, nFailures;
+static IMGPROC_CONTEXT Context; // RunOperation 비교용 처리 컨텍스트
+
+/*
+ * @Function Name : Check
+ * @Description : 비교 결과를 기록하고 다르면 출력합니다.
+ * @Input : bOk, *szImage, *szTest, *szOp
+ */
+static void Check(int bOk, const char *szImage, const char *szTest, const char *szOp)
+{
+    nChecks++;
+    if (!bOk)
+    {
+        nFailures++;
+        printf("FAIL %-16s %-22s %s\n", szImage, szTest, szOp);
+    }
+}
+
+/*
+ * @Function Name : RandomByte
+ * @Description : 고정 시드 선형 합동 생성기 (플랫폼마다 rand()가 달라도 같은 영상을 만들기 위함)
+ */
+static unsigned int nRandomSeed = 1u;
+static BYTE RandomByte(void)
+{
+    nRandomSeed = nRandomSeed * 1103515245u + 12345u;
+    return (BYTE)(nRandomSeed >> 16);
+}
+
+/*
+ * @Function Name : IsSameImage
+ * @Description : 두 영상(행 간격이 달라도 됨)의 모든 평면이 같은지 비교합니다.
+ * @Input : *pA, *pB
+ * @Output : 1 (같음) / 0 (다름)
+ */
+static int IsSameImage(const IMAGE *pA, const IMAGE *pB)
+{
+    int nPlanes = (pA->nLayout == LAYOUT_PLANAR) ? pA->nChannels : 1;
+    size_t nRowBytes = (pA->nLayout == LAYOUT_PLANAR) ? (size_t)pA->nWidth : (size_t)pA->nWidth * GetBytesPerPixel(pA->nFormat);
+
+    for (int c = 0; c < nPlanes; c++)
+        for (int i = 0; i < pA->nHeight; i++)
+            if (memcmp(pA->pPlane[c] + (size_t)i * pA->nStride, pB->pPlane[c] + (size_t)i * pB->nStride, nRowBytes) != 0)
+                return 0;
+
+    return 1;
+}
+
+/*
+ * @Function Name : SetThreads
+ * @Description : OpenMP 스레드 수를 설정합니다. (OpenMP 없이 빌드하면 아무것도 안함)
+ */
+static void SetThreads(int nThreads)
+{
+#ifdef _OPENMP
+    omp_set_num_threads(nThreads);
+#else
+    (void)nThreads;
+#endif
+}
+
+/*
+ * @Function Name : RunLegacy
+ * @Description : 기존 8비트 함수(기준 구현)를 실행합니다.
+ * @Input : nOp, *Input, nWidth, nHeight
+ * @Output : *Output
+ */
+// 김광제의 설명 - 기준 결과는 항상 1 스레드로 만든다. (최적화 경로는 여러 스레드로 실행해서 비교)
+static void RunLegacy(int nOp, BYTE *Input, BYTE *Output, int nWidth, int nHeight)
+{
+    int nHisto[256] = {
+        0,
+    };
+
+    SetThreads(1);
+    switch (nOp)
+    {
+    case GOLDEN_INVERSE:
+        InverseImage(Input, Output, nWidth, nHeight);
+        break;
+    case GOLDEN_BRIGHTNESS_UP:
+        AdjustBrightness(Input, Output, nWidth, nHeight, 40);
+        break;
+    case GOLDEN_BRIGHTNESS_DOWN:
+        AdjustBrightness(Input, Output, nWidth, nHeight, -70);
+        break;
+    case GOLDEN_CONTRAST_UP:
+        AdjustContrast(Input, Output, nWidth, nHeight, 1.7);
+        break;
+    case GOLDEN_CONTRAST_DOWN:
+        AdjustContrast(Input, Output, nWidth, nHeight, 0.3);
+        break;
+    case GOLDEN_BINARIZATION:
+        GenerateBinarization(Input, Output, nWidth, nHeight, 100);
+        break;
+    case GOLDEN_STRETCHING:
+        GenerateHistogram(Input, nHisto, nWidth, nHeight);
+        HistogramStretching(Input, Output, nHisto, nWidth, nHeight);
+        break;
+    case GOLDEN_EQUALIZATION:
+        GenerateHistogram(Input, nHisto, nWidth, nHeight);
+        HistogramEqualization(Input, Output, nHisto, nWidth, nHeight);
+        break;
+    case GOLDEN_MEDIAN_3:
+        MedianFilter(Input, Output, nWidth, nHeight);
+        break;
+    case GOLDEN_MEDIAN_5:
+        MedianFiltering(Input, Output, nWidth, nHeight, 5);
+        break;
+    case GOLDEN_VERTICAL_FLIP:
+        memcpy(Output, Input, (size_t)nWidth * nHeight);
+        VerticalFlip(Output, nWidth, nHeight);
+        break;
+    case GOLDEN_HORIZONTAL_FLIP:
+        memcpy(Output, Input, (size_t)nWidth * nHeight);
+        HorizontalFlip(Output, nWidth, nHeight);
+        break;
+    case GOLDEN_TRANSLATION:
+        Translation(Input, Output, nWidth, nHeight, 5, -3);
+        break;
+    case GOLDEN_SCALING:
+        Scaling(Input, Output, nWidth, nHeight, 0.7, 1.3);
+        break;
+    case GOLDEN_ROTATION:
+        Rotation(Input, Output, nWidth, nHeight, 30);
+        break;
+    case GOLDEN_EROSION:
+        Erosion(Input, Output, nWidth, nHeight);
+        break;
+    case GOLDEN_DILATION:
+        Dilation(Input, Output, nWidth, nHeight);
+        break;
+    case GOLDEN_EDGE:
+        DetectObjectEdge(Input, Output, nWidth, nHeight);
+        break;
+    default: // 컨볼루션
+        ConvolutionTable[nOp - GOLDEN_CONVOLUTION].Gray8(Input, Output, nWidth, nHeight);
+        break;
+    }
+}
+
+/*
+ * @Function Name : RunFast
+ * @Description : 같은 기능의 IMAGE 함수(최적화 경로)를 실행합니다.
+ * @Input : nOp, *pIn, nThreads
+ * @Output : *pOut
+ */
+static void RunFast(int nOp, const IMAGE *pIn, IMAGE *pOut, int nThreads)
+{
+    SetThreads(nThreads);
+    switch (nOp)
+    {
+    case GOLDEN_INVERSE:
+        ImgInverse(pIn, pOut);
+        break;
+    case GOLDEN_BRIGHTNESS_UP:
+        ImgAdjustBrightness(pIn, pOut, 40);
+        break;
+    case GOLDEN_BRIGHTNESS_DOWN:
+        ImgAdjustBrightness(pIn, pOut, -70);
+        break;
+    case GOLDEN_CONTRAST_UP:
+        ImgAdjustContrast(pIn, pOut, 1.7);
+        break;
+    case GOLDEN_CONTRAST_DOWN:
+        ImgAdjustContrast(pIn, pOut, 0.3);
+        break;
+    case GOLDEN_BINARIZATION:
+        ImgBinarization(pIn, pOut, 100);
+        break;
+    case GOLDEN_STRETCHING:
+        ImgHistogramStretching(pIn, pOut);
+        break;
+    case GOLDEN_EQUALIZATION:
+        ImgHistogramEqualization(pIn, pOut);
+        break;
+    case GOLDEN_MEDIAN_3:
+        ImgMedianFiltering(pIn, pOut, 3);
+        break;
+    case GOLDEN_MEDIAN_5:
+        ImgMedianFiltering(pIn, pOut, 5);
+        break;
+    case GOLDEN_VERTICAL_FLIP:
+        CopyImage(pIn, pOut);
+        ImgVerticalFlip(pOut);
+        break;
+    case GOLDEN_HORIZONTAL_FLIP:
+        CopyImage(pIn, pOut);
+        ImgHorizontalFlip(pOut);
+        break;
+    case GOLDEN_TRANSLATION:
+        ImgTranslation(pIn, pOut, 5, -3);
+        break;
+    case GOLDEN_SCALING:
+        ImgScaling(pIn, pOut, 0.7, 1.3);
+        break;
+    case GOLDEN_ROTATION:
+        ImgRotation(pIn, pOut, 30);
+        break;
+    case GOLDEN_EROSION:
+        ImgErosion(pIn, pOut);
+        break;
+    case GOLDEN_DILATION:
+        ImgDilation(pIn, pOut);
+        break;
+    case GOLDEN_EDGE:
+        ImgDetectObjectEdge(pIn, pOut);
+        break;
+    default:
+        ImgConvolution(pIn, pOut, nOp - GOLDEN_CONVOLUTION);
+        break;
+    }
+}
+
+/*
+ * @Function Name : GetContextOp
+ * @Description : 비교할 기능(GOLDEN_xxx)과 같은 RunOperation 기능 번호, 인자를 구합니다.
+ * @Input : nOp
+ * @Output : *pParam, 반환값 OP_xxx
+ */
+static int GetContextOp(int nOp, OP_PARAM *pParam)
+{
+    memset(pParam, 0, sizeof(OP_PARAM));
+    switch (nOp)
+    {
+    case GOLDEN_INVERSE:
+        return OP_INVERSE;
+    case GOLDEN_BRIGHTNESS_UP:
+        pParam->nBrightness = 40;
+        return OP_BRIGHTNESS;
+    case GOLDEN_BRIGHTNESS_DOWN:
+        pParam->nBrightness = -70;
+        return OP_BRIGHTNESS;
+    case GOLDEN_CONTRAST_UP:
+        pParam->dContrast = 1.7;
+        return OP_CONTRAST;
+    case GOLDEN_CONTRAST_DOWN:
+        pParam->dContrast = 0.3;
+        return OP_CONTRAST;
+    case GOLDEN_BINARIZATION:
+        pParam->nThreshold = 100;
+        return OP_BINARIZATION;
+    case GOLDEN_STRETCHING:
+        return OP_STRETCHING;
+    case GOLDEN_EQUALIZATION:
+        return OP_EQUALIZATION;
+    case GOLDEN_MEDIAN_3:
+        pParam->nSize = 3;
+        return OP_MEDIAN;
+    case GOLDEN_MEDIAN_5:
+        pParam->nSize = 5;
+        return OP_MEDIAN;
+    case GOLDEN_VERTICAL_FLIP:
+        return OP_VERTICAL_FLIP;
+    case GOLDEN_HORIZONTAL_FLIP:
+        return OP_HORIZONTAL_FLIP;
+    case GOLDEN_TRANSLATION:
+        pParam->Tx = 5;
+        pParam->Ty = -3;
+        return OP_TRANSLATION;
+    case GOLDEN_SCALING:
+        pParam->Sx = 0.7;
+        pParam->Sy = 1.3;
+        return OP_SCALING;
+    case GOLDEN_ROTATION:
+        pParam->Angle = 30;
+        return OP_ROTATION;
+    case GOLDEN_EROSION:
+        return OP_EROSION;
+    case GOLDEN_DILATION:
+        return OP_DILATION;
+    case GOLDEN_EDGE:
+        return OP_EDGE;
+    default:
+        pParam->nKernel = nOp - GOLDEN_CONVOLUTION;
+        return OP_CONVOLUTION;
+    }
+}
+
+// 파이프라인 비교용 기능 목록 ({기능 번호, 인자}, -1로 끝남)
+// 인자는 밝기, 임계값, 커널, 미디언 크기, 자동 이진화 방법, 대비 X 10
+#define PIPE_CHAIN_COUNT 7
+#define PIPE_CHAIN_MAX 8
+#define PIPE_CHAIN_COLOR 6 // 24비트 컬러 입력으로 실행하는 목록
+static const int PipeChains[PIPE_CHAIN_COUNT][PIPE_CHAIN_MAX][2] = {
+    {{OP_CONVOLUTION, KERNEL_GAUSSIAN}, {OP_CONVOLUTION, KERNEL_SOBEL_X}, {OP_BINARIZATION, 60}, {OP_DILATION, 0}, {-1, 0}},
+    {{OP_INVERSE, 0}, {OP_BRIGHTNESS, 30}, {OP_MEDIAN, 5}, {OP_EROSION, 0}, {OP_CONTRAST, 13}, {-1, 0}},
+    {{OP_MEDIAN, 3}, {OP_EQUALIZATION, 0}, {OP_CONVOLUTION, KERNEL_LAPLACIAN}, {OP_AUTO_BINARIZATION, THRESHOLD_OTSU}, {OP_DILATION, 0}, {OP_INVERSE, 0}, {-1, 0}},
+    {{OP_BRIGHTNESS, -20}, {OP_CONTRAST, 8}, {OP_BINARIZATION, 100}, {OP_COPY, 0}, {-1, 0}},
+    {{OP_MEDIAN, 7}, {OP_DILATION, 0}, {OP_CONVOLUTION, KERNEL_AVERAGE}, {OP_EROSION, 0}, {-1, 0}},
+    {{OP_VERTICAL_FLIP, 0}, {OP_CONVOLUTION, KERNEL_PREWITT_Y}, {OP_CLAHE, 0}, {OP_BRIGHTNESS, 15}, {-1, 0}},
+    {{OP_INVERSE, 0}, {OP_CONVOLUTION, KERNEL_GAUSSIAN}, {OP_TO_GRAY, 0}, {OP_MEDIAN, 3}, {OP_BINARIZATION, 128}, {-1, 0}},
+};
+
+/*
+ * @Function Name : BuildPipeline
+ * @Description : PipeChains의 c번째 목록으로 파이프라인을 만듭니다.
+ * @Input : c
+ * @Output : *pPipe
+ */
+static void BuildPipeline(PIPELINE *pPipe, int c)
+{
+    PipelineInit(pPipe);
+    for (int i = 0; i < PIPE_CHAIN_MAX && PipeChains[c][i][0] >= 0; i++)
+    {
+        int nValue = PipeChains[c][i][1];
+        OP_PARAM Param;
+
+        memset(&Param, 0, sizeof(OP_PARAM));
+        Param.nBrightness = Param.nThreshold = Param.nKernel = Param.nSize = Param.nMethod = nValue;
+        Param.dContrast = nValue / 10.0;
+        PipelineAdd(pPipe, PipeChains[c][i][0], &Param);
+    }
+}
+
+/*
+ * @Function Name : RunSequential
+ * @Description : 파이프라인의 기능을 RunOperation으로 하나씩 실행합니다. (PipelineRun 비교 기준)
+ * @Input : *pPipe, *pIn
+ * @Output : *pOut, 반환값 0 (성공) / -1 (처리 오류)
+ */
+static int RunSequential(const PIPELINE *pPipe, const IMAGE *pIn, IMAGE *pOut)
+{
+    IMAGE Temp[2];
+    const IMAGE *pCur = pIn;
+    int nRet = 0;
+
+    memset(Temp, 0, sizeof(Temp));
+    for (int i = 0; i < pPipe->nOps && nRet == 0; i++)
+    {
+        OP_PARAM Param = pPipe->Op[i].Param;
+        IMAGE *pDst = pOut;
+
+        if (i < pPipe->nOps - 1)
+        {
+            pDst = &Temp[i % 2];
+            FreeImage(pDst);
+            CreateImage(pDst, pIn->nWidth, pIn->nHeight, (pPipe->Op[i].nOp == OP_TO_GRAY) ? PIXEL_GRAY8 : pCur->nFormat, LAYOUT_INTERLEAVED);
+        }
+        nRet = RunOperation(&Context, pPipe->Op[i].nOp, pCur, pDst, &Param);
+        pCur = pDst;
+    }
+
+    FreeImage(&Temp[0]);
+    FreeImage(&Temp[1]);
+    return nRet;
+}
+
+/*
+ * @Function Name : TestPipeline
+ * @Description : PipelineRun 결과를 같은 기능을 RunOperation으로 차례로 실행한 결과와 비교합니다.
+ * @Input : *szImage, *Input, nWidth, nHeight
+ */
+// 김광제의 설명 - 타일 행 수를 자동, 1, 3으로 바꿔서 행 버퍼 경계가 영상 가장자리, 이웃 연산의 가장자리 폭과 겹치는 경우를 모두 확인한다.
+// ROI 출력, 입력과 출력이 같은 영상(제자리 처리)도 같이 비교
+static void TestPipeline(const char *szImage, BYTE *Input, int nWidth, int nHeight)
+{
+    const int nTiles[] = {0, 1, 3};
+    IMAGE Gray, Color, Ref, Out, BigOut, RoiOut, Copy;
+    PIPELINE Pipe;
+    OP_PARAM Param;
+
+    WrapImage(&Gray, Input, nWidth, nHeight, PIXEL_GRAY8, 0);
+    CreateImage(&Color, nWidth, nHeight, PIXEL_BGR24, LAYOUT_INTERLEAVED);
+    for (int i = 0; i < nHeight; i++)
+        for (int j = 0; j < nWidth; j++)
+        {
+            BYTE *p = Color.pPlane[0] + (size_t)i * Color.nStride + (size_t)j * 3;
+
+            p[0] = Input[(size_t)i * nWidth + j];
+            p[1] = 255 - p[0];
+            p[2] = RandomByte();
+        }
+    CreateImage(&BigOut, nWidth + 9, nHeight + 4, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+    CreateROI(&BigOut, &RoiOut, 4, 2, nWidth, nHeight);
+
+    for (int c = 0; c < PIPE_CHAIN_COUNT; c++)
+    {
+        const IMAGE *pIn = (c == PIPE_CHAIN_COLOR) ? &Color : &Gray;
+        char szTest[32];
+        int bRef;
+
+        snprintf(szTest, sizeof(szTest), "chain %d", c);
+        BuildPipeline(&Pipe, c);
+        CreateImage(&Ref, nWidth, nHeight, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+        CreateImage(&Out, nWidth, nHeight, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+        bRef = (RunSequential(&Pipe, pIn, &Ref) == 0); // 작은 영상은 CLAHE가 실패하므로 실패도 같은지 비교
+
+        for (int t = 0; t < (int)(sizeof(nTiles) / sizeof(nTiles[0])); t++)
+        {
+            Pipe.nTileRows = nTiles[t];
+            memset(Out.pBuffer, 0xA5, (size_t)Out.nStride * nHeight);
+            Check((PipelineRun(&Context, &Pipe, pIn, &Out) == 0) == bRef && (!bRef || IsSameImage(&Ref, &Out)), szImage, "pipeline", szTest);
+        }
+
+        Pipe.nTileRows = 0;
+        memset(BigOut.pBuffer, 0xA5, (size_t)BigOut.nStride * BigOut.nHeight);
+        Check((PipelineRun(&Context, &Pipe, pIn, &RoiOut) == 0) == bRef && (!bRef || IsSameImage(&Ref, &RoiOut)), szImage, "pipeline roi", szTest);
+
+        if (pIn == &Gray)
+        {
+            CreateImage(&Copy, nWidth, nHeight, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+            CopyImage(&Gray, &Copy);
+            Check((PipelineRun(&Context, &Pipe, &Copy, &Copy) == 0) == bRef && (!bRef || IsSameImage(&Ref, &Copy)), szImage, "pipeline in-place", szTest);
+            FreeImage(&Copy);
+        }
+
+        FreeImage(&Ref);
+        FreeImage(&Out);
+    }
+
+    // 파이프라인에 넣을 수 없는 기능, 잘못된 인자
+    PipelineInit(&Pipe);
+    memset(&Param, 0, sizeof(OP_PARAM));
+    Check(PipelineAdd(&Pipe, OP_COMBINE_MAX, &Param) != 0, szImage, "pipeline", "combine_max");
+    Param.nSize = 4;
+    PipelineAdd(&Pipe, OP_MEDIAN, &Param);
+    Check(PipelineRun(&Context, &Pipe, &Gray, &RoiOut) != 0, szImage, "pipeline", "median_even");
+
+    FreeImage(&Color);
+    FreeImage(&BigOut);
+}
+
+// PNG 확인용 inflate (pngio.c와 따로 RFC 1950, 1951대로 구현, 저장 / 고정 / 동적 허프만 블록 모두)
+typedef struct
+{
+    const BYTE *pIn; // zlib 데이터
+    size_t nIn, nInPos;
+    DWORD dwBits; // 아직 사용하지 않은 비트 (하위 비트부터)
+    int nBits;
+    BYTE *pOut;
+    size_t nOut, nMax;
+    int bError; // 입력이 모자람
+} INFLATE_STATE;
+
+typedef struct
+{
+    short nCount[16];   // 길이별 코드 수
+    short nSymbol[288]; // 코드 순서대로 정렬한 심볼
+} INFLATE_HUFFMAN;
+
+static const short InflateLenBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const short InflateLenExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const short InflateDistBase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769,
+                                          1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+static const short InflateDistExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+/*
+ * @Function Name : InflateBits
+ * @Description : 비트 스트림에서 nNeed 비트를 읽습니다. (하위 비트부터)
+ * @Input : *pState, nNeed (0 ~ 16)
+ * @Output : 읽은 값 (입력이 모자라면 pState->bError = 1)
+ */
+static int InflateBits(INFLATE_STATE *pState, int nNeed)
+{
+    DWORD dwValue = pState->dwBits;
+
+    while (pState->nBits < nNeed)
+    {
+        if (pState->nInPos == pState->nIn)
+        {
+            pState->bError = 1;
+            return 0;
+        }
+        dwValue |= (DWORD)pState->pIn[pState->nInPos++] << pState->nBits;
+        pState->nBits += 8;
+    }
+    pState->dwBits = dwValue >> nNeed;
+    pState->nBits -= nNeed;
+    return (int)(dwValue & ((1u << nNeed) - 1));
+}
+
+/*
+ * @Function Name : InflateBuild
+ * @Description : 심볼별 코드 길이로 정규 허프만 표를 만듭니다.
+ * @Input : *pLen - 심볼별 코드 길이 (0이면 없음), nSymbols
+ * @Output : *pHuff, 반환값 0 (완전한 코드) / 양수 (빈 코드가 남음) / -1 (코드가 너무 많음)
+ */
+static int InflateBuild(INFLATE_HUFFMAN *pHuff, const BYTE *pLen, int nSymbols)
+{
+    short nOffset[16];
+    int nLeft = 1;
+
+    memset(pHuff->nCount, 0, sizeof(pHuff->nCount));
+    for (int s = 0; s < nSymbols; s++)
+        pHuff->nCount[pLen[s]]++;
+    if (pHuff->nCount[0] == nSymbols)
+        return 0;
+
+    for (int nLen = 1; nLen < 16; nLen++)
+    {
+        nLeft = nLeft * 2 - pHuff->nCount[nLen];
+        if (nLeft < 0)
+            return (-1);
+    }
+
+    nOffset[1] = 0;
+    for (int nLen = 1; nLen < 15; nLen++)
+        nOffset[nLen + 1] = nOffset[nLen] + pHuff->nCount[nLen];
+    for (int s = 0; s < nSymbols; s++)
+        if (pLen[s] != 0)
+            pHuff->nSymbol[nOffset[pLen[s]]++] = (short)s;
+    return nLeft;
+}
+
+/*
+ * @Function Name : InflateDecode
+ * @Description : 허프만 코드 하나를 읽어서 심볼로 바꿉니다.
+ * @Input : *pState, *pHuff
+ * @Output : 심볼 (잘못된 코드, 입력이 모자라면 -1)
+ */
+// 김광제의 설명 - 정규 허프만 코드는 길이가 같은 코드끼리 연속이므로 한 비트씩 늘리면서 그 길이의 첫 코드와 개수로 찾는다.
+static int InflateDecode(INFLATE_STATE *pState, const INFLATE_HUFFMAN *pHuff)
+{
+    int nCode = 0, nFirst = 0, nIndex = 0;
+
+    for (int nLen = 1; nLen < 16; nLen++)
+    {
+        nCode |= InflateBits(pState, 1);
+        if (pState->bError)
+            return (-1);
+        if (nCode - pHuff->nCount[nLen] < nFirst)
+            return pHuff->nSymbol[nIndex + (nCode - nFirst)];
+        nIndex += pHuff->nCount[nLen];
+        nFirst = (nFirst + pHuff->nCount[nLen]) << 1;
+        nCode <<= 1;
+    }
+    return (-1);
+}
+
+/*
+ * @Function Name : InflateCodes
+ * @Description : 허프만 블록 하나의 리터럴, 길이 / 거리 쌍을 블록 끝(256)까지 풉니다.
+ * @Input : *pState, *pLitLen, *pDist
+ * @Output : 반환값 0 (성공) / -1 (잘못된 데이터, 출력 크기 초과)
+ */
+static int InflateCodes(INFLATE_STATE *pState, const INFLATE_HUFFMAN *pLitLen, const INFLATE_HUFFMAN *pDist)
+{
+    int nSym;
+
+    do
+    {
+        nSym = InflateDecode(pState, pLitLen);
+        if (nSym < 0)
+            return (-1);
+        if (nSym < 256)
+        {
+            if (pState->nOut == pState->nMax)
+                return (-1);
+            pState->pOut[pState->nOut++] = (BYTE)nSym;
+        }
+        else if (nSym > 256)
+        {
+            int nLen, nDistSym;
+            size_t nDist;
+
+            if (nSym - 257 >= 29)
+                return (-1);
+            nLen = InflateLenBase[nSym - 257] + InflateBits(pState, InflateLenExtra[nSym - 257]);
+            nDistSym = InflateDecode(pState, pDist);
+            if (nDistSym < 0 || nDistSym >= 30)
+                return (-1);
+            nDist = InflateDistBase[nDistSym] + InflateBits(pState, InflateDistExtra[nDistSym]);
+            if (pState->bError || nDist > pState->nOut || (size_t)nLen > pState->nMax - pState->nOut)
+                return (-1);
+            for (int i = 0; i < nLen; i++, pState->nOut++)
+                pState->pOut[pState->nOut] = pState->pOut[pState->nOut - nDist];
+        }
+    } while (nSym != 256);
+
+    return 0;
+}
+
+/*
+ * @Function Name : InflateDynamic
+ * @Description : 동적 허프만 블록의 코드 길이 표를 읽고 블록을 풉니다.
+ * @Input : *pState
+ * @Output : 반환값 0 (성공) / -1 (잘못된 데이터)
+ */
+static int InflateDynamic(INFLATE_STATE *pState)
+{
+    static const BYTE Order[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+    BYTE Len[320];
+    INFLATE_HUFFMAN LitLen, Dist;
+    int nLit = InflateBits(pState, 5) + 257, nDist = InflateBits(pState, 5) + 1, nCodeLen = InflateBits(pState, 4) + 4, nErr;
+
+    if (pState->bError || nLit > 286 || nDist > 30)
+        return (-1);
+
+    // 코드 길이 코드 (완전한 코드여야 함)
+    memset(Len, 0, sizeof(Len));
+    for (int i = 0; i < nCodeLen; i++)
+        Len[Order[i]] = (BYTE)InflateBits(pState, 3);
+    if (pState->bError || InflateBuild(&LitLen, Len, 19) != 0)
+        return (-1);
+
+    // 리터럴 / 길이, 거리 코드 길이 (16 : 앞 길이 3 ~ 6번, 17 : 0을 3 ~ 10번, 18 : 0을 11 ~ 138번)
+    for (int i = 0; i < nLit + nDist;)
+    {
+        int nSym = InflateDecode(pState, &LitLen), nRepeat;
+        BYTE nValue = 0;
+
+        if (nSym < 0)
+            return (-1);
+        if (nSym < 16)
+        {
+            Len[i++] = (BYTE)nSym;
+            continue;
+        }
+        if (nSym == 16)
+        {
+            if (i == 0)
+                return (-1);
+            nValue = Len[i - 1];
+            nRepeat = 3 + InflateBits(pState, 2);
+        }
+        else if (nSym == 17)
+            nRepeat = 3 + InflateBits(pState, 3);
+        else
+            nRepeat = 11 + InflateBits(pState, 7);
+        if (pState->bError || i + nRepeat > nLit + nDist)
+            return (-1);
+        while (nRepeat-- > 0)
+            Len[i++] = nValue;
+    }
+    if (Len[256] == 0)
+        return (-1);
+
+    // 코드가 하나뿐인 경우만 불완전한 코드를 허용
+    nErr = InflateBuild(&LitLen, Len, nLit);
+    if (nErr < 0 || (nErr > 0 && nLit != LitLen.nCount[0] + LitLen.nCount[1]))
+        return (-1);
+    nErr = InflateBuild(&Dist, Len + nLit, nDist);
+    if (nErr < 0 || (nErr > 0 && nDist != Dist.nCount[0] + Dist.nCount[1]))
+        return (-1);
+
+    return InflateCodes(pState, &LitLen, &Dist);
+}
+
+/*
+ * @Function Name : Inflate
+ * @Description : zlib 형식 데이터를 풀고 헤더, Adler-32를 확인합니다.
+ * @Input : *pIn, nIn, nMax - 출력 버퍼 크기
+ * @Output : *pOut, 반환값 푼 바이트 수 (잘못된 데이터, 뒤에 남는 데이터가 있으면 -1)
+ */
+static long long Inflate(const BYTE *pIn, size_t nIn, BYTE *pOut, size_t nMax)
+{
+    INFLATE_STATE State;
+    DWORD s1 = 1, s2 = 0, dwAdler;
+    int bLast = 0;
+
+    // CMF (deflate, 창 32K 이하), FLG (31의 배수, 사전 없음)
+    if (nIn < 6 || (pIn[0] & 0x0F) != 8 || (pIn[0] >> 4) > 7 || (pIn[0] * 256 + pIn[1]) % 31 != 0 || (pIn[1] & 0x20) != 0)
+        return (-1);
+
+    memset(&State, 0, sizeof(State));
+    State.pIn = pIn;
+    State.nIn = nIn - 4;
+    State.nInPos = 2;
+    State.pOut = pOut;
+    State.nMax = nMax;
+
+    while (!bLast)
+    {
+        int nType, nRet = 0;
+
+        bLast = InflateBits(&State, 1);
+        nType = InflateBits(&State, 2);
+        if (State.bError)
+            return (-1);
+
+        if (nType == 0)
+        {
+            // 저장 블록 : 바이트 경계부터 LEN, NLEN (LEN의 보수), 데이터
+            size_t nLen;
+
+            State.dwBits = 0;
+            State.nBits = 0;
+            if (State.nIn - State.nInPos < 4)
+                return (-1);
+            nLen = State.pIn[State.nInPos] | State.pIn[State.nInPos + 1] << 8;
+            if ((nLen ^ (State.pIn[State.nInPos + 2] | State.pIn[State.nInPos + 3] << 8)) != 0xFFFF)
+                return (-1);
+            State.nInPos += 4;
+            if (nLen > State.nIn - State.nInPos || nLen > State.nMax - State.nOut)
+                return (-1);
+            memcpy(State.pOut + State.nOut, State.pIn + State.nInPos, nLen);
+            State.nInPos += nLen;
+            State.nOut += nLen;
+        }
+        else if (nType == 1)
+        {
+            // 고정 허프만 : 0 ~ 143 8비트, 144 ~ 255 9비트, 256 ~ 279 7비트, 280 ~ 287 8비트, 거리 5비트
+            static INFLATE_HUFFMAN FixedLitLen, FixedDist;
+            static int bFixed = 0;
+
+            if (!bFixed)
+            {
+                BYTE Len[288];
+
+                for (int s = 0; s < 288; s++)
+                    Len[s] = (s < 144) ? 8 : ((s < 256) ? 9 : ((s < 280) ? 7 : 8));
+                InflateBuild(&FixedLitLen, Len, 288);
+                memset(Len, 5, 30);
+                InflateBuild(&FixedDist, Len, 30);
+                bFixed = 1;
+            }
+            nRet = InflateCodes(&State, &FixedLitLen, &FixedDist);
+        }
+        else if (nType == 2)
+            nRet = InflateDynamic(&State);
+        else
+            return (-1);
+
+        if (nRet != 0)
+            return (-1);
+    }
+
+    // 마지막 블록의 남은 비트는 버리고 바로 뒤가 Adler-32 (빅 엔디안)
+    if (State.nInPos != State.nIn)
+        return (-1);
+    for (size_t i = 0; i < State.nOut; i++)
+    {
+        s1 = (s1 + State.pOut[i]) % 65521;
+        s2 = (s2 + s1) % 65521;
+    }
+    dwAdler = (DWORD)pIn[nIn - 4] << 24 | (DWORD)pIn[nIn - 3] << 16 | (DWORD)pIn[nIn - 2] << 8 | pIn[nIn - 1];
+    return (dwAdler == (s2 << 16 | s1)) ? (long long)State.nOut : (-1);
+}
+
+/*
+ * @Function Name : GetBE32
+ * @Description : 빅 엔디안 32비트 값을 읽습니다.
+ */
+static DWORD GetBE32(const BYTE *p)
+{
+    return (DWORD)p[0] << 24 | (DWORD)p[1] << 16 | (DWORD)p[2] << 8 | p[3];
+}
+
+/*
+ * @Function Name : DecodePng
+ * @Description : PNG 파일을 읽어서 BMP와 같은 배치(아래에서 위, B, G, R 순서, 16비트는 리틀 엔디안)로 바꿉니다.
+ * @Input : *fp - "rb"로 연 파일 (처음부터 읽음)
+ * @Output : *pWidth, *pHeight, *pFormat (PIXEL_xxx), 반환값 픽셀 데이터 (PoolFree(GetThreadPool(), ...)로 반납, 잘못된 파일이면 NULL)
+ */
+// 김광제의 설명 - 모든 청크의 CRC, IHDR이 처음이고 IEND가 마지막인지, 필터 번호, 압축을 푼 크기가 정확히 맞는지 확인한다.
+// WritePng가 쓰지 않는 필터(Average, Paeth), 블록 형식도 풀 수 있어서 저장 방식이 바뀌어도 그대로 사용 가능
+static BYTE *DecodePng(FILE *fp, int *pWidth, int *pHeight, int *pFormat)
+{
+    static const BYTE Signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    DWORD dwCrcTable[256];
+    BYTE *pFile = NULL, *pIdat = NULL, *pRaw = NULL, *pImage = NULL;
+    size_t nFile = 0, nIdat = 0, nPos = 8, nRowBytes = 0, nRawSize = 0;
+    int nWidth = 0, nHeight = 0, nDepth = 0, nColorType = -1, nChannels = 0, nBpp = 0, nFormat = 0, bEnd = 0, bOk;
+    long nTell;
+
+    for (DWORD n = 0; n < 256; n++)
+    {
+        DWORD c = n;
+
+        for (int k = 0; k < 8; k++)
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        dwCrcTable[n] = c;
+    }
+
+    if (fseek(fp, 0, SEEK_END) == 0 && (nTell = ftell(fp)) > 0)
+        nFile = (size_t)nTell;
+    rewind(fp);
+    if (nFile > 0)
+    {
+        pFile = (BYTE *)malloc(nFile);
+        pIdat = (BYTE *)malloc(nFile);
+    }
+    bOk = (pFile != NULL && pIdat != NULL && fread(pFile, 1, nFile, fp) == nFile && nFile >= 8 && memcmp(pFile, Signature, 8) == 0);
+
+    // 청크 : 길이, 종류, 데이터, CRC (종류 + 데이터)
+    while (bOk && !bEnd && nFile - nPos >= 12)
+    {
+        DWORD dwLen = GetBE32(pFile + nPos), dwCrc = 0xFFFFFFFFu;
+        const BYTE *pType = pFile + nPos + 4, *pChunk = pType + 4;
+
+        if (dwLen > nFile - nPos - 12)
+        {
+            bOk = 0;
+            break;
+        }
+        for (size_t i = 0; i < dwLen + 4; i++)
+            dwCrc = dwCrcTable[(dwCrc ^ pType[i]) & 0xFF] ^ (dwCrc >> 8);
+        if ((dwCrc ^ 0xFFFFFFFFu) != GetBE32(pChunk + dwLen))
+            bOk = 0;
+        else if (memcmp(pType, "IHDR", 4) == 0)
+        {
+            // 크기, 비트 깊이, 색 형식 (0 : 그레이 8, 16, 2 : RGB 8, 6 : RGBA 8), 압축, 필터, 인터레이스 0
+            nWidth = (int)GetBE32(pChunk);
+            nHeight = (int)GetBE32(pChunk + 4);
+            nDepth = pChunk[8];
+            nColorType = pChunk[9];
+            nChannels = (nColorType == 0) ? 1 : ((nColorType == 2) ? 3 : 4);
+            bOk = (nPos == 8 && dwLen == 13 && nWidth > 0 && nWidth <= 65535 && nHeight > 0 && nHeight <= 65535 &&
+                   ((nColorType == 0 && (nDepth == 8 || nDepth == 16)) || ((nColorType == 2 || nColorType == 6) && nDepth == 8)) &&
+                   pChunk[10] == 0 && pChunk[11] == 0 && pChunk[12] == 0);
+        }
+        else if (nColorType < 0)
+            bOk = 0;
+        else if (memcmp(pType, "IDAT", 4) == 0)
+        {
+            memcpy(pIdat + nIdat, pChunk, dwLen);
+            nIdat += dwLen;
+        }
+        else if (memcmp(pType, "IEND", 4) == 0)
+            bOk = (dwLen == 0), bEnd = 1;
+        else if (pType[0] < 'a')
+            bOk = 0; // 모르는 필수 청크 (첫 글자가 대문자)
+        nPos += 12 + dwLen;
+    }
+    bOk = bOk && bEnd && nPos == nFile && nIdat > 0;
+
+    if (bOk)
+    {
+        nBpp = nChannels * nDepth / 8;
+        nRowBytes = (size_t)nWidth * nBpp;
+        nRawSize = (nRowBytes + 1) * nHeight;
+        pRaw = (BYTE *)malloc(nRawSize);
+        bOk = (pRaw != NULL && Inflate(pIdat, nIdat, pRaw, nRawSize) == (long long)nRawSize);
+    }
+
+    // 행 필터 되돌리기 (a : 왼쪽, b : 위, c : 왼쪽 위)
+    for (int y = 0; bOk && y < nHeight; y++)
+    {
+        BYTE *pRow = pRaw + (size_t)y * (nRowBytes + 1) + 1;
+        const BYTE *pUp = (y > 0) ? pRow - (nRowBytes + 1) : NULL;
+        int nFilter = pRow[-1];
+
+        if (nFilter > 4)
+        {
+            bOk = 0;
+            break;
+        }
+        for (size_t x = 0; x < nRowBytes; x++)
+        {
+            int a = (x >= (size_t)nBpp) ? pRow[x - nBpp] : 0, b = (pUp != NULL) ? pUp[x] : 0;
+            int c = (pUp != NULL && x >= (size_t)nBpp) ? pUp[x - nBpp] : 0, p = a + b - c, nPred = 0;
+
+            if (nFilter == 1)
+                nPred = a;
+            else if (nFilter == 2)
+                nPred = b;
+            else if (nFilter == 3)
+                nPred = (a + b) / 2;
+            else if (nFilter == 4)
+                nPred = (abs(p - a) <= abs(p - b) && abs(p - a) <= abs(p - c)) ? a : ((abs(p - b) <= abs(p - c)) ? b : c);
+            pRow[x] = (BYTE)(pRow[x] + nPred);
+        }
+    }
+
+    if (bOk)
+    {
+        nFormat = (nDepth == 16) ? PIXEL_GRAY16 : ((nColorType == 0) ? PIXEL_GRAY8 : ((nColorType == 2) ? PIXEL_BGR24 : PIXEL_BGRA32));
+        pImage = (BYTE *)PoolAlloc(GetThreadPool(), nRowBytes * nHeight, 0);
+    }
+    for (int y = 0; pImage != NULL && y < nHeight; y++)
+    {
+        const BYTE *pSrc = pRaw + (size_t)y * (nRowBytes + 1) + 1;
+        BYTE *pDst = pImage + (size_t)(nHeight - 1 - y) * nRowBytes;
+
+        if (nFormat == PIXEL_GRAY8)
+            memcpy(pDst, pSrc, nRowBytes);
+        else if (nFormat == PIXEL_GRAY16)
+            for (int x = 0; x < nWidth; x++)
+            {
+                pDst[x * 2] = pSrc[x * 2 + 1];
+                pDst[x * 2 + 1] = pSrc[x * 2];
+            }
+        else
+            for (int x = 0; x < nWidth; x++)
+            {
+                pDst[x * nBpp] = pSrc[x * nBpp + 2];
+                pDst[x * nBpp + 1] = pSrc[x * nBpp + 1];
+                pDst[x * nBpp + 2] = pSrc[x * nBpp];
+                if (nBpp == 4)
+                    pDst[x * nBpp + 3] = pSrc[x * nBpp + 3];
+            }
+    }
+
+    free(pFile);
+    free(pIdat);
+    free(pRaw);
+    *pWidth = nWidth;
+    *pHeight = nHeight;
+    *pFormat = nFormat;
+    return pImage;
+}
+
+/*
+ * @Function Name : ReadImageFile
+ * @Description : BMP, PNG 파일을 읽습니다. (PNG는 DecodePng)
+ * @Input : *szPath
+ * @Output : *pWidth, *pHeight, *pFormat, 반환값 픽셀 데이터 (PoolFree(GetThreadPool(), ...)로 반납, 실패하면 NULL)
+ */
+static BYTE *ReadImageFile(const char *szPath, int *pWidth, int *pHeight, int *pFormat)
+{
+    FILE *fp = fopen(szPath, "rb");
+    BITMAPFILEHEADER hf;
+    BITMAPINFOHEADER hInfo;
+    RGBQUAD hRGB[256];
+    BYTE *pImage, Head[8];
+
+    if (NULL == fp)
+        return NULL;
+    if (fread(Head, 1, 8, fp) == 8 && memcmp(Head, "\x89PNG\r\n\x1a\n", 8) == 0)
+    {
+        pImage = DecodePng(fp, pWidth, pHeight, pFormat);
+        fclose(fp);
+        return pImage;
+    }
+    rewind(fp);
+    pImage = ReadBitmap(fp, &hf, &hInfo, hRGB, pFormat);
+    fclose(fp);
+    *pWidth = hInfo.biWidth;
+    *pHeight = hInfo.biHeight;
+    return pImage;
+}
+
+/*
+ * @Function Name : TestBitmapHeader
+ * @Description : 크기가 깨진 BMP 헤더를 ReadBitmap이 할당 전에 거부하는지 확인합니다.
+ */
+// 김광제의 설명 - 정상 8비트 파일을 저장한 뒤 너비, 높이만 바꿔서 읽는다. (0 이하, INT_MIN, 행 크기 / 버퍼 크기 넘침, 파일보다 큰 크기)
+// 높이가 음수인 경우는 위에서 아래 순서 파일
+static void TestBitmapHeader(void)
+{
+    static const int nSizes[9][2] = {{0, 4}, {-7, 4}, {7, 0}, {7, INT_MIN}, {INT_MAX, 4}, {65536, -65536}, {40000, 40000}, {8, 5}, {7, 4}};
+    static const char *szCases[9] = {"width_0", "width_negative", "height_0", "height_int_min", "width_int_max",
+                                     "size_overflow", "huge_in_small_file", "larger_than_file", "valid"};
+    BITMAPFILEHEADER hf;
+    BITMAPINFOHEADER hInfo;
+    RGBQUAD hRGB[256];
+    BYTE Image[7 * 4];
+
+    memset(&hf, 0, sizeof(hf));
+    memset(&hInfo, 0, sizeof(hInfo));
+    hf.bfType = 0x4D42; // WriteBitmap은 원본 파일 헤더의 "BM"을 그대로 사용
+    hInfo.biSize = sizeof(BITMAPINFOHEADER);
+    hInfo.biWidth = 7;
+    hInfo.biHeight = 4;
+    hInfo.biPlanes = 1;
+    hInfo.biBitCount = 8;
+    for (int i = 0; i < 256; i++)
+    {
+        hRGB[i].rgbBlue = hRGB[i].rgbGreen = hRGB[i].rgbRed = (BYTE)i;
+        hRGB[i].rgbReserved = 0;
+    }
+    for (int i = 0; i < 7 * 4; i++)
+        Image[i] = (BYTE)(i * 9);
+
+    for (int c = 0; c < 9; c++)
+    {
+        FILE *fp = tmpfile();
+        BITMAPFILEHEADER hfRead;
+        BITMAPINFOHEADER hInfoRead;
+        BYTE *pRead = NULL;
+        int nFormat, bValid = (c == 8);
+
+        if (NULL == fp)
+            continue;
+        if (WriteBitmap(fp, &hf, &hInfo, hRGB, Image, PIXEL_GRAY8) == 0)
+        {
+            // 정상 파일은 7 X 4 (행 8바이트, 데이터 32바이트)라서 8 X 5부터는 데이터가 모자람
+            fseek(fp, sizeof(BITMAPFILEHEADER) + 4, SEEK_SET);
+            fwrite(nSizes[c], sizeof(int), 2, fp);
+            rewind(fp);
+            pRead = ReadBitmap(fp, &hfRead, &hInfoRead, hRGB, &nFormat);
+        }
+        Check((pRead != NULL) == bValid && (!bValid || memcmp(pRead, Image, sizeof(Image)) == 0), "bitmap_header", "read_bitmap", szCases[c]);
+        PoolFree(GetThreadPool(), pRead);
+        fclose(fp);
+    }
+}
+
+/*
+ * @Function Name : TestBatch
+ * @Description : BatchProcess로 저장한 파일을 같은 입력에 PipelineRun을 실행한 결과와 비교합니다. (저장 형식마다)
+ * @Input : *szDir - 예제 영상 폴더
+ */
+// 김광제의 설명 - 슬롯 수(3)보다 파일이 많도록 예제 영상을 반복해서 넣어서 슬롯이 여러번 돌아가는 경우를 확인한다.
+// 없는 파일은 실패로 세고 나머지 파일은 그대로 처리되어야 함
+// 파이프라인 0번은 이진 영상을 만드므로 RLE8, 1비트 BMP, PNG 모두 저장 가능 (쓰기 스레드가 저장 버퍼를 남기면 LeakSanitizer로 확인됨)
+static void TestBatch(const char *szDir)
+{
+    const char *szFiles[] = {"coins.bmp", "noise.bmp", "scratch.bmp"};
+    const char *szFormats[4] = {"bmp", "rle8", "bmp1", "png"};
+    const int nFileFormats[4] = {FILE_BMP, FILE_BMP_RLE8, FILE_BMP_1BIT, FILE_PNG};
+    char szIn[8][512], szOut[8][64];
+    const char *szInputs[8], *szOutputs[8];
+    int nFiles = 8;
+    PIPELINE Pipe;
+    BATCH_STATS Stats;
+
+    for (int f = 0; f < nFiles; f++)
+    {
+        if (f == 5)
+            snprintf(szIn[f], sizeof(szIn[f]), "%s/not_found.bmp", szDir);
+        else
+            snprintf(szIn[f], sizeof(szIn[f]), "%s/%s", szDir, szFiles[f % 3]);
+        szInputs[f] = szIn[f];
+        szOutputs[f] = szOut[f];
+    }
+
+    BuildPipeline(&Pipe, 0);
+    for (int t = 0; t < 4; t++)
+    {
+        for (int f = 0; f < nFiles; f++)
+            snprintf(szOut[f], sizeof(szOut[f]), "golden_batch_%d.%s", f, (nFileFormats[t] == FILE_PNG) ? "png" : "bmp");
+        Check(BatchProcess(&Context, &Pipe, szInputs, szOutputs, nFiles, 3, nFileFormats[t], &Stats) != 0 && Stats.nFiles == nFiles &&
+                  Stats.nFailed == 1,
+              "batch", szFormats[t], "status");
+
+        for (int f = 0; f < nFiles; f++)
+        {
+            int nWidth, nHeight, nFormat, nOutWidth, nOutHeight, nOutFormat;
+            BYTE *pInput, *pOutput;
+            IMAGE In, Out, Ref;
+
+            if (f == 5)
+                continue;
+
+            pInput = ReadImageFile(szIn[f], &nWidth, &nHeight, &nFormat);
+            pOutput = ReadImageFile(szOut[f], &nOutWidth, &nOutHeight, &nOutFormat);
+            if (NULL == pInput)
+            {
+                PoolFree(GetThreadPool(), pOutput);
+                continue; // 예제 영상이 없음
+            }
+
+            WrapImage(&In, pInput, nWidth, nHeight, nFormat, 0);
+            CreateImage(&Ref, nWidth, nHeight, nFormat, LAYOUT_INTERLEAVED);
+            PipelineRun(&Context, &Pipe, &In, &Ref);
+            if (pOutput != NULL)
+                WrapImage(&Out, pOutput, nOutWidth, nOutHeight, nOutFormat, 0);
+            Check(pOutput != NULL && nOutWidth == nWidth && nOutHeight == nHeight && nOutFormat == nFormat && IsSameImage(&Ref, &Out),
+                  szFiles[f % 3], szFormats[t], szOut[f]);
+
+            FreeImage(&Ref);
+            PoolFree(GetThreadPool(), pInput);
+            PoolFree(GetThreadPool(), pOutput);
+            remove(szOut[f]);
+        }
+    }
+}
+
+/*
+ * @Function Name : IsSameCircles
+ * @Description : 원 허프 변환 결과 두 개가 같은지 비교합니다. (구조체 패딩은 값이 정해지지 않아서 멤버별로 비교)
+ */
+static int IsSameCircles(const HOUGH_CIRCLE *pA, const HOUGH_CIRCLE *pB, int nCount)
+{
+    for (int i = 0; i < nCount; i++)
+        if (pA[i].dX != pB[i].dX || pA[i].dY != pB[i].dY || pA[i].dRadius != pB[i].dRadius || pA[i].nVotes != pB[i].nVotes ||
+            pA[i].dCoverage != pB[i].dCoverage)
+            return 0;
+    return 1;
+}
+
+/*
+ * @Function Name : TestHough
+ * @Description : 원을 그려 넣은 영상에서 ImgHoughCircles가 모든 원을 찾는지 확인하고, coins.bmp의 동전 개수를 확인합니다.
+ * @Input : *szDir - 예제 영상 폴더, nThreads
+ */
+// 김광제의 설명 - 맞닿은 원 두 개를 넣어서 붙어 있는 동전처럼 경계를 나눠 쓰는 경우도 확인한다.
+// 반전 영상(밝은 배경의 어두운 원)도 같은 원이 나와야 하고, 난수로 채운 큰 영상 안의 ROI, 1 스레드 결과와도 같아야 함
+static void TestHough(const char *szDir, int nThreads)
+{
+    static const int nDisks[5][3] = {{70, 70, 40}, {150, 70, 40}, {260, 90, 30}, {110, 175, 45}, {250, 180, 35}}; // x, y, 반지름
+    int nWidth = 360, nHeight = 240, nFound[2], nCoins;
+    BYTE *pDisk = (BYTE *)calloc((size_t)nWidth * nHeight, 1);
+    HOUGH_CIRCLE Circles[2][16], Coins[32];
+    IMAGE In, Big, Roi;
+    char szPath[512];
+    BYTE *pCoins;
+    int nCoinW, nCoinH, nCoinFormat;
+
+    for (int y = 0; y < nHeight; y++)
+        for (int x = 0; x < nWidth; x++)
+            for (int d = 0; d < 5; d++)
+            {
+                int dx = x - nDisks[d][0], dy = y - nDisks[d][1];
+
+                if (dx * dx + dy * dy <= nDisks[d][2] * nDisks[d][2])
+                    pDisk[y * nWidth + x] = 255;
+            }
+
+    // 1. 그려 넣은 원 (원본, 반전 영상)
+    for (int bInverse = 0; bInverse < 2; bInverse++)
+    {
+        int bOk;
+
+        if (bInverse)
+            for (int i = 0; i < nWidth * nHeight; i++)
+                pDisk[i] = 255 - pDisk[i];
+
+        WrapImage(&In, pDisk, nWidth, nHeight, PIXEL_GRAY8, 0);
+        SetThreads(nThreads);
+        nFound[bInverse] = ImgHoughCircles(&In, 25, 50, 100, 0.5, Circles[bInverse], 16);
+        bOk = nFound[bInverse] == 5;
+        for (int d = 0; d < 5 && bOk; d++)
+        {
+            int bMatch = 0;
+
+            for (int i = 0; i < nFound[bInverse]; i++)
+                bMatch |= fabs(Circles[bInverse][i].dX - nDisks[d][0]) < 1.5 && fabs(Circles[bInverse][i].dY - nDisks[d][1]) < 1.5 &&
+                          fabs(Circles[bInverse][i].dRadius - nDisks[d][2]) < 1.5;
+            bOk = bMatch;
+        }
+        Check(bOk, "disks", "hough_circles", bInverse ? "inverse" : "normal");
+    }
+
+    // 2. ROI, 1 스레드 (반전 영상 결과와 비트 단위 비교)
+    CreateImage(&Big, nWidth + 13, nHeight + 7, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+    for (int i = 0; i < (nWidth + 13) * (nHeight + 7); i++)
+        Big.pBuffer[i] = RandomByte();
+    CreateROI(&Big, &Roi, 5, 3, nWidth, nHeight);
+    CopyImage(&In, &Roi);
+    nFound[0] = ImgHoughCircles(&Roi, 25, 50, 100, 0.5, Circles[0], 16);
+    Check(nFound[0] == nFound[1] && IsSameCircles(Circles[0], Circles[1], nFound[1]), "disks", "hough_circles", "roi");
+    SetThreads(1);
+    nFound[0] = ImgHoughCircles(&In, 25, 50, 100, 0.5, Circles[0], 16);
+    Check(nFound[0] == nFound[1] && IsSameCircles(Circles[0], Circles[1], nFound[1]), "disks", "hough_circles", "1 thread");
+    SetThreads(nThreads);
+
+    // 최대 개수만큼만 저장, 잘못된 인자
+    Check(ImgHoughCircles(&In, 25, 50, 100, 0.5, Circles[0], 2) == 2 && IsSameCircles(Circles[0], Circles[1], 2), "disks", "hough_circles",
+          "max_circles");
+    Check(ImgHoughCircles(&In, 50, 25, 100, 0.5, Circles[0], 16) < 0 && ImgHoughCircles(&In, 25, 50, 100, 1.5, Circles[0], 16) < 0 &&
+              ImgHoughCircles(&In, 25, 50, 100, 0.5, NULL, 16) < 0,
+          "disks", "hough_circles", "invalid");
+    FreeImage(&Big);
+    free(pDisk);
+
+    // 3. coins.bmp (맞닿은 동전 포함 22개, 없으면 건너뜀)
+    snprintf(szPath, sizeof(szPath), "%s/coins.bmp", szDir);
+    pCoins = ReadImageFile(szPath, &nCoinW, &nCoinH, &nCoinFormat);
+    if (NULL == pCoins)
+        return;
+    WrapImage(&In, pCoins, nCoinW, nCoinH, nCoinFormat, 0);
+    nCoins = ImgHoughCircles(&In, 15, 30, 100, 0.5, Coins, 32);
+    Check(nCoinFormat == PIXEL_GRAY8 && nCoins == 22, "coins.bmp", "hough_circles", "count");
+    PoolFree(GetThreadPool(), pCoins);
+}
+
+/*
+ * @Function Name : IsSameLines
+ * @Description : 직선 허프 변환 결과 두 개가 같은지 비교합니다. (구조체 패딩은 값이 정해지지 않아서 멤버별로 비교)
+ */
+static int IsSameLines(const HOUGH_LINE *pA, const HOUGH_LINE *pB, int nCount)
+{
+    for (int i = 0; i < nCount; i++)
+        if (pA[i].dRho != pB[i].dRho || pA[i].dTheta != pB[i].dTheta || pA[i].nVotes != pB[i].nVotes || pA[i].x0 != pB[i].x0 || pA[i].y0 != pB[i].y0 ||
+            pA[i].x1 != pB[i].x1 || pA[i].y1 != pB[i].y1)
+            return 0;
+    return 1;
+}
+
+/*
+ * @Function Name : IsLineFound
+ * @Description : 찾은 직선 중 (x0, y0) - (x1, y1) 선분과 각도 1도, 거리 1.5픽셀, 끝점 2픽셀 안에서 같은 직선이 있는지 검사합니다.
+ */
+static int IsLineFound(const HOUGH_LINE *pLines, int nCount, int x0, int y0, int x1, int y1)
+{
+    double dTheta = atan2(x1 - x0, y0 - y1); // 법선 (y0 - y1, x1 - x0)
+
+    if (dTheta < 0.0)
+        dTheta += M_PI;
+    if (dTheta >= M_PI)
+        dTheta -= M_PI;
+
+    for (int i = 0; i < nCount; i++)
+    {
+        const HOUGH_LINE *p = &pLines[i];
+        double dDiff = fabs(p->dTheta - dTheta), c = cos(p->dTheta), s = sin(p->dTheta);
+        int bSame = abs(p->x0 - x0) <= 2 && abs(p->y0 - y0) <= 2 && abs(p->x1 - x1) <= 2 && abs(p->y1 - y1) <= 2;
+        int bSwap = abs(p->x0 - x1) <= 2 && abs(p->y0 - y1) <= 2 && abs(p->x1 - x0) <= 2 && abs(p->y1 - y0) <= 2;
+
+        if (dDiff > M_PI / 2.0)
+            dDiff = M_PI - dDiff;
+        if (dDiff < M_PI / 180.0 && fabs(x0 * c + y0 * s - p->dRho) < 1.5 && fabs(x1 * c + y1 * s - p->dRho) < 1.5 && (bSame || bSwap))
+            return 1;
+    }
+    return 0;
+}
+
+/*
+ * @Function Name : TestHoughLines
+ * @Description : 직선을 그려 넣은 영상에서 ImgHoughLines가 두 방식 모두 모든 선분을 찾는지 확인합니다.
+ * @Input : nThreads
+ */
+// 김광제의 설명 - DetectObjectEdge 결과처럼 흰 배경에 0인 선분과 잡음 점을 그리고, 소벨 모드는 사각형의 네 변을 찾는지 본다.
+// 표준 방식은 병렬 투표라서 1 스레드 결과와 같아야 함
+static void TestHoughLines(int nThreads)
+{
+    static const int nSegments[3][4] = {{10, 20, 280, 110}, {100, 5, 130, 190}, {5, 180, 295, 180}}; // x0, y0, x1, y1
+    static const char *szModes[2] = {"standard", "progressive"};
+    int nWidth = 300, nHeight = 200, nFound[2];
+    BYTE *pEdge = (BYTE *)malloc((size_t)nWidth * nHeight);
+    HOUGH_LINE Lines[2][16];
+    IMAGE In;
+    unsigned int nSeed = 7u;
+
+    memset(pEdge, 255, (size_t)nWidth * nHeight);
+    for (int l = 0; l < 3; l++)
+    {
+        int dx = nSegments[l][2] - nSegments[l][0], dy = nSegments[l][3] - nSegments[l][1];
+        int nSteps = (abs(dx) > abs(dy)) ? abs(dx) : abs(dy);
+
+        for (int k = 0; k <= nSteps; k++)
+            pEdge[(int)lrint(nSegments[l][1] + (double)k * dy / nSteps) * nWidth + (int)lrint(nSegments[l][0] + (double)k * dx / nSteps)] = 0;
+    }
+    for (int i = 0; i < nWidth * nHeight / 200; i++) // 잡음 점 0.5%
+    {
+        nSeed = nSeed * 1103515245u + 12345u;
+        pEdge[(nSeed >> 8) % (unsigned int)(nWidth * nHeight)] = 0;
+    }
+    WrapImage(&In, pEdge, nWidth, nHeight, PIXEL_GRAY8, 0);
+
+    // 1. 그려 넣은 선분 (두 방식, 1 스레드)
+    for (int nMode = 0; nMode < 2; nMode++)
+    {
+        int bOk;
+
+        SetThreads(nThreads);
+        nFound[0] = ImgHoughLines(&In, 0, 60, 50, 3, nMode, Lines[0], 16);
+        bOk = nFound[0] == 3;
+        for (int l = 0; l < 3 && bOk; l++)
+            bOk = IsLineFound(Lines[0], nFound[0], nSegments[l][0], nSegments[l][1], nSegments[l][2], nSegments[l][3]);
+        Check(bOk, "lines", "hough_lines", szModes[nMode]);
+
+        SetThreads(1);
+        nFound[1] = ImgHoughLines(&In, 0, 60, 50, 3, nMode, Lines[1], 16);
+        Check(nFound[0] == nFound[1] && IsSameLines(Lines[0], Lines[1], nFound[1]), "lines", "hough_lines", "1 thread");
+        SetThreads(nThreads);
+    }
+
+    // 최대 개수만큼만 저장 (표준 방식은 점이 많은 직선부터), 잘못된 인자
+    nFound[0] = ImgHoughLines(&In, 0, 60, 50, 3, HOUGH_LINES_STANDARD, Lines[0], 16);
+    Check(ImgHoughLines(&In, 0, 60, 50, 3, HOUGH_LINES_STANDARD, Lines[1], 1) == 1 && IsSameLines(Lines[0], Lines[1], 1), "lines",
+          "hough_lines", "max_lines");
+    Check(ImgHoughLines(&In, 0, 0, 50, 3, HOUGH_LINES_STANDARD, Lines[0], 16) < 0 && ImgHoughLines(&In, 0, 60, 50, 3, 2, Lines[0], 16) < 0 &&
+              ImgHoughLines(&In, -1, 60, 50, 3, HOUGH_LINES_STANDARD, Lines[0], 16) < 0 && ImgHoughLines(&In, 0, 60, 50, 3, HOUGH_LINES_STANDARD, NULL, 16) < 0,
+          "lines", "hough_lines", "invalid");
+
+    // 2. 소벨 에지 (밝은 사각형의 네 변)
+    memset(pEdge, 0, (size_t)nWidth * nHeight);
+    for (int y = 50; y < 150; y++)
+        memset(pEdge + y * nWidth + 60, 255, 180);
+    for (int nMode = 0; nMode < 2; nMode++)
+    {
+        nFound[0] = ImgHoughLines(&In, 100, 60, 50, 3, nMode, Lines[0], 16);
+        Check(nFound[0] == 4 && IsLineFound(Lines[0], 4, 60, 50, 239, 50) + IsLineFound(Lines[0], 4, 60, 149, 239, 149) + IsLineFound(Lines[0], 4, 60, 50, 60, 149) +
+                                        IsLineFound(Lines[0], 4, 239, 50, 239, 149) == 4,
+              "rectangle", "hough_lines", szModes[nMode]);
+    }
+    free(pEdge);
+}
+
+/*
+ * @Function Name : TestWatershed
+ * @Description : 맞닿은 원을 그려 넣은 영상에서 ImgSplitObjects가 원마다 다른 번호를 붙이는지, ImgWatershed의 마커가 능선에서 만나는지 확인합니다.
+ * @Input : *szDir - 예제 영상 폴더, nThreads
+ */
+// 김광제의 설명 - 맞닿은 원 두 개는 ComponentLabeling으로는 한 덩어리라서 나눠지는지가 핵심이고, coins.bmp를 이진화하면 동전 22개가 나와야 한다.
+static void TestWatershed(const char *szDir, int nThreads)
+{
+    static const int nDisks[4][3] = {{60, 60, 40}, {130, 60, 40}, {250, 100, 30}, {100, 170, 45}}; // x, y, 반지름 (앞의 두 개는 맞닿음)
+    int nWidth = 320, nHeight = 240, nObjects, bOk, nMask = 0;
+    BYTE *pDisk = (BYTE *)calloc((size_t)nWidth * nHeight, 1);
+    int *pLabels[2];
+    IMAGE In, Big, Roi;
+    char szPath[512];
+    BYTE *pCoins;
+    int nCoinW, nCoinH, nCoinFormat;
+
+    pLabels[0] = (int *)malloc(sizeof(int) * nWidth * nHeight);
+    pLabels[1] = (int *)malloc(sizeof(int) * nWidth * nHeight);
+    for (int y = 0; y < nHeight; y++)
+        for (int x = 0; x < nWidth; x++)
+            for (int d = 0; d < 4; d++)
+            {
+                int dx = x - nDisks[d][0], dy = y - nDisks[d][1];
+
+                if (dx * dx + dy * dy <= nDisks[d][2] * nDisks[d][2])
+                    pDisk[y * nWidth + x] = 255;
+            }
+
+    // 1. 그려 넣은 원 (원마다 다른 번호, 전경은 모두 양수, 배경은 0)
+    WrapImage(&In, pDisk, nWidth, nHeight, PIXEL_GRAY8, 0);
+    SetThreads(nThreads);
+    nObjects = ImgSplitObjects(&In, pLabels[0], 2.0);
+    bOk = nObjects == 4;
+    for (int d = 0; d < 4 && bOk; d++)
+    {
+        int nLabel = pLabels[0][nDisks[d][1] * nWidth + nDisks[d][0]];
+
+        bOk = nLabel >= 1 && nLabel <= 4 && !(nMask & (1 << nLabel));
+        nMask |= 1 << nLabel;
+    }
+    for (int i = 0; i < nWidth * nHeight && bOk; i++)
+        bOk = (pDisk[i] == 255) ? (pLabels[0][i] > 0) : (pLabels[0][i] == 0);
+    Check(bOk, "disks", "split_objects", "touching");
+
+    // 2. ROI, 1 스레드 (레이블 비교)
+    CreateImage(&Big, nWidth + 13, nHeight + 7, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+    for (int i = 0; i < (nWidth + 13) * (nHeight + 7); i++)
+        Big.pBuffer[i] = RandomByte();
+    CreateROI(&Big, &Roi, 5, 3, nWidth, nHeight);
+    CopyImage(&In, &Roi);
+    Check(ImgSplitObjects(&Roi, pLabels[1], 2.0) == nObjects && memcmp(pLabels[0], pLabels[1], sizeof(int) * nWidth * nHeight) == 0, "disks",
+          "split_objects", "roi");
+    SetThreads(1);
+    Check(ImgSplitObjects(&In, pLabels[1], 2.0) == nObjects && memcmp(pLabels[0], pLabels[1], sizeof(int) * nWidth * nHeight) == 0, "disks",
+          "split_objects", "1 thread");
+    SetThreads(nThreads);
+    FreeImage(&Big);
+
+    // 3. 마커 두 개 (x = 32 능선에서 만남, 맨 윗줄 음수 픽셀은 그대로)
+    for (int y = 0; y < 32; y++)
+        for (int x = 0; x < 64; x++)
+        {
+            pDisk[y * 64 + x] = (BYTE)(4 * ((abs(x - 16) < abs(x - 48)) ? abs(x - 16) : abs(x - 48)));
+            pLabels[0][y * 64 + x] = (y == 0) ? -1 : 0;
+        }
+    pLabels[0][16 * 64 + 16] = 1;
+    pLabels[0][16 * 64 + 48] = 2;
+    WrapImage(&In, pDisk, 64, 32, PIXEL_GRAY8, 0);
+    bOk = ImgWatershed(&In, pLabels[0]) == 0;
+    for (int y = 0; y < 32 && bOk; y++)
+        for (int x = 0; x < 64 && bOk; x++)
+        {
+            int nLabel = pLabels[0][y * 64 + x];
+
+            bOk = (y == 0) ? (nLabel == -1) : (x < 32) ? (nLabel == 1) : (x > 32) ? (nLabel == 2) : (nLabel == 1 || nLabel == 2);
+        }
+    Check(bOk, "ridge", "watershed", "markers");
+
+    // 잘못된 인자
+    Check(ImgWatershed(&In, NULL) < 0 && ImgSplitObjects(&In, NULL, 2.0) < 0 && ImgSplitObjects(&In, pLabels[0], -1.0) < 0, "ridge", "watershed",
+          "invalid");
+    free(pDisk);
+    free(pLabels[0]);
+    free(pLabels[1]);
+
+    // 4. coins.bmp (임계값 60으로 이진화, 맞닿은 동전 포함 22개, 없으면 건너뜀)
+    snprintf(szPath, sizeof(szPath), "%s/coins.bmp", szDir);
+    pCoins = ReadImageFile(szPath, &nCoinW, &nCoinH, &nCoinFormat);
+    if (NULL == pCoins)
+        return;
+    pLabels[0] = (int *)malloc(sizeof(int) * nCoinW * nCoinH);
+    GenerateBinarization(pCoins, pCoins, nCoinW, nCoinH, 60);
+    WrapImage(&In, pCoins, nCoinW, nCoinH, nCoinFormat, 0);
+    Check(nCoinFormat == PIXEL_GRAY8 && ImgSplitObjects(&In, pLabels[0], 2.0) == 22, "coins.bmp", "split_objects", "count");
+    free(pLabels[0]);
+    PoolFree(GetThreadPool(), pCoins);
+}
+
+/*
+ * @Function Name : WriteAndRead
+ * @Description : 8비트 그레이 영상을 nFileFormat 형식으로 임시 파일에 저장하고 다시 읽습니다.
+ * @Input : *Image, nWidth, nHeight, nFileFormat
+ * @Output : *pFileSize - 파일 크기, 반환값 다시 읽은 픽셀 데이터 (PoolFree(GetThreadPool(), ...)로 반납, 실패하면 NULL)
+ */
+static BYTE *WriteAndRead(BYTE *Image, int nWidth, int nHeight, int nFileFormat, long *pFileSize)
+{
+    FILE *fp = tmpfile();
+    BITMAPFILEHEADER hf;
+    BITMAPINFOHEADER hInfo;
+    RGBQUAD hRGB[256];
+    BYTE *pImage = NULL;
+    int nFormat;
+
+    *pFileSize = 0;
+    if (NULL == fp)
+        return NULL;
+
+    memset(&hf, 0, sizeof(hf));
+    memset(&hInfo, 0, sizeof(hInfo));
+    hInfo.biSize = sizeof(BITMAPINFOHEADER);
+    hInfo.biWidth = nWidth;
+    hInfo.biHeight = nHeight;
+    hInfo.biPlanes = 1;
+    hInfo.biBitCount = 8;
+    for (int i = 0; i < 256; i++)
+    {
+        hRGB[i].rgbBlue = hRGB[i].rgbGreen = hRGB[i].rgbRed = (BYTE)i;
+        hRGB[i].rgbReserved = 0;
+    }
+
+    if (WriteImageFile(fp, &hf, &hInfo, hRGB, Image, PIXEL_GRAY8, nFileFormat) == 0)
+    {
+        *pFileSize = ftell(fp);
+        rewind(fp);
+        pImage = ReadBitmap(fp, &hf, &hInfo, hRGB, &nFormat);
+        // 읽은 헤더가 요청한 저장 방식인지 (압축 없는 8비트로 저장해도 픽셀은 같으므로)
+        if (pImage != NULL && (nFormat != PIXEL_GRAY8 || hInfo.biWidth != nWidth || hInfo.biHeight != nHeight ||
+                               hInfo.biBitCount != ((nFileFormat == FILE_BMP_1BIT) ? 1 : 8) ||
+                               hInfo.biCompression != (DWORD)((nFileFormat == FILE_BMP_RLE8) ? BMP_RLE8 : BMP_RGB)))
+        {
+            PoolFree(GetThreadPool(), pImage);
+            pImage = NULL;
+        }
+        // 다시 읽은 팔레트는 밝기값 그대로 (1비트도 0 ~ 255 그레이 팔레트로 바뀜)
+        for (int i = 0; pImage != NULL && i < 256; i++)
+            if (hRGB[i].rgbGreen != i)
+            {
+                PoolFree(GetThreadPool(), pImage);
+                pImage = NULL;
+            }
+    }
+
+    fclose(fp);
+    return pImage;
+}
+
+/*
+ * @Function Name : PngRoundTrip
+ * @Description : 영상을 PNG로 임시 파일에 저장하고 DecodePng로 다시 읽습니다.
+ * @Input : *Image - 패딩이 없는 픽셀 데이터, nWidth, nHeight, nFormat
+ * @Output : *pFormat - 다시 읽은 형식, *pFileSize - 파일 크기, 반환값 다시 읽은 픽셀 데이터 (PoolFree(GetThreadPool(), ...)로 반납, 실패하면 NULL)
+ */
+static BYTE *PngRoundTrip(const BYTE *Image, int nWidth, int nHeight, int nFormat, int *pFormat, long *pFileSize)
+{
+    FILE *fp = tmpfile();
+    BYTE *pImage = NULL;
+    int nOutWidth, nOutHeight;
+
+    *pFileSize = 0;
+    if (NULL == fp)
+        return NULL;
+    if (WritePng(fp, Image, nWidth, nHeight, nFormat) == 0)
+    {
+        *pFileSize = ftell(fp);
+        pImage = DecodePng(fp, &nOutWidth, &nOutHeight, pFormat);
+        if (pImage != NULL && (nOutWidth != nWidth || nOutHeight != nHeight))
+        {
+            PoolFree(GetThreadPool(), pImage);
+            pImage = NULL;
+        }
+    }
+    fclose(fp);
+    return pImage;
+}
+
+/*
+ * @Function Name : TestFileFormats
+ * @Description : RLE8, 1비트 BMP, PNG로 저장하고 다시 읽은 결과를 원본과 픽셀 단위로 비교합니다.
+ * @Input : *szImage, *Input - 8비트 영상, *pBinary - 이진화한 영상, nWidth, nHeight
+ */
+// 김광제의 설명 - 난수 영상은 RLE8의 압축하지 않은 구간, 이진 영상은 반복 구간, 길이가 1 ~ 300인 구간 영상은 짧은 구간과 255보다 긴 구간을 확인한다.
+// PNG는 DecodePng(따로 구현한 inflate, 필터 되돌리기)로 풀어서 비교하므로 필터 번호, 허프만 코드, Adler-32, CRC가 틀리면 실패
+// 16비트는 상위, 하위 바이트가 다르고 컬러는 R, B가 다른 값이라서 바이트 순서, 채널 순서가 바뀌면 실패
+static void TestFileFormats(const char *szImage, BYTE *Input, BYTE *pBinary, int nWidth, int nHeight)
+{
+    size_t nSize = (size_t)nWidth * nHeight;
+    BYTE *pLevels = (BYTE *)malloc(nSize), *pRuns = (BYTE *)malloc(nSize), *pInverse = (BYTE *)malloc(nSize);
+    BYTE *pWide = (BYTE *)malloc(nSize * 2), *pColor = (BYTE *)malloc(nSize * 4);
+    BYTE *pImages[5] = {Input, pBinary, pLevels, pRuns, pInverse}, *pRead;
+    const char *szTests[5] = {"gray", "binary", "levels", "runs", "binary_inverse"};
+    long nFileSize, nRleSize = 0;
+    int nReadFormat;
+    IMAGE Src, Dst;
+
+    if (NULL == pLevels || NULL == pRuns || NULL == pInverse || NULL == pWide || NULL == pColor)
+    {
+        Check(0, szImage, "file_format", "malloc");
+        free(pLevels);
+        free(pRuns);
+        free(pInverse);
+        free(pWide);
+        free(pColor);
+        return;
+    }
+
+    // 같은 값이 짧게 이어지는 영상 (4단계), 길이가 1, 2, ... 300인 구간이 이어지는 영상, 반전한 이진 영상
+    for (size_t i = 0; i < nSize; i++)
+        pLevels[i] = (BYTE)(Input[i] & 0xC0);
+    for (size_t i = 0, nRun = 1, nValue = 0; i < nSize; nRun = nRun % 300 + 1, nValue++)
+        for (size_t k = 0; k < nRun && i < nSize; k++)
+            pRuns[i++] = (BYTE)(nValue * 37);
+    for (size_t i = 0; i < nSize; i++)
+        pInverse[i] = (BYTE)(255 - pBinary[i]);
+
+    for (int k = 0; k < 5; k++)
+    {
+        int bBinary = 1;
+
+        WrapImage(&Src, pImages[k], nWidth, nHeight, PIXEL_GRAY8, 0);
+
+        pRead = WriteAndRead(pImages[k], nWidth, nHeight, FILE_BMP_RLE8, &nFileSize);
+        if (pRead != NULL)
+            WrapImage(&Dst, pRead, nWidth, nHeight, PIXEL_GRAY8, 0);
+        Check(pRead != NULL && IsSameImage(&Src, &Dst), szImage, "rle8", szTests[k]);
+        PoolFree(GetThreadPool(), pRead);
+        if (k == 1)
+            nRleSize = nFileSize;
+
+        // 1비트는 0, 255만 있는 영상만 저장됨
+        for (size_t i = 0; i < nSize; i++)
+            bBinary &= (pImages[k][i] == 0 || pImages[k][i] == 255);
+        pRead = WriteAndRead(pImages[k], nWidth, nHeight, FILE_BMP_1BIT, &nFileSize);
+        if (pRead != NULL)
+            WrapImage(&Dst, pRead, nWidth, nHeight, PIXEL_GRAY8, 0);
+        Check((bBinary) ? (pRead != NULL && IsSameImage(&Src, &Dst)) : (NULL == pRead), szImage, "bmp1", szTests[k]);
+        PoolFree(GetThreadPool(), pRead);
+
+        pRead = PngRoundTrip(pImages[k], nWidth, nHeight, PIXEL_GRAY8, &nReadFormat, &nFileSize);
+        if (pRead != NULL)
+            WrapImage(&Dst, pRead, nWidth, nHeight, PIXEL_GRAY8, 0);
+        // 이진 영상은 LZ77이 행 단위 반복을 찾으므로 RLE8보다 작아야 함
+        Check(pRead != NULL && nReadFormat == PIXEL_GRAY8 && IsSameImage(&Src, &Dst) && (k != 1 || nSize < 4096 || nFileSize < nRleSize),
+              szImage, "png", szTests[k]);
+        PoolFree(GetThreadPool(), pRead);
+    }
+
+    // PNG 16비트 그레이 (하위 바이트는 상위 바이트와 다른 값)
+    for (size_t i = 0; i < nSize; i++)
+        ((WORD *)pWide)[i] = (WORD)(Input[i] << 8 | (BYTE)(Input[i] * 37 + i));
+    WrapImage(&Src, pWide, nWidth, nHeight, PIXEL_GRAY16, 0);
+    pRead = PngRoundTrip(pWide, nWidth, nHeight, PIXEL_GRAY16, &nReadFormat, &nFileSize);
+    if (pRead != NULL)
+        WrapImage(&Dst, pRead, nWidth, nHeight, PIXEL_GRAY16, 0);
+    Check(pRead != NULL && nReadFormat == PIXEL_GRAY16 && IsSameImage(&Src, &Dst), szImage, "png", "gray16");
+    PoolFree(GetThreadPool(), pRead);
+
+    // PNG 24비트 컬러 (B, G, R이 모두 다른 값)
+    for (size_t i = 0; i < nSize; i++)
+    {
+        pColor[i * 3] = Input[i];
+        pColor[i * 3 + 1] = (BYTE)(Input[i] ^ 0x55);
+        pColor[i * 3 + 2] = (BYTE)(255 - Input[i]);
+    }
+    WrapImage(&Src, pColor, nWidth, nHeight, PIXEL_BGR24, 0);
+    pRead = PngRoundTrip(pColor, nWidth, nHeight, PIXEL_BGR24, &nReadFormat, &nFileSize);
+    if (pRead != NULL)
+        WrapImage(&Dst, pRead, nWidth, nHeight, PIXEL_BGR24, 0);
+    Check(pRead != NULL && nReadFormat == PIXEL_BGR24 && IsSameImage(&Src, &Dst), szImage, "png", "bgr24");
+    PoolFree(GetThreadPool(), pRead);
+
+    // PNG 32비트 컬러 (알파가 있으면 RGBA, 알파가 모두 0이면 RGB로 저장됨)
+    for (int bAlpha = 1; bAlpha >= 0; bAlpha--)
+    {
+        int bOk;
+
+        for (size_t i = 0; i < nSize; i++)
+        {
+            pColor[i * 4] = Input[i];
+            pColor[i * 4 + 1] = (BYTE)(Input[i] ^ 0x55);
+            pColor[i * 4 + 2] = (BYTE)(255 - Input[i]);
+            pColor[i * 4 + 3] = (BYTE)((bAlpha) ? (Input[i] + i) | 1 : 0);
+        }
+        pRead = PngRoundTrip(pColor, nWidth, nHeight, PIXEL_BGRA32, &nReadFormat, &nFileSize);
+        bOk = (pRead != NULL && nReadFormat == ((bAlpha) ? PIXEL_BGRA32 : PIXEL_BGR24));
+        for (size_t i = 0; bOk && i < nSize; i++)
+            bOk = (memcmp(pRead + i * ((bAlpha) ? 4 : 3), pColor + i * 4, (bAlpha) ? 4 : 3) == 0);
+        Check(bOk, szImage, "png", (bAlpha) ? "bgra32" : "bgra32_no_alpha");
+        PoolFree(GetThreadPool(), pRead);
+    }
+
+    free(pLevels);
+    free(pRuns);
+    free(pInverse);
+    free(pWide);
+    free(pColor);
+}
+
+/*
+ * @Function Name : TestDistance
+ * @Description : 거리 변환을 직접 계산한 값과 비교하고, 반지름 단위 침식/팽창을 Erosion, Dilation을 반복한 결과와 비교합니다.
+ * @Input : *szImage, *pBinary - 이진 영상, nWidth, nHeight
+ */
+// 김광제의 설명 - 직접 계산은 픽셀마다 영상 전체를 보므로 큰 영상은 일부 픽셀만 비교한다.
+// Erosion, Dilation은 가장자리 1픽셀을 처리하지 않으므로 가장자리 N + 1픽셀을 배경으로 만든 영상에서 안쪽만 비교
+static void TestDistance(const char *szImage, BYTE *pBinary, int nWidth, int nHeight)
+{
+    static const char *szMetrics[4] = {"euclidean", "cityblock", "chessboard", "chamfer_3_4"};
+    size_t nSize = (size_t)nWidth * nHeight;
+    int nRadius = 3, nFrame = nRadius + 1;
+    float *pDist = (float *)malloc(nSize * sizeof(float));
+    BYTE *pFramed = (BYTE *)malloc(nSize);
+    IMAGE In, Out, Iter[2];
+    OP_PARAM Param;
+
+    WrapImage(&In, pBinary, nWidth, nHeight, PIXEL_GRAY8, 0);
+
+    // 1. 거리 변환 (모든 배경 픽셀까지의 거리 중 최소, 큰 영상은 256개 픽셀만 비교)
+    for (int m = 0; m < 4; m++)
+    {
+        int bOk = ImgDistanceTransform(&In, pDist, m) == 0;
+        size_t nStep = (nSize > 4096) ? nSize / 256 : 1;
+
+        for (size_t i = 0; i < nSize && bOk; i += nStep)
+        {
+            int x = (int)(i % nWidth), y = (int)(i / nWidth);
+            double dMin = FLT_MAX;
+
+            for (int v = 0; v < nHeight; v++)
+                for (int u = 0; u < nWidth; u++)
+                {
+                    int dx = abs(x - u), dy = abs(y - v);
+                    int nMin = (dx < dy) ? dx : dy, nMax = (dx < dy) ? dy : dx;
+                    double d;
+
+                    if (pBinary[v * nWidth + u] == 255)
+                        continue;
+                    if (m == DIST_EUCLIDEAN)
+                        d = sqrt((double)(dx * dx + dy * dy));
+                    else if (m == DIST_CITYBLOCK)
+                        d = dx + dy;
+                    else if (m == DIST_CHESSBOARD)
+                        d = nMax;
+                    else
+                        d = (4 * nMin + 3 * (nMax - nMin)) / 3.0;
+                    if (d < dMin)
+                        dMin = d;
+                }
+
+            bOk = (dMin == FLT_MAX) ? pDist[i] == FLT_MAX : fabs(pDist[i] - dMin) < 1e-3;
+        }
+        Check(bOk, szImage, "distance", szMetrics[m]);
+    }
+
+    // 2. 반지름 단위 침식/팽창 = 시가지 거리로 Erosion, Dilation을 nRadius번 반복
+    if (nWidth > 2 * nFrame && nHeight > 2 * nFrame)
+    {
+        for (int y = 0; y < nHeight; y++)
+            for (int x = 0; x < nWidth; x++)
+            {
+                int bEdge = x < nFrame || y < nFrame || x >= nWidth - nFrame || y >= nHeight - nFrame;
+                pFramed[y * nWidth + x] = bEdge ? 0 : pBinary[y * nWidth + x];
+            }
+        WrapImage(&In, pFramed, nWidth, nHeight, PIXEL_GRAY8, 0);
+
+        for (int bDilation = 0; bDilation < 2; bDilation++)
+        {
+            int bOk;
+
+            CreateImage(&Out, nWidth, nHeight, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+            CreateImage(&Iter[0], nWidth, nHeight, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+            CreateImage(&Iter[1], nWidth, nHeight, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+            CopyImage(&In, &Iter[0]);
+            CopyImage(&In, &Iter[1]);
+            for (int k = 0; k < nRadius; k++)
+                bDilation ? ImgDilation(&Iter[k & 1], &Iter[(k + 1) & 1]) : ImgErosion(&Iter[k & 1], &Iter[(k + 1) & 1]);
+
+            memset(&Param, 0, sizeof(OP_PARAM));
+            Param.dRadius = nRadius;
+            Param.nMetric = DIST_CITYBLOCK;
+            bOk = RunOperation(&Context, bDilation ? OP_DILATION_RADIUS : OP_EROSION_RADIUS, &In, &Out, &Param) == 0;
+            for (int y = nFrame; y < nHeight - nFrame && bOk; y++)
+                bOk = memcmp(Out.pPlane[0] + (size_t)y * Out.nStride + nFrame, Iter[nRadius & 1].pPlane[0] + (size_t)y * Iter[nRadius & 1].nStride + nFrame,
+                             nWidth - 2 * nFrame) == 0;
+            Check(bOk, szImage, bDilation ? "dilation_radius" : "erosion_radius", "cityblock");
+
+            // 반지름 0은 입력과 같음
+            Param.dRadius = 0.0;
+            Param.nMetric = DIST_EUCLIDEAN;
+            Check(RunOperation(&Context, bDilation ? OP_DILATION_RADIUS : OP_EROSION_RADIUS, &In, &Out, &Param) == 0 && IsSameImage(&In, &Out),
+                  szImage, bDilation ? "dilation_radius" : "erosion_radius", "radius_0");
+
+            FreeImage(&Iter[0]);
+            FreeImage(&Iter[1]);
+            FreeImage(&Out);
+        }
+
+        // 유클리드 원은 체스판 정사각형 안, 시가지 마름모 밖 (침식 결과 : 체스판 <= 유클리드 <= 시가지)
+        {
+            IMAGE Euclid, Chess, City;
+            int bOk = 1;
+
+            CreateImage(&Euclid, nWidth, nHeight, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+            CreateImage(&Chess, nWidth, nHeight, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+            CreateImage(&City, nWidth, nHeight, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+            ImgErosionRadius(&In, &Euclid, 2.5, DIST_EUCLIDEAN);
+            ImgErosionRadius(&In, &Chess, 2.5, DIST_CHESSBOARD);
+            ImgErosionRadius(&In, &City, 2.5, DIST_CITYBLOCK);
+            for (size_t i = 0; i < nSize; i++)
+                bOk &= Chess.pPlane[0][i] <= Euclid.pPlane[0][i] && Euclid.pPlane[0][i] <= City.pPlane[0][i];
+            Check(bOk, szImage, "erosion_radius", "metric_order");
+            FreeImage(&Euclid);
+            FreeImage(&Chess);
+            FreeImage(&City);
+        }
+    }
+
+    // 잘못된 인자
+    WrapImage(&In, pBinary, nWidth, nHeight, PIXEL_GRAY8, 0);
+    CreateImage(&Out, nWidth, nHeight, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+    Check(ImgErosionRadius(&In, &Out, -1.0, DIST_EUCLIDEAN) != 0 && ImgDilationRadius(&In, &Out, 1.0, 9) != 0, szImage, "distance", "invalid");
+    FreeImage(&Out);
+
+    free(pDist);
+    free(pFramed);
+}
+
+/*
+ * @Function Name : TestGray
+ * @Description : 8비트 영상에서 기존 함수와 IMAGE 함수(연속 버퍼, ROI, 여러 스레드)를 비교합니다.
+ * @Input : *szImage, *Input, nWidth, nHeight, nThreads
+ */
+// 김광제의 설명 - ROI는 난수로 채운 더 큰 영상 안에 만들어서 ROI 밖을 읽거나 쓰지 않는지도 같이 확인한다.
+static void TestGray(const char *szImage, BYTE *Input, int nWidth, int nHeight, int nThreads)
+{
+    size_t nSize = (size_t)nWidth * nHeight;
+    int nBigW = nWidth + 13, nBigH = nHeight + 7, nX = 5, nY = 3;
+    BYTE *pRef = (BYTE *)malloc(nSize), *pFast = (BYTE *)malloc(nSize);
+    IMAGE In, Out, BigIn, BigOut, RoiIn, RoiOut, Gray16, Ref16, Out16;
+    OP_PARAM Param;
+    BYTE bThreshold;
+    int nHisto[256] = {
+        0,
+    };
+    int nImgHisto[256] = {
+        0,
+    };
+
+    WrapImage(&In, Input, nWidth, nHeight, PIXEL_GRAY8, 0);
+    WrapImage(&Out, pFast, nWidth, nHeight, PIXEL_GRAY8, 0);
+    CreateImage(&BigIn, nBigW, nBigH, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+    CreateImage(&BigOut, nBigW, nBigH, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+    CreateROI(&BigIn, &RoiIn, nX, nY, nWidth, nHeight);
+    CreateROI(&BigOut, &RoiOut, nX, nY, nWidth, nHeight);
+
+    for (int i = 0; i < nBigW * nBigH; i++)
+        BigIn.pBuffer[i] = RandomByte();
+    CopyImage(&In, &RoiIn);
+
+    for (int nOp = 0; nOp < GOLDEN_OP_COUNT; nOp++)
+    {
+        int bOutside = 1;
+
+        memset(pRef, 0xA5, nSize);
+        RunLegacy(nOp, Input, pRef, nWidth, nHeight);
+
+        // 1. 연속 버퍼
+        memset(pFast, 0xA5, nSize);
+        RunFast(nOp, &In, &Out, nThreads);
+        Check(memcmp(pRef, pFast, nSize) == 0, szImage, "gray8", GoldenOpNames[nOp]);
+
+        // 2. ROI (행 간격이 너비보다 큼)
+        memset(BigOut.pBuffer, 0xA5, (size_t)nBigW * nBigH);
+        RunFast(nOp, &RoiIn, &RoiOut, nThreads);
+        WrapImage(&In, pRef, nWidth, nHeight, PIXEL_GRAY8, 0);
+        Check(IsSameImage(&In, &RoiOut), szImage, "gray8 roi", GoldenOpNames[nOp]);
+        WrapImage(&In, Input, nWidth, nHeight, PIXEL_GRAY8, 0);
+
+        for (int i = 0; i < nBigH; i++)
+            for (int j = 0; j < nBigW; j++)
+                if ((i < nY || i >= nY + nHeight || j < nX || j >= nX + nWidth) && BigOut.pBuffer[(size_t)i * nBigW + j] != 0xA5)
+                    bOutside = 0;
+        Check(bOutside, szImage, "gray8 roi outside", GoldenOpNames[nOp]);
+
+        // 3. 처리 컨텍스트 (RunOperation은 가장자리를 쓰지 않는 기능의 출력을 0으로 채운 뒤 처리)
+        memset(pRef, 0, nSize);
+        RunLegacy(nOp, Input, pRef, nWidth, nHeight);
+        memset(pFast, 0xA5, nSize);
+        Check(RunOperation(&Context, GetContextOp(nOp, &Param), &In, &Out, &Param) == 0 && memcmp(pRef, pFast, nSize) == 0,
+              szImage, "gray8 context", GoldenOpNames[nOp]);
+    }
+
+    // 자동 이진화 (오츠) : 구한 임계값과 결과
+    memset(&Param, 0, sizeof(OP_PARAM));
+    Param.nMethod = THRESHOLD_OTSU;
+    bThreshold = GenerateAutoBinarization(Input, pRef, nWidth, nHeight, THRESHOLD_OTSU);
+    WrapImage(&Out, pRef, nWidth, nHeight, PIXEL_GRAY8, 0);
+    Check(RunOperation(&Context, OP_AUTO_BINARIZATION, &RoiIn, &RoiOut, &Param) == 0 && Param.nThreshold == bThreshold && IsSameImage(&Out, &RoiOut),
+          szImage, "gray8 context", "auto_binarization");
+
+    // 16비트 고정 커널 : 정수 커널(ImgConvolution)과 double 커널(ImgConvolutionKernel) 비교
+    CreateImage(&Gray16, nWidth, nHeight, PIXEL_GRAY16, LAYOUT_INTERLEAVED);
+    CreateImage(&Ref16, nWidth, nHeight, PIXEL_GRAY16, LAYOUT_INTERLEAVED);
+    CreateImage(&Out16, nWidth, nHeight, PIXEL_GRAY16, LAYOUT_INTERLEAVED);
+    for (int i = 0; i < nHeight; i++)
+        for (int j = 0; j < nWidth; j++)
+            ((WORD *)(Gray16.pPlane[0] + (size_t)i * Gray16.nStride))[j] = (WORD)(Input[(size_t)i * nWidth + j] * 256 + RandomByte());
+    for (int k = KERNEL_AVERAGE; k <= KERNEL_HPF_LAPLACIAN; k++)
+    {
+        memset(Ref16.pBuffer, 0, (size_t)Ref16.nStride * nHeight);
+        memset(Out16.pBuffer, 0, (size_t)Out16.nStride * nHeight);
+        ImgConvolutionKernel(&Gray16, &Ref16, ConvolutionTable[k].Kernel, ConvolutionTable[k].nPost, ConvolutionTable[k].nDivisor);
+        Check(ImgConvolution(&Gray16, &Out16, k) == 0 && IsSameImage(&Ref16, &Out16), szImage, "gray16 fixed kernel", GoldenOpNames[GOLDEN_CONVOLUTION + k]);
+    }
+    FreeImage(&Gray16);
+    FreeImage(&Ref16);
+    FreeImage(&Out16);
+
+    // 히스토그램
+    GenerateHistogram(Input, nHisto, nWidth, nHeight);
+    ImgHistogram(&RoiIn, nImgHisto);
+    Check(memcmp(nHisto, nImgHisto, sizeof(nHisto)) == 0, szImage, "gray8 roi", "histogram");
+
+    // CLAHE : 1 스레드 연속 버퍼 결과와 여러 스레드 ROI 결과 비교
+    SetThreads(1);
+    CLAHE(Input, pRef, nWidth, nHeight, 4, 3, 2.0);
+    SetThreads(nThreads);
+    ImgCLAHE(&RoiIn, &RoiOut, 4, 3, 2.0);
+    WrapImage(&Out, pRef, nWidth, nHeight, PIXEL_GRAY8, 0);
+    Check(IsSameImage(&Out, &RoiOut), szImage, "gray8 roi", "clahe");
+
+    // Component Labeling (Gray Gap) : 연속 버퍼 결과와 ROI 결과 비교
+    for (size_t i = 0; i < nSize; i++)
+        pRef[i] = (Input[i] >= 128) ? 255 : 0;
+    WrapImage(&Out, pRef, nWidth, nHeight, PIXEL_GRAY8, 0);
+    CopyImage(&Out, &RoiIn);
+    ComponentLabeling(pRef, nHeight, nWidth, 3);
+    ImgComponentLabeling(&RoiIn, 3);
+    Check(IsSameImage(&Out, &RoiIn), szImage, "gray8 roi", "component_labeling");
+
+    FreeImage(&BigIn);
+    FreeImage(&BigOut);
+    free(pRef);
+    free(pFast);
+}
+
+/*
+ * @Function Name : TestColor
+ * @Description : 24/32비트 컬러 영상(Interleaved, Planar)의 채널별 결과를 기존 8비트 함수 결과와 비교합니다.
+ * @Input : *szImage, *Input (채널 0), nWidth, nHeight, nFormat, nThreads
+ */
+// 김광제의 설명 - 채널 0은 입력 영상, 나머지 채널은 반전, 난수로 만들어서 채널끼리 섞이면 바로 드러나도록 한다.
+static void TestColor(const char *szImage, BYTE *Input, int nWidth, int nHeight, int nFormat, int nThreads)
+{
+    size_t nSize = (size_t)nWidth * nHeight;
+    IMAGE Color, ColorOut, Planar, PlanarOut, Plane;
+    BYTE *pChannel = (BYTE *)malloc(nSize), *pRef = (BYTE *)malloc(nSize);
+    int nChannels = GetBytesPerPixel(nFormat);
+    char szTest[32];
+
+    CreateImage(&Color, nWidth, nHeight, nFormat, LAYOUT_INTERLEAVED);
+    CreateImage(&ColorOut, nWidth, nHeight, nFormat, LAYOUT_INTERLEAVED);
+    CreateImage(&Planar, nWidth, nHeight, nFormat, LAYOUT_PLANAR);
+    CreateImage(&PlanarOut, nWidth, nHeight, nFormat, LAYOUT_PLANAR);
+
+    for (size_t i = 0; i < nSize; i++)
+    {
+        Color.pBuffer[i * nChannels] = Input[i];
+        Color.pBuffer[i * nChannels + 1] = (BYTE)(255 - Input[i]);
+        Color.pBuffer[i * nChannels + 2] = RandomByte();
+        if (nChannels == 4)
+            Color.pBuffer[i * nChannels + 3] = RandomByte();
+    }
+    ConvertLayout(&Color, &Planar);
+
+    for (int nOp = 0; nOp < GOLDEN_OP_COUNT; nOp++)
+    {
+        if (!GOLDEN_IS_COLOR_OP(nOp))
+            continue;
+
+        // 컨볼루션, 미디언은 가장자리를 쓰지 않으므로 기준 결과와 같은 값으로 채워둠
+        memset(ColorOut.pBuffer, 0xA5, nSize * nChannels);
+        for (int c = 0; c < nChannels; c++)
+            memset(PlanarOut.pPlane[c], 0xA5, nSize);
+        RunFast(nOp, &Color, &ColorOut, nThreads);
+        RunFast(nOp, &Planar, &PlanarOut, nThreads);
+
+        for (int c = 0; c < nChannels; c++)
+        {
+            GetPlaneView(&Planar, c, &Plane);
+            for (size_t i = 0; i < nSize; i++)
+                pChannel[i] = Plane.pPlane[0][i];
+
+            // 알파는 점 연산에서는 그대로 복사
+            memset(pRef, 0xA5, nSize);
+            if (c == 3 && !GOLDEN_IS_GEOMETRIC(nOp))
+                memcpy(pRef, pChannel, nSize);
+            else
+                RunLegacy(nOp, pChannel, pRef, nWidth, nHeight);
+
+            snprintf(szTest, sizeof(szTest), "%s ch%d", (nChannels == 3) ? "bgr24" : "bgra32", c);
+            {
+                int bOk = 1;
+                // Interleaved 알파는 처리한 픽셀에서만 복사되므로 컨볼루션, 미디언의 가장자리(nMargin)는 비교하지 않음
+                int nMargin = (c == 3 && nOp >= GOLDEN_CONVOLUTION && nOp <= GOLDEN_MEDIAN_5) ? ((nOp == GOLDEN_MEDIAN_5) ? 2 : 1) : 0;
+
+                for (int i = nMargin; i < nHeight - nMargin && bOk; i++)
+                    for (int j = nMargin; j < nWidth - nMargin && bOk; j++)
+                        bOk = (ColorOut.pBuffer[((size_t)i * nWidth + j) * nChannels + c] == pRef[(size_t)i * nWidth + j]);
+                Check(bOk, szImage, szTest, GoldenOpNames[nOp]);
+            }
+
+            snprintf(szTest, sizeof(szTest), "%s planar ch%d", (nChannels == 3) ? "bgr24" : "bgra32", c);
+            GetPlaneView(&PlanarOut, c, &Plane);
+            Check(memcmp(Plane.pPlane[0], pRef, nSize) == 0, szImage, szTest, GoldenOpNames[nOp]);
+        }
+    }
+
+    FreeImage(&Color);
+    FreeImage(&ColorOut);
+    FreeImage(&Planar);
+    FreeImage(&PlanarOut);
+    free(pChannel);
+    free(pRef);
+}
+
+/*
+ * @Function Name : IsContourEdge
+ * @Description : 윤곽선 점이 모두 전경이고 이웃한 점끼리 8연결로 이어지는지, 점을 모두 모으면 4방향 경계 픽셀(ImgDetectObjectEdge)과 같은지 검사합니다.
+ * @Input : *pBinary - 이진 영상 (전경 255), nWidth, nHeight, *pSet - ImgFindContours 결과
+ */
+static int IsContourEdge(const BYTE *pBinary, int nWidth, int nHeight, const CONTOUR_SET *pSet)
+{
+    size_t nSize = (size_t)nWidth * nHeight;
+    BYTE *pInverse = (BYTE *)malloc(nSize), *pEdge = (BYTE *)malloc(nSize), *pMark = (BYTE *)calloc(nSize, 1);
+    IMAGE In, Out;
+    int bOk = 1;
+
+    // ImgDetectObjectEdge의 전경은 0
+    for (size_t i = 0; i < nSize; i++)
+        pInverse[i] = (pBinary[i] == 255) ? 0 : 255;
+    WrapImage(&In, pInverse, nWidth, nHeight, PIXEL_GRAY8, 0);
+    WrapImage(&Out, pEdge, nWidth, nHeight, PIXEL_GRAY8, 0);
+    ImgDetectObjectEdge(&In, &Out);
+
+    for (int c = 0; c < pSet->nContours && bOk; c++)
+    {
+        const CONTOUR *pContour = &pSet->pContours[c];
+
+        for (int k = 0; k < pContour->nCount && bOk; k++)
+        {
+            const CONTOUR_POINT *a = &pSet->pPoints[pContour->nFirst + k], *b = &pSet->pPoints[pContour->nFirst + (k + 1) % pContour->nCount];
+
+            bOk = a->x >= 0 && a->y >= 0 && a->x < nWidth && a->y < nHeight && pBinary[(size_t)a->y * nWidth + a->x] == 255 && abs(a->x - b->x) <= 1 &&
+                  abs(a->y - b->y) <= 1;
+            if (bOk)
+                pMark[(size_t)a->y * nWidth + a->x] = 1;
+        }
+    }
+    for (size_t i = 0; i < nSize && bOk; i++)
+        bOk = (pEdge[i] == 0) == (pMark[i] == 1);
+
+    free(pInverse);
+    free(pEdge);
+    free(pMark);
+    return bOk;
+}
+
+/*
+ * @Function Name : TestContours
+ * @Description : 윤곽선 점이 경계 픽셀과 같은지, ROI에서도 같은 윤곽선이 나오는지, Douglas-Peucker가 원래 점 중 일부만 남기는지 확인합니다.
+ * @Input : *szImage, *pBinary - 이진 영상, nWidth, nHeight
+ */
+static void TestContours(const char *szImage, BYTE *pBinary, int nWidth, int nHeight)
+{
+    CONTOUR_SET Set, RoiSet;
+    IMAGE In, Big, Roi;
+    int nContours, bOk;
+
+    ContourInit(&Set);
+    ContourInit(&RoiSet);
+    WrapImage(&In, pBinary, nWidth, nHeight, PIXEL_GRAY8, 0);
+    nContours = ImgFindContours(&In, &Set);
+    Check(nContours >= 0 && IsContourEdge(pBinary, nWidth, nHeight, &Set), szImage, "find_contours", "edge");
+
+    // ROI (점, 계층이 같아야 함)
+    CreateImage(&Big, nWidth + 5, nHeight + 3, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+    for (int i = 0; i < (nWidth + 5) * (nHeight + 3); i++)
+        Big.pBuffer[i] = (RandomByte() & 1) ? 255 : 0;
+    CreateROI(&Big, &Roi, 2, 1, nWidth, nHeight);
+    CopyImage(&In, &Roi);
+    Check(ImgFindContours(&Roi, &RoiSet) == nContours && RoiSet.nPoints == Set.nPoints &&
+              memcmp(RoiSet.pContours, Set.pContours, sizeof(CONTOUR) * nContours) == 0 &&
+              memcmp(RoiSet.pPoints, Set.pPoints, sizeof(CONTOUR_POINT) * Set.nPoints) == 0,
+          szImage, "find_contours", "roi");
+    FreeImage(&Big);
+
+    // Douglas-Peucker (윤곽선 수는 그대로, 첫 점은 남고 남은 점은 원래 순서대로 원래 점 중 일부)
+    bOk = SimplifyContours(&RoiSet, 1.0) == 0 && RoiSet.nContours == nContours && RoiSet.nPoints <= Set.nPoints;
+    for (int c = 0; c < nContours && bOk; c++)
+    {
+        const CONTOUR *pOld = &Set.pContours[c], *pNew = &RoiSet.pContours[c];
+        int k = 0;
+
+        bOk = pNew->nCount >= 1 && pNew->nCount <= pOld->nCount &&
+              memcmp(&RoiSet.pPoints[pNew->nFirst], &Set.pPoints[pOld->nFirst], sizeof(CONTOUR_POINT)) == 0;
+        for (int j = 0; j < pNew->nCount && bOk; j++)
+        {
+            while (k < pOld->nCount && memcmp(&Set.pPoints[pOld->nFirst + k], &RoiSet.pPoints[pNew->nFirst + j], sizeof(CONTOUR_POINT)) != 0)
+                k++;
+            bOk = k < pOld->nCount;
+        }
+    }
+    Check(bOk, szImage, "simplify_contours", "subset");
+
+    ContourRelease(&Set);
+    ContourRelease(&RoiSet);
+}
+
+/*
+ * @Function Name : TestContourShapes
+ * @Description : 구멍이 있는 사각형과 구멍 안의 점으로 윤곽선 계층을 확인하고, 사각형을 Douglas-Peucker로 줄이면 꼭짓점 4개만 남는지 확인합니다.
+ */
+// 김광제의 설명 - 사각형 바깥 경계 (-1) > 구멍 (사각형) > 구멍 안의 점 (구멍) 순서로 부모가 이어져야 한다.
+static void TestContourShapes(void)
+{
+    static const int nCorners[4][2] = {{10, 10}, {49, 10}, {49, 39}, {10, 39}};
+    int nWidth = 64, nHeight = 48, nOuter = -1, nHole = -1, nDot = -1, bOk;
+    BYTE *pShape = (BYTE *)calloc((size_t)nWidth * nHeight, 1);
+    CONTOUR_SET Set;
+    IMAGE In;
+
+    for (int y = 10; y < 40; y++)
+        for (int x = 10; x < 50; x++)
+            pShape[y * nWidth + x] = (x >= 20 && x < 40 && y >= 15 && y < 35) ? 0 : 255;
+    pShape[25 * nWidth + 30] = 255;
+    pShape[0] = 255; // 영상 모서리에 닿은 점
+
+    ContourInit(&Set);
+    WrapImage(&In, pShape, nWidth, nHeight, PIXEL_GRAY8, 0);
+    bOk = ImgFindContours(&In, &Set) == 4;
+    for (int c = 0; c < Set.nContours && bOk; c++)
+    {
+        const CONTOUR *pContour = &Set.pContours[c];
+        const CONTOUR_POINT *pFirst = &Set.pPoints[pContour->nFirst];
+
+        if (!pContour->bHole && pFirst->x == 10 && pFirst->y == 10)
+            nOuter = c;
+        else if (pContour->bHole)
+            nHole = c;
+        else if (pFirst->x == 30 && pFirst->y == 25)
+            nDot = c;
+    }
+    bOk = bOk && nOuter >= 0 && nHole >= 0 && nDot >= 0 && Set.pContours[nOuter].nParent == -1 && Set.pContours[nOuter].nCount == 2 * 39 + 2 * 29 &&
+          Set.pContours[nHole].nParent == nOuter && Set.pContours[nDot].nParent == nHole && Set.pContours[nDot].nCount == 1;
+    Check(bOk && IsContourEdge(pShape, nWidth, nHeight, &Set), "shapes", "find_contours", "hierarchy");
+
+    bOk = SimplifyContours(&Set, 0.5) == 0 && Set.pContours[nOuter].nCount == 4;
+    for (int k = 0; k < 4 && bOk; k++)
+    {
+        const CONTOUR_POINT *p = &Set.pPoints[Set.pContours[nOuter].nFirst + k];
+        int bCorner = 0;
+
+        for (int j = 0; j < 4; j++)
+            bCorner |= p->x == nCorners[j][0] && p->y == nCorners[j][1];
+        bOk = bCorner;
+    }
+    Check(bOk, "shapes", "simplify_contours", "rectangle");
+    Check(SimplifyContours(&Set, 0.0) < 0 && ImgFindContours(&In, NULL) < 0, "shapes", "find_contours", "invalid");
+
+    ContourRelease(&Set);
+    free(pShape);
+}
+
+/*
+ * @Function Name : RefFill
+ * @Description : 픽셀마다 큐에 넣는 너비 우선 탐색으로 (x, y)와 이어진 nLo ~ nHi 밝기 픽셀을 표시합니다. (영역 채우기 기준 구현)
+ * @Input : *pImage, nWidth, nHeight, x, y, nLo, nHi, nConnectivity - 4 또는 8, *pMark - 이미 표시한 픽셀은 다시 채우지 않음
+ * @Output : *pMark - 채운 픽셀 1, 반환값 채운 픽셀 수
+ */
+static int RefFill(const BYTE *pImage, int nWidth, int nHeight, int x, int y, int nLo, int nHi, int nConnectivity, BYTE *pMark)
+{
+    int *pQueue = (int *)malloc(sizeof(int) * nWidth * nHeight), nHead = 0, nTail = 0;
+
+    if (pImage[y * nWidth + x] < nLo || pImage[y * nWidth + x] > nHi || pMark[y * nWidth + x])
+    {
+        free(pQueue);
+        return 0;
+    }
+    pMark[y * nWidth + x] = 1;
+    pQueue[nTail++] = y * nWidth + x;
+    while (nHead < nTail)
+    {
+        int p = pQueue[nHead++], px = p % nWidth, py = p / nWidth;
+
+        for (int dy = -1; dy <= 1; dy++)
+            for (int dx = -1; dx <= 1; dx++)
+            {
+                int nx = px + dx, ny = py + dy, q = ny * nWidth + nx;
+
+                if ((dx == 0 && dy == 0) || (nConnectivity == 4 && dx != 0 && dy != 0) || nx < 0 || ny < 0 || nx >= nWidth || ny >= nHeight)
+                    continue;
+                if (pImage[q] >= nLo && pImage[q] <= nHi && !pMark[q])
+                {
+                    pMark[q] = 1;
+                    pQueue[nTail++] = q;
+                }
+            }
+    }
+    free(pQueue);
+    return nTail;
+}
+
+/*
+ * @Function Name : TestFill
+ * @Description : ImgFloodFill(4/8연결, 채울 값이 밝기 범위 안/밖)과 ImgFillHoles(ROI, 제자리, RunOperation)를 너비 우선 탐색 결과와 비교합니다.
+ * @Input : *szImage, *Input - 8비트 그레이 영상, *pBinary - 이진 영상, nWidth, nHeight
+ */
+// 김광제의 설명 - 구멍 채우기 기준 = 영상 둘레의 배경에서 4연결로 닿지 않는 배경을 255로 바꾼 것이고, 채운 뒤에는 구멍 윤곽선이 없어야 한다.
+static void TestFill(const char *szImage, BYTE *Input, BYTE *pBinary, int nWidth, int nHeight)
+{
+    size_t nSize = (size_t)nWidth * nHeight;
+    BYTE *pRef = (BYTE *)malloc(nSize), *pMark = (BYTE *)malloc(nSize);
+    int x0 = nWidth / 2, y0 = nHeight / 2, nSeed = Input[y0 * nWidth + x0];
+    IMAGE Img, Out, Big, Roi;
+    CONTOUR_SET Set;
+    char szTest[32];
+    int bOk;
+
+    // 1. 영역 채우기 (시작점 밝기 ± 20, 채울 값 = 범위 밖 / 시작점 밝기)
+    CreateImage(&Img, nWidth, nHeight, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+    for (int nConnectivity = 4; nConnectivity <= 8; nConnectivity += 4)
+        for (int bInRange = 0; bInRange < 2; bInRange++)
+        {
+            BYTE nValue = (BYTE)(bInRange ? nSeed : ((nSeed < 128) ? 255 : 0));
+            int nLo = (nSeed > 20) ? nSeed - 20 : 0, nHi = (nSeed < 235) ? nSeed + 20 : 255, nRef;
+
+            if (!bInRange && nValue >= nLo && nValue <= nHi)
+                continue;
+            memset(pMark, 0, nSize);
+            nRef = RefFill(Input, nWidth, nHeight, x0, y0, nLo, nHi, nConnectivity, pMark);
+            for (size_t i = 0; i < nSize; i++)
+                pRef[i] = pMark[i] ? nValue : Input[i];
+
+            memcpy(Img.pBuffer, Input, nSize);
+            bOk = ImgFloodFill(&Img, x0, y0, nValue, 20, nConnectivity) == nRef && memcmp(Img.pBuffer, pRef, nSize) == 0;
+            snprintf(szTest, sizeof(szTest), "%d conn%s", nConnectivity, bInRange ? " in range" : "");
+            Check(bOk, szImage, "flood_fill", szTest);
+        }
+    Check(ImgFloodFill(&Img, -1, 0, 0, 0, 4) < 0 && ImgFloodFill(&Img, 0, 0, 0, 256, 4) < 0 && ImgFloodFill(&Img, 0, 0, 0, 0, 6) < 0, szImage,
+          "flood_fill", "invalid");
+    FreeImage(&Img);
+
+    // 2. 구멍 채우기 (둘레의 배경마다 4연결 채우기)
+    memset(pMark, 0, nSize);
+    for (int y = 0; y < nHeight; y++)
+        for (int x = 0; x < nWidth; x++)
+            if (y == 0 || x == 0 || y == nHeight - 1 || x == nWidth - 1)
+                RefFill(pBinary, nWidth, nHeight, x, y, 0, 254, 4, pMark);
+    for (size_t i = 0; i < nSize; i++)
+        pRef[i] = pMark[i] ? pBinary[i] : 255;
+
+    WrapImage(&Img, pBinary, nWidth, nHeight, PIXEL_GRAY8, 0);
+    CreateImage(&Out, nWidth, nHeight, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+    Check(ImgFillHoles(&Img, &Out) == 0 && memcmp(Out.pBuffer, pRef, nSize) == 0, szImage, "fill_holes", "reference");
+
+    ContourInit(&Set);
+    bOk = ImgFindContours(&Out, &Set) >= 0;
+    for (int c = 0; c < Set.nContours && bOk; c++)
+        bOk = !Set.pContours[c].bHole;
+    Check(bOk, szImage, "fill_holes", "no_hole_contours");
+    ContourRelease(&Set);
+
+    // ROI, RunOperation 제자리 처리
+    CreateImage(&Big, nWidth + 9, nHeight + 4, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+    for (int i = 0; i < (nWidth + 9) * (nHeight + 4); i++)
+        Big.pBuffer[i] = RandomByte();
+    CreateROI(&Big, &Roi, 4, 2, nWidth, nHeight);
+    CopyImage(&Img, &Roi);
+    bOk = RunOperation(&Context, OP_FILL_HOLES, &Roi, &Roi, NULL) == 0;
+    for (int y = 0; y < nHeight && bOk; y++)
+        bOk = memcmp(Roi.pPlane[0] + (size_t)y * Roi.nStride, pRef + (size_t)y * nWidth, nWidth) == 0;
+    Check(bOk, szImage, "fill_holes", "roi in-place");
+
+    FreeImage(&Big);
+    FreeImage(&Out);
+    free(pRef);
+    free(pMark);
+}
+
+/*
+ * @Function Name : TestRle
+ * @Description : RLE 영상의 왕복 변환(ROI), 넓이, 레이블링(4/8연결), 침식/팽창을 픽셀 단위 결과와 비교합니다.
+ * @Input : *szImage, *pBinary - 이진 영상, nWidth, nHeight
+ */
+// 김광제의 설명 - 레이블 기준 = 래스터 순서로 처음 만난 전경 픽셀에서 픽셀 단위 너비 우선 탐색 (RleLabel도 요소의 첫 런 순서로 번호를 붙임)
+// 정사각형 침식/팽창은 ImgErosionRadius, ImgDilationRadius(체스판)와 같고, 가로 세로가 다른 직사각형은 직접 계산해서 비교
+static void TestRle(const char *szImage, BYTE *pBinary, int nWidth, int nHeight)
+{
+    size_t nSize = (size_t)nWidth * nHeight;
+    int *pRefLabels = (int *)malloc(sizeof(int) * nSize), *pQueue = (int *)malloc(sizeof(int) * nSize), *pRunLabels = NULL;
+    long long *pAreas = NULL, nArea = 0;
+    IMAGE In, Out, Ref, Big, Roi;
+    RLE_IMAGE Rle, Morph;
+    char szTest[32];
+    int bOk;
+
+    RleInit(&Rle);
+    RleInit(&Morph);
+    WrapImage(&In, pBinary, nWidth, nHeight, PIXEL_GRAY8, 0);
+    CreateImage(&Out, nWidth, nHeight, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+    CreateImage(&Ref, nWidth, nHeight, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+
+    // 1. 왕복 변환, 넓이 (ROI 입력, ROI 출력)
+    CreateImage(&Big, nWidth + 7, nHeight + 3, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+    for (int i = 0; i < (nWidth + 7) * (nHeight + 3); i++)
+        Big.pBuffer[i] = RandomByte();
+    CreateROI(&Big, &Roi, 3, 1, nWidth, nHeight);
+    CopyImage(&In, &Roi);
+    bOk = RleEncode(&Roi, &Rle) >= 0 && RleDecode(&Rle, &Out) == 0 && memcmp(Out.pBuffer, pBinary, nSize) == 0;
+    Check(bOk, szImage, "rle", "round_trip");
+    bOk = RleDecode(&Rle, &Roi) == 0;
+    for (int y = 0; y < nHeight && bOk; y++)
+        bOk = memcmp(Roi.pPlane[0] + (size_t)y * Roi.nStride, pBinary + (size_t)y * nWidth, nWidth) == 0;
+    Check(bOk, szImage, "rle", "roi_decode");
+    FreeImage(&Big);
+
+    for (size_t i = 0; i < nSize; i++)
+        nArea += (pBinary[i] == 255);
+    Check(RleArea(&Rle) == nArea, szImage, "rle", "area");
+
+    // 2. 레이블링
+    pRunLabels = (int *)malloc(sizeof(int) * (Rle.nRuns + 1));
+    pAreas = (long long *)malloc(sizeof(long long) * (Rle.nRuns + 1));
+    for (int nConnectivity = 4; nConnectivity <= 8; nConnectivity += 4)
+    {
+        int nRefLabels = 0, nLabels = RleLabel(&Rle, nConnectivity, pRunLabels, pAreas);
+
+        memset(pRefLabels, 0, sizeof(int) * nSize);
+        bOk = nLabels >= 0;
+        for (size_t i = 0; i < nSize && bOk; i++)
+            if (pBinary[i] == 255 && !pRefLabels[i])
+            {
+                int nHead = 0, nTail = 0;
+
+                pRefLabels[i] = ++nRefLabels;
+                pQueue[nTail++] = (int)i;
+                while (nHead < nTail)
+                {
+                    int px = pQueue[nHead] % nWidth, py = pQueue[nHead] / nWidth;
+
+                    nHead++;
+                    for (int dy = -1; dy <= 1; dy++)
+                        for (int dx = -1; dx <= 1; dx++)
+                        {
+                            int nx = px + dx, ny = py + dy, q = ny * nWidth + nx;
+
+                            if ((nConnectivity == 4 && dx != 0 && dy != 0) || nx < 0 || ny < 0 || nx >= nWidth || ny >= nHeight)
+                                continue;
+                            if (pBinary[q] == 255 && !pRefLabels[q])
+                            {
+                                pRefLabels[q] = nRefLabels;
+                                pQueue[nTail++] = q;
+                            }
+                        }
+                }
+                bOk = nRefLabels <= nLabels && pAreas[nRefLabels] == nTail;
+            }
+        bOk = bOk && nRefLabels == nLabels;
+        for (int y = 0; y < nHeight && bOk; y++)
+            for (int r = Rle.pRowStart[y]; r < Rle.pRowStart[y + 1] && bOk; r++)
+                for (int x = Rle.pRuns[r].x0; x < Rle.pRuns[r].x1 && bOk; x++)
+                    bOk = pRefLabels[(size_t)y * nWidth + x] == pRunLabels[r];
+        snprintf(szTest, sizeof(szTest), "label %d conn", nConnectivity);
+        Check(bOk, szImage, "rle", szTest);
+    }
+
+    // 3. 정사각형 침식/팽창 = 체스판 거리 반지름 침식/팽창
+    for (int nRadius = 1; nRadius <= 2; nRadius++)
+        for (int bDilation = 0; bDilation < 2; bDilation++)
+        {
+            bOk = (bDilation ? RleDilation(&Rle, &Morph, nRadius, nRadius) : RleErosion(&Rle, &Morph, nRadius, nRadius)) >= 0 &&
+                  RleDecode(&Morph, &Out) == 0 &&
+                  (bDilation ? ImgDilationRadius(&In, &Ref, nRadius, DIST_CHESSBOARD) : ImgErosionRadius(&In, &Ref, nRadius, DIST_CHESSBOARD)) == 0 &&
+                  IsSameImage(&Out, &Ref);
+            snprintf(szTest, sizeof(szTest), "%s r%d", bDilation ? "dilation" : "erosion", nRadius);
+            Check(bOk, szImage, "rle", szTest);
+        }
+
+    // 가로 2, 세로 1 직사각형 (영상 밖은 보지 않음)
+    for (int bDilation = 0; bDilation < 2; bDilation++)
+    {
+        bOk = (bDilation ? RleDilation(&Rle, &Morph, 2, 1) : RleErosion(&Rle, &Morph, 2, 1)) >= 0 && RleDecode(&Morph, &Out) == 0;
+        for (int y = 0; y < nHeight && bOk; y++)
+            for (int x = 0; x < nWidth && bOk; x++)
+            {
+                int nHit = !bDilation;
+
+                for (int v = y - 1; v <= y + 1; v++)
+                    for (int u = x - 2; u <= x + 2; u++)
+                        if (u >= 0 && v >= 0 && u < nWidth && v < nHeight && (pBinary[v * nWidth + u] == 255) == bDilation)
+                            nHit = bDilation;
+                bOk = Out.pBuffer[y * nWidth + x] == (nHit ? 255 : 0);
+            }
+        Check(bOk, szImage, "rle", bDilation ? "dilation 5x3" : "erosion 5x3");
+    }
+
+    // 잘못된 인자
+    Check(RleErosion(&Rle, &Rle, 1, 1) < 0 && RleDilation(&Rle, &Morph, -1, 0) < 0 && RleLabel(&Rle, 6, pRunLabels, NULL) < 0, szImage, "rle", "invalid");
+
+    RleRelease(&Rle);
+    RleRelease(&Morph);
+    FreeImage(&Out);
+    FreeImage(&Ref);
+    free(pRunLabels);
+    free(pAreas);
+    free(pRefLabels);
+    free(pQueue);
+}
+
+/*
+ * @Function Name : RefConvolution
+ * @Description : 큰 커널 컨볼루션 기준 구현 (영상 밖은 가장 가까운 가장자리 픽셀, 반올림 후 0 ~ 255 클리핑)
+ * @Input : *pImage, nWidth, nHeight, *pKernel, nKernelWidth, nKernelHeight, bAbs
+ * @Output : *pOut
+ */
+static void RefConvolution(const BYTE *pImage, int nWidth, int nHeight, const double *pKernel, int nKernelWidth, int nKernelHeight, int bAbs, BYTE *pOut)
+{
+    for (int y = 0; y < nHeight; y++)
+        for (int x = 0; x < nWidth; x++)
+        {
+            double dSum = 0.0;
+
+            for (int j = 0; j < nKernelHeight; j++)
+                for (int i = 0; i < nKernelWidth; i++)
+                {
+                    int u = x + i - nKernelWidth / 2, v = y + j - nKernelHeight / 2;
+
+                    u = (u < 0) ? 0 : ((u >= nWidth) ? nWidth - 1 : u);
+                    v = (v < 0) ? 0 : ((v >= nHeight) ? nHeight - 1 : v);
+                    dSum += pKernel[j * nKernelWidth + i] * pImage[v * nWidth + u];
+                }
+            if (bAbs)
+                dSum = fabs(dSum);
+            pOut[y * nWidth + x] = (BYTE)((dSum < 0.0) ? 0 : ((dSum > 255.0) ? 255 : floor(dSum + 0.5)));
+        }
+}
+
+/*
+ * @Function Name : MaxDifference
+ * @Description : 두 8비트 버퍼의 가장 큰 차이를 구합니다.
+ */
+static int MaxDifference(const BYTE *pA, const BYTE *pB, size_t nSize)
+{
+    int nMax = 0;
+
+    for (size_t i = 0; i < nSize; i++)
+        if (abs(pA[i] - pB[i]) > nMax)
+            nMax = abs(pA[i] - pB[i]);
+    return nMax;
+}
+
+/*
+ * @Function Name : TestConvolutionLarge
+ * @Description : ImgConvolutionLarge(직접, FFT, ROI 제자리, 16비트)를 픽셀 단위 계산과 비교하고 주파수 영역 필터 결과를 확인합니다.
+ * @Input : *szImage, *Input, nWidth, nHeight
+ */
+// 김광제의 설명 - 직접 계산과 FFT는 double 오차 때문에 반올림 경계(x.5)에서 1 차이가 날 수 있어서 1까지 허용
+static void TestConvolutionLarge(const char *szImage, BYTE *Input, int nWidth, int nHeight)
+{
+    static const int nKernelSizes[3][2] = {{3, 3}, {9, 5}, {15, 15}};
+    size_t nSize = (size_t)nWidth * nHeight;
+    BYTE *pRef = (BYTE *)malloc(nSize);
+    double *pKernel = (double *)malloc(sizeof(double) * 15 * 15);
+    IMAGE In, Out, Big, Roi, In16, Out16;
+    FFT_FILTER Filter;
+    OP_PARAM Param;
+    char szTest[48];
+    int bOk;
+
+    WrapImage(&In, Input, nWidth, nHeight, PIXEL_GRAY8, 0);
+    CreateImage(&Out, nWidth, nHeight, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+
+    // 1. 합이 1인 양수 커널, 부호가 섞인 커널(절대값)
+    for (int k = 0; k < 3; k++)
+        for (int bAbs = 0; bAbs < 2; bAbs++)
+        {
+            int nKw = nKernelSizes[k][0], nKh = nKernelSizes[k][1];
+            double dSum = 0.0;
+
+            for (int i = 0; i < nKw * nKh; i++)
+            {
+                pKernel[i] = bAbs ? (RandomByte() - 128) / 64.0 : RandomByte() + 1.0;
+                dSum += pKernel[i];
+            }
+            for (int i = 0; i < nKw * nKh && !bAbs; i++)
+                pKernel[i] /= dSum;
+            RefConvolution(Input, nWidth, nHeight, pKernel, nKw, nKh, bAbs, pRef);
+
+            for (int nMethod = CONV_METHOD_AUTO; nMethod <= CONV_METHOD_FFT; nMethod++)
+            {
+                bOk = ImgConvolutionLarge(&In, &Out, pKernel, nKw, nKh, bAbs ? CONV_POST_ABS : CONV_POST_NONE, nMethod) == 0 &&
+                      MaxDifference(Out.pBuffer, pRef, nSize) <= 1;
+                snprintf(szTest, sizeof(szTest), "%dx%d%s %s", nKw, nKh, bAbs ? " abs" : "", (nMethod == CONV_METHOD_AUTO) ? "auto" : ((nMethod == CONV_METHOD_DIRECT) ? "direct" : "fft"));
+                Check(bOk, szImage, "convolution_large", szTest);
+            }
+        }
+
+    // 3x3 가우시안은 ImgConvolution과 같음 (가장자리 제외, ImgConvolution은 버림이라서 1까지 허용)
+    for (int i = 0; i < 9; i++)
+        pKernel[i] = ConvolutionTable[KERNEL_GAUSSIAN].Kernel[i / 3][i % 3];
+    if (nWidth > 2 && nHeight > 2)
+    {
+        IMAGE Ref;
+
+        CreateImage(&Ref, nWidth, nHeight, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+        bOk = ImgConvolution(&In, &Ref, KERNEL_GAUSSIAN) == 0 && ImgConvolutionLarge(&In, &Out, pKernel, 3, 3, CONV_POST_NONE, CONV_METHOD_FFT) == 0;
+        for (int y = 1; y < nHeight - 1 && bOk; y++)
+            for (int x = 1; x < nWidth - 1 && bOk; x++)
+                bOk = abs(Out.pBuffer[y * nWidth + x] - Ref.pBuffer[y * nWidth + x]) <= 1;
+        Check(bOk, szImage, "convolution_large", "gaussian_3x3");
+        FreeImage(&Ref);
+    }
+
+    // ROI 제자리, FFT 필터 재사용
+    RefConvolution(Input, nWidth, nHeight, pKernel, 3, 3, 0, pRef);
+    CreateImage(&Big, nWidth + 6, nHeight + 5, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+    for (int i = 0; i < (nWidth + 6) * (nHeight + 5); i++)
+        Big.pBuffer[i] = RandomByte();
+    CreateROI(&Big, &Roi, 2, 3, nWidth, nHeight);
+    CopyImage(&In, &Roi);
+    bOk = FftFilterKernel(&Filter, nWidth, nHeight, pKernel, 3, 3, CONV_POST_NONE) == 0;
+    for (int nFrame = 0; nFrame < 2 && bOk; nFrame++)
+    {
+        bOk = FftFilterApply(&Filter, &In, &Out) == 0 && MaxDifference(Out.pBuffer, pRef, nSize) <= 1;
+        CopyImage(&In, &Roi);
+        bOk = bOk && FftFilterApply(&Filter, &Roi, &Roi) == 0;
+        for (int y = 0; y < nHeight && bOk; y++)
+            bOk = memcmp(Roi.pPlane[0] + (size_t)y * Roi.nStride, Out.pBuffer + (size_t)y * nWidth, nWidth) == 0;
+    }
+    Check(bOk, szImage, "convolution_large", "roi in-place reuse");
+    FftFilterRelease(&Filter);
+    FreeImage(&Big);
+
+    // 16비트 (8비트 값 X 256, 합이 1인 커널이면 결과도 256배)
+    CreateImage(&In16, nWidth, nHeight, PIXEL_GRAY16, LAYOUT_INTERLEAVED);
+    CreateImage(&Out16, nWidth, nHeight, PIXEL_GRAY16, LAYOUT_INTERLEAVED);
+    for (int y = 0; y < nHeight; y++)
+        for (int x = 0; x < nWidth; x++)
+            ((WORD *)(In16.pPlane[0] + (size_t)y * In16.nStride))[x] = (WORD)(Input[y * nWidth + x] * 256);
+    bOk = ImgConvolutionLarge(&In16, &Out16, pKernel, 3, 3, CONV_POST_NONE, CONV_METHOD_FFT) == 0;
+    for (int y = 0; y < nHeight && bOk; y++)
+        for (int x = 0; x < nWidth && bOk; x++)
+            bOk = fabs(((WORD *)(Out16.pPlane[0] + (size_t)y * Out16.nStride))[x] / 256.0 - pRef[y * nWidth + x]) <= 1.0;
+    Check(bOk, szImage, "convolution_large", "gray16");
+
+    // 2. 주파수 영역 필터 : 저역 통과는 평균(직류 성분)을 유지하고, 고역 통과는 상수 영상을 0으로 만듦
+    {
+        double dMeanIn = 0.0, dMeanOut = 0.0;
+
+        bOk = ImgFrequencyFilter(&In, &Out, FREQ_BUTTERWORTH_LOWPASS, 0.05, 2) == 0;
+        for (size_t i = 0; i < nSize; i++)
+        {
+            dMeanIn += Input[i];
+            dMeanOut += Out.pBuffer[i];
+        }
+        if (nWidth >= 32 && nHeight >= 32) // 작은 영상은 여백(가장자리 픽셀)이 평균에 섞이는 영향이 큼
+            Check(bOk && fabs(dMeanIn - dMeanOut) / nSize < 2.0, szImage, "frequency_filter", "lowpass_mean");
+
+        memset(&Param, 0, sizeof(OP_PARAM));
+        Param.nMethod = FREQ_BUTTERWORTH_LOWPASS;
+        Param.dRadius = 0.05;
+        memcpy(pRef, Out.pBuffer, nSize);
+        bOk = RunOperation(&Context, OP_FREQUENCY_FILTER, &In, &Out, &Param) == 0 && memcmp(Out.pBuffer, pRef, nSize) == 0;
+        Check(bOk, szImage, "frequency_filter", "run_operation");
+
+        memset(pRef, 77, nSize);
+        WrapImage(&In, pRef, nWidth, nHeight, PIXEL_GRAY8, 0);
+        for (int nType = FREQ_IDEAL_LOWPASS; nType <= FREQ_BUTTERWORTH_HIGHPASS; nType++)
+        {
+            int bHigh = (nType == FREQ_IDEAL_HIGHPASS || nType == FREQ_BUTTERWORTH_HIGHPASS);
+
+            bOk = ImgFrequencyFilter(&In, &Out, nType, 0.1, 3) == 0;
+            for (size_t i = 0; i < nSize && bOk; i++)
+                bOk = Out.pBuffer[i] == (bHigh ? 0 : 77);
+            snprintf(szTest, sizeof(szTest), "constant type %d", nType);
+            Check(bOk, szImage, "frequency_filter", szTest);
+        }
+    }
+
+    // 잘못된 인자
+    Check(ImgConvolutionLarge(&In, &Out, pKernel, 4, 3, CONV_POST_NONE, CONV_METHOD_AUTO) < 0 &&
+              ImgConvolutionLarge(&In, &Out16, pKernel, 3, 3, CONV_POST_NONE, CONV_METHOD_AUTO) < 0 &&
+              ImgFrequencyFilter(&In, &Out, FREQ_IDEAL_LOWPASS, 0.6, 1) < 0 && ImgFrequencyFilter(&In, &Out, 4, 0.1, 1) < 0,
+          szImage, "convolution_large", "invalid");
+
+    FreeImage(&In16);
+    FreeImage(&Out16);
+    FreeImage(&Out);
+    free(pKernel);
+    free(pRef);
+}
+
+/*
+ * @Function Name : RefSeparable
+ * @Description : 가장자리 화소를 이어 붙여서 가로, 세로로 같은 1차원 커널을 적용합니다. (가우시안 흐림 비교용)
+ * @Input : *pImage - nWidth X nHeight, *pKernel - 2 X nRadius + 1개
+ * @Output : *pImage
+ */
+static void RefSeparable(double *pImage, int nWidth, int nHeight, const double *pKernel, int nRadius)
+{
+    double *pTemp = (double *)malloc(sizeof(double) * nWidth * nHeight);
+
+    for (int y = 0; y < nHeight; y++)
+        for (int x = 0; x < nWidth; x++)
+        {
+            double dSum = 0.0;
+
+            for (int k = -nRadius; k <= nRadius; k++)
+            {
+                int u = (x + k < 0) ? 0 : ((x + k >= nWidth) ? nWidth - 1 : x + k);
+
+                dSum += pKernel[k + nRadius] * pImage[y * nWidth + u];
+            }
+            pTemp[y * nWidth + x] = dSum;
+        }
+    for (int y = 0; y < nHeight; y++)
+        for (int x = 0; x < nWidth; x++)
+        {
+            double dSum = 0.0;
+
+            for (int k = -nRadius; k <= nRadius; k++)
+            {
+                int v = (y + k < 0) ? 0 : ((y + k >= nHeight) ? nHeight - 1 : y + k);
+
+                dSum += pKernel[k + nRadius] * pTemp[v * nWidth + x];
+            }
+            pImage[y * nWidth + x] = dSum;
+        }
+    free(pTemp);
+}
+
+/*
+ * @Function Name : TestGaussianBlur
+ * @Description : 재귀 가우시안은 직접 계산한 가우시안 컨볼루션과, 상자 흐림은 직접 계산한 상자 평균 3번과 비교합니다.
+ * @Input : *szImage, *Input, nWidth, nHeight
+ */
+static void TestGaussianBlur(const char *szImage, const BYTE *Input, int nWidth, int nHeight)
+{
+    static const double Sigmas[] = {0.8, 3.0, 12.0};
+    size_t nSize = (size_t)nWidth * nHeight;
+    double *pRef = (double *)malloc(sizeof(double) * nSize);
+    BYTE *pExpected = (BYTE *)malloc(nSize);
+    IMAGE In, Out, Big, Roi, In16, Out16;
+    OP_PARAM Param;
+    char szTest[64];
+    int bOk;
+
+    WrapImage(&In, (BYTE *)Input, nWidth, nHeight, PIXEL_GRAY8, 0);
+    CreateImage(&Out, nWidth, nHeight, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+
+    for (int s = 0; s < (int)(sizeof(Sigmas) / sizeof(Sigmas[0])); s++)
+    {
+        double dSigma = Sigmas[s], dKernel[2 * 60 + 1], dSum = 0.0;
+        int nRadius = (int)ceil(5.0 * dSigma), nMax = 0, Radius[3], wl, m;
+
+        // 1. 재귀 가우시안 : 3차 근사 오차만큼 차이 (계단 응답 0.3%, 임펄스 응답 최대값의 1 ~ 2%, σ가 작을수록 큼)
+        for (int k = -nRadius; k <= nRadius; k++)
+            dSum += dKernel[k + nRadius] = exp(-k * k / (2.0 * dSigma * dSigma));
+        for (int k = 0; k <= 2 * nRadius; k++)
+            dKernel[k] /= dSum;
+        for (size_t i = 0; i < nSize; i++)
+            pRef[i] = Input[i];
+        RefSeparable(pRef, nWidth, nHeight, dKernel, nRadius);
+        bOk = ImgGaussianBlur(&In, &Out, dSigma, BLUR_RECURSIVE) == 0;
+        for (size_t i = 0; i < nSize && bOk; i++)
+            if (fabs(Out.pBuffer[i] - pRef[i]) > nMax)
+                nMax = (int)ceil(fabs(Out.pBuffer[i] - pRef[i]) - 0.5);
+        snprintf(szTest, sizeof(szTest), "recursive sigma %.1f", dSigma);
+        Check(bOk && nMax <= ((dSigma < 1.0) ? 10 : 4), szImage, "gaussian_blur", szTest);
+
+        // 2. 상자 흐림 3번 (반지름은 blur.c와 같은 규칙 : 너비 wl, wl + 2 홀수를 섞어서 분산 합이 σ²에 가깝게)
+        wl = (int)floor(sqrt(12.0 * dSigma * dSigma / 3 + 1.0));
+        wl -= (wl % 2 == 0) ? 1 : 0;
+        m = (int)floor((12.0 * dSigma * dSigma - 3 * wl * wl - 12.0 * wl - 9.0) / (-4.0 * wl - 4.0) + 0.5);
+        for (size_t i = 0; i < nSize; i++)
+            pRef[i] = Input[i];
+        for (int i = 0; i < 3; i++)
+        {
+            Radius[i] = ((i < m) ? wl : wl + 2) / 2;
+            for (int k = 0; k <= 2 * Radius[i]; k++)
+                dKernel[k] = 1.0 / (2 * Radius[i] + 1);
+            RefSeparable(pRef, nWidth, nHeight, dKernel, Radius[i]);
+        }
+        nMax = 0;
+        bOk = ImgGaussianBlur(&In, &Out, dSigma, BLUR_BOX) == 0;
+        for (size_t i = 0; i < nSize && bOk; i++)
+            if (fabs(Out.pBuffer[i] - pRef[i]) > nMax)
+                nMax = (int)ceil(fabs(Out.pBuffer[i] - pRef[i]) - 0.5);
+        snprintf(szTest, sizeof(szTest), "box sigma %.1f", dSigma);
+        Check(bOk && nMax <= 1 && fabs((Radius[0] * (Radius[0] + 1) + Radius[1] * (Radius[1] + 1) + Radius[2] * (Radius[2] + 1)) / 3.0 - dSigma * dSigma) < 2.0 * dSigma,
+              szImage, "gaussian_blur", szTest);
+    }
+
+    // 3. ROI 제자리 처리 = 복사본 처리
+    bOk = ImgGaussianBlur(&In, &Out, 4.0, BLUR_RECURSIVE) == 0;
+    memcpy(pExpected, Out.pBuffer, nSize);
+    CreateImage(&Big, nWidth + 5, nHeight + 4, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+    CreateROI(&Big, &Roi, 3, 1, nWidth, nHeight);
+    CopyImage(&In, &Roi);
+    bOk = bOk && ImgGaussianBlur(&Roi, &Roi, 4.0, BLUR_RECURSIVE) == 0;
+    for (int y = 0; y < nHeight && bOk; y++)
+        bOk = memcmp(Roi.pPlane[0] + (size_t)y * Roi.nStride, pExpected + (size_t)y * nWidth, nWidth) == 0;
+    Check(bOk, szImage, "gaussian_blur", "roi in-place");
+    FreeImage(&Big);
+
+    // 4. 16비트 (8비트 값 X 256)
+    CreateImage(&In16, nWidth, nHeight, PIXEL_GRAY16, LAYOUT_INTERLEAVED);
+    CreateImage(&Out16, nWidth, nHeight, PIXEL_GRAY16, LAYOUT_INTERLEAVED);
+    for (int y = 0; y < nHeight; y++)
+        for (int x = 0; x < nWidth; x++)
+            ((WORD *)(In16.pPlane[0] + (size_t)y * In16.nStride))[x] = (WORD)(Input[y * nWidth + x] * 256);
+    bOk = ImgGaussianBlur(&In16, &Out16, 4.0, BLUR_RECURSIVE) == 0;
+    for (int y = 0; y < nHeight && bOk; y++)
+        for (int x = 0; x < nWidth && bOk; x++)
+            bOk = fabs(((WORD *)(Out16.pPlane[0] + (size_t)y * Out16.nStride))[x] / 256.0 - pExpected[y * nWidth + x]) <= 1.0;
+    Check(bOk, szImage, "gaussian_blur", "gray16");
+
+    // 5. RunOperation, 상수 영상은 그대로 (가장자리 포함, 큰 σ)
+    memset(&Param, 0, sizeof(OP_PARAM));
+    Param.dRadius = 4.0;
+    Param.nMethod = BLUR_RECURSIVE;
+    bOk = RunOperation(&Context, OP_GAUSSIAN_BLUR, &In, &Out, &Param) == 0 && memcmp(Out.pBuffer, pExpected, nSize) == 0;
+    Check(bOk, szImage, "gaussian_blur", "run_operation");
+
+    memset(pExpected, 201, nSize);
+    WrapImage(&In, pExpected, nWidth, nHeight, PIXEL_GRAY8, 0);
+    for (int nMethod = BLUR_RECURSIVE; nMethod <= BLUR_BOX; nMethod++)
+    {
+        bOk = ImgGaussianBlur(&In, &Out, 40.0, nMethod) == 0;
+        for (size_t i = 0; i < nSize && bOk; i++)
+            bOk = Out.pBuffer[i] == 201;
+        snprintf(szTest, sizeof(szTest), "constant method %d", nMethod);
+        Check(bOk, szImage, "gaussian_blur", szTest);
+    }
+
+    // 잘못된 인자
+    Check(ImgGaussianBlur(&In, &Out, 0.3, BLUR_RECURSIVE) < 0 && ImgGaussianBlur(&In, &Out, 2.0, 2) < 0 && ImgGaussianBlur(&In, &Out16, 2.0, BLUR_BOX) < 0,
+          szImage, "gaussian_blur", "invalid");
+
+    FreeImage(&In16);
+    FreeImage(&Out16);
+    FreeImage(&Out);
+    free(pRef);
+    free(pExpected);
+}
+
+/*
+ * @Function Name : TestFft
+ * @Description : 2차원 실수 FFT를 직접 계산한 DFT와 비교하고 역변환으로 원래 값이 나오는지 확인합니다. (혼합 기수 크기)
+ */
+static void TestFft(void)
+{
+    static const int nSizes[][2] = {{2, 2}, {12, 10}, {30, 15}, {20, 9}, {64, 50}, {250, 6}};
+
+    for (int s = 0; s < (int)(sizeof(nSizes) / sizeof(nSizes[0])); s++)
+    {
+        int nWidth = nSizes[s][0], nHeight = nSizes[s][1], nSpecWidth = nWidth / 2 + 1, bOk;
+        double *pIn = (double *)malloc(sizeof(double) * nWidth * nHeight), *pBack = (double *)malloc(sizeof(double) * nWidth * nHeight);
+        FFT_COMPLEX *pSpec = (FFT_COMPLEX *)malloc(sizeof(FFT_COMPLEX) * nSpecWidth * nHeight);
+        FFT_PLAN Plan;
+        char szTest[32];
+
+        for (int i = 0; i < nWidth * nHeight; i++)
+            pIn[i] = RandomByte() - 128.0;
+
+        bOk = FftInit(&Plan, nWidth, nHeight) == 0 && FftForward2D(&Plan, pIn, pSpec) == 0;
+        for (int v = 0; v < nHeight && bOk; v++)
+            for (int u = 0; u < nSpecWidth && bOk; u++)
+            {
+                double re = 0.0, im = 0.0;
+
+                for (int y = 0; y < nHeight; y++)
+                    for (int x = 0; x < nWidth; x++)
+                    {
+                        double dAngle = -2.0 * M_PI * ((double)u * x / nWidth + (double)v * y / nHeight);
+
+                        re += pIn[y * nWidth + x] * cos(dAngle);
+                        im += pIn[y * nWidth + x] * sin(dAngle);
+                    }
+                bOk = fabs(pSpec[v * nSpecWidth + u].re - re) < 1e-6 * nWidth * nHeight && fabs(pSpec[v * nSpecWidth + u].im - im) < 1e-6 * nWidth * nHeight;
+            }
+        snprintf(szTest, sizeof(szTest), "dft %dx%d", nWidth, nHeight);
+        Check(bOk, "fft", "forward", szTest);
+
+        bOk = bOk && FftInverse2D(&Plan, pSpec, pBack) == 0;
+        for (int i = 0; i < nWidth * nHeight && bOk; i++)
+            bOk = fabs(pBack[i] - pIn[i]) < 1e-9;
+        snprintf(szTest, sizeof(szTest), "round_trip %dx%d", nWidth, nHeight);
+        Check(bOk, "fft", "inverse", szTest);
+
+        FftRelease(&Plan);
+        free(pIn);
+        free(pBack);
+        free(pSpec);
+    }
+
+    Check(FftGoodSize(1) == 2 && FftGoodSize(7) == 8 && FftGoodSize(31) == 32 && FftGoodSize(61) == 64 && FftGoodSize(97) == 100, "fft", "good_size", "");
+    {
+        FFT_PLAN Plan;
+
+        Check(FftInit(&Plan, 14, 8) < 0 && FftInit(&Plan, 15, 8) < 0 && FftInit(&Plan, 8, 7) < 0, "fft", "init", "invalid");
+    }
+}
+
+/*
+ * @Function Name : BlobTexture
+ * @Description : 가우시안 점 여러개를 더한 합성 영상 값을 실수 좌표에서 계산합니다. (부화소 이동, 회전한 영상을 보간 없이 만들기 위해)
+ * @Input : *pBlobs - 점마다 x, y, 표준 편차, 밝기, nBlobs, x, y
+ * @Output : 반환값 밝기
+ */
+static double BlobTexture(const double *pBlobs, int nBlobs, double x, double y)
+{
+    double dValue = 40.0;
+
+    for (int i = 0; i < nBlobs; i++)
+    {
+        const double *b = pBlobs + i * 4;
+        double dx = x - b[0], dy = y - b[1];
+
+        dValue += b[3] * exp(-(dx * dx + dy * dy) / (2.0 * b[2] * b[2]));
+    }
+    return (dValue > 255.0) ? 255.0 : dValue;
+}
+
+/*
+ * @Function Name : MakeWarpedFrame
+ * @Description : 프레임(c + dScale R(dAngle) (x - c) + (dx, dy)) = 기준(x)가 되도록 합성 영상을 만듭니다. (PHASE_CORR_RESULT 움직임 모델)
+ * @Input : *pBlobs, nBlobs, *pOut - 8, 16비트 그레이, dx, dy, dAngle (도), dScale
+ */
+static void MakeWarpedFrame(const double *pBlobs, int nBlobs, IMAGE *pOut, double dx, double dy, double dAngle, double dScale)
+{
+    double cx = (pOut->nWidth - 1) / 2.0, cy = (pOut->nHeight - 1) / 2.0, c = cos(dAngle * M_PI / 180.0), s = sin(dAngle * M_PI / 180.0);
+
+    for (int y = 0; y < pOut->nHeight; y++)
+        for (int x = 0; x < pOut->nWidth; x++)
+        {
+            // 기준 좌표 = c + R^-1 (p - c - d) / dScale
+            double px = x - cx - dx, py = y - cy - dy;
+            double dValue = BlobTexture(pBlobs, nBlobs, cx + (c * px + s * py) / dScale, cy + (-s * px + c * py) / dScale);
+
+            if (pOut->nFormat == PIXEL_GRAY16)
+                ((WORD *)(pOut->pPlane[0] + (size_t)y * pOut->nStride))[x] = (WORD)(dValue * 256.0 + 0.5);
+            else
+                pOut->pPlane[0][(size_t)y * pOut->nStride + x] = (BYTE)(dValue + 0.5);
+        }
+}
+
+/*
+ * @Function Name : TestRegistration
+ * @Description : 위상 상관 정합이 합성 영상의 알고 있는 이동량, 회전, 배율을 찾는지 확인합니다.
+ */
+static void TestRegistration(void)
+{
+    enum { nBlobs = 400 };
+    static const double Shifts[][2] = {{5.0, -3.0}, {-12.5, 7.25}, {0.3, -0.4}, {-20.0, -15.6}};
+    static const double Warps[][4] = {{4.0, -3.0, 10.0, 1.1}, {-2.0, 5.0, -25.0, 0.9}, {3.0, 2.0, 150.0, 1.0}};
+    double Blobs[nBlobs * 4];
+    IMAGE Ref, Frame, Ref16, Frame16, Small, Color;
+    PHASE_CORR Corr;
+    PHASE_CORR_RESULT Result;
+    char szTest[64];
+    int bOk;
+
+    for (int i = 0; i < nBlobs; i++)
+    {
+        Blobs[i * 4 + 0] = RandomByte() * (240.0 / 255.0) - 20.0;
+        Blobs[i * 4 + 1] = RandomByte() * (240.0 / 255.0) - 20.0;
+        Blobs[i * 4 + 2] = 1.5 + RandomByte() / 60.0;
+        Blobs[i * 4 + 3] = 30.0 + RandomByte() / 3.0;
+    }
+
+    // 1. 평행 이동 (120 X 90 : 변환 크기와 같음, 기준 스펙트럼 한번으로 여러 프레임)
+    CreateImage(&Ref, 120, 90, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+    CreateImage(&Frame, 120, 90, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+    MakeWarpedFrame(Blobs, nBlobs, &Ref, 0.0, 0.0, 0.0, 1.0);
+    bOk = PhaseCorrInit(&Corr, &Ref, 0) == 0;
+    Check(bOk, "phase_correlation", "init", "");
+    for (int i = 0; i < (int)(sizeof(Shifts) / sizeof(Shifts[0])) && bOk; i++)
+    {
+        double dx = 0.0, dy = 0.0;
+
+        MakeWarpedFrame(Blobs, nBlobs, &Frame, Shifts[i][0], Shifts[i][1], 0.0, 1.0);
+        snprintf(szTest, sizeof(szTest), "shift %.2f,%.2f", Shifts[i][0], Shifts[i][1]);
+        Check(PhaseCorrMatch(&Corr, &Frame, &Result) == 0 && fabs(Result.dx - Shifts[i][0]) < 0.1 && fabs(Result.dy - Shifts[i][1]) < 0.1 &&
+                  Result.dAngle == 0.0 && Result.dScale == 1.0,
+              "phase_correlation", "match", szTest);
+        Check(ImgPhaseCorrelate(&Ref, &Frame, &dx, &dy) == 0 && dx == Result.dx && dy == Result.dy, "phase_correlation", "one_shot", szTest);
+    }
+    MakeWarpedFrame(Blobs, nBlobs, &Frame, 0.0, 0.0, 0.0, 1.0);
+    Check(PhaseCorrMatch(&Corr, &Frame, &Result) == 0 && fabs(Result.dx) < 1e-6 && fabs(Result.dy) < 1e-6 && Result.dResponse > 0.99, "phase_correlation",
+          "match", "identity");
+    PhaseCorrRelease(&Corr);
+
+    // 2. 16비트, 변환 크기보다 작은 영상 (97 X 61 -> 100 X 64, 나머지 0)
+    CreateImage(&Ref16, 97, 61, PIXEL_GRAY16, LAYOUT_INTERLEAVED);
+    CreateImage(&Frame16, 97, 61, PIXEL_GRAY16, LAYOUT_INTERLEAVED);
+    MakeWarpedFrame(Blobs, nBlobs, &Ref16, 0.0, 0.0, 0.0, 1.0);
+    MakeWarpedFrame(Blobs, nBlobs, &Frame16, -6.75, 4.5, 0.0, 1.0);
+    bOk = PhaseCorrInit(&Corr, &Ref16, 0) == 0 && PhaseCorrMatch(&Corr, &Frame16, &Result) == 0;
+    Check(bOk && fabs(Result.dx + 6.75) < 0.1 && fabs(Result.dy - 4.5) < 0.1, "phase_correlation", "gray16", "shift -6.75,4.50");
+    PhaseCorrRelease(&Corr);
+
+    // 3. 회전, 배율 (θ + π 구분 포함)
+    FreeImage(&Ref);
+    FreeImage(&Frame);
+    CreateImage(&Ref, 200, 200, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+    CreateImage(&Frame, 200, 200, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+    MakeWarpedFrame(Blobs, nBlobs, &Ref, 0.0, 0.0, 0.0, 1.0);
+    bOk = PhaseCorrInit(&Corr, &Ref, 1) == 0;
+    Check(bOk, "phase_correlation", "init", "rotation_scale");
+    for (int i = 0; i < (int)(sizeof(Warps) / sizeof(Warps[0])) && bOk; i++)
+    {
+        MakeWarpedFrame(Blobs, nBlobs, &Frame, Warps[i][0], Warps[i][1], Warps[i][2], Warps[i][3]);
+        snprintf(szTest, sizeof(szTest), "%.0fdeg x%.2f shift %.0f,%.0f", Warps[i][2], Warps[i][3], Warps[i][0], Warps[i][1]);
+        Check(PhaseCorrMatch(&Corr, &Frame, &Result) == 0 && fabs(Result.dAngle - Warps[i][2]) < 1.0 && fabs(Result.dScale / Warps[i][3] - 1.0) < 0.02 &&
+                  fabs(Result.dx - Warps[i][0]) < 1.0 && fabs(Result.dy - Warps[i][1]) < 1.0,
+              "phase_correlation", "rotation_scale", szTest);
+    }
+    PhaseCorrRelease(&Corr);
+
+    // 4. 잘못된 입력
+    CreateImage(&Small, 3, 3, PIXEL_GRAY8, LAYOUT_INTERLEAVED);
+    CreateImage(&Color, 200, 200, PIXEL_BGR24, LAYOUT_INTERLEAVED);
+    bOk = PhaseCorrInit(&Corr, &Small, 0) < 0 && PhaseCorrInit(&Corr, &Color, 0) < 0 && PhaseCorrInit(&Corr, &Ref16, 0) == 0;
+    bOk = bOk && PhaseCorrMatch(&Corr, &Ref, &Result) < 0 && PhaseCorrMatch(&Corr, &Frame16, NULL) < 0;
+    PhaseCorrRelease(&Corr);
+    Check(bOk && PhaseCorrMatch(&Corr, &Frame16, &Result) < 0, "phase_correlation", "invalid", "");
+
+    FreeImage(&Ref);
+    FreeImage(&Frame);
+    FreeImage(&Ref16);
+    FreeImage(&Frame16);
+    FreeImage(&Small);
+    FreeImage(&Color);
+}
+
+/*
+ * @Function Name : TestImage
+ * @Description : 8비트 영상 하나에 대해 그레이(원본, 이진화), 컬러 비교를 모두 실행합니다.
+ * @Input : *szImage, *Input, nWidth, nHeight, nThreads
+ */
+static void TestImage(const char *szImage, BYTE *Input, int nWidth, int nHeight, int nThreads)
+{
+    size_t nSize = (size_t)nWidth * nHeight;
+    BYTE *pBinary = (BYTE *)malloc(nSize);
+    char szName[64];
+
+    // 형태학 연산, 경계 검출은 이진 영상에서 의미가 있으므로 이진화한 영상으로도 비교
+    for (size_t i = 0; i < nSize; i++)
+        pBinary[i] = (Input[i] >= 128) ? 255 : 0;
+
+    TestGray(szImage, Input, nWidth, nHeight, nThreads);
+    TestPipeline(szImage, Input, nWidth, nHeight);
+    TestFileFormats(szImage, Input, pBinary, nWidth, nHeight);
+    TestDistance(szImage, pBinary, nWidth, nHeight);
+    TestContours(szImage, pBinary, nWidth, nHeight);
+    TestFill(szImage, Input, pBinary, nWidth, nHeight);
+    TestRle(szImage, pBinary, nWidth, nHeight);
+    TestConvolutionLarge(szImage, Input, nWidth, nHeight);
+    TestGaussianBlur(szImage, Input, nWidth, nHeight);
+    snprintf(szName, sizeof(szName), "%s(bin)", szImage);
+    TestGray(szName, pBinary, nWidth, nHeight, nThreads);
+    TestColor(szImage, Input, nWidth, nHeight, PIXEL_BGR24, nThreads);
+    TestColor(szImage, Input, nWidth, nHeight, PIXEL_BGRA32, nThreads);
+
+    free(pBinary);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *szDir = (argc > 1) ? argv[1] : ".";
+    const char *szFiles[] = {"coins.bmp", "noise.bmp", "scratch.bmp"};
+    // 홀수 크기 (행 끝 처리, SIMD 나머지 처리, 타일 나머지 처리 확인용)
+    const int nSizes[][2] = {{3, 3}, {7, 5}, {17, 33}, {77, 41}, {129, 65}, {255, 3}, {5, 131}};
+    int nThreads = 4;
+
+    if (argc > 2)
+        nRandomSeed = (unsigned int)strtoul(argv[2], NULL, 10);
+
+#ifdef _OPENMP
+    if (omp_get_num_procs() > nThreads)
+        nThreads = omp_get_num_procs();
+#endif
+
+    if (ContextInit(&Context, nThreads, 0) != 0)
+    {
+        printf("Error : this CPU does not support the instruction set used in the build\n");
+        return 1;
+    }
+
+    // 1. 예제 영상 (없으면 건너뜀)
+    for (int f = 0; f < 3; f++)
+    {
+        char szPath[512];
+        FILE *fp;
+        BITMAPFILEHEADER hf;
+        BITMAPINFOHEADER hInfo;
+        RGBQUAD hRGB[256];
+        int nFormat;
+        BYTE *Input;
+
+        snprintf(szPath, sizeof(szPath), "%s/%s", szDir, szFiles[f]);
+        fp = fopen(szPath, "rb");
+        if (NULL == fp)
+        {
+            printf("skip %s (not found)\n", szPath);
+            continue;
+        }
+        Input = ReadBitmap(fp, &hf, &hInfo, hRGB, &nFormat);
+        fclose(fp);
+        if (NULL == Input || nFormat != PIXEL_GRAY8)
+        {
+            printf("skip %s (not 8 bit)\n", szPath);
+            PoolFree(GetThreadPool(), Input);
+            continue;
+        }
+
+        TestImage(szFiles[f], Input, hInfo.biWidth, hInfo.biHeight, nThreads);
+        PoolFree(GetThreadPool(), Input);
+    }
+
+    // 2. 홀수 크기 난수 영상
+    for (int s = 0; s < (int)(sizeof(nSizes) / sizeof(nSizes[0])); s++)
+    {
+        int nWidth = nSizes[s][0], nHeight = nSizes[s][1];
+        BYTE *Input = (BYTE *)malloc((size_t)nWidth * nHeight);
+        char szName[32];
+
+        for (int i = 0; i < nWidth * nHeight; i++)
+            Input[i] = RandomByte();
+
+        snprintf(szName, sizeof(szName), "random_%dx%d", nWidth, nHeight);
+        TestImage(szName, Input, nWidth, nHeight, nThreads);
+        free(Input);
+    }
+
+    // 3. 일괄 처리 (깨진 BMP 헤더 포함)
+    TestBitmapHeader();
+    TestBatch(szDir);
+
+    // 4. 원 허프 변환
+    TestHough(szDir, nThreads);
+    TestHoughLines(nThreads);
+
+    // 5. 워터셰드
+    TestWatershed(szDir, nThreads);
+
+    // 6. 윤곽선
+    TestContourShapes();
+
+    // 7. FFT
+    TestFft();
+
+    // 8. 위상 상관 정합
+    TestRegistration();
+
+    ContextRelease(&Context);
+    PoolRelease(GetThreadPool());
+    printf("%d checks, %d failures\n", nChecks, nFailures);
+    return (nFailures == 0) ? 0 : 1;
+}
@@ -0,0 +1,1651 @@
+/*
+ * @Name : hough.c
+ * @Description : Image Processing in C - 허프 변환 (원, 직선 검출)
+ * @Date : 2026. 10. 19
+ * @Revision : 1.1
+ * 1.0 : ImgHoughCircles (가우시안 + 소벨 기울기 방향 투표, 2 X 2 픽셀 칸 16비트 중심 누적 배열, 행 띠 단위 병렬 투표, 반지름 검증)
+ * 1.1 : ImgHoughLines (에지 점 목록, 고정 소수점 sin / cos 표, 정수 누적 배열, 극대점 비교 후 직선 다시 맞추기, 점진 방식)
+ *
+ * 레이블링 면적으로 동전을 세면 맞닿은 동전이 한 덩어리가 되어 개수와 크기가 틀린다.
+ * 원 위의 에지 픽셀은 기울기 방향(원의 법선)으로 반지름만큼 가면 중심이 나오므로, 에지마다 그 선분 위에만 투표하면
+ * (x, y, r) 3차원 누적 배열 없이 중심 (x, y)만 누적하고 반지름은 중심을 찾은 뒤에 따로 구할 수 있다.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include "imgprocessing.h"
+#include "profile.h"
+
+#define HOUGH_CELL_SHIFT 1                // 중심 누적 배열 한 칸 = 2 X 2 픽셀
+#define HOUGH_CELL (1 << HOUGH_CELL_SHIFT) // 한 칸의 픽셀 수 (투표 선분의 반지름 간격과 같음)
+#define HOUGH_BAND_ROWS 64                 // 스레드 하나가 맡는 누적 배열 행 수 (4096 영상은 64 X 2048칸 X 2바이트 = 256KB, L2 캐시 크기)
+#define HOUGH_EDGE_BLOCK 64                // 에지를 모을 때 스레드 하나가 맡는 행 수
+#define HOUGH_FIX_BITS 16                  // 투표 선분 위치의 고정 소수점 비트 수
+#define HOUGH_ALIGN_COS 0.9f               // 반지름 검증에서 에지 기울기와 중심 방향이 이루는 각의 cos 최소값 (약 25도)
+#define HOUGH_REFINE_PASSES 3              // 중심을 다시 구하는 횟수
+#define HOUGH_GATHER_MARGIN 8              // 중심을 다시 구하면서 움직일 수 있는 거리 (픽셀)
+#define HOUGH_GATHER_COS 0.7071f           // 주변 에지를 모을 때 기울기와 중심 방향이 이루는 각의 cos 최소값 (45도, 중심이 옮겨가도 빠지지 않도록 넓게)
+#define HOUGH_ANGLE_BINS 64                // 둘레 비율을 셀 때 원을 나누는 각도 구간 수 (64비트 하나에 표시)
+#define HOUGH_THETA_BINS 180               // 직선 법선 각도 구간 수 (1도)
+#define HOUGH_TRIG_BITS 16                 // sin, cos 표의 고정 소수점 비트 수
+#define HOUGH_LINE_NMS 2                   // 직선 극대점 비교 범위 (각도, 거리 각각 +-2칸)
+#define HOUGH_LINE_BAND 1                  // 선분 끝점을 찾을 때 직선에서 허용하는 거리 (픽셀)
+#define HOUGH_LINE_PASSES 8                // 직선을 다시 맞추는 최대 횟수 (점이 늘지 않으면 멈춤)
+#define HOUGH_LINE_CANDIDATE 48            // 직선 후보로 볼 누적 배열 투표 수의 최대값 (1도 칸에 어긋난 긴 직선이 한 칸에 모으는 약 115표의 절반 이하)
+#define HOUGH_LINE_SLIVER 200              // 처음 모은 선분(칸 직선 +-2픽셀 띠)에서 요구하는 점 수의 최대값 (어긋난 긴 직선도 약 4 / sin(0.5도) = 460픽셀은 띠 안)
+#define HOUGH_POINT_CHUNK 4096             // 표준 방식 투표에서 각도마다 한번에 보는 에지 점 수 (16KB, L1 캐시)
+#define HOUGH_SHUFFLE_SEED 12345u          // 점진 방식의 투표 순서 (고정 시드라서 결과가 매번 같음)
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// 에지 픽셀 (기울기 방향은 단위 벡터)
+typedef struct
+{
+    int x, y;
+    float ux, uy;
+} HOUGH_EDGE;
+
+// 중심 후보 (누적 배열 칸 좌표와 3 X 3칸 투표 합)
+typedef struct
+{
+    int x, y;
+    int nScore;
+    double dX, dY; // 3 X 3칸 가중 평균으로 구한 중심 (픽셀)
+} HOUGH_PEAK;
+
+// 직선 허프 변환의 에지 점 (영상 한 변은 65535 이하)
+typedef struct
+{
+    WORD x, y;
+} HOUGH_POINT;
+
+// 이미 고른 중심 (dMinDist 크기 격자 칸마다 연결 리스트, 가까운 중심은 주변 3 X 3칸에서만 찾음)
+typedef struct
+{
+    int nCols, nRows, nCount;
+    double dMinDist;
+    int *pHead, *pNext; // 칸의 첫 중심 번호, 같은 칸의 다음 중심 번호 (-1 : 없음)
+    double *pXY;
+} HOUGH_GRID;
+
+/*
+ * @Function Name : GradientRow
+ * @Description : y행의 기울기 크기의 제곱과 X, Y 기울기를 구합니다. (가우시안 3 X 3 후 소벨 X, Y를 한번에 한 5 X 5 미분, 부호 유지)
+ * @Input : *pIn, y (2 ~ nHeight - 3), *pSmooth, *pDiff - 작업 버퍼 (nWidth개)
+ * @Output : *pGx, *pGy, *pG2 - x = 2 ~ nWidth - 3 위치
+ */
+// 김광제의 설명 - 5 X 5 커널은 세로 [1 4 6 4 1] (가우시안 x 소벨의 평활 방향), [-1 -2 0 2 1] (미분 방향)과 가로 같은 두 벡터의 곱이라서
+// 세로 합을 먼저 구하고 가로로 한번 더 합친다. (각 루프가 분기 없이 벡터화됨)
+static void GradientRow(const IMAGE *pIn, int y, int *pSmooth, int *pDiff, int *pGx, int *pGy, int *pG2)
+{
+    int nWidth = pIn->nWidth;
+    const BYTE *p0 = pIn->pPlane[0] + (size_t)(y - 2) * pIn->nStride;
+    const BYTE *p1 = p0 + pIn->nStride, *p2 = p1 + pIn->nStride, *p3 = p2 + pIn->nStride, *p4 = p3 + pIn->nStride;
+
+    for (int x = 0; x < nWidth; x++)
+    {
+        pSmooth[x] = p0[x] + 4 * p1[x] + 6 * p2[x] + 4 * p3[x] + p4[x];
+        pDiff[x] = p4[x] + 2 * p3[x] - 2 * p1[x] - p0[x];
+    }
+
+    for (int x = 2; x < nWidth - 2; x++)
+    {
+        int gx = pSmooth[x + 2] + 2 * pSmooth[x + 1] - 2 * pSmooth[x - 1] - pSmooth[x - 2];
+        int gy = pDiff[x - 2] + 4 * pDiff[x - 1] + 6 * pDiff[x] + 4 * pDiff[x + 1] + pDiff[x + 2];
+
+        pGx[x] = gx;
+        pGy[x] = gy;
+        pG2[x] = gx * gx + gy * gy;
+    }
+}
+
+/*
+ * @Function Name : CollectEdges
+ * @Description : 기울기 크기가 nEdgeThreshold 이상인 픽셀을 행 순서로 모읍니다.
+ * @Input : *pIn - 8비트 그레이 영상 (ROI 가능), nEdgeThreshold - 소벨 출력(ConvolutionEx)과 같은 단위의 임계값
+ * @Output : *pRowStart - y행 에지의 시작 번호 (nHeight + 1개), **ppEdges - 에지 배열 (PoolAlloc), 반환값 에지 개수 / -1 (메모리 할당 오류)
+ */
+// 김광제의 설명 - 이진 영상의 원 경계는 계단 모양이라서 3 X 3 소벨의 방향은 10도 가까이 틀리고, 반지름 100이면 중심이 15픽셀 넘게 어긋난다.
+// 가우시안 (1 2 1) 후 소벨을 한 것과 같은 5 X 5 미분을 사용하면 계단이 퍼져서 방향 오차가 1 ~ 2도로 줄어듦
+// 크기는 같은 단차에서 소벨의 12배라서 임계값도 맞춰서 비교한다. (소벨 출력 |g| / 4 -> 5 X 5는 |g| / 48)
+// HOUGH_EDGE_BLOCK 행씩 나눠서 블록마다 따로 모은 뒤 (병렬) 블록 순서로 이어 붙이므로 영상을 한번만 읽고 결과는 행 순서가 된다.
+// 행 순서로 모여 있어서 투표, 반지름 검증에서 필요한 행 범위의 에지만 바로 꺼낼 수 있다.
+static int CollectEdges(const IMAGE *pIn, int nEdgeThreshold, int *pRowStart, HOUGH_EDGE **ppEdges)
+{
+    int nWidth = pIn->nWidth, nHeight = pIn->nHeight;
+    int nBlocks = (nHeight + HOUGH_EDGE_BLOCK - 1) / HOUGH_EDGE_BLOCK;
+    int nLimit = 48 * 48 * nEdgeThreshold * nEdgeThreshold;
+    HOUGH_EDGE **pBlock, *pEdges = NULL;
+    int nFailed = 0;
+
+    if (nEdgeThreshold < 1)
+        nLimit = 1;
+    else if (nEdgeThreshold > 900)
+        nLimit = INT_MAX; // |g| <= 255 x 96 x sqrt(2) 이라서 / 48 은 721보다 작음
+
+    pBlock = (HOUGH_EDGE **)calloc(nBlocks, sizeof(HOUGH_EDGE *));
+    if (NULL == pBlock)
+        return (-1);
+    memset(pRowStart, 0, sizeof(int) * (nHeight + 1));
+
+    // 1. 블록마다 모으기 (블록 안의 행별 개수는 pRowStart[y + 1]에 기록)
+#pragma omp parallel reduction(+ : nFailed)
+    {
+        int *pWork = (int *)malloc(sizeof(int) * nWidth * 5);
+
+        if (NULL == pWork)
+            nFailed++;
+
+#pragma omp for schedule(dynamic, 1)
+        for (int b = 0; b < nBlocks; b++)
+        {
+            int y0 = b * HOUGH_EDGE_BLOCK, y1 = (y0 + HOUGH_EDGE_BLOCK < nHeight) ? y0 + HOUGH_EDGE_BLOCK : nHeight;
+            int nCount = 0, nCapacity = nWidth, bFull = 0;
+            HOUGH_EDGE *pList;
+
+            if (NULL == pWork || (pList = (HOUGH_EDGE *)malloc(sizeof(HOUGH_EDGE) * nCapacity)) == NULL)
+            {
+                nFailed++;
+                continue;
+            }
+
+            for (int y = (y0 > 2) ? y0 : 2; y < y1 && y < nHeight - 2; y++)
+            {
+                int *pGx = pWork + nWidth * 2, *pGy = pWork + nWidth * 3, *pG2 = pWork + nWidth * 4;
+                int nRowStart = nCount;
+
+                GradientRow(pIn, y, pWork, pWork + nWidth, pGx, pGy, pG2);
+                for (int x = 2; x < nWidth - 2; x++)
+                {
+                    float fInv;
+
+                    if (pG2[x] < nLimit)
+                        continue;
+
+                    if (nCount == nCapacity)
+                    {
+                        HOUGH_EDGE *pNew = (HOUGH_EDGE *)realloc(pList, sizeof(HOUGH_EDGE) * nCapacity * 2);
+
+                        if (NULL == pNew)
+                        {
+                            bFull = 1;
+                            break;
+                        }
+                        pList = pNew;
+                        nCapacity *= 2;
+                    }
+
+                    fInv = 1.0f / sqrtf((float)pG2[x]);
+                    pList[nCount].x = x;
+                    pList[nCount].y = y;
+                    pList[nCount].ux = pGx[x] * fInv;
+                    pList[nCount].uy = pGy[x] * fInv;
+                    nCount++;
+                }
+                pRowStart[y + 1] = nCount - nRowStart;
+                if (bFull)
+                {
+                    nFailed++;
+                    break;
+                }
+            }
+            pBlock[b] = pList;
+        }
+
+        free(pWork);
+    }
+
+    // 2. 행별 개수의 누적합으로 자리를 정하고 블록 순서로 이어 붙임
+    for (int y = 0; y < nHeight; y++)
+        pRowStart[y + 1] += pRowStart[y];
+
+    if (nFailed == 0)
+        pEdges = (HOUGH_EDGE *)PoolAlloc(GetThreadPool(), sizeof(HOUGH_EDGE) * (pRowStart[nHeight] + 1), 0);
+
+    for (int b = 0; b < nBlocks; b++)
+    {
+        int y0 = b * HOUGH_EDGE_BLOCK, y1 = (y0 + HOUGH_EDGE_BLOCK < nHeight) ? y0 + HOUGH_EDGE_BLOCK : nHeight;
+
+        if (NULL != pEdges && NULL != pBlock[b])
+            memcpy(pEdges + pRowStart[y0], pBlock[b], sizeof(HOUGH_EDGE) * (pRowStart[y1] - pRowStart[y0]));
+        free(pBlock[b]);
+    }
+    free(pBlock);
+
+    if (NULL == pEdges)
+        return (-1);
+
+    *ppEdges = pEdges;
+    return pRowStart[nHeight];
+}
+
+/*
+ * @Function Name : ClipRay
+ * @Description : o + r * d 가 [dLo, dHi) 안에 있는 r 범위로 *pRLo ~ *pRHi를 줄입니다.
+ * @Input : o, d, dLo, dHi
+ * @Output : *pRLo, *pRHi (범위가 없으면 *pRLo > *pRHi)
+ */
+static void ClipRay(float o, float d, float dLo, float dHi, float *pRLo, float *pRHi)
+{
+    float t0, t1;
+
+    if (fabsf(d) < 1e-6f)
+    {
+        if (o < dLo || o >= dHi)
+            *pRLo = *pRHi + 1.0f;
+        return;
+    }
+
+    t0 = (dLo - o) / d;
+    t1 = (dHi - o) / d;
+    if (t0 > t1)
+    {
+        float t = t0;
+        t0 = t1;
+        t1 = t;
+    }
+    if (t0 > *pRLo)
+        *pRLo = t0;
+    if (t1 < *pRHi)
+        *pRHi = t1;
+}
+
+/*
+ * @Function Name : VoteBand
+ * @Description : 누적 배열의 nRow0 ~ nRow1 - 1 행(띠)에 떨어지는 중심 투표만 합니다.
+ * @Input : *pEdges, nFirst ~ nLast - 1 (띠에 닿을 수 있는 에지), nMinRadius, nMaxRadius, nWidth, nHeight, nAccWidth, nRow0, nRow1
+ * @Output : *pBand - 누적 배열의 nRow0 행 (nRow1 - nRow0행 X nAccWidth칸)
+ */
+// 김광제의 설명 - 에지 하나가 기울기 방향과 반대 방향으로 각각 nMinRadius ~ nMaxRadius 선분 위에 투표한다.
+// (밝은 원, 어두운 원 모두 찾도록 두 방향 모두 투표, 선분 간격은 누적 배열 한 칸 크기)
+// 선분을 영상과 띠 범위로 먼저 잘라서 띠 밖으로 나가는 반지름은 계산하지 않는다. 띠는 한 스레드만 쓰므로 원자적 연산이 필요 없음
+static void VoteBand(const HOUGH_EDGE *pEdges, int nFirst, int nLast, int nMinRadius, int nMaxRadius, int nWidth, int nHeight, int nAccWidth, int nRow0, int nRow1, WORD *pBand)
+{
+    float fBandTop = (float)(nRow0 << HOUGH_CELL_SHIFT);
+    float fBandBottom = (float)(nRow1 << HOUGH_CELL_SHIFT);
+    int nSteps = (nMaxRadius - nMinRadius) / HOUGH_CELL;
+    unsigned long long nBandRows = (unsigned long long)(nRow1 - nRow0);
+
+    if (fBandBottom > (float)nHeight)
+        fBandBottom = (float)nHeight;
+
+    for (int i = nFirst; i < nLast; i++)
+    {
+        float ox = pEdges[i].x + 0.5f, oy = pEdges[i].y + 0.5f; // 픽셀 중앙
+
+        for (int s = -1; s <= 1; s += 2)
+        {
+            float dx = s * pEdges[i].ux, dy = s * pEdges[i].uy;
+            float fRLo = (float)nMinRadius, fRHi = (float)nMaxRadius;
+            long long fx, fy, nStepX, nStepY;
+            int k0, k1;
+
+            ClipRay(ox, dx, 0.0f, (float)nWidth, &fRLo, &fRHi);
+            ClipRay(oy, dy, fBandTop, fBandBottom, &fRLo, &fRHi);
+            if (fRLo > fRHi)
+                continue;
+
+            // 경계에서 반올림 차이로 빠지지 않도록 한 칸씩 넓히고 아래에서 다시 검사
+            k0 = (int)floorf((fRLo - nMinRadius) / HOUGH_CELL) - 1;
+            k1 = (int)ceilf((fRHi - nMinRadius) / HOUGH_CELL) + 1;
+            if (k0 < 0)
+                k0 = 0;
+            if (k1 > nSteps)
+                k1 = nSteps;
+
+            // 선분 위의 위치는 고정 소수점(HOUGH_FIX_BITS)으로 더해가면서 칸 번호는 시프트로 구함
+            fx = llrint(((double)ox + (nMinRadius + k0 * HOUGH_CELL) * (double)dx) * (1 << HOUGH_FIX_BITS));
+            fy = llrint(((double)oy + (nMinRadius + k0 * HOUGH_CELL) * (double)dy) * (1 << HOUGH_FIX_BITS)) - ((long long)nRow0 << (HOUGH_FIX_BITS + HOUGH_CELL_SHIFT));
+            nStepX = llrint(HOUGH_CELL * (double)dx * (1 << HOUGH_FIX_BITS));
+            nStepY = llrint(HOUGH_CELL * (double)dy * (1 << HOUGH_FIX_BITS));
+
+            for (int k = k0; k <= k1; k++, fx += nStepX, fy += nStepY)
+            {
+                long long cx = fx >> (HOUGH_FIX_BITS + HOUGH_CELL_SHIFT), cy = fy >> (HOUGH_FIX_BITS + HOUGH_CELL_SHIFT);
+                WORD *pCell;
+
+                if ((unsigned long long)cx >= (unsigned long long)nAccWidth || (unsigned long long)cy >= nBandRows)
+                    continue;
+
+                pCell = pBand + (size_t)cy * nAccWidth + cx;
+                if (*pCell != 0xFFFF) // 16비트 포화
+                    (*pCell)++;
+            }
+        }
+    }
+}
+
+/*
+ * @Function Name : ComparePeak
+ * @Description : 중심 후보를 투표 합이 큰 순서로 정렬합니다. (같으면 위, 왼쪽 먼저 - 스레드 수와 관계없이 같은 결과)
+ */
+static int ComparePeak(const void *a, const void *b)
+{
+    const HOUGH_PEAK *p = (const HOUGH_PEAK *)a, *q = (const HOUGH_PEAK *)b;
+
+    if (p->nScore != q->nScore)
+        return (p->nScore > q->nScore) ? -1 : 1;
+    if (p->y != q->y)
+        return (p->y < q->y) ? -1 : 1;
+    return (p->x > q->x) - (p->x < q->x);
+}
+
+/*
+ * @Function Name : CompareCircle
+ * @Description : 검출된 원을 반지름 검증 투표 수가 큰 순서로 정렬합니다. (같으면 위, 왼쪽 먼저)
+ */
+static int CompareCircle(const void *a, const void *b)
+{
+    const HOUGH_CIRCLE *p = (const HOUGH_CIRCLE *)a, *q = (const HOUGH_CIRCLE *)b;
+
+    if (p->nVotes != q->nVotes)
+        return (p->nVotes > q->nVotes) ? -1 : 1;
+    if (p->dY != q->dY)
+        return (p->dY < q->dY) ? -1 : 1;
+    return (p->dX > q->dX) - (p->dX < q->dX);
+}
+
+/*
+ * @Function Name : FindPeaks
+ * @Description : 누적 배열에서 3 X 3칸 합이 nMinVotes 이상인 극대점을 모읍니다.
+ * @Input : *pAcc, nAccWidth, nAccHeight, nMinVotes, *pSum - 작업 버퍼 (누적 배열 크기의 int)
+ * @Output : *pnPeaks, 반환값 중심 후보 배열 (malloc, 후보가 없어도 할당) / NULL (메모리 할당 오류)
+ */
+// 김광제의 설명 - 소벨 기울기 방향의 오차만큼 투표가 중심 주변 몇 칸으로 퍼지기 때문에 칸 하나가 아닌 3 X 3칸 합으로 비교한다.
+// 합이 같은 이웃이 있으면 앞(위, 왼쪽)에 있는 칸만 극대점으로 남김
+static HOUGH_PEAK *FindPeaks(const WORD *pAcc, int nAccWidth, int nAccHeight, int nMinVotes, int *pSum, int *pnPeaks)
+{
+    HOUGH_PEAK *pPeaks = NULL;
+    int nPeaks = 0, nCapacity = 64;
+
+    // 세로 3칸 합을 pSum 행에 만든 뒤 그 행 안에서 가로 3칸 합 (칸마다 9번 읽지 않고 분리해서 계산)
+#pragma omp parallel for schedule(static)
+    for (int y = 0; y < nAccHeight; y++)
+    {
+        const WORD *pUp = pAcc + (size_t)((y > 0) ? y - 1 : y) * nAccWidth;
+        const WORD *pMid = pAcc + (size_t)y * nAccWidth;
+        const WORD *pDown = pAcc + (size_t)((y < nAccHeight - 1) ? y + 1 : y) * nAccWidth;
+        int *pRow = pSum + (size_t)y * nAccWidth;
+        int nLeft = 0, nCenter;
+
+        for (int x = 0; x < nAccWidth; x++) // 가장자리 행은 바깥 행이 없으므로 가운데 행을 한번만 더함
+            pRow[x] = pMid[x] + ((y > 0) ? pUp[x] : 0) + ((y < nAccHeight - 1) ? pDown[x] : 0);
+
+        nCenter = pRow[0];
+        for (int x = 0; x < nAccWidth; x++)
+        {
+            int nRight = (x + 1 < nAccWidth) ? pRow[x + 1] : 0;
+
+            pRow[x] = nLeft + nCenter + nRight;
+            nLeft = nCenter;
+            nCenter = nRight;
+        }
+    }
+
+    pPeaks = (HOUGH_PEAK *)malloc(sizeof(HOUGH_PEAK) * nCapacity);
+    if (NULL == pPeaks)
+        return NULL;
+
+    for (int y = 0; y < nAccHeight; y++)
+    {
+        const int *pRow = pSum + (size_t)y * nAccWidth;
+
+        for (int x = 0; x < nAccWidth; x++)
+        {
+            int nScore = pRow[x], bPeak = 1;
+            double dW = 0.0, dX = 0.0, dY = 0.0;
+
+            if (nScore < nMinVotes || nScore == 0)
+                continue;
+
+            for (int j = -1; j <= 1 && bPeak; j++)
+                for (int i = -1; i <= 1; i++)
+                {
+                    int nx = x + i, ny = y + j, nNeighbor;
+
+                    if ((i == 0 && j == 0) || nx < 0 || ny < 0 || nx >= nAccWidth || ny >= nAccHeight)
+                        continue;
+                    nNeighbor = pSum[(size_t)ny * nAccWidth + nx];
+                    if (nNeighbor > nScore || (nNeighbor == nScore && (j < 0 || (j == 0 && i < 0))))
+                    {
+                        bPeak = 0;
+                        break;
+                    }
+                }
+            if (!bPeak)
+                continue;
+
+            if (nPeaks == nCapacity)
+            {
+                HOUGH_PEAK *pNew = (HOUGH_PEAK *)realloc(pPeaks, sizeof(HOUGH_PEAK) * nCapacity * 2);
+
+                if (NULL == pNew)
+                {
+                    free(pPeaks);
+                    return NULL;
+                }
+                pPeaks = pNew;
+                nCapacity *= 2;
+            }
+
+            // 3 X 3칸 가중 평균 (칸 중앙의 연속 좌표 (i + 0.5) * HOUGH_CELL -> 픽셀 번호는 0.5를 뺌)
+            for (int j = (y > 0) ? y - 1 : 0; j <= y + 1 && j < nAccHeight; j++)
+                for (int i = (x > 0) ? x - 1 : 0; i <= x + 1 && i < nAccWidth; i++)
+                {
+                    double w = pAcc[(size_t)j * nAccWidth + i];
+
+                    dW += w;
+                    dX += w * ((i + 0.5) * HOUGH_CELL - 0.5);
+                    dY += w * ((j + 0.5) * HOUGH_CELL - 0.5);
+                }
+
+            pPeaks[nPeaks].x = x;
+            pPeaks[nPeaks].y = y;
+            pPeaks[nPeaks].nScore = nScore;
+            pPeaks[nPeaks].dX = dX / dW;
+            pPeaks[nPeaks].dY = dY / dW;
+            nPeaks++;
+        }
+    }
+
+    *pnPeaks = nPeaks;
+    return pPeaks;
+}
+
+/*
+ * @Function Name : GatherEdges
+ * @Description : 중심 (dX, dY)에서 nMinRadius - HOUGH_GATHER_MARGIN ~ nMaxRadius + HOUGH_GATHER_MARGIN 거리에 있고 기울기가 대략 중심 방향인 에지를 모읍니다.
+ * @Input : *pEdges, *pRowStart, nHeight, dX, dY, nMinRadius, nMaxRadius
+ * @Output : *pNear, 반환값 모은 에지 개수
+ */
+// 김광제의 설명 - 행마다 x가 정렬되어 있으므로 이진 탐색으로 원을 둘러싼 사각형 안의 에지만 본다.
+// 반지름 검증은 중심을 몇 픽셀 옮기면서 반복하기 때문에 옮겨도 빠지지 않도록 여유(HOUGH_GATHER_MARGIN, HOUGH_GATHER_COS)를 두고 한번만 모음
+// 방향이 다른 에지(이웃한 원, 잡음)를 여기서 빼두면 반복하는 검증에서 보는 에지가 줄어듦
+static int GatherEdges(const HOUGH_EDGE *pEdges, const int *pRowStart, int nHeight, double dX, double dY, int nMinRadius, int nMaxRadius, HOUGH_EDGE *pNear)
+{
+    double dOuter = nMaxRadius + 1.5 + HOUGH_GATHER_MARGIN, dInner = nMinRadius - 1.5 - HOUGH_GATHER_MARGIN;
+    int y0 = (int)ceil(dY - dOuter), y1 = (int)floor(dY + dOuter);
+    int nLeft = (int)ceil(dX - dOuter), nRight = (int)floor(dX + dOuter);
+    int nNear = 0;
+
+    if (dInner < 0.0)
+        dInner = 0.0;
+    y0 = (y0 < 0) ? 0 : y0;
+    y1 = (y1 > nHeight - 1) ? nHeight - 1 : y1;
+
+    for (int y = y0; y <= y1; y++)
+    {
+        int lo = pRowStart[y], hi = pRowStart[y + 1];
+        double dy = y - dY;
+
+        while (lo < hi) // nLeft 이상인 첫 에지
+        {
+            int mid = (lo + hi) >> 1;
+
+            if (pEdges[mid].x < nLeft)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        for (int i = lo; i < pRowStart[y + 1] && pEdges[i].x <= nRight; i++)
+        {
+            double dx = pEdges[i].x - dX, d2 = dx * dx + dy * dy, dDot = dx * pEdges[i].ux + dy * pEdges[i].uy;
+
+            if (d2 >= dInner * dInner && d2 <= dOuter * dOuter && dDot * dDot >= (HOUGH_GATHER_COS * HOUGH_GATHER_COS) * d2)
+                pNear[nNear++] = pEdges[i];
+        }
+    }
+
+    return nNear;
+}
+
+/*
+ * @Function Name : IsOnCircle
+ * @Description : 에지가 중심 (dX, dY)에서 dLo 이상 dHi 미만 거리에 있고 기울기가 중심 방향(또는 반대)인지 검사합니다.
+ * @Input : *pEdge, dX, dY, dLo, dHi
+ * @Output : *pDist - 중심까지 거리, 반환값 1 (원 위의 에지) / 0
+ */
+static int IsOnCircle(const HOUGH_EDGE *pEdge, double dX, double dY, double dLo, double dHi, double *pDist)
+{
+    double dx = pEdge->x - dX, dy = pEdge->y - dY;
+    double d2 = dx * dx + dy * dy, dDot = dx * pEdge->ux + dy * pEdge->uy;
+
+    if (d2 < dLo * dLo || d2 >= dHi * dHi || dDot * dDot < (HOUGH_ALIGN_COS * HOUGH_ALIGN_COS) * d2) // |cos| 비교를 제곱으로 (sqrt는 원 위의 에지만)
+        return 0;
+    *pDist = sqrt(d2);
+    return 1;
+}
+
+/*
+ * @Function Name : RefineCenter
+ * @Description : (dX, dY)에서 dLo ~ dHi 거리에 있고 기울기가 중심 방향인 에지들로 중심을 다시 구합니다.
+ * @Input : *pEdges, nEdges, *pX, *pY, dLo, dHi
+ * @Output : *pX, *pY, 반환값 1 (구함) / 0 (에지 방향이 모두 평행해서 구할 수 없음)
+ */
+// 김광제의 설명 - 원 위의 에지는 기울기 방향 직선이 모두 중심을 지나므로 직선들까지 거리 제곱의 합이 최소인 점을 구한다. (2 X 2 연립방정식)
+// 반지름을 모르는 상태에서도 원 둘레 전체의 에지를 쓸 수 있어서 누적 배열 칸(2픽셀) 보다 정확해짐
+// 에지 고르는 기준을 직선까지 거리로 하면 중심 후보가 어긋난 방향의 에지만 빠져서 어긋난 쪽에 머무르므로 각도(IsOnCircle)로 고른다.
+// 몇 픽셀 어긋나도 반지름 방향 각도는 거의 변하지 않아서 둘레 전체가 대칭으로 들어감
+static int RefineCenter(const HOUGH_EDGE *pEdges, int nEdges, double *pX, double *pY, double dLo, double dHi)
+{
+    double dA = 0.0, dB = 0.0, dC = 0.0, dBx = 0.0, dBy = 0.0, dDet, d;
+
+    for (int i = 0; i < nEdges; i++)
+    {
+        double ux = pEdges[i].ux, uy = pEdges[i].uy;
+
+        if (!IsOnCircle(&pEdges[i], *pX, *pY, dLo, dHi, &d))
+            continue;
+
+        dA += 1.0 - ux * ux;
+        dB -= ux * uy;
+        dC += 1.0 - uy * uy;
+        dBx += (1.0 - ux * ux) * pEdges[i].x - ux * uy * pEdges[i].y;
+        dBy += (1.0 - uy * uy) * pEdges[i].y - ux * uy * pEdges[i].x;
+    }
+
+    dDet = dA * dC - dB * dB;
+    if (dDet <= 1e-6 * (dA + dC) * (dA + dC))
+        return 0;
+
+    *pX = (dC * dBx - dB * dBy) / dDet;
+    *pY = (dA * dBy - dB * dBx) / dDet;
+    return 1;
+}
+
+/*
+ * @Function Name : EstimateRadius
+ * @Description : 중심 후보 (dX, dY) 주변의 에지로 중심, 반지름, 둘레 비율을 구합니다.
+ * @Input : *pEdges, nEdges - 중심 후보 주변 에지 (GatherEdges), dX, dY, nMinRadius, nMaxRadius, *pHist, *pSumD - 작업 버퍼 (nMaxRadius + 2개)
+ * @Output : *pCircle
+ */
+// 김광제의 설명 - 1. 중심 후보는 기울기 방향 오차만큼 (반지름 100에서 5픽셀 정도) 어긋나므로 RefineCenter를 몇 번 반복한다.
+// 2. 중심에서 에지까지 거리를 1픽셀 단위 히스토그램으로 모아서 연속한 3칸의 합이 가장 큰 곳을 반지름으로 하고, 그 3칸 거리의 평균으로 소수점까지 구한다.
+//    이진 영상의 에지는 경계 양쪽 2픽셀이라서 3칸이면 충분함. 맞닿은 동전의 에지는 기울기가 중심 방향이 아니라서 대부분 빠짐
+// 3. 둘레 비율은 그 반지름의 에지가 있는 각도 구간의 비율이라서 에지 두께와 관계없고, 동전 사이 빈 곳에 생기는 가짜 원(여러 동전의 호가 조금씩)은 낮게 나온다.
+static void EstimateRadius(const HOUGH_EDGE *pEdges, int nEdges, double dX, double dY, int nMinRadius, int nMaxRadius, int *pHist, double *pSumD, HOUGH_CIRCLE *pCircle)
+{
+    int nBest = -1, nBestVotes = 0;
+    double d;
+
+    for (int nPass = 0; nPass < HOUGH_REFINE_PASSES; nPass++)
+        if (!RefineCenter(pEdges, nEdges, &dX, &dY, nMinRadius - 1.5, nMaxRadius + 1.5))
+            break;
+
+    memset(pHist, 0, sizeof(int) * (nMaxRadius + 2));
+    memset(pSumD, 0, sizeof(double) * (nMaxRadius + 2));
+    for (int i = 0; i < nEdges; i++)
+    {
+        if (IsOnCircle(&pEdges[i], dX, dY, nMinRadius - 0.5, nMaxRadius + 0.5, &d))
+        {
+            int b = (int)(d + 0.5);
+
+            pHist[b]++;
+            pSumD[b] += d;
+        }
+    }
+
+    for (int r = nMinRadius; r <= nMaxRadius; r++)
+    {
+        int nVotes = pHist[r] + pHist[r + 1] + ((r > nMinRadius) ? pHist[r - 1] : 0);
+
+        if (nVotes > nBestVotes)
+        {
+            nBestVotes = nVotes;
+            nBest = r;
+        }
+    }
+
+    pCircle->dX = dX;
+    pCircle->dY = dY;
+    pCircle->nVotes = nBestVotes;
+    pCircle->dRadius = 0.0;
+    pCircle->dCoverage = 0.0;
+    if (nBest >= 0)
+    {
+        int nBins = (int)(2.0 * M_PI * nBest); // 둘레가 짧은 원은 픽셀 수만큼만 나눔
+        unsigned long long nMask = 0;
+        int nHit = 0;
+
+        if (nBins > HOUGH_ANGLE_BINS)
+            nBins = HOUGH_ANGLE_BINS;
+        pCircle->dRadius = (pSumD[nBest] + pSumD[nBest + 1] + ((nBest > nMinRadius) ? pSumD[nBest - 1] : 0.0)) / nBestVotes;
+
+        // 고른 3칸에 들어간 에지의 각도 구간 표시
+        for (int i = 0; i < nEdges; i++)
+        {
+            if (IsOnCircle(&pEdges[i], dX, dY, nBest - 1.5, nBest + 1.5, &d))
+            {
+                int nBin = (int)((atan2(pEdges[i].y - dY, pEdges[i].x - dX) + M_PI) * nBins / (2.0 * M_PI));
+
+                nMask |= 1ULL << ((nBin < nBins) ? nBin : nBins - 1);
+            }
+        }
+        for (int b = 0; b < nBins; b++)
+            nHit += (int)((nMask >> b) & 1);
+        pCircle->dCoverage = (double)nHit / nBins;
+    }
+}
+
+/*
+ * @Function Name : GridInit
+ * @Description : nWidth X nHeight 영상의 중심을 dMinDist 크기 칸으로 나누는 격자를 만듭니다.
+ * @Input : nWidth, nHeight, dMinDist (1 이상), nMaxCount - 넣을 수 있는 최대 중심 개수
+ * @Output : *pGrid, 반환값 0 (성공) / -1 (메모리 할당 오류)
+ */
+static int GridInit(HOUGH_GRID *pGrid, int nWidth, int nHeight, double dMinDist, int nMaxCount)
+{
+    pGrid->nCols = (int)(nWidth / dMinDist) + 1;
+    pGrid->nRows = (int)(nHeight / dMinDist) + 1;
+    pGrid->nCount = 0;
+    pGrid->dMinDist = dMinDist;
+    pGrid->pHead = (int *)malloc(sizeof(int) * pGrid->nCols * pGrid->nRows);
+    pGrid->pNext = (int *)malloc(sizeof(int) * (nMaxCount + 1));
+    pGrid->pXY = (double *)malloc(sizeof(double) * 2 * (nMaxCount + 1));
+    if (NULL == pGrid->pHead || NULL == pGrid->pNext || NULL == pGrid->pXY)
+    {
+        free(pGrid->pHead);
+        free(pGrid->pNext);
+        free(pGrid->pXY);
+        return (-1);
+    }
+    memset(pGrid->pHead, 0xFF, sizeof(int) * pGrid->nCols * pGrid->nRows); // -1
+    return 0;
+}
+
+static void GridFree(HOUGH_GRID *pGrid)
+{
+    free(pGrid->pHead);
+    free(pGrid->pNext);
+    free(pGrid->pXY);
+}
+
+/*
+ * @Function Name : GridAddIfFar
+ * @Description : 이미 넣은 중심과 모두 dMinDist 이상 떨어져 있으면 (dX, dY)를 격자에 넣습니다.
+ * @Input : *pGrid, dX, dY
+ * @Output : 반환값 1 (넣음) / 0 (가까운 중심이 있음)
+ */
+// 김광제의 설명 - 칸 크기가 dMinDist라서 dMinDist 안의 중심은 주변 3 X 3칸에만 있다. (고른 중심 전체와 비교하면 후보가 많은 영상에서 후보 수의 제곱)
+// 다시 구한 중심은 영상 밖으로 조금 나갈 수 있으므로 칸 번호는 격자 안으로 자름
+static int GridAddIfFar(HOUGH_GRID *pGrid, double dX, double dY)
+{
+    int cx = (int)floor(dX / pGrid->dMinDist), cy = (int)floor(dY / pGrid->dMinDist);
+    double dMin2 = pGrid->dMinDist * pGrid->dMinDist;
+
+    cx = (cx < 0) ? 0 : ((cx >= pGrid->nCols) ? pGrid->nCols - 1 : cx);
+    cy = (cy < 0) ? 0 : ((cy >= pGrid->nRows) ? pGrid->nRows - 1 : cy);
+
+    for (int j = cy - 1; j <= cy + 1; j++)
+        for (int i = cx - 1; i <= cx + 1; i++)
+        {
+            if (i < 0 || j < 0 || i >= pGrid->nCols || j >= pGrid->nRows)
+                continue;
+            for (int k = pGrid->pHead[j * pGrid->nCols + i]; k >= 0; k = pGrid->pNext[k])
+            {
+                double dx = dX - pGrid->pXY[2 * k], dy = dY - pGrid->pXY[2 * k + 1];
+
+                if (dx * dx + dy * dy < dMin2)
+                    return 0;
+            }
+        }
+
+    pGrid->pXY[2 * pGrid->nCount] = dX;
+    pGrid->pXY[2 * pGrid->nCount + 1] = dY;
+    pGrid->pNext[pGrid->nCount] = pGrid->pHead[cy * pGrid->nCols + cx];
+    pGrid->pHead[cy * pGrid->nCols + cx] = pGrid->nCount++;
+    return 1;
+}
+
+/*
+ * @Function Name : DetectCircles
+ * @Description : 투표가 끝난 누적 배열에서 원을 고르고 반지름을 구합니다. (ImgHoughCircles의 3, 4단계)
+ * @Input : *pAcc, nAccWidth, nAccHeight, *pSum - 작업 버퍼, *pEdges, *pRowStart, nHeight, nMinRadius, nMaxRadius,
+ *          nMinVotes - 중심 후보의 최소 투표 합, dMinCoverage, nMaxCircles
+ * @Output : *pCircles, 반환값 찾은 원의 개수 / -1 (메모리 할당 오류)
+ */
+static int DetectCircles(const WORD *pAcc, int nAccWidth, int nAccHeight, int *pSum, const HOUGH_EDGE *pEdges, const int *pRowStart, int nHeight,
+                         int nMinRadius, int nMaxRadius, int nMinVotes, double dMinCoverage, HOUGH_CIRCLE *pCircles, int nMaxCircles)
+{
+    int nMinDist = (nMinRadius > 2 * HOUGH_CELL) ? nMinRadius : 2 * HOUGH_CELL;
+    int nPeaks = 0, nKept = 0, nFound = 0, nFailed = 0;
+    long long nBox = 2LL * (nMaxRadius + 2 + HOUGH_GATHER_MARGIN) + 1;
+    int nNearMax = (nBox * nBox < pRowStart[nHeight]) ? (int)(nBox * nBox) : pRowStart[nHeight] + 1; // GatherEdges 최대 개수
+    HOUGH_PEAK *pPeaks;
+    HOUGH_CIRCLE *pFound;
+    HOUGH_GRID Grid;
+
+    pPeaks = FindPeaks(pAcc, nAccWidth, nAccHeight, nMinVotes, pSum, &nPeaks);
+    if (NULL == pPeaks)
+        return (-1);
+    PROFILE_COUNT("hough_peaks", nPeaks);
+
+    // 투표 합이 큰 순서로 보면서 이미 고른 중심과 가까운 후보는 버림
+    qsort(pPeaks, nPeaks, sizeof(HOUGH_PEAK), ComparePeak);
+    if (GridInit(&Grid, nAccWidth << HOUGH_CELL_SHIFT, nAccHeight << HOUGH_CELL_SHIFT, nMinDist, nPeaks) != 0)
+    {
+        free(pPeaks);
+        return (-1);
+    }
+    for (int i = 0; i < nPeaks; i++)
+        if (GridAddIfFar(&Grid, pPeaks[i].dX, pPeaks[i].dY))
+            pPeaks[nKept++] = pPeaks[i];
+
+    pFound = (HOUGH_CIRCLE *)malloc(sizeof(HOUGH_CIRCLE) * (nKept + 1));
+    if (NULL == pFound)
+    {
+        GridFree(&Grid);
+        free(pPeaks);
+        return (-1);
+    }
+
+    // 반지름 검증 (중심마다 독립 -> 병렬, 스레드마다 히스토그램, 주변 에지 버퍼)
+#pragma omp parallel reduction(+ : nFailed)
+    {
+        int *pHist = (int *)malloc(sizeof(int) * (nMaxRadius + 2));
+        double *pSumD = (double *)malloc(sizeof(double) * (nMaxRadius + 2));
+        HOUGH_EDGE *pNear = (HOUGH_EDGE *)malloc(sizeof(HOUGH_EDGE) * nNearMax);
+
+        if (NULL == pHist || NULL == pSumD || NULL == pNear)
+            nFailed++;
+
+#pragma omp for schedule(dynamic, 4)
+        for (int i = 0; i < nKept; i++)
+        {
+            int nNear;
+
+            if (NULL == pHist || NULL == pSumD || NULL == pNear)
+                continue;
+            nNear = GatherEdges(pEdges, pRowStart, nHeight, pPeaks[i].dX, pPeaks[i].dY, nMinRadius, nMaxRadius, pNear);
+            EstimateRadius(pNear, nNear, pPeaks[i].dX, pPeaks[i].dY, nMinRadius, nMaxRadius, pHist, pSumD, &pFound[i]);
+        }
+
+        free(pHist);
+        free(pSumD);
+        free(pNear);
+    }
+    free(pPeaks);
+
+    if (nFailed != 0)
+    {
+        GridFree(&Grid);
+        free(pFound);
+        return (-1);
+    }
+
+    for (int i = 0; i < nKept; i++)
+        if (pFound[i].nVotes > 0 && pFound[i].dCoverage >= dMinCoverage)
+            pFound[nFound++] = pFound[i];
+    qsort(pFound, nFound, sizeof(HOUGH_CIRCLE), CompareCircle);
+
+    // 다시 구한 중심은 같은 원으로 모일 수 있으므로 한번 더 가까운 원을 버림 (격자는 비우고 다시 사용)
+    memset(Grid.pHead, 0xFF, sizeof(int) * Grid.nCols * Grid.nRows);
+    Grid.nCount = 0;
+    nKept = 0;
+    for (int i = 0; i < nFound; i++)
+        if (GridAddIfFar(&Grid, pFound[i].dX, pFound[i].dY))
+            pFound[nKept++] = pFound[i];
+    nFound = nKept;
+    GridFree(&Grid);
+
+    if (nFound > nMaxCircles)
+        nFound = nMaxCircles;
+    if (nFound > 0)
+        memcpy(pCircles, pFound, sizeof(HOUGH_CIRCLE) * nFound);
+
+    free(pFound);
+    return nFound;
+}
+
+/*
+ * @Function Name : ImgHoughCircles
+ * @Description : 8비트 그레이 영상(ROI 가능)에서 반지름이 nMinRadius ~ nMaxRadius인 원을 찾습니다.
+ * @Input : *pIn, nMinRadius, nMaxRadius, nEdgeThreshold - 소벨 출력 단위의 에지 임계값 (이진 영상은 255 이하, 보통 50 ~ 100),
+ *          dMinCoverage - 원으로 인정할 최소 둘레 비율 (0 ~ 1, 맞닿은 동전은 0.5 정도), nMaxCircles
+ * @Output : *pCircles - 투표 수가 큰 순서 (최대 nMaxCircles개), 반환값 저장한 원의 개수 / -1 (입력 오류, 메모리 할당 오류)
+ */
+// 김광제의 설명 - 1. 소벨 기울기가 큰 픽셀을 모은다.
+// 2. 에지마다 기울기 방향 선분 위의 중심 후보에 투표한다. 누적 배열은 2 X 2 픽셀을 한 칸, 16비트로 해서 영상 크기의 절반 바이트이고
+//    HOUGH_BAND_ROWS 행씩 띠로 나눠서 스레드마다 자기 띠만 쓰므로 띠가 캐시에 머물고 스레드별 배열을 합치는 과정이 없다.
+// 3. 3 X 3칸 합의 극대점을 투표 순서로 보면서 이미 고른 중심과 nMinRadius보다 가까운 후보는 버린다. (맞닿은 동전의 중심 거리는 2r 이상)
+//    중심 후보의 최소 투표 합은 nMinRadius 원의 둘레 x dMinCoverage (경계 양쪽 2픽셀이 에지라서 둘레 한 픽셀에 2표 정도, 3 X 3칸 밖에 떨어지는 투표 감안해서 절반)
+// 4. 남은 중심마다 반지름을 구하고 둘레 비율이 dMinCoverage 이상인 것만 원으로 남긴다.
+// 중심이 영상 밖에 있는 원(가장자리에 걸친 동전)은 찾지 않는다.
+int ImgHoughCircles(const IMAGE *pIn, int nMinRadius, int nMaxRadius, int nEdgeThreshold, double dMinCoverage, HOUGH_CIRCLE *pCircles, int nMaxCircles)
+{
+    int nWidth = pIn->nWidth, nHeight = pIn->nHeight;
+    int nAccWidth = (nWidth + HOUGH_CELL - 1) >> HOUGH_CELL_SHIFT, nAccHeight = (nHeight + HOUGH_CELL - 1) >> HOUGH_CELL_SHIFT;
+    size_t nAccSize = (size_t)nAccWidth * nAccHeight;
+    int nBands = (nAccHeight + HOUGH_BAND_ROWS - 1) / HOUGH_BAND_ROWS;
+    int *pRowStart, *pSum;
+    HOUGH_EDGE *pEdges = NULL;
+    WORD *pAcc;
+    int nMinVotes = (int)ceil(2.0 * M_PI * nMinRadius * dMinCoverage);
+    int nEdges, nRet = -1;
+    PROFILE_BEGIN(dStart);
+
+    if (pIn->nFormat != PIXEL_GRAY8 || nMinRadius < 1 || nMaxRadius < nMinRadius || nMaxRadius > 0x7FFF || !(dMinCoverage >= 0.0 && dMinCoverage <= 1.0) || nMaxCircles < 0 ||
+        (NULL == pCircles && nMaxCircles > 0))
+        return (-1);
+    if (nWidth < 5 || nHeight < 5)
+        return 0;
+
+    // 1. 에지
+    pRowStart = (int *)PoolAlloc(GetThreadPool(), sizeof(int) * (nHeight + 1), 0);
+    if (NULL == pRowStart)
+        return (-1);
+    nEdges = CollectEdges(pIn, nEdgeThreshold, pRowStart, &pEdges);
+    if (nEdges < 0)
+    {
+        PoolFree(GetThreadPool(), pRowStart);
+        return (-1);
+    }
+    PROFILE_COUNT("hough_edges", nEdges);
+
+    pAcc = (WORD *)PoolAlloc(GetThreadPool(), nAccSize * sizeof(WORD), 0);
+    pSum = (int *)PoolAlloc(GetThreadPool(), nAccSize * sizeof(int), 0);
+    if (NULL != pAcc && NULL != pSum)
+    {
+        // 2. 행 띠 단위 투표 (띠에 닿을 수 있는 에지는 띠 위, 아래로 nMaxRadius 안의 행이라서 pRowStart로 바로 꺼냄)
+#pragma omp parallel for schedule(dynamic, 1)
+        for (int b = 0; b < nBands; b++)
+        {
+            int nRow0 = b * HOUGH_BAND_ROWS, nRow1 = (nRow0 + HOUGH_BAND_ROWS < nAccHeight) ? nRow0 + HOUGH_BAND_ROWS : nAccHeight;
+            int y0 = (nRow0 << HOUGH_CELL_SHIFT) - nMaxRadius - 1, y1 = (nRow1 << HOUGH_CELL_SHIFT) + nMaxRadius + 1;
+            WORD *pBand = pAcc + (size_t)nRow0 * nAccWidth;
+
+            if (y0 < 0)
+                y0 = 0;
+            if (y1 > nHeight)
+                y1 = nHeight;
+
+            memset(pBand, 0, sizeof(WORD) * (size_t)(nRow1 - nRow0) * nAccWidth);
+            VoteBand(pEdges, pRowStart[y0], pRowStart[y1], nMinRadius, nMaxRadius, nWidth, nHeight, nAccWidth, nRow0, nRow1, pBand);
+        }
+
+        // 3, 4. 중심 후보, 반지름 검증
+        nRet = DetectCircles(pAcc, nAccWidth, nAccHeight, pSum, pEdges, pRowStart, nHeight, nMinRadius, nMaxRadius, nMinVotes, dMinCoverage, pCircles, nMaxCircles);
+    }
+
+    PoolFree(GetThreadPool(), pSum);
+    PoolFree(GetThreadPool(), pAcc);
+    PoolFree(GetThreadPool(), pEdges);
+    PoolFree(GetThreadPool(), pRowStart);
+    PROFILE_END(dStart, "hough_circles", (long long)nWidth * nHeight, (long long)nWidth * nHeight * 2 + (long long)nAccSize * (sizeof(WORD) + sizeof(int)));
+    return nRet;
+}
+
+/*
+ * @Function Name : RowLinePoints
+ * @Description : y행의 에지 점을 찾습니다. (pPoints가 NULL이면 개수만 셈)
+ * @Input : *pIn, y, nLimit - 소벨 기울기 크기 제곱의 최소값 (0이면 값이 0인 픽셀이 에지 점)
+ * @Output : *pPoints, 반환값 y행 에지 점 개수
+ */
+// 김광제의 설명 - nLimit이 0이면 입력을 DetectObjectEdge 결과(경계 0, 나머지 255)처럼 이미 만든 에지 영상으로 보고 0인 픽셀을 그대로 쓴다.
+// 그 외에는 3 X 3 소벨 X, Y를 바로 계산해서 크기로 고름 (가장자리 1픽셀은 소벨을 계산할 수 없으므로 제외)
+static int RowLinePoints(const IMAGE *pIn, int y, int nLimit, HOUGH_POINT *pPoints)
+{
+    int nWidth = pIn->nWidth, nHeight = pIn->nHeight, nCount = 0;
+    const BYTE *p1 = pIn->pPlane[0] + (size_t)y * pIn->nStride;
+
+    if (nLimit == 0)
+    {
+        for (int x = 0; x < nWidth; x++)
+        {
+            if (p1[x] != 0)
+                continue;
+            if (NULL != pPoints)
+            {
+                pPoints[nCount].x = (WORD)x;
+                pPoints[nCount].y = (WORD)y;
+            }
+            nCount++;
+        }
+        return nCount;
+    }
+
+    if (y < 1 || y >= nHeight - 1)
+        return 0;
+
+    for (int x = 1; x < nWidth - 1; x++)
+    {
+        const BYTE *p0 = p1 - pIn->nStride, *p2 = p1 + pIn->nStride;
+        int gx = (p0[x + 1] + 2 * p1[x + 1] + p2[x + 1]) - (p0[x - 1] + 2 * p1[x - 1] + p2[x - 1]);
+        int gy = (p2[x - 1] + 2 * p2[x] + p2[x + 1]) - (p0[x - 1] + 2 * p0[x] + p0[x + 1]);
+
+        if (gx * gx + gy * gy < nLimit)
+            continue;
+        if (NULL != pPoints)
+        {
+            pPoints[nCount].x = (WORD)x;
+            pPoints[nCount].y = (WORD)y;
+        }
+        nCount++;
+    }
+    return nCount;
+}
+
+/*
+ * @Function Name : CollectLinePoints
+ * @Description : 에지 점을 행 순서로 모읍니다.
+ * @Input : *pIn, nEdgeThreshold - 소벨 출력 단위의 임계값 (0이면 값이 0인 픽셀)
+ * @Output : **ppPoints - 에지 점 배열 (PoolAlloc), 반환값 에지 점 개수 / -1 (메모리 할당 오류)
+ */
+// 김광제의 설명 - 행마다 개수를 먼저 세고 누적합으로 자리를 정한 뒤 한번 더 채운다. (두 번 모두 행 단위 병렬, 결과는 스레드 수와 관계없이 행 순서)
+// 에지 점은 x, y 16비트 두 개(4바이트)라서 투표할 때 영상 전체를 다시 읽지 않고 작은 목록만 반복해서 읽음
+static int CollectLinePoints(const IMAGE *pIn, int nEdgeThreshold, HOUGH_POINT **ppPoints)
+{
+    int nHeight = pIn->nHeight, nPoints;
+    int nLimit = 16 * nEdgeThreshold * nEdgeThreshold; // 소벨 출력 |g| / 4
+    int *pRowStart = (int *)PoolAlloc(GetThreadPool(), sizeof(int) * (nHeight + 1), 0);
+    HOUGH_POINT *pPoints;
+
+    if (NULL == pRowStart)
+        return (-1);
+    if (nEdgeThreshold > 400)
+        nLimit = INT_MAX; // |g| / 4 <= 255 x sqrt(2)
+
+    pRowStart[0] = 0;
+#pragma omp parallel for schedule(static)
+    for (int y = 0; y < nHeight; y++)
+        pRowStart[y + 1] = RowLinePoints(pIn, y, nLimit, NULL);
+    for (int y = 0; y < nHeight; y++)
+        pRowStart[y + 1] += pRowStart[y];
+
+    nPoints = pRowStart[nHeight];
+    pPoints = (HOUGH_POINT *)PoolAlloc(GetThreadPool(), sizeof(HOUGH_POINT) * (nPoints + 1), 0);
+    if (NULL != pPoints)
+    {
+#pragma omp parallel for schedule(static)
+        for (int y = 0; y < nHeight; y++)
+            RowLinePoints(pIn, y, nLimit, pPoints + pRowStart[y]);
+    }
+
+    PoolFree(GetThreadPool(), pRowStart);
+    if (NULL == pPoints)
+        return (-1);
+    *ppPoints = pPoints;
+    return nPoints;
+}
+
+/*
+ * @Function Name : LineRho
+ * @Description : 에지 점 (x, y)가 각도 구간 하나에서 투표할 거리 칸 번호를 구합니다.
+ * @Input : x, y, nCos, nSin - 고정 소수점 cos, sin (HOUGH_TRIG_BITS), nRhoOffset - 거리 0의 칸 번호
+ */
+static int LineRho(int x, int y, int nCos, int nSin, int nRhoOffset)
+{
+    return (int)(((long long)x * nCos + (long long)y * nSin + (1 << (HOUGH_TRIG_BITS - 1))) >> HOUGH_TRIG_BITS) + nRhoOffset;
+}
+
+/*
+ * @Function Name : VoteLinePoint
+ * @Description : 에지 점 하나를 모든 각도에 투표하거나 (nDelta 1) 투표를 취소합니다. (nDelta -1)
+ * @Input : *pAcc, nRhoBins, nRhoOffset, *pCos, *pSin, x, y, nDelta
+ * @Output : *pBestTheta - 투표 후 가장 큰 칸의 각도 구간, 반환값 그 칸의 투표 수
+ */
+static int VoteLinePoint(int *pAcc, int nRhoBins, int nRhoOffset, const int *pCos, const int *pSin, int x, int y, int nDelta, int *pBestTheta)
+{
+    int nBest = INT_MIN;
+
+    for (int t = 0; t < HOUGH_THETA_BINS; t++)
+    {
+        int *pCell = pAcc + (size_t)t * nRhoBins + LineRho(x, y, pCos[t], pSin[t], nRhoOffset);
+
+        *pCell += nDelta;
+        if (*pCell > nBest)
+        {
+            nBest = *pCell;
+            *pBestTheta = t;
+        }
+    }
+    return nBest;
+}
+
+/*
+ * @Function Name : LineVotesAt
+ * @Description : 누적 배열 (t, r) 칸의 투표 수를 구합니다. (각도가 0 ~ 180도 밖이면 반대쪽 끝 각도, 거리 부호를 바꾼 칸)
+ * @Input : *pAcc, nRhoBins, t, r
+ * @Output : 반환값 투표 수 (거리가 범위 밖이면 -1), *pIndex - 칸 번호
+ */
+// 김광제의 설명 - theta와 theta + 180도는 rho의 부호만 다른 같은 직선이라서 0도 근처의 극대점은 179도 근처와도 비교해야 한다.
+static int LineVotesAt(const int *pAcc, int nRhoBins, int t, int r, int *pIndex)
+{
+    if (t < 0 || t >= HOUGH_THETA_BINS)
+    {
+        t = (t + HOUGH_THETA_BINS) % HOUGH_THETA_BINS;
+        r = nRhoBins - 1 - r;
+    }
+    if (r < 0 || r >= nRhoBins)
+        return (-1);
+    *pIndex = t * nRhoBins + r;
+    return pAcc[*pIndex];
+}
+
+/*
+ * @Function Name : CompareLine
+ * @Description : 직선을 투표 수가 큰 순서로 정렬합니다. (같으면 각도, 거리 순서 - 스레드 수와 관계없이 같은 결과)
+ */
+static int CompareLine(const void *a, const void *b)
+{
+    const HOUGH_LINE *p = (const HOUGH_LINE *)a, *q = (const HOUGH_LINE *)b;
+
+    if (p->nVotes != q->nVotes)
+        return (p->nVotes > q->nVotes) ? -1 : 1;
+    if (p->dTheta != q->dTheta)
+        return (p->dTheta < q->dTheta) ? -1 : 1;
+    return (p->dRho > q->dRho) - (p->dRho < q->dRho);
+}
+
+/*
+ * @Function Name : FindLinePeaks
+ * @Description : 누적 배열에서 투표 수가 nMinVotes 이상이고 +-HOUGH_LINE_NMS칸 안에서 가장 큰 칸을 모읍니다.
+ * @Input : *pAcc, nRhoBins, nRhoOffset, nMinVotes
+ * @Output : *pnPeaks, 반환값 직선 배열 (malloc, dRho, dTheta, nVotes만 채움) / NULL (메모리 할당 오류)
+ */
+// 김광제의 설명 - 두께가 있는 선이나 선 양쪽 경계는 가까운 각도, 거리 여러 칸에 투표가 몰리므로 주변 칸보다 큰 칸 하나만 남긴다.
+// 투표 수가 같으면 칸 번호가 작은 쪽을 남김
+static HOUGH_LINE *FindLinePeaks(const int *pAcc, int nRhoBins, int nRhoOffset, int nMinVotes, int *pnPeaks)
+{
+    int nPeaks = 0, nCapacity = 64;
+    HOUGH_LINE *pPeaks = (HOUGH_LINE *)malloc(sizeof(HOUGH_LINE) * nCapacity);
+
+    if (NULL == pPeaks)
+        return NULL;
+
+    for (int t = 0; t < HOUGH_THETA_BINS; t++)
+    {
+        for (int r = 0; r < nRhoBins; r++)
+        {
+            int nIndex = t * nRhoBins + r, nVotes = pAcc[nIndex], bPeak = 1;
+
+            if (nVotes < nMinVotes)
+                continue;
+
+            for (int dt = -HOUGH_LINE_NMS; dt <= HOUGH_LINE_NMS && bPeak; dt++)
+                for (int dr = -HOUGH_LINE_NMS; dr <= HOUGH_LINE_NMS; dr++)
+                {
+                    int nOther = 0, nNeighbor = LineVotesAt(pAcc, nRhoBins, t + dt, r + dr, &nOther);
+
+                    if (nNeighbor > nVotes || (nNeighbor == nVotes && nOther < nIndex))
+                    {
+                        bPeak = 0;
+                        break;
+                    }
+                }
+            if (!bPeak)
+                continue;
+
+            if (nPeaks == nCapacity)
+            {
+                HOUGH_LINE *pNew = (HOUGH_LINE *)realloc(pPeaks, sizeof(HOUGH_LINE) * nCapacity * 2);
+
+                if (NULL == pNew)
+                {
+                    free(pPeaks);
+                    return NULL;
+                }
+                pPeaks = pNew;
+                nCapacity *= 2;
+            }
+            memset(&pPeaks[nPeaks], 0, sizeof(HOUGH_LINE));
+            pPeaks[nPeaks].dRho = r - nRhoOffset;
+            pPeaks[nPeaks].dTheta = t * M_PI / HOUGH_THETA_BINS;
+            pPeaks[nPeaks].nVotes = nVotes;
+            nPeaks++;
+        }
+    }
+
+    *pnPeaks = nPeaks;
+    return pPeaks;
+}
+
+/*
+ * @Function Name : GatherLinePoints
+ * @Description : 직선 (dRho, dTheta)에서 dBand 안에 있고 다른 직선에 속하지 않은 에지 점을 모읍니다.
+ * @Input : *pMask - 남은 에지 점 표시 (1비트, 행마다 (nWidth + 7) / 8 바이트, 찾은 직선의 점은 지움), nWidth, nHeight, dRho, dTheta, dBand
+ * @Output : *pOut, 반환값 모은 점 개수
+ */
+// 김광제의 설명 - 행마다 직선이 지나가는 x 범위(띠 폭 / |cos| 픽셀)만 표시 영상에서 읽는다.
+// 후보 직선마다 영상 높이만큼 다른 행을 읽으므로 표시는 픽셀당 1비트 (4096 X 4096도 2MB라서 캐시에 가깝게 남음)
+// 직선 하나에 에지 점 전체를 보지 않고 직선이 지나는 행 수 x 띠 폭만 봄 (가로에 가까운 직선은 행이 적고 범위가 넓음)
+static int GatherLinePoints(const BYTE *pMask, int nWidth, int nHeight, double dRho, double dTheta, double dBand, HOUGH_POINT *pOut)
+{
+    double c = cos(dTheta), s = sin(dTheta);
+    int nCount = 0, nTop = 0, nBottom = nHeight - 1;
+
+    if (fabs(s) > 1e-9) // 직선이 영상 안(x 0 ~ nWidth - 1)을 지나는 행만
+    {
+        double y0 = (dRho - dBand) / s, y1 = (dRho + dBand) / s, y2 = (dRho - (nWidth - 1) * c - dBand) / s, y3 = (dRho - (nWidth - 1) * c + dBand) / s;
+        double dTop = fmin(fmin(y0, y1), fmin(y2, y3)), dBottom = fmax(fmax(y0, y1), fmax(y2, y3));
+
+        if (dBottom < 0.0 || dTop > nHeight - 1)
+            return 0;
+        nTop = (dTop < 0.0) ? 0 : (int)ceil(dTop);
+        nBottom = (dBottom > nHeight - 1) ? nHeight - 1 : (int)floor(dBottom);
+    }
+
+    for (int y = nTop; y <= nBottom; y++)
+    {
+        double dLeft = dRho - y * s - dBand, dRight = dRho - y * s + dBand; // x cos 범위
+        const BYTE *pRow = pMask + (size_t)y * ((nWidth + 7) >> 3);
+        int nLeft, nRight;
+
+        if (fabs(c) < 1e-9) // 가로 직선 : 행 전체가 들어가거나 모두 빠짐
+        {
+            if (dLeft > 0.0 || dRight < 0.0)
+                continue;
+            nLeft = 0;
+            nRight = nWidth - 1;
+        }
+        else
+        {
+            double x0 = dLeft / c, x1 = dRight / c;
+
+            if (x0 > x1)
+            {
+                double dTemp = x0;
+                x0 = x1;
+                x1 = dTemp;
+            }
+            if (x1 < 0.0 || x0 > nWidth - 1)
+                continue;
+            nLeft = (x0 < 0.0) ? 0 : (int)ceil(x0);
+            nRight = (x1 > nWidth - 1) ? nWidth - 1 : (int)floor(x1);
+        }
+
+        for (int x = nLeft; x <= nRight; x++)
+            if (pRow[x >> 3] & (1 << (x & 7)))
+            {
+                pOut[nCount].x = (WORD)x;
+                pOut[nCount].y = (WORD)y;
+                nCount++;
+            }
+    }
+
+    return nCount;
+}
+
+/*
+ * @Function Name : FitLine
+ * @Description : 점들에 가장 가까운 직선(점에서 직선까지 수직 거리 제곱의 합이 최소)을 구합니다.
+ * @Input : *pPoints, nCount (2 이상)
+ * @Output : *pRho, *pTheta (0 ~ pi)
+ */
+// 김광제의 설명 - 누적 배열 칸은 1도, 1픽셀 단위라서 긴 직선은 끝에서 몇 픽셀 어긋난다. 점들의 공분산에서 퍼짐이 가장 작은 방향이 법선
+static void FitLine(const HOUGH_POINT *pPoints, int nCount, double *pRho, double *pTheta)
+{
+    double mx = 0.0, my = 0.0, sxx = 0.0, sxy = 0.0, syy = 0.0, dTheta;
+
+    for (int i = 0; i < nCount; i++)
+    {
+        mx += pPoints[i].x;
+        my += pPoints[i].y;
+    }
+    mx /= nCount;
+    my /= nCount;
+    for (int i = 0; i < nCount; i++)
+    {
+        double dx = pPoints[i].x - mx, dy = pPoints[i].y - my;
+
+        sxx += dx * dx;
+        sxy += dx * dy;
+        syy += dy * dy;
+    }
+
+    dTheta = 0.5 * atan2(2.0 * sxy, sxx - syy) + M_PI / 2.0; // 퍼짐이 가장 큰 방향 + 90도
+    while (dTheta >= M_PI)
+        dTheta -= M_PI;
+    while (dTheta < 0.0)
+        dTheta += M_PI;
+
+    *pTheta = dTheta;
+    *pRho = mx * cos(dTheta) + my * sin(dTheta);
+}
+
+/*
+ * @Function Name : FindLineSegment
+ * @Description : 직선 위의 점들이 nMaxGap 이하 간격으로 이어진 가장 긴 구간을 찾습니다.
+ * @Input : *pPoints, nCount, nMaxGap, nRhoOffset, *pCount - 작업 버퍼 (2 x nRhoOffset + 1개, 모두 0이어야 하고 돌려줄 때도 모두 0)
+ * @Output : pLine->x0, y0, x1, y1, nVotes - 구간 안의 점 수, *pFirst, *pLast - 구간의 직선 방향 좌표, 반환값 구간 길이 (픽셀, 점이 없으면 -1)
+ */
+// 김광제의 설명 - 직선 방향 좌표 u = -x sin + y cos 는 -nRhoOffset ~ nRhoOffset 이라서 점을 정렬하지 않고 u마다 개수만 세서 구간을 찾는다.
+// 점이 있는 u 범위만 읽고 다시 0으로 되돌리므로 후보가 많아도 매번 버퍼 전체를 지우지 않음
+static int FindLineSegment(const HOUGH_POINT *pPoints, int nCount, int nMaxGap, int nRhoOffset, int *pCount, HOUGH_LINE *pLine, int *pFirst, int *pLast)
+{
+    double c = cos(pLine->dTheta), s = sin(pLine->dTheta);
+    int nMin = INT_MAX, nMax = -1, nStart = -1, nLast = -1, nRun = 0, nBestStart = -1, nBestEnd = -1, nBestRun = 0;
+
+    for (int i = 0; i < nCount; i++)
+    {
+        int u = (int)lrint(pPoints[i].y * c - pPoints[i].x * s) + nRhoOffset;
+
+        pCount[u]++;
+        nMin = (u < nMin) ? u : nMin;
+        nMax = (u > nMax) ? u : nMax;
+    }
+
+    for (int u = nMin; u <= nMax; u++)
+    {
+        if (pCount[u] == 0)
+            continue;
+        if (nLast < 0 || u - nLast > nMaxGap + 1)
+        {
+            nStart = u;
+            nRun = 0;
+        }
+        nLast = u;
+        nRun += pCount[u];
+        if (nBestStart < 0 || nLast - nStart > nBestEnd - nBestStart)
+        {
+            nBestStart = nStart;
+            nBestEnd = nLast;
+            nBestRun = nRun;
+        }
+    }
+    if (nBestStart < 0)
+        return (-1);
+    memset(pCount + nMin, 0, sizeof(int) * (nMax - nMin + 1)); // 다음 호출을 위해 쓴 칸만 0으로
+
+    // 직선 위의 점 = rho (cos, sin) + u (-sin, cos)
+    *pFirst = nBestStart - nRhoOffset;
+    *pLast = nBestEnd - nRhoOffset;
+    pLine->x0 = (int)lrint(pLine->dRho * c - *pFirst * s);
+    pLine->y0 = (int)lrint(pLine->dRho * s + *pFirst * c);
+    pLine->x1 = (int)lrint(pLine->dRho * c - *pLast * s);
+    pLine->y1 = (int)lrint(pLine->dRho * s + *pLast * c);
+    pLine->nVotes = nBestRun;
+    return nBestEnd - nBestStart;
+}
+
+/*
+ * @Function Name : KeepSegmentPoints
+ * @Description : 점 중 직선 방향 좌표가 nFirst ~ nLast인 점만 앞으로 모읍니다.
+ * @Input : *pPoints, nCount, dTheta, nFirst, nLast (FindLineSegment 결과)
+ * @Output : *pPoints, 반환값 남은 점 개수
+ */
+static int KeepSegmentPoints(HOUGH_POINT *pPoints, int nCount, double dTheta, int nFirst, int nLast)
+{
+    double c = cos(dTheta), s = sin(dTheta);
+    int nKept = 0;
+
+    for (int i = 0; i < nCount; i++)
+    {
+        int u = (int)lrint(pPoints[i].y * c - pPoints[i].x * s);
+
+        if (u >= nFirst && u <= nLast)
+            pPoints[nKept++] = pPoints[i];
+    }
+    return nKept;
+}
+
+/*
+ * @Function Name : HoughLinesStandard
+ * @Description : 모든 에지 점을 투표한 뒤 극대점마다 선분을 구합니다. (ImgHoughLines 표준 방식)
+ * @Input : *pPoints, nPoints, nWidth, nHeight, nRhoBins, nRhoOffset, *pCos, *pSin, nMinVotes, nMinLength, nMaxGap, nMaxLines
+ * @Output : *pLines, 반환값 찾은 직선 개수 / -1 (메모리 할당 오류)
+ */
+// 김광제의 설명 - 1. 각도 구간마다 누적 배열 한 행이라서 각도를 스레드에 나누면 스레드마다 자기 행만 쓴다. (스레드별 누적 배열, 합치기 없음)
+//    에지 점은 HOUGH_POINT_CHUNK개씩 나눠서 그 묶음을 모든 각도가 캐시에서 다시 읽음 (같은 static 분배라서 묶음이 바뀌어도 스레드의 각도는 같음)
+// 2. 극대점을 투표 순서로 보면서 주변 점으로 직선을 다시 맞추고 (FitLine) 선분을 구한다. 선분 위의 점이 nMinVotes 이상이면 직선
+//    각도 칸은 1도라서 칸 가운데서 어긋난 긴 직선은 한 칸에 약 1 / sin(0.5도) = 115표까지만 모이므로 극대점은 HOUGH_LINE_CANDIDATE표부터 후보로 봄
+//    선분의 점은 남은 에지 점 표시에서 지워서 다음 극대점에서 빼고 투표도 취소하므로, 한 직선의 점이 비스듬한 여러 칸에 나눠 투표해서 생긴 가짜 극대점은 다시 모으지 않고 빠짐
+static int HoughLinesStandard(const HOUGH_POINT *pPoints, int nPoints, int nWidth, int nHeight, int nRhoBins, int nRhoOffset, const int *pCos, const int *pSin,
+                              int nMinVotes, int nMinLength, int nMaxGap, HOUGH_LINE *pLines, int nMaxLines)
+{
+    int *pAcc = (int *)PoolAlloc(GetThreadPool(), sizeof(int) * (size_t)HOUGH_THETA_BINS * nRhoBins, 1);
+    HOUGH_POINT *pNear = (HOUGH_POINT *)PoolAlloc(GetThreadPool(), sizeof(HOUGH_POINT) * (nPoints + 1), 0);
+    int *pCount = (int *)PoolAlloc(GetThreadPool(), sizeof(int) * nRhoBins, 1);
+    BYTE *pMask = (BYTE *)PoolAlloc(GetThreadPool(), (size_t)((nWidth + 7) >> 3) * nHeight, 1); // 남은 에지 점 (1비트)
+    HOUGH_LINE *pPeaks = NULL;
+    int nPeaks = 0, nFound = 0, nCandidate = (nMinVotes < HOUGH_LINE_CANDIDATE) ? nMinVotes : HOUGH_LINE_CANDIDATE;
+    int nSliver = (nMinVotes < HOUGH_LINE_SLIVER) ? nMinVotes : HOUGH_LINE_SLIVER;
+
+    if (NULL != pAcc && NULL != pNear && NULL != pCount && NULL != pMask)
+    {
+        for (int i = 0; i < nPoints; i++)
+            pMask[(size_t)pPoints[i].y * ((nWidth + 7) >> 3) + (pPoints[i].x >> 3)] |= (BYTE)(1 << (pPoints[i].x & 7));
+
+        // 1. 투표
+#pragma omp parallel
+        for (int nFirst = 0; nFirst < nPoints; nFirst += HOUGH_POINT_CHUNK)
+        {
+            int nLast = (nFirst + HOUGH_POINT_CHUNK < nPoints) ? nFirst + HOUGH_POINT_CHUNK : nPoints;
+
+#pragma omp for schedule(static) nowait
+            for (int t = 0; t < HOUGH_THETA_BINS; t++)
+            {
+                int *pRow = pAcc + (size_t)t * nRhoBins;
+
+                for (int i = nFirst; i < nLast; i++)
+                    pRow[LineRho(pPoints[i].x, pPoints[i].y, pCos[t], pSin[t], nRhoOffset)]++;
+            }
+        }
+
+        pPeaks = FindLinePeaks(pAcc, nRhoBins, nRhoOffset, nCandidate, &nPeaks);
+    }
+
+    if (NULL != pPeaks)
+    {
+        PROFILE_COUNT("hough_line_peaks", nPeaks);
+        qsort(pPeaks, nPeaks, sizeof(HOUGH_LINE), CompareLine);
+
+        // 2. 극대점마다 직선 다시 맞추기, 선분
+        for (int p = 0; p < nPeaks && nFound < nMaxLines; p++)
+        {
+            HOUGH_LINE Line = pPeaks[p];
+            int nCount, nFirst, nLast, nLength, nUnused;
+
+            // 앞에서 찾은 직선의 점은 투표를 취소했으므로 그 점으로만 생긴 극대점은 남은 투표가 모자람
+            if (pAcc[(int)lrint(Line.dTheta * HOUGH_THETA_BINS / M_PI) * nRhoBins + (int)lrint(Line.dRho) + nRhoOffset] < nCandidate)
+                continue;
+
+            nCount = 0;
+            for (int nPass = 0; nPass < HOUGH_LINE_PASSES; nPass++) // 다시 맞춘 직선으로 모으면 처음 칸에서 어긋났던 끝쪽 점이 더 들어옴
+            {
+                int nGathered = GatherLinePoints(pMask, nWidth, nHeight, Line.dRho, Line.dTheta, HOUGH_LINE_BAND + 1.0, pNear);
+
+                // 선분 밖의 점(직선 띠에 우연히 걸린 다른 에지)은 멀리 있어서 각도를 칸 쪽으로 끌어당기므로 선분 안의 점으로만 맞춤
+                if (nGathered < nSliver || nGathered < 2 || FindLineSegment(pNear, nGathered, nMaxGap, nRhoOffset, pCount, &Line, &nFirst, &nLast) < 0)
+                    break;
+                nGathered = KeepSegmentPoints(pNear, nGathered, Line.dTheta, nFirst, nLast);
+                if (nGathered <= nCount || nGathered < nSliver || nGathered < 2) // 띠 안의 점이 이어져 있지 않으면 (무늬의 경계) 후보가 아님
+                    break;
+                nCount = nGathered;
+                FitLine(pNear, nCount, &Line.dRho, &Line.dTheta);
+            }
+            if (nCount < nSliver || nCount < 2)
+                continue;
+
+            nCount = GatherLinePoints(pMask, nWidth, nHeight, Line.dRho, Line.dTheta, HOUGH_LINE_BAND, pNear);
+            nLength = FindLineSegment(pNear, nCount, nMaxGap, nRhoOffset, pCount, &Line, &nFirst, &nLast);
+            if (nLength < nMinLength || Line.nVotes < nMinVotes)
+                continue;
+
+            // 선분 위의 점은 이 직선의 것으로 지우고 투표 취소
+            nCount = KeepSegmentPoints(pNear, nCount, Line.dTheta, nFirst, nLast);
+            for (int i = 0; i < nCount; i++)
+            {
+                pMask[(size_t)pNear[i].y * ((nWidth + 7) >> 3) + (pNear[i].x >> 3)] &= (BYTE)~(1 << (pNear[i].x & 7));
+                VoteLinePoint(pAcc, nRhoBins, nRhoOffset, pCos, pSin, pNear[i].x, pNear[i].y, -1, &nUnused);
+            }
+            pLines[nFound++] = Line;
+        }
+    }
+
+    PoolFree(GetThreadPool(), pAcc);
+    PoolFree(GetThreadPool(), pNear);
+    PoolFree(GetThreadPool(), pCount);
+    PoolFree(GetThreadPool(), pMask);
+    if (NULL == pPeaks)
+        return (-1);
+    free(pPeaks);
+    return nFound;
+}
+
+/*
+ * @Function Name : IsMaskedNear
+ * @Description : (x, y) 또는 짧은 축으로 한 픽셀 옆에 에지 점이 있는지 검사합니다.
+ * @Input : *pMask, nWidth, nHeight, x, y, bMajorX - 긴 축이 x인지
+ * @Output : *pX, *pY - 찾은 점 (가운데 먼저), 반환값 1 (있음) / 0
+ */
+static int IsMaskedNear(const BYTE *pMask, int nWidth, int nHeight, int x, int y, int bMajorX, int *pX, int *pY)
+{
+    static const int nOrder[3] = {0, -1, 1};
+
+    for (int k = 0; k < 3; k++)
+    {
+        int px = bMajorX ? x : x + nOrder[k], py = bMajorX ? y + nOrder[k] : y;
+
+        if (px < 0 || py < 0 || px >= nWidth || py >= nHeight || pMask[(size_t)py * nWidth + px] == 0)
+            continue;
+        *pX = px;
+        *pY = py;
+        return 1;
+    }
+    return 0;
+}
+
+/*
+ * @Function Name : WalkLine
+ * @Description : (x, y)에서 (dDx, dDy) 방향으로 에지 점을 따라가서 nMaxGap보다 긴 빈 곳 직전까지의 걸음 수를 구합니다.
+ * @Input : *pMask - 에지 점 표시 (0 : 없음), nWidth, nHeight, x, y, dDx, dDy - 한 걸음 (둘 중 하나는 +-1), nMaxGap
+ * @Output : *pX, *pY - 마지막 에지 점 (없으면 (x, y)), 반환값 마지막 에지 점까지 걸음 수
+ */
+// 김광제의 설명 - 각도 칸(1도)만큼 직선이 어긋나도 따라갈 수 있도록 짧은 축으로 한 픽셀 옆의 점도 이어진 것으로 본다.
+static int WalkLine(const BYTE *pMask, int nWidth, int nHeight, int x, int y, double dDx, double dDy, int nMaxGap, int *pX, int *pY)
+{
+    int nGap = 0, nSteps = 0, bMajorX = fabs(dDx) >= fabs(dDy);
+
+    *pX = x;
+    *pY = y;
+    for (int k = 1;; k++)
+    {
+        int px = (int)lrint(x + k * dDx), py = (int)lrint(y + k * dDy);
+
+        if (px < 0 || py < 0 || px >= nWidth || py >= nHeight)
+            break;
+        if (IsMaskedNear(pMask, nWidth, nHeight, px, py, bMajorX, pX, pY))
+        {
+            nSteps = k;
+            nGap = 0;
+        }
+        else if (++nGap > nMaxGap)
+            break;
+    }
+    return nSteps;
+}
+
+/*
+ * @Function Name : StepOf
+ * @Description : (dx, dy) 방향으로 긴 축이 한 픽셀씩 움직이는 한 걸음을 구합니다.
+ */
+static void StepOf(double dx, double dy, double *pDx, double *pDy)
+{
+    double dMajor = (fabs(dx) > fabs(dy)) ? fabs(dx) : fabs(dy);
+
+    *pDx = dx / dMajor;
+    *pDy = dy / dMajor;
+}
+
+/*
+ * @Function Name : ClearSegment
+ * @Description : WalkLine으로 찾은 선분 위(짧은 축으로 +-1픽셀)의 에지 점을 세고, pAcc가 있으면 지우면서 투표한 점은 투표를 취소합니다.
+ * @Input : *pMask, nWidth, nHeight, x, y, dDx, dDy, *pSteps - 양쪽 걸음 수, *pAcc (NULL이면 세기만 함), nRhoBins, nRhoOffset, *pCos, *pSin
+ * @Output : 반환값 에지 점 개수
+ */
+// 김광제의 설명 - 긴 축은 걸음마다 정확히 한 픽셀 움직이므로 같은 점을 두번 세지 않는다.
+static int ClearSegment(BYTE *pMask, int nWidth, int nHeight, int x, int y, double dDx, double dDy, const int *pSteps, int *pAcc, int nRhoBins, int nRhoOffset,
+                        const int *pCos, const int *pSin)
+{
+    int bMajorX = fabs(dDx) >= fabs(dDy), nCount = 0;
+
+    for (int d = 0; d < 2; d++)
+    {
+        double dSign = (d == 0) ? 1.0 : -1.0;
+
+        for (int j = d; j <= pSteps[d]; j++) // 시작점은 한번만
+        {
+            int px = (int)lrint(x + j * dSign * dDx), py = (int)lrint(y + j * dSign * dDy);
+
+            for (int k = -1; k <= 1; k++)
+            {
+                int qx = bMajorX ? px : px + k, qy = bMajorX ? py + k : py, nUnused;
+                BYTE *pCell;
+
+                if (qx < 0 || qy < 0 || qx >= nWidth || qy >= nHeight)
+                    continue;
+                pCell = &pMask[(size_t)qy * nWidth + qx];
+                if (*pCell == 0)
+                    continue;
+                nCount++;
+                if (NULL == pAcc)
+                    continue;
+                if (*pCell == 2)
+                    VoteLinePoint(pAcc, nRhoBins, nRhoOffset, pCos, pSin, qx, qy, -1, &nUnused);
+                *pCell = 0;
+            }
+        }
+    }
+    return nCount;
+}
+
+/*
+ * @Function Name : HoughLinesProgressive
+ * @Description : 에지 점을 임의 순서로 투표하면서 임계값을 넘은 직선을 선분으로 떼어냅니다. (ImgHoughLines 점진 방식)
+ * @Input : *pPoints, nPoints, nWidth, nHeight, nRhoBins, nRhoOffset, *pCos, *pSin, nMinVotes, nMinLength, nMaxGap, nMaxLines
+ * @Output : *pLines, 반환값 찾은 선분 개수 / -1 (메모리 할당 오류)
+ */
+// 김광제의 설명 - 점진 확률 허프 변환 (Matas)
+// 1. 아직 남은 에지 점 하나를 투표하고, 그 점이 투표한 칸 중 가장 큰 칸이 후보 임계값(표준 방식과 같음) 이상이면 그 각도로 점에서 양쪽으로 에지를 따라가서 선분을 찾는다.
+//    찾은 양 끝점을 이은 방향이 각도 칸보다 정확하므로 선분이 길어지는 동안 그 방향으로 다시 따라감
+// 2. 선분이 nMinLength 이상이고 선분 위의 점이 nMinVotes 이상이면 선분 위의 점을 지우고 이미 투표한 점은 투표를 취소한다. (같은 직선이 다시 나오지 않고, 남은 점만으로 다음 직선을 찾음)
+// 긴 직선은 점 일부만 투표해도 임계값을 넘으므로 모든 점이 투표하지 않고, nMaxLines개를 찾으면 바로 끝나서 큰 영상에서 빠르다.
+// 투표 순서가 결과에 영향을 주므로 고정 시드로 섞고 한 스레드로 처리 (스레드 수와 관계없이 같은 결과)
+static int HoughLinesProgressive(const HOUGH_POINT *pPoints, int nPoints, int nWidth, int nHeight, int nRhoBins, int nRhoOffset, const int *pCos, const int *pSin,
+                                 int nMinVotes, int nMinLength, int nMaxGap, HOUGH_LINE *pLines, int nMaxLines)
+{
+    int *pAcc = (int *)PoolAlloc(GetThreadPool(), sizeof(int) * (size_t)HOUGH_THETA_BINS * nRhoBins, 1);
+    int *pOrder = (int *)PoolAlloc(GetThreadPool(), sizeof(int) * (nPoints + 1), 0);
+    BYTE *pMask = (BYTE *)PoolAlloc(GetThreadPool(), (size_t)nWidth * nHeight, 1); // 0 : 에지 아님 (또는 지움), 1 : 에지, 2 : 투표한 에지
+    unsigned int nSeed = HOUGH_SHUFFLE_SEED;
+    int nFound = 0, nCandidate = (nMinVotes < HOUGH_LINE_CANDIDATE) ? nMinVotes : HOUGH_LINE_CANDIDATE;
+
+    if (NULL == pAcc || NULL == pOrder || NULL == pMask)
+    {
+        PoolFree(GetThreadPool(), pAcc);
+        PoolFree(GetThreadPool(), pOrder);
+        PoolFree(GetThreadPool(), pMask);
+        return (-1);
+    }
+
+    for (int i = 0; i < nPoints; i++)
+    {
+        pOrder[i] = i;
+        pMask[(size_t)pPoints[i].y * nWidth + pPoints[i].x] = 1;
+    }
+    for (int i = nPoints - 1; i > 0; i--) // Fisher-Yates
+    {
+        int j, nTemp;
+
+        nSeed = nSeed * 1103515245u + 12345u;
+        j = (int)(((unsigned long long)(nSeed >> 1) * (unsigned int)(i + 1)) >> 31);
+        nTemp = pOrder[i];
+        pOrder[i] = pOrder[j];
+        pOrder[j] = nTemp;
+    }
+
+    for (int k = 0; k < nPoints && nFound < nMaxLines; k++)
+    {
+        int x = pPoints[pOrder[k]].x, y = pPoints[pOrder[k]].y, t, nVotes, nEnd[2][2], nSteps[2], nLength, nCount = 0;
+        double dDx, dDy, dTheta;
+
+        if (pMask[(size_t)y * nWidth + x] == 0) // 이미 찾은 선분에 속해서 지워진 점
+            continue;
+        pMask[(size_t)y * nWidth + x] = 2;
+        nVotes = VoteLinePoint(pAcc, nRhoBins, nRhoOffset, pCos, pSin, x, y, 1, &t);
+        if (nVotes < nCandidate)
+            continue;
+
+        // 1. 직선 방향 (-sin, cos)으로 양쪽 끝점, 끝점을 이은 방향으로 다시
+        dTheta = t * M_PI / HOUGH_THETA_BINS;
+        StepOf(-sin(dTheta), cos(dTheta), &dDx, &dDy);
+        nLength = -1;
+        for (int nPass = 0; nPass < HOUGH_LINE_PASSES; nPass++) // 선분이 길어지는 동안
+        {
+            int nNewSteps[2], nNewEnd[2][2];
+
+            nNewSteps[0] = WalkLine(pMask, nWidth, nHeight, x, y, dDx, dDy, nMaxGap, &nNewEnd[0][0], &nNewEnd[0][1]);
+            nNewSteps[1] = WalkLine(pMask, nWidth, nHeight, x, y, -dDx, -dDy, nMaxGap, &nNewEnd[1][0], &nNewEnd[1][1]);
+            if (nNewSteps[0] + nNewSteps[1] <= nLength)
+                break;
+            memcpy(nSteps, nNewSteps, sizeof(nSteps));
+            memcpy(nEnd, nNewEnd, sizeof(nEnd));
+            nLength = nSteps[0] + nSteps[1];
+            if (nLength == 0)
+                break;
+            StepOf(nEnd[0][0] - nEnd[1][0], nEnd[0][1] - nEnd[1][1], &dDx, &dDy);
+        }
+        if (nLength <= 0 || hypot(nEnd[0][0] - nEnd[1][0], nEnd[0][1] - nEnd[1][1]) < nMinLength)
+            continue;
+
+        // 2. 선분 위의 점이 nMinVotes 이상이면 지우고 투표한 점은 투표 취소
+        nCount = ClearSegment(pMask, nWidth, nHeight, x, y, dDx, dDy, nSteps, NULL, 0, 0, NULL, NULL);
+        if (nCount < nMinVotes)
+            continue;
+        ClearSegment(pMask, nWidth, nHeight, x, y, dDx, dDy, nSteps, pAcc, nRhoBins, nRhoOffset, pCos, pSin);
+
+        // 끝점을 이은 직선의 법선 각도 (0 ~ pi), 거리
+        dTheta = atan2(dDx, -dDy);
+        if (dTheta < 0.0)
+            dTheta += M_PI;
+        if (dTheta >= M_PI)
+            dTheta -= M_PI;
+        pLines[nFound].dTheta = dTheta;
+        pLines[nFound].dRho = x * cos(dTheta) + y * sin(dTheta);
+        pLines[nFound].nVotes = nCount;
+        pLines[nFound].x0 = nEnd[1][0];
+        pLines[nFound].y0 = nEnd[1][1];
+        pLines[nFound].x1 = nEnd[0][0];
+        pLines[nFound].y1 = nEnd[0][1];
+        nFound++;
+    }
+
+    PoolFree(GetThreadPool(), pAcc);
+    PoolFree(GetThreadPool(), pOrder);
+    PoolFree(GetThreadPool(), pMask);
+    return nFound;
+}
+
+/*
+ * @Function Name : ImgHoughLines
+ * @Description : 8비트 그레이 영상(ROI 가능)에서 직선을 찾습니다.
+ * @Input : *pIn - 한 변 65535 이하, nEdgeThreshold - 소벨 출력 단위의 에지 임계값 (0이면 값이 0인 픽셀을 에지 점으로 사용 - DetectObjectEdge 결과),
+ *          nMinVotes - 직선으로 인정할 선분 위의 최소 에지 점 수 (1 이상), nMinLength - 선분의 최소 길이 (픽셀), nMaxGap - 선분 안에서 허용하는 빈 곳 (픽셀),
+ *          nMode - HOUGH_LINES_STANDARD / HOUGH_LINES_PROGRESSIVE, nMaxLines
+ * @Output : *pLines - 표준 방식은 누적 배열 투표 수가 큰 순서, 점진 방식은 찾은 순서 (최대 nMaxLines개), 반환값 저장한 직선 개수 / -1 (입력 오류, 메모리 할당 오류)
+ */
+// 김광제의 설명 - 1. 에지 점을 (x, y) 목록으로 모은다. (영상 전체가 아닌 에지 점만 투표)
+// 2. cos, sin은 각도 구간마다 한번 고정 소수점 표로 만들고 거리 칸은 정수 곱셈, 시프트로 구한다. 누적 배열은 각도 180 X 거리 (2 x 대각선 + 1)의 int
+// 3. 표준 방식은 극대점, 점진 방식은 투표하면서 바로 선분을 찾는다. (HoughLinesStandard, HoughLinesProgressive)
+int ImgHoughLines(const IMAGE *pIn, int nEdgeThreshold, int nMinVotes, int nMinLength, int nMaxGap, int nMode, HOUGH_LINE *pLines, int nMaxLines)
+{
+    int nWidth = pIn->nWidth, nHeight = pIn->nHeight;
+    int nRhoOffset = (int)ceil(sqrt((double)nWidth * nWidth + (double)nHeight * nHeight)) + 1, nRhoBins = 2 * nRhoOffset + 1;
+    int nCos[HOUGH_THETA_BINS], nSin[HOUGH_THETA_BINS];
+    HOUGH_POINT *pPoints = NULL;
+    int nPoints, nRet = -1;
+    PROFILE_BEGIN(dStart);
+
+    if (pIn->nFormat != PIXEL_GRAY8 || nWidth > 0xFFFF || nHeight > 0xFFFF || nEdgeThreshold < 0 || nMinVotes < 1 || nMinLength < 0 || nMaxGap < 0 ||
+        (nMode != HOUGH_LINES_STANDARD && nMode != HOUGH_LINES_PROGRESSIVE) || nMaxLines < 0 || (NULL == pLines && nMaxLines > 0))
+        return (-1);
+    if (nMaxLines == 0)
+        return 0;
+
+    for (int t = 0; t < HOUGH_THETA_BINS; t++)
+    {
+        nCos[t] = (int)lrint(cos(t * M_PI / HOUGH_THETA_BINS) * (1 << HOUGH_TRIG_BITS));
+        nSin[t] = (int)lrint(sin(t * M_PI / HOUGH_THETA_BINS) * (1 << HOUGH_TRIG_BITS));
+    }
+
+    nPoints = CollectLinePoints(pIn, nEdgeThreshold, &pPoints);
+    if (nPoints >= 0)
+    {
+        PROFILE_COUNT("hough_line_points", nPoints);
+        if (nMode == HOUGH_LINES_STANDARD)
+            nRet = HoughLinesStandard(pPoints, nPoints, nWidth, nHeight, nRhoBins, nRhoOffset, nCos, nSin, nMinVotes, nMinLength, nMaxGap, pLines, nMaxLines);
+        else
+            nRet = HoughLinesProgressive(pPoints, nPoints, nWidth, nHeight, nRhoBins, nRhoOffset, nCos, nSin, nMinVotes, nMinLength, nMaxGap, pLines, nMaxLines);
+        PoolFree(GetThreadPool(), pPoints);
+    }
+
+    PROFILE_END(dStart, "hough_lines", (long long)nWidth * nHeight,
+                (long long)nWidth * nHeight + (long long)(nPoints > 0 ? nPoints : 0) * sizeof(HOUGH_POINT) * HOUGH_THETA_BINS);
+    return nRet;
+}
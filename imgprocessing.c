@@ -0,0 +1,3510 @@
+/*
+ * @Name : imgprocessing.c
+ * @Description : Image Processing in C
+ * @Date : 2023. 9. 12
+ * @Revision : 2.5
+ * 0.1 : inverse
+ * 0.2 : brightness, contrast
+ * 0.3 : histogram, gonzales method, binalization
+ * 0.4 : histogram stretching, histogram equalization
+ * 0.5 : convolution(9~17)
+ * 0.6 : laplacian high pass filter
+ * 0.7 : Median Filter - MinPooling , MedianPooling, MaxPooling using Bubble Sorting, swap
+ * 0.8 : Median Filtering(variable filter), Component Labeling(GrassFire Algorithm using Depth-First Search stack)
+ * 0.9 : Detect Object Edge
+ * 1.0 : VerticalFlip, HorizontalFlip, Translation, Scaling, Rotation
+ * 1.1 : Erosion, Dilation, ZhangSuenAlgorithm, FeatureExtractThinImage
+ *         침식      팽창       뒤에 두개는 시험 X
+ * 1.2 : Otsu Method, Multi Otsu Method (Multi-level Thresholding)
+ * 1.3 : CLAHE (Contrast Limited Adaptive Histogram Equalization), OpenMP 병렬 처리 (/openmp 옵션)
+ * 1.4 : 16비트 그레이, 24/32비트 컬러 BMP 지원 (pixel_kernels.h), 행 패딩 처리
+ * 1.5 : IMAGE 구조체 (Interleaved / Planar), SSE2/SSSE3 채널 분리/합치기, RGB -> Gray 변환
+ * 1.6 : IMAGE 행 간격(nStride), 64바이트 정렬 할당, ROI (복사 없는 부분 영상), IMAGE 입력 함수 (ImgXXX)
+ * 1.7 : 크기 등급별 버퍼 풀, 작업 단위 아레나 (중간 버퍼 재사용, 필요한 경우에만 0 초기화)
+ * 1.8 : benchmark.c (성능 측정) - IMGPROC_NO_MAIN 정의 시 main 제외
+ * 1.9 : golden_test.c (기준 구현과 최적화 경로 비교), ComponentLabeling 시작 픽셀 검사 위치 오류 수정
+ * 2.0 : profile.h 단계별 시간, 처리량, 카운터 기록 (IMGPROC_PROFILE, JSON / Chrome trace 출력)
+ * 2.1 : 라이브러리(imgprocessing.c, bmpio.c, profile.c)와 메뉴 프로그램(14week.c) 분리, Windows.h 의존 제거, CMake 빌드
+ * 2.2 : context.c 처리 컨텍스트 (버퍼 풀, 스레드 수, CPU 기능), 기능 번호로 호출하는 RunOperation, SetThreadPool, CopyImage
+ * 2.3 : pipeline.c 지연 실행 파이프라인 (점 연산 LUT 합치기, 이웃 연산 행 버퍼로 이어서 타일 단위 실행)
+ * 2.4 : 고정 커널 정수 컨볼루션 (Convolution3x3Fixed_X), 실행 중에 만든 커널용 ImgConvolutionKernel
+ * 2.5 : DetectObjectEdge가 첫 행, 마지막 행에서 영상 밖을 읽던 오류 수정 (영상 밖은 배경)
+ */
+
+// 지금 어려운게 필터를 사용할때 1,1로 계산을 시작하니까 너무 헷갈림
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#ifdef _WIN32
+#include <malloc.h> // _aligned_malloc
+#endif
+// SIMD (SSE2는 x64에서 항상 사용 가능, SSSE3는 /arch:AVX 또는 -mssse3 이상에서 사용)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define IMGPROC_SSE2
+#endif
+#if defined(__SSSE3__) || defined(__AVX__)
+#include <tmmintrin.h>
+#define IMGPROC_SSSE3
+#endif
+// 헤더파일
+#include "imgprocessing.h"
+#include "convolution.h"
+#include "profile.h" // IMGPROC_PROFILE을 정의하면 단계별 시간, 카운터 기록
+
+// 이진영상에서
+unsigned char blankPixel = 255, imagePixel = 0;
+
+// ver 2.1 ZhangSuen 세선화용 행 포인터 (선언이 빠져 있어서 빌드되지 않던 문제 수정)
+static BYTE **imageMatrix = NULL;
+
+// pixel 좌표 구조체
+typedef struct
+{
+    int row, col;
+} pixel;
+
+/*
+ * @Function Name : GetBytesPerPixel
+ * @Description : 픽셀 형식의 픽셀당 바이트 수를 반환합니다.
+ * @Input : nFormat
+ * @Output : 픽셀당 바이트 수
+ */
+int GetBytesPerPixel(int nFormat)
+{
+    switch (nFormat)
+    {
+    case PIXEL_GRAY16:
+        return 2;
+    case PIXEL_BGR24:
+        return 3;
+    case PIXEL_BGRA32:
+        return 4;
+    default:
+        return 1;
+    }
+}
+
+/*
+ * @Function Name : AlignedMalloc
+ * @Description : IMAGE_ALIGN(64) 바이트 경계에 정렬된 메모리를 할당합니다.
+ * @Input : nSize - 할당할 바이트 수
+ * @Output : 할당된 메모리 (실패하면 NULL), AlignedFree로 해제
+ */
+// 김광제의 설명 - 버퍼 시작이 캐시 라인 경계에 맞으면 한 행을 읽을 때 걸치는 캐시 라인 수가 줄고 SIMD 로드가 라인을 넘지 않는다.
+void *AlignedMalloc(size_t nSize)
+{
+#ifdef _WIN32
+    return _aligned_malloc(nSize, IMAGE_ALIGN);
+#else
+    void *p = NULL;
+
+    if (posix_memalign(&p, IMAGE_ALIGN, nSize) != 0)
+        return NULL;
+    return p;
+#endif
+}
+
+/*
+ * @Function Name : AlignedFree
+ * @Description : AlignedMalloc으로 할당한 메모리를 해제합니다.
+ * @Input : *p
+ */
+void AlignedFree(void *p)
+{
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
+/*
+ * @Function Name : PoolClassSize
+ * @Description : nClass번 크기 등급의 블록 크기를 반환합니다.
+ * @Input : nClass
+ * @Output : 블록 크기 (바이트)
+ */
+// 김광제의 설명 - 2의 거듭제곱 사이를 4등분한 크기 (64, 80, 96, 112, 128, 160, ...)
+// 2배씩만 나누면 큰 영상에서 최대 절반이 낭비되는데 4등분하면 낭비가 25% 이하
+size_t PoolClassSize(int nClass)
+{
+    return (size_t)(4 + nClass % 4) << (nClass / 4 + POOL_MIN_SHIFT - 2);
+}
+
+/*
+ * @Function Name : PoolSizeClass
+ * @Description : nSize 바이트를 담을 수 있는 가장 작은 크기 등급을 반환합니다.
+ * @Input : nSize
+ * @Output : 크기 등급 (너무 크면 -1)
+ */
+int PoolSizeClass(size_t nSize)
+{
+    int nClass = 0;
+
+    // 2의 거듭제곱 단위로 먼저 건너뛰고 4등분 중 하나를 고른다.
+    while (nClass + 4 < POOL_CLASSES && PoolClassSize(nClass + 4) <= nSize)
+        nClass += 4;
+    while (nClass < POOL_CLASSES && PoolClassSize(nClass) < nSize)
+        nClass++;
+
+    return (nClass < POOL_CLASSES) ? nClass : -1;
+}
+
+/*
+ * @Function Name : PoolInit
+ * @Description : 버퍼 풀을 초기화합니다.
+ * @Input : nMaxCached - 해제하지 않고 보관할 최대 바이트 수 (0이면 POOL_DEFAULT_MAX_CACHED)
+ * @Output : *pPool
+ */
+void PoolInit(BUFFER_POOL *pPool, size_t nMaxCached)
+{
+    memset(pPool, 0, sizeof(BUFFER_POOL));
+    pPool->nMaxCached = (nMaxCached > 0) ? nMaxCached : POOL_DEFAULT_MAX_CACHED;
+    pPool->bInit = 1;
+}
+
+/*
+ * @Function Name : PoolAlloc
+ * @Description : 풀에서 IMAGE_ALIGN 바이트 정렬된 nSize 바이트 버퍼를 가져옵니다.
+ * @Input : *pPool, nSize, bZero - 0으로 초기화할지 여부
+ * @Output : 버퍼 (실패하면 NULL), PoolFree로 반납
+ */
+// 김광제의 설명 - 같은 크기 등급의 반납된 블록이 있으면 그대로 다시 사용한다. (새로 할당하면서 생기는 페이지 폴트가 없음)
+// 블록 앞의 IMAGE_ALIGN 바이트에 등급과 연결 정보를 저장하기 때문에 반납할 때 크기를 넘길 필요가 없음
+// 0 초기화는 비용이 크므로 결과가 초기값에 의존하는 경우(bZero)에만 한다.
+void *PoolAlloc(BUFFER_POOL *pPool, size_t nSize, int bZero)
+{
+    int nClass = PoolSizeClass(nSize > 0 ? nSize : 1);
+    POOL_BLOCK *pBlock;
+
+    if (nClass < 0)
+        return NULL;
+
+    pBlock = pPool->pFree[nClass];
+    if (pBlock != NULL)
+    {
+        pPool->pFree[nClass] = pBlock->pNext;
+        pPool->nCached -= PoolClassSize(nClass);
+        pPool->nHits++;
+    }
+    else
+    {
+        pBlock = (POOL_BLOCK *)AlignedMalloc(IMAGE_ALIGN + PoolClassSize(nClass));
+        if (NULL == pBlock)
+            return NULL;
+        pBlock->nClass = nClass;
+        pPool->nMisses++;
+    }
+
+    pBlock->pNext = NULL;
+    if (bZero)
+        memset((BYTE *)pBlock + IMAGE_ALIGN, 0, nSize);
+
+    return (BYTE *)pBlock + IMAGE_ALIGN;
+}
+
+/*
+ * @Function Name : PoolFree
+ * @Description : PoolAlloc으로 가져온 버퍼를 풀에 반납합니다. (보관 한도를 넘으면 해제)
+ * @Input : *pPool, *p (NULL이면 아무것도 하지 않음)
+ * @Output : *pPool
+ */
+void PoolFree(BUFFER_POOL *pPool, void *p)
+{
+    POOL_BLOCK *pBlock;
+    size_t nBlockSize;
+
+    if (NULL == p)
+        return;
+
+    pBlock = (POOL_BLOCK *)((BYTE *)p - IMAGE_ALIGN);
+    nBlockSize = PoolClassSize(pBlock->nClass);
+
+    if (pPool->nCached + nBlockSize > pPool->nMaxCached)
+    {
+        AlignedFree(pBlock);
+        return;
+    }
+
+    pBlock->pNext = pPool->pFree[pBlock->nClass];
+    pPool->pFree[pBlock->nClass] = pBlock;
+    pPool->nCached += nBlockSize;
+}
+
+/*
+ * @Function Name : PoolRelease
+ * @Description : 풀에 보관중인 블록을 모두 해제합니다. (사용중인 버퍼는 그대로)
+ * @Input : *pPool
+ * @Output : *pPool
+ */
+void PoolRelease(BUFFER_POOL *pPool)
+{
+    for (int c = 0; c < POOL_CLASSES; c++)
+    {
+        while (pPool->pFree[c] != NULL)
+        {
+            POOL_BLOCK *pNext = pPool->pFree[c]->pNext;
+            AlignedFree(pPool->pFree[c]);
+            pPool->pFree[c] = pNext;
+        }
+    }
+    pPool->nCached = 0;
+}
+
+/*
+ * @Function Name : GetThreadPool
+ * @Description : 현재 스레드의 기본 버퍼 풀을 반환합니다.
+ * @Output : 버퍼 풀 (스레드마다 하나)
+ */
+// 김광제의 설명 - 풀은 잠금이 없어서 스레드끼리 공유하면 안 된다. 스레드마다 따로 두면 잠금 없이 안전함
+// 풀을 인자로 받지 않는 함수들(ComponentLabeling, MedianFiltering, CreateImage 등)은 이 풀을 사용
+// 스레드를 끝내기 전에 PoolRelease(GetThreadPool())로 보관중인 블록을 해제해야 함
+static IMGPROC_THREAD_LOCAL BUFFER_POOL *pCurrentPool = NULL; // ver 2.2 SetThreadPool로 바꾼 풀 (NULL이면 스레드 기본 풀)
+
+BUFFER_POOL *GetThreadPool(void)
+{
+    static IMGPROC_THREAD_LOCAL BUFFER_POOL ThreadPool;
+
+    if (pCurrentPool != NULL)
+        return pCurrentPool;
+
+    if (!ThreadPool.bInit)
+        PoolInit(&ThreadPool, 0);
+
+    return &ThreadPool;
+}
+
+/*
+ * @Function Name : SetThreadPool
+ * @Description : 현재 스레드에서 GetThreadPool이 반환할 풀을 바꿉니다.
+ * @Input : *pPool - 사용할 풀 (NULL이면 스레드 기본 풀로 되돌림)
+ * @Output : 이전에 설정된 풀 (기본 풀이었으면 NULL)
+ */
+// 김광제의 설명 - RunOperation이 처리하는 동안만 컨텍스트의 풀을 쓰도록 바꿨다가 끝나면 이전 값으로 되돌린다.
+// 컨텍스트를 다른 스레드로 옮겨서 사용해도 항상 같은 풀(컨텍스트의 풀)에서 재사용됨
+BUFFER_POOL *SetThreadPool(BUFFER_POOL *pPool)
+{
+    BUFFER_POOL *pPrev = pCurrentPool;
+
+    pCurrentPool = pPool;
+    return pPrev;
+}
+
+/*
+ * @Function Name : ArenaInit
+ * @Description : 작업 단위 아레나를 초기화합니다.
+ * @Input : *pPool - 청크를 가져올 풀, nChunkSize - 기본 청크 크기 (0이면 ARENA_DEFAULT_CHUNK)
+ * @Output : *pArena
+ */
+// 김광제의 설명 - 한 작업(영상 한 장) 동안 필요한 작은 임시 버퍼들을 청크 안에서 잘라 쓰고 작업이 끝나면 한번에 돌려준다.
+// 버퍼마다 해제할 필요가 없어서 중간에 실패해도 ArenaReset 한번이면 됨
+void ArenaInit(ARENA *pArena, BUFFER_POOL *pPool, size_t nChunkSize)
+{
+    memset(pArena, 0, sizeof(ARENA));
+    pArena->pPool = pPool;
+    pArena->nChunkSize = (nChunkSize > 0) ? nChunkSize : ARENA_DEFAULT_CHUNK;
+}
+
+/*
+ * @Function Name : ArenaAlloc
+ * @Description : 아레나에서 IMAGE_ALIGN 바이트 정렬된 nSize 바이트를 잘라옵니다.
+ * @Input : *pArena, nSize, bZero - 0으로 초기화할지 여부
+ * @Output : 버퍼 (실패하면 NULL), 개별 해제 없음 (ArenaReset)
+ */
+void *ArenaAlloc(ARENA *pArena, size_t nSize, int bZero)
+{
+    BYTE *p;
+
+    nSize = (nSize + IMAGE_ALIGN - 1) / IMAGE_ALIGN * IMAGE_ALIGN;
+
+    // 현재 청크에 공간이 없으면 새 청크 (기본 크기보다 크면 요청 크기만큼)
+    if (pArena->nChunks == 0 || pArena->nUsed + nSize > pArena->nChunkBytes[pArena->nChunks - 1])
+    {
+        size_t nBytes = (nSize > pArena->nChunkSize) ? nSize : pArena->nChunkSize;
+
+        if (pArena->nChunks == ARENA_MAX_CHUNKS)
+            return NULL;
+
+        p = (BYTE *)PoolAlloc(pArena->pPool, nBytes, 0);
+        if (NULL == p)
+            return NULL;
+
+        pArena->pChunk[pArena->nChunks] = p;
+        pArena->nChunkBytes[pArena->nChunks] = nBytes;
+        pArena->nChunks++;
+        pArena->nUsed = 0;
+    }
+
+    p = pArena->pChunk[pArena->nChunks - 1] + pArena->nUsed;
+    pArena->nUsed += nSize;
+
+    if (bZero)
+        memset(p, 0, nSize);
+
+    return p;
+}
+
+/*
+ * @Function Name : ArenaReset
+ * @Description : 아레나에서 잘라간 버퍼를 모두 무효로 하고 청크를 풀에 반납합니다.
+ * @Input : *pArena
+ * @Output : *pArena
+ */
+void ArenaReset(ARENA *pArena)
+{
+    for (int c = 0; c < pArena->nChunks; c++)
+        PoolFree(pArena->pPool, pArena->pChunk[c]);
+
+    pArena->nChunks = 0;
+    pArena->nUsed = 0;
+}
+
+/*
+ * @Function Name : CreateImage
+ * @Description : nFormat 형식의 영상을 nLayout 방식으로 저장할 버퍼를 스레드 버퍼 풀에서 가져옵니다. (IMAGE_ALIGN 바이트 정렬, 초기화하지 않음)
+ * @Input : nWidth, nHeight, nFormat (PIXEL_xxx), nLayout (LAYOUT_INTERLEAVED, LAYOUT_PLANAR)
+ * @Output : *pImage, 반환값 0 (성공) / -1 (메모리 할당 오류)
+ */
+// 김광제의 설명 - Planar는 채널별로 nWidth X nHeight 크기의 평면을 연속해서 붙여서 할당한다.
+// 평면 크기를 IMAGE_ALIGN 배수로 올려서 모든 평면의 시작 주소가 정렬되도록 함
+// 행 사이에는 패딩을 넣지 않는다. (nStride = nWidth X 바이트 수라서 기존 함수에 평면 주소를 그대로 넘길 수 있음)
+// 그레이 영상은 채널이 하나라서 두 방식이 같음
+int CreateImage(IMAGE *pImage, int nWidth, int nHeight, int nFormat, int nLayout)
+{
+    int nBpp = GetBytesPerPixel(nFormat);
+    size_t nPlaneSize;
+
+    pImage->nWidth = nWidth;
+    pImage->nHeight = nHeight;
+    pImage->nFormat = nFormat;
+    pImage->nChannels = (nFormat == PIXEL_BGR24) ? 3 : ((nFormat == PIXEL_BGRA32) ? 4 : 1);
+    pImage->nLayout = (pImage->nChannels == 1) ? LAYOUT_INTERLEAVED : nLayout;
+    pImage->nStride = (pImage->nLayout == LAYOUT_PLANAR) ? nWidth : nWidth * nBpp;
+
+    nPlaneSize = ((size_t)pImage->nStride * nHeight + IMAGE_ALIGN - 1) / IMAGE_ALIGN * IMAGE_ALIGN;
+    pImage->pBuffer = (BYTE *)PoolAlloc(GetThreadPool(), nPlaneSize * ((pImage->nLayout == LAYOUT_PLANAR) ? pImage->nChannels : 1), 0);
+
+    for (int c = 0; c < 4; c++)
+        pImage->pPlane[c] = NULL;
+
+    if (NULL == pImage->pBuffer)
+        return (-1);
+
+    if (pImage->nLayout == LAYOUT_PLANAR)
+    {
+        // 채널 c의 평면은 버퍼의 c X nPlaneSize 위치부터 시작
+        for (int c = 0; c < pImage->nChannels; c++)
+            pImage->pPlane[c] = pImage->pBuffer + c * nPlaneSize;
+    }
+    else
+    {
+        pImage->pPlane[0] = pImage->pBuffer;
+    }
+
+    return 0;
+}
+
+/*
+ * @Function Name : FreeImage
+ * @Description : CreateImage로 할당한 버퍼를 스레드 버퍼 풀에 반납합니다. (ROI, WrapImage 영상은 버퍼를 소유하지 않으므로 아무것도 해제하지 않음)
+ * @Input : *pImage
+ * @Output : *pImage
+ */
+void FreeImage(IMAGE *pImage)
+{
+    PoolFree(GetThreadPool(), pImage->pBuffer);
+    pImage->pBuffer = NULL;
+    for (int c = 0; c < 4; c++)
+        pImage->pPlane[c] = NULL;
+}
+
+/*
+ * @Function Name : WrapImage
+ * @Description : 이미 할당된 Interleaved 버퍼를 복사 없이 IMAGE로 감쌉니다.
+ * @Input : *pData, nWidth, nHeight, nFormat, nStride (0이면 nWidth X 바이트 수)
+ * @Output : *pImage
+ */
+// 김광제의 설명 - ReadBitmap으로 읽은 버퍼나 기존 BYTE* 인터페이스의 버퍼를 IMAGE 함수에 넘길 때 사용
+void WrapImage(IMAGE *pImage, void *pData, int nWidth, int nHeight, int nFormat, int nStride)
+{
+    pImage->nWidth = nWidth;
+    pImage->nHeight = nHeight;
+    pImage->nFormat = nFormat;
+    pImage->nLayout = LAYOUT_INTERLEAVED;
+    pImage->nChannels = (nFormat == PIXEL_BGR24) ? 3 : ((nFormat == PIXEL_BGRA32) ? 4 : 1);
+    pImage->nStride = (nStride > 0) ? nStride : nWidth * GetBytesPerPixel(nFormat);
+    pImage->pBuffer = NULL;
+    pImage->pPlane[0] = (BYTE *)pData;
+    for (int c = 1; c < 4; c++)
+        pImage->pPlane[c] = NULL;
+}
+
+/*
+ * @Function Name : CreateROI
+ * @Description : pSrc의 (x, y) 위치부터 nWidth X nHeight 영역을 가리키는 ROI 영상을 만듭니다. (복사 없음)
+ * @Input : *pSrc, x, y, nWidth, nHeight
+ * @Output : *pRoi, 반환값 0 (성공) / -1 (영역이 영상을 벗어남)
+ */
+// 김광제의 설명 - 시작 주소만 옮기고 nStride는 원본 값을 그대로 쓰기 때문에 다음 행으로 넘어갈 때 원본의 다음 행을 가리킨다.
+// ROI는 원본 버퍼를 공유하므로 ROI에 쓴 결과는 원본에 바로 반영되고, 원본을 해제하면 ROI도 사용할 수 없음
+int CreateROI(const IMAGE *pSrc, IMAGE *pRoi, int x, int y, int nWidth, int nHeight)
+{
+    int nOffset;
+
+    if (x < 0 || y < 0 || nWidth < 1 || nHeight < 1 || x + nWidth > pSrc->nWidth || y + nHeight > pSrc->nHeight)
+        return (-1);
+
+    *pRoi = *pSrc;
+    pRoi->nWidth = nWidth;
+    pRoi->nHeight = nHeight;
+    pRoi->pBuffer = NULL;
+
+    // Planar는 평면마다 1바이트가 1픽셀, Interleaved는 픽셀당 바이트 수만큼 이동
+    nOffset = y * pSrc->nStride + x * ((pSrc->nLayout == LAYOUT_PLANAR) ? 1 : GetBytesPerPixel(pSrc->nFormat));
+    for (int c = 0; c < 4; c++)
+        if (pSrc->pPlane[c] != NULL)
+            pRoi->pPlane[c] = pSrc->pPlane[c] + nOffset;
+
+    return 0;
+}
+
+/*
+ * @Function Name : GetPlaneView
+ * @Description : Planar 영상의 c번째 평면을 8비트 그레이 영상으로 봅니다. (복사 없음)
+ * @Input : *pSrc, c
+ * @Output : *pView
+ */
+void GetPlaneView(const IMAGE *pSrc, int c, IMAGE *pView)
+{
+    WrapImage(pView, pSrc->pPlane[c], pSrc->nWidth, pSrc->nHeight, PIXEL_GRAY8, pSrc->nStride);
+}
+
+/*
+ * @Function Name : InverseImage
+ * @Description : 픽셀 단위로 밝기 값을 반전시킵니다.
+ * @Input : *Input - 입력 이미지 데이터 배열을 가리키는 포인터,
+ *          nWidth - 이미지의 너비 (픽셀 단위),
+ *          nHeight - 이미지의 높이 (픽셀 단위)
+ * @Output : *Output - 출력 이미지 데이터 배열을 가리키는 포인터
+ */
+// 김광제의 설명 - 밝기값을 255는 0으로 0은 255로 바뀌도록 해둔거임
+void InverseImage(BYTE *Input, BYTE *Output, int nWidth, int nHeight)
+{
+    int nImgSize = nWidth * nHeight; // 이미지 크기 계산
+
+    // 픽셀별로 밝기값을 반전시킴
+    for (int i = 0; i < nImgSize; i++)
+        Output[i] = 255 - Input[i]; // 반전 연산: 255에서 빼기
+
+    return;
+}
+
+/*
+ * @Function Name : AdjustBrightness
+ * @Description : nBrightness 값에 따라 픽셀 단위로 밝기값을 조절합니다.
+ * @Input : *Input - 입력 이미지 데이터 배열을 가리키는 포인터,
+ *          nWidth - 이미지의 너비 (픽셀 단위),
+ *          nHeight - 이미지의 높이 (픽셀 단위),
+ *          nBrightness - 조정할 밝기값
+ * @Output : *Output - 출력 이미지 데이터 배열을 가리키는 포인터
+ */
+// 김광제의 설명 - 픽셀의 밝기값에 + 연산을 진행하는데 범위를 넘어가는 값은 클리핑 처리하여 경계값으로 지정한다.
+void AdjustBrightness(BYTE *Input, BYTE *Output, int nWidth, int nHeight, int nBrightness)
+{
+    int nImgSize = nWidth * nHeight; // 가로 세로를 곱하여 전체 픽셀 수를 구함
+
+    for (int i = 0; i < nImgSize; i++)
+    {
+        // 밝기값 조정
+        if (Input[i] + nBrightness > 255)    // 계산 결과가 255보다 크면
+            Output[i] = 255;                 // 최댓값 255로 설정
+        else if (Input[i] + nBrightness < 0) // 계산 결과가 0보다 작으면
+            Output[i] = 0;                   // 최솟값 0으로 설정
+        else
+            Output[i] = Input[i] + nBrightness; // 밝기값을 nBrightness만큼 조정
+    }
+
+    return;
+}
+
+/*
+ * @Function Name : AdjustContrast
+ * @Descriotion : dContrast에 설정된 값을 Pixel 단위로 *를 통한 대비값을 조정(기준 값 1)
+ * @Input : *Input, nWidth, nHeight, dContrast
+ * @Output : *Output
+ */
+// 김광제의 설명 - 대비를 조정하는것인데 dContrast가 1보다 크면 곱하기가 되고 1보다 작으면 나누기 효과를 가진다.
+// 곱하기를 하면 영상이 전체적으로 밝아지며 대비가 커지기 때문에 영상이 강렬해지는 효과과 있음
+// 반대로 나누기를 하면 전체적으로 어두워지고 대비가 작아지기 때문에 영상이 전체적으로 부드러워짐
+void AdjustContrast(BYTE *Input, BYTE *Output, int nWidth, int nHeight, double dContrast)
+{
+    int nImgSize = nWidth * nHeight; // 사이즈 구하는거임
+
+    for (int i = 0; i < nImgSize; i++)  // 전체 픽셀 순회
+        if (Input[i] * dContrast > 255) // 255보다 커지는 경우
+            Output[i] = 255;            // 경계값을 넣어줌
+        else
+            Output[i] = (BYTE)(Input[i] * dContrast); // 그렇지 않다면 연산결과를 넣어줌
+
+    return;
+}
+
+/*
+ * @Function Name : GenerateHistogram
+ * @Descriotion : 입력 이미지에 대한 히스토그램을 버퍼에 출력
+ * @Input : *Input, nWidth, nHeight, dContrast
+ * @Output : *Histogram
+ */
+// 김광제의 설명 - input[i]는 값이 들어있고 histogram은 256개가 있으며 해당 값의 갯수를 ++로 늘리는거임
+// histogram[i] 에는 값의 갯수가 들어감
+void GenerateHistogram(BYTE *Input, int *Histogram, int nWidth, int nHeight)
+{
+    int nImgSize = nWidth * nHeight; // 전체 이미지 사이즈
+    PROFILE_BEGIN(dStart);
+
+    for (int i = 0; i < nImgSize; i++) // 전체 이미지를 순회하며
+        Histogram[Input[i]]++;         // 해당 밝기값을 가지는 인덱스의 빈도수를 1씩 늘린다.
+
+    PROFILE_END(dStart, "histogram", nImgSize, nImgSize);
+    return;
+}
+
+/*
+ * @Function Name : GenerateBinarization
+ * @Descriotion : bThreshold 값을 임계값으로 하여 이진화를 진행
+ * @Input : *Input, nWidth, nHeight, bThreshold
+ * @Output : *Output
+ */
+// 김광제의 설명 - 여기에서 스레드 홀드는 곤잘레스 알고리즘으로 받아오거나 사용자에게 받아오는 방법이 사용된다.
+void GenerateBinarization(BYTE *Input, BYTE *Output, int nWidth, int nHeight, BYTE bThreshold)
+{
+
+    int nImgSize = nWidth * nHeight; // 전체 이미지 사이즈
+
+    for (int i = 0; i < nImgSize; i++)
+        if (Input[i] < bThreshold) // 임계값 보다 작다면 0으로 처리함
+            Output[i] = 0;
+        else
+            Output[i] = 255; // 임계값 보다는 크니 255
+
+    return;
+}
+
+/*
+ * @Function Name : GonzalezMethod
+ * @Description : Gonzalez-Woods Method를 사용하여 최적의 이진화 임계값을 계산합니다.
+ * @Input : *Histogram - 히스토그램 배열 포인터
+ * @Output : bThreshold - 계산된 이진화 임계값
+ */
+// 김광제의 설명 - 곤잘레스 알고리즘으로 최적의 임계값을 정하는 메소드
+BYTE GonzalezMethod(int *Histogram)
+{
+    BYTE bLow = 0, bHigh = 0;       // 영상의 최소값과 최대값
+    BYTE bThreshold, bNewThreshold; // 현재 임계값과 새로운 임계값
+    BYTE e = 2;                     // 오차값 설정 (입실론)
+
+    int nG1 = 0, nG2 = 0, nCntG1 = 0, nCntG2 = 0; // nG1, nG2는 밝기값 총합  nCntG1, nCntG2는 픽셀 개수
+    int nMeanG1, nMeanG2;                         // G1, G2의 밝기값 평균
+    PROFILE_BEGIN(dStart);
+
+    // 초기 Threshold 설정: 영상에서 가장 어두운 값부터 시작하여 최소값, 최대값 찾기
+    // 최초로 갯수가 0이 아니게 되는 수를 찾아서 그 밝기값을 넣는다.
+    // Histogram[i]는 영상에서 i 밝기값을 가지는 픽셀의 갯수가 들어간다.
+    for (int i = 0; i < 256; i++)
+    {
+        if (Histogram[i] != 0)
+        {
+            bLow = i; // 최소값 설정
+            break;    // 최소값만 찾고 바로 종료
+        }
+    }
+
+    // 가장 밝은 부분을 찾기위한 반복문으로 최초로 포함된 픽셀의 갯수가 0인 아닌곳을 찾음
+    for (int i = 255; i >= 0; i--)
+    {
+        if (Histogram[i] != 0)
+        {
+            bHigh = i; // 최대값 설정
+            break;     // 최댓값만 찾고 바로 종료
+        }
+    }
+
+    // 1. Threshold 초기값 추정: 최소값과 최대값의 중간값으로 시작
+    bThreshold = (bLow + bHigh) / 2;
+    printf("---------------------------\n");
+    printf("Initial Threshold = %d\n", bThreshold);
+
+    // 2~4번을 e보다 작을 때까지 반복: e = 2로 설정된 오차 범위 내에서 계산
+    while (1)
+    {
+        PROFILE_COUNT("gonzalez_iterations", 1);
+
+        // 2. Threshold를 기준으로 영상을 분할하여 G1, G2의 합 및 개수 계산
+        for (int i = bLow; i <= bThreshold; i++)
+        {
+            nG1 += (Histogram[i] * i); // G1의 밝기값 총합
+            nCntG1 += Histogram[i];    // G1의 픽셀 갯수
+        }
+
+        for (int i = bThreshold + 1; i <= bHigh; i++)
+        {
+            nG2 += (Histogram[i] * i); // G2의 밝기값 총합
+            nCntG2 += Histogram[i];    // G2의 픽셀 갯수
+        }
+
+        // 오류 처리: 0으로 나누기 오류 방지
+        if (nCntG1 == 0)
+            nCntG1 = 1;
+        if (nCntG2 == 0)
+            nCntG2 = 1;
+
+        // 3. G1, G2의 밝기값 평균 계산
+        nMeanG1 = nG1 / nCntG1;
+        nMeanG2 = nG2 / nCntG2;
+
+        // 4. 새로운 임계값 계산
+        bNewThreshold = (nMeanG1 + nMeanG2) / 2;
+
+        // 5. 오차가 e보다 작은지 검사하여 최종 Threshold 결정
+        if (abs(bNewThreshold - bThreshold) < e) // 원래 임계값에서 새로운 임계값을 빼서 절대값으로 e보다 작아야됨
+        {
+            bThreshold = bNewThreshold; // 오차 범위 내에서 Threshold 결정
+            break;                      // 미리 정해둔 오차보다 작은 임계값을 찾았기 때문에 반복분 종료
+        }
+        else
+        {
+            bThreshold = bNewThreshold;                    // 새로운 Threshold 설정 하고 이 경우에는 새로운 임계값을 기준으로 다시 돌려야됨
+            printf("New Threshold = %d\n", bNewThreshold); // 계산된 새로운 Threshold 출력
+        }
+
+        // 반복을 위해 변수 초기화
+        nG1 = nG2 = nCntG1 = nCntG2 = 0;
+    }
+
+    printf("Last Threshold = %d\n", bThreshold); // 최종 결정된 Threshold 출력
+    PROFILE_END(dStart, "gonzalez", 0, 256 * sizeof(int));
+    return bThreshold;                           // 최종적으로 결정된 이진화 임계값 반환
+}
+
+/*
+ * @Function Name : OtsuMethod
+ * @Description : Otsu Method를 사용하여 클래스 간 분산이 최대가 되는 이진화 임계값을 계산합니다.
+ * @Input : *Histogram - 히스토그램 배열 포인터
+ * @Output : bThreshold - 계산된 이진화 임계값 (bThreshold보다 작은 밝기값이 배경)
+ */
+// 김광제의 설명 - 곤잘레스 방법은 수렴할 때까지 히스토그램을 반복해서 돌지만 오츠 방법은 누적합을 한번만 돌면서 모든 임계값 후보를 평가한다.
+// 클래스 간 분산 = (S0 X T - S X W0)^2 / (W0 X W1)  (W0, W1 : 두 구간의 픽셀 수, S0 : 앞 구간 밝기값 합, S : 전체 밝기값 합, T : 전체 픽셀 수)
+// 반복 횟수가 영상에 상관없이 256번으로 고정되기 때문에 처리 시간이 일정하다.
+BYTE OtsuMethod(int *Histogram)
+{
+    double dTotal = 0.0, dSum = 0.0; // 전체 픽셀 수, 전체 밝기값 합
+    double dW0 = 0.0, dSum0 = 0.0;   // 0 ~ k 구간의 누적 픽셀 수, 누적 밝기값 합
+    double dW1, dBetween;            // k+1 ~ 255 구간의 픽셀 수, 클래스 간 분산
+    double dMaxBetween = -1.0;       // 지금까지 찾은 최대 클래스 간 분산
+    int nBest = 0;                   // 최대 분산을 만드는 앞 구간의 마지막 밝기값
+    PROFILE_BEGIN(dStart);
+
+    for (int i = 0; i < 256; i++)
+    {
+        dTotal += Histogram[i];
+        dSum += (double)i * Histogram[i];
+    }
+
+    // 앞 구간을 0 ~ k로 잡고 k를 하나씩 늘려가며 누적합만 갱신한다.
+    for (int k = 0; k < 255; k++)
+    {
+        dW0 += Histogram[k];
+        dSum0 += (double)k * Histogram[k];
+        dW1 = dTotal - dW0;
+
+        if (dW0 == 0.0 || dW1 == 0.0) // 한쪽 구간이 비어있으면 분할이 아님
+            continue;
+
+        dBetween = (dSum0 * dTotal - dSum * dW0) * (dSum0 * dTotal - dSum * dW0) / (dW0 * dW1);
+        if (dBetween > dMaxBetween)
+        {
+            dMaxBetween = dBetween;
+            nBest = k;
+        }
+    }
+
+    // GenerateBinarization은 임계값보다 작은 값을 0으로 보내기 때문에 앞 구간의 마지막 값 + 1을 임계값으로 반환
+    PROFILE_END(dStart, "otsu", 0, 256 * sizeof(int));
+    return (BYTE)(nBest + 1);
+}
+
+/*
+ * @Function Name : MultiOtsuMethod
+ * @Description : Multi Otsu Method로 nThresholds(1~4)개의 임계값을 계산합니다.
+ * @Input : *Histogram - 히스토그램 배열 포인터,
+ *          nThresholds - 구할 임계값의 개수 (1 ~ MAX_OTSU_THRESHOLDS)
+ * @Output : *Thresholds - 오름차순으로 정렬된 임계값 배열, 반환값 0 (성공) / -1 (입력 오류)
+ */
+// 김광제의 설명 - 클래스 간 분산은 각 구간의 (밝기값 합)^2 / (픽셀 수)를 더한 값이 최대일 때 최대가 된다.
+// 구간별 값이 서로 독립적으로 더해지기 때문에 동적 계획법으로 구할 수 있음
+// Best[m][t] = 0 ~ t 밝기값을 m개의 구간으로 나누었을 때의 최대값
+// Best[m][t] = max( Best[m-1][s] + Cost(s+1, t) )  (s < t)
+// 모든 조합을 검사하면 256^4 번이지만 이렇게 하면 구간 수 X 256 X 256 번으로 끝난다.
+int MultiOtsuMethod(int *Histogram, BYTE *Thresholds, int nThresholds)
+{
+    double dCnt[257], dSum[257];                  // 누적 픽셀 수, 누적 밝기값 합 (dCnt[i] = 0 ~ i-1 까지의 합)
+    double dBest[MAX_OTSU_THRESHOLDS + 1][256];   // 구간 수별 최대값
+    short nArg[MAX_OTSU_THRESHOLDS + 1][256];     // 최대값을 만든 이전 구간의 끝 위치 (역추적용)
+    int nClass = nThresholds + 1;                 // 나눌 구간의 개수
+    double dCnt_st, dSum_st, dValue;
+    int m, s, t;
+
+    PROFILE_BEGIN(dStart);
+
+    if (nThresholds < 1 || nThresholds > MAX_OTSU_THRESHOLDS)
+        return (-1);
+
+    // 누적 배열은 한번만 계산한다.
+    dCnt[0] = dSum[0] = 0.0;
+    for (int i = 0; i < 256; i++)
+    {
+        dCnt[i + 1] = dCnt[i] + Histogram[i];
+        dSum[i + 1] = dSum[i] + (double)i * Histogram[i];
+    }
+
+    // 구간이 하나일 때는 0 ~ t 전체가 하나의 구간
+    for (t = 0; t < 256; t++)
+    {
+        dBest[0][t] = (dCnt[t + 1] > 0.0) ? dSum[t + 1] * dSum[t + 1] / dCnt[t + 1] : 0.0;
+        nArg[0][t] = -1;
+    }
+
+    // 구간을 하나씩 늘려가면서 마지막 구간 (s+1 ~ t)의 시작 위치를 모두 검사
+    for (m = 1; m < nClass; m++)
+    {
+        for (t = 0; t < 256; t++)
+        {
+            dBest[m][t] = -1.0;
+            nArg[m][t] = -1;
+
+            for (s = m - 1; s < t; s++) // 앞의 m개 구간이 최소 한 칸씩은 차지해야 함
+            {
+                dCnt_st = dCnt[t + 1] - dCnt[s + 1];
+                dSum_st = dSum[t + 1] - dSum[s + 1];
+                dValue = dBest[m - 1][s] + ((dCnt_st > 0.0) ? dSum_st * dSum_st / dCnt_st : 0.0);
+
+                if (dValue > dBest[m][t])
+                {
+                    dBest[m][t] = dValue;
+                    nArg[m][t] = (short)s;
+                }
+            }
+        }
+    }
+
+    // 마지막 구간부터 역추적하면서 구간의 경계를 임계값으로 저장
+    // 경계 s는 앞 구간의 마지막 밝기값이므로 s + 1이 임계값이 된다. (GenerateBinarization과 동일한 기준)
+    t = 255;
+    for (m = nClass - 1; m > 0; m--)
+    {
+        s = nArg[m][t];
+        Thresholds[m - 1] = (BYTE)(s + 1);
+        t = s;
+    }
+
+    PROFILE_END(dStart, "multi_otsu", 0, 256 * sizeof(int));
+    return 0;
+}
+
+/*
+ * @Function Name : SelectThreshold
+ * @Description : nMethod에 따라 Gonzalez 또는 Otsu 방법으로 이진화 임계값을 선택합니다.
+ * @Input : *Histogram - 히스토그램 배열 포인터,
+ *          nMethod - THRESHOLD_GONZALEZ, THRESHOLD_OTSU
+ * @Output : bThreshold - 선택된 이진화 임계값
+ */
+// 김광제의 설명 - 이진화 진입점에서 임계값 결정 방법을 바꿀 수 있도록 한 곳으로 모아둠
+BYTE SelectThreshold(int *Histogram, int nMethod)
+{
+    if (nMethod == THRESHOLD_OTSU)
+        return OtsuMethod(Histogram);
+
+    return GonzalezMethod(Histogram);
+}
+
+/*
+ * @Function Name : GenerateAutoBinarization
+ * @Description : 히스토그램을 생성하고 nMethod로 선택한 임계값으로 이진화를 진행합니다.
+ * @Input : *Input, nWidth, nHeight, nMethod
+ * @Output : *Output, 반환값 - 사용한 임계값
+ */
+// 김광제의 설명 - 히스토그램 생성 -> 임계값 선택 -> 이진화를 한번에 수행
+BYTE GenerateAutoBinarization(BYTE *Input, BYTE *Output, int nWidth, int nHeight, int nMethod)
+{
+    int nHisto[256] = {
+        0,
+    };
+    BYTE bThreshold;
+    PROFILE_BEGIN(dStart);
+
+    GenerateHistogram(Input, nHisto, nWidth, nHeight);
+    bThreshold = SelectThreshold(nHisto, nMethod);
+    GenerateBinarization(Input, Output, nWidth, nHeight, bThreshold);
+
+    PROFILE_END(dStart, "auto_binarization", (long long)nWidth * nHeight, (long long)nWidth * nHeight * 3);
+    return bThreshold;
+}
+
+/*
+ * @Function Name : GenerateMultiLevelBinarization
+ * @Description : 여러 개의 임계값으로 영상을 nThresholds + 1 단계의 밝기로 나눕니다.
+ * @Input : *Input, nWidth, nHeight, *Thresholds(오름차순), nThresholds
+ * @Output : *Output
+ */
+// 김광제의 설명 - 밝기값 v가 몇 번째 구간에 속하는지를 미리 256개짜리 표(LUT)로 만들어두고 픽셀마다 표를 참조만 한다.
+// 구간 c는 c X 255 / nThresholds 밝기로 출력 (0, ..., 255로 균등하게 배치)
+void GenerateMultiLevelBinarization(BYTE *Input, BYTE *Output, int nWidth, int nHeight, BYTE *Thresholds, int nThresholds)
+{
+    int nImgSize = nWidth * nHeight;
+    BYTE LUT[256];
+    int nClass = 0; // 현재 밝기값이 속한 구간
+    PROFILE_BEGIN(dStart);
+
+    for (int v = 0; v < 256; v++)
+    {
+        // 임계값 이상이 되면 다음 구간으로 넘어감
+        while (nClass < nThresholds && v >= Thresholds[nClass])
+            nClass++;
+        LUT[v] = (BYTE)(nClass * 255 / nThresholds);
+    }
+
+    for (int i = 0; i < nImgSize; i++)
+        Output[i] = LUT[Input[i]];
+
+    PROFILE_END(dStart, "multi_level_binarization", nImgSize, (long long)nImgSize * 2);
+    return;
+}
+
+/*
+ * @Function Name : HistogramStretching
+ * @Description : 히스토그램 스트래칭을 수행합니다.
+ * @Input : *Input - 입력 이미지 데이터 배열을 가리키는 포인터,
+ *          *Histogram - 입력 이미지의 히스토그램을 가리키는 포인터,
+ *          nWidth - 이미지의 너비 (픽셀 단위),
+ *          nHeight - 이미지의 높이 (픽셀 단위)
+ * @Output : *Output - 출력 이미지 데이터 배열을 가리키는 포인터
+ */
+// 김광제의 설명 - 히스토그램을 0~255로 스트레칭하는것이 아닌 하이와 로우를 잡고서 로우보다 작으면 0으로 보내버리고서 로우보다는 클때 연산
+void HistogramStretching(BYTE *Input, BYTE *Output, int *Histogram, int nWidth, int nHeight)
+{
+    int ImgSize = nWidth * nHeight; // 이미지 크기 계산
+    BYTE Low = 0, High = 255;       // 히스토그램의 최소값과 최대값 (빈 히스토그램이면 그대로)
+
+    // 히스토램에서 갯수가 최초로 0이 아닌 밝기 값을 찾아 최소값으로 설정
+    for (int i = 0; i < 256; i++)
+    {
+        if (Histogram[i] != 0)
+        {
+            Low = i; // 밝기값 저장
+            break;
+        }
+    }
+
+    // 히스토그램에서 갯수가 최초로 0이 아닌 밝기 값을 찾아 최대값으로 설정
+    for (int i = 255; i >= 0; i--)
+    {
+        if (Histogram[i] != 0)
+        {
+            High = i; // 밝기값 저장
+            break;
+        }
+    }
+
+    // 히스토그램 스트래칭을 수행하여 출력 이미지 생성
+    for (int i = 0; i < ImgSize; i++)
+    {
+        // Input[i] - Low = 밝기의 최소값이 0이 되도록 설정
+        // High-Low = 최대 밝기 값과 최소 밝기 값의 차이
+        // X 255 = 밝기 값을 0 ~ 255 범위로 스케일링
+        // 입력 이미지의 각 픽셀 값을 히스토그램의 최소값부터 최대값 사이로 스케일링하여 출력
+        if (Input[i] <= Low)
+        {
+            Output[i] = 0; // 최소값 이하는 0으로 설정하여 검은색 부분 강조
+        }
+        // 로우보다 크고 하이보다 작은 값들사이에서 스트레칭
+        else
+        {
+            // 입력 값들을 히스토그램의 최소값과 최대값 사이로 스케일링하여 출력
+            Output[i] = (BYTE)((Input[i] - Low) / (double)(High - Low) * 255.0);
+        }
+    }
+
+    return;
+}
+
+/*
+ * @Function Name : HistogramEqualization
+ * @Descriotion : 히스토그램 평활화를 수행
+ * @Input : *Input, *Histigrnam, nWidth, nHeight
+ * @Output : *Output
+ */
+// 김광제의 설명 - Gmax는 흑백 영상에서 255로 고정
+// 정규화합 공식 - (영상의 최대 밝기값(255) / 총 픽셀) X 해당 픽셀의 누적합
+// 정규화합으로 그리는 히스토그램은 255에 가까워질수록 누적합이 계속해서 커지므로 이미지의 밝기 대비가 향상되어 전체적으로 밝은 부분이 더 강조될 수 있다.
+void HistogramEqualization(BYTE *Input, BYTE *Output, int *Histogram, int nWidth, int nHeight)
+{
+    int ImgSize = nWidth * nHeight;
+
+    int Nt = ImgSize; // 총 픽셀수로 이미지 크기와 같음
+    int Gmax = 255;   // 흑백 이미지에서 최대 밝기 레벨
+
+    double Ratio = Gmax / (double)Nt; // 최대 밝기 레벨을 전체 픽셀 수로 나눈 비율
+    BYTE NormSum[256];                // 정규화된 누적 히스토그램을 저장할 배열
+
+    int AHistogram[256] = {
+        0,
+    }; // 누적 히스토그램을 저장할 배열로 누적값이 들어감
+
+    // 누적 히스토그램 계산 (값 밝기값의 누적값을 계산함)
+    // AHistogram[i] = AHistogram[i - 1] + Histogram[i] 이므로 2중 반복문 없이 바로 앞의 누적값에 더하기만 하면 된다.
+    // Histogram은 밝기값의 갯수가 들어가있음
+    AHistogram[0] = Histogram[0];
+    for (int i = 1; i < 256; i++)
+    {
+        AHistogram[i] = AHistogram[i - 1] + Histogram[i]; // 최대 밝기 레벨 255까지 히스토그램 값들을 저장
+    } // AHistorgram[255]는 전체 픽셀 수 Nt와 같음
+
+    // 최종적으로 정규화된 누적 히스토그램 계산
+    // 누적 히스토그램의 각 값에 Ratio를 곱해서 0~255 까지 정규화 진행
+    for (int i = 0; i < 256; i++)
+    {
+        NormSum[i] = (BYTE)(Ratio * AHistogram[i]);
+    } // AHistorgram[255] X (Gmax / Nt ) = Nt X ( Gmax / Nt ) = Gmax = 255
+
+    // Input의 각 픽셀값에 대응하는 정규화된 히스토그램 값을 Output에 저장
+    for (int i = 0; i < ImgSize; i++)
+    {
+        Output[i] = NormSum[Input[i]];
+    }
+
+    return;
+}
+
+/*
+ * @Function Name : ImgCLAHE
+ * @Description : 영상을 nTilesX X nTilesY개의 타일로 나누어 타일별로 대비 제한 히스토그램 평활화를 수행합니다.
+ * @Input : *pIn - 8비트 그레이 영상 (ROI 가능),
+ *          nTilesX, nTilesY - 가로, 세로 타일 개수,
+ *          dClipLimit - 대비 제한 값 (평균 빈도수의 몇 배까지 허용할지, 0 이하이면 제한 없음)
+ * @Output : *pOut - 같은 크기의 8비트 그레이 영상, 반환값 0 (성공) / -1 (입력 오류, 메모리 할당 오류)
+ */
+// 김광제의 설명 - HistogramEqualization은 영상 전체를 하나의 히스토그램으로 평활화해서 국부적인 대비는 살리지 못한다.
+// 1. 타일마다 히스토그램을 구하고 (타일끼리는 독립적이라 병렬 처리)
+// 2. 빈도수가 제한값을 넘는 부분은 잘라서 전체 밝기값에 골고루 나눠준다. (잡음이 과하게 강조되는 것을 막음)
+// 3. 잘라낸 히스토그램의 누적합으로 타일별 LUT(변환표)를 만든다.
+// 4. 픽셀마다 주변 4개 타일 중심의 LUT 결과를 거리에 따라 선형 보간한다. (타일 경계에 계단 현상이 생기지 않음)
+int ImgCLAHE(const IMAGE *pIn, IMAGE *pOut, int nTilesX, int nTilesY, double dClipLimit)
+{
+    int nWidth = pIn->nWidth, nHeight = pIn->nHeight;
+    int nTiles = nTilesX * nTilesY;
+    int *pHisto, *pX0, *pX1, *pWX; // 타일별 히스토그램, 열별 좌우 타일 번호와 보간 가중치
+    BYTE *pLUT;                    // 타일별 LUT
+    ARENA Arena;                   // 위 임시 버퍼들을 한번에 반납하기 위한 아레나
+    PROFILE_BEGIN(dStart);
+
+    if (pIn->nFormat != PIXEL_GRAY8 || pOut->nFormat != PIXEL_GRAY8 || pOut->nWidth != nWidth || pOut->nHeight != nHeight)
+        return (-1);
+    if (nTilesX < 1 || nTilesY < 1 || nTilesX > nWidth || nTilesY > nHeight)
+        return (-1);
+
+    ArenaInit(&Arena, GetThreadPool(), 0);
+    pHisto = (int *)ArenaAlloc(&Arena, (size_t)nTiles * 256 * sizeof(int), 1); // 히스토그램만 0으로 초기화 필요
+    pLUT = (BYTE *)ArenaAlloc(&Arena, (size_t)nTiles * 256, 0);
+    pX0 = (int *)ArenaAlloc(&Arena, nWidth * sizeof(int), 0);
+    pX1 = (int *)ArenaAlloc(&Arena, nWidth * sizeof(int), 0);
+    pWX = (int *)ArenaAlloc(&Arena, nWidth * sizeof(int), 0);
+
+    if (NULL == pHisto || NULL == pLUT || NULL == pX0 || NULL == pX1 || NULL == pWX)
+    {
+        ArenaReset(&Arena);
+        return (-1);
+    }
+
+    // 1 ~ 3. 타일별 히스토그램 -> 클리핑 -> LUT (타일 단위로 병렬 처리)
+#pragma omp parallel for schedule(dynamic)
+    for (int t = 0; t < nTiles; t++)
+    {
+        int tx = t % nTilesX, ty = t / nTilesX;
+        // 타일의 영역 (x0 <= x < x1, y0 <= y < y1)
+        int x0 = tx * nWidth / nTilesX, x1 = (tx + 1) * nWidth / nTilesX;
+        int y0 = ty * nHeight / nTilesY, y1 = (ty + 1) * nHeight / nTilesY;
+        int nArea = (x1 - x0) * (y1 - y0);
+        int *Histogram = pHisto + t * 256;
+        int nClip, nExcess = 0, nAdd, nRest, nSum = 0;
+
+        // 1. 타일 영역을 한번만 돌면서 히스토그램 생성
+        for (int i = y0; i < y1; i++)
+        {
+            const BYTE *pRow = pIn->pPlane[0] + (size_t)i * pIn->nStride;
+            for (int j = x0; j < x1; j++)
+                Histogram[pRow[j]]++;
+        }
+
+        // 2. 클리핑 : 평균 빈도수(nArea / 256) X dClipLimit 을 넘는 부분을 잘라냄
+        if (dClipLimit > 0.0)
+        {
+            nClip = (int)(dClipLimit * nArea / 256.0);
+            if (nClip < 1)
+                nClip = 1;
+
+            for (int v = 0; v < 256; v++)
+            {
+                if (Histogram[v] > nClip)
+                {
+                    nExcess += Histogram[v] - nClip;
+                    Histogram[v] = nClip;
+                }
+            }
+
+            // 잘라낸 개수를 모든 밝기값에 똑같이 나눠주고 나머지는 일정한 간격으로 하나씩 더해준다.
+            nAdd = nExcess / 256;
+            nRest = nExcess % 256;
+            for (int v = 0; v < 256; v++)
+                Histogram[v] += nAdd;
+            if (nRest > 0)
+            {
+                for (int v = 0, nStep = 256 / nRest; v < 256 && nRest > 0; v += nStep, nRest--)
+                    Histogram[v]++;
+            }
+        }
+
+        // 3. 누적합을 0 ~ 255로 정규화하여 LUT 생성 (HistogramEqualization과 같은 공식)
+        for (int v = 0; v < 256; v++)
+        {
+            nSum += Histogram[v];
+            pLUT[t * 256 + v] = (BYTE)(255.0 * nSum / nArea + 0.5);
+        }
+    }
+
+    // 4. 보간에 필요한 열별 좌우 타일 번호와 가중치는 미리 구해둔다. (픽셀마다 나눗셈을 하지 않기 위함)
+    // 가중치는 0 ~ 256 정수로 저장하여 보간을 정수 연산으로 처리한다.
+    for (int j = 0; j < nWidth; j++)
+    {
+        double dPos = (j + 0.5) * nTilesX / nWidth - 0.5; // 타일 중심을 기준으로 한 좌표
+        int nT0 = (int)floor(dPos);
+
+        if (nT0 < 0) // 첫번째 타일 중심보다 왼쪽
+        {
+            pX0[j] = pX1[j] = 0;
+            pWX[j] = 0;
+        }
+        else if (nT0 >= nTilesX - 1) // 마지막 타일 중심보다 오른쪽
+        {
+            pX0[j] = pX1[j] = nTilesX - 1;
+            pWX[j] = 0;
+        }
+        else
+        {
+            pX0[j] = nT0;
+            pX1[j] = nT0 + 1;
+            pWX[j] = (int)((dPos - nT0) * 256.0 + 0.5);
+        }
+    }
+
+    // 행 단위로 병렬 처리
+#pragma omp parallel for
+    for (int i = 0; i < nHeight; i++)
+    {
+        double dPos = (i + 0.5) * nTilesY / nHeight - 0.5;
+        int nT0 = (int)floor(dPos), nY0, nY1, nWY;
+        BYTE *pRow0, *pRow1, *pSrc = pIn->pPlane[0] + (size_t)i * pIn->nStride, *pDst = pOut->pPlane[0] + (size_t)i * pOut->nStride;
+
+        if (nT0 < 0)
+        {
+            nY0 = nY1 = 0;
+            nWY = 0;
+        }
+        else if (nT0 >= nTilesY - 1)
+        {
+            nY0 = nY1 = nTilesY - 1;
+            nWY = 0;
+        }
+        else
+        {
+            nY0 = nT0;
+            nY1 = nT0 + 1;
+            nWY = (int)((dPos - nT0) * 256.0 + 0.5);
+        }
+
+        pRow0 = pLUT + nY0 * nTilesX * 256; // 위쪽 타일 줄의 LUT
+        pRow1 = pLUT + nY1 * nTilesX * 256; // 아래쪽 타일 줄의 LUT
+
+        for (int j = 0; j < nWidth; j++)
+        {
+            int v = pSrc[j];
+            // 주변 4개 타일의 LUT 결과
+            int a = pRow0[pX0[j] * 256 + v], b = pRow0[pX1[j] * 256 + v];
+            int c = pRow1[pX0[j] * 256 + v], d = pRow1[pX1[j] * 256 + v];
+            int wx = pWX[j];
+
+            // 가로로 보간한 뒤 세로로 보간 (가중치 합이 256 X 256 이므로 16비트 시프트 + 반올림)
+            pDst[j] = (BYTE)(((256 - nWY) * ((256 - wx) * a + wx * b) + nWY * ((256 - wx) * c + wx * d) + 32768) >> 16);
+        }
+    }
+
+    ArenaReset(&Arena);
+
+    PROFILE_END(dStart, "clahe", (long long)nWidth * nHeight, (long long)nWidth * nHeight * 2);
+    return 0;
+}
+
+/*
+ * @Function Name : CLAHE
+ * @Description : 연속된 8비트 버퍼에 대해 ImgCLAHE를 수행합니다.
+ * @Input : *Input, nWidth, nHeight, nTilesX, nTilesY, dClipLimit
+ * @Output : *Output, 반환값 0 (성공) / -1 (입력 오류, 메모리 할당 오류)
+ */
+int CLAHE(BYTE *Input, BYTE *Output, int nWidth, int nHeight, int nTilesX, int nTilesY, double dClipLimit)
+{
+    IMAGE In, Out;
+
+    WrapImage(&In, Input, nWidth, nHeight, PIXEL_GRAY8, 0);
+    WrapImage(&Out, Output, nWidth, nHeight, PIXEL_GRAY8, 0);
+
+    return ImgCLAHE(&In, &Out, nTilesX, nTilesY, dClipLimit);
+}
+
+/*
+ * @Function Name : AverageConvolution
+ * @Description : 평균 커널을 적용한 컨볼루션 연산을 수행합니다.
+ * @Input : *Input - 입력 이미지 데이터 배열 포인터,
+ *          nWidth - 이미지의 너비 (픽셀 단위),
+ *          nHeight - 이미지의 높이 (픽셀 단위)
+ * @Output : *Output - 출력 이미지 데이터 배열 포인터
+ */
+// 김광제의 설명 - 입력과 필터에서는 0,0부터 계산하지만 아웃풋을 1,1로 정해두었기 떄문에 마진이 생김
+// nWidth와 nHeight는 영상의 가로 세로 길이
+// 가우시안과 평활화는 평균값을(소수임) 사용하기 때문에 범위를 넘지않음
+// 가우시안 잡음 없애는데 효과적임
+// 경계면을 뭉개기 떄문에 경계면이 부드러워짐
+void AverageConvolution(BYTE *Input, BYTE *Output, int nWidth, int nHeight)
+{
+    double SumProduct = 0.0; // 컨볼루션 연산 결과를 저장할 변수
+
+    // Convolution Center를 (1,1)로 설정하기 위해 1부터 시작하여 n-1까지 진행합니다.
+    // 이 경우 이미지의 가장자리에 마진이 생김
+    for (int i = 1; i < nHeight - 1; i++)
+    { // 이미지의 y 행을 순회
+        for (int j = 1; j < nWidth - 1; j++)
+        { // 이미지의 x 열을 순회
+            for (int m = -1; m <= 1; m++)
+            { // 커널의 열을 순회합니다. (중요) 2차원 배열의 기준점을 (0,0)으로 설정하기 위해 (-1, -1)부터 시작합니다.
+                for (int n = -1; n <= 1; n++)
+                { // 커널의 행을 순회합니다.
+                    // 입력 이미지와 커널을 이용하여 컨볼루션 연산을 수행합니다.
+                    // 입력 이미지의 0,0과 AvgKernel의 0,0부터 시작해서 2,2까지 계산하여 전부 더한 값을 넣는다.
+                    // AvgKernel에서 m과 n은 -1부터 시작하기때문에 +1을 해줘야된다.
+                    SumProduct += Input[(i + m) * nWidth + (j + n)] * AvgKernel[m + 1][n + 1]; // 입력 이미지와 커널을 곱하고 합산합니다.
+                }
+            }
+            // i * nWidth + j는 2차원 배열에서 원하는 인덱스를 잡음
+            // 1,1 부터 값이 들어감
+            Output[i * nWidth + j] = (BYTE)SumProduct; // 컨볼루션 연산 결과를 출력 이미지에 저장합니다. (중요) 2차원 배열을 1차원 배열로 변환하여 저장합니다.
+            SumProduct = 0.0;                          // SumProduct 변수를 초기화합니다.
+        }
+    }
+
+    return;
+}
+
+/*
+ * @Function Name : GaussianConvolution
+ * @Descriotion : Gaussian Kernel을 적용한 Convolution
+ * @Input : *Input, nWidth, nHeight
+ * @Output : *Output
+ */
+// 김광제의 설명 - AvgKernel과 과정과 연산이 모두 일치하지만 커널의 픽셀값이 다르기 때문에 결과는 다르다.
+// 가우시안과 평활화는 평균값을(소수임) 사용하기 때문에 범위를 넘지않음
+// 가우시안 커널은 잡음을 없애기 위해 사용하는 경우도 있고. 고주파 및 저주파 성분을 동시에 잡아 이미지의 부드러움을 조절하는데 사용
+void GaussianConvolution(BYTE *Input, BYTE *Output, int nWidth, int nHeight)
+{
+    double SumProduct = 0.0;
+
+    // Convolution Center를 (1,1)로 잡기 위해 1부터 시작, n-1까지 진행
+    // 아웃풋 영상에 1,1부터 값이 들어가게됨
+    for (int i = 1; i < nHeight - 1; i++)
+    { // y 행
+        for (int j = 1; j < nWidth - 1; j++)
+        { // x
+            for (int m = -1; m <= 1; m++)
+            { // kernel의 행
+                for (int n = -1; n <= 1; n++)
+                { // kernel의 열
+                    // 입력 이미지와 커널을 이용하여 컨볼루션 연산을 수행합니다.
+                    // 입력 이미지의 0,0과 GaussKernel의 0,0부터 시작해서 2,2까지 계산하여 전부 더한 값을 넣는다.
+                    // GaussKernel에서 m과 n은 -1부터 시작하기때문에 +1을 해줘야된다.
+                    // AvgKernel과 연산은 같지만 커널의 값이 다르니 결과도 다르다. 결국 전부 곱하고 더한값을 넣음
+                    SumProduct += Input[(i + m) * nWidth + (j + n)] * GaussKernel[m + 1][n + 1]; // y * 전체 x + x
+                }
+            }
+            Output[i * nWidth + j] = (BYTE)SumProduct;
+            SumProduct = 0.0; // 초기화
+        }
+    }
+
+    return;
+}
+
+/*
+ * @Function Name : LaplacianConvolution
+ * @Descriotion : Laplacian Kernel을 적용한 Edge 검출 Convolution
+ * @Input : *Input, nWidth, nHeight
+ * @Output : *Output
+ */
+// 김광제의 설명 - 이미지의 높은 주파수 성분을 감지하고 강조하는데 사용
+// 범위를 벗어날수있다 그렇기때문에 범위를 다시 조정해줘야됨
+// 경계값이 인풋영상보다는 작아지지만 경계의 8방향의 픽셀들이 더 작은 값으로 변하기때문에 경계가 돋보임
+void LaplacianConvolution(BYTE *Input, BYTE *Output, int nWidth, int nHeight)
+{
+    double SumProduct = 0.0;
+
+    // Convolution Center를 (1,1)로 잡기 위해 1부터 시작, n-1까지 진행
+    for (int i = 1; i < nHeight - 1; i++)
+    { // y 행
+        for (int j = 1; j < nWidth - 1; j++)
+        { // x
+            for (int m = -1; m <= 1; m++)
+            { // kernel의 행
+                for (int n = -1; n <= 1; n++)
+                {
+                    // 입력 이미지와 커널을 이용하여 컨볼루션 연산을 수행합니다.
+                    // 입력 이미지의 0,0과 LaplacianKernel의 0,0부터 시작해서 2,2까지 계산하여 전부 더한 값을 넣는다.
+                    // LaplacianKernel에서 m과 n은 -1부터 시작하기때문에 +1을 해줘야된다.                                                                   // kernel의 열
+                    SumProduct += Input[(i + m) * nWidth + (j + n)] * LaplacianKernel[m + 1][n + 1]; // y * 전체 x + x
+                }
+            }
+
+            // 라플라시안 커널에는 현재 -1 8개와 8 1개가 들어가서 총 합이 0이 되어 높은 주파수 성분을 감지하고 강조한다.
+            //  0 ~ +- 2040 값이 나오기 때문에, 절대값 / 8을 취하여 0 ~ 255 값으로 조정
+            Output[i * nWidth + j] = abs((long)SumProduct) / 8;
+            SumProduct = 0.0; // 초기화
+        }
+    }
+
+    return;
+}
+
+/*
+ * @Function Name : X_PrewittConvolution
+ * @Descriotion : X_Prewitt Kernel을 적용한 Edge 검출 Convolution
+ * @Input : *Input, nWidth, nHeight
+ * @Output : *Output
+ */
+// 김광제의 설명 - 프리윗은 경계를 검출하기 위해서 사용한다.
+// X는 오른쪽으로 값이 바뀐다. 1차원으로 표시하면 [-1, 0, 1     -1, 0, 1      -1, 0, 1]
+// Y방향으로 라인이 생기고 값이 변하는건 아웃풋의 X라인이다.
+void X_PrewittConvolution(BYTE *Input, BYTE *Output, int nWidth, int nHeight)
+{
+    double SumProduct = 0.0;
+
+    // Convolution Center를 (1,1)로 잡기 위해 1부터 시작, n-1까지 진행
+    for (int i = 1; i < nHeight - 1; i++)
+    { // y 행
+        for (int j = 1; j < nWidth - 1; j++)
+        { // x
+            for (int m = -1; m <= 1; m++)
+            { // kernel의 행
+                for (int n = -1; n <= 1; n++)
+                { // kernel의 열
+                    // 입력 이미지와 커널을 이용하여 컨볼루션 연산을 수행합니다.
+                    // 입력 이미지의 0,0과 PrewittKernel_X의 0,0부터 시작해서 2,2까지 계산하여 전부 더한 값을 넣는다.
+                    // PrewittKernel_X에서 m과 n은 -1부터 시작하기때문에 +1을 해줘야된다.
+                    SumProduct += Input[(i + m) * nWidth + (j + n)] * PrewittKernel_X[m + 1][n + 1]; // y * 전체 x + x
+                }
+            }
+
+            // 0 ~ +- 765 값이 나오기 때문에, 절대값 / 3을 취하여 0 ~ 255 값으로 조정
+            Output[i * nWidth + j] = abs((long)SumProduct) / 3;
+            SumProduct = 0.0; // 초기화
+        }
+    }
+
+    return;
+}
+
+/*
+ * @Function Name : Y_PrewittConvolution
+ * @Descriotion : Y_Prewitt Kernel을 적용한 Edge 검출 Convolution
+ * @Input : *Input, nWidth, nHeight
+ * @Output : *Output
+ */
+// 김광제의 설명 - Y는 오른쪽으로 값이 바뀐다. 1차원으로 표시하면 [-1, -1, -1    0, 0, 0     1, 1, 1]
+// X방향으로 라인이 생기고 값이 변하는건 아웃풋의 Y라인이다.
+void Y_PrewittConvolution(BYTE *Input, BYTE *Output, int nWidth, int nHeight)
+{
+    double SumProduct = 0.0;
+
+    // Convolution Center를 (1,1)로 잡기 위해 1부터 시작, n-1까지 진행
+    for (int i = 1; i < nHeight - 1; i++)
+    { // y 행
+        for (int j = 1; j < nWidth - 1; j++)
+        { // x
+            for (int m = -1; m <= 1; m++)
+            { // kernel의 행
+                for (int n = -1; n <= 1; n++)
+                {
+                    // 입력 이미지와 커널을 이용하여 컨볼루션 연산을 수행합니다.
+                    // 입력 이미지의 0,0과 PrewittKernel_Y의 0,0부터 시작해서 2,2까지 계산하여 전부 더한 값을 넣는다.
+                    // PrewittKernel_Y에서 m과 n은 -1부터 시작하기때문에 +1을 해줘야된다.                                                                                    // kernel의 열
+                    SumProduct += Input[(i + m) * nWidth + (j + n)] * PrewittKernel_Y[m + 1][n + 1]; // y * 전체 x + x
+                }
+            }
+
+            // 0 ~ +- 765 값이 나오기 때문에, 절대값 / 3을 취하여 0 ~ 255 값으로 조정
+            Output[i * nWidth + j] = abs((long)SumProduct) / 3;
+            SumProduct = 0.0; // 초기화
+        }
+    }
+
+    return;
+}
+
+/*
+ * @Function Name : X_SobelConvolution
+ * @Descriotion : X_Sobel Kernel을 적용한 Edge 검출 Convolution
+ * @Input : *Input, nWidth, nHeight
+ * @Output : *Output
+ */
+// 김광제의 설명 - Sobel이 Prewitt보다 더 날카로운 경계를 검출한다
+// Sobel은 Prewitt과 다르게 [-1,0,1   -2,0,2   -1,0,1] 이렇게 중간에 2를 사용하여 더 날카롭게 나옴
+void X_SobelConvolution(BYTE *Input, BYTE *Output, int nWidth, int nHeight)
+{
+    double SumProduct = 0.0;
+
+    // Convolution Center를 (1,1)로 잡기 위해 1부터 시작, n-1까지 진행
+    for (int i = 1; i < nHeight - 1; i++)
+    { // y 행
+        for (int j = 1; j < nWidth - 1; j++)
+        { // x
+            for (int m = -1; m <= 1; m++)
+            { // kernel의 행
+                for (int n = -1; n <= 1; n++)
+                { // kernel의 열
+                    // 입력 이미지와 커널을 이용하여 컨볼루션 연산을 수행합니다.
+                    // 입력 이미지의 0,0과 SobelKernel_X의 0,0부터 시작해서 2,2까지 계산하여 전부 더한 값을 넣는다.
+                    // SobelKernel_X에서 m과 n은 -1부터 시작하기때문에 +1을 해줘야된다.
+                    SumProduct += Input[(i + m) * nWidth + (j + n)] * SobelKernel_X[m + 1][n + 1]; // y * 전체 x + x
+                }
+            }
+
+            // 0 ~ +- 1020 값이 나오기 때문에, 절대값 / 4을 취하여 0 ~ 255 값으로 조정
+            Output[i * nWidth + j] = abs((long)SumProduct) / 4;
+            SumProduct = 0.0; // 초기화
+        }
+    }
+
+    return;
+}
+
+/*
+ * @Function Name : Y_SobelConvolution
+ * @Descriotion : Y_Sobel Kernel을 적용한 Edge 검출 Convolution
+ * @Input : *Input, nWidth, nHeight
+ * @Output : *Output
+ */
+// 김광제의 설명 - 1차원 배열로는 [-1,-2,-1   0,0,0   1,2,1] 요렇게 들어감
+void Y_SobelConvolution(BYTE *Input, BYTE *Output, int nWidth, int nHeight)
+{
+    double SumProduct = 0.0;
+
+    // Convolution Center를 (1,1)로 잡기 위해 1부터 시작, n-1까지 진행
+    for (int i = 1; i < nHeight - 1; i++)
+    { // y 행
+        for (int j = 1; j < nWidth - 1; j++)
+        { // x
+            for (int m = -1; m <= 1; m++)
+            { // kernel의 행
+                for (int n = -1; n <= 1; n++)
+                { // kernel의 열
+                    // 입력 이미지와 커널을 이용하여 컨볼루션 연산을 수행합니다.
+                    // 입력 이미지의 0,0과 SobelKernel_Y의 0,0부터 시작해서 2,2까지 계산하여 전부 더한 값을 넣는다.
+                    // SobelKernel_Y에서 m과 n은 -1부터 시작하기때문에 +1을 해줘야된다.
+                    SumProduct += Input[(i + m) * nWidth + (j + n)] * SobelKernel_Y[m + 1][n + 1]; // y * 전체 x + x
+                }
+            }
+
+            // 0 ~ +- 1020 값이 나오기 때문에, 절대값 / 4을 취하여 0 ~ 255 값으로 조정
+            Output[i * nWidth + j] = abs((long)SumProduct) / 4;
+            SumProduct = 0.0; // 초기화
+        }
+    }
+
+    return;
+}
+
+/*
+ * @Function Name : HPF_LaplacianConvolution
+ * @Descriotion : Laplacian Kernel을 적용한 High Pass Filter Convolution
+ * @Input : *Input, nWidth, nHeight
+ * @Output : *Output
+ */
+// 김광제의 설명 - 고역통과 필터로 고주파 성분은 패스하고 저주파 성분은 더욱 감쇄한다.
+// 샤프닝 효과를 가지며 흐릿한 영상에 샤프닝 처리할때 많이 사용한다.
+// 다른것과 다르게 일정한 비율로 나누지않고 클리핑처리를 한다. 0과 255가 엄청나게 많아지니 대비가 커지겠지? 날카롭겠지?? 응???
+void HPF_LaplacianConvolution(BYTE *Input, BYTE *Output, int nWidth, int nHeight)
+{
+    double SumProduct = 0.0;
+
+    // Convolution Center를 (1,1)로 잡기 위해 1부터 시작, n-1까지 진행
+    for (int i = 1; i < nHeight - 1; i++)
+    { // y 행
+        for (int j = 1; j < nWidth - 1; j++)
+        { // x
+            for (int m = -1; m <= 1; m++)
+            { // kernel의 행
+                for (int n = -1; n <= 1; n++)
+                { // kernel의 열
+                    // 입력 이미지와 커널을 이용하여 컨볼루션 연산을 수행합니다.
+                    // 입력 이미지의 0,0과 LaplacianKernel_HPF의 0,0부터 시작해서 2,2까지 계산하여 전부 더한 값을 넣는다.
+                    // LaplacianKernel_HPF에서 m과 n은 -1부터 시작하기때문에 +1을 해줘야된다.
+                    SumProduct += Input[(i + m) * nWidth + (j + n)] * LaplacianKernel_HPF[m + 1][n + 1]; // y * 전체 x + x
+                }
+            }
+
+            // 255보다 크면 255로 조정, 0보다 작으면 0으로 조정
+            // 다른곳에서는 절대값을 취하고 일정한 비율로 나누었지만 고역통과 필터에서는 그냥 클리핑 처리한다.
+            // 이러면 결과적으로 영상의 대비가 높아져 샤프닝 효과를 얻는다.
+            if (SumProduct > 255.0)
+                Output[i * nWidth + j] = 255;
+            else if (SumProduct < 0.0)
+                Output[i * nWidth + j] = 0;
+            else // 0~255 사이에 있는 값이라면 그냥 넣는다.
+                Output[i * nWidth + j] = (BYTE)SumProduct;
+
+            SumProduct = 0.0; // 초기화
+        }
+    }
+
+    return;
+}
+
+/*
+ * @Function Name : swap
+ * @Descriotion : 두 개의 입력값을 swap
+ * @Input : *left, *right
+ * @Output : *left, *right
+ */
+// 김광제의 설명 - 좌우 변경
+void swap(BYTE *left, BYTE *right)
+{
+    BYTE temp = *left;
+    *left = *right;
+    *right = temp;
+
+    return;
+}
+
+/*
+ * @Function Name : MinPooling
+ * @Descriotion : 입력 버퍼 중에서 가장 작은 값을 선택
+ * @Input : *bArr, nSize
+ * @Output : bArr[0]
+ */
+// 김광제의 설명 - 정렬 이후 가장 작은 값을 선택함
+// 솔트 노이즈 제거
+BYTE MinPooling(BYTE *bArr, int nSize)
+{
+    // Sorting
+    for (int i = 0; i < nSize - 1; i++)
+    {
+        for (int j = i + 1; j < nSize; j++)
+        {
+            if (bArr[i] > bArr[j])
+                swap(&bArr[i], &bArr[j]);
+        }
+    }
+
+    // 정렬 됐으니 0번 인덱스가 가장 작은 값임
+    return bArr[0];
+}
+
+/*
+ * @Function Name : MedianPooling
+ * @Descriotion : 입력 버퍼 중에서 중간 값을 선택
+ * @Input : *bArr, nSize
+ * @Output : *bArr[4]
+ */
+// 김광제의 설명 - 정렬 이후 중간값을 선택함
+// 경계면이 뭉개지지않음 (라인은 살아있고 라인 안쪽이 뭉개진다.)
+BYTE MedianPooling(BYTE *bArr, int nSize)
+{
+
+    const int nMedian = nSize;
+    // Sorting
+    for (int i = 0; i < nSize - 1; i++)
+    {
+        for (int j = i + 1; j < nSize; j++)
+        {
+            if (bArr[i] > bArr[j])
+                swap(&bArr[i], &bArr[j]);
+        }
+    }
+    // 정렬 이후 전체 값에서 중간값을 구함
+    // 9 / 2 == 4
+    return bArr[nMedian / 2];
+}
+
+/*
+ * @Function Name : MaxPooling
+ * @Descriotion : 입력 버퍼 중에서 가장 큰 값을 선택
+ * @Input : *bArr, nSize
+ * @Output : bArr[8]
+ */
+// 김광제의 설명 - 정렬 이후 가장 큰 값을 선택함
+// 페퍼노이즈 제거
+BYTE MaxPooling(BYTE *bArr, int nSize)
+{
+    // Sorting
+    for (int i = 0; i < nSize - 1; i++)
+    {
+        for (int j = i + 1; j < nSize; j++)
+        {
+            if (bArr[i] > bArr[j])
+                swap(&bArr[i], &bArr[j]);
+        }
+    }
+    // 여기에서는 가장 큰 값을 선택함
+    return bArr[8];
+}
+
+/*
+ * @Function Name : MedianFilter
+ * @Description : 3x3 필터를 이용하여 입력 이미지에 중앙값 필터링을 적용합니다.
+ *                각 픽셀에 대해 3x3 영역의 픽셀 값을 가져와 정렬하여 중앙값을 찾아 출력 이미지에 적용합니다.
+ * @Input : *Input - 입력 이미지 데이터 배열 포인터,
+ *          nWidth - 이미지의 너비 (픽셀 단위),
+ *          nHeight - 이미지의 높이 (픽셀 단위)
+ * @Output : *Output - 출력 이미지 데이터 배열 포인터
+ */
+// 김광제의 설명 - 입력영상의 특정 픽셀과 맞닿는 8개의 픽셀을 가져와서 MeddianPooling으로 중간값을 가져와서 출력 화소로 대응
+// 중간값이 255일 경우에는 필터 윈도우를 5x5 or 7x7로 늘리자
+// 필터 윈도우 늘렸을때 단점 - 필터 크기를 키우면 확인할게 많아져서 성능이 떨어지게 됨 또한 정상값도 중간값으로 변경되어서 영상이 변질
+void MedianFilter(BYTE *Input, BYTE *Output, int nWidth, int nHeight)
+{
+    BYTE temp[9]; // 3x3 필터링을 위한 임시 배열
+    int i, j;     // 반복문을 위한 변수
+    PROFILE_BEGIN(dStart);
+
+    // 이미지 내부 픽셀을 중심으로 순회합니다.
+    for (i = 1; i < nHeight - 1; i++)
+    {
+        for (j = 1; j < nWidth - 1; j++)
+        {
+            // 3x3 영역의 픽셀 값을 가져와 temp 배열에 저장합니다.
+            temp[0] = Input[(i - 1) * nWidth + j - 1];
+            temp[1] = Input[(i - 1) * nWidth + j];
+            temp[2] = Input[(i - 1) * nWidth + j + 1];
+            temp[3] = Input[i * nWidth + j - 1];
+            temp[4] = Input[i * nWidth + j];
+            temp[5] = Input[i * nWidth + j + 1];
+            temp[6] = Input[(i + 1) * nWidth + j - 1];
+            temp[7] = Input[(i + 1) * nWidth + j];
+            temp[8] = Input[(i + 1) * nWidth + j + 1];
+
+            // temp 배열에 저장된 값을 정렬한 후 중앙값을 출력 이미지에 저장합니다.
+            // MedianPooling은 중간값을 반환해주는 메서드임
+            Output[i * nWidth + j] = MedianPooling(temp, 9);
+        }
+    }
+
+    PROFILE_END(dStart, "median_filter", (long long)nWidth * nHeight, (long long)nWidth * nHeight * 2);
+    return;
+}
+
+/*
+ * @Function Name : MedianFiltering
+ * @Description : Filter 크기를 입력받아 Median Filter를 수행합니다.
+ * @Input : *Input - 입력 이미지 데이터 배열 포인터,
+ *          nWidth - 이미지의 너비 (픽셀 단위),
+ *          nHeight - 이미지의 높이 (픽셀 단위),
+ *          nSize - 필터 크기
+ * @Output : *Output - 출력 이미지 데이터 배열 포인터
+ */
+// 김광제의 설명 - 사용자로부터 필터의 크기를 입력받아 해당 크기의 중앙값 필터를 이미지에 적용
+// 마스크(윈도우)의 크기를 조절하여 다양한 크기의 잡음에 대응할 수 있다.
+// 마스크의 크기가 클수록 더 넓은 영역의 픽셀을 고려하기 때문에 더 강한 잡음 제거 효과를 얻을 수 있지만,
+// 동시에 이미지의 세부 사항이 더 흐려질 수 있다.
+void MedianFiltering(BYTE *Input, BYTE *Output, int nWidth, int nHeight, int nSize)
+{
+    int nLength = nSize;                                 // 마스크의 한 변의 길이
+    int nMargin = nLength / 2;                           // 마스크의 가장자리 크기
+    int nWSize = nLength * nLength;                      // 마스크 크기
+    BYTE *pTemp = (BYTE *)PoolAlloc(GetThreadPool(), sizeof(BYTE) * nWSize, 0); // 필터링을 위한 임시 배열 (스레드 버퍼 풀)
+    int i, j, m, n;                                      // 반복문을 위한 변수들
+
+    // 마스크 영역 내부 픽셀을 중심으로 순회합니다.
+    for (i = nMargin; i < nHeight - nMargin; i++)
+    {
+        for (j = nMargin; j < nWidth - nMargin; j++)
+        { // 이미지의 가로, 세로축을 반복하지만 nMargin픽셀은 제외하고 처리한다.
+            // 마스크 크기에 따른 픽셀 값을 임시 배열에 저장합니다.
+            for (m = -nMargin; m <= nMargin; m++)
+            { // 마진 값을 이용하여 커널의 중간에 있는 픽셀을 0,0으로 맞출수있다.
+                for (n = -nMargin; n <= nMargin; n++)
+                {
+                    // 현재 마스크 내의 각 픽셀('m', 'n')에 대해, 원본 이미지(Input)에서 해당 위치의 픽셀 값을 pTemp 배열에 복사한다.
+                    pTemp[(m + nMargin) * nLength + (n + nMargin)] = Input[(i + m) * nWidth + j + n];
+                }
+            }
+
+            // 임시 배열에 저장된 값 중앙값을 출력 이미지에 저장합니다.
+            // pTemp 배열에 저장된 픽셀 값들의 중앙값을 계산
+            Output[i * nWidth + j] = MedianPooling(pTemp, nWSize);
+        }
+    }
+
+    PoolFree(GetThreadPool(), pTemp); // 버퍼 풀에 반납
+}
+
+/*
+ * @Function Name : push
+ * @Descriotion : pStack_x, pStack_y에 vx, vy를 push
+ * @Input : *pStack_x, *pStack_yn, arr_size, vx, vy, *top
+ * @Output : 0, *pStack_x, *pStack_yn,*top
+ * **short *pStack_x, short* pStack_y**: 스택을 나타내는 두 개의 배열 포인터
+pStack_x는 x좌표를, pStack_y는 y좌표를 저장한다.
+int arr_size: 스택의 최대 크기를 의미한다.
+short vx, short vy: 스택에 추가할 x, y 좌표값을 의미한다.
+int* top: 현재 스택의 최상단 위치를 나타내는 포인터이다.
+ */
+// 김광제의 설명 - 스택 자료구조에 새로운 요소를 추가하는 함수 push이다.
+int push(short *pStack_x, short *pStack_y, int arr_size, short vx, short vy, int *top)
+{
+    if (*top >= arr_size)
+        return (-1); // 스택이 가득 찼을 때 오류 반환
+
+    // 스택이 꽉 차있지 않았다면 top을 하나 증가시키고, pStack_x와 pStack_y에 새로운 좌표 값을 저장한다. (vx, vy)
+    (*top)++;
+    pStack_x[*top] = vx; // x값 push
+    pStack_y[*top] = vy; // y값 push
+
+    return 0;
+}
+
+/*
+ * @Function Name : pop
+ * @Descriotion : *vx, *vy를 pop
+ * @Input : *pStack_x, *pStack_yn, *vx, *vy, *top
+ * @Output : 0, *vx, *vy
+ * short pStack_x, short pStack_y: 스택을 나타내는 두 개의 배열 포인터
+pStack_x는 x좌표를, pStack_y는 y좌표를 저장한다.
+short vx, short vy: 제거된 요소의 x, y 좌표값을 저장할 포인터.
+int top: 현재 스택의 최상단 위치를 나타내는 포인터이다.
+ */
+// 김광제의 설명 - 스택 자료구조에서 최상단의 요소를 제거한다.
+int pop(short *pStack_x, short *pStack_y, short *vx, short *vy, int *top)
+{
+    if (*top == 0)
+        return (-1); // 스택이 비었을 때 오류 반환
+
+    // 스택이 비어있지 않다면, pStack_x와 pStack_y에서 최상단 요소의 값을 vx와 vy에 복사하고, top을 하나 감소시킨다.
+    *vx = pStack_x[*top]; // x값 pop
+    *vy = pStack_y[*top]; // y값 pop
+    (*top)--;
+
+    return 0;
+}
+
+/*
+ * @Function Name : ComponentLabeling
+ * @Descriotion : 이미지의 Component를 추출하고 Labeling을 진행
+ * @Input : *CutImage, nWidth, nHeight
+ * @Output : *CutImage
+ * BYTE* CutImage: 이미지 데이터를 가리키는 포인터이다. 이 배열에 있는 픽셀 값을 사용하여 레이블링을 수행한다.
+ * int nWidth, int nHeight: 각각 입력 이미지의 너비와 높이를 나타낸다.
+ * int nLabel : 레이블링 모드를 지정하는 매개변수이다. 이 값에 따라 함수는 다른 종류의 레이블링을 수행한다.
+ */
+// 김광제의 설명 - 이미지에서 컴포넌트 레이블링을 수행하는 함수이다. 이 방법은 이미지에서 서로 연결된 픽셀 집합(블롭)을 찾아 각각에 고유한 레이블을 할당하는 알고리즘이다.
+// 주로 흑백 이미지에서 사용되며, 각 블롭은 픽셀 값이 255(흰색)으로 구성된다. 컴포넌트 레이블링은 이미지의 개별 연결 요소를 식별하고 레이블을 지정하는 과정이다.
+void ComponentLabeling(BYTE *CutImage, int nHeight, int nWidth, int nLabel)
+{
+    // nLabel 값별 실행 동작
+    // 1. Max Size Labeling
+    // 2. Size Filter Labeling
+    // 3. Gray Gap Labeling
+    int i, j, m, n, top, area, Out_Area, index;
+    int BlobArea[1000] = {
+        0,
+    };
+    long k;
+    short curColor = 0, r, c;
+    Out_Area = 1;
+#ifdef IMGPROC_PROFILE
+    int nMaxTop = 0; // 가장 깊었던 스택 깊이
+#endif
+    PROFILE_BEGIN(dStart);
+
+    // 스택으로 사용할 메모리와 레이블링된 픽셀을 저장하기 위한 메모리를 스레드 버퍼 풀에서 가져옴
+    // 스택은 쓰기 전에 읽지 않으므로 초기화하지 않고 레이블(pColoring)만 0으로 초기화
+    // push는 top을 먼저 증가시키고 저장하기 때문에 스택은 arr_size + 1개가 필요함
+    BUFFER_POOL *pPool = GetThreadPool();
+    short *pStack_x = (short *)PoolAlloc(pPool, ((size_t)nHeight * nWidth + 1) * sizeof(short), 0);
+    short *pStack_y = (short *)PoolAlloc(pPool, ((size_t)nHeight * nWidth + 1) * sizeof(short), 0);
+    short *pColoring = (short *)PoolAlloc(pPool, (size_t)nHeight * nWidth * sizeof(short), 1);
+
+    int arr_size = nHeight * nWidth;
+
+    for (i = 0; i < nHeight; i++)
+    {
+        for (j = 0; j < nWidth; j++)
+        {
+            // ver 1.9 index는 아래 GRASSFIRE에서 다른 행으로 바뀌므로 픽셀마다 다시 계산 (예전에는 블롭 하나를 찾은 뒤 다른 행을 검사하고 영상 밖을 읽었음)
+            index = i * nWidth;
+
+            // 이미 방문했거나 픽셀값이 255가 아니라면 처리 안함
+            if (pColoring[index + j] != 0 || CutImage[index + j] != 255)
+                continue;
+
+            r = i;
+            c = j;
+            top = 0;
+            area = 1;
+            curColor++;
+
+            while (1)
+            {
+            // 이미지의 픽셀을 순회하면서, 아직 레이블이 지정되지 않은 픽셀(값이 255인 픽셀)을 찾는다. 그리고 이 픽셀을 시작점으로 하여 연결된 모든 픽셀에 같은 레이블을 할당한다. 이 과정에서 스택을 사용하여 연결 요소를 추적한다.
+            // Grassfire 알고리즘은 연결된 픽셀을 효율적으로 찾는데 사용된다. 이 알고리즘은 이미지 처리, 객체 감지나 세분화 작업에 널리 사용된다.
+            GRASSFIRE:
+                for (m = r - 1; m <= r + 1; m++)
+                {
+                    index = m * nWidth;
+                    for (n = c - 1; n <= c + 1; n++)
+                    {
+                        // 관심 픽셀이 영상 경계를 벗어나면 처리 안함
+                        if (m < 0 || m >= nHeight || n < 0 || n >= nWidth)
+                            continue;
+
+                        if ((int)CutImage[index + n] == 255 && pColoring[index + n] == 0)
+                        {
+                            pColoring[index + n] = curColor; // 현재 레이블로 마크
+                            if (push(pStack_x, pStack_y, arr_size, (short)m, (short)n, &top) == -1)
+                                continue;
+#ifdef IMGPROC_PROFILE
+                            if (top > nMaxTop)
+                                nMaxTop = top;
+#endif
+                            r = m;
+                            c = n;
+                            area++;
+                            goto GRASSFIRE;
+                        }
+                    }
+                }
+                if (pop(pStack_x, pStack_y, &r, &c, &top) == -1)
+                    break;
+            }
+            if (curColor < 1000)
+                BlobArea[curColor] = area;
+        }
+    }
+
+    // 가장 면적이 넓은 영역을 찾아내기 위함
+    // 레이블링이 끝난 후, 가장 큰 영역("Out_Area")을 찾는다.
+    float grayGap = 255.0f / (float)curColor;
+    for (i = 1; i <= curColor; i++)
+    {
+        if (BlobArea[i] >= BlobArea[Out_Area])
+            Out_Area = i;
+    }
+
+    // CutImage 배열 255로 초기화
+    for (k = 0; k < nWidth * nHeight; k++)
+        CutImage[k] = 255;
+
+    if (nLabel == 1)
+    {
+        for (k = 0; k < nWidth * nHeight; k++)
+        {
+            if (pColoring[k] == Out_Area)
+                CutImage[k] = 0; // 가장 큰 것만 저장 (size filtering)
+        }
+    }
+    else if (nLabel == 2)
+    {
+        for (k = 0; k < nWidth * nHeight; k++)
+        {
+            if (BlobArea[pColoring[k]] > 500)
+                CutImage[k] = 0; // 특정 면적 이상되는 영역만 출력 (500 이상)
+        }
+    }
+    else if (nLabel == 3)
+    {
+        for (k = 0; k < nWidth * nHeight; k++)
+        {
+            CutImage[k] = (unsigned char)(pColoring[k] * grayGap); // 밝기값으로 레이블링
+        }
+    }
+    else
+    {
+        printf("Labeling Mode Error\n");
+    }
+
+    // 버퍼 풀에 반납하여 다음 호출(다음 영상)에서 다시 사용한다.
+    PoolFree(pPool, pStack_x);
+    PoolFree(pPool, pStack_y);
+    PoolFree(pPool, pColoring);
+
+    PROFILE_COUNT("label_blobs", curColor);
+    PROFILE_MAX("label_max_stack_depth", nMaxTop);
+    PROFILE_END(dStart, "component_labeling", arr_size, (long long)arr_size * (1 + 3 * sizeof(short)));
+    return;
+}
+
+/*
+ * @Function Name : DetectObjectEdge
+ * @Descriotion : Component Labeling 결과를 입력받아서 Edge를 추출
+ * @Input : *Input, nWidth, nHeight
+ * @Output : *Output
+ */
+// 김광제의 설명 - 주어진 이미지에서 객체의 경계를 감지하는 함수이다. 이 함수는 픽셀 단위로 이미지를 처리하여 전경(객체) 픽셀의 가장자리를 찾아내는 역할
+// 경계는 객체의 내부이다. 이때 경계를 4방향으로 보냐 8방향으로 보냐를 알아야됨
+void DetectObjectEdge(BYTE *Input, BYTE *Output, int nWidth, int nHeight)
+{
+    int nImgSize = nWidth * nHeight; // 전체 이미지 사이즈
+    PROFILE_BEGIN(dStart);
+
+    // 아웃풋을 전부 255로 초기화
+    for (int i = 0; i < nImgSize; i++)
+        Output[i] = 255;
+
+    for (int i = 0; i < nHeight; i++)
+    {
+        for (int j = 0; j < nWidth; j++)
+        {                                   // 전체 순회
+            if (Input[i * nWidth + j] == 0) // 0은 전경(forground) (객체)
+            {
+                // 위/아래/좌/우 픽셀이 전경이 아니라면(하나라도 0이 아니라면) 경계로 판단
+                // 여기에서는 4방향으로 확인하는 코드임 (영상 밖은 배경으로 봄, 첫 행, 마지막 행, 첫 열, 마지막 열의 전경은 경계)
+                if (!(i > 0 && Input[(i - 1) * nWidth + j] == 0 && i < nHeight - 1 && Input[(i + 1) * nWidth + j] == 0 &&
+                      j > 0 && Input[i * nWidth + j - 1] == 0 && j < nWidth - 1 && Input[i * nWidth + j + 1] == 0))
+                {
+                    // 경계 좌표만 아웃풋에서 밝기값 0으로 표시한다.
+                    Output[i * nWidth + j] = 0;
+                }
+            }
+        }
+    }
+
+    PROFILE_END(dStart, "detect_object_edge", nImgSize, (long long)nImgSize * 2);
+}
+
+/*
+ * @Function Name : VerticalFlip
+ * @Descriotion : 원본 영상에 대해 Vertical Flip을 수행
+ * @Input : *Input, nWidth, nHeight
+ * @Output : *Input
+ */
+// 김광제의 설명 - 단순하게 col을 2로 나누어서 맨 위와 맨 아래 부터 시작해서 값을 전부 바꿈
+void VerticalFlip(BYTE *Input, int nWidth, int nHeight)
+{
+    // 제일 위쪽 픽셀 값과 제일 아래쪽 픽셀 값부터 교환
+    for (int i = 0; i < nHeight / 2; i++)
+    { // y좌표 : 교환이기 때문에 1/2만 돌면 됨
+        for (int j = 0; j < nWidth; j++)
+        { // x좌표
+            swap(&Input[i * nWidth + j], &Input[(nHeight - 1 - i) * nWidth + j]);
+        }
+    }
+}
+
+/*
+ * @Function Name : HorizontalFlip
+ * @Descriotion : 원본 영상에 대해 Horizontal Flip을 수행
+ * @Input : *Input, nWidth, nHeight
+ * @Output : *Input
+ */
+// 김광제의 설명 - row를 2로 나누어서 좌 우 값을 바꿈
+void HorizontalFlip(BYTE *Input, int nWidth, int nHeight)
+{
+    // 제일 왼쪽 픽셀 값과 제일 오른쪽 픽셀 값부터 교환
+    for (int i = 0; i < nWidth / 2; i++)
+    { // x좌표 : 교환이기 때문에 1/2만 돌면 됨
+        for (int j = 0; j < nHeight; j++)
+        { // y좌표
+            swap(&Input[j * nWidth + i], &Input[j * nWidth + (nWidth - 1 - i)]);
+        }
+    }
+}
+
+/*
+ * @Function Name : Translation
+ * @Descriotion : 원본 영상과 이동할 x, y 좌표를 입력받아서 영상을 이동
+ * @Input : *Input, nWidth, nHeight, Tx, Ty
+ * @Output : *Output
+ */
+// 김광제의 설명 - 이동은 클리핑 처리를 해주어야되며
+// BMP는 영상이 거꾸로 들어가있다
+// Tx와 Ty는 오프셋거리이다. (이동 거리)
+// 영상이 상하반전 되어있기 때문에 0,0의 위치는 맨 왼쪽 아래이다.
+void Translation(BYTE *Input, BYTE *Output, int nWidth, int nHeight, int Tx, int Ty)
+{
+    // 영상이 상하반전되어있기 때문에 y축의 이동거리에만 -1을 곱해줌
+    // 결과적으로 offset이 (양수,양수)로 되어있다면 오른쪽 아래로 이동한것으로 보여짐
+    Ty *= -1; // 영상이 거꾸로 되어 있기 때문에, y 좌표 값을 -로 처리
+    for (int i = 0; i < nHeight; i++)
+    { // 2차원 배열의 영상을 처리하는 기본적인 구분(암기)
+        for (int j = 0; j < nWidth; j++)
+        { // 2차원 배열의 영상을 처리하는 기본적인 구분(암기)
+            // 영상이 프레임 범위를 벗어나는지 확인
+            // 기하학적 변환에서는 범위를 벗어나는 값은 버림
+            // 이동하는 좌표가 0보다 크고 기존 높이/폭 보다 작아야 처리
+            if ((i + Ty < nHeight && i + Ty >= 0) && (j + Tx < nWidth && j + Tx >= 0))
+                // 순방향 사상(Forward Mapping)으로 진행
+                Output[(i + Ty) * nWidth + (j + Tx)] = Input[i * nWidth + j];
+        }
+    }
+}
+
+/*
+ * @Function Name : Scaling
+ * @Descriotion : 원본 영상과 확장할 x, y 좌표를 입력받아서 영상을 확장
+ * @Input : *Input, nWidth, nHeight, Sx, Sy
+ * @Output : *Output
+ */
+// 김광제의 설명 - 확장을 위한건데 0,0을 기준으로 시작해서 인풋에서 비율을 고려하여 값을 넣음
+// Sx, Sy는 확대 비율 Sx, Sy가 1보다 작다면 축소 1보다 크면 확대
+// 순방향 사상은 인풋에서 아웃풋으로 이동 (이때 홀이 생기는데 Scaling은 홀이 일정한 간격으로 발생한다.)
+// 확대시에는 홀이 발생하고 축소시에는 오버랩이 발생한다.
+// 역방향 사상은 아웃풋에서 인풋픽셀을 정하여 매핑한다.
+// 역방향 사상은 출력 이미지의 각 픽셀에 대해 원본 이미지에서 해당 값을 가져온다. 이 방법은 빈 공간을 방지하지만, 원본 이미지의 일부 픽셀이 결과 이미지에 반영되지 않을 수 있다.
+void Scaling(BYTE *Input, BYTE *Output, int nWidth, int nHeight, double Sx, double Sy)
+{
+    // Scaling
+    int tmpX, tmpY; // 선택한 X,Y좌표를 담기 위한 변수
+    for (int i = 0; i < nHeight; i++)
+    { // 2차원 배열의 영상을 처리하는 기본적인 구분(암기)
+        for (int j = 0; j < nWidth; j++)
+        { // 2차원 배열의 영상을 처리하는 기본적인 구분(암기)
+            /*1. 순방향 사상으로 진행하는 코드입니다. 주석처리를 바꿔가면서 테스트 해보세요*/
+            // 순방향으로 입력영상의 픽셀을 가져갈 목적영상의 픽셀을 구함
+            // 순방향으로 확대시에 홀이 발생하게됨 이걸 해결하기위해 보간법을 사용해야됨
+            tmpX = (int)(j * Sx); // Sx가 double 이라서 int로 형변환
+            tmpY = (int)(i * Sy); // Sy가 double 이라서 int로 형변환
+
+            // 영상이 프레임 범위를 벗어나는지 확인
+            // 이동하는 좌표가 기존 높이/폭 보다 작아야 처리(음수는 처리하지 않음)
+            if (tmpY < nHeight && tmpX < nWidth)
+                // 순방향 사상(Reverse Mapping)으로 진행
+                // input 영상의 모든 픽셀을 스캔하면서 tmpX와 tmpY가 반영된 Output 영상의 좌표에 픽셀 값을 저장
+                Output[tmpY * nWidth + tmpX] = Input[i * nWidth + j];
+
+            /*2. 역방향 사상으로 진행하는 코드입니다. 주석처리를 바꿔가면서 테스트 해보세요
+                // 역방향으로 목적 영상에 대응시킬 입력영상의 픽셀을 구함
+                // 출력 이미지의 각 픽셀에 대해 원본 이미지에서 해당 값을 가져온다. 이 방법은 빈 공간을 방지하지만, 원본 이미지의 일부 픽셀이 결과 이미지에 반영되지 않을 수 있다.
+                tmpX = (int)(j / Sx);					// 역방향 이기 때문에, *를 /로 수정
+                tmpY = (int)(i / Sy);					// 역방향 이기 때문에, *를 /로 수정
+                // 영상이 프레임 범위를 벗어나는지 확인
+                // 이동하는 좌표가 기존 높이/폭 보다 작아야 처리(음수는 처리하지 않음)
+                if (tmpY < nHeight && tmpX < nWidth)
+                    // 역방향 사상(Reverse Mapping)으로 진행
+                    // input 영상에서 tmpX와 tmpY가 반영된 좌표의 픽셀 값을 Output 영상의 좌표에 픽셀 값을 저장
+                    // output 영상의 모든 픽셀을 스캔하면서 input 영상에 해당하는 좌표의 픽셀 값을 가져오는 것과 같은 의미임
+                    Output[i * nWidth + j] = Input[tmpY * nWidth + tmpX];
+            */
+        }
+    }
+}
+
+/*
+ * @Function Name : Rotation
+ * @Descriotion : 원본 영상과 회전할 각도를 입력받아서 영상을 회전
+ * @Input : *Input, nWidth, nHeight, Tx, Ty
+ * @Output : *Output
+ */
+// 김광제의 설명 - 0,0을 기준으로 잡고 영상을 돌린다. 다만 영상이 거꾸로 되어있기 떄문에 0,0의 위치는 왼쪽 아래임 이러한 이유로 반시계방향으로 돈다.
+// 이때도 순방향사상으로 코드를 돌릴시에 홀이 발생한다. 홀이 생기는 모양?은 Translation과 다르다.
+//  Angle은 회전 각도
+void Rotation(BYTE *Input, BYTE *Output, int nWidth, int nHeight, int Angle)
+{
+    int tmpX, tmpY;
+    double Radian = Angle * 3.141592 / 180.0; // 각도를 라디안 단위로 변환한다. 이미지처리에서 회전을 수행할 때는 라디안 단위를 사용하는 것이 일반적이다.
+    for (int i = 0; i < nHeight; i++)
+    { // 2차원 배열의 영상을 처리하는 기본적인 구분(암기)
+        for (int j = 0; j < nWidth; j++)
+        { // 2차원 배열의 영상을 처리하는 기본적인 구분(암기)
+
+            // 순방향 사상
+            // 회전된 이미지에서의 각 픽셀의 좌표를 계산하는 부분입니다.
+            // 각 픽셀의 새 위치는 회전 변환 행렬을 사용하여 계산된다. 이는 표준 2D 회전 변환 공식을 따른다.
+            tmpX = (int)(cos(Radian) * j - sin(Radian) * i); // j의 코사인과 i의 사인 값의 조합으로 계산
+            tmpY = (int)(sin(Radian) * j + cos(Radian) * i); // j의 사인과 i의 코사인 값의 조합으로 계산
+
+            // 계산된 위치가 이미지 프레임 내에 있는지 확인한다.
+            // 이동하는 좌표가 0보다 크고 기존 높이/폭 보다 작아야 처리
+            if ((tmpY < nHeight && tmpY >= 0) && (tmpX < nWidth && tmpX >= 0))
+                // 순방향 사상(Forward Mapping)으로 진행
+                // 순방향 사상은 원본 이미지의 각 픽셀을 타겟 이미지의 새 위치로 직접 매핑한다.
+                // 원본 이미지(Input)의 픽셀 값을 새 위치에 있는 출력 이미지(Output)의 해당 픽셀에 할당한다.
+                Output[tmpY * nWidth + tmpX] = Input[i * nWidth + j];
+
+            /*2. 역방향 사상
+            // 역방향 사상은 회전 변환의 역행렬을 사용한다.
+            tmpX = (int)(cos(Radian) * j + sin(Radian) * i);			// 역방향을 위해서 역행렬을 적용
+            tmpY = (int)(-sin(Radian) * j + cos(Radian) * i);			// 역방향을 위해서 역행렬을 적용
+            // 영상이 프레임 범위를 벗어나는지 확인
+            // 이동하는 좌표가 0보다 크고 기존 높이/폭 보다 작아야 처리
+            if ((tmpY < nHeight && tmpY >= 0) && (tmpX < nWidth && tmpX >= 0))
+                // 역방향 사상(Reverse Mapping)으로 진행
+                // 출력 이미지의 각 픽셀에 대해 원본 이미지에서 해당 픽셀 값을 가져온다.
+                // 이 방법은 결과 이미지의 모든 픽셀을 채우는 데 더 효과적일 수 있으며, 순방향 사상에서 발생할 수 있는 "홀"이나 빈 공간을 방지한다.
+                Output[i * nWidth + j] = Input[tmpY * nWidth + tmpX];
+            */
+        }
+    }
+}
+
+/*
+ * @Function Name : Erosion
+ * @Descriotion : 입력 영상을 침식합니다. 전경화소 주변에 배경화소가 있는 경우를 검사하여 처리합니다.
+ * @Input : *Input - 입력 이미지 데이터 배열 포인터,
+ *          nWidth - 이미지의 너비 (픽셀 단위),
+ *          nHeight - 이미지의 높이 (픽셀 단위)
+ * @Output : *Output - 출력 이미지 데이터 배열 포인터
+ */
+// 김광제의 설명 - 이미지 처리에서 사용하는 "침식" 개념을 구현하는 함수이다. 침식은 주로 이진 이미지 처리에서 사용되며, 전경 객체의 경계를 축소하거나 객체 내의 작은 구멍을 제거하는 데 사용된다.
+// 입력영상에서 값을 바꾸는것이 아닌 결과영상에 값을 옮기기 때문에 이미 바꾼 픽셀은 다른 픽셀에 영향을 주지 않음
+void Erosion(BYTE *Input, BYTE *Output, int nWidth, int nHeight)
+{
+    PROFILE_BEGIN(dStart);
+
+    for (int i = 1; i < nHeight - 1; i++)
+    {
+        for (int j = 1; j < nWidth - 1; j++)
+        {                                     // 이중 for문을 사용하여 이미지의 모든 픽셀을 순회한다. 경계픽셀은 제외하고 처리된다.
+            if (Input[i * nWidth + j] == 255) // 전경화소를 기준으로 검사합니다.
+            {
+                // 4주변 화소가 모두 전경화소가 아닌 경우에 처리합니다.
+                // 즉, 전경화소 주변에 배경화소가 하나라도 존재한다면 침식을 수행합니다.
+                if (!(Input[(i - 1) * nWidth + j] == 255 &&
+                      Input[(i + 1) * nWidth + j] == 255 &&
+                      Input[i * nWidth + j - 1] == 255 &&
+                      Input[i * nWidth + j + 1] == 255))
+                {
+                    // 검은색(배경) 값 0으로 처리합니다.
+                    Output[i * nWidth + j] = 0;
+                }
+                else
+                {
+                    // 모두 전경화소이면, 흰색(전경) 값 255로 처리합니다.
+                    Output[i * nWidth + j] = 255;
+                }
+            }
+            else
+            {
+                // 배경화소는 검은색(배경) 값 0으로 처리합니다.
+                Output[i * nWidth + j] = 0;
+            }
+        }
+    }
+
+    PROFILE_END(dStart, "erosion", (long long)nWidth * nHeight, (long long)nWidth * nHeight * 2);
+}
+
+/*
+ * @Function Name : Dilation
+ * @Descriotion : 입력 영상을 팽창
+ * @Input : *Input, nWidth, nHeight
+ * @Output : *Output
+ */
+// 김광제의 설명 - 배경에 대해서 4방향에 객체가 닿아있다면 그 픽셀까지 전경으로 변경
+//  이미지 처리에서 사용되는 "팽창" 개념의 구현이다. 팽창은 주로 이진 이미지 처리에서 사용되며, 전경 객체의 경계를 확장하거나 객체들을 연결하는데 사용
+void Dilation(BYTE *Input, BYTE *Output, int nWidth, int nHeight)
+{
+    PROFILE_BEGIN(dStart);
+
+    for (int i = 1; i < nHeight - 1; i++)
+    {
+        for (int j = 1; j < nWidth - 1; j++)
+        {                                   // 이중 for 반복문을 사용하여 이미지의 모든 픽셀을 순회한다. 경계 픽셀은 제외하고 처리한다.
+            if (Input[i * nWidth + j] == 0) // 배경화소를 기준으로 검사
+            {
+                // 4주변화소가 모두 배경화소가 아닌 경우(하나라도 전경화소가 있다면~)
+                if (!(Input[(i - 1) * nWidth + j] == 0 &&
+                      Input[(i + 1) * nWidth + j] == 0 &&
+                      Input[i * nWidth + j - 1] == 0 &&
+                      Input[i * nWidth + j + 1] == 0))
+
+                    // 흰색(전경) 값 255로 처리
+                    Output[i * nWidth + j] = 255;
+                else
+                    // 모두 배경화소이면, 검은색(배경) 값 0으로 처리
+                    Output[i * nWidth + j] = 0;
+            }
+            else
+                // 전경화소는 흰색(전경) 값 255로 처리
+                Output[i * nWidth + j] = 255;
+        }
+    }
+
+    PROFILE_END(dStart, "dilation", (long long)nWidth * nHeight, (long long)nWidth * nHeight * 2);
+}
+
+/*
+ * @Function Name : getBlackNeighbours
+ * @Descriotion : 입력 영상을 팽창
+ * @Input : *Input, nWidth, nHeight
+ * @Output : *Output
+ * int row, int col: 검사할 픽셀의 행과 열 위치
+ * imageMatrix: 이미지 데이터를 나타내는 2차원 배열이다. (전역)
+ * imagePixel: 이 함수에서 찾고자 하는 특정 색상의 픽셀 값으로, 여기서는 검은색 픽셀을 의미한다. (전역)
+ */
+// 김광제의 설명 - 이미지 행렬 내에서 특정 픽셀 주변의 특정 색상 픽셀의 개수를 계산하는 함수이다.
+// 이 함수는 주어진 행(row)과 열(col)에 위치한 픽셀을 중심으로 8방향 이웃 픽셀들을 검사하여, 주어진 색상의 픽셀 수를 계산
+int getBlackNeighbours(int row, int col)
+{
+    int i, j, sum = 0;
+
+    for (i = -1; i <= 1; i++)
+    {
+        for (j = -1; j <= 1; j++)
+        {                         // 중심 픽셀 주변의 모든 픽셀을 순회한다. 여기서 i와 j는 중심 픽셀로부터의 상대적 위치를 나타낸다
+            if (i != 0 || j != 0) // 주변 픽셀이 imagePixel(검은색)과 일치하는지 확인
+                // 일치하는 경우 sum을 1 증가시켜 해당 색상의 픽셀 수를 계산
+                sum += (imageMatrix[row + i][col + j] == imagePixel);
+        }
+    }
+
+    return sum;
+}
+
+/*
+ * @Function Name : getBWTransitions
+ * @Descriotion : 픽셀의 중심을 기준으로 3X3 영역에서 흰색과 검은색의 전환 개수를 계산
+ * @Input : row, col
+ * @Output : 흰색, 검은색 전환 개수
+ * int row, int col: 검사할 픽셀의 행과 열 위치
+ * imageMatrix: 이미지 데이터를 나타내는 2차원 배열이다. (전역)
+ * blackPixel: 여기서는 흰색 픽셀을 의미한다.
+ * imagePixel: 검은색 픽셀을 의미한다.
+ */
+// 김광제의 설명 - 주어진 픽셀의 8-방향 이웃에 대해 흰색에서 검은색으로 바뀌는 전환을 감지하여 그 수를 계산
+int getBWTransitions(int row, int col)
+{
+    // 중심 픽셀을 기준으로 상하좌우 및 대각선 방향에 있는 이웃 픽셀들을 순회하며 흰색에서 검은색으로의 전환을 감지
+    // 각 조건문은 두 개의 인접 픽셀을 검사한다. 첫 번째 픽셀이 흰색(blankPixel)이고, 두 번째 픽셀이 검은색(imagePixel)인 경우에 한해 전환을 감지
+    // 모든 방향에 대해 이러한 검사를 수행하고, 각각의 검사 결과(전환 발생 시 1, 아닐 시 0)를 합산하여 반환
+    return ((imageMatrix[row - 1][col] == blankPixel && imageMatrix[row - 1][col + 1] == imagePixel) + (imageMatrix[row - 1][col + 1] == blankPixel && imageMatrix[row][col + 1] == imagePixel) + (imageMatrix[row][col + 1] == blankPixel && imageMatrix[row + 1][col + 1] == imagePixel) + (imageMatrix[row + 1][col + 1] == blankPixel && imageMatrix[row + 1][col] == imagePixel) + (imageMatrix[row + 1][col] == blankPixel && imageMatrix[row + 1][col - 1] == imagePixel) + (imageMatrix[row + 1][col - 1] == blankPixel && imageMatrix[row][col - 1] == imagePixel) + (imageMatrix[row][col - 1] == blankPixel && imageMatrix[row - 1][col - 1] == imagePixel) + (imageMatrix[row - 1][col - 1] == blankPixel && imageMatrix[row - 1][col] == imagePixel));
+    // 주어진 픽셀 주변에서 발생하는 흑백 전환의 총 횟수를 반환
+}
+
+// ver 1.4 픽셀 형식별 커널 생성 (pixel_kernels.h 템플릿을 형식마다 한번씩 include)
+// ver 1.6 IMAGE(nStride, ROI) 입력을 받도록 바꾸면서 8비트 그레이도 생성 (위의 기존 함수들은 결과 비교용 기준으로 그대로 둠)
+#define PK_TYPE BYTE
+#define PK_CH 1
+#define PK_ALPHA 0
+#define PK_MAX 255
+#define PK_SUFFIX Gray8
+#include "pixel_kernels.h"
+
+#define PK_TYPE WORD
+#define PK_CH 1
+#define PK_ALPHA 0
+#define PK_MAX 65535
+#define PK_SUFFIX Gray16
+#include "pixel_kernels.h"
+
+#define PK_TYPE BYTE
+#define PK_CH 3
+#define PK_ALPHA 0
+#define PK_MAX 255
+#define PK_SUFFIX BGR24
+#include "pixel_kernels.h"
+
+#define PK_TYPE BYTE
+#define PK_CH 4
+#define PK_ALPHA 1
+#define PK_MAX 255
+#define PK_SUFFIX BGRA32
+#include "pixel_kernels.h"
+
+CONVOLUTION_INFO ConvolutionTable[] = {
+    {AvgKernel, CONV_POST_NONE, 1, AverageConvolution},
+    {GaussKernel, CONV_POST_NONE, 1, GaussianConvolution},
+    {LaplacianKernel, CONV_POST_ABS, 8, LaplacianConvolution},
+    {PrewittKernel_X, CONV_POST_ABS, 3, X_PrewittConvolution},
+    {PrewittKernel_Y, CONV_POST_ABS, 3, Y_PrewittConvolution},
+    {SobelKernel_X, CONV_POST_ABS, 4, X_SobelConvolution},
+    {SobelKernel_Y, CONV_POST_ABS, 4, Y_SobelConvolution},
+    {LaplacianKernel_HPF, CONV_POST_CLIP, 1, HPF_LaplacianConvolution},
+};
+
+// ver 1.6 형식별 템플릿 함수 호출 (Func_Gray8, Func_Gray16, Func_BGR24, Func_BGRA32 중 하나)
+// 반환값이 없는 함수도 사용할 수 있도록 switch 대신 조건 연산자로 만듦
+#define CALL_KERNEL(nFormat, Func, ...)                   \
+    ((nFormat) == PIXEL_GRAY16   ? Func##_Gray16(__VA_ARGS__) \
+     : (nFormat) == PIXEL_BGR24  ? Func##_BGR24(__VA_ARGS__)  \
+     : (nFormat) == PIXEL_BGRA32 ? Func##_BGRA32(__VA_ARGS__) \
+                                 : Func##_Gray8(__VA_ARGS__))
+
+/*
+ * @Function Name : CheckImagePair
+ * @Description : 입력, 출력 영상의 크기, 형식, 저장 방식이 같은지 검사합니다.
+ * @Input : *pIn, *pOut
+ * @Output : 0 (같음) / -1 (다름)
+ */
+int CheckImagePair(const IMAGE *pIn, const IMAGE *pOut)
+{
+    if (pIn->nWidth != pOut->nWidth || pIn->nHeight != pOut->nHeight)
+        return (-1);
+    if (pIn->nFormat != pOut->nFormat || pIn->nLayout != pOut->nLayout)
+        return (-1);
+    return 0;
+}
+
+/*
+ * @Function Name : GetUnitCount
+ * @Description : 커널을 호출할 단위 영상의 개수를 반환합니다.
+ * @Input : *pImg, bAlpha - Planar 알파 평면도 처리할지 여부
+ * @Output : Interleaved는 1, Planar는 평면 개수 (bAlpha가 0이면 알파 평면 제외)
+ */
+// 김광제의 설명 - Planar 영상은 평면마다 8비트 그레이 영상으로 보고 Gray8 커널을 호출한다.
+int GetUnitCount(const IMAGE *pImg, int bAlpha)
+{
+    if (pImg->nLayout != LAYOUT_PLANAR)
+        return 1;
+    return (pImg->nChannels == 4 && !bAlpha) ? 3 : pImg->nChannels;
+}
+
+/*
+ * @Function Name : GetUnitView
+ * @Description : u번째 단위 영상을 pView에 만듭니다. (Interleaved는 영상 자체, Planar는 u번째 평면)
+ * @Input : *pImg, u
+ * @Output : *pView
+ */
+void GetUnitView(const IMAGE *pImg, int u, IMAGE *pView)
+{
+    if (pImg->nLayout == LAYOUT_PLANAR)
+        GetPlaneView(pImg, u, pView);
+    else
+        *pView = *pImg;
+}
+
+/*
+ * @Function Name : CopyRestPlanes
+ * @Description : Planar 영상에서 처리하지 않은 평면(nFirst번째 부터)을 그대로 복사합니다.
+ * @Input : *pIn, nFirst
+ * @Output : *pOut
+ */
+void CopyRestPlanes(const IMAGE *pIn, IMAGE *pOut, int nFirst)
+{
+    if (pIn->nLayout != LAYOUT_PLANAR)
+        return;
+
+    for (int c = nFirst; c < pIn->nChannels; c++)
+        for (int i = 0; i < pIn->nHeight; i++)
+            memcpy(pOut->pPlane[c] + (size_t)i * pOut->nStride, pIn->pPlane[c] + (size_t)i * pIn->nStride, pIn->nWidth);
+}
+
+/*
+ * @Function Name : CopyImage
+ * @Description : 영상(모든 형식, 저장 방식, ROI)을 크기, 형식, 저장 방식이 같은 영상에 복사합니다.
+ * @Input : *pSrc
+ * @Output : *pDst, 반환값 0 (성공) / -1 (입력 오류)
+ */
+// 김광제의 설명 - 제자리 처리 함수(뒤집기, 레이블링)를 입력을 보존한 채로 실행할 때 출력에 먼저 복사하는 용도
+int CopyImage(const IMAGE *pSrc, IMAGE *pDst)
+{
+    IMAGE In, Out;
+    int nUnits = GetUnitCount(pSrc, 1);
+
+    if (CheckImagePair(pSrc, pDst) != 0)
+        return (-1);
+
+    for (int u = 0; u < nUnits; u++)
+    {
+        size_t nRowBytes;
+
+        GetUnitView(pSrc, u, &In);
+        GetUnitView(pDst, u, &Out);
+        if (In.pPlane[0] == Out.pPlane[0])
+            continue; // 같은 버퍼
+
+        nRowBytes = (size_t)In.nWidth * GetBytesPerPixel(In.nFormat);
+        for (int i = 0; i < In.nHeight; i++)
+            memcpy(Out.pPlane[0] + (size_t)i * Out.nStride, In.pPlane[0] + (size_t)i * In.nStride, nRowBytes);
+    }
+
+    return 0;
+}
+
+/*
+ * @Function Name : ImgInverse
+ * @Description : 영상(모든 형식, 저장 방식, ROI)의 밝기 값을 반전시킵니다.
+ * @Input : *pIn
+ * @Output : *pOut, 반환값 0 (성공) / -1 (입력 오류)
+ */
+// 김광제의 설명 - 아래 ImgXXX 함수들은 모두 같은 방식으로 단위 영상마다 형식에 맞는 커널을 한번씩 호출한다.
+// 알파 채널은 처리하지 않고 복사 (기하 변환은 알파도 같이 옮김)
+int ImgInverse(const IMAGE *pIn, IMAGE *pOut)
+{
+    IMAGE In, Out;
+    int nUnits = GetUnitCount(pIn, 0);
+
+    if (CheckImagePair(pIn, pOut) != 0)
+        return (-1);
+
+    for (int u = 0; u < nUnits; u++)
+    {
+        GetUnitView(pIn, u, &In);
+        GetUnitView(pOut, u, &Out);
+        CALL_KERNEL(In.nFormat, InverseImage, &In, &Out);
+    }
+    CopyRestPlanes(pIn, pOut, nUnits);
+
+    return 0;
+}
+
+/*
+ * @Function Name : ImgAdjustBrightness
+ * @Description : 영상의 밝기를 nBrightness 만큼 조절합니다.
+ * @Input : *pIn, nBrightness (영상의 밝기 범위 단위)
+ * @Output : *pOut, 반환값 0 (성공) / -1 (입력 오류)
+ */
+int ImgAdjustBrightness(const IMAGE *pIn, IMAGE *pOut, int nBrightness)
+{
+    IMAGE In, Out;
+    int nUnits = GetUnitCount(pIn, 0);
+
+    if (CheckImagePair(pIn, pOut) != 0)
+        return (-1);
+
+    for (int u = 0; u < nUnits; u++)
+    {
+        GetUnitView(pIn, u, &In);
+        GetUnitView(pOut, u, &Out);
+        CALL_KERNEL(In.nFormat, AdjustBrightness, &In, &Out, nBrightness);
+    }
+    CopyRestPlanes(pIn, pOut, nUnits);
+
+    return 0;
+}
+
+/*
+ * @Function Name : ImgAdjustContrast
+ * @Description : 영상에 dContrast를 곱하여 대비를 조정합니다.
+ * @Input : *pIn, dContrast
+ * @Output : *pOut, 반환값 0 (성공) / -1 (입력 오류)
+ */
+int ImgAdjustContrast(const IMAGE *pIn, IMAGE *pOut, double dContrast)
+{
+    IMAGE In, Out;
+    int nUnits = GetUnitCount(pIn, 0);
+
+    if (CheckImagePair(pIn, pOut) != 0)
+        return (-1);
+
+    for (int u = 0; u < nUnits; u++)
+    {
+        GetUnitView(pIn, u, &In);
+        GetUnitView(pOut, u, &Out);
+        CALL_KERNEL(In.nFormat, AdjustContrast, &In, &Out, dContrast);
+    }
+    CopyRestPlanes(pIn, pOut, nUnits);
+
+    return 0;
+}
+
+/*
+ * @Function Name : ImgBinarization
+ * @Description : nThreshold를 기준으로 영상을 이진화합니다.
+ * @Input : *pIn, nThreshold (영상의 밝기 범위 단위)
+ * @Output : *pOut, 반환값 0 (성공) / -1 (입력 오류)
+ */
+int ImgBinarization(const IMAGE *pIn, IMAGE *pOut, unsigned int nThreshold)
+{
+    IMAGE In, Out;
+    int nUnits = GetUnitCount(pIn, 0);
+
+    if (CheckImagePair(pIn, pOut) != 0)
+        return (-1);
+
+    for (int u = 0; u < nUnits; u++)
+    {
+        GetUnitView(pIn, u, &In);
+        GetUnitView(pOut, u, &Out);
+        CALL_KERNEL(In.nFormat, GenerateBinarization, &In, &Out, nThreshold);
+    }
+    CopyRestPlanes(pIn, pOut, nUnits);
+
+    return 0;
+}
+
+/*
+ * @Function Name : ImgCombineMax
+ * @Description : 두 영상의 같은 위치 샘플 중 큰 값을 pOut에 저장합니다.
+ * @Input : *pIn, *pOut
+ * @Output : *pOut, 반환값 0 (성공) / -1 (입력 오류)
+ */
+int ImgCombineMax(const IMAGE *pIn, IMAGE *pOut)
+{
+    IMAGE In, Out;
+    int nUnits = GetUnitCount(pIn, 1);
+
+    if (CheckImagePair(pIn, pOut) != 0)
+        return (-1);
+
+    for (int u = 0; u < nUnits; u++)
+    {
+        GetUnitView(pIn, u, &In);
+        GetUnitView(pOut, u, &Out);
+        CALL_KERNEL(In.nFormat, CombineMax, &In, &Out);
+    }
+
+    return 0;
+}
+
+/*
+ * @Function Name : ImgHistogram
+ * @Description : 그레이 영상(8, 16비트)의 히스토그램을 만듭니다.
+ * @Input : *pIn
+ * @Output : *Histogram (8비트 256개, 16비트 65536개, 0으로 초기화되어 있어야 함), 반환값 0 (성공) / -1 (지원하지 않는 형식)
+ */
+int ImgHistogram(const IMAGE *pIn, int *Histogram)
+{
+    if (pIn->nFormat == PIXEL_GRAY8)
+        GenerateHistogram_Gray8(pIn, Histogram);
+    else if (pIn->nFormat == PIXEL_GRAY16)
+        GenerateHistogram_Gray16(pIn, Histogram);
+    else
+        return (-1);
+
+    return 0;
+}
+
+/*
+ * @Function Name : ImgHistogramStretching
+ * @Description : 그레이 영상(8, 16비트)의 히스토그램을 만들고 히스토그램 스트래칭을 수행합니다.
+ * @Input : *pIn
+ * @Output : *pOut, 반환값 0 (성공) / -1 (지원하지 않는 형식, 메모리 할당 오류)
+ */
+// 김광제의 설명 - 16비트는 히스토그램이 65536개라서 스택 대신 동적 할당
+int ImgHistogramStretching(const IMAGE *pIn, IMAGE *pOut)
+{
+    int *pHisto;
+
+    if (CheckImagePair(pIn, pOut) != 0 || (pIn->nFormat != PIXEL_GRAY8 && pIn->nFormat != PIXEL_GRAY16))
+        return (-1);
+
+    pHisto = (int *)PoolAlloc(GetThreadPool(), ((pIn->nFormat == PIXEL_GRAY16) ? 65536 : 256) * sizeof(int), 1);
+    if (NULL == pHisto)
+        return (-1);
+
+    ImgHistogram(pIn, pHisto);
+    if (pIn->nFormat == PIXEL_GRAY16)
+        HistogramStretching_Gray16(pIn, pOut, pHisto);
+    else
+        HistogramStretching_Gray8(pIn, pOut, pHisto);
+
+    PoolFree(GetThreadPool(), pHisto);
+    return 0;
+}
+
+/*
+ * @Function Name : ImgHistogramEqualization
+ * @Description : 그레이 영상(8, 16비트)의 히스토그램을 만들고 히스토그램 평활화를 수행합니다.
+ * @Input : *pIn
+ * @Output : *pOut, 반환값 0 (성공) / -1 (지원하지 않는 형식, 메모리 할당 오류)
+ */
+int ImgHistogramEqualization(const IMAGE *pIn, IMAGE *pOut)
+{
+    int *pHisto, nResult;
+
+    if (CheckImagePair(pIn, pOut) != 0 || (pIn->nFormat != PIXEL_GRAY8 && pIn->nFormat != PIXEL_GRAY16))
+        return (-1);
+
+    pHisto = (int *)PoolAlloc(GetThreadPool(), ((pIn->nFormat == PIXEL_GRAY16) ? 65536 : 256) * sizeof(int), 1);
+    if (NULL == pHisto)
+        return (-1);
+
+    ImgHistogram(pIn, pHisto);
+    if (pIn->nFormat == PIXEL_GRAY16)
+        nResult = HistogramEqualization_Gray16(pIn, pOut, pHisto);
+    else
+        nResult = HistogramEqualization_Gray8(pIn, pOut, pHisto);
+
+    PoolFree(GetThreadPool(), pHisto);
+    return nResult;
+}
+
+/*
+ * @Function Name : ImgConvolution
+ * @Description : nKernel(KERNEL_xxx) 번호의 3x3 컨볼루션을 수행합니다. (가장자리 1픽셀은 처리하지 않음)
+ * @Input : *pIn, nKernel
+ * @Output : *pOut, 반환값 0 (성공) / -1 (입력 오류)
+ */
+// 김광제의 설명 - 고정 커널은 계수를 정수 상수로 특수화한 Convolution3x3Fixed_X를 먼저 사용하고,
+// 특수화하지 않은 경우(16비트 평균)에만 double 커널로 계산하는 Convolution3x3_X를 사용한다.
+int ImgConvolution(const IMAGE *pIn, IMAGE *pOut, int nKernel)
+{
+    IMAGE In, Out;
+    CONVOLUTION_INFO *pInfo;
+    int nUnits = GetUnitCount(pIn, 0);
+
+    if (CheckImagePair(pIn, pOut) != 0 || nKernel < 0 || nKernel > KERNEL_HPF_LAPLACIAN)
+        return (-1);
+
+    pInfo = &ConvolutionTable[nKernel];
+    for (int u = 0; u < nUnits; u++)
+    {
+        GetUnitView(pIn, u, &In);
+        GetUnitView(pOut, u, &Out);
+        if (CALL_KERNEL(In.nFormat, Convolution3x3Fixed, &In, &Out, nKernel) != 0)
+            CALL_KERNEL(In.nFormat, Convolution3x3, &In, &Out, pInfo->Kernel, pInfo->nPost, pInfo->nDivisor);
+    }
+    CopyRestPlanes(pIn, pOut, nUnits);
+
+    return 0;
+}
+
+/*
+ * @Function Name : ImgConvolutionKernel
+ * @Description : 실행 중에 만든 3x3 커널로 컨볼루션을 수행합니다. (가장자리 1픽셀은 처리하지 않음)
+ * @Input : *pIn,
+ *          Kernel - 3x3 커널,
+ *          nPost - 결과 후처리 방법 (CONV_POST_NONE, CONV_POST_ABS, CONV_POST_CLIP),
+ *          nDivisor - CONV_POST_ABS일 때 절대값을 나눌 값 (1 이상)
+ * @Output : *pOut, 반환값 0 (성공) / -1 (입력 오류)
+ */
+int ImgConvolutionKernel(const IMAGE *pIn, IMAGE *pOut, const double Kernel[3][3], int nPost, int nDivisor)
+{
+    IMAGE In, Out;
+    int nUnits = GetUnitCount(pIn, 0);
+
+    if (CheckImagePair(pIn, pOut) != 0 || NULL == Kernel || nPost < CONV_POST_NONE || nPost > CONV_POST_CLIP || nDivisor < 1)
+        return (-1);
+
+    for (int u = 0; u < nUnits; u++)
+    {
+        GetUnitView(pIn, u, &In);
+        GetUnitView(pOut, u, &Out);
+        CALL_KERNEL(In.nFormat, Convolution3x3, &In, &Out, Kernel, nPost, nDivisor);
+    }
+    CopyRestPlanes(pIn, pOut, nUnits);
+
+    return 0;
+}
+
+/*
+ * @Function Name : ImgMedianFiltering
+ * @Description : nSize X nSize 크기의 Median Filter를 수행합니다.
+ * @Input : *pIn, nSize
+ * @Output : *pOut, 반환값 0 (성공) / -1 (입력 오류, 메모리 할당 오류)
+ */
+int ImgMedianFiltering(const IMAGE *pIn, IMAGE *pOut, int nSize)
+{
+    IMAGE In, Out;
+    int nUnits = GetUnitCount(pIn, 0);
+
+    if (CheckImagePair(pIn, pOut) != 0 || nSize < 1)
+        return (-1);
+
+    for (int u = 0; u < nUnits; u++)
+    {
+        GetUnitView(pIn, u, &In);
+        GetUnitView(pOut, u, &Out);
+        if (CALL_KERNEL(In.nFormat, MedianFiltering, &In, &Out, nSize) != 0)
+            return (-1);
+    }
+    CopyRestPlanes(pIn, pOut, nUnits);
+
+    return 0;
+}
+
+/*
+ * @Function Name : ImgVerticalFlip
+ * @Description : 영상에 대해 Vertical Flip을 수행 (제자리 처리)
+ * @Input : *pImg
+ * @Output : *pImg
+ */
+void ImgVerticalFlip(IMAGE *pImg)
+{
+    IMAGE View;
+
+    for (int u = 0; u < GetUnitCount(pImg, 1); u++)
+    {
+        GetUnitView(pImg, u, &View);
+        CALL_KERNEL(View.nFormat, VerticalFlip, &View);
+    }
+}
+
+/*
+ * @Function Name : ImgHorizontalFlip
+ * @Description : 영상에 대해 Horizontal Flip을 수행 (제자리 처리)
+ * @Input : *pImg
+ * @Output : *pImg
+ */
+void ImgHorizontalFlip(IMAGE *pImg)
+{
+    IMAGE View;
+
+    for (int u = 0; u < GetUnitCount(pImg, 1); u++)
+    {
+        GetUnitView(pImg, u, &View);
+        CALL_KERNEL(View.nFormat, HorizontalFlip, &View);
+    }
+}
+
+/*
+ * @Function Name : ImgTranslation
+ * @Description : 영상을 Tx, Ty 만큼 이동 (pOut의 빈 영역은 그대로 둠)
+ * @Input : *pIn, Tx, Ty
+ * @Output : *pOut, 반환값 0 (성공) / -1 (입력 오류)
+ */
+int ImgTranslation(const IMAGE *pIn, IMAGE *pOut, int Tx, int Ty)
+{
+    IMAGE In, Out;
+
+    if (CheckImagePair(pIn, pOut) != 0)
+        return (-1);
+
+    for (int u = 0; u < GetUnitCount(pIn, 1); u++)
+    {
+        GetUnitView(pIn, u, &In);
+        GetUnitView(pOut, u, &Out);
+        CALL_KERNEL(In.nFormat, Translation, &In, &Out, Tx, Ty);
+    }
+
+    return 0;
+}
+
+/*
+ * @Function Name : ImgScaling
+ * @Description : 영상을 Sx, Sy 비율로 확대/축소 (pOut의 빈 영역은 그대로 둠)
+ * @Input : *pIn, Sx, Sy
+ * @Output : *pOut, 반환값 0 (성공) / -1 (입력 오류)
+ */
+int ImgScaling(const IMAGE *pIn, IMAGE *pOut, double Sx, double Sy)
+{
+    IMAGE In, Out;
+
+    if (CheckImagePair(pIn, pOut) != 0)
+        return (-1);
+
+    for (int u = 0; u < GetUnitCount(pIn, 1); u++)
+    {
+        GetUnitView(pIn, u, &In);
+        GetUnitView(pOut, u, &Out);
+        CALL_KERNEL(In.nFormat, Scaling, &In, &Out, Sx, Sy);
+    }
+
+    return 0;
+}
+
+/*
+ * @Function Name : ImgRotation
+ * @Description : 영상을 (0,0) 기준으로 Angle 만큼 회전 (pOut의 빈 영역은 그대로 둠)
+ * @Input : *pIn, Angle
+ * @Output : *pOut, 반환값 0 (성공) / -1 (입력 오류)
+ */
+int ImgRotation(const IMAGE *pIn, IMAGE *pOut, int Angle)
+{
+    IMAGE In, Out;
+
+    if (CheckImagePair(pIn, pOut) != 0)
+        return (-1);
+
+    for (int u = 0; u < GetUnitCount(pIn, 1); u++)
+    {
+        GetUnitView(pIn, u, &In);
+        GetUnitView(pOut, u, &Out);
+        CALL_KERNEL(In.nFormat, Rotation, &In, &Out, Angle);
+    }
+
+    return 0;
+}
+
+/*
+ * @Function Name : ImgErosion
+ * @Description : 8비트 이진 영상을 침식합니다. (Erosion과 같은 결과, 가장자리 1픽셀은 처리하지 않음)
+ * @Input : *pIn
+ * @Output : *pOut, 반환값 0 (성공) / -1 (입력 오류)
+ */
+int ImgErosion(const IMAGE *pIn, IMAGE *pOut)
+{
+    if (CheckImagePair(pIn, pOut) != 0 || pIn->nFormat != PIXEL_GRAY8)
+        return (-1);
+
+    for (int i = 1; i < pIn->nHeight - 1; i++)
+    {
+        const BYTE *pUp = pIn->pPlane[0] + (size_t)(i - 1) * pIn->nStride;
+        const BYTE *pCur = pUp + pIn->nStride, *pDown = pCur + pIn->nStride;
+        BYTE *pDst = pOut->pPlane[0] + (size_t)i * pOut->nStride;
+
+        // 자신과 4주변 화소가 모두 전경(255)일 때만 전경으로 남김
+        for (int j = 1; j < pIn->nWidth - 1; j++)
+            pDst[j] = (pCur[j] == 255 && pUp[j] == 255 && pDown[j] == 255 && pCur[j - 1] == 255 && pCur[j + 1] == 255) ? 255 : 0;
+    }
+
+    return 0;
+}
+
+/*
+ * @Function Name : ImgDilation
+ * @Description : 8비트 이진 영상을 팽창합니다. (Dilation과 같은 결과, 가장자리 1픽셀은 처리하지 않음)
+ * @Input : *pIn
+ * @Output : *pOut, 반환값 0 (성공) / -1 (입력 오류)
+ */
+int ImgDilation(const IMAGE *pIn, IMAGE *pOut)
+{
+    if (CheckImagePair(pIn, pOut) != 0 || pIn->nFormat != PIXEL_GRAY8)
+        return (-1);
+
+    for (int i = 1; i < pIn->nHeight - 1; i++)
+    {
+        const BYTE *pUp = pIn->pPlane[0] + (size_t)(i - 1) * pIn->nStride;
+        const BYTE *pCur = pUp + pIn->nStride, *pDown = pCur + pIn->nStride;
+        BYTE *pDst = pOut->pPlane[0] + (size_t)i * pOut->nStride;
+
+        // 자신과 4주변 화소가 모두 배경(0)일 때만 배경으로 남김
+        for (int j = 1; j < pIn->nWidth - 1; j++)
+            pDst[j] = (pCur[j] == 0 && pUp[j] == 0 && pDown[j] == 0 && pCur[j - 1] == 0 && pCur[j + 1] == 0) ? 0 : 255;
+    }
+
+    return 0;
+}
+
+/*
+ * @Function Name : ImgDetectObjectEdge
+ * @Description : 8비트 이진 영상에서 전경(0) 객체의 4방향 경계를 추출합니다.
+ * @Input : *pIn
+ * @Output : *pOut (경계 0, 나머지 255), 반환값 0 (성공) / -1 (입력 오류)
+ */
+// 김광제의 설명 - DetectObjectEdge와 같이 영상 밖을 배경으로 보고 처리한다. (가장자리에 닿은 전경 픽셀은 경계가 됨)
+// 행마다 위, 아래 행 포인터를 한번만 정해서 ROI(행 간격이 너비보다 큼)도 그대로 처리
+int ImgDetectObjectEdge(const IMAGE *pIn, IMAGE *pOut)
+{
+    int nWidth = pIn->nWidth, nHeight = pIn->nHeight;
+
+    if (CheckImagePair(pIn, pOut) != 0 || pIn->nFormat != PIXEL_GRAY8)
+        return (-1);
+
+    for (int i = 0; i < nHeight; i++)
+    {
+        const BYTE *pCur = pIn->pPlane[0] + (size_t)i * pIn->nStride;
+        const BYTE *pUp = (i > 0) ? pCur - pIn->nStride : NULL;
+        const BYTE *pDown = (i < nHeight - 1) ? pCur + pIn->nStride : NULL;
+        BYTE *pDst = pOut->pPlane[0] + (size_t)i * pOut->nStride;
+
+        for (int j = 0; j < nWidth; j++)
+        {
+            int bInner = pCur[j] == 0 && pUp != NULL && pUp[j] == 0 && pDown != NULL && pDown[j] == 0 &&
+                         j > 0 && pCur[j - 1] == 0 && j < nWidth - 1 && pCur[j + 1] == 0;
+
+            pDst[j] = (pCur[j] == 0 && !bInner) ? 0 : 255;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * @Function Name : ImgComponentLabeling
+ * @Description : 8비트 이진 영상(ROI 가능)에 대해 ComponentLabeling을 수행합니다. (제자리 처리)
+ * @Input : *pImg, nLabel (1 ~ 3, ComponentLabeling 참고)
+ * @Output : *pImg, 반환값 0 (성공) / -1 (입력 오류, 메모리 할당 오류)
+ */
+// 김광제의 설명 - 레이블링은 영상 크기의 작업 버퍼(스택, 레이블)를 어차피 만들어야 해서 연속 영상이 아닌 경우(ROI)에만 연속 버퍼로 모아서 처리한다.
+// 연속 영상이면 복사 없이 바로 처리
+int ImgComponentLabeling(IMAGE *pImg, int nLabel)
+{
+    int nWidth = pImg->nWidth, nHeight = pImg->nHeight;
+    BYTE *pPacked;
+
+    if (pImg->nFormat != PIXEL_GRAY8)
+        return (-1);
+
+    if (pImg->nStride == nWidth)
+    {
+        ComponentLabeling(pImg->pPlane[0], nHeight, nWidth, nLabel);
+        return 0;
+    }
+
+    pPacked = (BYTE *)PoolAlloc(GetThreadPool(), (size_t)nWidth * nHeight, 0);
+    if (NULL == pPacked)
+        return (-1);
+
+    for (int i = 0; i < nHeight; i++)
+        memcpy(pPacked + (size_t)i * nWidth, pImg->pPlane[0] + (size_t)i * pImg->nStride, nWidth);
+
+    ComponentLabeling(pPacked, nHeight, nWidth, nLabel);
+
+    for (int i = 0; i < nHeight; i++)
+        memcpy(pImg->pPlane[0] + (size_t)i * pImg->nStride, pPacked + (size_t)i * nWidth, nWidth);
+
+    PoolFree(GetThreadPool(), pPacked);
+    return 0;
+}
+
+/*
+ * @Function Name : InverseImageEx
+ * @Description : 픽셀 형식(nFormat)에 맞는 InverseImage를 호출합니다.
+ * @Input : *Input, nWidth, nHeight, nFormat
+ * @Output : *Output
+ */
+// 김광제의 설명 - 8비트는 기존 함수를 그대로 호출하고, 나머지 형식은 버퍼를 IMAGE로 감싸서 ImgXXX 함수에 넘긴다.
+// 아래 ~Ex 함수들은 모두 같은 방식임
+void InverseImageEx(void *Input, void *Output, int nWidth, int nHeight, int nFormat)
+{
+    IMAGE In, Out;
+    PROFILE_BEGIN(dStart);
+
+    if (nFormat == PIXEL_GRAY8)
+        InverseImage((BYTE *)Input, (BYTE *)Output, nWidth, nHeight);
+    else
+    {
+        WrapImage(&In, Input, nWidth, nHeight, nFormat, 0);
+        WrapImage(&Out, Output, nWidth, nHeight, nFormat, 0);
+        ImgInverse(&In, &Out);
+    }
+
+    PROFILE_END(dStart, "inverse", (long long)nWidth * nHeight, (long long)nWidth * nHeight * GetBytesPerPixel(nFormat) * 2);
+}
+
+/*
+ * @Function Name : AdjustBrightnessEx
+ * @Description : 픽셀 형식(nFormat)에 맞는 AdjustBrightness를 호출합니다.
+ * @Input : *Input, nWidth, nHeight, nFormat, nBrightness
+ * @Output : *Output
+ */
+void AdjustBrightnessEx(void *Input, void *Output, int nWidth, int nHeight, int nFormat, int nBrightness)
+{
+    IMAGE In, Out;
+    PROFILE_BEGIN(dStart);
+
+    if (nFormat == PIXEL_GRAY8)
+        AdjustBrightness((BYTE *)Input, (BYTE *)Output, nWidth, nHeight, nBrightness);
+    else
+    {
+        WrapImage(&In, Input, nWidth, nHeight, nFormat, 0);
+        WrapImage(&Out, Output, nWidth, nHeight, nFormat, 0);
+        ImgAdjustBrightness(&In, &Out, nBrightness);
+    }
+
+    PROFILE_END(dStart, "brightness", (long long)nWidth * nHeight, (long long)nWidth * nHeight * GetBytesPerPixel(nFormat) * 2);
+}
+
+/*
+ * @Function Name : AdjustContrastEx
+ * @Description : 픽셀 형식(nFormat)에 맞는 AdjustContrast를 호출합니다.
+ * @Input : *Input, nWidth, nHeight, nFormat, dContrast
+ * @Output : *Output
+ */
+void AdjustContrastEx(void *Input, void *Output, int nWidth, int nHeight, int nFormat, double dContrast)
+{
+    IMAGE In, Out;
+    PROFILE_BEGIN(dStart);
+
+    if (nFormat == PIXEL_GRAY8)
+        AdjustContrast((BYTE *)Input, (BYTE *)Output, nWidth, nHeight, dContrast);
+    else
+    {
+        WrapImage(&In, Input, nWidth, nHeight, nFormat, 0);
+        WrapImage(&Out, Output, nWidth, nHeight, nFormat, 0);
+        ImgAdjustContrast(&In, &Out, dContrast);
+    }
+
+    PROFILE_END(dStart, "contrast", (long long)nWidth * nHeight, (long long)nWidth * nHeight * GetBytesPerPixel(nFormat) * 2);
+}
+
+/*
+ * @Function Name : GenerateBinarizationEx
+ * @Description : 픽셀 형식(nFormat)에 맞는 GenerateBinarization을 호출합니다.
+ * @Input : *Input, nWidth, nHeight, nFormat, nThreshold (영상의 밝기 범위 단위)
+ * @Output : *Output
+ */
+void GenerateBinarizationEx(void *Input, void *Output, int nWidth, int nHeight, int nFormat, unsigned int nThreshold)
+{
+    IMAGE In, Out;
+    PROFILE_BEGIN(dStart);
+
+    if (nFormat == PIXEL_GRAY8)
+        GenerateBinarization((BYTE *)Input, (BYTE *)Output, nWidth, nHeight, (BYTE)nThreshold);
+    else
+    {
+        WrapImage(&In, Input, nWidth, nHeight, nFormat, 0);
+        WrapImage(&Out, Output, nWidth, nHeight, nFormat, 0);
+        ImgBinarization(&In, &Out, nThreshold);
+    }
+
+    PROFILE_END(dStart, "binarization", (long long)nWidth * nHeight, (long long)nWidth * nHeight * GetBytesPerPixel(nFormat) * 2);
+}
+
+/*
+ * @Function Name : CombineMaxEx
+ * @Description : 픽셀 형식(nFormat)에 맞게 두 영상 중 큰 값을 Output에 저장합니다.
+ * @Input : *Input, *Output, nWidth, nHeight, nFormat
+ * @Output : *Output
+ */
+void CombineMaxEx(void *Input, void *Output, int nWidth, int nHeight, int nFormat)
+{
+    IMAGE In, Out;
+    PROFILE_BEGIN(dStart);
+
+    WrapImage(&In, Input, nWidth, nHeight, nFormat, 0);
+    WrapImage(&Out, Output, nWidth, nHeight, nFormat, 0);
+    ImgCombineMax(&In, &Out);
+
+    PROFILE_END(dStart, "combine_max", (long long)nWidth * nHeight, (long long)nWidth * nHeight * GetBytesPerPixel(nFormat) * 3);
+}
+
+/*
+ * @Function Name : HistogramStretchingEx
+ * @Description : 그레이 영상(8, 16비트)의 히스토그램을 만들고 히스토그램 스트래칭을 수행합니다.
+ * @Input : *Input, nWidth, nHeight, nFormat
+ * @Output : *Output, 반환값 0 (성공) / -1 (지원하지 않는 형식, 메모리 할당 오류)
+ */
+int HistogramStretchingEx(void *Input, void *Output, int nWidth, int nHeight, int nFormat)
+{
+    int nHisto[256] = {
+        0,
+    };
+    IMAGE In, Out;
+    int nRet = 0;
+    PROFILE_BEGIN(dStart);
+
+    if (nFormat == PIXEL_GRAY8)
+    {
+        GenerateHistogram((BYTE *)Input, nHisto, nWidth, nHeight);
+        HistogramStretching((BYTE *)Input, (BYTE *)Output, nHisto, nWidth, nHeight);
+    }
+    else
+    {
+        WrapImage(&In, Input, nWidth, nHeight, nFormat, 0);
+        WrapImage(&Out, Output, nWidth, nHeight, nFormat, 0);
+        nRet = ImgHistogramStretching(&In, &Out);
+    }
+
+    PROFILE_END(dStart, "histogram_stretching", (long long)nWidth * nHeight, (long long)nWidth * nHeight * GetBytesPerPixel(nFormat) * 2);
+    return nRet;
+}
+
+/*
+ * @Function Name : HistogramEqualizationEx
+ * @Description : 그레이 영상(8, 16비트)의 히스토그램을 만들고 히스토그램 평활화를 수행합니다.
+ * @Input : *Input, nWidth, nHeight, nFormat
+ * @Output : *Output, 반환값 0 (성공) / -1 (지원하지 않는 형식, 메모리 할당 오류)
+ */
+int HistogramEqualizationEx(void *Input, void *Output, int nWidth, int nHeight, int nFormat)
+{
+    int nHisto[256] = {
+        0,
+    };
+    IMAGE In, Out;
+    int nRet = 0;
+    PROFILE_BEGIN(dStart);
+
+    if (nFormat == PIXEL_GRAY8)
+    {
+        GenerateHistogram((BYTE *)Input, nHisto, nWidth, nHeight);
+        HistogramEqualization((BYTE *)Input, (BYTE *)Output, nHisto, nWidth, nHeight);
+    }
+    else
+    {
+        WrapImage(&In, Input, nWidth, nHeight, nFormat, 0);
+        WrapImage(&Out, Output, nWidth, nHeight, nFormat, 0);
+        nRet = ImgHistogramEqualization(&In, &Out);
+    }
+
+    PROFILE_END(dStart, "histogram_equalization", (long long)nWidth * nHeight, (long long)nWidth * nHeight * GetBytesPerPixel(nFormat) * 2);
+    return nRet;
+}
+
+/*
+ * @Function Name : ConvolutionEx
+ * @Description : nKernel(KERNEL_xxx) 번호의 3x3 컨볼루션을 픽셀 형식에 맞게 수행합니다.
+ * @Input : *Input, nWidth, nHeight, nFormat, nKernel
+ * @Output : *Output
+ */
+// 김광제의 설명 - 모든 형식을 ImgConvolution으로 처리한다. (8비트도 기존 XXXConvolution 함수와 결과가 같은 정수 커널 사용)
+void ConvolutionEx(void *Input, void *Output, int nWidth, int nHeight, int nFormat, int nKernel)
+{
+    IMAGE In, Out;
+    PROFILE_BEGIN(dStart);
+
+    WrapImage(&In, Input, nWidth, nHeight, nFormat, 0);
+    WrapImage(&Out, Output, nWidth, nHeight, nFormat, 0);
+    ImgConvolution(&In, &Out, nKernel);
+
+    PROFILE_END(dStart, "convolution", (long long)nWidth * nHeight, (long long)nWidth * nHeight * GetBytesPerPixel(nFormat) * 2);
+}
+
+/*
+ * @Function Name : MedianFilteringEx
+ * @Description : 픽셀 형식(nFormat)에 맞는 MedianFiltering을 호출합니다.
+ * @Input : *Input, nWidth, nHeight, nFormat, nSize
+ * @Output : *Output, 반환값 0 (성공) / -1 (메모리 할당 오류)
+ */
+int MedianFilteringEx(void *Input, void *Output, int nWidth, int nHeight, int nFormat, int nSize)
+{
+    IMAGE In, Out;
+    int nRet = 0;
+    PROFILE_BEGIN(dStart);
+
+    if (nFormat == PIXEL_GRAY8)
+        MedianFiltering((BYTE *)Input, (BYTE *)Output, nWidth, nHeight, nSize);
+    else
+    {
+        WrapImage(&In, Input, nWidth, nHeight, nFormat, 0);
+        WrapImage(&Out, Output, nWidth, nHeight, nFormat, 0);
+        nRet = ImgMedianFiltering(&In, &Out, nSize);
+    }
+
+    PROFILE_END(dStart, "median_filtering", (long long)nWidth * nHeight, (long long)nWidth * nHeight * GetBytesPerPixel(nFormat) * 2);
+    return nRet;
+}
+
+/*
+ * @Function Name : VerticalFlipEx
+ * @Description : 픽셀 형식(nFormat)에 맞는 VerticalFlip을 호출합니다.
+ * @Input : *Input, nWidth, nHeight, nFormat
+ * @Output : *Input
+ */
+void VerticalFlipEx(void *Input, int nWidth, int nHeight, int nFormat)
+{
+    IMAGE Img;
+    PROFILE_BEGIN(dStart);
+
+    if (nFormat == PIXEL_GRAY8)
+        VerticalFlip((BYTE *)Input, nWidth, nHeight);
+    else
+    {
+        WrapImage(&Img, Input, nWidth, nHeight, nFormat, 0);
+        ImgVerticalFlip(&Img);
+    }
+
+    PROFILE_END(dStart, "vertical_flip", (long long)nWidth * nHeight, (long long)nWidth * nHeight * GetBytesPerPixel(nFormat) * 2);
+}
+
+/*
+ * @Function Name : HorizontalFlipEx
+ * @Description : 픽셀 형식(nFormat)에 맞는 HorizontalFlip을 호출합니다.
+ * @Input : *Input, nWidth, nHeight, nFormat
+ * @Output : *Input
+ */
+void HorizontalFlipEx(void *Input, int nWidth, int nHeight, int nFormat)
+{
+    IMAGE Img;
+    PROFILE_BEGIN(dStart);
+
+    if (nFormat == PIXEL_GRAY8)
+        HorizontalFlip((BYTE *)Input, nWidth, nHeight);
+    else
+    {
+        WrapImage(&Img, Input, nWidth, nHeight, nFormat, 0);
+        ImgHorizontalFlip(&Img);
+    }
+
+    PROFILE_END(dStart, "horizontal_flip", (long long)nWidth * nHeight, (long long)nWidth * nHeight * GetBytesPerPixel(nFormat) * 2);
+}
+
+/*
+ * @Function Name : TranslationEx
+ * @Description : 픽셀 형식(nFormat)에 맞는 Translation을 호출합니다.
+ * @Input : *Input, nWidth, nHeight, nFormat, Tx, Ty
+ * @Output : *Output
+ */
+void TranslationEx(void *Input, void *Output, int nWidth, int nHeight, int nFormat, int Tx, int Ty)
+{
+    IMAGE In, Out;
+    PROFILE_BEGIN(dStart);
+
+    if (nFormat == PIXEL_GRAY8)
+        Translation((BYTE *)Input, (BYTE *)Output, nWidth, nHeight, Tx, Ty);
+    else
+    {
+        WrapImage(&In, Input, nWidth, nHeight, nFormat, 0);
+        WrapImage(&Out, Output, nWidth, nHeight, nFormat, 0);
+        ImgTranslation(&In, &Out, Tx, Ty);
+    }
+
+    PROFILE_END(dStart, "translation", (long long)nWidth * nHeight, (long long)nWidth * nHeight * GetBytesPerPixel(nFormat) * 2);
+}
+
+/*
+ * @Function Name : ScalingEx
+ * @Description : 픽셀 형식(nFormat)에 맞는 Scaling을 호출합니다.
+ * @Input : *Input, nWidth, nHeight, nFormat, Sx, Sy
+ * @Output : *Output
+ */
+void ScalingEx(void *Input, void *Output, int nWidth, int nHeight, int nFormat, double Sx, double Sy)
+{
+    IMAGE In, Out;
+    PROFILE_BEGIN(dStart);
+
+    if (nFormat == PIXEL_GRAY8)
+        Scaling((BYTE *)Input, (BYTE *)Output, nWidth, nHeight, Sx, Sy);
+    else
+    {
+        WrapImage(&In, Input, nWidth, nHeight, nFormat, 0);
+        WrapImage(&Out, Output, nWidth, nHeight, nFormat, 0);
+        ImgScaling(&In, &Out, Sx, Sy);
+    }
+
+    PROFILE_END(dStart, "scaling", (long long)nWidth * nHeight, (long long)nWidth * nHeight * GetBytesPerPixel(nFormat) * 2);
+}
+
+/*
+ * @Function Name : RotationEx
+ * @Description : 픽셀 형식(nFormat)에 맞는 Rotation을 호출합니다.
+ * @Input : *Input, nWidth, nHeight, nFormat, Angle
+ * @Output : *Output
+ */
+void RotationEx(void *Input, void *Output, int nWidth, int nHeight, int nFormat, int Angle)
+{
+    IMAGE In, Out;
+    PROFILE_BEGIN(dStart);
+
+    if (nFormat == PIXEL_GRAY8)
+        Rotation((BYTE *)Input, (BYTE *)Output, nWidth, nHeight, Angle);
+    else
+    {
+        WrapImage(&In, Input, nWidth, nHeight, nFormat, 0);
+        WrapImage(&Out, Output, nWidth, nHeight, nFormat, 0);
+        ImgRotation(&In, &Out, Angle);
+    }
+
+    PROFILE_END(dStart, "rotation", (long long)nWidth * nHeight, (long long)nWidth * nHeight * GetBytesPerPixel(nFormat) * 2);
+}
+
+/*
+ * @Function Name : DeinterleaveBGR24
+ * @Description : BGRBGR... 순서의 픽셀을 B, G, R 평면으로 분리합니다.
+ * @Input : *pSrc, nCount - 픽셀 수
+ * @Output : *pB, *pG, *pR
+ */
+// 김광제의 설명 - SSSE3의 pshufb(_mm_shuffle_epi8)로 48바이트(16픽셀)씩 한번에 분리한다.
+// 16바이트 레지스터 3개에 흩어진 B(또는 G, R) 값을 각각 모아서 OR로 합치는 방식 (마스크의 -1 위치는 0이 됨)
+void DeinterleaveBGR24(const BYTE *pSrc, BYTE *pB, BYTE *pG, BYTE *pR, int nCount)
+{
+    int i = 0;
+
+#ifdef IMGPROC_SSSE3
+    const __m128i mB0 = _mm_setr_epi8(0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i mB1 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14, -1, -1, -1, -1, -1);
+    const __m128i mB2 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, 4, 7, 10, 13);
+    const __m128i mG0 = _mm_setr_epi8(1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i mG1 = _mm_setr_epi8(-1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1);
+    const __m128i mG2 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14);
+    const __m128i mR0 = _mm_setr_epi8(2, 5, 8, 11, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i mR1 = _mm_setr_epi8(-1, -1, -1, -1, -1, 1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1);
+    const __m128i mR2 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15);
+
+    for (; i + 16 <= nCount; i += 16)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i *)(pSrc + i * 3));
+        __m128i b = _mm_loadu_si128((const __m128i *)(pSrc + i * 3 + 16));
+        __m128i c = _mm_loadu_si128((const __m128i *)(pSrc + i * 3 + 32));
+
+        _mm_storeu_si128((__m128i *)(pB + i), _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, mB0), _mm_shuffle_epi8(b, mB1)), _mm_shuffle_epi8(c, mB2)));
+        _mm_storeu_si128((__m128i *)(pG + i), _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, mG0), _mm_shuffle_epi8(b, mG1)), _mm_shuffle_epi8(c, mG2)));
+        _mm_storeu_si128((__m128i *)(pR + i), _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, mR0), _mm_shuffle_epi8(b, mR1)), _mm_shuffle_epi8(c, mR2)));
+    }
+#endif
+
+    // 남은 픽셀 (또는 SSSE3를 사용할 수 없는 경우 전체)
+    for (; i < nCount; i++)
+    {
+        pB[i] = pSrc[i * 3];
+        pG[i] = pSrc[i * 3 + 1];
+        pR[i] = pSrc[i * 3 + 2];
+    }
+}
+
+/*
+ * @Function Name : InterleaveBGR24
+ * @Description : B, G, R 평면을 BGRBGR... 순서로 합칩니다.
+ * @Input : *pB, *pG, *pR, nCount - 픽셀 수
+ * @Output : *pDst
+ */
+// 김광제의 설명 - DeinterleaveBGR24의 반대 과정으로 평면 레지스터 3개에서 출력 16바이트씩 골라서 합친다.
+void InterleaveBGR24(const BYTE *pB, const BYTE *pG, const BYTE *pR, BYTE *pDst, int nCount)
+{
+    int i = 0;
+
+#ifdef IMGPROC_SSSE3
+    const __m128i mB0 = _mm_setr_epi8(0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1, 5);
+    const __m128i mG0 = _mm_setr_epi8(-1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1);
+    const __m128i mR0 = _mm_setr_epi8(-1, -1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1);
+    const __m128i mB1 = _mm_setr_epi8(-1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10, -1);
+    const __m128i mG1 = _mm_setr_epi8(5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10);
+    const __m128i mR1 = _mm_setr_epi8(-1, 5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1);
+    const __m128i mB2 = _mm_setr_epi8(-1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1, -1);
+    const __m128i mG2 = _mm_setr_epi8(-1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1);
+    const __m128i mR2 = _mm_setr_epi8(10, -1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15);
+
+    for (; i + 16 <= nCount; i += 16)
+    {
+        __m128i b = _mm_loadu_si128((const __m128i *)(pB + i));
+        __m128i g = _mm_loadu_si128((const __m128i *)(pG + i));
+        __m128i r = _mm_loadu_si128((const __m128i *)(pR + i));
+
+        _mm_storeu_si128((__m128i *)(pDst + i * 3), _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(b, mB0), _mm_shuffle_epi8(g, mG0)), _mm_shuffle_epi8(r, mR0)));
+        _mm_storeu_si128((__m128i *)(pDst + i * 3 + 16), _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(b, mB1), _mm_shuffle_epi8(g, mG1)), _mm_shuffle_epi8(r, mR1)));
+        _mm_storeu_si128((__m128i *)(pDst + i * 3 + 32), _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(b, mB2), _mm_shuffle_epi8(g, mG2)), _mm_shuffle_epi8(r, mR2)));
+    }
+#endif
+
+    for (; i < nCount; i++)
+    {
+        pDst[i * 3] = pB[i];
+        pDst[i * 3 + 1] = pG[i];
+        pDst[i * 3 + 2] = pR[i];
+    }
+}
+
+/*
+ * @Function Name : DeinterleaveBGRA32
+ * @Description : BGRABGRA... 순서의 픽셀을 B, G, R, A 평면으로 분리합니다.
+ * @Input : *pSrc, nCount - 픽셀 수
+ * @Output : *pB, *pG, *pR, *pA
+ */
+// 김광제의 설명 - 레지스터마다 4픽셀을 B4 G4 R4 A4 순서로 모은 다음 4x4 (32비트 단위) 전치로 평면을 만든다.
+void DeinterleaveBGRA32(const BYTE *pSrc, BYTE *pB, BYTE *pG, BYTE *pR, BYTE *pA, int nCount)
+{
+    int i = 0;
+
+#ifdef IMGPROC_SSSE3
+    const __m128i mGroup = _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+
+    for (; i + 16 <= nCount; i += 16)
+    {
+        __m128i a = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(pSrc + i * 4)), mGroup);
+        __m128i b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(pSrc + i * 4 + 16)), mGroup);
+        __m128i c = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(pSrc + i * 4 + 32)), mGroup);
+        __m128i d = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(pSrc + i * 4 + 48)), mGroup);
+        __m128i ab0 = _mm_unpacklo_epi32(a, b), ab1 = _mm_unpackhi_epi32(a, b); // B B G G, R R A A
+        __m128i cd0 = _mm_unpacklo_epi32(c, d), cd1 = _mm_unpackhi_epi32(c, d);
+
+        _mm_storeu_si128((__m128i *)(pB + i), _mm_unpacklo_epi64(ab0, cd0));
+        _mm_storeu_si128((__m128i *)(pG + i), _mm_unpackhi_epi64(ab0, cd0));
+        _mm_storeu_si128((__m128i *)(pR + i), _mm_unpacklo_epi64(ab1, cd1));
+        _mm_storeu_si128((__m128i *)(pA + i), _mm_unpackhi_epi64(ab1, cd1));
+    }
+#endif
+
+    for (; i < nCount; i++)
+    {
+        pB[i] = pSrc[i * 4];
+        pG[i] = pSrc[i * 4 + 1];
+        pR[i] = pSrc[i * 4 + 2];
+        pA[i] = pSrc[i * 4 + 3];
+    }
+}
+
+/*
+ * @Function Name : InterleaveBGRA32
+ * @Description : B, G, R, A 평면을 BGRABGRA... 순서로 합칩니다.
+ * @Input : *pB, *pG, *pR, *pA, nCount - 픽셀 수
+ * @Output : *pDst
+ */
+// 김광제의 설명 - 전치 후 같은 셔플 마스크를 한번 더 적용하면 원래 순서로 돌아온다. (4x4 바이트 전치는 자기 자신이 역변환)
+void InterleaveBGRA32(const BYTE *pB, const BYTE *pG, const BYTE *pR, const BYTE *pA, BYTE *pDst, int nCount)
+{
+    int i = 0;
+
+#ifdef IMGPROC_SSSE3
+    const __m128i mGroup = _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+
+    for (; i + 16 <= nCount; i += 16)
+    {
+        __m128i b = _mm_loadu_si128((const __m128i *)(pB + i));
+        __m128i g = _mm_loadu_si128((const __m128i *)(pG + i));
+        __m128i r = _mm_loadu_si128((const __m128i *)(pR + i));
+        __m128i a = _mm_loadu_si128((const __m128i *)(pA + i));
+        __m128i bg0 = _mm_unpacklo_epi32(b, g), bg1 = _mm_unpackhi_epi32(b, g);
+        __m128i ra0 = _mm_unpacklo_epi32(r, a), ra1 = _mm_unpackhi_epi32(r, a);
+
+        _mm_storeu_si128((__m128i *)(pDst + i * 4), _mm_shuffle_epi8(_mm_unpacklo_epi64(bg0, ra0), mGroup));
+        _mm_storeu_si128((__m128i *)(pDst + i * 4 + 16), _mm_shuffle_epi8(_mm_unpackhi_epi64(bg0, ra0), mGroup));
+        _mm_storeu_si128((__m128i *)(pDst + i * 4 + 32), _mm_shuffle_epi8(_mm_unpacklo_epi64(bg1, ra1), mGroup));
+        _mm_storeu_si128((__m128i *)(pDst + i * 4 + 48), _mm_shuffle_epi8(_mm_unpackhi_epi64(bg1, ra1), mGroup));
+    }
+#endif
+
+    for (; i < nCount; i++)
+    {
+        pDst[i * 4] = pB[i];
+        pDst[i * 4 + 1] = pG[i];
+        pDst[i * 4 + 2] = pR[i];
+        pDst[i * 4 + 3] = pA[i];
+    }
+}
+
+/*
+ * @Function Name : RGBToGrayPlanar
+ * @Description : B, G, R 평면을 밝기(Y) 평면으로 변환합니다.
+ * @Input : *pB, *pG, *pR, nCount - 픽셀 수
+ * @Output : *pGray
+ */
+// 김광제의 설명 - Y = 0.299R + 0.587G + 0.114B 를 256배 한 정수 계수 (77, 150, 29)로 계산한다. (합이 256이라 >> 8)
+// 최대값이 255 X 256 + 128 = 65408로 16비트 부호없는 범위 안이라 SSE2로 8픽셀씩 16비트 곱셈이 가능함
+void RGBToGrayPlanar(const BYTE *pB, const BYTE *pG, const BYTE *pR, BYTE *pGray, int nCount)
+{
+    int i = 0;
+
+#ifdef IMGPROC_SSE2
+    const __m128i kB = _mm_set1_epi16(LUMA_B), kG = _mm_set1_epi16(LUMA_G), kR = _mm_set1_epi16(LUMA_R);
+    const __m128i kRound = _mm_set1_epi16(128), kZero = _mm_setzero_si128();
+
+    for (; i + 16 <= nCount; i += 16)
+    {
+        __m128i b = _mm_loadu_si128((const __m128i *)(pB + i));
+        __m128i g = _mm_loadu_si128((const __m128i *)(pG + i));
+        __m128i r = _mm_loadu_si128((const __m128i *)(pR + i));
+        __m128i lo, hi;
+
+        lo = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(b, kZero), kB), _mm_mullo_epi16(_mm_unpacklo_epi8(g, kZero), kG)),
+                           _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(r, kZero), kR), kRound));
+        hi = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(b, kZero), kB), _mm_mullo_epi16(_mm_unpackhi_epi8(g, kZero), kG)),
+                           _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(r, kZero), kR), kRound));
+
+        _mm_storeu_si128((__m128i *)(pGray + i), _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8)));
+    }
+#endif
+
+    for (; i < nCount; i++)
+        pGray[i] = (BYTE)((LUMA_B * pB[i] + LUMA_G * pG[i] + LUMA_R * pR[i] + 128) >> 8);
+}
+
+/*
+ * @Function Name : RGBToGrayInterleaved
+ * @Description : BGR(A) 순서로 저장된 픽셀을 밝기(Y) 평면으로 변환합니다.
+ * @Input : *pSrc, nChannels (3, 4), nCount - 픽셀 수
+ * @Output : *pGray
+ */
+// 김광제의 설명 - 임시 평면 버퍼를 만들지 않도록 스택의 작은 블록(256픽셀) 단위로 분리 -> 밝기 변환을 반복한다.
+// 블록이 L1 캐시에 머물기 때문에 평면 전체를 만들어서 변환하는 것보다 메모리 접근이 적음
+void RGBToGrayInterleaved(const BYTE *pSrc, int nChannels, BYTE *pGray, int nCount)
+{
+    BYTE B[256], G[256], R[256], A[256];
+
+    for (int i = 0; i < nCount; i += 256)
+    {
+        int nBlock = (nCount - i < 256) ? nCount - i : 256;
+
+        if (nChannels == 4)
+            DeinterleaveBGRA32(pSrc + (size_t)i * 4, B, G, R, A, nBlock);
+        else
+            DeinterleaveBGR24(pSrc + (size_t)i * 3, B, G, R, nBlock);
+
+        RGBToGrayPlanar(B, G, R, pGray + i, nBlock);
+    }
+}
+
+/*
+ * @Function Name : ConvertLayout
+ * @Description : 같은 형식의 영상을 pDst의 저장 방식(Interleaved <-> Planar)으로 변환합니다.
+ * @Input : *pSrc
+ * @Output : *pDst (같은 크기, 형식의 영상, ROI 가능), 반환값 0 (성공) / -1 (입력 오류)
+ */
+// 김광제의 설명 - 행마다 nStride 간격이 다를 수 있어서 (ROI) 행 단위로 변환한다.
+int ConvertLayout(const IMAGE *pSrc, IMAGE *pDst)
+{
+    int nWidth = pSrc->nWidth;
+
+    if (pSrc->nWidth != pDst->nWidth || pSrc->nHeight != pDst->nHeight || pSrc->nFormat != pDst->nFormat)
+        return (-1);
+
+    if (pSrc->nLayout == pDst->nLayout) // 같은 방식이면 복사만
+    {
+        int nPlanes = (pSrc->nLayout == LAYOUT_PLANAR) ? pSrc->nChannels : 1;
+        int nRowBytes = (pSrc->nLayout == LAYOUT_PLANAR) ? nWidth : nWidth * GetBytesPerPixel(pSrc->nFormat);
+
+        for (int c = 0; c < nPlanes; c++)
+            for (int i = 0; i < pSrc->nHeight; i++)
+                memcpy(pDst->pPlane[c] + (size_t)i * pDst->nStride, pSrc->pPlane[c] + (size_t)i * pSrc->nStride, nRowBytes);
+        return 0;
+    }
+
+    for (int i = 0; i < pSrc->nHeight; i++)
+    {
+        size_t nSrcRow = (size_t)i * pSrc->nStride, nDstRow = (size_t)i * pDst->nStride;
+
+        if (pDst->nLayout == LAYOUT_PLANAR)
+        {
+            if (pSrc->nChannels == 4)
+                DeinterleaveBGRA32(pSrc->pPlane[0] + nSrcRow, pDst->pPlane[0] + nDstRow, pDst->pPlane[1] + nDstRow, pDst->pPlane[2] + nDstRow, pDst->pPlane[3] + nDstRow, nWidth);
+            else
+                DeinterleaveBGR24(pSrc->pPlane[0] + nSrcRow, pDst->pPlane[0] + nDstRow, pDst->pPlane[1] + nDstRow, pDst->pPlane[2] + nDstRow, nWidth);
+        }
+        else
+        {
+            if (pSrc->nChannels == 4)
+                InterleaveBGRA32(pSrc->pPlane[0] + nSrcRow, pSrc->pPlane[1] + nSrcRow, pSrc->pPlane[2] + nSrcRow, pSrc->pPlane[3] + nSrcRow, pDst->pPlane[0] + nDstRow, nWidth);
+            else
+                InterleaveBGR24(pSrc->pPlane[0] + nSrcRow, pSrc->pPlane[1] + nSrcRow, pSrc->pPlane[2] + nSrcRow, pDst->pPlane[0] + nDstRow, nWidth);
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * @Function Name : ConvertToGray
+ * @Description : 컬러 영상(Interleaved 또는 Planar)을 8비트 그레이 영상으로 변환합니다.
+ * @Input : *pSrc
+ * @Output : *pGray - 같은 크기의 8비트 그레이 영상 (ROI 가능), 반환값 0 (성공) / -1 (입력 오류, 지원하지 않는 형식)
+ */
+// 김광제의 설명 - 카메라 영상 처리의 첫 단계라서 저장 방식별로 복사 없이 바로 변환한다.
+int ConvertToGray(const IMAGE *pSrc, IMAGE *pGray)
+{
+    int nWidth = pSrc->nWidth;
+    PROFILE_BEGIN(dStart);
+
+    if (pGray->nFormat != PIXEL_GRAY8 || pGray->nWidth != nWidth || pGray->nHeight != pSrc->nHeight)
+        return (-1);
+
+    if (pSrc->nFormat != PIXEL_GRAY8 && pSrc->nFormat != PIXEL_BGR24 && pSrc->nFormat != PIXEL_BGRA32)
+        return (-1);
+
+    for (int i = 0; i < pSrc->nHeight; i++)
+    {
+        size_t nSrcRow = (size_t)i * pSrc->nStride;
+        BYTE *pDst = pGray->pPlane[0] + (size_t)i * pGray->nStride;
+
+        if (pSrc->nFormat == PIXEL_GRAY8)
+            memcpy(pDst, pSrc->pPlane[0] + nSrcRow, nWidth);
+        else if (pSrc->nLayout == LAYOUT_PLANAR)
+            RGBToGrayPlanar(pSrc->pPlane[0] + nSrcRow, pSrc->pPlane[1] + nSrcRow, pSrc->pPlane[2] + nSrcRow, pDst, nWidth);
+        else
+            RGBToGrayInterleaved(pSrc->pPlane[0] + nSrcRow, pSrc->nChannels, pDst, nWidth);
+    }
+
+    PROFILE_END(dStart, "convert_to_gray", (long long)nWidth * pSrc->nHeight, (long long)nWidth * pSrc->nHeight * (GetBytesPerPixel(pSrc->nFormat) + 1));
+    return 0;
+}
+
+/*
+ * @Function Name : ApplyPlanes
+ * @Description : 8비트 단일 채널 함수(InverseImage, XXXConvolution, MedianFilter, ...)를 Planar 영상의 채널마다 적용합니다.
+ * @Input : *pSrc - Planar 영상, Func - 적용할 함수, bAlpha - 알파 채널도 처리할지 여부
+ * @Output : *pDst - 같은 크기의 Planar 영상, 반환값 0 (성공) / -1 (입력 오류)
+ */
+// 김광제의 설명 - Planar 영상의 각 평면은 그 자체로 nWidth X nHeight 8비트 영상이라서 기존 함수에 평면 주소만 넘기면 된다. (복사 없음)
+// 기존 함수는 행 간격을 모르기 때문에 행이 연속된 영상(CreateImage로 만든 영상)만 처리하고, ROI는 ImgXXX 함수를 사용
+// 알파 채널을 처리하지 않는 경우에는 원본 알파를 그대로 복사
+int ApplyPlanes(const IMAGE *pSrc, IMAGE *pDst, IMAGE_FUNC Func, int bAlpha)
+{
+    int nColor = GetUnitCount(pSrc, bAlpha);
+
+    if (pSrc->nLayout != LAYOUT_PLANAR && pSrc->nChannels != 1)
+        return (-1);
+    if (CheckImagePair(pSrc, pDst) != 0 || pSrc->nStride != pSrc->nWidth || pDst->nStride != pDst->nWidth)
+        return (-1);
+
+    for (int c = 0; c < nColor; c++)
+        Func(pSrc->pPlane[c], pDst->pPlane[c], pSrc->nWidth, pSrc->nHeight);
+
+    CopyRestPlanes(pSrc, pDst, nColor);
+
+    return 0;
+}
@@ -0,0 +1,626 @@
+/*
+ * @Name : imgprocessing.h
+ * @Description : Image Processing in C 라이브러리 헤더 (영상 구조체, 버퍼 풀, 처리 함수, BMP 입출력)
+ * @Date : 2026. 10. 19
+ * @Revision : 2.5
+ * 1.0 : imgprocessing.c, bmpio.c 공개 선언 (Windows.h 없이 BYTE, WORD, DWORD, CHAR 정의)
+ * 1.1 : context.c 처리 컨텍스트, 기능 번호(OP_xxx), C++에서 사용할 수 있도록 extern "C"
+ * 1.2 : pipeline.c 지연 실행 파이프라인 (PIPELINE)
+ * 1.3 : ImgConvolutionKernel (실행 중에 만든 커널), CONVOLUTION_INFO 커널 const
+ * 1.4 : batch.c 일괄 처리 (BatchProcess)
+ * 1.5 : RLE8, 1비트 BMP, pngio.c PNG 저장 (WriteImageFile, FILE_xxx), BatchProcess 저장 형식
+ * 1.6 : distance.c 거리 변환 (DIST_xxx), 반지름 단위 침식/팽창 (OP_EROSION_RADIUS, OP_DILATION_RADIUS)
+ * 1.7 : hough.c 원 허프 변환 (ImgHoughCircles, HOUGH_CIRCLE)
+ * 1.8 : 직선 허프 변환 (ImgHoughLines, HOUGH_LINE, HOUGH_LINES_xxx)
+ * 1.9 : watershed.c 워터셰드 영역 분할 (ImgWatershed, ImgSplitObjects)
+ * 2.0 : contour.c 윤곽선 추적 (ImgFindContours, SimplifyContours, CONTOUR_SET)
+ * 2.1 : fill.c 영역 채우기 (ImgFloodFill), 구멍 채우기 (ImgFillHoles, OP_FILL_HOLES)
+ * 2.2 : rle.c 런 길이 부호화 이진 영상 (RLE_IMAGE), 런 단위 레이블링, 침식, 팽창
+ * 2.3 : fft.c 2차원 실수 FFT (FFT_PLAN), 큰 커널 컨볼루션 (ImgConvolutionLarge, CONV_METHOD_xxx), 주파수 영역 필터 (FFT_FILTER, FREQ_xxx, OP_FREQUENCY_FILTER)
+ * 2.4 : registration.c 위상 상관 영상 정합 (PHASE_CORR, PhaseCorrMatch, ImgPhaseCorrelate)
+ * 2.5 : blur.c 재귀 가우시안 흐림 (ImgGaussianBlur, BLUR_xxx, OP_GAUSSIAN_BLUR)
+ */
+
+#ifndef IMGPROCESSING_H
+#define IMGPROCESSING_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Windows.h의 정수 형식 (Windows.h 없이 Linux, macOS에서도 빌드되도록 직접 정의)
+typedef unsigned char BYTE;
+typedef unsigned short WORD;
+typedef unsigned int DWORD; // BMP 헤더, 마스크는 32비트 (Linux의 unsigned long은 64비트)
+typedef char CHAR;
+
+#pragma pack(push, 1) // 패딩을 최소화하여 메모리를 절약
+typedef struct
+{
+    unsigned short bfType;      // BMP 파일 식별자, "BM"으로 설정됩니다. (2 바이트)
+    unsigned int bfSize;        // BMP 파일 전체 크기 (바이트). 파일 헤더와 이미지 데이터의 총 크기를 나타냅니다. (4 바이트)
+    unsigned short bfReserved1; // 예약된 필드, 일반적으로 0으로 설정됩니다. (2 바이트)
+    unsigned short bfReserved2; // 예약된 필드, 일반적으로 0으로 설정됩니다. (2 바이트)
+    unsigned int bfOffBits;     // 이미지 데이터의 시작 위치 (오프셋). 파일 헤더와 정보 헤더의 크기를 더한 값으로 설정됩니다. (4 바이트)
+} BITMAPFILEHEADER;
+
+// BMP 정보 헤더 구조체 (40 바이트)
+typedef struct
+{
+    unsigned int biSize;     // 정보 헤더의 크기. 일반적으로 40으로 설정됩니다. (4 바이트)
+    int biWidth;             // 이미지의 가로 너비 (픽셀 수). (4 바이트) buWidth랑 biHeight로 이미지 크기
+    int biHeight;            // 이미지의 세로 높이 (픽셀 수). 음수 값인 경우 이미지가 위에서 아래로 뒤집힌 이미지임을 나타냅니다. (4 바이트)
+    unsigned short biPlanes; // 이미지의 색상 평면 수. 항상 1로 설정됩니다. (2 바이트)
+    // biBitCount가 24면 트루컬러 8이면 8비트 그레이컬러
+    unsigned short biBitCount;   // 픽셀당 비트 수. 1, 4, 8, 16, 24 또는 32 중 하나의 값으로 설정됩니다. (2 바이트)
+    unsigned int biCompression;  // 압축 방법을 나타내는 값. 일반적으로 0 (비압축)으로 설정됩니다. (4 바이트)
+    unsigned int biSizeImage;    // 이미지 데이터의 크기 (바이트). 압축되지 않은 경우 이미지의 크기와 동일합니다. (4 바이트)
+    int biXPelsPerMeter;         // 수평 해상도 (픽셀당 미터 단위). (4 바이트)
+    int biYPelsPerMeter;         // 수직 해상도 (픽셀당 미터 단위). (4 바이트)
+    unsigned int biClrUsed;      // 사용된 색상 테이블(팔레트)의 색상 수. 0인 경우 모든 가능한 색상을 사용합니다. (4 바이트)
+    unsigned int biClrImportant; // 중요한 색상 테이블의 색상 수. 0인 경우 모든 색상이 중요하다는 것을 나타냅니다. (4 바이트)
+} BITMAPINFOHEADER;
+#pragma pack(pop) // 이전에 저장도니 패딩 설정으로 복원
+
+// RGBQUAD 구조체 정의 (필요한 경우)
+typedef struct
+{
+    unsigned char rgbBlue;
+    unsigned char rgbGreen;
+    unsigned char rgbRed;
+    unsigned char rgbReserved;
+} RGBQUAD;
+
+// 이진화 임계값 결정 방법
+#define THRESHOLD_GONZALEZ 0 // 곤잘레스 방법 (반복)
+#define THRESHOLD_OTSU 1     // 오츠 방법 (클래스 간 분산 최대)
+
+// Multi Otsu로 구할 수 있는 최대 임계값 개수
+#define MAX_OTSU_THRESHOLDS 4
+
+// 픽셀 형식
+#define PIXEL_GRAY8 0  // 8비트 그레이 (256 팔레트)
+#define PIXEL_GRAY16 1 // 16비트 그레이 (고비트 카메라)
+#define PIXEL_BGR24 2  // 24비트 컬러 (B, G, R 순서)
+#define PIXEL_BGRA32 3 // 32비트 컬러 (B, G, R, A 순서)
+
+// 컬러 채널 저장 방식
+#define LAYOUT_INTERLEAVED 0 // BGRBGR... 픽셀 단위로 저장 (BMP 파일과 같음)
+#define LAYOUT_PLANAR 1      // BBB... GGG... RRR... 채널 단위로 저장
+
+// RGB -> Gray 변환 계수 (BT.601 X 256)
+#define LUMA_R 77
+#define LUMA_G 150
+#define LUMA_B 29
+
+// 영상 구조체
+typedef struct
+{
+    int nWidth, nHeight; // 영상 크기 (픽셀)
+    int nFormat;         // 픽셀 형식 (PIXEL_xxx)
+    int nLayout;         // 저장 방식 (LAYOUT_xxx)
+    int nChannels;       // 채널 수
+    int nStride;         // 한 행의 바이트 수 (ROI는 원본 영상의 값을 그대로 가짐)
+    BYTE *pPlane[4];     // Planar : 채널별 평면의 시작 주소, Interleaved : pPlane[0]만 사용
+    BYTE *pBuffer;       // 할당된 버퍼 (해제용, 다른 영상의 버퍼를 참조하는 ROI는 NULL)
+} IMAGE;
+
+// 영상 버퍼 정렬 단위 (캐시 라인, AVX-512 레지스터 크기)
+#define IMAGE_ALIGN 64
+
+// 버퍼 풀 크기 등급 (2의 거듭제곱마다 4등급, 가장 작은 블록 64바이트)
+#define POOL_MIN_SHIFT 6
+#define POOL_CLASSES ((int)(sizeof(size_t) * 8 - POOL_MIN_SHIFT - 1) * 4)
+#define POOL_DEFAULT_MAX_CACHED ((size_t)512 << 20) // 풀이 보관할 최대 바이트 수 (512MB)
+
+// 아레나
+#define ARENA_MAX_CHUNKS 64
+#define ARENA_DEFAULT_CHUNK ((size_t)1 << 20) // 1MB
+
+// 스레드마다 따로 가지는 전역 변수
+#if defined(_MSC_VER)
+#define IMGPROC_THREAD_LOCAL __declspec(thread)
+#else
+#define IMGPROC_THREAD_LOCAL __thread
+#endif
+
+// 버퍼 풀 블록 헤더 (블록 앞의 IMAGE_ALIGN 바이트에 저장)
+typedef struct POOL_BLOCK
+{
+    struct POOL_BLOCK *pNext; // 같은 등급의 다음 반납 블록
+    int nClass;               // 크기 등급
+} POOL_BLOCK;
+
+// 크기 등급별 버퍼 풀 (스레드 하나에서만 사용)
+typedef struct
+{
+    POOL_BLOCK *pFree[POOL_CLASSES]; // 등급별 반납된 블록 목록
+    size_t nCached, nMaxCached;      // 보관중인 바이트 수, 최대 보관 바이트 수
+    long nHits, nMisses;             // 재사용 횟수, 새로 할당한 횟수
+    int bInit;
+} BUFFER_POOL;
+
+// 작업 단위 아레나 (풀에서 가져온 청크를 잘라서 사용하고 한번에 반납)
+typedef struct
+{
+    BUFFER_POOL *pPool;
+    BYTE *pChunk[ARENA_MAX_CHUNKS];
+    size_t nChunkBytes[ARENA_MAX_CHUNKS];
+    int nChunks;
+    size_t nUsed;      // 마지막 청크에서 사용한 바이트 수
+    size_t nChunkSize; // 기본 청크 크기
+} ARENA;
+
+// BMP 압축 방식 (biCompression)
+#define BMP_RGB 0       // 압축 없음
+#define BMP_RLE8 1      // 8비트 런 길이 압축
+#define BMP_BITFIELDS 3 // 비트 마스크 사용 (16, 32비트)
+
+// 저장 형식 (WriteImageFile)
+#define FILE_BMP 0      // 압축 없는 BMP (모든 픽셀 형식)
+#define FILE_BMP_RLE8 1 // RLE8 압축 BMP (8비트 그레이, 이진 영상, 레이블 영상)
+#define FILE_BMP_1BIT 2 // 1비트 BMP (0, 255만 있는 8비트 이진 영상)
+#define FILE_PNG 3      // PNG (8, 16비트 그레이, 24, 32비트 컬러)
+
+// 거리 변환 방법 (ImgDistanceTransform, ImgErosionRadius, ImgDilationRadius)
+#define DIST_EUCLIDEAN 0   // 정확한 유클리드 거리
+#define DIST_CITYBLOCK 1   // |dx| + |dy| (Erosion, Dilation을 반복한 것과 같은 마름모)
+#define DIST_CHESSBOARD 2  // max(|dx|, |dy|) (정사각형)
+#define DIST_CHAMFER_3_4 3 // 3-4 챔퍼 (유클리드 근사)
+
+// 허프 변환으로 찾은 원 (ImgHoughCircles)
+typedef struct
+{
+    double dX, dY;    // 중심 (픽셀, 입력 영상 기준)
+    double dRadius;   // 반지름 (픽셀)
+    int nVotes;       // 반지름 검증에서 원 둘레에 있었던 에지 픽셀 수
+    double dCoverage; // 둘레 중 에지가 있는 비율 (0 ~ 1)
+} HOUGH_CIRCLE;
+
+// 허프 변환으로 찾은 직선 (ImgHoughLines, x cos(theta) + y sin(theta) = rho)
+typedef struct
+{
+    double dRho;        // 영상 왼쪽 위에서 직선까지 거리 (픽셀, 음수 가능)
+    double dTheta;      // 직선의 법선 각도 (라디안, 0 ~ pi)
+    int nVotes;         // 선분 위의 에지 점 수
+    int x0, y0, x1, y1; // 에지 점이 nMaxGap 이하 간격으로 이어진 가장 긴 선분의 끝점
+} HOUGH_LINE;
+
+// 직선 허프 변환 방식 (ImgHoughLines)
+#define HOUGH_LINES_STANDARD 0    // 모든 에지 점이 투표한 뒤 누적 배열의 극대점
+#define HOUGH_LINES_PROGRESSIVE 1 // 임의 순서로 투표하면서 임계값을 넘는 직선을 바로 선분으로 떼어냄 (nMaxLines개 찾으면 끝)
+
+// 윤곽선 점 (픽셀 좌표, 입력 영상 기준)
+typedef struct
+{
+    int x, y;
+} CONTOUR_POINT;
+
+// 윤곽선 하나 (8연결 전경 픽셀을 따라 한 바퀴 도는 닫힌 경계)
+typedef struct
+{
+    int nFirst, nCount; // 점 (CONTOUR_SET의 pPoints[nFirst] ~ pPoints[nFirst + nCount - 1])
+    int bHole;          // 0 : 객체의 바깥 경계, 1 : 객체 안 구멍의 경계
+    int nParent;        // 바로 바깥의 윤곽선 번호 (구멍은 그 구멍을 가진 객체, 객체는 자기를 둘러싼 구멍, 없으면 -1)
+} CONTOUR;
+
+// 윤곽선 목록 (ContourInit으로 초기화, 여러 영상에 재사용 가능, ContourRelease로 해제)
+typedef struct
+{
+    CONTOUR *pContours;
+    int nContours, nMaxContours;
+    CONTOUR_POINT *pPoints;
+    int nPoints, nMaxPoints;
+} CONTOUR_SET;
+
+// 한 행의 전경 구간 x0 ~ x1 - 1
+typedef struct
+{
+    int x0, x1;
+} RLE_RUN;
+
+// 런 길이 부호화 이진 영상 (RleInit으로 초기화, 여러 영상에 재사용 가능, RleRelease로 해제)
+typedef struct
+{
+    int nWidth, nHeight;
+    int *pRowStart; // y 행의 런 = pRuns[pRowStart[y]] ~ pRuns[pRowStart[y + 1] - 1] (x 순서, 겹치거나 닿지 않음)
+    RLE_RUN *pRuns;
+    int nRuns, nMaxRuns;
+} RLE_IMAGE;
+
+// 복소수 (FFT 스펙트럼)
+typedef struct
+{
+    double re, im;
+} FFT_COMPLEX;
+
+#define FFT_MAX_STAGES 32
+
+// 1차원 복소수 FFT (길이 n = 2^a 3^b 5^c, 기수 4, 2, 3, 5 단계)
+typedef struct
+{
+    int n, nStages;
+    int Radix[FFT_MAX_STAGES];
+    FFT_COMPLEX *pTwiddle; // 단계마다 회전 인자
+} FFT_1D;
+
+// 2차원 실수 FFT 계획 (FftInit으로 만들고 FftRelease로 해제, 여러 스레드에서 같이 사용 가능)
+typedef struct
+{
+    int nWidth, nHeight; // 변환 크기 (2^a 3^b 5^c, nWidth는 짝수)
+    int nSpecWidth;      // 스펙트럼 한 행의 복소수 개수 (nWidth / 2 + 1)
+    FFT_1D Row, Col;     // Row : 길이 nWidth / 2 (실수 행을 복소수로 묶어서 변환), Col : 길이 nHeight
+    FFT_COMPLEX *pHalf;  // 실수 변환 회전 인자 exp(-2πik / nWidth) (k = 0 ~ nWidth / 2)
+} FFT_PLAN;
+
+// FFT 필터 (커널 / 전달 함수 스펙트럼을 한번 만들어서 같은 크기의 여러 영상에 적용)
+typedef struct
+{
+    int nWidth, nHeight;   // 처리할 영상 크기
+    int nOffsetX, nOffsetY; // 변환 버퍼 안 영상 위치 (바깥은 가장자리 픽셀로 채움)
+    int nPost;             // 결과 후처리 (CONV_POST_ABS면 절대값, 나머지는 클리핑)
+    FFT_PLAN Plan;
+    FFT_COMPLEX *pTransfer; // 전달 함수 (Plan.nHeight X Plan.nSpecWidth)
+} FFT_FILTER;
+
+// 위상 상관 정합 (PhaseCorrInit으로 기준 영상 스펙트럼을 만들어서 여러 프레임에 재사용, 여러 스레드에서 같이 사용 가능)
+typedef struct
+{
+    int nWidth, nHeight;             // 기준 영상 크기
+    int bRotationScale;              // 1이면 회전, 배율도 구함
+    FFT_PLAN Plan;                   // 변환 크기 = FftGoodSize(영상 크기), 나머지는 0
+    double *pRef, dRefMean;          // 기준 영상과 평균 (이동량이 크면 겹치는 영역으로 스펙트럼을 다시 만듦)
+    FFT_COMPLEX *pRefSpec;           // 기준 영상 스펙트럼 (Plan.nHeight X Plan.nSpecWidth)
+    FFT_PLAN PolarPlan;              // 로그 극좌표 크기 스펙트럼 변환 (행 = 각도 0 ~ π, 열 = log 반지름)
+    double dLogBase;                 // 로그 극좌표 열 하나의 log 반지름 간격
+    FFT_COMPLEX *pRefPolarSpec;      // 기준 영상 로그 극좌표 스펙트럼
+} PHASE_CORR;
+
+// 위상 상관 정합 결과 (프레임(c + dScale R(dAngle) (x - c) + (dx, dy)) = 기준(x), c = 영상 가운데)
+typedef struct
+{
+    double dx, dy;    // 평행 이동 (버퍼 좌표, 부화소)
+    double dAngle;    // 회전 (도, Rotation과 같은 방향)
+    double dScale;    // 배율
+    double dResponse; // 상관 최대값 (1에 가까울수록 확실)
+} PHASE_CORR_RESULT;
+
+// 컨볼루션 결과 후처리 방법
+#define CONV_POST_NONE 0 // 그대로 저장 (평균, 가우시안)
+#define CONV_POST_ABS 1  // 절대값 / nDivisor (라플라시안, 프리윗, 소벨)
+#define CONV_POST_CLIP 2 // 0 ~ 최대값으로 클리핑 (고역통과 필터)
+
+// ConvolutionEx에서 사용하는 커널 번호
+#define KERNEL_AVERAGE 0
+#define KERNEL_GAUSSIAN 1
+#define KERNEL_LAPLACIAN 2
+#define KERNEL_PREWITT_X 3
+#define KERNEL_PREWITT_Y 4
+#define KERNEL_SOBEL_X 5
+#define KERNEL_SOBEL_Y 6
+#define KERNEL_HPF_LAPLACIAN 7
+
+// 큰 커널 컨볼루션 방법 (ImgConvolutionLarge)
+#define CONV_METHOD_AUTO 0   // 예상 비용이 작은 쪽
+#define CONV_METHOD_DIRECT 1 // 직접 곱셈 누적
+#define CONV_METHOD_FFT 2    // FFT
+
+// 주파수 영역 필터 종류 (FftFilterFrequency, ImgFrequencyFilter)
+#define FREQ_IDEAL_LOWPASS 0
+#define FREQ_IDEAL_HIGHPASS 1
+#define FREQ_BUTTERWORTH_LOWPASS 2
+#define FREQ_BUTTERWORTH_HIGHPASS 3
+
+// ImgGaussianBlur 방법
+#define BLUR_RECURSIVE 0 // Young-van Vliet 재귀 가우시안 (앞, 뒤 방향 3차 점화식)
+#define BLUR_BOX 1       // 누적 합 상자 흐림 3번 (더 빠르고 조금 덜 정확)
+
+// 8비트 단일 채널 함수 (기존 함수, InverseImage, XXXConvolution 등)
+typedef void (*IMAGE_FUNC)(BYTE *Input, BYTE *Output, int nWidth, int nHeight);
+
+// KERNEL_xxx 번호별 커널, 후처리 방법, 8비트 함수
+typedef struct
+{
+    const double (*Kernel)[3];
+    int nPost, nDivisor;
+    IMAGE_FUNC Gray8;
+} CONVOLUTION_INFO;
+
+// KERNEL_xxx 순서의 컨볼루션 정보
+extern CONVOLUTION_INFO ConvolutionTable[];
+
+// 영상 메모리 (정렬 할당, 버퍼 풀, 아레나, IMAGE 생성/해제/ROI)
+int GetBytesPerPixel(int nFormat);
+void *AlignedMalloc(size_t nSize);
+void AlignedFree(void *p);
+void PoolInit(BUFFER_POOL *pPool, size_t nMaxCached);
+void *PoolAlloc(BUFFER_POOL *pPool, size_t nSize, int bZero);
+void PoolFree(BUFFER_POOL *pPool, void *p);
+void PoolRelease(BUFFER_POOL *pPool);
+BUFFER_POOL *GetThreadPool(void);
+BUFFER_POOL *SetThreadPool(BUFFER_POOL *pPool);
+void ArenaInit(ARENA *pArena, BUFFER_POOL *pPool, size_t nChunkSize);
+void *ArenaAlloc(ARENA *pArena, size_t nSize, int bZero);
+void ArenaReset(ARENA *pArena);
+int CreateImage(IMAGE *pImage, int nWidth, int nHeight, int nFormat, int nLayout);
+void FreeImage(IMAGE *pImage);
+void WrapImage(IMAGE *pImage, void *pData, int nWidth, int nHeight, int nFormat, int nStride);
+int CreateROI(const IMAGE *pSrc, IMAGE *pRoi, int x, int y, int nWidth, int nHeight);
+void GetPlaneView(const IMAGE *pSrc, int c, IMAGE *pView);
+int CopyImage(const IMAGE *pSrc, IMAGE *pDst);
+
+// 8비트 그레이 기존 함수 (행 패딩이 없는 연속 버퍼)
+void InverseImage(BYTE *Input, BYTE *Output, int nWidth, int nHeight);
+void AdjustBrightness(BYTE *Input, BYTE *Output, int nWidth, int nHeight, int nBrightness);
+void AdjustContrast(BYTE *Input, BYTE *Output, int nWidth, int nHeight, double dContrast);
+void GenerateHistogram(BYTE *Input, int *Histogram, int nWidth, int nHeight);
+void GenerateBinarization(BYTE *Input, BYTE *Output, int nWidth, int nHeight, BYTE bThreshold);
+BYTE GonzalezMethod(int *Histogram);
+BYTE OtsuMethod(int *Histogram);
+int MultiOtsuMethod(int *Histogram, BYTE *Thresholds, int nThresholds);
+BYTE SelectThreshold(int *Histogram, int nMethod);
+BYTE GenerateAutoBinarization(BYTE *Input, BYTE *Output, int nWidth, int nHeight, int nMethod);
+void GenerateMultiLevelBinarization(BYTE *Input, BYTE *Output, int nWidth, int nHeight, BYTE *Thresholds, int nThresholds);
+void HistogramStretching(BYTE *Input, BYTE *Output, int *Histogram, int nWidth, int nHeight);
+void HistogramEqualization(BYTE *Input, BYTE *Output, int *Histogram, int nWidth, int nHeight);
+int ImgCLAHE(const IMAGE *pIn, IMAGE *pOut, int nTilesX, int nTilesY, double dClipLimit);
+int CLAHE(BYTE *Input, BYTE *Output, int nWidth, int nHeight, int nTilesX, int nTilesY, double dClipLimit);
+void AverageConvolution(BYTE *Input, BYTE *Output, int nWidth, int nHeight);
+void GaussianConvolution(BYTE *Input, BYTE *Output, int nWidth, int nHeight);
+void LaplacianConvolution(BYTE *Input, BYTE *Output, int nWidth, int nHeight);
+void X_PrewittConvolution(BYTE *Input, BYTE *Output, int nWidth, int nHeight);
+void Y_PrewittConvolution(BYTE *Input, BYTE *Output, int nWidth, int nHeight);
+void X_SobelConvolution(BYTE *Input, BYTE *Output, int nWidth, int nHeight);
+void Y_SobelConvolution(BYTE *Input, BYTE *Output, int nWidth, int nHeight);
+void HPF_LaplacianConvolution(BYTE *Input, BYTE *Output, int nWidth, int nHeight);
+void MedianFilter(BYTE *Input, BYTE *Output, int nWidth, int nHeight);
+void MedianFiltering(BYTE *Input, BYTE *Output, int nWidth, int nHeight, int nSize);
+void ComponentLabeling(BYTE *CutImage, int nHeight, int nWidth, int nLabel);
+void DetectObjectEdge(BYTE *Input, BYTE *Output, int nWidth, int nHeight);
+void VerticalFlip(BYTE *Input, int nWidth, int nHeight);
+void HorizontalFlip(BYTE *Input, int nWidth, int nHeight);
+void Translation(BYTE *Input, BYTE *Output, int nWidth, int nHeight, int Tx, int Ty);
+void Scaling(BYTE *Input, BYTE *Output, int nWidth, int nHeight, double Sx, double Sy);
+void Rotation(BYTE *Input, BYTE *Output, int nWidth, int nHeight, int Angle);
+void Erosion(BYTE *Input, BYTE *Output, int nWidth, int nHeight);
+void Dilation(BYTE *Input, BYTE *Output, int nWidth, int nHeight);
+
+// IMAGE 입력 함수 (모든 픽셀 형식, Planar, ROI, 실패하면 -1)
+int ImgInverse(const IMAGE *pIn, IMAGE *pOut);
+int ImgAdjustBrightness(const IMAGE *pIn, IMAGE *pOut, int nBrightness);
+int ImgAdjustContrast(const IMAGE *pIn, IMAGE *pOut, double dContrast);
+int ImgBinarization(const IMAGE *pIn, IMAGE *pOut, unsigned int nThreshold);
+int ImgCombineMax(const IMAGE *pIn, IMAGE *pOut);
+int ImgHistogram(const IMAGE *pIn, int *Histogram);
+int ImgHistogramStretching(const IMAGE *pIn, IMAGE *pOut);
+int ImgHistogramEqualization(const IMAGE *pIn, IMAGE *pOut);
+int ImgConvolution(const IMAGE *pIn, IMAGE *pOut, int nKernel);
+int ImgConvolutionKernel(const IMAGE *pIn, IMAGE *pOut, const double Kernel[3][3], int nPost, int nDivisor);
+int ImgMedianFiltering(const IMAGE *pIn, IMAGE *pOut, int nSize);
+void ImgVerticalFlip(IMAGE *pImg);
+void ImgHorizontalFlip(IMAGE *pImg);
+int ImgTranslation(const IMAGE *pIn, IMAGE *pOut, int Tx, int Ty);
+int ImgScaling(const IMAGE *pIn, IMAGE *pOut, double Sx, double Sy);
+int ImgRotation(const IMAGE *pIn, IMAGE *pOut, int Angle);
+int ImgErosion(const IMAGE *pIn, IMAGE *pOut);
+int ImgDilation(const IMAGE *pIn, IMAGE *pOut);
+int ImgDetectObjectEdge(const IMAGE *pIn, IMAGE *pOut);
+int ImgComponentLabeling(IMAGE *pImg, int nLabel);
+
+// 거리 변환, 반지름 단위 형태학 연산 (distance.c, 8비트 이진 영상, 전경 255)
+int ImgDistanceTransform(const IMAGE *pIn, float *pDist, int nMetric);
+int ImgErosionRadius(const IMAGE *pIn, IMAGE *pOut, double dRadius, int nMetric);
+int ImgDilationRadius(const IMAGE *pIn, IMAGE *pOut, double dRadius, int nMetric);
+
+// 허프 변환 (hough.c, 8비트 그레이 또는 이진 영상)
+int ImgHoughCircles(const IMAGE *pIn, int nMinRadius, int nMaxRadius, int nEdgeThreshold, double dMinCoverage, HOUGH_CIRCLE *pCircles, int nMaxCircles);
+int ImgHoughLines(const IMAGE *pIn, int nEdgeThreshold, int nMinVotes, int nMinLength, int nMaxGap, int nMode, HOUGH_LINE *pLines, int nMaxLines);
+
+// 워터셰드 영역 분할 (watershed.c, 레이블은 nWidth X nHeight int 연속 버퍼)
+int ImgWatershed(const IMAGE *pRelief, int *pLabels);
+int ImgSplitObjects(const IMAGE *pIn, int *pLabels, double dMinDepth);
+
+// 윤곽선 추적 (contour.c, 8비트 이진 영상, 전경 255)
+void ContourInit(CONTOUR_SET *pSet);
+void ContourRelease(CONTOUR_SET *pSet);
+int ImgFindContours(const IMAGE *pIn, CONTOUR_SET *pSet);
+int SimplifyContours(CONTOUR_SET *pSet, double dEpsilon);
+
+// 영역 채우기 (fill.c, 구간 단위)
+int ImgFloodFill(IMAGE *pImg, int x, int y, BYTE nValue, int nTolerance, int nConnectivity);
+int ImgFillHoles(const IMAGE *pIn, IMAGE *pOut);
+
+// 런 길이 부호화 이진 영상 (rle.c, 전경 255)
+void RleInit(RLE_IMAGE *pRle);
+void RleRelease(RLE_IMAGE *pRle);
+int RleEncode(const IMAGE *pIn, RLE_IMAGE *pRle);
+int RleDecode(const RLE_IMAGE *pRle, IMAGE *pOut);
+long long RleArea(const RLE_IMAGE *pRle);
+int RleLabel(const RLE_IMAGE *pRle, int nConnectivity, int *pRunLabels, long long *pAreas);
+int RleErosion(const RLE_IMAGE *pIn, RLE_IMAGE *pOut, int nRadiusX, int nRadiusY);
+int RleDilation(const RLE_IMAGE *pIn, RLE_IMAGE *pOut, int nRadiusX, int nRadiusY);
+
+// FFT, 큰 커널 컨볼루션, 주파수 영역 필터 (fft.c, 8, 16비트 그레이)
+int FftGoodSize(int n);
+int FftInit(FFT_PLAN *pPlan, int nWidth, int nHeight);
+void FftRelease(FFT_PLAN *pPlan);
+int FftForward2D(const FFT_PLAN *pPlan, const double *pIn, FFT_COMPLEX *pSpec);
+int FftInverse2D(const FFT_PLAN *pPlan, FFT_COMPLEX *pSpec, double *pOut);
+int FftFilterKernel(FFT_FILTER *pFilter, int nWidth, int nHeight, const double *pKernel, int nKernelWidth, int nKernelHeight, int nPost);
+int FftFilterFrequency(FFT_FILTER *pFilter, int nWidth, int nHeight, int nType, double dCutoff, int nOrder);
+void FftFilterRelease(FFT_FILTER *pFilter);
+int FftFilterApply(const FFT_FILTER *pFilter, const IMAGE *pIn, IMAGE *pOut);
+int ImgConvolutionLarge(const IMAGE *pIn, IMAGE *pOut, const double *pKernel, int nKernelWidth, int nKernelHeight, int nPost, int nMethod);
+int ImgFrequencyFilter(const IMAGE *pIn, IMAGE *pOut, int nType, double dCutoff, int nOrder);
+
+// 위상 상관 영상 정합 (registration.c, 8, 16비트 그레이)
+int PhaseCorrInit(PHASE_CORR *pCorr, const IMAGE *pRef, int bRotationScale);
+void PhaseCorrRelease(PHASE_CORR *pCorr);
+int PhaseCorrMatch(const PHASE_CORR *pCorr, const IMAGE *pFrame, PHASE_CORR_RESULT *pResult);
+int ImgPhaseCorrelate(const IMAGE *pRef, const IMAGE *pFrame, double *pDx, double *pDy);
+
+// 가우시안 흐림 (blur.c, 8, 16비트 그레이, σ와 상관없이 화소당 계산량 일정)
+int ImgGaussianBlur(const IMAGE *pIn, IMAGE *pOut, double dSigma, int nMethod);
+
+// 픽셀 형식 번호를 받는 함수 (연속 버퍼, 8비트 그레이는 기존 함수 호출)
+void InverseImageEx(void *Input, void *Output, int nWidth, int nHeight, int nFormat);
+void AdjustBrightnessEx(void *Input, void *Output, int nWidth, int nHeight, int nFormat, int nBrightness);
+void AdjustContrastEx(void *Input, void *Output, int nWidth, int nHeight, int nFormat, double dContrast);
+void GenerateBinarizationEx(void *Input, void *Output, int nWidth, int nHeight, int nFormat, unsigned int nThreshold);
+void CombineMaxEx(void *Input, void *Output, int nWidth, int nHeight, int nFormat);
+int HistogramStretchingEx(void *Input, void *Output, int nWidth, int nHeight, int nFormat);
+int HistogramEqualizationEx(void *Input, void *Output, int nWidth, int nHeight, int nFormat);
+void ConvolutionEx(void *Input, void *Output, int nWidth, int nHeight, int nFormat, int nKernel);
+int MedianFilteringEx(void *Input, void *Output, int nWidth, int nHeight, int nFormat, int nSize);
+void VerticalFlipEx(void *Input, int nWidth, int nHeight, int nFormat);
+void HorizontalFlipEx(void *Input, int nWidth, int nHeight, int nFormat);
+void TranslationEx(void *Input, void *Output, int nWidth, int nHeight, int nFormat, int Tx, int Ty);
+void ScalingEx(void *Input, void *Output, int nWidth, int nHeight, int nFormat, double Sx, double Sy);
+void RotationEx(void *Input, void *Output, int nWidth, int nHeight, int nFormat, int Angle);
+
+// 채널 분리/합치기, 저장 방식/형식 변환
+void DeinterleaveBGR24(const BYTE *pSrc, BYTE *pB, BYTE *pG, BYTE *pR, int nCount);
+void InterleaveBGR24(const BYTE *pB, const BYTE *pG, const BYTE *pR, BYTE *pDst, int nCount);
+void DeinterleaveBGRA32(const BYTE *pSrc, BYTE *pB, BYTE *pG, BYTE *pR, BYTE *pA, int nCount);
+void InterleaveBGRA32(const BYTE *pB, const BYTE *pG, const BYTE *pR, const BYTE *pA, BYTE *pDst, int nCount);
+void RGBToGrayPlanar(const BYTE *pB, const BYTE *pG, const BYTE *pR, BYTE *pGray, int nCount);
+void RGBToGrayInterleaved(const BYTE *pSrc, int nChannels, BYTE *pGray, int nCount);
+int ConvertLayout(const IMAGE *pSrc, IMAGE *pDst);
+int ConvertToGray(const IMAGE *pSrc, IMAGE *pGray);
+int ApplyPlanes(const IMAGE *pSrc, IMAGE *pDst, IMAGE_FUNC Func, int bAlpha);
+
+// BMP 파일 입출력 (bmpio.c)
+int ImgOpenFile(FILE **pFp, const char *szPath, const char *szMode);
+BYTE *ReadBitmap(FILE *fp, BITMAPFILEHEADER *pHf, BITMAPINFOHEADER *pInfo, RGBQUAD *pRGB, int *pFormat);
+int WriteBitmap(FILE *fp, BITMAPFILEHEADER *pHf, BITMAPINFOHEADER *pInfo, RGBQUAD *pRGB, BYTE *Image, int nFormat);
+int WriteBitmapRLE8(FILE *fp, BITMAPFILEHEADER *pHf, BITMAPINFOHEADER *pInfo, RGBQUAD *pRGB, BYTE *Image);
+int WriteBitmap1(FILE *fp, BITMAPFILEHEADER *pHf, BITMAPINFOHEADER *pInfo, BYTE *Image);
+int WriteImageFile(FILE *fp, BITMAPFILEHEADER *pHf, BITMAPINFOHEADER *pInfo, RGBQUAD *pRGB, BYTE *Image, int nFormat, int nFileFormat);
+
+// PNG 저장 (pngio.c, 외부 라이브러리 없이 deflate 직접 구현)
+int WritePng(FILE *fp, const BYTE *Image, int nWidth, int nHeight, int nFormat);
+
+// 처리 컨텍스트 (context.c)
+// CPU 기능 (GetCpuFeatures, IMGPROC_CONTEXT::nCpuFeatures)
+#define CPU_SSE2 0x01
+#define CPU_SSSE3 0x02
+#define CPU_AVX2 0x04
+
+// RunOperation 기능 번호
+#define OP_COPY 0
+#define OP_INVERSE 1
+#define OP_BRIGHTNESS 2          // nBrightness
+#define OP_CONTRAST 3            // dContrast
+#define OP_BINARIZATION 4        // nThreshold
+#define OP_AUTO_BINARIZATION 5   // nMethod (THRESHOLD_xxx), 구한 임계값을 nThreshold에 저장
+#define OP_STRETCHING 6
+#define OP_EQUALIZATION 7
+#define OP_CONVOLUTION 8         // nKernel (KERNEL_xxx)
+#define OP_MEDIAN 9              // nSize (홀수)
+#define OP_VERTICAL_FLIP 10
+#define OP_HORIZONTAL_FLIP 11
+#define OP_TRANSLATION 12        // Tx, Ty
+#define OP_SCALING 13            // Sx, Sy
+#define OP_ROTATION 14           // Angle
+#define OP_EROSION 15
+#define OP_DILATION 16
+#define OP_EDGE 17
+#define OP_LABELING 18           // nLabel (1 ~ 3)
+#define OP_CLAHE 19              // nTilesX, nTilesY, dClipLimit (0이면 8, 8, 2.0)
+#define OP_COMBINE_MAX 20
+#define OP_TO_GRAY 21            // 컬러 -> 8비트 그레이 (pOut은 PIXEL_GRAY8)
+#define OP_EROSION_RADIUS 22     // dRadius, nMetric (DIST_xxx)
+#define OP_DILATION_RADIUS 23    // dRadius, nMetric (DIST_xxx)
+#define OP_FILL_HOLES 24
+#define OP_FREQUENCY_FILTER 25   // nMethod (FREQ_xxx), dRadius (차단 주파수, 픽셀당 주기), nSize (버터워스 차수, 0이면 2)
+#define OP_GAUSSIAN_BLUR 26      // dRadius (표준 편차), nMethod (BLUR_xxx)
+#define OP_COUNT 27
+
+// RunOperation 인자 (기능마다 필요한 값만 사용, 나머지는 0)
+typedef struct
+{
+    int nBrightness, nThreshold, nMethod, nKernel, nSize, nLabel;
+    int Tx, Ty, Angle;
+    int nTilesX, nTilesY, nMetric;
+    double dContrast, Sx, Sy, dClipLimit, dRadius;
+} OP_PARAM;
+
+// 처리 컨텍스트 (한번 만들어서 여러 영상에 재사용, 한번에 한 스레드에서만 사용)
+typedef struct
+{
+    BUFFER_POOL Pool;      // 중간 버퍼 풀 (RunOperation 동안 GetThreadPool이 이 풀을 반환)
+    int nThreads;          // OpenMP 스레드 수 (0이면 OpenMP 기본값)
+    int nCpuFeatures;      // 실행 중인 CPU의 기능 (CPU_xxx)
+    int nBuildFeatures;    // 빌드할 때 사용한 기능 (CPU_xxx)
+    long long nCalls;      // RunOperation 호출 수
+} IMGPROC_CONTEXT;
+
+int GetCpuFeatures(void);
+int ContextInit(IMGPROC_CONTEXT *pCtx, int nThreads, size_t nMaxCached);
+void ContextRelease(IMGPROC_CONTEXT *pCtx);
+const char *GetOperationName(int nOp);
+int RunOperation(IMGPROC_CONTEXT *pCtx, int nOp, const IMAGE *pIn, IMAGE *pOut, OP_PARAM *pParam);
+
+// 지연 실행 파이프라인 (pipeline.c)
+#define PIPELINE_MAX_OPS 32
+#define PIPELINE_L2_BYTES ((size_t)256 << 10) // 타일 행 버퍼 전체의 목표 크기 (L2 캐시)
+
+// 기록한 기능 하나
+typedef struct
+{
+    int nOp;        // OP_xxx
+    OP_PARAM Param; // OP_AUTO_BINARIZATION은 실행 후 구한 임계값이 nThreshold에 저장됨
+} PIPELINE_OP;
+
+// 실행 구간 (합친 구간은 한번에 타일 단위로, 아니면 RunOperation 한번)
+typedef struct
+{
+    int bFused;         // 1 : 점 연산 + 이웃 연산을 합친 구간 (8비트 그레이)
+    int nFirst, nCount; // 구간의 기능 (Op[nFirst] ~ Op[nFirst + nCount - 1])
+    int nStages;        // 구간 안의 이웃 연산 수 (0이면 LUT 한번)
+    int nPreLUT;        // 첫 이웃 연산 앞의 점 연산 LUT 번호 (-1이면 없음)
+} PIPELINE_SEGMENT;
+
+typedef struct
+{
+    PIPELINE_OP Op[PIPELINE_MAX_OPS];
+    int nOps;
+    int nTileRows; // 타일 행 수 (0이면 PIPELINE_L2_BYTES에 맞춰 자동)
+
+    // PipelineCompile 결과
+    int bCompiled, nFormat; // 컴파일할 때의 입력 형식
+    PIPELINE_SEGMENT Segment[PIPELINE_MAX_OPS];
+    int nSegments;
+    int nPostLUT[PIPELINE_MAX_OPS]; // 이웃 연산 Op[i] 뒤의 점 연산 LUT 번호 (-1이면 없음)
+    BYTE LUT[PIPELINE_MAX_OPS][256];
+    int nLUTs;
+} PIPELINE;
+
+void PipelineInit(PIPELINE *pPipe);
+int PipelineAdd(PIPELINE *pPipe, int nOp, const OP_PARAM *pParam);
+int PipelineCompile(PIPELINE *pPipe, int nFormat);
+int PipelineRun(IMGPROC_CONTEXT *pCtx, PIPELINE *pPipe, const IMAGE *pIn, IMAGE *pOut);
+
+// 일괄 처리 (batch.c)
+#define BATCH_MAX_SLOTS 16    // 동시에 메모리에 올릴 수 있는 최대 파일 수
+#define BATCH_DEFAULT_SLOTS 4 // 읽기, 처리, 쓰기 각 1개 + 여유 1개
+
+// BatchProcess 결과
+typedef struct
+{
+    int nFiles, nFailed;
+    double dTotalSec;                        // 전체 시간
+    double dReadSec, dProcessSec, dWriteSec; // 단계별로 일한 시간 (겹쳐서 진행되므로 합이 전체보다 큼)
+} BATCH_STATS;
+
+int BatchProcess(IMGPROC_CONTEXT *pCtx, PIPELINE *pPipe, const char *const *szInputs, const char *const *szOutputs, int nFiles,
+                 int nSlots, int nFileFormat, BATCH_STATS *pStats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IMGPROCESSING_H
@@ -0,0 +1,492 @@
+/*
+ * @Name : pipeline.c
+ * @Description : Image Processing in C - 지연 실행 파이프라인 (기능을 기록했다가 합쳐서 타일 단위로 실행)
+ * @Date : 2026. 10. 19
+ * @Revision : 1.0
+ * 1.0 : PipelineInit, PipelineAdd, PipelineCompile, PipelineRun
+ *       점 연산(반전, 밝기, 대비, 이진화)은 LUT 하나로 합쳐서 앞의 이웃 연산 결과에 바로 적용,
+ *       이웃 연산(컨볼루션, 미디언, 침식, 팽창)은 행 버퍼로 이어서 영상 전체를 한번만 읽고 쓰도록 실행
+ *
+ * 예) Gaussian -> Sobel X -> 이진화 -> 팽창 은 RunOperation 4번이면 영상 전체를 4번 읽고 쓰지만
+ *     파이프라인은 L2 캐시에 들어가는 몇십 행짜리 버퍼 사이에서만 데이터가 오가고 입력, 출력은 한번씩만 접근한다.
+ * 결과는 같은 기능을 RunOperation으로 차례로 실행한 것과 비트 단위로 같다. (golden_test에서 비교)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "imgprocessing.h"
+#include "profile.h"
+
+// 합친 구간의 이웃 연산 하나 (행 버퍼)
+typedef struct
+{
+    const PIPELINE_OP *pOp;
+    int nRadius;       // 가장자리 폭 (결과 y행은 입력 y - nRadius ~ y + nRadius행으로 계산)
+    const BYTE *pLUT;  // 이 연산 결과에 적용할 점 연산 LUT (NULL이면 없음)
+    BYTE *pWin, *pOut; // 입력 행 버퍼, 결과 행 버퍼 (각각 nCap행)
+    int nCap;          // 버퍼 행 수 (타일 행 수 + 2 X nRadius)
+    int nFirst, nRows; // 입력 행 버퍼에 들어있는 첫 행 번호(영상 기준)와 행 수
+    int nNext;         // 다음에 만들 결과 행 번호
+} FUSED_STAGE;
+
+// 합친 구간 하나를 실행하는 동안의 상태
+typedef struct
+{
+    FUSED_STAGE Stage[PIPELINE_MAX_OPS];
+    int nStages;
+    int nWidth, nHeight;
+    const BYTE *pZero; // 0으로 채운 행 (이웃 연산이 쓰지 않는 가장자리 행)
+    IMAGE *pDst;       // 구간의 결과 영상
+    int nDstRow;       // 다음에 쓸 결과 영상 행
+} FUSED_RUN;
+
+/*
+ * @Function Name : IsPointOp
+ * @Description : 픽셀 하나만 보고 결과가 정해지는 기능(8비트에서 LUT로 바꿀 수 있는 기능)인지 검사합니다.
+ * @Input : nOp
+ * @Output : 1 (점 연산) / 0 (아님)
+ */
+static int IsPointOp(int nOp)
+{
+    return nOp == OP_COPY || nOp == OP_INVERSE || nOp == OP_BRIGHTNESS || nOp == OP_CONTRAST || nOp == OP_BINARIZATION;
+}
+
+/*
+ * @Function Name : GetNeighbourRadius
+ * @Description : 이웃 연산의 가장자리 폭을 반환합니다.
+ * @Input : *pOp
+ * @Output : 가장자리 폭 (이웃 연산이 아니면 0, 잘못된 인자면 -1)
+ */
+// 김광제의 설명 - 여기서 다루는 이웃 연산은 모두 가장자리 nRadius 픽셀을 쓰지 않고, 결과 y행이 입력 y ± nRadius행에만 의존한다.
+// 그래서 입력을 몇 행씩 잘라서 ROI로 넘겨도 안쪽 행의 결과는 영상 전체로 실행한 것과 같다.
+static int GetNeighbourRadius(const PIPELINE_OP *pOp)
+{
+    switch (pOp->nOp)
+    {
+    case OP_CONVOLUTION:
+        return (pOp->Param.nKernel < 0 || pOp->Param.nKernel > KERNEL_HPF_LAPLACIAN) ? (-1) : 1;
+    case OP_MEDIAN:
+        return (pOp->Param.nSize < 1 || pOp->Param.nSize % 2 == 0) ? (-1) : pOp->Param.nSize / 2;
+    case OP_EROSION:
+    case OP_DILATION:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+/*
+ * @Function Name : BuildPointLUT
+ * @Description : 점 연산을 8비트 LUT로 만들어서 기존 LUT 뒤에 합칩니다. (LUT[v] = 점 연산(LUT[v]))
+ * @Input : *pOp, LUT
+ * @Output : LUT
+ */
+// 김광제의 설명 - 값 계산식은 pixel_kernels.h의 8비트 LUT와 같아야 비트 단위로 같은 결과가 나온다.
+static void BuildPointLUT(const PIPELINE_OP *pOp, BYTE *LUT)
+{
+    for (int i = 0; i < 256; i++)
+    {
+        int v = LUT[i];
+
+        switch (pOp->nOp)
+        {
+        case OP_INVERSE:
+            v = 255 - v;
+            break;
+        case OP_BRIGHTNESS:
+            v = (v + pOp->Param.nBrightness > 255) ? 255 : ((v + pOp->Param.nBrightness < 0) ? 0 : v + pOp->Param.nBrightness);
+            break;
+        case OP_CONTRAST:
+            v = (v * pOp->Param.dContrast > 255) ? 255 : (BYTE)(v * pOp->Param.dContrast);
+            break;
+        case OP_BINARIZATION:
+            v = ((unsigned int)v < (unsigned int)pOp->Param.nThreshold) ? 0 : 255;
+            break;
+        }
+        LUT[i] = (BYTE)v;
+    }
+}
+
+/*
+ * @Function Name : PipelineInit
+ * @Description : 빈 파이프라인을 만듭니다.
+ * @Output : *pPipe
+ */
+void PipelineInit(PIPELINE *pPipe)
+{
+    memset(pPipe, 0, sizeof(PIPELINE));
+}
+
+/*
+ * @Function Name : PipelineAdd
+ * @Description : 파이프라인 끝에 기능을 기록합니다. (실행은 PipelineRun에서)
+ * @Input : *pPipe, nOp - OP_xxx, *pParam - 기능별 인자 (NULL이면 모두 0, 복사해서 보관)
+ * @Output : 반환값 0 (성공) / -1 (잘못된 기능 번호, 파이프라인이 가득 참)
+ */
+// OP_COMBINE_MAX는 출력 영상도 입력으로 사용하는 기능이라 파이프라인에 넣을 수 없음
+int PipelineAdd(PIPELINE *pPipe, int nOp, const OP_PARAM *pParam)
+{
+    PIPELINE_OP *pOp;
+
+    if (nOp < 0 || nOp >= OP_COUNT || nOp == OP_COMBINE_MAX || pPipe->nOps >= PIPELINE_MAX_OPS)
+        return (-1);
+
+    pOp = &pPipe->Op[pPipe->nOps++];
+    pOp->nOp = nOp;
+    if (pParam != NULL)
+        pOp->Param = *pParam;
+    else
+        memset(&pOp->Param, 0, sizeof(OP_PARAM));
+
+    pPipe->bCompiled = 0;
+    return 0;
+}
+
+/*
+ * @Function Name : PipelineCompile
+ * @Description : 기록한 기능을 합칠 수 있는 구간으로 나누고 점 연산 LUT를 만듭니다.
+ * @Input : *pPipe, nFormat - 입력 영상의 픽셀 형식
+ * @Output : *pPipe (Segment, LUT), 반환값 0 (성공) / -1 (잘못된 인자)
+ */
+// 김광제의 설명 - 8비트 그레이 구간에서 점 연산과 이웃 연산이 이어지는 부분을 하나의 구간으로 묶는다.
+//   [점 연산...] [이웃 연산 [점 연산...]]...
+// 첫 이웃 연산 앞의 점 연산은 입력을 읽을 때, 이웃 연산 뒤의 점 연산은 그 결과 행을 다음 버퍼로 넘길 때 LUT로 적용
+// 히스토그램 기능, 기하 변환, 레이블링 등 영상 전체가 필요한 기능과 8비트가 아닌 영상은 RunOperation으로 하나씩 실행
+int PipelineCompile(PIPELINE *pPipe, int nFormat)
+{
+    int nCur = nFormat;
+    int i = 0;
+
+    pPipe->nSegments = 0;
+    pPipe->nLUTs = 0;
+    for (int k = 0; k < pPipe->nOps; k++)
+        pPipe->nPostLUT[k] = -1;
+
+    while (i < pPipe->nOps)
+    {
+        PIPELINE_SEGMENT *pSeg = &pPipe->Segment[pPipe->nSegments++];
+        int *pLUTSlot = &pSeg->nPreLUT;
+        const PIPELINE_OP *pOp = &pPipe->Op[i];
+
+        pSeg->nFirst = i;
+        pSeg->nPreLUT = -1;
+        pSeg->nStages = 0;
+
+        if (GetNeighbourRadius(pOp) < 0)
+            return (-1);
+
+        // 합칠 수 없는 기능은 단독 구간
+        if (nCur != PIXEL_GRAY8 || (!IsPointOp(pOp->nOp) && GetNeighbourRadius(pOp) == 0))
+        {
+            pSeg->bFused = 0;
+            pSeg->nCount = 1;
+            if (pOp->nOp == OP_TO_GRAY)
+                nCur = PIXEL_GRAY8;
+            i++;
+            continue;
+        }
+
+        pSeg->bFused = 1;
+        for (; i < pPipe->nOps; i++)
+        {
+            int nRadius;
+
+            pOp = &pPipe->Op[i];
+            nRadius = GetNeighbourRadius(pOp);
+            if (nRadius < 0)
+                return (-1);
+
+            if (IsPointOp(pOp->nOp))
+            {
+                if (pOp->nOp == OP_COPY)
+                    continue;
+                // 현재 위치(첫 이웃 연산 앞 또는 마지막 이웃 연산 뒤)의 LUT에 합침
+                if (*pLUTSlot < 0)
+                {
+                    *pLUTSlot = pPipe->nLUTs++;
+                    for (int v = 0; v < 256; v++)
+                        pPipe->LUT[*pLUTSlot][v] = (BYTE)v;
+                }
+                BuildPointLUT(pOp, pPipe->LUT[*pLUTSlot]);
+            }
+            else if (nRadius > 0)
+            {
+                pSeg->nStages++;
+                pLUTSlot = &pPipe->nPostLUT[i];
+            }
+            else
+                break;
+        }
+        pSeg->nCount = i - pSeg->nFirst;
+    }
+
+    pPipe->nFormat = nFormat;
+    pPipe->bCompiled = 1;
+    return 0;
+}
+
+/*
+ * @Function Name : CopyRows
+ * @Description : nRows행을 복사하면서 LUT를 적용합니다.
+ * @Input : *pSrc, nSrcStride (0이면 같은 행 반복), nRows, nWidth, *pLUT (NULL이면 그대로 복사)
+ * @Output : *pDst
+ */
+static void CopyRows(BYTE *pDst, size_t nDstStride, const BYTE *pSrc, size_t nSrcStride, int nRows, int nWidth, const BYTE *pLUT)
+{
+    for (int i = 0; i < nRows; i++)
+    {
+        BYTE *d = pDst + (size_t)i * nDstStride;
+        const BYTE *s = pSrc + (size_t)i * nSrcStride;
+
+        if (pLUT != NULL)
+            for (int j = 0; j < nWidth; j++)
+                d[j] = pLUT[s[j]];
+        else
+            memcpy(d, s, nWidth);
+    }
+}
+
+static int PutRows(FUSED_RUN *pRun, int k, const BYTE *pSrc, size_t nSrcStride, int nRows, const BYTE *pLUT);
+
+/*
+ * @Function Name : ProcessStage
+ * @Description : k번째 이웃 연산의 입력 행 버퍼로 만들 수 있는 결과 행을 모두 만들어서 다음 단계로 넘깁니다.
+ * @Input : *pRun, k
+ * @Output : 반환값 0 (성공) / -1 (처리 오류)
+ */
+// 김광제의 설명 - 가장자리 행(이웃 연산이 쓰지 않는 행)은 RunOperation처럼 0으로 보고 바로 넘긴다.
+// 안쪽 행은 버퍼의 연속된 행을 ROI로 만들어서 IMAGE 함수를 한번에 호출한다. (ROI의 위아래 nRadius행은 결과에 쓰지 않음)
+// 결과 행 버퍼의 왼쪽, 오른쪽 가장자리 열은 처음에 0으로 할당해서 계속 0으로 남음
+static int ProcessStage(FUSED_RUN *pRun, int k)
+{
+    FUSED_STAGE *pStage = &pRun->Stage[k];
+    int nWidth = pRun->nWidth, nHeight = pRun->nHeight, r = pStage->nRadius;
+    int nAvail = pStage->nFirst + pStage->nRows;
+
+    while (pStage->nNext < nHeight)
+    {
+        int y = pStage->nNext, yEnd, nOffset, nRet = 0;
+        IMAGE In, Out;
+
+        if (y < r || y >= nHeight - r)
+        {
+            int n = 0;
+
+            while (y + n < nHeight && (y + n < r || y + n >= nHeight - r))
+                n++;
+            if (PutRows(pRun, k + 1, pRun->pZero, 0, n, pStage->pLUT) != 0)
+                return (-1);
+            pStage->nNext += n;
+            continue;
+        }
+
+        yEnd = (nAvail - r < nHeight - r) ? nAvail - r : nHeight - r;
+        if (yEnd <= y)
+            break;
+
+        nOffset = y - r - pStage->nFirst;
+        WrapImage(&In, pStage->pWin + (size_t)nOffset * nWidth, nWidth, yEnd - y + 2 * r, PIXEL_GRAY8, nWidth);
+        WrapImage(&Out, pStage->pOut + (size_t)nOffset * nWidth, nWidth, yEnd - y + 2 * r, PIXEL_GRAY8, nWidth);
+
+        switch (pStage->pOp->nOp)
+        {
+        case OP_CONVOLUTION:
+            nRet = ImgConvolution(&In, &Out, pStage->pOp->Param.nKernel);
+            break;
+        case OP_MEDIAN:
+            nRet = ImgMedianFiltering(&In, &Out, pStage->pOp->Param.nSize);
+            break;
+        case OP_EROSION:
+            nRet = ImgErosion(&In, &Out);
+            break;
+        case OP_DILATION:
+            nRet = ImgDilation(&In, &Out);
+            break;
+        }
+        if (nRet != 0 || PutRows(pRun, k + 1, pStage->pOut + (size_t)(nOffset + r) * nWidth, nWidth, yEnd - y, pStage->pLUT) != 0)
+            return (-1);
+        pStage->nNext = yEnd;
+    }
+
+    // 다음 결과 행에 필요한 행(nNext - nRadius부터)만 남기고 버퍼 앞으로 당김
+    if (pStage->nNext - r > pStage->nFirst)
+    {
+        int nDrop = pStage->nNext - r - pStage->nFirst;
+
+        if (nDrop > pStage->nRows)
+            nDrop = pStage->nRows;
+        memmove(pStage->pWin, pStage->pWin + (size_t)nDrop * nWidth, (size_t)(pStage->nRows - nDrop) * nWidth);
+        pStage->nFirst += nDrop;
+        pStage->nRows -= nDrop;
+    }
+
+    return 0;
+}
+
+/*
+ * @Function Name : PutRows
+ * @Description : k번째 이웃 연산의 입력 행 버퍼에 다음 nRows행을 넣습니다. (k가 마지막 다음이면 결과 영상에 씀)
+ * @Input : *pRun, k, *pSrc, nSrcStride (0이면 같은 행 반복), nRows, *pLUT - 넣을 때 적용할 LUT
+ * @Output : 반환값 0 (성공) / -1 (처리 오류)
+ */
+// 김광제의 설명 - 버퍼가 가득 차거나 영상의 마지막 행까지 들어오면 ProcessStage로 결과를 만들어서 비운다.
+static int PutRows(FUSED_RUN *pRun, int k, const BYTE *pSrc, size_t nSrcStride, int nRows, const BYTE *pLUT)
+{
+    FUSED_STAGE *pStage;
+
+    if (k == pRun->nStages)
+    {
+        CopyRows(pRun->pDst->pPlane[0] + (size_t)pRun->nDstRow * pRun->pDst->nStride, pRun->pDst->nStride, pSrc, nSrcStride, nRows, pRun->nWidth, pLUT);
+        pRun->nDstRow += nRows;
+        return 0;
+    }
+
+    pStage = &pRun->Stage[k];
+    while (nRows > 0)
+    {
+        int n = pStage->nCap - pStage->nRows;
+
+        if (n > nRows)
+            n = nRows;
+        CopyRows(pStage->pWin + (size_t)pStage->nRows * pRun->nWidth, pRun->nWidth, pSrc, nSrcStride, n, pRun->nWidth, pLUT);
+        pStage->nRows += n;
+        pSrc += (size_t)n * nSrcStride;
+        nRows -= n;
+
+        if (pStage->nRows == pStage->nCap || pStage->nFirst + pStage->nRows == pRun->nHeight)
+            if (ProcessStage(pRun, k) != 0)
+                return (-1);
+    }
+
+    return 0;
+}
+
+/*
+ * @Function Name : RunFusedSegment
+ * @Description : 합친 구간을 타일(몇십 행) 단위로 실행합니다. (8비트 그레이)
+ * @Input : *pPipe, *pSeg, *pIn, *pPool - 행 버퍼를 가져올 풀
+ * @Output : *pOut, 반환값 0 (성공) / -1 (메모리 할당 오류, 처리 오류)
+ */
+// 김광제의 설명 - 타일 행 수는 모든 단계의 행 버퍼(입력, 결과)가 L2 캐시(PIPELINE_L2_BYTES)에 들어가도록 정한다.
+// 입력이 출력과 같은 영상이어도 된다. (결과 y행은 입력 y행 이후를 이미 읽은 다음에 씀)
+static int RunFusedSegment(const PIPELINE *pPipe, const PIPELINE_SEGMENT *pSeg, const IMAGE *pIn, IMAGE *pOut, BUFFER_POOL *pPool)
+{
+    FUSED_RUN Run;
+    int nWidth = pIn->nWidth, nTileRows = pPipe->nTileRows, nRet = 0;
+    BYTE *pZero;
+    PROFILE_BEGIN(dStart);
+
+    if (pIn->nWidth != pOut->nWidth || pIn->nHeight != pOut->nHeight || pOut->nFormat != PIXEL_GRAY8)
+        return (-1);
+
+    memset(&Run, 0, sizeof(FUSED_RUN));
+    Run.nWidth = nWidth;
+    Run.nHeight = pIn->nHeight;
+    Run.pDst = pOut;
+
+    for (int i = pSeg->nFirst; i < pSeg->nFirst + pSeg->nCount; i++)
+        if (GetNeighbourRadius(&pPipe->Op[i]) > 0)
+        {
+            FUSED_STAGE *pStage = &Run.Stage[Run.nStages++];
+
+            pStage->pOp = &pPipe->Op[i];
+            pStage->nRadius = GetNeighbourRadius(pStage->pOp);
+            pStage->pLUT = (pPipe->nPostLUT[i] >= 0) ? pPipe->LUT[pPipe->nPostLUT[i]] : NULL;
+        }
+
+    if (nTileRows <= 0)
+    {
+        nTileRows = (Run.nStages > 0) ? (int)(PIPELINE_L2_BYTES / ((size_t)nWidth * 2 * Run.nStages)) : 0;
+        nTileRows = (nTileRows < 8) ? 8 : ((nTileRows > 256) ? 256 : nTileRows);
+    }
+
+    pZero = (BYTE *)PoolAlloc(pPool, nWidth, 1);
+    Run.pZero = pZero;
+    for (int k = 0; k < Run.nStages; k++)
+    {
+        FUSED_STAGE *pStage = &Run.Stage[k];
+
+        pStage->nCap = nTileRows + 2 * pStage->nRadius;
+        pStage->pWin = (BYTE *)PoolAlloc(pPool, (size_t)pStage->nCap * nWidth, 0);
+        pStage->pOut = (BYTE *)PoolAlloc(pPool, (size_t)pStage->nCap * nWidth, 1); // 가장자리 열은 항상 0
+        if (NULL == pStage->pWin || NULL == pStage->pOut)
+            nRet = (-1);
+    }
+
+    if (nRet == 0 && pZero != NULL)
+        nRet = PutRows(&Run, 0, pIn->pPlane[0], pIn->nStride, pIn->nHeight, (pSeg->nPreLUT >= 0) ? pPipe->LUT[pSeg->nPreLUT] : NULL);
+    else
+        nRet = (-1);
+
+    for (int k = 0; k < Run.nStages; k++)
+    {
+        PoolFree(pPool, Run.Stage[k].pWin);
+        PoolFree(pPool, Run.Stage[k].pOut);
+    }
+    PoolFree(pPool, pZero);
+
+    PROFILE_COUNT("pipeline_fused_ops", pSeg->nCount);
+    PROFILE_END(dStart, "pipeline_fused", (long long)nWidth * pIn->nHeight, (long long)nWidth * pIn->nHeight * 2);
+    return nRet;
+}
+
+/*
+ * @Function Name : PipelineRun
+ * @Description : 파이프라인을 실행합니다. (처음 실행하거나 입력 형식이 바뀌면 PipelineCompile)
+ * @Input : *pCtx, *pPipe, *pIn
+ * @Output : *pOut - 마지막 기능의 결과 (OP_TO_GRAY가 있으면 8비트 그레이, 없으면 pIn과 같은 형식),
+ *           반환값 0 (성공) / -1 (잘못된 인자, 메모리 할당 오류, 처리 오류)
+ */
+// 김광제의 설명 - 구간 사이의 중간 결과만 영상 크기 버퍼(컨텍스트의 풀) 두 개를 번갈아 사용한다.
+// 같은 파이프라인을 여러 프레임에 반복 실행하면 컴파일과 버퍼 할당은 처음 한번만 일어남
+int PipelineRun(IMGPROC_CONTEXT *pCtx, PIPELINE *pPipe, const IMAGE *pIn, IMAGE *pOut)
+{
+    IMAGE Temp[2];
+    const IMAGE *pCur = pIn;
+    BUFFER_POOL *pPrevPool;
+    int nRet = 0;
+
+    if (pPipe->nOps == 0)
+        return RunOperation(pCtx, OP_COPY, pIn, pOut, NULL);
+
+    if ((!pPipe->bCompiled || pPipe->nFormat != pIn->nFormat) && PipelineCompile(pPipe, pIn->nFormat) != 0)
+        return (-1);
+
+    memset(Temp, 0, sizeof(Temp));
+    pPrevPool = SetThreadPool(&pCtx->Pool);
+
+    for (int s = 0; s < pPipe->nSegments && nRet == 0; s++)
+    {
+        const PIPELINE_SEGMENT *pSeg = &pPipe->Segment[s];
+        PIPELINE_OP *pOp = &pPipe->Op[pSeg->nFirst];
+        int nFormat = (!pSeg->bFused && pOp->nOp == OP_TO_GRAY) ? PIXEL_GRAY8 : pCur->nFormat;
+        IMAGE *pDst = pOut;
+
+        // 마지막 구간이 아니면 중간 버퍼 (바로 앞 구간의 결과와 다른 버퍼)
+        if (s < pPipe->nSegments - 1)
+        {
+            pDst = &Temp[s % 2];
+            if (pDst->pBuffer != NULL && pDst->nFormat != nFormat)
+                FreeImage(pDst);
+            if (pDst->pBuffer == NULL &&
+                CreateImage(pDst, pIn->nWidth, pIn->nHeight, nFormat, (nFormat == PIXEL_GRAY8) ? LAYOUT_INTERLEAVED : pCur->nLayout) != 0)
+            {
+                nRet = (-1);
+                break;
+            }
+        }
+
+        if (pSeg->bFused)
+            nRet = RunFusedSegment(pPipe, pSeg, pCur, pDst, &pCtx->Pool);
+        else
+            nRet = RunOperation(pCtx, pOp->nOp, pCur, pDst, &pOp->Param);
+
+        pCur = pDst;
+    }
+
+    FreeImage(&Temp[0]);
+    FreeImage(&Temp[1]);
+    SetThreadPool(pPrevPool);
+    return nRet;
+}
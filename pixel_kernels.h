@@ -0,0 +1,669 @@
+/*
+ * @DName : pixel_kernels.h
+ * @Description : Image Processing in C
+ * @Date : 2026. 10. 19
+ * @Revision : 1.3
+ *	1.0 : pixel type generic kernels (16bit gray, 24/32bit color)
+ *	1.1 : IMAGE 구조체 입력 (nStride, ROI), 8비트 LUT 처리
+ *	1.2 : 임시 버퍼를 스레드 버퍼 풀에서 가져옴
+ *	1.3 : 고정 커널(KERNEL_xxx) 정수 컨볼루션 (계수를 컴파일 시간 상수로 특수화)
+ *
+ * 픽셀 형식별 커널 템플릿입니다. include 하기 전에 아래 매크로를 정의하면
+ * 해당 형식에 맞게 특수화된 함수들이 만들어집니다. (C에는 template이 없어서 매크로로 대신함)
+ *
+ *  PK_TYPE   : 샘플 자료형 (BYTE, WORD)
+ *  PK_CH     : 픽셀당 채널 수 (1, 3, 4)
+ *  PK_ALPHA  : 마지막 채널이 알파 채널이면 1 (알파는 처리하지 않고 그대로 복사)
+ *  PK_MAX    : 샘플의 최대값 (255, 65535)
+ *  PK_SUFFIX : 함수 이름 뒤에 붙일 접미사 (InverseImage_Gray16 처럼 만들어짐)
+ *
+ * 채널 수와 최대값이 컴파일 시간에 정해지기 때문에 픽셀마다 형식을 검사하는 분기가 없고
+ * 채널 반복문도 컴파일러가 풀어버린다.
+ * 모든 함수는 Interleaved IMAGE를 입력받고 행은 nStride 간격으로 접근하기 때문에 ROI 영상도 복사 없이 처리할 수 있다.
+ */
+
+#define PK_CAT2(a, b) a##_##b
+#define PK_CAT(a, b) PK_CAT2(a, b)
+#define PK_NAME(name) PK_CAT(name, PK_SUFFIX)
+
+// 실제로 처리하는 채널 수 (알파 채널 제외)
+#define PK_COLOR (PK_CH - PK_ALPHA)
+
+// i번째 행의 시작 주소
+#define PK_ROW(pImg, i) ((PK_TYPE *)((pImg)->pPlane[0] + (size_t)(i) * (pImg)->nStride))
+
+/*
+ * @Function Name : ApplyLUT_X
+ * @Description : 8비트 샘플을 256개짜리 LUT로 변환합니다. (알파 채널은 복사)
+ * @Input : *pIn, LUT
+ * @Output : *pOut
+ */
+#if PK_MAX == 255
+static void PK_NAME(ApplyLUT)(const IMAGE *pIn, IMAGE *pOut, const BYTE *LUT)
+{
+    for (int i = 0; i < pIn->nHeight; i++)
+    {
+        const PK_TYPE *pSrc = PK_ROW(pIn, i);
+        PK_TYPE *pDst = PK_ROW(pOut, i);
+
+        for (int j = 0; j < pIn->nWidth; j++)
+        {
+            for (int c = 0; c < PK_COLOR; c++)
+                pDst[j * PK_CH + c] = LUT[pSrc[j * PK_CH + c]];
+#if PK_ALPHA
+            pDst[j * PK_CH + PK_COLOR] = pSrc[j * PK_CH + PK_COLOR];
+#endif
+        }
+    }
+}
+#endif
+
+/*
+ * @Function Name : InverseImage_X
+ * @Description : 샘플 단위로 밝기 값을 반전시킵니다. (PK_MAX - 값)
+ * @Input : *pIn
+ * @Output : *pOut
+ */
+void PK_NAME(InverseImage)(const IMAGE *pIn, IMAGE *pOut)
+{
+#if PK_MAX == 255
+    // 8비트는 밝기값이 256개뿐이라 결과를 미리 표로 만들어두고 참조만 한다.
+    BYTE LUT[256];
+
+    for (int v = 0; v < 256; v++)
+        LUT[v] = (BYTE)(255 - v);
+    PK_NAME(ApplyLUT)(pIn, pOut, LUT);
+#else
+    for (int i = 0; i < pIn->nHeight; i++)
+    {
+        const PK_TYPE *pSrc = PK_ROW(pIn, i);
+        PK_TYPE *pDst = PK_ROW(pOut, i);
+
+        for (int j = 0; j < pIn->nWidth; j++)
+        {
+            for (int c = 0; c < PK_COLOR; c++)
+                pDst[j * PK_CH + c] = (PK_TYPE)(PK_MAX - pSrc[j * PK_CH + c]);
+#if PK_ALPHA
+            pDst[j * PK_CH + PK_COLOR] = pSrc[j * PK_CH + PK_COLOR];
+#endif
+        }
+    }
+#endif
+}
+
+/*
+ * @Function Name : AdjustBrightness_X
+ * @Description : nBrightness 값에 따라 샘플 단위로 밝기값을 조절합니다. (영상의 밝기 범위 단위)
+ * @Input : *pIn, nBrightness
+ * @Output : *pOut
+ */
+void PK_NAME(AdjustBrightness)(const IMAGE *pIn, IMAGE *pOut, int nBrightness)
+{
+#if PK_MAX == 255
+    BYTE LUT[256];
+
+    for (int v = 0; v < 256; v++)
+        LUT[v] = (BYTE)((v + nBrightness > 255) ? 255 : ((v + nBrightness < 0) ? 0 : v + nBrightness));
+    PK_NAME(ApplyLUT)(pIn, pOut, LUT);
+#else
+    long nValue;
+
+    for (int i = 0; i < pIn->nHeight; i++)
+    {
+        const PK_TYPE *pSrc = PK_ROW(pIn, i);
+        PK_TYPE *pDst = PK_ROW(pOut, i);
+
+        for (int j = 0; j < pIn->nWidth; j++)
+        {
+            for (int c = 0; c < PK_COLOR; c++)
+            {
+                nValue = (long)pSrc[j * PK_CH + c] + nBrightness;
+                // 범위를 넘어가는 값은 클리핑
+                if (nValue > PK_MAX)
+                    nValue = PK_MAX;
+                else if (nValue < 0)
+                    nValue = 0;
+                pDst[j * PK_CH + c] = (PK_TYPE)nValue;
+            }
+#if PK_ALPHA
+            pDst[j * PK_CH + PK_COLOR] = pSrc[j * PK_CH + PK_COLOR];
+#endif
+        }
+    }
+#endif
+}
+
+/*
+ * @Function Name : AdjustContrast_X
+ * @Description : dContrast 값을 곱하여 대비를 조정합니다.
+ * @Input : *pIn, dContrast
+ * @Output : *pOut
+ */
+void PK_NAME(AdjustContrast)(const IMAGE *pIn, IMAGE *pOut, double dContrast)
+{
+#if PK_MAX == 255
+    BYTE LUT[256];
+
+    for (int v = 0; v < 256; v++)
+        LUT[v] = (v * dContrast > 255) ? 255 : (BYTE)(v * dContrast);
+    PK_NAME(ApplyLUT)(pIn, pOut, LUT);
+#else
+    for (int i = 0; i < pIn->nHeight; i++)
+    {
+        const PK_TYPE *pSrc = PK_ROW(pIn, i);
+        PK_TYPE *pDst = PK_ROW(pOut, i);
+
+        for (int j = 0; j < pIn->nWidth; j++)
+        {
+            for (int c = 0; c < PK_COLOR; c++)
+            {
+                if (pSrc[j * PK_CH + c] * dContrast > PK_MAX)
+                    pDst[j * PK_CH + c] = PK_MAX;
+                else
+                    pDst[j * PK_CH + c] = (PK_TYPE)(pSrc[j * PK_CH + c] * dContrast);
+            }
+#if PK_ALPHA
+            pDst[j * PK_CH + PK_COLOR] = pSrc[j * PK_CH + PK_COLOR];
+#endif
+        }
+    }
+#endif
+}
+
+/*
+ * @Function Name : GenerateBinarization_X
+ * @Description : nThreshold 보다 작은 샘플은 0, 크거나 같은 샘플은 PK_MAX로 이진화합니다.
+ * @Input : *pIn, nThreshold
+ * @Output : *pOut
+ */
+void PK_NAME(GenerateBinarization)(const IMAGE *pIn, IMAGE *pOut, unsigned int nThreshold)
+{
+#if PK_MAX == 255
+    BYTE LUT[256];
+
+    for (unsigned int v = 0; v < 256; v++)
+        LUT[v] = (v < nThreshold) ? 0 : 255;
+    PK_NAME(ApplyLUT)(pIn, pOut, LUT);
+#else
+    for (int i = 0; i < pIn->nHeight; i++)
+    {
+        const PK_TYPE *pSrc = PK_ROW(pIn, i);
+        PK_TYPE *pDst = PK_ROW(pOut, i);
+
+        for (int j = 0; j < pIn->nWidth; j++)
+        {
+            for (int c = 0; c < PK_COLOR; c++)
+                pDst[j * PK_CH + c] = (pSrc[j * PK_CH + c] < nThreshold) ? 0 : PK_MAX;
+#if PK_ALPHA
+            pDst[j * PK_CH + PK_COLOR] = pSrc[j * PK_CH + PK_COLOR];
+#endif
+        }
+    }
+#endif
+}
+
+/*
+ * @Function Name : CombineMax_X
+ * @Description : 두 영상의 같은 위치 샘플 중 큰 값을 pOut에 저장합니다. (Prewitt, Sobel X/Y 결과 합치기)
+ * @Input : *pIn, *pOut
+ * @Output : *pOut
+ */
+void PK_NAME(CombineMax)(const IMAGE *pIn, IMAGE *pOut)
+{
+    for (int i = 0; i < pIn->nHeight; i++)
+    {
+        const PK_TYPE *pSrc = PK_ROW(pIn, i);
+        PK_TYPE *pDst = PK_ROW(pOut, i);
+
+        for (int j = 0; j < pIn->nWidth * PK_CH; j++)
+            if (pSrc[j] > pDst[j])
+                pDst[j] = pSrc[j];
+    }
+}
+
+#if PK_CH == 1
+// 히스토그램 관련 함수는 그레이 영상에서만 의미가 있음 (히스토그램 크기 PK_MAX + 1)
+
+/*
+ * @Function Name : GenerateHistogram_X
+ * @Description : 입력 이미지에 대한 히스토그램(PK_MAX + 1 개)을 버퍼에 출력
+ * @Input : *pIn
+ * @Output : *Histogram
+ */
+void PK_NAME(GenerateHistogram)(const IMAGE *pIn, int *Histogram)
+{
+    for (int i = 0; i < pIn->nHeight; i++)
+    {
+        const PK_TYPE *pSrc = PK_ROW(pIn, i);
+
+        for (int j = 0; j < pIn->nWidth; j++)
+            Histogram[pSrc[j]]++;
+    }
+}
+
+/*
+ * @Function Name : HistogramStretching_X
+ * @Description : 히스토그램의 최소값 ~ 최대값을 0 ~ PK_MAX로 스트래칭합니다.
+ * @Input : *pIn, *Histogram
+ * @Output : *pOut
+ */
+void PK_NAME(HistogramStretching)(const IMAGE *pIn, IMAGE *pOut, int *Histogram)
+{
+    long Low = 0, High = PK_MAX;
+
+    for (long i = 0; i <= PK_MAX; i++)
+    {
+        if (Histogram[i] != 0)
+        {
+            Low = i;
+            break;
+        }
+    }
+
+    for (long i = PK_MAX; i >= 0; i--)
+    {
+        if (Histogram[i] != 0)
+        {
+            High = i;
+            break;
+        }
+    }
+
+    for (int i = 0; i < pIn->nHeight; i++)
+    {
+        const PK_TYPE *pSrc = PK_ROW(pIn, i);
+        PK_TYPE *pDst = PK_ROW(pOut, i);
+
+        for (int j = 0; j < pIn->nWidth; j++)
+        {
+            if (pSrc[j] <= Low)
+                pDst[j] = 0;
+            else
+                pDst[j] = (PK_TYPE)((pSrc[j] - Low) / (double)(High - Low) * (double)PK_MAX);
+        }
+    }
+}
+
+/*
+ * @Function Name : HistogramEqualization_X
+ * @Description : 누적 히스토그램을 0 ~ PK_MAX로 정규화하여 히스토그램 평활화를 수행합니다.
+ * @Input : *pIn, *Histogram
+ * @Output : *pOut, 반환값 0 (성공) / -1 (메모리 할당 오류)
+ */
+int PK_NAME(HistogramEqualization)(const IMAGE *pIn, IMAGE *pOut, int *Histogram)
+{
+    double Ratio = PK_MAX / (double)(pIn->nWidth * pIn->nHeight);
+    long nSum = 0;
+    PK_TYPE *NormSum = (PK_TYPE *)PoolAlloc(GetThreadPool(), sizeof(PK_TYPE) * ((size_t)PK_MAX + 1), 0); // 16비트는 65536개라서 스택 대신 버퍼 풀
+
+    if (NULL == NormSum)
+        return (-1);
+
+    for (long i = 0; i <= PK_MAX; i++)
+    {
+        nSum += Histogram[i];
+        NormSum[i] = (PK_TYPE)(Ratio * nSum);
+    }
+
+    for (int i = 0; i < pIn->nHeight; i++)
+    {
+        const PK_TYPE *pSrc = PK_ROW(pIn, i);
+        PK_TYPE *pDst = PK_ROW(pOut, i);
+
+        for (int j = 0; j < pIn->nWidth; j++)
+            pDst[j] = NormSum[pSrc[j]];
+    }
+
+    PoolFree(GetThreadPool(), NormSum);
+    return 0;
+}
+#endif
+
+/*
+ * @Function Name : Convolution3x3_X
+ * @Description : 3x3 커널로 채널별 컨볼루션을 수행합니다. (가장자리 1픽셀은 처리하지 않음)
+ * @Input : *pIn,
+ *          Kernel - 3x3 커널 (convolution.h),
+ *          nPost - 결과 후처리 방법 (CONV_POST_NONE, CONV_POST_ABS, CONV_POST_CLIP),
+ *          nDivisor - CONV_POST_ABS일 때 절대값을 나눌 값
+ * @Output : *pOut
+ */
+void PK_NAME(Convolution3x3)(const IMAGE *pIn, IMAGE *pOut, const double Kernel[3][3], int nPost, int nDivisor)
+{
+    double SumProduct;
+    long nValue;
+
+    for (int i = 1; i < pIn->nHeight - 1; i++)
+    {
+        const PK_TYPE *pRow[3] = {PK_ROW(pIn, i - 1), PK_ROW(pIn, i), PK_ROW(pIn, i + 1)}; // 위, 가운데, 아래 행
+        PK_TYPE *pDst = PK_ROW(pOut, i);
+
+        for (int j = 1; j < pIn->nWidth - 1; j++)
+        {
+            for (int c = 0; c < PK_COLOR; c++)
+            {
+                SumProduct = 0.0;
+                // 같은 채널끼리만 곱해야 하므로 옆 픽셀은 PK_CH 만큼 떨어져 있음
+                for (int m = -1; m <= 1; m++)
+                    for (int n = -1; n <= 1; n++)
+                        SumProduct += pRow[m + 1][(j + n) * PK_CH + c] * Kernel[m + 1][n + 1];
+
+                if (nPost == CONV_POST_ABS)
+                    nValue = labs((long)SumProduct) / nDivisor;
+                else if (nPost == CONV_POST_CLIP)
+                    nValue = (SumProduct > PK_MAX) ? PK_MAX : ((SumProduct < 0.0) ? 0 : (long)SumProduct);
+                else
+                    nValue = (long)SumProduct;
+
+                pDst[j * PK_CH + c] = (PK_TYPE)nValue;
+            }
+#if PK_ALPHA
+            pDst[j * PK_CH + PK_COLOR] = pRow[1][j * PK_CH + PK_COLOR];
+#endif
+        }
+    }
+}
+
+/*
+ * @Function Name : Convolution3x3Fixed_X
+ * @Description : convolution.h의 고정 커널을 정수 연산으로 컨볼루션합니다. (가장자리 1픽셀은 처리하지 않음)
+ * @Input : *pIn, nKernel - KERNEL_xxx
+ * @Output : *pOut, 반환값 0 (처리함) / -1 (특수화하지 않은 커널, Convolution3x3_X 사용)
+ */
+// 김광제의 설명 - 커널마다 계수를 정수 상수로 넣은 반복문을 따로 만든다. (PK_CONV_FIXED)
+// 계수가 상수라서 컴파일러가 0 계수 항(프리윗, 소벨의 가운데 행/열)은 빼버리고 ±1, ±2 곱은 덧셈, 시프트로 바꾼다.
+// 결과는 double 커널로 계산한 Convolution3x3_X와 비트 단위로 같다.
+//   - 가우시안 계수는 1/16의 배수라 double 합이 정확하므로 정수 합 >> 4와 같음
+//   - 평균 0.11111 X 합은 정수와 1e-5 이상 떨어져 있어서 (합 X 11111) / 100000과 같음 (8비트만, 16비트는 합이 커서 기존 경로)
+#define PK_CONV_FIXED(k00, k01, k02, k10, k11, k12, k20, k21, k22, POST)                                        \
+    for (int i = 1; i < pIn->nHeight - 1; i++)                                                                    \
+    {                                                                                                             \
+        const PK_TYPE *p0 = PK_ROW(pIn, i - 1), *p1 = PK_ROW(pIn, i), *p2 = PK_ROW(pIn, i + 1);                   \
+        PK_TYPE *pDst = PK_ROW(pOut, i);                                                                          \
+                                                                                                                  \
+        for (int j = 1; j < pIn->nWidth - 1; j++)                                                                 \
+        {                                                                                                         \
+            for (int c = 0; c < PK_COLOR; c++)                                                                    \
+            {                                                                                                     \
+                int x = j * PK_CH + c;                                                                            \
+                int nSum = k00 * p0[x - PK_CH] + k01 * p0[x] + k02 * p0[x + PK_CH] +                              \
+                           k10 * p1[x - PK_CH] + k11 * p1[x] + k12 * p1[x + PK_CH] +                              \
+                           k20 * p2[x - PK_CH] + k21 * p2[x] + k22 * p2[x + PK_CH];                               \
+                pDst[x] = (PK_TYPE)(POST);                                                                        \
+            }                                                                                                     \
+            PK_CONV_ALPHA                                                                                         \
+        }                                                                                                         \
+    }
+
+#if PK_ALPHA
+#define PK_CONV_ALPHA pDst[j * PK_CH + PK_COLOR] = p1[j * PK_CH + PK_COLOR];
+#else
+#define PK_CONV_ALPHA
+#endif
+
+static int PK_NAME(Convolution3x3Fixed)(const IMAGE *pIn, IMAGE *pOut, int nKernel)
+{
+    switch (nKernel)
+    {
+#if PK_MAX == 255
+    case KERNEL_AVERAGE:
+        PK_CONV_FIXED(1, 1, 1, 1, 1, 1, 1, 1, 1, nSum * 11111 / 100000);
+        break;
+#endif
+    case KERNEL_GAUSSIAN:
+        PK_CONV_FIXED(1, 2, 1, 2, 4, 2, 1, 2, 1, nSum >> 4);
+        break;
+    case KERNEL_LAPLACIAN:
+        PK_CONV_FIXED(-1, -1, -1, -1, 8, -1, -1, -1, -1, abs(nSum) / 8);
+        break;
+    case KERNEL_PREWITT_X:
+        PK_CONV_FIXED(-1, 0, 1, -1, 0, 1, -1, 0, 1, abs(nSum) / 3);
+        break;
+    case KERNEL_PREWITT_Y:
+        PK_CONV_FIXED(-1, -1, -1, 0, 0, 0, 1, 1, 1, abs(nSum) / 3);
+        break;
+    case KERNEL_SOBEL_X:
+        PK_CONV_FIXED(-1, 0, 1, -2, 0, 2, -1, 0, 1, abs(nSum) / 4);
+        break;
+    case KERNEL_SOBEL_Y:
+        PK_CONV_FIXED(-1, -2, -1, 0, 0, 0, 1, 2, 1, abs(nSum) / 4);
+        break;
+    case KERNEL_HPF_LAPLACIAN:
+        PK_CONV_FIXED(-1, -1, -1, -1, 9, -1, -1, -1, -1, (nSum > PK_MAX) ? PK_MAX : ((nSum < 0) ? 0 : nSum));
+        break;
+    default:
+        return (-1);
+    }
+
+    return 0;
+}
+
+#undef PK_CONV_ALPHA
+#undef PK_CONV_FIXED
+
+/*
+ * @Function Name : SelectKth_X
+ * @Description : 배열에서 k번째로 작은 값을 찾습니다. (Quick Select, 배열 순서는 바뀜)
+ * @Input : *pArr, nSize, k
+ * @Output : k번째로 작은 값
+ */
+// 정렬 전체를 하지 않고 k번째 값이 있는 쪽만 나눠가며 찾기 때문에 평균 O(n)
+static PK_TYPE PK_NAME(SelectKth)(PK_TYPE *pArr, int nSize, int k)
+{
+    int nLeft = 0, nRight = nSize - 1;
+    PK_TYPE tPivot, tTemp;
+
+    while (nLeft < nRight)
+    {
+        int i = nLeft, j = nRight;
+        tPivot = pArr[(nLeft + nRight) / 2];
+
+        while (i <= j)
+        {
+            while (pArr[i] < tPivot)
+                i++;
+            while (pArr[j] > tPivot)
+                j--;
+            if (i <= j)
+            {
+                tTemp = pArr[i];
+                pArr[i] = pArr[j];
+                pArr[j] = tTemp;
+                i++;
+                j--;
+            }
+        }
+
+        if (k <= j)
+            nRight = j;
+        else if (k >= i)
+            nLeft = i;
+        else
+            break;
+    }
+
+    return pArr[k];
+}
+
+/*
+ * @Function Name : MedianFiltering_X
+ * @Description : nSize X nSize 크기의 채널별 Median Filter를 수행합니다.
+ * @Input : *pIn, nSize
+ * @Output : *pOut, 반환값 0 (성공) / -1 (메모리 할당 오류)
+ */
+int PK_NAME(MedianFiltering)(const IMAGE *pIn, IMAGE *pOut, int nSize)
+{
+    int nMargin = nSize / 2;
+    int nWSize = nSize * nSize;
+    PK_TYPE *pTemp = (PK_TYPE *)PoolAlloc(GetThreadPool(), sizeof(PK_TYPE) * nWSize, 0);
+
+    if (NULL == pTemp)
+        return (-1);
+
+    for (int i = nMargin; i < pIn->nHeight - nMargin; i++)
+    {
+        PK_TYPE *pDst = PK_ROW(pOut, i);
+
+        for (int j = nMargin; j < pIn->nWidth - nMargin; j++)
+        {
+            for (int c = 0; c < PK_COLOR; c++)
+            {
+                int k = 0;
+                for (int m = -nMargin; m <= nMargin; m++)
+                {
+                    const PK_TYPE *pSrc = PK_ROW(pIn, i + m);
+                    for (int n = -nMargin; n <= nMargin; n++)
+                        pTemp[k++] = pSrc[(j + n) * PK_CH + c];
+                }
+
+                pDst[j * PK_CH + c] = PK_NAME(SelectKth)(pTemp, nWSize, nWSize / 2);
+            }
+#if PK_ALPHA
+            pDst[j * PK_CH + PK_COLOR] = PK_ROW(pIn, i)[j * PK_CH + PK_COLOR];
+#endif
+        }
+    }
+
+    PoolFree(GetThreadPool(), pTemp);
+    return 0;
+}
+
+/*
+ * @Function Name : SwapPixel_X
+ * @Description : 두 픽셀의 모든 채널을 교환합니다.
+ * @Input : *pLeft, *pRight
+ * @Output : *pLeft, *pRight
+ */
+static void PK_NAME(SwapPixel)(PK_TYPE *pLeft, PK_TYPE *pRight)
+{
+    PK_TYPE tTemp;
+
+    for (int c = 0; c < PK_CH; c++)
+    {
+        tTemp = pLeft[c];
+        pLeft[c] = pRight[c];
+        pRight[c] = tTemp;
+    }
+}
+
+/*
+ * @Function Name : VerticalFlip_X
+ * @Description : 영상에 대해 Vertical Flip을 수행 (제자리 처리)
+ * @Input : *pImg
+ * @Output : *pImg
+ */
+void PK_NAME(VerticalFlip)(IMAGE *pImg)
+{
+    for (int i = 0; i < pImg->nHeight / 2; i++)
+    {
+        PK_TYPE *pTop = PK_ROW(pImg, i), *pBottom = PK_ROW(pImg, pImg->nHeight - 1 - i);
+
+        for (int j = 0; j < pImg->nWidth; j++)
+            PK_NAME(SwapPixel)(&pTop[j * PK_CH], &pBottom[j * PK_CH]);
+    }
+}
+
+/*
+ * @Function Name : HorizontalFlip_X
+ * @Description : 영상에 대해 Horizontal Flip을 수행 (제자리 처리)
+ * @Input : *pImg
+ * @Output : *pImg
+ */
+void PK_NAME(HorizontalFlip)(IMAGE *pImg)
+{
+    for (int i = 0; i < pImg->nHeight; i++)
+    {
+        PK_TYPE *pRow = PK_ROW(pImg, i);
+
+        for (int j = 0; j < pImg->nWidth / 2; j++)
+            PK_NAME(SwapPixel)(&pRow[j * PK_CH], &pRow[(pImg->nWidth - 1 - j) * PK_CH]);
+    }
+}
+
+/*
+ * @Function Name : Translation_X
+ * @Description : 영상을 Tx, Ty 만큼 이동 (BMP는 상하가 뒤집혀 있어서 Ty는 -1을 곱해서 처리)
+ * @Input : *pIn, Tx, Ty
+ * @Output : *pOut
+ */
+void PK_NAME(Translation)(const IMAGE *pIn, IMAGE *pOut, int Tx, int Ty)
+{
+    int nWidth = pIn->nWidth, nHeight = pIn->nHeight;
+
+    Ty *= -1;
+    for (int i = 0; i < nHeight; i++)
+    {
+        const PK_TYPE *pSrc = PK_ROW(pIn, i);
+
+        if (i + Ty >= nHeight || i + Ty < 0)
+            continue;
+
+        for (int j = 0; j < nWidth; j++)
+            if (j + Tx < nWidth && j + Tx >= 0)
+                for (int c = 0; c < PK_CH; c++)
+                    PK_ROW(pOut, i + Ty)[(j + Tx) * PK_CH + c] = pSrc[j * PK_CH + c];
+    }
+}
+
+/*
+ * @Function Name : Scaling_X
+ * @Description : 순방향 사상으로 영상을 Sx, Sy 비율로 확대/축소
+ * @Input : *pIn, Sx, Sy
+ * @Output : *pOut
+ */
+void PK_NAME(Scaling)(const IMAGE *pIn, IMAGE *pOut, double Sx, double Sy)
+{
+    int tmpX, tmpY;
+
+    for (int i = 0; i < pIn->nHeight; i++)
+    {
+        const PK_TYPE *pSrc = PK_ROW(pIn, i);
+
+        for (int j = 0; j < pIn->nWidth; j++)
+        {
+            tmpX = (int)(j * Sx);
+            tmpY = (int)(i * Sy);
+            if (tmpY < pIn->nHeight && tmpX < pIn->nWidth)
+                for (int c = 0; c < PK_CH; c++)
+                    PK_ROW(pOut, tmpY)[tmpX * PK_CH + c] = pSrc[j * PK_CH + c];
+        }
+    }
+}
+
+/*
+ * @Function Name : Rotation_X
+ * @Description : 순방향 사상으로 영상을 (0,0) 기준으로 Angle 만큼 회전
+ * @Input : *pIn, Angle
+ * @Output : *pOut
+ */
+void PK_NAME(Rotation)(const IMAGE *pIn, IMAGE *pOut, int Angle)
+{
+    int tmpX, tmpY;
+    double Radian = Angle * 3.141592 / 180.0;
+    double dCos = cos(Radian), dSin = sin(Radian); // 픽셀마다 다시 계산하지 않도록 미리 구함
+
+    for (int i = 0; i < pIn->nHeight; i++)
+    {
+        const PK_TYPE *pSrc = PK_ROW(pIn, i);
+
+        for (int j = 0; j < pIn->nWidth; j++)
+        {
+            tmpX = (int)(dCos * j - dSin * i);
+            tmpY = (int)(dSin * j + dCos * i);
+            if ((tmpY < pIn->nHeight && tmpY >= 0) && (tmpX < pIn->nWidth && tmpX >= 0))
+                for (int c = 0; c < PK_CH; c++)
+                    PK_ROW(pOut, tmpY)[tmpX * PK_CH + c] = pSrc[j * PK_CH + c];
+        }
+    }
+}
+
+#undef PK_ROW
+#undef PK_COLOR
+#undef PK_NAME
+#undef PK_CAT
+#undef PK_CAT2
+#undef PK_TYPE
+#undef PK_CH
+#undef PK_ALPHA
+#undef PK_MAX
+#undef PK_SUFFIX
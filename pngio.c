@@ -0,0 +1,467 @@
+/*
+ * @Name : pngio.c
+ * @Description : Image Processing in C - PNG 저장 (외부 라이브러리 없이 zlib 형식, deflate 직접 구현)
+ * @Date : 2026. 10. 19
+ * @Revision : 1.0
+ * 1.0 : WritePng - 행 필터 (None, Sub, Up 중 선택), 고정 허프만 deflate (해시 한번만 찾는 빠른 LZ77)
+ *
+ * 이진 영상, 레이블 영상은 같은 값이 길게 이어져서 고정 허프만 + LZ77만으로도 원본의 수십 분의 1이 된다.
+ * 압축률보다 속도를 우선하므로 해시 체인 없이 마지막으로 나온 위치 하나만 비교한다. (zlib 레벨 1과 비슷한 방식)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "imgprocessing.h"
+#include "profile.h"
+
+#define PNG_IDAT_BYTES 65536 // IDAT 청크 하나의 최대 크기 (버퍼가 차면 청크로 저장)
+#define PNG_HASH_BITS 15     // LZ77 해시 테이블 크기 (2^15)
+#define PNG_WINDOW 32768     // deflate 최대 거리
+#define PNG_MIN_MATCH 3
+#define PNG_MAX_MATCH 258
+
+// deflate 길이 코드 (257 ~ 285)의 시작 길이, 추가 비트 수
+static const unsigned short g_nLenBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27,
+                                              31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const BYTE g_nLenExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+
+// deflate 거리 코드 (0 ~ 29)의 시작 거리, 추가 비트 수
+static const unsigned short g_nDistBase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129,
+                                               193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+static const BYTE g_nDistExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+// PNG 저장 상태 (WritePng 한번에 하나, 스레드마다 따로 사용)
+typedef struct
+{
+    FILE *fp;
+    DWORD dwCrcTable[256];
+    BYTE Out[PNG_IDAT_BYTES]; // 저장하지 않은 zlib 데이터
+    int nOut;
+    unsigned long long qwBits; // 아직 바이트로 나가지 않은 비트 (deflate는 하위 비트부터)
+    int nBits;
+    int nStatus; // 0 : 정상, -1 : 파일 쓰기 오류
+
+    // 고정 허프만 코드 (비트 순서를 뒤집어 둔 값)
+    unsigned short nLitCode[288];
+    BYTE nLitLen[288];
+    BYTE nDistCode[30];
+    BYTE nLenSym[PNG_MAX_MATCH + 1]; // 길이 -> 길이 코드 번호 (0 ~ 28)
+} PNG_WRITER;
+
+/*
+ * @Function Name : ReverseBits
+ * @Description : 하위 nBits 비트의 순서를 뒤집습니다.
+ * @Input : nCode, nBits
+ * @Output : 뒤집은 값
+ */
+// 김광제의 설명 - 허프만 코드는 상위 비트부터 저장해야 하는데 deflate 비트 스트림은 하위 비트부터 채우므로 미리 뒤집어 둔다.
+static unsigned int ReverseBits(unsigned int nCode, int nBits)
+{
+    unsigned int nRet = 0;
+
+    for (int i = 0; i < nBits; i++)
+    {
+        nRet = (nRet << 1) | (nCode & 1);
+        nCode >>= 1;
+    }
+    return nRet;
+}
+
+/*
+ * @Function Name : PngWriterInit
+ * @Description : CRC 테이블, 고정 허프만 코드 테이블을 만듭니다.
+ * @Input : *pW, *fp
+ * @Output : *pW
+ */
+// 김광제의 설명 - 고정 허프만 코드 (RFC 1951 3.2.6)
+//   0 ~ 143 : 8비트 (00110000 ~), 144 ~ 255 : 9비트 (110010000 ~), 256 ~ 279 : 7비트 (0000000 ~), 280 ~ 287 : 8비트 (11000000 ~)
+//   거리 코드는 모두 5비트
+static void PngWriterInit(PNG_WRITER *pW, FILE *fp)
+{
+    pW->fp = fp;
+    pW->nOut = 0;
+    pW->qwBits = 0;
+    pW->nBits = 0;
+    pW->nStatus = 0;
+
+    for (DWORD n = 0; n < 256; n++)
+    {
+        DWORD c = n;
+
+        for (int k = 0; k < 8; k++)
+            c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+        pW->dwCrcTable[n] = c;
+    }
+
+    for (int i = 0; i < 288; i++)
+    {
+        if (i < 144)
+            pW->nLitLen[i] = 8, pW->nLitCode[i] = (unsigned short)ReverseBits(0x30 + i, 8);
+        else if (i < 256)
+            pW->nLitLen[i] = 9, pW->nLitCode[i] = (unsigned short)ReverseBits(0x190 + (i - 144), 9);
+        else if (i < 280)
+            pW->nLitLen[i] = 7, pW->nLitCode[i] = (unsigned short)ReverseBits(i - 256, 7);
+        else
+            pW->nLitLen[i] = 8, pW->nLitCode[i] = (unsigned short)ReverseBits(0xC0 + (i - 280), 8);
+    }
+    for (int i = 0; i < 30; i++)
+        pW->nDistCode[i] = (BYTE)ReverseBits(i, 5);
+
+    for (int nSym = 0, nLen = PNG_MIN_MATCH; nLen <= PNG_MAX_MATCH; nLen++)
+    {
+        while (nSym < 28 && nLen >= g_nLenBase[nSym + 1])
+            nSym++;
+        pW->nLenSym[nLen] = (BYTE)nSym;
+    }
+}
+
+/*
+ * @Function Name : UpdateCrc
+ * @Description : CRC-32를 계산합니다. (PNG 청크)
+ * @Input : *pW, dwCrc - 이전 값 (처음은 0xFFFFFFFF), *pData, nSize
+ * @Output : 갱신된 CRC (마지막에 0xFFFFFFFF와 XOR)
+ */
+static DWORD UpdateCrc(const PNG_WRITER *pW, DWORD dwCrc, const BYTE *pData, size_t nSize)
+{
+    for (size_t i = 0; i < nSize; i++)
+        dwCrc = pW->dwCrcTable[(dwCrc ^ pData[i]) & 0xFF] ^ (dwCrc >> 8);
+    return dwCrc;
+}
+
+/*
+ * @Function Name : PutBE32
+ * @Description : 32비트 값을 빅 엔디안으로 저장합니다.
+ * @Input : *p, dwValue
+ * @Output : p[0 ~ 3]
+ */
+static void PutBE32(BYTE *p, DWORD dwValue)
+{
+    p[0] = (BYTE)(dwValue >> 24);
+    p[1] = (BYTE)(dwValue >> 16);
+    p[2] = (BYTE)(dwValue >> 8);
+    p[3] = (BYTE)dwValue;
+}
+
+/*
+ * @Function Name : WriteChunk
+ * @Description : PNG 청크 (길이, 종류, 데이터, CRC)를 저장합니다.
+ * @Input : *pW, *szType - 4글자 청크 종류, *pData, nSize
+ * @Output : 파일 쓰기 오류면 pW->nStatus = -1
+ */
+static void WriteChunk(PNG_WRITER *pW, const char *szType, const BYTE *pData, int nSize)
+{
+    BYTE Head[8], Tail[4];
+    DWORD dwCrc;
+
+    PutBE32(Head, (DWORD)nSize);
+    memcpy(Head + 4, szType, 4);
+    dwCrc = UpdateCrc(pW, 0xFFFFFFFFu, Head + 4, 4);
+    dwCrc = UpdateCrc(pW, dwCrc, pData, nSize) ^ 0xFFFFFFFFu;
+    PutBE32(Tail, dwCrc);
+
+    if (fwrite(Head, 1, 8, pW->fp) != 8 || (nSize > 0 && fwrite(pData, 1, nSize, pW->fp) != (size_t)nSize) ||
+        fwrite(Tail, 1, 4, pW->fp) != 4)
+        pW->nStatus = (-1);
+}
+
+/*
+ * @Function Name : PutByte
+ * @Description : zlib 데이터 한 바이트를 추가합니다. (버퍼가 차면 IDAT 청크로 저장)
+ * @Input : *pW, nValue
+ * @Output : pW->Out
+ */
+static void PutByte(PNG_WRITER *pW, BYTE nValue)
+{
+    pW->Out[pW->nOut++] = nValue;
+    if (pW->nOut == PNG_IDAT_BYTES)
+    {
+        WriteChunk(pW, "IDAT", pW->Out, pW->nOut);
+        pW->nOut = 0;
+    }
+}
+
+/*
+ * @Function Name : PutBits
+ * @Description : deflate 비트 스트림에 nBits 비트를 추가합니다. (하위 비트부터)
+ * @Input : *pW, nValue, nBits (최대 32)
+ * @Output : pW->qwBits, nBits
+ */
+static void PutBits(PNG_WRITER *pW, unsigned int nValue, int nBits)
+{
+    pW->qwBits |= (unsigned long long)nValue << pW->nBits;
+    pW->nBits += nBits;
+    while (pW->nBits >= 8)
+    {
+        PutByte(pW, (BYTE)pW->qwBits);
+        pW->qwBits >>= 8;
+        pW->nBits -= 8;
+    }
+}
+
+/*
+ * @Function Name : PutMatch
+ * @Description : (길이, 거리)를 고정 허프만 코드로 저장합니다.
+ * @Input : *pW, nLen (3 ~ 258), nDist (1 ~ 32768)
+ * @Output : 비트 스트림
+ */
+static void PutMatch(PNG_WRITER *pW, int nLen, int nDist)
+{
+    int nSym = pW->nLenSym[nLen], nDistSym = 29;
+
+    PutBits(pW, pW->nLitCode[257 + nSym], pW->nLitLen[257 + nSym]);
+    if (g_nLenExtra[nSym] > 0)
+        PutBits(pW, nLen - g_nLenBase[nSym], g_nLenExtra[nSym]);
+
+    while (g_nDistBase[nDistSym] > nDist)
+        nDistSym--;
+    PutBits(pW, pW->nDistCode[nDistSym], 5);
+    if (g_nDistExtra[nDistSym] > 0)
+        PutBits(pW, nDist - g_nDistBase[nDistSym], g_nDistExtra[nDistSym]);
+}
+
+/*
+ * @Function Name : Deflate
+ * @Description : 필터를 적용한 데이터 전체를 zlib 형식 (헤더, 고정 허프만 블록 하나, Adler-32)으로 압축합니다.
+ * @Input : *pW, *pData, nSize, *pHead - 2^PNG_HASH_BITS 개 (0으로 초기화)
+ * @Output : IDAT 청크 (마지막 청크는 pW->Out에 남음)
+ */
+// 김광제의 설명 - 3바이트 해시로 마지막으로 같은 해시가 나온 위치 하나만 비교하고 일치하면 최대 258바이트까지 늘린다.
+// 일치한 구간 안의 위치도 모두 해시에 넣어야 다음 행의 같은 패턴을 찾을 수 있음 (이진 영상은 대부분 거리 1 또는 한 행 거리)
+static void Deflate(PNG_WRITER *pW, const BYTE *pData, size_t nSize, unsigned int *pHead)
+{
+    DWORD s1 = 1, s2 = 0;
+    size_t i = 0;
+
+    // zlib 헤더 (deflate, 32K 창, 빠른 압축)
+    PutByte(pW, 0x78);
+    PutByte(pW, 0x01);
+
+    // 마지막 블록, 고정 허프만
+    PutBits(pW, 1, 1);
+    PutBits(pW, 1, 2);
+
+    while (i < nSize)
+    {
+        int nLen = 0;
+        size_t nCand = 0;
+        unsigned int nHash = 0;
+
+        if (i + PNG_MIN_MATCH <= nSize)
+        {
+            nHash = ((DWORD)pData[i] << 16 | (DWORD)pData[i + 1] << 8 | pData[i + 2]) * 2654435761u >> (32 - PNG_HASH_BITS);
+            nCand = pHead[nHash];
+            pHead[nHash] = (unsigned int)(i + 1);
+
+            if (nCand > 0 && i - (nCand - 1) <= PNG_WINDOW)
+            {
+                const BYTE *p = pData + nCand - 1, *q = pData + i;
+                int nMax = (nSize - i < PNG_MAX_MATCH) ? (int)(nSize - i) : PNG_MAX_MATCH;
+
+                while (nLen < nMax && p[nLen] == q[nLen])
+                    nLen++;
+            }
+        }
+
+        if (nLen >= PNG_MIN_MATCH)
+        {
+            PutMatch(pW, nLen, (int)(i - (nCand - 1)));
+            for (size_t k = i + 1; k < i + nLen && k + PNG_MIN_MATCH <= nSize; k++)
+                pHead[((DWORD)pData[k] << 16 | (DWORD)pData[k + 1] << 8 | pData[k + 2]) * 2654435761u >> (32 - PNG_HASH_BITS)] = (unsigned int)(k + 1);
+            i += nLen;
+        }
+        else
+        {
+            PutBits(pW, pW->nLitCode[pData[i]], pW->nLitLen[pData[i]]);
+            i++;
+        }
+    }
+
+    // 블록 끝, 바이트 경계까지 채움
+    PutBits(pW, pW->nLitCode[256], pW->nLitLen[256]);
+    if (pW->nBits > 0)
+        PutBits(pW, 0, 8 - pW->nBits);
+
+    // Adler-32 (압축 전 데이터, 5552바이트마다 나머지 계산)
+    for (i = 0; i < nSize;)
+    {
+        size_t nEnd = (nSize - i > 5552) ? i + 5552 : nSize;
+
+        for (; i < nEnd; i++)
+        {
+            s1 += pData[i];
+            s2 += s1;
+        }
+        s1 %= 65521;
+        s2 %= 65521;
+    }
+    PutByte(pW, (BYTE)(s2 >> 8));
+    PutByte(pW, (BYTE)s2);
+    PutByte(pW, (BYTE)(s1 >> 8));
+    PutByte(pW, (BYTE)s1);
+}
+
+/*
+ * @Function Name : FilterCost
+ * @Description : 필터를 적용한 행의 크기 추정값 (바이트를 부호 있는 값으로 본 절대값의 합)
+ * @Input : *pRow, nBytes
+ * @Output : 합
+ */
+static long long FilterCost(const BYTE *pRow, int nBytes)
+{
+    long long nSum = 0;
+
+    for (int i = 0; i < nBytes; i++)
+        nSum += (pRow[i] < 128) ? pRow[i] : 256 - pRow[i];
+    return nSum;
+}
+
+/*
+ * @Function Name : WritePng
+ * @Description : 영상을 PNG 파일로 저장합니다.
+ * @Input : *fp - "wb"로 연 파일, *Image - 패딩이 없는 픽셀 데이터 (아래에서 위 순서), nWidth, nHeight,
+ *          nFormat - PIXEL_GRAY8 (그레이 8비트), PIXEL_GRAY16 (그레이 16비트), PIXEL_BGR24 (RGB), PIXEL_BGRA32 (RGBA)
+ * @Output : 반환값 0 (성공) / -1 (잘못된 크기, 형식, 메모리 할당 오류, 파일 쓰기 오류)
+ */
+// 김광제의 설명 - PNG는 위에서 아래 순서, 16비트는 빅 엔디안, 컬러는 R, G, B 순서라서 행마다 바꿔서 필터를 적용한다.
+// 필터는 None, Sub, Up을 모두 적용해 보고 절대값의 합이 가장 작은 것을 사용 (Average, Paeth는 속도 때문에 사용하지 않음)
+// 32비트 영상의 알파가 모두 0이면 알파를 쓰지 않은 BMP로 보고 RGB로 저장 (RGBA로 저장하면 전부 투명하게 보임)
+int WritePng(FILE *fp, const BYTE *Image, int nWidth, int nHeight, int nFormat)
+{
+    static const BYTE Signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    PNG_WRITER *pW;
+    BYTE Header[13];
+    BYTE *pData, *pRaw, *pPrev, *pFilter[3];
+    unsigned int *pHead;
+    int nBpp, nSrcBpp, nRowBytes, nColorType, nDepth = 8, nRet;
+    size_t nSize;
+    PROFILE_BEGIN(dStart);
+
+    if (NULL == Image || nWidth <= 0 || nHeight <= 0)
+        return (-1);
+
+    nSrcBpp = GetBytesPerPixel(nFormat);
+    switch (nFormat)
+    {
+    case PIXEL_GRAY8:
+        nColorType = 0, nBpp = 1;
+        break;
+    case PIXEL_GRAY16:
+        nColorType = 0, nBpp = 2, nDepth = 16;
+        break;
+    case PIXEL_BGR24:
+        nColorType = 2, nBpp = 3;
+        break;
+    case PIXEL_BGRA32:
+        nColorType = 2, nBpp = 3;
+        for (size_t i = 3; i < (size_t)nWidth * nHeight * 4; i += 4)
+            if (Image[i] != 0)
+            {
+                nColorType = 6, nBpp = 4;
+                break;
+            }
+        break;
+    default:
+        return (-1);
+    }
+
+    nRowBytes = nWidth * nBpp;
+    nSize = (size_t)(nRowBytes + 1) * nHeight;
+    pW = (PNG_WRITER *)PoolAlloc(GetThreadPool(), sizeof(PNG_WRITER), 0);
+    pData = (BYTE *)PoolAlloc(GetThreadPool(), nSize + (size_t)nRowBytes * 4, 0);
+    pHead = (unsigned int *)PoolAlloc(GetThreadPool(), sizeof(unsigned int) << PNG_HASH_BITS, 1);
+    if (NULL == pW || NULL == pData || NULL == pHead)
+    {
+        PoolFree(GetThreadPool(), pW);
+        PoolFree(GetThreadPool(), pData);
+        PoolFree(GetThreadPool(), pHead);
+        return (-1);
+    }
+    PngWriterInit(pW, fp);
+
+    // 행마다 PNG 순서로 바꾼 원본(pFilter[0]), Sub(pFilter[1]), Up(pFilter[2]) 중 가장 작은 것을 필터 번호와 함께 저장
+    // 원본 행은 Up 필터에 쓰도록 두 버퍼(pRaw, pPrev)를 번갈아 사용
+    pRaw = pData + nSize;
+    pPrev = pRaw + nRowBytes;
+    pFilter[1] = pPrev + nRowBytes;
+    pFilter[2] = pFilter[1] + nRowBytes;
+    for (int y = 0; y < nHeight; y++)
+    {
+        const BYTE *pSrc = Image + (size_t)(nHeight - 1 - y) * nWidth * nSrcBpp;
+        BYTE *pDst = pData + (size_t)y * (nRowBytes + 1), *pTmp;
+        long long nCost, nBest;
+        int nFilter = 0;
+
+        switch (nFormat)
+        {
+        case PIXEL_GRAY8:
+            memcpy(pRaw, pSrc, nRowBytes);
+            break;
+        case PIXEL_GRAY16:
+            for (int x = 0; x < nWidth; x++)
+            {
+                pRaw[x * 2] = pSrc[x * 2 + 1];
+                pRaw[x * 2 + 1] = pSrc[x * 2];
+            }
+            break;
+        default:
+            for (int x = 0; x < nWidth; x++)
+            {
+                BYTE *p = pRaw + x * nBpp;
+                const BYTE *q = pSrc + x * nSrcBpp;
+
+                p[0] = q[2];
+                p[1] = q[1];
+                p[2] = q[0];
+                if (nBpp == 4)
+                    p[3] = q[3];
+            }
+            break;
+        }
+
+        pFilter[0] = pRaw;
+        for (int x = 0; x < nRowBytes; x++)
+            pFilter[1][x] = (BYTE)(pRaw[x] - (x >= nBpp ? pRaw[x - nBpp] : 0));
+        nBest = FilterCost(pRaw, nRowBytes);
+        if ((nCost = FilterCost(pFilter[1], nRowBytes)) < nBest)
+            nBest = nCost, nFilter = 1;
+        if (y > 0)
+        {
+            for (int x = 0; x < nRowBytes; x++)
+                pFilter[2][x] = (BYTE)(pRaw[x] - pPrev[x]);
+            if (FilterCost(pFilter[2], nRowBytes) < nBest)
+                nFilter = 2;
+        }
+
+        pDst[0] = (BYTE)nFilter;
+        memcpy(pDst + 1, pFilter[nFilter], nRowBytes);
+
+        pTmp = pPrev;
+        pPrev = pRaw;
+        pRaw = pTmp;
+    }
+
+    // 시그니처, IHDR (크기, 비트 깊이, 색 형식, 압축 0, 필터 0, 인터레이스 0), IDAT, IEND
+    if (fwrite(Signature, 1, 8, fp) != 8)
+        pW->nStatus = (-1);
+    PutBE32(Header, (DWORD)nWidth);
+    PutBE32(Header + 4, (DWORD)nHeight);
+    Header[8] = (BYTE)nDepth;
+    Header[9] = (BYTE)nColorType;
+    Header[10] = Header[11] = Header[12] = 0;
+    WriteChunk(pW, "IHDR", Header, 13);
+
+    Deflate(pW, pData, nSize, pHead);
+    if (pW->nOut > 0)
+        WriteChunk(pW, "IDAT", pW->Out, pW->nOut);
+    WriteChunk(pW, "IEND", NULL, 0);
+    nRet = pW->nStatus;
+
+    PoolFree(GetThreadPool(), pHead);
+    PoolFree(GetThreadPool(), pData);
+    PoolFree(GetThreadPool(), pW);
+
+    PROFILE_COUNT("png_bytes_written", (long long)nSize);
+    PROFILE_END(dStart, "write_png", (long long)nWidth * nHeight, (long long)nWidth * nHeight * nSrcBpp + (long long)nSize);
+    return nRet;
+}
@@ -0,0 +1,342 @@
+/*
+ * @Name : profile.c
+ * @Description : Image Processing in C - 단계별 시간, 카운터 기록 (profile.h 구현)
+ * @Date : 2026. 10. 19
+ * @Revision : 1.1
+ * 1.0 : profile.h에서 분리 (IMGPROC_PROFILE을 정의하지 않으면 빈 파일)
+ * 1.1 : OpenMP critical 대신 뮤텍스로 잠금 (OpenMP 없이 빌드해도 일괄 처리의 읽기, 쓰기 스레드와 동시에 기록 가능)
+ */
+
+#include "profile.h"
+
+#ifdef IMGPROC_PROFILE
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#include <threads.h>
+#else
+#include <time.h>
+#include <pthread.h>
+#endif
+
+#define PROFILE_MAX_STAGES 64
+#define PROFILE_MAX_COUNTERS 32
+#define PROFILE_MAX_EVENTS 65536 // trace에 남길 최대 구간 수 (넘으면 합계만 기록)
+
+#ifndef IMGPROC_THREAD_LOCAL
+#if defined(_MSC_VER)
+#define IMGPROC_THREAD_LOCAL __declspec(thread)
+#else
+#define IMGPROC_THREAD_LOCAL __thread
+#endif
+#endif
+
+// 단계별 합계
+typedef struct
+{
+    const char *szName;
+    long long nCalls;
+    double dTotal, dMin, dMax; // 초
+    long long nPixels, nBytes;
+} PROFILE_STAGE;
+
+// 알고리즘 카운터
+typedef struct
+{
+    const char *szName;
+    long long nValue;
+    int bMax; // 1이면 최대값, 0이면 합계
+} PROFILE_COUNTER;
+
+// trace에 남길 실행 구간 (bCounter가 1이면 카운터 값 변화)
+typedef struct
+{
+    const char *szName;
+    double dStart, dDuration;
+    long long nPixels, nBytes;
+    int nThread, bCounter;
+} PROFILE_EVENT;
+
+typedef struct
+{
+    PROFILE_STAGE Stage[PROFILE_MAX_STAGES];
+    PROFILE_COUNTER Counter[PROFILE_MAX_COUNTERS];
+    PROFILE_EVENT *pEvent;
+    int nStages, nCounters, nEvents;
+    long long nDropped; // 가득 차서 trace에 남기지 못한 구간 수
+    int nThreads;       // 지금까지 기록한 스레드 수 (trace의 tid)
+    double dBase;       // trace 시간 기준 (가장 먼저 시작한 기록의 시각)
+    int bBase;
+} PROFILER;
+
+static PROFILER Profiler;
+static IMGPROC_THREAD_LOCAL int nProfileThread = -1;
+
+// Profiler 잠금 (batch.c와 같이 Windows는 C11 threads.h, 그 외는 pthread)
+// C11 mtx_t는 정적 초기화가 없으므로 처음 잠글 때 call_once로 초기화
+#ifdef _WIN32
+static mtx_t ProfileMutex;
+static once_flag ProfileOnce = ONCE_FLAG_INIT;
+static void ProfileMutexInit(void) { mtx_init(&ProfileMutex, mtx_plain); }
+#define PROFILE_LOCK() (call_once(&ProfileOnce, ProfileMutexInit), mtx_lock(&ProfileMutex))
+#define PROFILE_UNLOCK() mtx_unlock(&ProfileMutex)
+#else
+static pthread_mutex_t ProfileMutex = PTHREAD_MUTEX_INITIALIZER;
+#define PROFILE_LOCK() pthread_mutex_lock(&ProfileMutex)
+#define PROFILE_UNLOCK() pthread_mutex_unlock(&ProfileMutex)
+#endif
+
+/*
+ * @Function Name : ProfileNow
+ * @Description : 단조 증가 시계의 현재 시각을 초 단위로 반환합니다.
+ * @Output : 초
+ */
+double ProfileNow(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER nCount, nFreq;
+
+    QueryPerformanceCounter(&nCount);
+    QueryPerformanceFrequency(&nFreq);
+    return (double)nCount.QuadPart / (double)nFreq.QuadPart;
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+/*
+ * @Function Name : ProfileThreadId
+ * @Description : 호출한 스레드의 번호(0부터 기록한 순서)를 반환합니다. (Profiler 잠금 안에서 호출)
+ */
+static int ProfileThreadId(void)
+{
+    if (nProfileThread < 0)
+        nProfileThread = Profiler.nThreads++;
+    return nProfileThread;
+}
+
+/*
+ * @Function Name : ProfileAddEvent
+ * @Description : trace 구간을 하나 추가합니다. (Profiler 잠금 안에서 호출)
+ */
+// 김광제의 설명 - 구간 배열은 처음 기록할 때 한번만 할당하고, 가득 차면 더 늘리지 않고 버린 개수만 센다.
+// (오래 도는 배치에서 메모리가 계속 늘어나지 않도록)
+static void ProfileAddEvent(const char *szName, double dStart, double dDuration, long long nPixels, long long nBytes, int bCounter)
+{
+    PROFILE_EVENT *pEvent;
+
+    if (NULL == Profiler.pEvent)
+        Profiler.pEvent = (PROFILE_EVENT *)malloc(sizeof(PROFILE_EVENT) * PROFILE_MAX_EVENTS);
+    if (NULL == Profiler.pEvent || Profiler.nEvents >= PROFILE_MAX_EVENTS)
+    {
+        Profiler.nDropped++;
+        return;
+    }
+
+    pEvent = &Profiler.pEvent[Profiler.nEvents++];
+    pEvent->szName = szName;
+    pEvent->dStart = dStart;
+    pEvent->dDuration = dDuration;
+    pEvent->nPixels = nPixels;
+    pEvent->nBytes = nBytes;
+    pEvent->nThread = ProfileThreadId();
+    pEvent->bCounter = bCounter;
+}
+
+/*
+ * @Function Name : ProfileRecord
+ * @Description : szName 단계의 실행 시간(dStart부터 지금까지), 픽셀 수, 바이트 수를 누적합니다.
+ * @Input : *szName, dStart, nPixels, nBytes
+ */
+// 김광제의 설명 - 여러 스레드(OpenMP, 일괄 처리의 읽기, 쓰기 스레드)에서 호출해도 되도록 뮤텍스로 잠근다.
+// OpenMP critical은 OpenMP 없이 빌드하면 사라지고 OpenMP가 아닌 스레드끼리는 막지 못하므로 사용하지 않음
+void ProfileRecord(const char *szName, double dStart, long long nPixels, long long nBytes)
+{
+    double dEnd = ProfileNow(), dTime = dEnd - dStart;
+
+    PROFILE_LOCK();
+    {
+        PROFILE_STAGE *pStage = NULL;
+
+        // 바깥 단계는 안쪽 단계보다 늦게 끝나므로 기준 시각은 가장 이른 시작 시각으로 갱신
+        if (!Profiler.bBase || dStart < Profiler.dBase)
+        {
+            Profiler.dBase = dStart;
+            Profiler.bBase = 1;
+        }
+
+        for (int i = 0; i < Profiler.nStages; i++)
+            if (Profiler.Stage[i].szName == szName || strcmp(Profiler.Stage[i].szName, szName) == 0)
+            {
+                pStage = &Profiler.Stage[i];
+                break;
+            }
+
+        if (NULL == pStage && Profiler.nStages < PROFILE_MAX_STAGES)
+        {
+            pStage = &Profiler.Stage[Profiler.nStages++];
+            memset(pStage, 0, sizeof(PROFILE_STAGE));
+            pStage->szName = szName;
+            pStage->dMin = dTime;
+        }
+
+        if (pStage)
+        {
+            pStage->nCalls++;
+            pStage->dTotal += dTime;
+            pStage->dMin = (dTime < pStage->dMin) ? dTime : pStage->dMin;
+            pStage->dMax = (dTime > pStage->dMax) ? dTime : pStage->dMax;
+            pStage->nPixels += nPixels;
+            pStage->nBytes += nBytes;
+        }
+
+        ProfileAddEvent(szName, dStart, dTime, nPixels, nBytes, 0);
+    }
+    PROFILE_UNLOCK();
+}
+
+/*
+ * @Function Name : ProfileCounter
+ * @Description : 카운터에 nValue를 더하거나(bMax = 0) 최대값으로 갱신(bMax = 1)합니다.
+ * @Input : *szName, nValue, bMax
+ */
+void ProfileCounter(const char *szName, long long nValue, int bMax)
+{
+    double dNow = ProfileNow();
+
+    PROFILE_LOCK();
+    {
+        PROFILE_COUNTER *pCounter = NULL;
+
+        if (!Profiler.bBase || dNow < Profiler.dBase)
+        {
+            Profiler.dBase = dNow;
+            Profiler.bBase = 1;
+        }
+
+        for (int i = 0; i < Profiler.nCounters; i++)
+            if (Profiler.Counter[i].szName == szName || strcmp(Profiler.Counter[i].szName, szName) == 0)
+            {
+                pCounter = &Profiler.Counter[i];
+                break;
+            }
+
+        if (NULL == pCounter && Profiler.nCounters < PROFILE_MAX_COUNTERS)
+        {
+            pCounter = &Profiler.Counter[Profiler.nCounters++];
+            pCounter->szName = szName;
+            pCounter->nValue = 0;
+            pCounter->bMax = bMax;
+        }
+
+        if (pCounter)
+        {
+            if (bMax)
+                pCounter->nValue = (nValue > pCounter->nValue) ? nValue : pCounter->nValue;
+            else
+                pCounter->nValue += nValue;
+
+            // trace에는 카운터의 현재 값을 남김
+            ProfileAddEvent(szName, dNow, 0.0, pCounter->nValue, 0, 1);
+        }
+    }
+    PROFILE_UNLOCK();
+}
+
+/*
+ * @Function Name : ProfileReset
+ * @Description : 기록을 모두 지웁니다. (구간 배열은 해제)
+ */
+void ProfileReset(void)
+{
+    int nThreads;
+
+    PROFILE_LOCK();
+    nThreads = Profiler.nThreads; // 스레드 번호는 스레드마다 이미 저장되어 있으므로 유지
+    free(Profiler.pEvent);
+    memset(&Profiler, 0, sizeof(PROFILER));
+    Profiler.nThreads = nThreads;
+    PROFILE_UNLOCK();
+}
+
+/*
+ * @Function Name : ProfileWriteJson
+ * @Description : 단계별 합계(호출 수, 시간, 픽셀/바이트 처리량)와 카운터를 JSON 파일로 저장합니다.
+ * @Input : *szPath
+ * @Output : 0 (성공) / -1 (파일 열기 오류)
+ */
+int ProfileWriteJson(const char *szPath)
+{
+    FILE *fp = fopen(szPath, "w");
+
+    if (NULL == fp)
+        return (-1);
+
+    PROFILE_LOCK();
+    fprintf(fp, "{\n  \"stages\": [");
+    for (int i = 0; i < Profiler.nStages; i++)
+    {
+        PROFILE_STAGE *pStage = &Profiler.Stage[i];
+        double dTotal = (pStage->dTotal > 0.0) ? pStage->dTotal : 1e-9;
+
+        fprintf(fp, "%s\n    {\"name\": \"%s\", \"calls\": %lld, \"total_ms\": %.6f, \"mean_ms\": %.6f, \"min_ms\": %.6f, \"max_ms\": %.6f, "
+                    "\"pixels\": %lld, \"bytes\": %lld, \"mpix_per_s\": %.4f, \"gb_per_s\": %.4f}",
+                (i == 0) ? "" : ",", pStage->szName, pStage->nCalls, pStage->dTotal * 1e3, pStage->dTotal * 1e3 / pStage->nCalls,
+                pStage->dMin * 1e3, pStage->dMax * 1e3, pStage->nPixels, pStage->nBytes,
+                pStage->nPixels / dTotal / 1e6, pStage->nBytes / dTotal / 1e9);
+    }
+
+    fprintf(fp, "\n  ],\n  \"counters\": {");
+    for (int i = 0; i < Profiler.nCounters; i++)
+        fprintf(fp, "%s\n    \"%s\": %lld", (i == 0) ? "" : ",", Profiler.Counter[i].szName, Profiler.Counter[i].nValue);
+
+    fprintf(fp, "\n  },\n  \"trace_events\": %d,\n  \"trace_dropped\": %lld\n}\n", Profiler.nEvents, Profiler.nDropped);
+    PROFILE_UNLOCK();
+    fclose(fp);
+
+    return 0;
+}
+
+/*
+ * @Function Name : ProfileWriteTrace
+ * @Description : 기록한 구간을 Chrome trace(JSON) 형식으로 저장합니다.
+ * @Input : *szPath
+ * @Output : 0 (성공) / -1 (파일 열기 오류)
+ */
+// 김광제의 설명 - 구간은 "X"(시작 시각 + 길이), 카운터는 "C" 이벤트로 남긴다. 시간 단위는 마이크로초
+int ProfileWriteTrace(const char *szPath)
+{
+    FILE *fp = fopen(szPath, "w");
+
+    if (NULL == fp)
+        return (-1);
+
+    PROFILE_LOCK();
+    fprintf(fp, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [");
+    for (int i = 0; i < Profiler.nEvents; i++)
+    {
+        PROFILE_EVENT *pEvent = &Profiler.pEvent[i];
+        double dTs = (pEvent->dStart - Profiler.dBase) * 1e6;
+
+        if (pEvent->bCounter)
+            fprintf(fp, "%s\n{\"name\": \"%s\", \"ph\": \"C\", \"ts\": %.3f, \"pid\": 1, \"tid\": %d, \"args\": {\"value\": %lld}}",
+                    (i == 0) ? "" : ",", pEvent->szName, dTs, pEvent->nThread, pEvent->nPixels);
+        else
+            fprintf(fp, "%s\n{\"name\": \"%s\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": 1, \"tid\": %d, "
+                        "\"args\": {\"pixels\": %lld, \"bytes\": %lld}}",
+                    (i == 0) ? "" : ",", pEvent->szName, dTs, pEvent->dDuration * 1e6, pEvent->nThread, pEvent->nPixels, pEvent->nBytes);
+    }
+    fprintf(fp, "\n]}\n");
+    PROFILE_UNLOCK();
+    fclose(fp);
+
+    return 0;
+}
+
+#endif // IMGPROC_PROFILE
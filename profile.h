@@ -0,0 +1,65 @@
+/*
+ * @DName : profile.h
+ * @Description : Image Processing in C
+ * @Date : 2026. 10. 19
+ * @Revision : 1.1
+ *	1.0 : 단계별 처리 시간, 처리 픽셀/바이트 수, 알고리즘 카운터 기록 (JSON, Chrome trace 출력)
+ *	1.1 : 구현을 profile.c로 분리 (라이브러리의 여러 파일에서 같은 기록을 사용)
+ *
+ * IMGPROC_PROFILE을 정의하고 빌드할 때만 기록하고, 정의하지 않으면 아래 매크로가 모두 빈 문장이 되어 실행 비용이 없다.
+ *
+ *  PROFILE_BEGIN(var)                         : 시작 시각을 var에 저장
+ *  PROFILE_END(var, szName, nPixels, nBytes)  : szName 단계의 시간, 픽셀 수, 읽고 쓴 바이트 수를 누적
+ *  PROFILE_COUNT(szName, nValue)              : 카운터에 nValue를 더함 (곤잘레스 반복 횟수, 블롭 개수 등)
+ *  PROFILE_MAX(szName, nValue)                : 카운터를 지금까지의 최대값으로 갱신 (최대 스택 깊이 등)
+ *  PROFILE_WRITE_JSON(szPath)                 : 단계별 합계와 카운터를 JSON으로 저장
+ *  PROFILE_WRITE_TRACE(szPath)                : 단계별 실행 구간을 Chrome trace 형식으로 저장 (chrome://tracing, Perfetto)
+ *  PROFILE_RESET()                            : 기록을 모두 지움
+ *
+ * szName은 문자열 상수만 사용 (포인터를 그대로 저장함)
+ * 단계 시간은 안에서 호출한 단계의 시간을 포함함 (예: auto_binarization 안의 histogram, otsu)
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#ifdef IMGPROC_PROFILE
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// profile.c
+double ProfileNow(void);
+void ProfileRecord(const char *szName, double dStart, long long nPixels, long long nBytes);
+void ProfileCounter(const char *szName, long long nValue, int bMax);
+void ProfileReset(void);
+int ProfileWriteJson(const char *szPath);
+int ProfileWriteTrace(const char *szPath);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define PROFILE_BEGIN(var) double var = ProfileNow()
+#define PROFILE_END(var, szName, nPixels, nBytes) ProfileRecord(szName, var, (long long)(nPixels), (long long)(nBytes))
+#define PROFILE_COUNT(szName, nValue) ProfileCounter(szName, (long long)(nValue), 0)
+#define PROFILE_MAX(szName, nValue) ProfileCounter(szName, (long long)(nValue), 1)
+#define PROFILE_WRITE_JSON(szPath) ProfileWriteJson(szPath)
+#define PROFILE_WRITE_TRACE(szPath) ProfileWriteTrace(szPath)
+#define PROFILE_RESET() ProfileReset()
+
+#else // IMGPROC_PROFILE
+
+// 측정하지 않는 빌드에서는 인자도 계산하지 않음
+#define PROFILE_BEGIN(var)
+#define PROFILE_END(var, szName, nPixels, nBytes) ((void)0)
+#define PROFILE_COUNT(szName, nValue) ((void)0)
+#define PROFILE_MAX(szName, nValue) ((void)0)
+#define PROFILE_WRITE_JSON(szPath) ((void)0)
+#define PROFILE_WRITE_TRACE(szPath) ((void)0)
+#define PROFILE_RESET() ((void)0)
+
+#endif // IMGPROC_PROFILE
+
+#endif // PROFILE_H
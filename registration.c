@@ -0,0 +1,508 @@
+/*
+ * @Name : registration.c
+ * @Description : Image Processing in C - 위상 상관(phase correlation) 영상 정합 (평행 이동, 로그 극좌표로 회전과 배율)
+ * @Date : 2026. 10. 19
+ * @Revision : 1.0
+ * 1.0 : PHASE_CORR (기준 영상 스펙트럼을 한번 만들어서 여러 프레임에 재사용), PhaseCorrMatch (부화소 최대값 보간),
+ *       회전, 배율 (크기 스펙트럼의 로그 극좌표 위상 상관), ImgPhaseCorrelate
+ *
+ * 이동량마다 Translation을 실행해서 차이를 비교하면 탐색 범위의 제곱만큼 영상 전체를 다시 읽는다.
+ * 두 영상의 FFT로 만든 정규화 교차 전력 스펙트럼을 역변환하면 이동량 위치에 최대값 하나가 생기므로 FFT 두번으로 끝난다.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "imgprocessing.h"
+#include "profile.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define PHASE_EPSILON 1e-12     // 교차 전력 스펙트럼 크기가 이보다 작으면 0 (나누기 0 방지)
+#define PHASE_PEAK_SIGMA 2.0    // 상관 최대값 모양 (가우시안 표준 편차, 화소)
+#define PHASE_POLAR_MIN_SIZE 64 // 로그 극좌표 영상의 최소 크기 (각도, 반지름 칸 수)
+#define PHASE_POLAR_MIN_RADIUS 2.0 // 로그 극좌표의 가장 작은 반지름 (변환 크기 기준 주파수 칸, 직류 근처 제외)
+
+/*
+ * @Function Name : LoadFrame
+ * @Description : 그레이 영상(8, 16비트)을 double 연속 버퍼로 옮기고 평균을 구합니다.
+ * @Input : *pIn
+ * @Output : *pDst - nWidth X nHeight, 반환값 평균
+ */
+static double LoadFrame(const IMAGE *pIn, double *pDst)
+{
+    int nWidth = pIn->nWidth, nHeight = pIn->nHeight;
+    double dSum = 0.0;
+
+#pragma omp parallel for schedule(static) reduction(+ : dSum)
+    for (int y = 0; y < nHeight; y++)
+    {
+        const BYTE *pSrc = pIn->pPlane[0] + (size_t)y * pIn->nStride;
+        double *pRow = pDst + (size_t)y * nWidth;
+
+        if (pIn->nFormat == PIXEL_GRAY16)
+            for (int x = 0; x < nWidth; x++)
+                pRow[x] = ((const WORD *)pSrc)[x];
+        else
+            for (int x = 0; x < nWidth; x++)
+                pRow[x] = pSrc[x];
+        for (int x = 0; x < nWidth; x++)
+            dSum += pRow[x];
+    }
+    return dSum / ((double)nWidth * nHeight);
+}
+
+/*
+ * @Function Name : WindowToSpectrum
+ * @Description : 평균을 빼고 Hann 창을 곱한 영상을 변환 크기 버퍼(나머지 0)에 놓고 FFT합니다.
+ * @Input : *pCorr, *pFrame - nWidth X nHeight, dMean, nLeft, nTop, nRight, nBottom - 창을 씌울 영역 (밖은 0), *pPad - 변환 크기 작업 버퍼
+ * @Output : *pSpec, 반환값 0 (성공) / -1 (메모리 할당 오류)
+ */
+// 김광제의 설명 - 창을 곱하지 않으면 FFT가 영상을 주기적으로 이어 붙이면서 생기는 가장자리 불연속이 이동량과 상관없는 최대값(0, 0)을 만든다.
+static int WindowToSpectrum(const PHASE_CORR *pCorr, const double *pFrame, double dMean, int nLeft, int nTop, int nRight, int nBottom, double *pPad,
+                            FFT_COMPLEX *pSpec)
+{
+    int nWidth = pCorr->nWidth, nPadWidth = pCorr->Plan.nWidth, nPadHeight = pCorr->Plan.nHeight;
+    double *pWindowX = (double *)PoolAlloc(GetThreadPool(), sizeof(double) * (nRight - nLeft + nBottom - nTop), 0), *pWindowY;
+
+    if (NULL == pWindowX)
+        return (-1);
+    pWindowY = pWindowX + (nRight - nLeft);
+    for (int x = 0; x < nRight - nLeft; x++)
+        pWindowX[x] = 0.5 - 0.5 * cos(2.0 * M_PI * (x + 0.5) / (nRight - nLeft));
+    for (int y = 0; y < nBottom - nTop; y++)
+        pWindowY[y] = 0.5 - 0.5 * cos(2.0 * M_PI * (y + 0.5) / (nBottom - nTop));
+
+#pragma omp parallel for schedule(static)
+    for (int v = 0; v < nPadHeight; v++)
+    {
+        double *pDst = pPad + (size_t)v * nPadWidth;
+        const double *pSrc = pFrame + (size_t)v * nWidth;
+
+        memset(pDst, 0, sizeof(double) * nPadWidth);
+        if (v < nTop || v >= nBottom)
+            continue;
+        for (int x = nLeft; x < nRight; x++)
+            pDst[x] = (pSrc[x] - dMean) * pWindowX[x - nLeft] * pWindowY[v - nTop];
+    }
+    PoolFree(GetThreadPool(), pWindowX);
+    return FftForward2D(&pCorr->Plan, pPad, pSpec);
+}
+
+/*
+ * @Function Name : RefinePeak
+ * @Description : 최대값과 양 옆 값으로 부화소 위치를 구합니다. (가우시안 3점 맞춤, 값이 0 이하면 포물선)
+ * @Input : l, c, r - 왼쪽, 최대값, 오른쪽
+ * @Output : 반환값 -0.5 ~ 0.5 보정량
+ */
+static double RefinePeak(double l, double c, double r)
+{
+    double d = 0.0, dDen;
+
+    if (l > 0.0 && c > 0.0 && r > 0.0)
+    {
+        dDen = 2.0 * (log(l) - 2.0 * log(c) + log(r));
+        if (dDen < 0.0)
+            d = (log(l) - log(r)) / dDen;
+    }
+    else
+    {
+        dDen = 2.0 * (l - 2.0 * c + r);
+        if (dDen < 0.0)
+            d = (l - r) / dDen;
+    }
+    return (d < -0.5) ? -0.5 : ((d > 0.5) ? 0.5 : d);
+}
+
+/*
+ * @Function Name : CorrelatePeak
+ * @Description : 두 스펙트럼의 정규화 교차 전력 스펙트럼을 역변환해서 최대값 위치(부화소)를 구합니다.
+ * @Input : *pPlan, *pSpec - 움직인 영상 스펙트럼 (바뀜), *pRefSpec - 기준 스펙트럼, *pSurface - 변환 크기 작업 버퍼
+ * @Output : *pDx, *pDy - 기준 영상에서 움직인 양 (-크기 / 2 ~ 크기 / 2), *pPeak - 최대값 (완전히 같으면 1), 반환값 0 (성공) / -1 (메모리 할당 오류)
+ */
+// 김광제의 설명 - g = f(x - d)이면 G = F exp(-2πi u d)라서 G conj(F) / |G conj(F)| = exp(-2πi u d)이고 역변환은 d 위치의 델타 함수
+// 크기로 나누어서 밝기, 대비가 달라도 위상(위치 정보)만 비교됨
+// 그대로 역변환하면 신호가 거의 없는 고주파의 위상 잡음이 최대값 주변을 흔들고 부화소 위치는 sinc 모양이라 맞추기 어렵다.
+// 가우시안 가중치 exp(-2π² σ² f²)를 곱하면 역변환이 d 위치의 표준 편차 σ 가우시안이 되어 RefinePeak의 3점 맞춤이 정확해짐
+static int CorrelatePeak(const FFT_PLAN *pPlan, FFT_COMPLEX *pSpec, const FFT_COMPLEX *pRefSpec, double *pSurface, double *pDx, double *pDy, double *pPeak)
+{
+    int nWidth = pPlan->nWidth, nHeight = pPlan->nHeight, nSpecWidth = pPlan->nSpecWidth, nBest = 0;
+    double *pRowMax, *pWeightX, *pWeightY, dSumX = 0.0, dSumY = 0.0, dScale;
+    int *pRowArg;
+    int px, py, xl, xr, yu, yd;
+
+    pRowMax = (double *)PoolAlloc(GetThreadPool(), sizeof(double) * (nHeight * 2 + nSpecWidth), 0);
+    pRowArg = (int *)PoolAlloc(GetThreadPool(), sizeof(int) * nHeight, 0);
+    if (NULL == pRowMax || NULL == pRowArg)
+    {
+        PoolFree(GetThreadPool(), pRowMax);
+        PoolFree(GetThreadPool(), pRowArg);
+        return (-1);
+    }
+
+    // 가중치는 x, y로 나누어짐, 전체 합으로 나누어서 같은 영상이면 최대값 1
+    pWeightX = pRowMax + nHeight;
+    pWeightY = pWeightX + nSpecWidth;
+    for (int u = 0; u < nSpecWidth; u++)
+    {
+        double f = (double)u / nWidth;
+
+        pWeightX[u] = exp(-2.0 * M_PI * M_PI * PHASE_PEAK_SIGMA * PHASE_PEAK_SIGMA * f * f);
+        dSumX += (u == 0 || u == nWidth / 2) ? pWeightX[u] : 2.0 * pWeightX[u];
+    }
+    for (int v = 0; v < nHeight; v++)
+    {
+        double f = (double)((v <= nHeight / 2) ? v : v - nHeight) / nHeight;
+
+        pWeightY[v] = exp(-2.0 * M_PI * M_PI * PHASE_PEAK_SIGMA * PHASE_PEAK_SIGMA * f * f);
+        dSumY += pWeightY[v];
+    }
+    dScale = (double)nWidth * nHeight / (dSumX * dSumY);
+
+#pragma omp parallel for schedule(static)
+    for (int v = 0; v < nHeight; v++)
+        for (int u = 0; u < nSpecWidth; u++)
+        {
+            size_t i = (size_t)v * nSpecWidth + u;
+            double re = pSpec[i].re * pRefSpec[i].re + pSpec[i].im * pRefSpec[i].im; // G conj(F)
+            double im = pSpec[i].im * pRefSpec[i].re - pSpec[i].re * pRefSpec[i].im;
+            double dMag = sqrt(re * re + im * im), w = dScale * pWeightX[u] * pWeightY[v];
+
+            pSpec[i].re = (dMag > PHASE_EPSILON) ? w * re / dMag : 0.0;
+            pSpec[i].im = (dMag > PHASE_EPSILON) ? w * im / dMag : 0.0;
+        }
+    if (FftInverse2D(pPlan, pSpec, pSurface) < 0)
+    {
+        PoolFree(GetThreadPool(), pRowMax);
+        PoolFree(GetThreadPool(), pRowArg);
+        return (-1);
+    }
+
+    // 최대값 (행마다 병렬로 구하고 행끼리 비교)
+#pragma omp parallel for schedule(static)
+    for (int y = 0; y < nHeight; y++)
+    {
+        const double *pRow = pSurface + (size_t)y * nWidth;
+        int nArg = 0;
+
+        for (int x = 1; x < nWidth; x++)
+            if (pRow[x] > pRow[nArg])
+                nArg = x;
+        pRowMax[y] = pRow[nArg];
+        pRowArg[y] = nArg;
+    }
+    for (int y = 1; y < nHeight; y++)
+        if (pRowMax[y] > pRowMax[nBest])
+            nBest = y;
+
+    // 부화소 보간 (반대쪽 끝과 이어짐)
+    px = pRowArg[nBest];
+    py = nBest;
+    xl = (px + nWidth - 1) % nWidth, xr = (px + 1) % nWidth, yu = (py + nHeight - 1) % nHeight, yd = (py + 1) % nHeight;
+    *pPeak = pSurface[(size_t)py * nWidth + px];
+    *pDx = px + RefinePeak(pSurface[(size_t)py * nWidth + xl], *pPeak, pSurface[(size_t)py * nWidth + xr]);
+    *pDy = py + RefinePeak(pSurface[(size_t)yu * nWidth + px], *pPeak, pSurface[(size_t)yd * nWidth + px]);
+    if (*pDx >= nWidth / 2.0)
+        *pDx -= nWidth;
+    if (*pDy >= nHeight / 2.0)
+        *pDy -= nHeight;
+
+    PoolFree(GetThreadPool(), pRowMax);
+    PoolFree(GetThreadPool(), pRowArg);
+    return 0;
+}
+
+/*
+ * @Function Name : TranslationPeak
+ * @Description : 프레임이 기준 영상에서 평행 이동한 양을 구합니다. (처음 구한 정수 이동량으로 겹치는 영역에 창을 다시 씌워서 한번 더)
+ * @Input : *pCorr, *pFrame - nWidth X nHeight, dMean, *pPad, *pSpec - 작업 버퍼
+ * @Output : *pDx, *pDy, *pPeak, 반환값 0 (성공) / -1 (메모리 할당 오류)
+ */
+// 김광제의 설명 - 두 영상에 같은 자리의 창을 곱하면 창 스펙트럼이 이웃 주파수를 섞는데, 이동량 d가 크면 이웃끼리 위상 차이(2π d / 크기)가 커서 결과가 0 쪽으로 끌린다.
+// 정수 이동량 k로 겹치는 영역을 구해서 기준 영상은 그 영역, 프레임은 k만큼 옮긴 영역에 창을 씌우면 남은 이동량이 0.5화소 이하라서 이 오차가 거의 없어짐
+// 이때는 기준 영상 스펙트럼을 다시 만들어야 하므로 k = 0이면 (흔들림 보정처럼 이동량이 작은 경우) 저장한 스펙트럼만 사용
+static int TranslationPeak(const PHASE_CORR *pCorr, const double *pFrame, double dMean, double *pPad, FFT_COMPLEX *pSpec, double *pDx, double *pDy, double *pPeak)
+{
+    int nWidth = pCorr->nWidth, nHeight = pCorr->nHeight, kx, ky, nRet;
+    FFT_COMPLEX *pRefSpec;
+
+    if (WindowToSpectrum(pCorr, pFrame, dMean, 0, 0, nWidth, nHeight, pPad, pSpec) < 0 || CorrelatePeak(&pCorr->Plan, pSpec, pCorr->pRefSpec, pPad, pDx, pDy, pPeak) < 0)
+        return (-1);
+    kx = (int)floor(*pDx + 0.5);
+    ky = (int)floor(*pDy + 0.5);
+    if ((kx == 0 && ky == 0) || nWidth - abs(kx) < 4 || nHeight - abs(ky) < 4)
+        return 0;
+
+    pRefSpec = (FFT_COMPLEX *)PoolAlloc(GetThreadPool(), sizeof(FFT_COMPLEX) * pCorr->Plan.nHeight * pCorr->Plan.nSpecWidth, 0);
+    if (NULL == pRefSpec)
+        return (-1);
+    nRet = WindowToSpectrum(pCorr, pCorr->pRef, pCorr->dRefMean, (kx < 0) ? -kx : 0, (ky < 0) ? -ky : 0, (kx < 0) ? nWidth : nWidth - kx,
+                            (ky < 0) ? nHeight : nHeight - ky, pPad, pRefSpec);
+    if (nRet == 0)
+        nRet = WindowToSpectrum(pCorr, pFrame, dMean, (kx > 0) ? kx : 0, (ky > 0) ? ky : 0, (kx > 0) ? nWidth : nWidth + kx, (ky > 0) ? nHeight : nHeight + ky,
+                                pPad, pSpec);
+    if (nRet == 0)
+        nRet = CorrelatePeak(&pCorr->Plan, pSpec, pRefSpec, pPad, pDx, pDy, pPeak);
+    PoolFree(GetThreadPool(), pRefSpec);
+    return nRet;
+}
+
+/*
+ * @Function Name : LogPolarSpectrum
+ * @Description : 크기 스펙트럼을 로그 극좌표(행 = 각도 0 ~ π, 열 = log 반지름)로 옮기고 FFT합니다.
+ * @Input : *pCorr, *pSpec - 창을 곱한 영상의 스펙트럼, *pPolar - 로그 극좌표 작업 버퍼
+ * @Output : *pPolarSpec, 반환값 0 (성공) / -1 (메모리 할당 오류)
+ */
+// 김광제의 설명 - 크기 스펙트럼은 이동에 영향을 받지 않고, 영상이 θ 회전하면 같이 θ 회전하고 s배 커지면 1 / s배 작아진다.
+// 로그 극좌표에서는 회전이 각도 방향, 배율이 log 반지름 방향 평행 이동이 되므로 한번 더 위상 상관으로 구함
+// 직류 근처의 큰 값이 최대값을 흐리지 않도록 고역 강조 (1 - X)(2 - X), X = cos(π fu) cos(π fv)를 곱한다. (Reddy, Chatterji)
+static int LogPolarSpectrum(const PHASE_CORR *pCorr, const FFT_COMPLEX *pSpec, double *pPolar, FFT_COMPLEX *pPolarSpec)
+{
+    const FFT_PLAN *pPlan = &pCorr->Plan;
+    int nAngles = pCorr->PolarPlan.nHeight, nRadii = pCorr->PolarPlan.nWidth, nSpecWidth = pPlan->nSpecWidth;
+    double dMinRadius = PHASE_POLAR_MIN_RADIUS / ((pPlan->nWidth < pPlan->nHeight) ? pPlan->nWidth : pPlan->nHeight);
+
+#pragma omp parallel for schedule(static)
+    for (int a = 0; a < nAngles; a++)
+    {
+        double dTheta = M_PI * a / nAngles, dCos = cos(dTheta), dSin = sin(dTheta), dSum = 0.0;
+        double *pRow = pPolar + (size_t)a * nRadii;
+
+        for (int r = 0; r < nRadii; r++)
+        {
+            double dRadius = dMinRadius * exp(r * pCorr->dLogBase), fu = dRadius * dCos, fv = dRadius * dSin;
+            double u = fu * pPlan->nWidth, v = fv * pPlan->nHeight, X = cos(M_PI * fu) * cos(M_PI * fv);
+            double du, dv, dMag = 0.0;
+            int u0, v0;
+
+            if (u < 0.0) // 실수 영상 스펙트럼은 켤레 대칭 |F(-u, -v)| = |F(u, v)|
+            {
+                u = -u;
+                v = -v;
+            }
+            u0 = (int)floor(u);
+            v0 = (int)floor(v);
+            du = u - u0;
+            dv = v - v0;
+            for (int j = 0; j < 2; j++)
+                for (int i = 0; i < 2; i++)
+                {
+                    int uu = (u0 + i < nSpecWidth) ? u0 + i : nSpecWidth - 1, vv = ((v0 + j) % pPlan->nHeight + pPlan->nHeight) % pPlan->nHeight;
+                    const FFT_COMPLEX *pS = &pSpec[(size_t)vv * nSpecWidth + uu];
+                    double w = (i ? du : 1.0 - du) * (j ? dv : 1.0 - dv);
+
+                    dMag += w * sqrt(pS->re * pS->re + pS->im * pS->im);
+                }
+            pRow[r] = dMag * (1.0 - X) * (2.0 - X);
+            dSum += pRow[r];
+        }
+
+        // 반지름 방향은 이어지지 않으므로 평균을 빼고 Hann 창 (각도 방향은 π 주기라서 그대로 이어짐)
+        dSum /= nRadii;
+        for (int r = 0; r < nRadii; r++)
+            pRow[r] = (pRow[r] - dSum) * (0.5 - 0.5 * cos(2.0 * M_PI * (r + 0.5) / nRadii));
+    }
+    return FftForward2D(&pCorr->PolarPlan, pPolar, pPolarSpec);
+}
+
+/*
+ * @Function Name : PhaseCorrInit
+ * @Description : 기준 영상으로 위상 상관 정합을 준비합니다. (기준 스펙트럼을 한번만 계산)
+ * @Input : *pCorr, *pRef - 8, 16비트 그레이 기준 영상 (ROI 가능, 4 X 4 이상), bRotationScale - 1이면 회전, 배율도 구함
+ * @Output : *pCorr, 반환값 0 (성공) / -1 (입력 오류, 메모리 할당 오류)
+ */
+int PhaseCorrInit(PHASE_CORR *pCorr, const IMAGE *pRef, int bRotationScale)
+{
+    int nWidth = pRef->nWidth, nHeight = pRef->nHeight, nPolar, nRet = 0;
+    double *pPad;
+
+    memset(pCorr, 0, sizeof(PHASE_CORR));
+    if ((pRef->nFormat != PIXEL_GRAY8 && pRef->nFormat != PIXEL_GRAY16) || nWidth < 4 || nHeight < 4 ||
+        FftInit(&pCorr->Plan, FftGoodSize(nWidth), FftGoodSize(nHeight)) < 0)
+        return (-1);
+    pCorr->nWidth = nWidth;
+    pCorr->nHeight = nHeight;
+    pCorr->bRotationScale = bRotationScale ? 1 : 0;
+
+    pCorr->pRef = (double *)malloc(sizeof(double) * nWidth * nHeight);
+    pCorr->pRefSpec = (FFT_COMPLEX *)malloc(sizeof(FFT_COMPLEX) * pCorr->Plan.nHeight * pCorr->Plan.nSpecWidth);
+    pPad = (double *)PoolAlloc(GetThreadPool(), sizeof(double) * pCorr->Plan.nWidth * pCorr->Plan.nHeight, 0);
+    if (NULL == pCorr->pRef || NULL == pCorr->pRefSpec || NULL == pPad)
+        nRet = -1;
+
+    if (nRet == 0)
+    {
+        pCorr->dRefMean = LoadFrame(pRef, pCorr->pRef);
+        nRet = WindowToSpectrum(pCorr, pCorr->pRef, pCorr->dRefMean, 0, 0, nWidth, nHeight, pPad, pCorr->pRefSpec);
+    }
+
+    // 로그 극좌표 : 한 변 = 짧은 변의 절반 (최소 PHASE_POLAR_MIN_SIZE), 반지름은 가장 작은 반지름 ~ 0.5 주기
+    if (nRet == 0 && pCorr->bRotationScale)
+    {
+        int nMin = (pCorr->Plan.nWidth < pCorr->Plan.nHeight) ? pCorr->Plan.nWidth : pCorr->Plan.nHeight;
+        double *pPolar;
+
+        nPolar = FftGoodSize((nMin / 2 > PHASE_POLAR_MIN_SIZE) ? nMin / 2 : PHASE_POLAR_MIN_SIZE);
+        pCorr->dLogBase = log(0.5 / (PHASE_POLAR_MIN_RADIUS / nMin)) / nPolar;
+        pCorr->pRefPolarSpec = (FFT_COMPLEX *)malloc(sizeof(FFT_COMPLEX) * nPolar * (nPolar / 2 + 1));
+        pPolar = (double *)PoolAlloc(GetThreadPool(), sizeof(double) * nPolar * nPolar, 0);
+        if (NULL == pCorr->pRefPolarSpec || NULL == pPolar || FftInit(&pCorr->PolarPlan, nPolar, nPolar) < 0 ||
+            LogPolarSpectrum(pCorr, pCorr->pRefSpec, pPolar, pCorr->pRefPolarSpec) < 0)
+            nRet = -1;
+        PoolFree(GetThreadPool(), pPolar);
+    }
+
+    PoolFree(GetThreadPool(), pPad);
+    if (nRet != 0)
+        PhaseCorrRelease(pCorr);
+    return nRet;
+}
+
+/*
+ * @Function Name : PhaseCorrRelease
+ * @Description : 위상 상관 정합의 메모리를 해제합니다.
+ * @Input : *pCorr
+ */
+void PhaseCorrRelease(PHASE_CORR *pCorr)
+{
+    FftRelease(&pCorr->Plan);
+    FftRelease(&pCorr->PolarPlan);
+    free(pCorr->pRef);
+    free(pCorr->pRefSpec);
+    free(pCorr->pRefPolarSpec);
+    memset(pCorr, 0, sizeof(PHASE_CORR));
+}
+
+/*
+ * @Function Name : WarpBack
+ * @Description : 영상을 가운데 기준으로 dScale배, dAngle 회전한 위치에서 가져옵니다. (양선형 보간, 영상 밖은 평균)
+ * @Input : *pSrc - nWidth X nHeight, dAngle (라디안), dScale, dFill
+ * @Output : *pDst(x) = pSrc(c + dScale R(dAngle) (x - c))
+ */
+static void WarpBack(const double *pSrc, double *pDst, int nWidth, int nHeight, double dAngle, double dScale, double dFill)
+{
+    double cx = (nWidth - 1) / 2.0, cy = (nHeight - 1) / 2.0, a = dScale * cos(dAngle), b = dScale * sin(dAngle);
+
+#pragma omp parallel for schedule(static)
+    for (int y = 0; y < nHeight; y++)
+        for (int x = 0; x < nWidth; x++)
+        {
+            double sx = cx + a * (x - cx) - b * (y - cy), sy = cy + b * (x - cx) + a * (y - cy);
+            int x0 = (int)floor(sx), y0 = (int)floor(sy);
+            double fx = sx - x0, fy = sy - y0;
+
+            if (x0 < 0 || y0 < 0 || x0 + 1 >= nWidth || y0 + 1 >= nHeight)
+                pDst[(size_t)y * nWidth + x] = dFill;
+            else
+            {
+                const double *p = pSrc + (size_t)y0 * nWidth + x0;
+
+                pDst[(size_t)y * nWidth + x] = (1.0 - fy) * ((1.0 - fx) * p[0] + fx * p[1]) + fy * ((1.0 - fx) * p[nWidth] + fx * p[nWidth + 1]);
+            }
+        }
+}
+
+/*
+ * @Function Name : PhaseCorrMatch
+ * @Description : 프레임이 기준 영상에서 얼마나 움직였는지 구합니다.
+ * @Input : *pCorr, *pFrame - 기준 영상과 같은 형식, 크기 (ROI 가능)
+ * @Output : *pResult - dx, dy (버퍼 좌표, 부화소), dAngle (도), dScale, dResponse (최대값, 1에 가까울수록 확실), 반환값 0 (성공) / -1 (입력 오류, 메모리 할당 오류)
+ */
+// 김광제의 설명 - 움직임 모델 : 프레임(c + dScale R(dAngle) (x - c) + (dx, dy)) = 기준(x), c = 영상 가운데, R은 Rotation과 같은 방향의 회전
+// 평행 이동만 있으면 Translation(프레임, 결과, -dx, dy)로 기준 영상에 맞출 수 있다. (Translation은 BMP 행 순서 때문에 Ty를 반대로 이동)
+// 회전, 배율은 로그 극좌표에서 각도를 π 주기로만 알 수 있어서 θ, θ + π로 프레임을 되돌려 보고 평행 이동 최대값이 큰 쪽을 사용
+int PhaseCorrMatch(const PHASE_CORR *pCorr, const IMAGE *pFrame, PHASE_CORR_RESULT *pResult)
+{
+    int nWidth = pCorr->nWidth, nHeight = pCorr->nHeight, nRet = 0;
+    size_t nPadSize = (size_t)pCorr->Plan.nWidth * pCorr->Plan.nHeight, nSpecSize = (size_t)pCorr->Plan.nHeight * pCorr->Plan.nSpecWidth;
+    double *pFrameBuf, *pPad, dMean = 0.0;
+    FFT_COMPLEX *pSpec;
+    PROFILE_BEGIN(dStart);
+
+    if (NULL == pCorr->pRefSpec || NULL == pResult || (pFrame->nFormat != PIXEL_GRAY8 && pFrame->nFormat != PIXEL_GRAY16) || pFrame->nWidth != nWidth ||
+        pFrame->nHeight != nHeight)
+        return (-1);
+
+    memset(pResult, 0, sizeof(PHASE_CORR_RESULT));
+    pResult->dScale = 1.0;
+    pFrameBuf = (double *)PoolAlloc(GetThreadPool(), sizeof(double) * nWidth * nHeight * (pCorr->bRotationScale ? 2 : 1), 0);
+    pPad = (double *)PoolAlloc(GetThreadPool(), sizeof(double) * nPadSize, 0);
+    pSpec = (FFT_COMPLEX *)PoolAlloc(GetThreadPool(), sizeof(FFT_COMPLEX) * nSpecSize, 0);
+    if (NULL == pFrameBuf || NULL == pPad || NULL == pSpec)
+        nRet = -1;
+
+    if (nRet == 0)
+        dMean = LoadFrame(pFrame, pFrameBuf);
+
+    if (nRet == 0 && !pCorr->bRotationScale)
+        nRet = TranslationPeak(pCorr, pFrameBuf, dMean, pPad, pSpec, &pResult->dx, &pResult->dy, &pResult->dResponse);
+    else if (nRet == 0)
+    {
+        int nPolar = pCorr->PolarPlan.nWidth;
+        double *pPolar = (double *)PoolAlloc(GetThreadPool(), sizeof(double) * nPolar * nPolar, 0);
+        FFT_COMPLEX *pPolarSpec = (FFT_COMPLEX *)PoolAlloc(GetThreadPool(), sizeof(FFT_COMPLEX) * nPolar * (nPolar / 2 + 1), 0);
+        double dLogScale = 0.0, dAngleBins = 0.0, dPeak, dAngle, dScale;
+
+        // 1. 회전, 배율 (로그 극좌표 열 이동 = -log(배율), 행 이동 = 각도)
+        if (NULL == pPolar || NULL == pPolarSpec || WindowToSpectrum(pCorr, pFrameBuf, dMean, 0, 0, nWidth, nHeight, pPad, pSpec) < 0 ||
+            LogPolarSpectrum(pCorr, pSpec, pPolar, pPolarSpec) < 0 ||
+            CorrelatePeak(&pCorr->PolarPlan, pPolarSpec, pCorr->pRefPolarSpec, pPolar, &dLogScale, &dAngleBins, &dPeak) < 0)
+            nRet = -1;
+        dAngle = dAngleBins * M_PI / nPolar;
+        dScale = exp(-dLogScale * pCorr->dLogBase);
+
+        // 2. θ, θ + π로 되돌린 프레임의 평행 이동 (되돌린 좌표의 이동 d'을 프레임 좌표로 : d = dScale R d')
+        pResult->dResponse = -1.0;
+        for (int k = 0; k < 2 && nRet == 0; k++)
+        {
+            double dTheta = dAngle + k * M_PI, dx, dy, dResponse;
+
+            WarpBack(pFrameBuf, pFrameBuf + (size_t)nWidth * nHeight, nWidth, nHeight, dTheta, dScale, dMean);
+            if (TranslationPeak(pCorr, pFrameBuf + (size_t)nWidth * nHeight, dMean, pPad, pSpec, &dx, &dy, &dResponse) < 0)
+                nRet = -1;
+            else if (dResponse > pResult->dResponse)
+            {
+                pResult->dResponse = dResponse;
+                pResult->dAngle = remainder(dTheta, 2.0 * M_PI) * 180.0 / M_PI;
+                pResult->dScale = dScale;
+                pResult->dx = dScale * (cos(dTheta) * dx - sin(dTheta) * dy);
+                pResult->dy = dScale * (sin(dTheta) * dx + cos(dTheta) * dy);
+            }
+        }
+        PoolFree(GetThreadPool(), pPolar);
+        PoolFree(GetThreadPool(), pPolarSpec);
+    }
+
+    PoolFree(GetThreadPool(), pFrameBuf);
+    PoolFree(GetThreadPool(), pPad);
+    PoolFree(GetThreadPool(), pSpec);
+    PROFILE_END(dStart, "phase_correlation", (long long)nWidth * nHeight, (long long)nPadSize * (2 * sizeof(double) + 2 * sizeof(FFT_COMPLEX)));
+    return nRet;
+}
+
+/*
+ * @Function Name : ImgPhaseCorrelate
+ * @Description : 두 영상의 평행 이동량을 위상 상관으로 구합니다. (한 쌍만 처리, 여러 프레임은 PhaseCorrInit + PhaseCorrMatch)
+ * @Input : *pRef, *pFrame - 같은 형식(8, 16비트 그레이), 크기
+ * @Output : *pDx, *pDy - 프레임이 기준 영상에서 움직인 양 (버퍼 좌표, 부화소), 반환값 0 (성공) / -1 (입력 오류, 메모리 할당 오류)
+ */
+int ImgPhaseCorrelate(const IMAGE *pRef, const IMAGE *pFrame, double *pDx, double *pDy)
+{
+    PHASE_CORR Corr;
+    PHASE_CORR_RESULT Result;
+    int nRet;
+
+    if (PhaseCorrInit(&Corr, pRef, 0) < 0)
+        return (-1);
+    nRet = PhaseCorrMatch(&Corr, pFrame, &Result);
+    PhaseCorrRelease(&Corr);
+    if (nRet == 0)
+    {
+        *pDx = Result.dx;
+        *pDy = Result.dy;
+    }
+    return nRet;
+}
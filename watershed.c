@@ -0,0 +1,436 @@
+/*
+ * @Name : watershed.c
+ * @Description : Image Processing in C - 워터셰드 영역 분할 (맞닿은 객체 나누기)
+ * @Date : 2026. 10. 19
+ * @Revision : 1.0
+ * 1.0 : ImgWatershed (마커 기반, 8비트 높이 256단계 계층 큐), ImgSplitObjects (거리 변환 + 깊이 기준 분지 합치기)
+ *
+ * ComponentLabeling은 맞닿은 동전을 한 덩어리로 세므로 BlobArea 기준으로 고르거나 개수를 세면 틀린다.
+ * 객체 안쪽일수록 낮은 지형(거리 변환을 뒤집은 것)에 물을 채우면 동전마다 중심에서 물이 차오르다가 맞닿은 곳(잘록한 목)에서 만난다.
+ * 높이가 8비트라서 우선순위 큐 대신 높이마다 FIFO를 하나씩 두면 넣고 빼기가 O(1)이고 전체가 O(N)이 된다.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <float.h>
+#include <math.h>
+#include "imgprocessing.h"
+#include "profile.h"
+
+#define WS_LEVELS 256      // 지형 높이 단계 수 (8비트)
+#define WS_BLOCK_SIZE 4096 // 큐 블록 하나의 항목 수 (32KB, 빈 블록은 다시 사용하므로 큐 메모리는 물이 차오르는 경계 크기만큼)
+#define WS_MAX_SCALE 4     // ImgSplitObjects에서 거리 1픽셀당 높이 단계 수의 최대값
+#define WS_SHIFT 16        // 큐 항목 = (픽셀 번호 << 16) | x
+
+// 높이 하나의 FIFO 블록 (연결 리스트)
+typedef struct WS_BLOCK
+{
+    struct WS_BLOCK *pNext;
+    int nHead, nTail;
+    unsigned long long Entry[WS_BLOCK_SIZE];
+} WS_BLOCK;
+
+// 계층 큐 (높이마다 FIFO, 현재 높이보다 낮은 높이는 다시 보지 않음)
+typedef struct
+{
+    WS_BLOCK *pHead[WS_LEVELS], *pTail[WS_LEVELS];
+    WS_BLOCK *pFree; // 다 꺼낸 블록
+    int nLevel;      // 현재 물 높이
+} WS_QUEUE;
+
+/*
+ * @Function Name : QueuePush
+ * @Description : 계층 큐의 nLevel 높이에 항목을 넣습니다.
+ * @Input : *pQueue, nLevel, nEntry
+ * @Output : 반환값 0 (성공) / -1 (메모리 할당 오류)
+ */
+static int QueuePush(WS_QUEUE *pQueue, int nLevel, unsigned long long nEntry)
+{
+    WS_BLOCK *pBlock = pQueue->pTail[nLevel];
+
+    if (NULL == pBlock || pBlock->nTail == WS_BLOCK_SIZE)
+    {
+        WS_BLOCK *pNew = pQueue->pFree;
+
+        if (NULL != pNew)
+            pQueue->pFree = pNew->pNext;
+        else if ((pNew = (WS_BLOCK *)malloc(sizeof(WS_BLOCK))) == NULL)
+            return (-1);
+        pNew->pNext = NULL;
+        pNew->nHead = pNew->nTail = 0;
+        if (NULL == pBlock)
+            pQueue->pHead[nLevel] = pNew;
+        else
+            pBlock->pNext = pNew;
+        pQueue->pTail[nLevel] = pBlock = pNew;
+    }
+    pBlock->Entry[pBlock->nTail++] = nEntry;
+    return 0;
+}
+
+/*
+ * @Function Name : QueuePop
+ * @Description : 계층 큐에서 가장 낮은 높이의 가장 먼저 넣은 항목을 꺼냅니다.
+ * @Input : *pQueue
+ * @Output : *pEntry, 반환값 꺼낸 항목의 높이 / -1 (큐가 비었음)
+ */
+// 김광제의 설명 - 물 높이는 내려가지 않으므로 (넣을 때 현재 높이보다 낮으면 현재 높이에 넣음) 빈 높이는 한번만 지나간다.
+static int QueuePop(WS_QUEUE *pQueue, unsigned long long *pEntry)
+{
+    WS_BLOCK *pBlock;
+
+    while (pQueue->nLevel < WS_LEVELS && NULL == pQueue->pHead[pQueue->nLevel])
+        pQueue->nLevel++;
+    if (pQueue->nLevel == WS_LEVELS)
+        return (-1);
+
+    pBlock = pQueue->pHead[pQueue->nLevel];
+    *pEntry = pBlock->Entry[pBlock->nHead++];
+    if (pBlock->nHead == pBlock->nTail) // 다 꺼낸 블록은 빈 블록 목록으로
+    {
+        pQueue->pHead[pQueue->nLevel] = pBlock->pNext;
+        if (NULL == pBlock->pNext)
+            pQueue->pTail[pQueue->nLevel] = NULL;
+        pBlock->pNext = pQueue->pFree;
+        pQueue->pFree = pBlock;
+    }
+    return pQueue->nLevel;
+}
+
+/*
+ * @Function Name : QueueRelease
+ * @Description : 계층 큐의 모든 블록을 해제합니다.
+ */
+static void QueueRelease(WS_QUEUE *pQueue)
+{
+    for (int l = 0; l < WS_LEVELS; l++)
+        while (NULL != pQueue->pHead[l])
+        {
+            WS_BLOCK *pNext = pQueue->pHead[l]->pNext;
+
+            free(pQueue->pHead[l]);
+            pQueue->pHead[l] = pNext;
+        }
+    while (NULL != pQueue->pFree)
+    {
+        WS_BLOCK *pNext = pQueue->pFree->pNext;
+
+        free(pQueue->pFree);
+        pQueue->pFree = pNext;
+    }
+}
+
+/*
+ * @Function Name : FindBasin
+ * @Description : 합쳐진 분지의 대표 번호를 찾습니다. (경로 절반 압축)
+ */
+static int FindBasin(int *pParent, int a)
+{
+    while (pParent[a] != a)
+    {
+        pParent[a] = pParent[pParent[a]];
+        a = pParent[a];
+    }
+    return a;
+}
+
+/*
+ * @Function Name : Flood
+ * @Description : 마커에서 시작해서 낮은 곳부터 물을 채우며 레이블을 넓힙니다.
+ * @Input : *pRelief - 지형 (nWidth X nHeight 연속 버퍼), *pLabels - 마커 (0 : 채울 픽셀, 양수 : 마커 번호, 음수 : 채우지 않는 픽셀),
+ *          *pParent, *pMin - 분지 합치기 (NULL이면 합치지 않음, 마커 번호마다 대표 번호와 가장 낮은 높이), nDepth - 합치지 않을 최소 깊이 (높이 단계)
+ * @Output : *pLabels - 닿을 수 있는 0인 픽셀은 모두 마커 번호, 반환값 0 (성공) / -1 (메모리 할당 오류)
+ */
+// 김광제의 설명 - 1. 0인 픽셀이나 다른 마커와 닿은 마커 픽셀을 마커 높이에 넣는다. (마커는 자기 높이까지 물이 차오르면 퍼지기 시작)
+// 2. 가장 낮은 높이의 픽셀을 꺼내서 0인 8주변 화소에 같은 번호를 붙이고 max(현재 높이, 그 화소 높이)에 넣는다.
+//    번호는 넣을 때 붙이므로 모든 픽셀은 한번만 큐에 들어가고, 같은 높이에서는 먼저 닿은 분지가 차지함 (평지에서 경계가 가운데 생김)
+// 3. 합치기를 하면 서로 다른 분지가 만날 때 (낮은 곳부터 채우므로 처음 만나는 곳이 두 분지 사이의 가장 낮은 고개) 한쪽이라도 깊이가 nDepth보다 얕으면 깊은 쪽으로 합친다.
+//    분지 깊이 = 고개 높이 - 분지의 가장 낮은 높이라서 잡음으로 생긴 얕은 웅덩이는 옆 분지에 흡수됨
+static int Flood(const BYTE *pRelief, int nWidth, int nHeight, int *pLabels, int *pParent, BYTE *pMin, int nDepth)
+{
+    long long nSize = (long long)nWidth * nHeight;
+    WS_QUEUE Queue;
+    unsigned long long nEntry;
+    int nLevel, nRet = 0;
+
+    memset(&Queue, 0, sizeof(Queue));
+
+    // 1. 마커 경계 (0인 픽셀이나 다른 마커와 닿은 마커 픽셀)
+    for (int y = 0; y < nHeight && nRet == 0; y++)
+        for (int x = 0; x < nWidth; x++)
+        {
+            long long p = (long long)y * nWidth + x;
+            int bBorder = 0;
+
+            if (pLabels[p] <= 0)
+                continue;
+            for (int dy = -1; dy <= 1 && !bBorder; dy++)
+                for (int dx = -1; dx <= 1; dx++)
+                {
+                    int nx = x + dx, ny = y + dy, b;
+
+                    if (nx < 0 || ny < 0 || nx >= nWidth || ny >= nHeight)
+                        continue;
+                    b = pLabels[(long long)ny * nWidth + nx];
+                    if (b == 0 || (b > 0 && b != pLabels[p]))
+                    {
+                        bBorder = 1;
+                        break;
+                    }
+                }
+            if (bBorder && QueuePush(&Queue, pRelief[p], ((unsigned long long)p << WS_SHIFT) | (unsigned int)x) < 0)
+            {
+                nRet = -1;
+                break;
+            }
+        }
+
+    // 2. 물 채우기
+    while (nRet == 0 && (nLevel = QueuePop(&Queue, &nEntry)) >= 0)
+    {
+        long long p = (long long)(nEntry >> WS_SHIFT);
+        int x = (int)(nEntry & ((1u << WS_SHIFT) - 1));
+        int a = pLabels[p];
+        int nMask = 0xFF; // 영상 안에 있는 8주변 화소 (비트 k = 방향 k)
+
+        if (x == 0)
+            nMask &= ~0x29; // 왼쪽 (0, 3, 5)
+        if (x == nWidth - 1)
+            nMask &= ~0x94; // 오른쪽 (2, 4, 7)
+        if (p < nWidth)
+            nMask &= ~0x07; // 위 (0, 1, 2)
+        if (p + nWidth >= nSize)
+            nMask &= ~0xE0; // 아래 (5, 6, 7)
+
+        for (int k = 0; k < 8; k++)
+        {
+            static const int nDx[8] = {-1, 0, 1, -1, 1, -1, 0, 1}, nDy[8] = {-1, -1, -1, 0, 0, 1, 1, 1};
+            long long q;
+            int b;
+
+            if (!(nMask & (1 << k)))
+                continue;
+            q = p + (long long)nDy[k] * nWidth + nDx[k];
+            b = pLabels[q];
+
+            if (b == 0)
+            {
+                pLabels[q] = a;
+                if (QueuePush(&Queue, (pRelief[q] > nLevel) ? pRelief[q] : nLevel, ((unsigned long long)q << WS_SHIFT) | (unsigned int)(x + nDx[k])) < 0)
+                {
+                    nRet = -1;
+                    break;
+                }
+            }
+            else if (b > 0 && b != a && NULL != pParent)
+            {
+                // 3. 두 분지가 만남 (고개 높이 = 두 픽셀 중 높은 쪽)
+                int ra = FindBasin(pParent, a), rb = FindBasin(pParent, b), nPass = (pRelief[q] > nLevel) ? pRelief[q] : nLevel;
+
+                if (ra != rb && (nPass - pMin[ra] < nDepth || nPass - pMin[rb] < nDepth))
+                {
+                    if (pMin[rb] < pMin[ra] || (pMin[rb] == pMin[ra] && rb < ra))
+                        pParent[ra] = rb;
+                    else
+                        pParent[rb] = ra;
+                }
+            }
+        }
+    }
+
+    QueueRelease(&Queue);
+    return nRet;
+}
+
+/*
+ * @Function Name : PackRelief
+ * @Description : 8비트 그레이 영상(ROI 가능)을 연속 버퍼로 가져옵니다. (이미 연속이면 복사하지 않음)
+ * @Input : *pIn
+ * @Output : **ppCopy - 새로 할당한 버퍼 (PoolAlloc, 복사하지 않았으면 NULL), 반환값 연속 버퍼 / NULL (메모리 할당 오류)
+ */
+static const BYTE *PackRelief(const IMAGE *pIn, BYTE **ppCopy)
+{
+    int nWidth = pIn->nWidth, nHeight = pIn->nHeight;
+
+    *ppCopy = NULL;
+    if (pIn->nStride == nWidth)
+        return pIn->pPlane[0];
+
+    *ppCopy = (BYTE *)PoolAlloc(GetThreadPool(), (size_t)nWidth * nHeight, 0);
+    if (NULL == *ppCopy)
+        return NULL;
+    for (int y = 0; y < nHeight; y++)
+        memcpy(*ppCopy + (size_t)y * nWidth, pIn->pPlane[0] + (size_t)y * pIn->nStride, nWidth);
+    return *ppCopy;
+}
+
+/*
+ * @Function Name : ImgWatershed
+ * @Description : 마커 기반 워터셰드로 영역을 나눕니다.
+ * @Input : *pRelief - 8비트 그레이 지형 (ROI 가능, 기울기 크기나 뒤집은 거리 변환처럼 경계가 높은 영상, 한 변 65535 이하),
+ *          *pLabels - nWidth X nHeight 연속 버퍼 (양수 : 마커 번호, 0 : 채울 픽셀, 음수 : 채우지 않는 픽셀)
+ * @Output : *pLabels - 마커에서 닿을 수 있는 0인 픽셀은 가장 먼저 물이 닿은 마커의 번호 (마커, 음수 픽셀은 그대로),
+ *           반환값 0 (성공) / -1 (입력 오류, 메모리 할당 오류)
+ */
+// 김광제의 설명 - 경계선 픽셀은 따로 두지 않고 모든 픽셀을 어느 한 분지에 넣는다. (레이블 영상에서 번호가 바뀌는 곳이 경계)
+// 한 픽셀을 한번만 큐에 넣고 빼므로 영상 크기에 비례한 시간이고, 큐는 물이 차오르는 경계만큼만 메모리를 씀
+int ImgWatershed(const IMAGE *pRelief, int *pLabels)
+{
+    int nWidth = pRelief->nWidth, nHeight = pRelief->nHeight, nRet;
+    const BYTE *pPacked;
+    BYTE *pCopy;
+    PROFILE_BEGIN(dStart);
+
+    if (pRelief->nFormat != PIXEL_GRAY8 || nWidth > 0xFFFF || NULL == pLabels)
+        return (-1);
+
+    pPacked = PackRelief(pRelief, &pCopy);
+    if (NULL == pPacked)
+        return (-1);
+    nRet = Flood(pPacked, nWidth, nHeight, pLabels, NULL, NULL, 0);
+    PoolFree(GetThreadPool(), pCopy);
+
+    PROFILE_END(dStart, "watershed", (long long)nWidth * nHeight, (long long)nWidth * nHeight * (1 + 2 * sizeof(int)));
+    return nRet;
+}
+
+/*
+ * @Function Name : ImgSplitObjects
+ * @Description : 8비트 이진 영상의 객체(전경 255, 8연결)를 맞닿은 곳에서 나눠서 레이블을 붙입니다.
+ * @Input : *pIn - 8비트 이진 영상 (ROI 가능, 한 변 65535 이하), dMinDepth - 나눌 최소 깊이 (픽셀, 객체 중심의 거리 - 맞닿은 목의 거리)
+ * @Output : *pLabels - nWidth X nHeight 연속 버퍼 (배경 0, 객체 1 ~ 반환값), 반환값 객체 수 / -1 (입력 오류, 메모리 할당 오류)
+ */
+// 김광제의 설명 - 1. 유클리드 거리 변환을 높이 0 ~ 254로 뒤집어서 지형을 만든다. (객체 중심이 가장 낮음, 거리 1픽셀 = 최대 WS_MAX_SCALE 단계)
+// 2. 주변 8화소보다 높지 않은 전경 픽셀마다 마커를 두고 물을 채우면서, 고개에서 만난 두 분지 중 한쪽이라도 dMinDepth보다 얕으면 합친다.
+//    동전 두 개가 맞닿으면 목의 거리가 동전 반지름보다 훨씬 작아서 두 분지 모두 깊으므로 나눠지고, 한 동전 안의 잡음 웅덩이는 얕아서 합쳐짐
+// 3. 남은 분지에 1부터 번호를 다시 붙인다.
+int ImgSplitObjects(const IMAGE *pIn, int *pLabels, double dMinDepth)
+{
+    int nWidth = pIn->nWidth, nHeight = pIn->nHeight, nSeeds = 0, nObjects = 0, nDepth;
+    size_t nSize = (size_t)nWidth * nHeight;
+    float *pDist = NULL;
+    BYTE *pRelief = NULL, *pMin = NULL;
+    int *pParent = NULL, *pNumber = NULL;
+    float fMax = 0.0f;
+    double dScale;
+    PROFILE_BEGIN(dStart);
+
+    if (pIn->nFormat != PIXEL_GRAY8 || nWidth > 0xFFFF || NULL == pLabels || dMinDepth < 0.0)
+        return (-1);
+
+    // 1. 거리 변환 -> 지형
+    pDist = (float *)PoolAlloc(GetThreadPool(), nSize * sizeof(float), 0);
+    pRelief = (BYTE *)PoolAlloc(GetThreadPool(), nSize, 0);
+    if (NULL == pDist || NULL == pRelief || ImgDistanceTransform(pIn, pDist, DIST_EUCLIDEAN) < 0)
+    {
+        PoolFree(GetThreadPool(), pDist);
+        PoolFree(GetThreadPool(), pRelief);
+        return (-1);
+    }
+
+    for (size_t i = 0; i < nSize; i++)
+        if (pDist[i] != FLT_MAX && pDist[i] > fMax)
+            fMax = pDist[i];
+    dScale = (fMax > 0.0f) ? 254.0 / fMax : 1.0;
+    if (dScale > WS_MAX_SCALE)
+        dScale = WS_MAX_SCALE;
+    nDepth = (int)lrint(dMinDepth * dScale);
+    if (nDepth < 1)
+        nDepth = 1; // 높이가 같은 평지의 마커끼리는 항상 합침
+
+#pragma omp parallel for schedule(static)
+    for (int y = 0; y < nHeight; y++)
+    {
+        const BYTE *pRow = pIn->pPlane[0] + (size_t)y * pIn->nStride;
+
+        for (int x = 0; x < nWidth; x++)
+        {
+            size_t i = (size_t)y * nWidth + x;
+
+            if (pRow[x] != 255)
+            {
+                pRelief[i] = 255;
+                pLabels[i] = -1; // 배경은 채우지 않음
+            }
+            else
+            {
+                pRelief[i] = (pDist[i] == FLT_MAX) ? 0 : (BYTE)(254 - (int)(pDist[i] * dScale + 0.5));
+                pLabels[i] = 0;
+            }
+        }
+    }
+    PoolFree(GetThreadPool(), pDist);
+
+    // 2. 주변보다 높지 않은 전경 픽셀마다 마커 (줄마다 나눠서 표시한 뒤 위쪽부터 번호)
+#pragma omp parallel for schedule(static)
+    for (int y = 0; y < nHeight; y++)
+    {
+        int y0 = (y > 0) ? y - 1 : 0, y1 = (y < nHeight - 1) ? y + 1 : nHeight - 1;
+
+        for (int x = 0; x < nWidth; x++)
+        {
+            size_t i = (size_t)y * nWidth + x;
+            int x0 = (x > 0) ? x - 1 : 0, x1 = (x < nWidth - 1) ? x + 1 : nWidth - 1, bMinimum = 1;
+            BYTE nHere = pRelief[i];
+
+            if (nHere == 255) // 배경 (전경 높이는 254 이하)
+                continue;
+            for (int ny = y0; ny <= y1 && bMinimum; ny++)
+            {
+                const BYTE *pRow = pRelief + (size_t)ny * nWidth;
+
+                for (int nx = x0; nx <= x1; nx++)
+                    if (pRow[nx] < nHere)
+                    {
+                        bMinimum = 0;
+                        break;
+                    }
+            }
+            if (bMinimum)
+                pLabels[i] = INT_MAX;
+        }
+    }
+    for (size_t i = 0; i < nSize; i++)
+        if (pLabels[i] == INT_MAX)
+            pLabels[i] = ++nSeeds;
+
+    pParent = (int *)PoolAlloc(GetThreadPool(), sizeof(int) * (nSeeds + 1), 0);
+    pNumber = (int *)PoolAlloc(GetThreadPool(), sizeof(int) * (nSeeds + 1), 1);
+    pMin = (BYTE *)PoolAlloc(GetThreadPool(), nSeeds + 1, 0);
+    if (NULL != pParent && NULL != pNumber && NULL != pMin)
+    {
+        for (int s = 0; s <= nSeeds; s++)
+            pParent[s] = s;
+        for (size_t i = 0; i < nSize; i++)
+            if (pLabels[i] > 0)
+                pMin[pLabels[i]] = pRelief[i];
+
+        if (Flood(pRelief, nWidth, nHeight, pLabels, pParent, pMin, nDepth) == 0)
+        {
+            // 3. 남은 분지 번호 (마커 순서 = 영상 위쪽부터)
+            for (int s = 1; s <= nSeeds; s++)
+                if (FindBasin(pParent, s) == s)
+                    pNumber[s] = ++nObjects;
+            for (int s = 1; s <= nSeeds; s++)
+                pNumber[s] = pNumber[FindBasin(pParent, s)];
+
+#pragma omp parallel for schedule(static)
+            for (long long i = 0; i < (long long)nSize; i++)
+                pLabels[i] = (pLabels[i] > 0) ? pNumber[pLabels[i]] : 0;
+        }
+        else
+            nObjects = -1;
+    }
+    else
+        nObjects = -1;
+
+    PoolFree(GetThreadPool(), pRelief);
+    PoolFree(GetThreadPool(), pParent);
+    PoolFree(GetThreadPool(), pNumber);
+    PoolFree(GetThreadPool(), pMin);
+    PROFILE_COUNT("watershed_seeds", nSeeds);
+    PROFILE_END(dStart, "split_objects", (long long)nSize, (long long)nSize * (2 + 3 * sizeof(int) + sizeof(float)));
+    return nObjects;
+}